@@ -0,0 +1,57 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Benchmarks of the vectorized hot kernels of BE.
+//
+// The results are printed as JSON by default so that they can be stored and compared
+// between releases, e.g.
+//   ./doris_be_benchmark --benchmark_out=result.json --benchmark_filter=BM_Block
+// All the flags of google benchmark are accepted.
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <vector>
+
+#include "runtime/memory/chunk_allocator.h"
+#include "util/cpu_info.h"
+#include "util/mem_info.h"
+
+int main(int argc, char** argv) {
+    doris::CpuInfo::init();
+    doris::MemInfo::init();
+    doris::ChunkAllocator::init_instance(4096);
+
+    std::vector<char*> args(argv, argv + argc);
+    bool has_format = false;
+    for (int i = 1; i < argc; ++i) {
+        has_format |= strncmp(argv[i], "--benchmark_format", strlen("--benchmark_format")) == 0;
+    }
+    char json_format[] = "--benchmark_format=json";
+    if (!has_format) {
+        args.push_back(json_format);
+    }
+    int num_args = args.size();
+
+    benchmark::Initialize(&num_args, args.data());
+    if (benchmark::ReportUnrecognizedArguments(num_args, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
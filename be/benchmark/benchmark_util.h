@@ -0,0 +1,55 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <random>
+#include <string>
+
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+
+namespace doris::vectorized {
+
+// Deterministic data, so that the results of different runs and releases are comparable.
+inline ColumnInt64::MutablePtr make_int64_column(size_t rows, int64_t cardinality) {
+    std::mt19937_64 rng(rows);
+    std::uniform_int_distribution<int64_t> dist(0, cardinality - 1);
+    auto column = ColumnInt64::create();
+    auto& data = column->get_data();
+    data.reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        data.push_back(dist(rng));
+    }
+    return column;
+}
+
+inline ColumnString::MutablePtr make_string_column(size_t rows, int64_t cardinality,
+                                                   size_t length) {
+    std::mt19937_64 rng(rows);
+    std::uniform_int_distribution<int64_t> dist(0, cardinality - 1);
+    auto column = ColumnString::create();
+    column->reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        std::string value = std::to_string(dist(rng));
+        value.resize(std::max(length, value.size()), 'x');
+        column->insert_data(value.data(), value.size());
+    }
+    return column;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,90 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_util.h"
+#include "common/config.h"
+#include "gen_cpp/data.pb.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+static Block make_block(size_t rows) {
+    Block block;
+    block.insert({make_int64_column(rows, 1024), std::make_shared<DataTypeInt64>(), "k1"});
+    block.insert({make_string_column(rows, 1024, 32), std::make_shared<DataTypeString>(), "k2"});
+    return block;
+}
+
+static void BM_BlockSerialize(benchmark::State& state) {
+    config::compress_rowbatches = true;
+    auto compression_type = static_cast<segment_v2::CompressionTypePB>(state.range(0));
+    Block block = make_block(4096);
+    PBlock pblock;
+    std::string buffer;
+    size_t uncompressed_bytes = 0;
+    size_t compressed_bytes = 0;
+    for (auto _ : state) {
+        pblock.Clear();
+        auto st = block.serialize(&pblock, &uncompressed_bytes, &compressed_bytes, &buffer,
+                                  compression_type);
+        benchmark::DoNotOptimize(st);
+    }
+    state.SetBytesProcessed(state.iterations() * uncompressed_bytes);
+    state.counters["compressed_bytes"] = compressed_bytes;
+}
+
+static void BM_BlockDeserialize(benchmark::State& state) {
+    config::compress_rowbatches = true;
+    auto compression_type = static_cast<segment_v2::CompressionTypePB>(state.range(0));
+    Block block = make_block(4096);
+    PBlock pblock;
+    std::string buffer;
+    size_t uncompressed_bytes = 0;
+    size_t compressed_bytes = 0;
+    auto st = block.serialize(&pblock, &uncompressed_bytes, &compressed_bytes, &buffer,
+                              compression_type);
+    if (!st.ok()) {
+        state.SkipWithError(st.get_error_msg().c_str());
+        return;
+    }
+    pblock.set_column_values(buffer);
+    for (auto _ : state) {
+        Block result;
+        st = result.deserialize(pblock);
+        if (!st.ok()) {
+            state.SkipWithError(st.get_error_msg().c_str());
+            return;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * uncompressed_bytes);
+}
+
+#define COMPRESSION_TYPES                                  \
+    Arg(segment_v2::CompressionTypePB::NO_COMPRESSION)     \
+            ->Arg(segment_v2::CompressionTypePB::SNAPPY)   \
+            ->Arg(segment_v2::CompressionTypePB::LZ4)      \
+            ->Arg(segment_v2::CompressionTypePB::ZSTD)
+
+BENCHMARK(BM_BlockSerialize)->COMPRESSION_TYPES;
+BENCHMARK(BM_BlockDeserialize)->COMPRESSION_TYPES;
+
+} // namespace doris::vectorized
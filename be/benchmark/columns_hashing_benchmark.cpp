@@ -0,0 +1,133 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_util.h"
+#include "vec/common/arena.h"
+#include "vec/common/columns_hashing.h"
+#include "vec/common/hash_table/hash_map.h"
+#include "vec/common/hash_table/two_level_hash_map.h"
+
+namespace doris::vectorized {
+
+using Int64HashMap = HashMap<UInt64, UInt64, HashCRC32<UInt64>>;
+using Int64TwoLevelHashMap = TwoLevelHashMap<UInt64, UInt64, HashCRC32<UInt64>>;
+using StringHashMap = HashMapWithSavedHash<StringRef, UInt64>;
+
+template <typename Data>
+using Int64HashMethod =
+        ColumnsHashing::HashMethodOneNumber<typename Data::value_type, UInt64, UInt64, false>;
+using StringHashMethod =
+        ColumnsHashing::HashMethodString<StringHashMap::value_type, UInt64, true, false>;
+
+template <typename Data, typename Method>
+static void emplace_keys(Data& data, Method& method, size_t rows, Arena& arena) {
+    for (size_t i = 0; i < rows; ++i) {
+        auto emplace_result = method.emplace_key(data, i, arena);
+        if (emplace_result.is_inserted()) {
+            emplace_result.set_mapped(i);
+        }
+    }
+}
+
+// the aggregation probes: insert the key when it is not found
+template <typename Data>
+static void BM_AggregateInt64Emplace(benchmark::State& state) {
+    const size_t rows = 4096;
+    auto column = make_int64_column(rows, state.range(0));
+    ColumnRawPtrs key_columns {column.get()};
+    for (auto _ : state) {
+        Data data;
+        Arena arena;
+        Int64HashMethod<Data> method(key_columns, {}, nullptr);
+        emplace_keys(data, method, rows, arena);
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+
+static void BM_AggregateStringEmplace(benchmark::State& state) {
+    const size_t rows = 4096;
+    auto column = make_string_column(rows, state.range(0), 16);
+    ColumnRawPtrs key_columns {column.get()};
+    for (auto _ : state) {
+        StringHashMap data;
+        Arena arena;
+        StringHashMethod method(key_columns, {}, nullptr);
+        emplace_keys(data, method, rows, arena);
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+
+// the join probes: look up the keys of probe side in the hash table built by build side
+static void BM_JoinInt64Find(benchmark::State& state) {
+    const size_t build_rows = state.range(0);
+    const size_t probe_rows = 4096;
+    auto build_column = make_int64_column(build_rows, build_rows);
+    auto probe_column = make_int64_column(probe_rows, build_rows * 2);
+
+    Int64HashMap data;
+    Arena arena;
+    ColumnRawPtrs build_columns {build_column.get()};
+    Int64HashMethod<Int64HashMap> build_method(build_columns, {}, nullptr);
+    emplace_keys(data, build_method, build_rows, arena);
+
+    ColumnRawPtrs probe_columns {probe_column.get()};
+    for (auto _ : state) {
+        Int64HashMethod<Int64HashMap> probe_method(probe_columns, {}, nullptr);
+        size_t matched = 0;
+        for (size_t i = 0; i < probe_rows; ++i) {
+            matched += probe_method.find_key(data, i, arena).is_found();
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetItemsProcessed(state.iterations() * probe_rows);
+}
+
+static void BM_JoinStringFind(benchmark::State& state) {
+    const size_t build_rows = state.range(0);
+    const size_t probe_rows = 4096;
+    auto build_column = make_string_column(build_rows, build_rows, 16);
+    auto probe_column = make_string_column(probe_rows, build_rows * 2, 16);
+
+    StringHashMap data;
+    Arena arena;
+    ColumnRawPtrs build_columns {build_column.get()};
+    StringHashMethod build_method(build_columns, {}, nullptr);
+    emplace_keys(data, build_method, build_rows, arena);
+
+    ColumnRawPtrs probe_columns {probe_column.get()};
+    for (auto _ : state) {
+        StringHashMethod probe_method(probe_columns, {}, nullptr);
+        size_t matched = 0;
+        for (size_t i = 0; i < probe_rows; ++i) {
+            matched += probe_method.find_key(data, i, arena).is_found();
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetItemsProcessed(state.iterations() * probe_rows);
+}
+
+BENCHMARK_TEMPLATE(BM_AggregateInt64Emplace, Int64HashMap)->Arg(16)->Arg(1024)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_AggregateInt64Emplace, Int64TwoLevelHashMap)->Arg(1024)->Arg(1 << 20);
+BENCHMARK(BM_AggregateStringEmplace)->Arg(16)->Arg(1024)->Arg(1 << 20);
+BENCHMARK(BM_JoinInt64Find)->Arg(1024)->Arg(1 << 20);
+BENCHMARK(BM_JoinStringFind)->Arg(1024)->Arg(1 << 20);
+
+} // namespace doris::vectorized
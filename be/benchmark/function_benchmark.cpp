@@ -0,0 +1,119 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_util.h"
+#include "testutil/function_utils.h"
+#include "udf/udf_internal.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/functions/simple_function_factory.h"
+
+namespace doris::vectorized {
+
+static constexpr size_t ROWS = 4096;
+
+// Runs function `name` on the columns of `block`, the result column is dropped after each run.
+static void run_function(benchmark::State& state, const std::string& name, Block& block,
+                         const DataTypePtr& return_type) {
+    ColumnNumbers arguments;
+    for (size_t i = 0; i < block.columns(); ++i) {
+        arguments.push_back(i);
+    }
+    auto function = SimpleFunctionFactory::instance().get_function(
+            name, block.get_columns_with_type_and_name(), return_type);
+    if (function == nullptr) {
+        state.SkipWithError(("function not found: " + name).c_str());
+        return;
+    }
+
+    FunctionUtils fn_utils;
+    auto* fn_ctx = fn_utils.get_fn_ctx();
+    std::vector<ColumnPtrWrapper*> constant_cols(arguments.size(), nullptr);
+    fn_ctx->impl()->set_constant_cols(constant_cols);
+    function->prepare(fn_ctx, FunctionContext::FRAGMENT_LOCAL);
+    function->prepare(fn_ctx, FunctionContext::THREAD_LOCAL);
+
+    block.insert({nullptr, return_type, "result"});
+    size_t result = block.columns() - 1;
+    for (auto _ : state) {
+        block.get_by_position(result).column = nullptr;
+        auto st = function->execute(fn_ctx, block, arguments, result, ROWS);
+        benchmark::DoNotOptimize(st);
+    }
+    block.erase(result);
+
+    function->close(fn_ctx, FunctionContext::THREAD_LOCAL);
+    function->close(fn_ctx, FunctionContext::FRAGMENT_LOCAL);
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+static Block make_int64_block() {
+    Block block;
+    block.insert({make_int64_column(ROWS, 1 << 20), std::make_shared<DataTypeInt64>(), "a"});
+    block.insert({make_int64_column(ROWS, 1 << 10), std::make_shared<DataTypeInt64>(), "b"});
+    return block;
+}
+
+static void BM_FunctionArithmetic(benchmark::State& state, const std::string& name) {
+    Block block = make_int64_block();
+    run_function(state, name, block, std::make_shared<DataTypeInt64>());
+}
+
+static void BM_FunctionComparison(benchmark::State& state, const std::string& name) {
+    Block block = make_int64_block();
+    run_function(state, name, block, std::make_shared<DataTypeUInt8>());
+}
+
+static void BM_FunctionUpper(benchmark::State& state) {
+    Block block;
+    block.insert({make_string_column(ROWS, 1024, state.range(0)),
+                  std::make_shared<DataTypeString>(), "s"});
+    run_function(state, "upper", block, std::make_shared<DataTypeString>());
+}
+
+static void BM_FunctionSubstring(benchmark::State& state) {
+    Block block;
+    block.insert({make_string_column(ROWS, 1024, state.range(0)),
+                  std::make_shared<DataTypeString>(), "s"});
+    auto pos = ColumnInt32::create(ROWS, 2);
+    auto len = ColumnInt32::create(ROWS, 8);
+    block.insert({std::move(pos), std::make_shared<DataTypeInt32>(), "pos"});
+    block.insert({std::move(len), std::make_shared<DataTypeInt32>(), "len"});
+    run_function(state, "substring", block, std::make_shared<DataTypeString>());
+}
+
+static void BM_FunctionConcat(benchmark::State& state) {
+    Block block;
+    block.insert({make_string_column(ROWS, 1024, state.range(0)),
+                  std::make_shared<DataTypeString>(), "s1"});
+    block.insert({make_string_column(ROWS, 64, state.range(0)), std::make_shared<DataTypeString>(),
+                  "s2"});
+    run_function(state, "concat", block, std::make_shared<DataTypeString>());
+}
+
+BENCHMARK_CAPTURE(BM_FunctionArithmetic, add, std::string("add"));
+BENCHMARK_CAPTURE(BM_FunctionArithmetic, multiply, std::string("multiply"));
+BENCHMARK_CAPTURE(BM_FunctionComparison, eq, std::string("eq"));
+BENCHMARK_CAPTURE(BM_FunctionComparison, lt, std::string("lt"));
+BENCHMARK(BM_FunctionUpper)->Arg(8)->Arg(64);
+BENCHMARK(BM_FunctionSubstring)->Arg(8)->Arg(64);
+BENCHMARK(BM_FunctionConcat)->Arg(8)->Arg(64);
+
+} // namespace doris::vectorized
@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "olap/rowset/segment_v2/binary_plain_page.h"
+#include "olap/rowset/segment_v2/bitshuffle_page.h"
+#include "olap/rowset/segment_v2/options.h"
+#include "olap/types.h"
+#include "util/slice.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+
+namespace doris::segment_v2 {
+
+static constexpr size_t ROWS = 65536;
+
+// Decodes a whole bitshuffle page into a vectorized column.
+template <FieldType Type, typename ColumnType>
+static void BM_BitShufflePageDecode(benchmark::State& state) {
+    using CppType = typename TypeTraits<Type>::CppType;
+    std::mt19937_64 rng(ROWS);
+    std::uniform_int_distribution<CppType> dist(0, state.range(0));
+    std::vector<CppType> values(ROWS);
+    for (auto& value : values) {
+        value = dist(rng);
+    }
+
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = ROWS * sizeof(CppType) * 2;
+    BitshufflePageBuilder<Type> page_builder(builder_options);
+    size_t count = values.size();
+    page_builder.add(reinterpret_cast<const uint8_t*>(values.data()), &count);
+    OwnedSlice page = page_builder.finish();
+
+    for (auto _ : state) {
+        BitShufflePageDecoder<Type> decoder(page.slice(), PageDecoderOptions());
+        auto st = decoder.init();
+        vectorized::MutableColumnPtr column = ColumnType::create();
+        size_t n = ROWS;
+        st = decoder.next_batch(&n, column);
+        benchmark::DoNotOptimize(st);
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+// Decodes a whole binary plain page into a ColumnString.
+static void BM_BinaryPlainPageDecode(benchmark::State& state) {
+    std::vector<std::string> strings(ROWS);
+    for (size_t i = 0; i < ROWS; ++i) {
+        strings[i] = std::to_string(i);
+        strings[i].resize(state.range(0), 'x');
+    }
+    std::vector<Slice> slices(strings.begin(), strings.end());
+
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = 0;
+    BinaryPlainPageBuilder page_builder(builder_options);
+    size_t count = slices.size();
+    page_builder.add(reinterpret_cast<const uint8_t*>(slices.data()), &count);
+    OwnedSlice page = page_builder.finish();
+
+    for (auto _ : state) {
+        BinaryPlainPageDecoder decoder(page.slice());
+        auto st = decoder.init();
+        vectorized::MutableColumnPtr column = vectorized::ColumnString::create();
+        size_t n = ROWS;
+        st = decoder.next_batch(&n, column);
+        benchmark::DoNotOptimize(st);
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+BENCHMARK_TEMPLATE(BM_BitShufflePageDecode, OLAP_FIELD_TYPE_INT, vectorized::ColumnInt32)
+        ->Arg(1 << 10)
+        ->Arg(1 << 30);
+BENCHMARK_TEMPLATE(BM_BitShufflePageDecode, OLAP_FIELD_TYPE_BIGINT, vectorized::ColumnInt64)
+        ->Arg(1 << 10)
+        ->Arg(1L << 40);
+BENCHMARK(BM_BinaryPlainPageDecode)->Arg(8)->Arg(64);
+
+} // namespace doris::segment_v2
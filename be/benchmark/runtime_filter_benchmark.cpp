@@ -0,0 +1,123 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "exprs/create_predicate_function.h"
+#include "runtime/string_value.h"
+
+namespace doris {
+
+static constexpr size_t PROBE_ROWS = 4096;
+
+static std::vector<int64_t> make_values(size_t rows, int64_t cardinality) {
+    std::mt19937_64 rng(rows);
+    std::uniform_int_distribution<int64_t> dist(0, cardinality - 1);
+    std::vector<int64_t> values(rows);
+    for (auto& value : values) {
+        value = dist(rng);
+    }
+    return values;
+}
+
+// range(0) is the number of rows the filter is built from
+static void BM_BloomFilterInsert(benchmark::State& state) {
+    auto values = make_values(state.range(0), state.range(0));
+    for (auto _ : state) {
+        std::unique_ptr<IBloomFilterFuncBase> filter(create_bloom_filter(TYPE_BIGINT));
+        filter->init(values.size(), 0.05);
+        for (auto& value : values) {
+            filter->insert(&value);
+        }
+        benchmark::DoNotOptimize(filter);
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+static void BM_BloomFilterFind(benchmark::State& state) {
+    auto build_values = make_values(state.range(0), state.range(0));
+    auto probe_values = make_values(PROBE_ROWS, state.range(0) * 2);
+    std::unique_ptr<IBloomFilterFuncBase> filter(create_bloom_filter(TYPE_BIGINT));
+    filter->init(build_values.size(), 0.05);
+    for (auto& value : build_values) {
+        filter->insert(&value);
+    }
+    for (auto _ : state) {
+        size_t matched = 0;
+        for (auto& value : probe_values) {
+            matched += filter->find(&value);
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetItemsProcessed(state.iterations() * probe_values.size());
+}
+
+static void BM_BloomFilterFindString(benchmark::State& state) {
+    auto make_strings = [](const std::vector<int64_t>& values) {
+        std::vector<std::string> strings;
+        for (auto value : values) {
+            strings.emplace_back(std::to_string(value) + "_suffix_of_the_key");
+        }
+        return strings;
+    };
+    auto build_strings = make_strings(make_values(state.range(0), state.range(0)));
+    auto probe_strings = make_strings(make_values(PROBE_ROWS, state.range(0) * 2));
+    std::unique_ptr<IBloomFilterFuncBase> filter(create_bloom_filter(TYPE_STRING));
+    filter->init(build_strings.size(), 0.05);
+    for (auto& str : build_strings) {
+        StringValue value(str);
+        filter->insert(&value);
+    }
+    std::vector<StringValue> probe_values(probe_strings.begin(), probe_strings.end());
+    for (auto _ : state) {
+        size_t matched = 0;
+        for (auto& value : probe_values) {
+            matched += filter->find(&value);
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetItemsProcessed(state.iterations() * probe_values.size());
+}
+
+static void BM_InFilterFind(benchmark::State& state) {
+    auto build_values = make_values(state.range(0), state.range(0));
+    auto probe_values = make_values(PROBE_ROWS, state.range(0) * 2);
+    std::unique_ptr<HybridSetBase> set(create_set(TYPE_BIGINT));
+    for (auto& value : build_values) {
+        set->insert(&value);
+    }
+    for (auto _ : state) {
+        size_t matched = 0;
+        for (auto& value : probe_values) {
+            matched += set->find(&value);
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetItemsProcessed(state.iterations() * probe_values.size());
+}
+
+BENCHMARK(BM_BloomFilterInsert)->Arg(1024)->Arg(1 << 20);
+BENCHMARK(BM_BloomFilterFind)->Arg(1024)->Arg(1 << 20);
+BENCHMARK(BM_BloomFilterFindString)->Arg(1024)->Arg(1 << 20);
+BENCHMARK(BM_InFilterFind)->Arg(16)->Arg(1024);
+
+} // namespace doris
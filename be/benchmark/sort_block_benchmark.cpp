@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_util.h"
+#include "vec/core/block.h"
+#include "vec/core/sort_block.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+static constexpr size_t ROWS = 65536;
+
+static Block make_block() {
+    Block block;
+    block.insert({make_int64_column(ROWS, 1024), std::make_shared<DataTypeInt64>(), "k1"});
+    block.insert({make_string_column(ROWS, ROWS, 16), std::make_shared<DataTypeString>(), "k2"});
+    return block;
+}
+
+// range(0) is the number of sort columns, range(1) is the limit (0 means a full sort)
+static void BM_SortBlock(benchmark::State& state) {
+    const Block source = make_block();
+    SortDescription description;
+    for (int i = 0; i < state.range(0); ++i) {
+        description.emplace_back(i, 1, 1);
+    }
+    for (auto _ : state) {
+        state.PauseTiming();
+        Block block = source.clone_empty();
+        for (size_t i = 0; i < block.columns(); ++i) {
+            block.get_by_position(i).column = source.get_by_position(i).column->clone_resized(ROWS);
+        }
+        state.ResumeTiming();
+        sort_block(block, description, state.range(1));
+        benchmark::DoNotOptimize(block);
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+BENCHMARK(BM_SortBlock)->Args({1, 0})->Args({2, 0})->Args({1, 100})->Args({2, 100});
+
+} // namespace doris::vectorized
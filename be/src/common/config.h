@@ -147,14 +147,21 @@ CONF_Int32(num_threads_per_core, "3");
 CONF_mBool(compress_rowbatches, "true");
 // interval between profile reports; in seconds
 CONF_mInt32(status_report_interval, "5");
-// if true, each disk will have a separate thread pool for scanner
-CONF_Bool(doris_enable_scanner_thread_pool_per_disk, "true");
 // the timeout of a work thread to wait the blocking priority queue to get a task
 CONF_mInt64(doris_blocking_priority_queue_wait_timeout_ms, "5");
 // number of olap scanner thread pool size
 CONF_Int32(doris_scanner_thread_pool_thread_num, "48");
 // number of olap scanner thread pool queue size
 CONF_Int32(doris_scanner_thread_pool_queue_size, "102400");
+// number of local queues of the scan scheduler, 0 means one queue per cpu core.
+// idle scanner threads steal tasks from the other queues.
+CONF_Int32(doris_scan_scheduler_queue_num, "0");
+// weights of resource groups in the scan scheduler, e.g. "normal:10,high:20".
+// queries share the scanner threads in proportion to the weight of their group,
+// groups not listed get weight 10.
+CONF_String(doris_scan_scheduler_group_weights, "");
+// max running time of a scanner before it yields the scanner thread to other queries
+CONF_mInt32(doris_scanner_max_run_time_ms, "200");
 // number of etl thread pool size
 CONF_Int32(etl_thread_pool_size, "8");
 // number of etl thread pool size
@@ -182,6 +189,14 @@ CONF_mInt32(max_pushdown_conditions_per_column, "1024");
 CONF_mInt32(doris_max_pushdown_conjuncts_return_rate, "90");
 // (Advanced) Maximum size of per-query receive-side buffer
 CONF_mInt32(exchg_node_buffer_size_bytes, "10485760");
+// if true, the partitioned blocks sent by vectorized data stream sender to a fragment
+// on the same backend are passed to the receiver in memory instead of by brpc.
+// Off by default: when the receiver is over its buffer limit, the local path blocks the
+// sender thread in VDataStreamRecvr::SenderQueue::add_block, so one full receiver stops
+// the sender from feeding all its other channels. By brpc, a channel only waits for its
+// own last rpc. It can be on by default once the local path waits per channel as well
+// and the hash shuffle of many sender instances on one backend is measured to be faster.
+CONF_mBool(enable_local_exchange_for_partitioned_sink, "false");
 // push_write_mbytes_per_sec
 CONF_mInt32(push_write_mbytes_per_sec, "100");
 
@@ -230,18 +245,32 @@ CONF_String(storage_page_cache_limit, "20%");
 // Percentage for index page cache
 // all storage page cache will be divided into data_page_cache and index_page_cache
 CONF_Int32(index_page_cache_percentage, "10");
+// Cache for the compressed storage pages, it keeps the pages as read from the files
+// and serves the pages evicted from the storage page cache by decompressing them.
+// 0 means disable the compressed page cache
+CONF_String(storage_compressed_page_cache_limit, "0");
 // whether to disable page cache feature in storage
 CONF_Bool(disable_storage_page_cache, "false");
 
 CONF_Bool(enable_storage_vectorization, "false");
 
 CONF_Bool(enable_low_cardinality_optimize, "false");
+// Whether the olap scanners evaluate the `=` and `IN` conjuncts of the VARCHAR and STRING
+// columns, which are not pushed to the storage, on the dictionary codes of the pages, so only
+// the rows left are decoded to strings. It only works with enable_storage_vectorization.
+CONF_mBool(enable_dict_code_filter, "true");
 
 // be policy
 // whether disable automatic compaction task
 CONF_mBool(disable_auto_compaction, "false");
 // whether enable vectorized compaction
 CONF_Bool(enable_vectorized_compaction, "false");
+// whether enable vertical compaction, which merges the key columns first and then the value
+// columns group by group, to bound the memory of compacting wide tables. It works with the
+// vectorized compaction only.
+CONF_mBool(enable_vertical_compaction, "false");
+// the number of value columns merged together in a column group of vertical compaction
+CONF_mInt32(vertical_compaction_num_columns_per_group, "5");
 // check the configuration of auto compaction in seconds when auto compaction disabled
 CONF_mInt32(check_auto_compaction_interval_seconds, "5");
 
@@ -465,6 +494,10 @@ CONF_Int32(memory_max_alignment, "16");
 // write buffer size before flush
 CONF_mInt64(write_buffer_size, "209715200");
 
+// If true, the vectorized memtable only appends the loaded blocks to a columnar buffer,
+// and sorts and aggregates the rows once when flushing instead of keeping a skiplist.
+CONF_mBool(enable_vectorized_memtable_sort_merge, "false");
+
 // following 2 configs limit the memory consumption of load process on a Backend.
 // eg: memory limit to 80% of mem limit config but up to 100GB(default)
 // NOTICE(cmy): set these default values very large because we don't want to
@@ -574,6 +607,9 @@ CONF_Int32(txn_shard_size, "1024");
 // Whether to continue to start be when load tablet from header failed.
 CONF_Bool(ignore_load_tablet_failure, "false");
 
+// The number of threads to parse metas and load tablets of each data dir at startup.
+CONF_Int32(load_tablet_threads_per_data_dir, "4");
+
 // Whether to continue to start be when load tablet from header failed.
 CONF_mBool(ignore_rowset_stale_unconsistent_delete, "false");
 
@@ -655,6 +691,15 @@ CONF_mDouble(tablet_version_graph_orphan_vertex_ratio, "0.1");
 // else we will call sync method
 CONF_mBool(runtime_filter_use_async_rpc, "true");
 
+// Before a bloom runtime filter is published, its size is halved as long as the fraction
+// of bits set stays under this ratio, so a filter sized by the planner for more rows than
+// the build side really has costs less to send and to probe. 0 disables it.
+CONF_mDouble(runtime_bloom_filter_max_fill_ratio, "0.5");
+
+// For ORDER BY ... LIMIT n, the vectorized sort node publishes the n-th value of the first
+// ordering column to the olap scan node below it, which skips the pages and rows worse than it.
+CONF_mBool(enable_topn_runtime_filter, "true");
+
 // max send batch parallelism for OlapTableSink
 // The value set by the user for send_batch_parallelism is not allowed to exceed max_send_batch_parallelism_per_job,
 // if exceed, the value of send_batch_parallelism would be max_send_batch_parallelism_per_job
@@ -667,6 +712,29 @@ CONF_Int32(send_batch_thread_pool_thread_num, "64");
 // number of send batch thread pool queue size
 CONF_Int32(send_batch_thread_pool_queue_size, "102400");
 
+// number of data pages of each column that the segment reader reads ahead
+// on the segment prefetch thread pool, 0 means disable page prefetch
+CONF_mInt32(segment_prefetch_page_num, "0");
+// number of segment prefetch thread pool size
+CONF_Int32(segment_prefetch_thread_pool_thread_num, "32");
+// number of segment prefetch thread pool queue size
+CONF_Int32(segment_prefetch_thread_pool_queue_size, "102400");
+
+// Whether to read and write the local files through io_uring. The blocking pread and
+// pwrite are used if io_uring is not supported by the kernel.
+CONF_Bool(enable_io_uring, "false");
+// the number of entries of the io_uring queue, that is the max number of reads and
+// writes in flight
+CONF_Int32(io_uring_queue_depth, "256");
+
+// the local directory, better on SSD, caching the segments on the remote storage like S3,
+// the remote segments are not cached if it is empty
+CONF_String(remote_block_cache_path, "");
+// the max bytes of the data cached in remote_block_cache_path
+CONF_Int64(remote_block_cache_capacity, "10737418240");
+// the remote segments are downloaded and cached in blocks of this size
+CONF_Int32(remote_block_cache_block_size, "1048576");
+
 // Limit the number of segment of a newly created rowset.
 // The newly created rowset may to be compacted after loading,
 // so if there are too many segment in a rowset, the compaction process
@@ -738,6 +806,37 @@ CONF_Validator(string_type_length_soft_limit_bytes,
 // is greater than object_pool_buffer_size, release the object in the unused_object_pool.
 CONF_Int32(object_pool_buffer_size, "100");
 
+// When the session variable enable_spilling is set, a vectorized hash join whose build side
+// grows beyond this size partitions its build and probe input and spills partitions to the
+// tmp dirs (grace hash join).
+CONF_mInt64(vhash_join_spill_threshold_bytes, "2147483648");
+// The number of partitions a spilling vectorized hash join splits its input into, [2, 64].
+CONF_mInt32(vhash_join_spill_partition_num, "16");
+// The max number of partition levels of a spilling vectorized hash join. A spilled partition
+// larger than vhash_join_spill_threshold_bytes is partitioned again until this depth.
+CONF_mInt32(vhash_join_spill_max_depth, "3");
+
+// A vectorized aggregation converts its hash table to a two-level one, i.e. 256 sub tables
+// selected by the hash of the key, once it holds this number of groups. The sub tables
+// are resized independently, which avoids the stall of rehashing one huge table.
+CONF_mInt64(vagg_two_level_hash_table_threshold, "100000");
+
+// When the session variable enable_spilling is set, a vectorized grouping aggregation whose
+// hash table grows beyond this size spills the aggregate states of half of its in-memory
+// partitions (by the hash of the group by keys) to the tmp dirs, and merges them back one
+// partition at a time.
+CONF_mInt64(vagg_spill_threshold_bytes, "2147483648");
+// The number of partitions a spilling vectorized aggregation splits its groups into, [2, 64].
+CONF_mInt32(vagg_spill_partition_num, "16");
+// The max number of partition levels of a spilling vectorized aggregation. A spilled partition
+// larger than vagg_spill_threshold_bytes is partitioned again until this depth.
+CONF_mInt32(vagg_spill_max_depth, "3");
+
+// When the session variable enable_spilling is set, a vectorized sort whose buffered input
+// grows beyond this size writes it to the tmp dirs as a sorted run. The runs are merged when
+// the result is read (external merge sort).
+CONF_mInt64(vsort_spill_threshold_bytes, "2147483648");
+
 } // namespace config
 
 } // namespace doris
@@ -16,16 +16,31 @@
 // under the License.
 
 #include "common/config.h"
+#include "common/logging.h"
 #include "env/env.h"
 #include "env/env_posix.h"
+#include "env/io_uring.h"
 
 namespace doris {
 
 std::shared_ptr<PosixEnv> Env::_posix_env(new PosixEnv());
+std::shared_ptr<PosixEnv> Env::_io_uring_env;
 
 // Default Posix Env
 Env* Env::Default() {
-    return _posix_env.get();
+    // chosen once, the config is not changed at runtime
+    static Env* env = []() -> Env* {
+        if (config::enable_io_uring) {
+            IOUring* io_uring = IOUring::instance();
+            if (io_uring != nullptr) {
+                _io_uring_env.reset(new IOUringEnv(io_uring));
+                return _io_uring_env.get();
+            }
+            LOG(WARNING) << "io_uring is not available, fall back to posix env";
+        }
+        return _posix_env.get();
+    }();
+    return env;
 }
 
 } // end namespace doris
\ No newline at end of file
@@ -48,6 +48,9 @@ public:
     // Return a default environment suitable for the current operating
     // system.  Sophisticated users may wish to provide their own Env
     // implementation instead of relying on this default environment.
+    //
+    // The files are read and written through io_uring if config::enable_io_uring is
+    // true and io_uring is available, see IOUringEnv.
     static Env* Default();
 
     // Create a brand new random access read-only file with the
@@ -182,6 +185,7 @@ public:
 
 private:
     static std::shared_ptr<PosixEnv> _posix_env;
+    static std::shared_ptr<PosixEnv> _io_uring_env;
 };
 
 struct FilePathDesc {
@@ -291,6 +295,12 @@ struct RandomRWFileOptions {
     Env::OpenMode mode = Env::CREATE_OR_OPEN_WITH_TRUNCATE;
 };
 
+// A range of a file to read: "data.size" bytes from "offset" are read into "data.data".
+struct ReadRange {
+    uint64_t offset = 0;
+    Slice data;
+};
+
 class RandomAccessFile {
 public:
     RandomAccessFile() {}
@@ -321,6 +331,23 @@ public:
     // Safe for concurrent use by multiple threads.
     virtual Status readv_at(uint64_t offset, const Slice* result, size_t res_cnt) const = 0;
 
+    // Reads each of the "ranges" fully, like read_at(). The ranges may be read
+    // concurrently, their buffers must not overlap.
+    //
+    // If an error was encountered, returns a non-OK status.
+    //
+    // Safe for concurrent use by multiple threads.
+    virtual Status read_batch(const ReadRange* ranges, size_t cnt) const {
+        for (size_t i = 0; i < cnt; ++i) {
+            RETURN_IF_ERROR(read_at(ranges[i].offset, &ranges[i].data));
+        }
+        return Status::OK();
+    }
+
+    // Whether read_batch() issues the reads of all the ranges at once, rather than
+    // one read after another.
+    virtual bool is_batch_read_supported() const { return false; }
+
     // read all data from this file
     virtual Status read_all(std::string* content) const = 0;
 
@@ -28,9 +28,11 @@
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <vector>
 
 #include "common/logging.h"
 #include "env/env.h"
+#include "env/io_uring.h"
 #include "gutil/gscoped_ptr.h"
 #include "gutil/macros.h"
 #include "gutil/port.h"
@@ -223,9 +225,75 @@ static Status do_writev_at(int fd, const string& filename, uint64_t offset, cons
     return Status::OK();
 }
 
+// Complete the request submitted to io_uring, the rest of a short read or write
+// is read or written by the blocking system call.
+static Status finish_io_uring_request(const IOUringRequest& req, const std::string& filename) {
+    size_t done = 0;
+    if (req.result >= 0) {
+        done = req.result;
+    } else if (req.result != -EINTR && req.result != -EAGAIN) {
+        return io_error(filename, -req.result);
+    }
+    uint64_t offset = req.offset + done;
+    std::vector<Slice> rest;
+    for (int i = 0; i < req.iov_cnt; ++i) {
+        const struct iovec& iov = req.iov[i];
+        if (done >= iov.iov_len) {
+            done -= iov.iov_len;
+            continue;
+        }
+        rest.emplace_back(static_cast<char*>(iov.iov_base) + done, iov.iov_len - done);
+        done = 0;
+    }
+    if (PREDICT_TRUE(rest.empty())) {
+        return Status::OK();
+    }
+    if (req.is_write) {
+        size_t bytes_written = 0;
+        return do_writev_at(req.fd, filename, offset, rest.data(), rest.size(), &bytes_written);
+    }
+    return do_readv_at(req.fd, filename, offset, rest.data(), rest.size());
+}
+
+static Status do_io_uring_requests(IOUring* io_uring, const std::string& filename,
+                                   std::vector<IOUringRequest>* reqs) {
+    RETURN_IF_ERROR(io_uring->submit_and_wait(reqs->data(), reqs->size()));
+    for (const auto& req : *reqs) {
+        RETURN_IF_ERROR(finish_io_uring_request(req, filename));
+    }
+    return Status::OK();
+}
+
+// Read or write the slices at the consecutive offsets from `offset` through io_uring,
+// no more than IOV_MAX slices per request.
+static Status do_io_uring_rwv_at(IOUring* io_uring, int fd, const std::string& filename,
+                                 bool is_write, uint64_t offset, const Slice* data,
+                                 size_t data_cnt) {
+    struct iovec iov[data_cnt];
+    for (size_t i = 0; i < data_cnt; i++) {
+        iov[i] = {data[i].data, data[i].size};
+    }
+
+    std::vector<IOUringRequest> reqs((data_cnt + IOV_MAX - 1) / IOV_MAX);
+    uint64_t cur_offset = offset;
+    for (size_t i = 0; i < reqs.size(); i++) {
+        IOUringRequest& req = reqs[i];
+        req.fd = fd;
+        req.is_write = is_write;
+        req.offset = cur_offset;
+        req.iov = iov + i * IOV_MAX;
+        req.iov_cnt = std::min(data_cnt - i * IOV_MAX, static_cast<size_t>(IOV_MAX));
+        for (int j = 0; j < req.iov_cnt; j++) {
+            cur_offset += req.iov[j].iov_len;
+        }
+    }
+    return do_io_uring_requests(io_uring, filename, &reqs);
+}
+
 class PosixRandomAccessFile : public RandomAccessFile {
 public:
-    PosixRandomAccessFile(std::string filename, int fd) : _filename(std::move(filename)), _fd(fd) {}
+    PosixRandomAccessFile(std::string filename, int fd, IOUring* io_uring = nullptr)
+            : _filename(std::move(filename)), _fd(fd), _io_uring(io_uring) {}
     ~PosixRandomAccessFile() override {
         int res;
         RETRY_ON_EINTR(res, close(_fd));
@@ -240,9 +308,30 @@ public:
     }
 
     Status readv_at(uint64_t offset, const Slice* result, size_t res_cnt) const override {
+        if (_io_uring != nullptr) {
+            return do_io_uring_rwv_at(_io_uring, _fd, _filename, false, offset, result, res_cnt);
+        }
         return do_readv_at(_fd, _filename, offset, result, res_cnt);
     }
 
+    Status read_batch(const ReadRange* ranges, size_t cnt) const override {
+        if (_io_uring == nullptr) {
+            return RandomAccessFile::read_batch(ranges, cnt);
+        }
+        std::vector<struct iovec> iov(cnt);
+        std::vector<IOUringRequest> reqs(cnt);
+        for (size_t i = 0; i < cnt; i++) {
+            iov[i] = {ranges[i].data.data, ranges[i].data.size};
+            reqs[i].fd = _fd;
+            reqs[i].offset = ranges[i].offset;
+            reqs[i].iov = &iov[i];
+            reqs[i].iov_cnt = 1;
+        }
+        return do_io_uring_requests(_io_uring, _filename, &reqs);
+    }
+
+    bool is_batch_read_supported() const override { return _io_uring != nullptr; }
+
     Status read_all(std::string* content) const override {
         std::fstream fs(_filename.c_str(), std::fstream::in);
         if (!fs.is_open()) {
@@ -282,15 +371,18 @@ public:
 private:
     std::string _filename;
     int _fd;
+    IOUring* _io_uring;
 };
 
 class PosixWritableFile : public WritableFile {
 public:
-    PosixWritableFile(std::string filename, int fd, uint64_t filesize, bool sync_on_close)
+    PosixWritableFile(std::string filename, int fd, uint64_t filesize, bool sync_on_close,
+                      IOUring* io_uring = nullptr)
             : _filename(std::move(filename)),
               _fd(fd),
               _sync_on_close(sync_on_close),
-              _filesize(filesize) {}
+              _filesize(filesize),
+              _io_uring(io_uring) {}
 
     ~PosixWritableFile() override {
         WARN_IF_ERROR(close(), "Failed to close file, file=" + _filename);
@@ -300,7 +392,16 @@ public:
 
     Status appendv(const Slice* data, size_t cnt) override {
         size_t bytes_written = 0;
-        RETURN_IF_ERROR(do_writev_at(_fd, _filename, _filesize, data, cnt, &bytes_written));
+        if (_io_uring != nullptr) {
+            // the slices are owned by the caller, so the writes are waited for here
+            RETURN_IF_ERROR(
+                    do_io_uring_rwv_at(_io_uring, _fd, _filename, true, _filesize, data, cnt));
+            for (size_t i = 0; i < cnt; i++) {
+                bytes_written += data[i].size;
+            }
+        } else {
+            RETURN_IF_ERROR(do_writev_at(_fd, _filename, _filesize, data, cnt, &bytes_written));
+        }
         _filesize += bytes_written;
         return Status::OK();
     }
@@ -398,6 +499,7 @@ private:
     bool _closed = false;
     uint64_t _filesize = 0;
     uint64_t _pre_allocated_size = 0;
+    IOUring* _io_uring;
 };
 
 class PosixRandomRWFile : public RandomRWFile {
@@ -499,7 +601,7 @@ Status PosixEnv::new_random_access_file(const RandomAccessFileOptions& opts,
     if (fd < 0) {
         return io_error(fname, errno);
     }
-    result->reset(new PosixRandomAccessFile(fname, fd));
+    result->reset(new PosixRandomAccessFile(fname, fd, _io_uring));
     return Status::OK();
 }
 
@@ -516,7 +618,7 @@ Status PosixEnv::new_writable_file(const WritableFileOptions& opts, const string
     if (opts.mode == MUST_EXIST) {
         RETURN_IF_ERROR(get_file_size(fname, &file_size));
     }
-    result->reset(new PosixWritableFile(fname, fd, file_size, opts.sync_on_close));
+    result->reset(new PosixWritableFile(fname, fd, file_size, opts.sync_on_close, _io_uring));
     return Status::OK();
 }
 
@@ -21,6 +21,7 @@
 
 namespace doris {
 
+class IOUring;
 class RandomAccessFile;
 class RandomRWFile;
 class WritableFile;
@@ -87,6 +88,21 @@ public:
     Status link_file(const std::string& old_path, const std::string& new_path) override;
 
     Status get_space_info(const std::string& path, int64_t* capacity, int64_t* available) override;
+
+protected:
+    // the ring the random access files and the writable files are read and written
+    // through, nullptr to use the blocking system calls
+    IOUring* _io_uring = nullptr;
+};
+
+// A PosixEnv whose random access files and writable files submit their reads and writes
+// to io_uring. The slices of a readv_at() or an appendv(), and the ranges of a read_batch()
+// are submitted together and served by the kernel concurrently, so a few threads can keep
+// many reads in flight on a fast device.
+class IOUringEnv : public PosixEnv {
+public:
+    explicit IOUringEnv(IOUring* io_uring) { _io_uring = io_uring; }
+    ~IOUringEnv() override {}
 };
 
 } // namespace doris
\ No newline at end of file
@@ -0,0 +1,291 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "env/io_uring.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define DORIS_HAVE_IO_URING
+#endif
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "util/countdown_latch.h"
+#include "util/errno.h"
+
+namespace doris {
+
+IOUring* IOUring::instance() {
+    // never destroyed, the files may still be read by other static objects at exit
+    static IOUring* ring = []() -> IOUring* {
+        std::unique_ptr<IOUring> ring;
+        Status st = create(config::io_uring_queue_depth, &ring);
+        if (!st.ok()) {
+            LOG(WARNING) << "io_uring is not available: " << st;
+            return nullptr;
+        }
+        return ring.release();
+    }();
+    return ring;
+}
+
+Status IOUring::create(uint32_t entries, std::unique_ptr<IOUring>* ring) {
+    std::unique_ptr<IOUring> res(new IOUring());
+    RETURN_IF_ERROR(res->_init(entries));
+    *ring = std::move(res);
+    return Status::OK();
+}
+
+Status IOUring::submit_and_wait(IOUringRequest* reqs, size_t cnt) {
+    if (cnt == 0) {
+        return Status::OK();
+    }
+    CountDownLatch latch(cnt);
+    for (size_t i = 0; i < cnt; ++i) {
+        reqs[i].result = 0;
+        reqs[i].latch = &latch;
+    }
+    Status st = _submit(reqs, cnt);
+    // the submitted requests refer to the buffers of the caller, so they must be completed
+    // even if some others failed to be submitted
+    latch.wait();
+    return st;
+}
+
+#ifdef DORIS_HAVE_IO_URING
+
+static int io_uring_setup(uint32_t entries, struct io_uring_params* params) {
+    return syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int io_uring_enter(int ring_fd, unsigned to_submit, unsigned min_complete,
+                          unsigned flags) {
+    return syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0);
+}
+
+Status IOUring::_init(uint32_t entries) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = io_uring_setup(std::max(entries, 1U), &params);
+    if (fd < 0) {
+        return Status::IOError("failed to set up io_uring", errno, errno_to_string(errno));
+    }
+    _ring_fd = fd;
+
+    _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+    // the submission queue ring and the completion queue ring are mapped together
+    single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+#endif
+    if (single_mmap) {
+        _sq_ring_size = _cq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+    }
+    _sq_ptr = mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   fd, IORING_OFF_SQ_RING);
+    if (_sq_ptr == MAP_FAILED) {
+        _sq_ptr = nullptr;
+        return Status::IOError("failed to map io_uring submission queue", errno,
+                               errno_to_string(errno));
+    }
+    if (single_mmap) {
+        _cq_ptr = _sq_ptr;
+    } else {
+        _cq_ptr = mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       fd, IORING_OFF_CQ_RING);
+        if (_cq_ptr == MAP_FAILED) {
+            _cq_ptr = nullptr;
+            return Status::IOError("failed to map io_uring completion queue", errno,
+                                   errno_to_string(errno));
+        }
+    }
+    _sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                      IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        return Status::IOError("failed to map io_uring submission queue entries", errno,
+                               errno_to_string(errno));
+    }
+    _sqes = static_cast<struct io_uring_sqe*>(sqes);
+
+    auto* sq_ptr = static_cast<char*>(_sq_ptr);
+    _sq_head = reinterpret_cast<unsigned*>(sq_ptr + params.sq_off.head);
+    _sq_tail = reinterpret_cast<unsigned*>(sq_ptr + params.sq_off.tail);
+    _sq_mask = *reinterpret_cast<unsigned*>(sq_ptr + params.sq_off.ring_mask);
+    _sq_array = reinterpret_cast<unsigned*>(sq_ptr + params.sq_off.array);
+    _sq_entries = params.sq_entries;
+
+    auto* cq_ptr = static_cast<char*>(_cq_ptr);
+    _cq_head = reinterpret_cast<unsigned*>(cq_ptr + params.cq_off.head);
+    _cq_tail = reinterpret_cast<unsigned*>(cq_ptr + params.cq_off.tail);
+    _cq_mask = *reinterpret_cast<unsigned*>(cq_ptr + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<struct io_uring_cqe*>(cq_ptr + params.cq_off.cqes);
+
+    _reap_thread = std::thread(&IOUring::_reap, this);
+    return Status::OK();
+}
+
+IOUring::~IOUring() {
+    if (_reap_thread.joinable()) {
+        _stopped = true;
+        {
+            // wake up the reaping thread by a no-op request
+            std::lock_guard<std::mutex> l(_sq_lock);
+            unsigned tail = *_sq_tail;
+            unsigned index = tail & _sq_mask;
+            memset(&_sqes[index], 0, sizeof(struct io_uring_sqe));
+            _sqes[index].opcode = IORING_OP_NOP;
+            _sq_array[index] = index;
+            __atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+            int ret;
+            do {
+                ret = io_uring_enter(_ring_fd, 1, 0, 0);
+            } while (ret < 0 && errno == EINTR);
+        }
+        _reap_thread.join();
+    }
+    if (_sqes != nullptr) {
+        munmap(_sqes, _sqes_size);
+    }
+    if (_cq_ptr != nullptr && _cq_ptr != _sq_ptr) {
+        munmap(_cq_ptr, _cq_ring_size);
+    }
+    if (_sq_ptr != nullptr) {
+        munmap(_sq_ptr, _sq_ring_size);
+    }
+    if (_ring_fd >= 0) {
+        close(_ring_fd);
+    }
+}
+
+Status IOUring::_submit(IOUringRequest* reqs, size_t cnt) {
+    std::unique_lock<std::mutex> l(_sq_lock);
+    size_t next = 0;
+    while (next < cnt) {
+        _sq_cv.wait(l, [this] { return _inflight < _sq_entries; });
+        // without SQPOLL, the entries put before are all consumed by io_uring_enter(),
+        // so the whole submission queue is free
+        unsigned tail = *_sq_tail;
+        DCHECK_EQ(tail, __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE));
+        unsigned n = std::min<size_t>(cnt - next, _sq_entries - _inflight);
+        for (unsigned i = 0; i < n; ++i) {
+            const IOUringRequest& req = reqs[next + i];
+            unsigned index = (tail + i) & _sq_mask;
+            struct io_uring_sqe* sqe = &_sqes[index];
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = req.is_write ? IORING_OP_WRITEV : IORING_OP_READV;
+            sqe->fd = req.fd;
+            sqe->off = req.offset;
+            sqe->addr = reinterpret_cast<uint64_t>(req.iov);
+            sqe->len = req.iov_cnt;
+            sqe->user_data = reinterpret_cast<uint64_t>(&reqs[next + i]);
+            _sq_array[index] = index;
+        }
+        __atomic_store_n(_sq_tail, tail + n, __ATOMIC_RELEASE);
+        _inflight += n;
+
+        unsigned consumed = 0;
+        while (consumed < n) {
+            int ret = io_uring_enter(_ring_fd, n - consumed, 0, 0);
+            int err = errno;
+            consumed = __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE) - tail;
+            if (ret >= 0 || err == EINTR || err == EAGAIN || err == EBUSY) {
+                continue;
+            }
+            // take back the entries not consumed by the kernel, and fail them and the
+            // requests not put to the queue yet
+            __atomic_store_n(_sq_tail, tail + consumed, __ATOMIC_RELEASE);
+            _inflight -= n - consumed;
+            for (size_t i = next + consumed; i < cnt; ++i) {
+                reqs[i].result = -err;
+                reqs[i].latch->count_down();
+            }
+            return Status::IOError("failed to submit io_uring requests", err,
+                                   errno_to_string(err));
+        }
+        next += n;
+    }
+    return Status::OK();
+}
+
+void IOUring::_reap() {
+    while (true) {
+        unsigned head = *_cq_head;
+        unsigned tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+        if (head == tail) {
+            if (_stopped) {
+                break;
+            }
+            int ret = io_uring_enter(_ring_fd, 0, 1, IORING_ENTER_GETEVENTS);
+            if (ret < 0 && errno != EINTR) {
+                LOG(WARNING) << "failed to wait for io_uring completions: "
+                             << errno_to_string(errno);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            continue;
+        }
+        unsigned reaped = 0;
+        for (; head != tail; ++head) {
+            const struct io_uring_cqe& cqe = _cqes[head & _cq_mask];
+            auto* req = reinterpret_cast<IOUringRequest*>(cqe.user_data);
+            if (req == nullptr) {
+                // the no-op request to stop
+                continue;
+            }
+            req->result = cqe.res;
+            // the request may be destroyed by the submitter once it is counted down
+            req->latch->count_down();
+            ++reaped;
+        }
+        __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+        if (reaped > 0) {
+            std::lock_guard<std::mutex> l(_sq_lock);
+            _inflight -= reaped;
+        }
+        _sq_cv.notify_all();
+    }
+}
+
+#else
+
+Status IOUring::_init(uint32_t entries) {
+    return Status::NotSupported("io_uring is not supported by the build environment");
+}
+
+IOUring::~IOUring() {}
+
+Status IOUring::_submit(IOUringRequest* reqs, size_t cnt) {
+    for (size_t i = 0; i < cnt; ++i) {
+        reqs[i].result = -ENOSYS;
+        reqs[i].latch->count_down();
+    }
+    return Status::NotSupported("io_uring is not supported by the build environment");
+}
+
+void IOUring::_reap() {}
+
+#endif
+
+} // namespace doris
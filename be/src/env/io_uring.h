@@ -0,0 +1,128 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <sys/uio.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "common/status.h"
+#include "gutil/macros.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace doris {
+
+class CountDownLatch;
+
+// A read or write of `iov` at `offset` of the file `fd`, submitted to IOUring.
+struct IOUringRequest {
+    int fd = -1;
+    bool is_write = false;
+    uint64_t offset = 0;
+    const struct iovec* iov = nullptr;
+    int iov_cnt = 0;
+    // set on completion: the number of bytes read or written, or -errno on failure.
+    // Like preadv and pwritev, a request may be completed with fewer bytes than requested.
+    int32_t result = 0;
+
+    // signaled when the request is completed, owned by the submitter
+    CountDownLatch* latch = nullptr;
+};
+
+// An io_uring instance shared by all the threads of the process.
+//
+// The submission queue is filled under a lock and the requests are submitted by one
+// io_uring_enter() per batch, the completions are reaped by a background thread which
+// signals the submitters. So a thread submitting a batch of requests is blocked only once,
+// while the kernel serves the requests concurrently.
+//
+// The ring is set up with the raw system calls and no liburing, the kernel must be 5.1
+// or newer. instance() returns nullptr when io_uring is not available, for example it is
+// not supported by the kernel or is forbidden by the seccomp policy of the container.
+class IOUring {
+public:
+    // Return the ring of the process with `config::io_uring_queue_depth` entries,
+    // or nullptr if io_uring is not available.
+    static IOUring* instance();
+
+    // Set up a ring with at least `entries` entries, `*ring` is nullptr on failure.
+    static Status create(uint32_t entries, std::unique_ptr<IOUring>* ring);
+
+    ~IOUring();
+
+    // Submit the requests, and wait until all of them are completed.
+    // The returned status tells whether the requests are submitted, the result of each
+    // request is set in IOUringRequest::result.
+    Status submit_and_wait(IOUringRequest* reqs, size_t cnt);
+
+private:
+    IOUring() = default;
+
+    Status _init(uint32_t entries);
+
+    // Put the requests to the submission queue and submit them to the kernel, waiting for
+    // free entries if too many requests are in flight. The requests which are not submitted
+    // because of an error are completed with the error.
+    Status _submit(IOUringRequest* reqs, size_t cnt);
+
+    // the loop of the thread reaping the completions
+    void _reap();
+
+    int _ring_fd = -1;
+
+    // the submission queue ring and its entries, `_sq_tail` is only written by the
+    // submitters under `_sq_lock`
+    void* _sq_ptr = nullptr;
+    size_t _sq_ring_size = 0;
+    unsigned* _sq_head = nullptr;
+    unsigned* _sq_tail = nullptr;
+    unsigned _sq_mask = 0;
+    unsigned* _sq_array = nullptr;
+    struct io_uring_sqe* _sqes = nullptr;
+    size_t _sqes_size = 0;
+    unsigned _sq_entries = 0;
+
+    // the completion queue ring, `_cq_head` is only written by the reaping thread
+    void* _cq_ptr = nullptr;
+    size_t _cq_ring_size = 0;
+    unsigned* _cq_head = nullptr;
+    unsigned* _cq_tail = nullptr;
+    unsigned _cq_mask = 0;
+    struct io_uring_cqe* _cqes = nullptr;
+
+    std::mutex _sq_lock;
+    // signaled when the requests in flight are completed
+    std::condition_variable _sq_cv;
+    // the number of requests submitted but not reaped, no more than `_sq_entries` to
+    // never overflow the completion queue
+    unsigned _inflight = 0;
+
+    std::thread _reap_thread;
+    std::atomic<bool> _stopped {false};
+
+    DISALLOW_COPY_AND_ASSIGN(IOUring);
+};
+
+} // namespace doris
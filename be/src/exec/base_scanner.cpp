@@ -27,7 +27,13 @@
 #include "runtime/mem_tracker.h"
 #include "runtime/raw_value.h"
 #include "runtime/runtime_state.h"
+#include "runtime/string_value.h"
 #include "runtime/tuple.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_common.h"
+#include "vec/core/block.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
 
 namespace doris {
 
@@ -280,10 +286,265 @@ void BaseScanner::free_expr_local_allocations() {
     }
 }
 
+// `value < col` is `col > value`
+static TExprOpcode::type swap_op(TExprOpcode::type op) {
+    switch (op) {
+    case TExprOpcode::LT:
+        return TExprOpcode::GT;
+    case TExprOpcode::LE:
+        return TExprOpcode::GE;
+    case TExprOpcode::GT:
+        return TExprOpcode::LT;
+    case TExprOpcode::GE:
+        return TExprOpcode::LE;
+    default:
+        return op;
+    }
+}
+
+static bool get_int_value(PrimitiveType type, void* value, int64_t* int_value) {
+    switch (type) {
+    case TYPE_TINYINT:
+        *int_value = *reinterpret_cast<int8_t*>(value);
+        return true;
+    case TYPE_SMALLINT:
+        *int_value = *reinterpret_cast<int16_t*>(value);
+        return true;
+    case TYPE_INT:
+        *int_value = *reinterpret_cast<int32_t*>(value);
+        return true;
+    case TYPE_BIGINT:
+        *int_value = *reinterpret_cast<int64_t*>(value);
+        return true;
+    default:
+        return false;
+    }
+}
+
+std::vector<SrcSlotPredicate> BaseScanner::get_src_slot_predicates() {
+    std::vector<SrcSlotPredicate> predicates;
+    for (auto ctx : _pre_filter_ctxs) {
+        Expr* pred = ctx->root();
+        if (pred->node_type() != TExprNodeType::BINARY_PRED) {
+            continue;
+        }
+        switch (pred->op()) {
+        case TExprOpcode::EQ:
+        case TExprOpcode::LT:
+        case TExprOpcode::LE:
+        case TExprOpcode::GT:
+        case TExprOpcode::GE:
+            break;
+        default:
+            continue;
+        }
+        for (int child_idx = 0; child_idx < 2; ++child_idx) {
+            Expr* slot_expr = pred->get_child(child_idx);
+            Expr* literal = pred->get_child(1 - child_idx);
+            std::vector<SlotId> slot_ids;
+            if (Expr::type_without_cast(slot_expr) != TExprNodeType::SLOT_REF ||
+                slot_expr->get_slot_ids(&slot_ids) != 1 || !literal->is_constant()) {
+                continue;
+            }
+            int slot_index = 0;
+            while (slot_index < _src_slot_descs.size() &&
+                   _src_slot_descs[slot_index]->id() != slot_ids[0]) {
+                ++slot_index;
+            }
+            if (slot_index == _src_slot_descs.size()) {
+                continue;
+            }
+            void* value = ctx->get_value(literal, nullptr);
+            if (value == nullptr) {
+                continue;
+            }
+            SrcSlotPredicate predicate;
+            predicate.slot_index = slot_index;
+            predicate.op = child_idx == 0 ? pred->op() : swap_op(pred->op());
+            predicate.is_int = get_int_value(slot_expr->type().type, value, &predicate.int_value);
+            if (!predicate.is_int) {
+                // a cast to other types may change the order
+                if (slot_expr->node_type() != TExprNodeType::SLOT_REF ||
+                    !slot_expr->type().is_string_type()) {
+                    continue;
+                }
+                predicate.string_value = reinterpret_cast<StringValue*>(value)->to_string();
+            }
+            predicates.push_back(std::move(predicate));
+        }
+    }
+    return predicates;
+}
+
+Status BaseScanner::init_vexpr_ctxes() {
+    _src_tuple_desc = _state->desc_tbl().get_tuple_descriptor(_params.src_tuple_id);
+    std::map<SlotId, int> src_column_of_slot;
+    for (auto slot_desc : _src_tuple_desc->slots()) {
+        int index = 0;
+        while (index < _src_slot_descs.size() && _src_slot_descs[index] != slot_desc) {
+            ++index;
+        }
+        src_column_of_slot.emplace(slot_desc->id(), _src_slot_index.size());
+        _src_slot_index.push_back(index == _src_slot_descs.size() ? -1 : index);
+    }
+
+    if (!_pre_filter_texprs.empty()) {
+        RETURN_IF_ERROR(vectorized::VExpr::create_expr_trees(
+                _state->obj_pool(), _pre_filter_texprs, &_vpre_filter_ctxs));
+        RETURN_IF_ERROR(vectorized::VExpr::prepare(_vpre_filter_ctxs, _state, *_row_desc,
+                                                   _mem_tracker));
+        RETURN_IF_ERROR(vectorized::VExpr::open(_vpre_filter_ctxs, _state));
+    }
+
+    // init_expr_ctxes() has checked the exprs and the slot map
+    bool has_slot_id_map = _params.__isset.dest_sid_to_src_sid_without_trans;
+    for (auto slot_desc : _dest_tuple_desc->slots()) {
+        if (!slot_desc->is_materialized()) {
+            continue;
+        }
+        vectorized::VExprContext* ctx = nullptr;
+        RETURN_IF_ERROR(vectorized::VExpr::create_expr_tree(
+                _state->obj_pool(), _params.expr_of_dest_slot.at(slot_desc->id()), &ctx));
+        _dest_vexpr_ctxs.push_back(ctx);
+        int src_column = -1;
+        if (has_slot_id_map) {
+            auto it = _params.dest_sid_to_src_sid_without_trans.find(slot_desc->id());
+            if (it != _params.dest_sid_to_src_sid_without_trans.end()) {
+                src_column = src_column_of_slot.at(it->second);
+            }
+        }
+        _src_column_of_dest.push_back(src_column);
+    }
+    RETURN_IF_ERROR(
+            vectorized::VExpr::prepare(_dest_vexpr_ctxs, _state, *_row_desc, _mem_tracker));
+    return vectorized::VExpr::open(_dest_vexpr_ctxs, _state);
+}
+
+Status BaseScanner::fill_src_block(
+        const TBrokerRangeDesc& range, size_t num_rows,
+        const std::function<Status(int, const SlotDescriptor*, vectorized::IColumn*)>& read_column,
+        vectorized::Block* block) {
+    int num_of_columns_from_file = range.__isset.num_of_columns_from_file
+                                           ? range.num_of_columns_from_file
+                                           : _src_slot_descs.size();
+    const auto& src_slots = _src_tuple_desc->slots();
+    for (int i = 0; i < src_slots.size(); ++i) {
+        auto slot_desc = src_slots[i];
+        auto column = slot_desc->get_empty_mutable_column();
+        int index = _src_slot_index[i];
+        if (index < 0) {
+            // not used by any expr
+            column->insert_many_defaults(num_rows);
+        } else if (index < num_of_columns_from_file) {
+            column->reserve(num_rows);
+            RETURN_IF_ERROR(read_column(index, slot_desc, column.get()));
+        } else {
+            // values of columns from path can not be null
+            const std::string& value = range.columns_from_path[index - num_of_columns_from_file];
+            for (size_t row = 0; row < num_rows; ++row) {
+                column->insert_data(value.data(), value.size());
+            }
+        }
+        block->insert(vectorized::ColumnWithTypeAndName(
+                std::move(column), slot_desc->get_data_type_ptr(), slot_desc->col_name()));
+    }
+    return Status::OK();
+}
+
+Status BaseScanner::fill_dest_columns(vectorized::Block* src_block,
+                                      std::vector<vectorized::MutableColumnPtr>& columns,
+                                      const std::vector<vectorized::ColumnPtr>& parsed_columns) {
+    // filter src block by preceding filter first
+    size_t num_src_columns = src_block->columns();
+    size_t rows = src_block->rows();
+    for (auto ctx : _vpre_filter_ctxs) {
+        RETURN_IF_ERROR(vectorized::VExprContext::filter_block(ctx, src_block, num_src_columns));
+    }
+    _counter->num_rows_unselected += rows - src_block->rows();
+    rows = src_block->rows();
+    if (rows == 0) {
+        return Status::OK();
+    }
+
+    vectorized::IColumn::Filter filter(rows, 1);
+    std::vector<vectorized::ColumnPtr> results;
+    int ctx_idx = 0;
+    for (auto slot_desc : _dest_tuple_desc->slots()) {
+        if (!slot_desc->is_materialized()) {
+            continue;
+        }
+        int dest_index = ctx_idx++;
+        if (dest_index < parsed_columns.size() && parsed_columns[dest_index] != nullptr) {
+            results.push_back(parsed_columns[dest_index]);
+            continue;
+        }
+        int result_column_id = -1;
+        RETURN_IF_ERROR(_dest_vexpr_ctxs[dest_index]->execute(src_block, &result_column_id));
+        vectorized::ColumnPtr result = src_block->get_by_position(result_column_id)
+                                               .column->convert_to_full_column_if_const();
+        if (auto* nullable_column =
+                    vectorized::check_and_get_column<vectorized::ColumnNullable>(*result)) {
+            const auto& null_map = nullable_column->get_null_map_data();
+            for (size_t row = 0; row < rows; ++row) {
+                if (null_map[row] && filter[row]) {
+                    RETURN_IF_ERROR(_check_null_value(*src_block, slot_desc, dest_index, row,
+                                                      &filter[row]));
+                }
+            }
+            if (!slot_desc->is_nullable()) {
+                result = nullable_column->get_nested_column_ptr();
+            }
+        } else if (slot_desc->is_nullable()) {
+            result = vectorized::make_nullable(result);
+        }
+        results.push_back(std::move(result));
+    }
+
+    size_t count = vectorized::count_bytes_in_filter(filter);
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (count == rows) {
+            columns[i]->insert_range_from(*results[i], 0, rows);
+        } else {
+            columns[i]->insert_range_from(*results[i]->filter(filter, count), 0, count);
+        }
+    }
+    return Status::OK();
+}
+
+Status BaseScanner::_check_null_value(const vectorized::Block& src_block,
+                                      const SlotDescriptor* slot_desc, int dest_index,
+                                      size_t row, uint8_t* filter) {
+    std::string error_msg;
+    int src_column = _src_column_of_dest[dest_index];
+    // If _strict_mode is false, _src_column_of_dest is all -1
+    if (_strict_mode && src_column >= 0 &&
+        !src_block.get_by_position(src_column).column->is_null_at(row)) {
+        error_msg = fmt::format(
+                "column({}) value is incorrect while strict mode is {}, src value is {}",
+                slot_desc->col_name(), _strict_mode,
+                src_block.get_by_position(src_column).column->get_data_at(row).to_string());
+    } else if (!slot_desc->is_nullable()) {
+        error_msg = fmt::format("column({}) values is null while columns is not nullable",
+                                slot_desc->col_name());
+    } else {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_state->append_error_msg_to_file(
+            [&]() -> std::string { return src_block.dump_data(row, 1); },
+            [&]() -> std::string { return error_msg; }, &_scanner_eof));
+    _counter->num_rows_filtered++;
+    *filter = 0;
+    return Status::OK();
+}
+
 void BaseScanner::close() {
     if (!_pre_filter_ctxs.empty()) {
         Expr::close(_pre_filter_ctxs, _state);
     }
+    vectorized::VExpr::close(_vpre_filter_ctxs, _state);
+    _vpre_filter_ctxs.clear();
+    vectorized::VExpr::close(_dest_vexpr_ctxs, _state);
+    _dest_vexpr_ctxs.clear();
 }
 
 } // namespace doris
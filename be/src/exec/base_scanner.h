@@ -18,6 +18,8 @@
 #ifndef BE_SRC_EXEC_BASE_SCANNER_H_
 #define BE_SRC_EXEC_BASE_SCANNER_H_
 
+#include <functional>
+
 #include "common/status.h"
 #include "exprs/expr.h"
 #include "runtime/tuple.h"
@@ -35,6 +37,9 @@ class ExprContext;
 
 namespace vectorized {
 class IColumn;
+class Block;
+class VExprContext;
+using ColumnPtr = IColumn::Ptr;
 using MutableColumnPtr = IColumn::MutablePtr;
 } // namespace vectorized
 
@@ -48,6 +53,19 @@ struct ScannerCounter {
     int64_t num_rows_unselected; // rows filtered by predicates
 };
 
+// A conjunct of the preceding filter in the form of `slot op literal`. The source slots hold
+// the text of the values in the file, so a slot cast to integer is compared as the integer
+// in the file, and a string slot is compared as bytes.
+struct SrcSlotPredicate {
+    // index in the source slots
+    int slot_index;
+    // one of EQ, LT, LE, GT, GE, with the slot on the left
+    TExprOpcode::type op;
+    bool is_int;
+    int64_t int_value;
+    std::string string_value;
+};
+
 class BaseScanner {
 public:
     BaseScanner(RuntimeState* state, RuntimeProfile* profile, const TBrokerScanRangeParams& params,
@@ -76,6 +94,28 @@ public:
     void free_expr_local_allocations();
 
 protected:
+    // Collect the conjuncts of the preceding filter which can be checked against the
+    // statistics of the file.
+    std::vector<SrcSlotPredicate> get_src_slot_predicates();
+
+    // Prepare the vectorized preceding filter and dest exprs, for the scanners which read
+    // a block of the source slots at a time.
+    Status init_vexpr_ctxes();
+
+    // Build the block of all the slots of the source tuple, `read_column(index, slot, column)`
+    // appends `num_rows` values of the index-th column read from the file to `column`.
+    Status fill_src_block(const TBrokerRangeDesc& range, size_t num_rows,
+                          const std::function<Status(int, const SlotDescriptor*,
+                                                     vectorized::IColumn*)>& read_column,
+                          vectorized::Block* block);
+
+    // Filter `src_block` by the preceding filter, evaluate the dest exprs on it and append
+    // the valid rows to `columns`. The non null entries of `parsed_columns` are the values of
+    // the dest slots which the scanner has parsed and checked itself, their exprs are skipped.
+    Status fill_dest_columns(vectorized::Block* src_block,
+                             std::vector<vectorized::MutableColumnPtr>& columns,
+                             const std::vector<vectorized::ColumnPtr>& parsed_columns = {});
+
     RuntimeState* _state;
     const TBrokerScanRangeParams& _params;
     // used for process stat
@@ -105,6 +145,15 @@ protected:
     const std::vector<TExpr> _pre_filter_texprs;
     std::vector<ExprContext*> _pre_filter_ctxs;
 
+    // Vectorized exprs, set by init_vexpr_ctxes()
+    const TupleDescriptor* _src_tuple_desc = nullptr;
+    // position in _src_slot_descs of each slot of the src tuple, -1 if it is not read
+    std::vector<int> _src_slot_index;
+    // position in the src block of the src slot of each dest slot, -1 if there is none
+    std::vector<int> _src_column_of_dest;
+    std::vector<vectorized::VExprContext*> _vpre_filter_ctxs;
+    std::vector<vectorized::VExprContext*> _dest_vexpr_ctxs;
+
     bool _strict_mode;
 
     int32_t _line_counter;
@@ -120,6 +169,9 @@ protected:
 
 private:
     Status _fill_dest_tuple(Tuple* dest_tuple, MemPool* mem_pool);
+    // Check the null value of the dest slot, `filter` is cleared if the row is invalid.
+    Status _check_null_value(const vectorized::Block& src_block, const SlotDescriptor* slot_desc,
+                             int dest_index, size_t row, uint8_t* filter);
 };
 
 } /* namespace doris */
@@ -37,6 +37,7 @@
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_pipe.h"
 #include "runtime/tuple.h"
+#include "util/simd/bits.h"
 #include "util/utf8_check.h"
 #include "common/consts.h"
 
@@ -50,6 +51,8 @@ BrokerScanner::BrokerScanner(RuntimeState* state, RuntimeProfile* profile,
         : BaseScanner(state, profile, params, pre_filter_texprs, counter),
           _ranges(ranges),
           _broker_addresses(broker_addresses),
+          _enclose(params.__isset.enclose ? static_cast<char>(params.enclose) : 0),
+          _unescaped_values_size(0),
           _cur_file_reader(nullptr),
           _cur_line_reader(nullptr),
           _cur_decompressor(nullptr),
@@ -283,7 +286,8 @@ Status BrokerScanner::open_line_reader() {
     case TFileFormatType::FORMAT_CSV_LZOP:
     case TFileFormatType::FORMAT_CSV_DEFLATE:
         _cur_line_reader = new PlainTextLineReader(_profile, _cur_file_reader, _cur_decompressor,
-                                                   size, _line_delimiter, _line_delimiter_length);
+                                                   size, _line_delimiter, _line_delimiter_length,
+                                                   _enclose);
         break;
     case TFileFormatType::FORMAT_PROTO:
         _cur_line_reader = new PlainBinaryLineReader(_cur_file_reader);
@@ -336,6 +340,30 @@ void BrokerScanner::split_line(const Slice& line) {
         }
         delete row;
         delete[] ptr;
+    } else if (_enclose != 0) {
+        split_enclosed_line(line);
+    } else if (_value_separator_length == 1) {
+        // Find the separators of 32 bytes at a time
+        const char* value = line.data;
+        const char separator = _value_separator[0];
+        size_t start = 0;
+        size_t pos = 0;
+        for (; pos + 32 <= line.size; pos += 32) {
+            uint32_t mask = simd::bytes32_eq_to_bits32_mask(value + pos, separator);
+            while (mask != 0) {
+                size_t end = pos + __builtin_ctz(mask);
+                _split_values.emplace_back(value + start, end - start);
+                start = end + 1;
+                mask &= mask - 1;
+            }
+        }
+        for (; pos < line.size; ++pos) {
+            if (value[pos] == separator) {
+                _split_values.emplace_back(value + start, pos - start);
+                start = pos + 1;
+            }
+        }
+        _split_values.emplace_back(value + start, line.size - start);
     } else {
         const char* value = line.data;
         size_t start = 0;  // point to the start pos of next col value.
@@ -374,6 +402,89 @@ void BrokerScanner::split_line(const Slice& line) {
     }
 }
 
+void BrokerScanner::split_enclosed_line(const Slice& line) {
+    // the unescaped values are never longer than the line, so the buffer is not reallocated
+    // while the values point into it
+    if (_unescaped_values.size() < line.size) {
+        _unescaped_values.resize(line.size);
+    }
+    _unescaped_values_size = 0;
+
+    const char* value = line.data;
+    size_t start = 0;
+    bool enclosed = false;
+    size_t pos = 0;
+    if (_value_separator_length == 1) {
+        // Find the separators and the enclose chars of 32 bytes at a time, a separator after
+        // an odd number of enclose chars of the value is in it
+        const char separator = _value_separator[0];
+        for (; pos + 32 <= line.size; pos += 32) {
+            uint32_t mask = simd::bytes32_eq_to_bits32_mask(value + pos, separator) |
+                            simd::bytes32_eq_to_bits32_mask(value + pos, _enclose);
+            while (mask != 0) {
+                size_t end = pos + __builtin_ctz(mask);
+                if (value[end] == _enclose) {
+                    enclosed = !enclosed;
+                } else if (!enclosed) {
+                    append_enclosed_value(value, start, end);
+                    start = end + 1;
+                }
+                mask &= mask - 1;
+            }
+        }
+        for (; pos < line.size; ++pos) {
+            if (value[pos] == _enclose) {
+                enclosed = !enclosed;
+            } else if (!enclosed && value[pos] == separator) {
+                append_enclosed_value(value, start, pos);
+                start = pos + 1;
+            }
+        }
+    } else {
+        while (pos < line.size) {
+            if (value[pos] == _enclose) {
+                enclosed = !enclosed;
+                ++pos;
+            } else if (!enclosed && pos + _value_separator_length <= line.size &&
+                       memcmp(value + pos, _value_separator.data(), _value_separator_length) ==
+                               0) {
+                append_enclosed_value(value, start, pos);
+                pos += _value_separator_length;
+                start = pos;
+            } else {
+                ++pos;
+            }
+        }
+    }
+    append_enclosed_value(value, start, line.size);
+}
+
+void BrokerScanner::append_enclosed_value(const char* value, size_t start, size_t end) {
+    if (end - start < 2 || value[start] != _enclose || value[end - 1] != _enclose) {
+        // not enclosed, the enclose chars in it are kept
+        _split_values.emplace_back(value + start, end - start);
+        return;
+    }
+    ++start;
+    --end;
+    const char* enclose = static_cast<const char*>(memchr(value + start, _enclose, end - start));
+    if (enclose == nullptr) {
+        _split_values.emplace_back(value + start, end - start);
+        return;
+    }
+    // keep one of each doubled enclose chars
+    char* unescaped = _unescaped_values.data() + _unescaped_values_size;
+    size_t size = 0;
+    for (size_t pos = start; pos < end; ++pos) {
+        unescaped[size++] = value[pos];
+        if (value[pos] == _enclose && pos + 1 < end && value[pos + 1] == _enclose) {
+            ++pos;
+        }
+    }
+    _split_values.emplace_back(unescaped, size);
+    _unescaped_values_size += size;
+}
+
 void BrokerScanner::fill_fix_length_string(const Slice& value, MemPool* pool, char** new_value_p,
                                            const int new_value_length) {
     if (new_value_length != 0 && value.size < new_value_length) {
@@ -451,10 +562,6 @@ bool BrokerScanner::check_decimal_input(const Slice& slice, int precision, int s
     return true;
 }
 
-bool is_null(const Slice& slice) {
-    return slice.size == 2 && slice.data[0] == '\\' && slice.data[1] == 'N';
-}
-
 // Convert one row to this tuple
 Status BrokerScanner::_convert_one_row(const Slice& line, Tuple* tuple, MemPool* tuple_pool,
                                        bool* fill_tuple) {
@@ -468,8 +575,7 @@ Status BrokerScanner::_convert_one_row(const Slice& line, Tuple* tuple, MemPool*
     return fill_dest_tuple(tuple, tuple_pool, fill_tuple);
 }
 
-// Convert one row to this tuple
-Status BrokerScanner::_line_to_src_tuple(const Slice& line) {
+Status BrokerScanner::_line_split_to_values(const Slice& line) {
     bool is_proto_format = _file_format_type == TFileFormatType::FORMAT_PROTO;
     if (!is_proto_format && !validate_utf8(line.data, line.size)) {
         RETURN_IF_ERROR(_state->append_error_msg_to_file(
@@ -546,10 +652,21 @@ Status BrokerScanner::_line_to_src_tuple(const Slice& line) {
         }
     }
 
+    _success = true;
+    return Status::OK();
+}
+
+// Convert one row to this tuple
+Status BrokerScanner::_line_to_src_tuple(const Slice& line) {
+    RETURN_IF_ERROR(_line_split_to_values(line));
+    if (!_success) {
+        return Status::OK();
+    }
+
     for (int i = 0; i < _split_values.size(); ++i) {
         auto slot_desc = _src_slot_descs[i];
         const Slice& value = _split_values[i];
-        if (slot_desc->is_nullable() && is_null(value)) {
+        if (slot_desc->is_nullable() && is_null_value(value)) {
             _src_tuple->set_null(slot_desc->null_indicator_offset());
             continue;
         }
@@ -560,11 +677,11 @@ Status BrokerScanner::_line_to_src_tuple(const Slice& line) {
         str_slot->len = value.size;
     }
 
+    const TBrokerRangeDesc& range = _ranges.at(_next_range - 1);
     if (range.__isset.num_of_columns_from_file) {
-        fill_slots_of_columns_from_path(range.num_of_columns_from_file, columns_from_path);
+        fill_slots_of_columns_from_path(range.num_of_columns_from_file, range.columns_from_path);
     }
 
-    _success = true;
     return Status::OK();
 }
 
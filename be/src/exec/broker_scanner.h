@@ -75,8 +75,15 @@ protected:
     // Read next buffer from reader
     Status open_next_reader();
 
+    // Validate and split one line to _split_values, _success is false if it is an invalid row
+    Status _line_split_to_values(const Slice& line);
+
     Status _line_to_src_tuple(const Slice& line);
 
+    static bool is_null_value(const Slice& value) {
+        return value.size == 2 && value.data[0] == '\\' && value.data[1] == 'N';
+    }
+
 private:
     Status open_file_reader();
     Status create_decompressor(TFileFormatType::type type);
@@ -85,6 +92,12 @@ private:
     // Split one text line to values
     void split_line(const Slice& line);
 
+    // Split one text line whose values may be enclosed by _enclose
+    void split_enclosed_line(const Slice& line);
+
+    // Append the value of line[start, end) to _split_values, without the enclose chars
+    void append_enclosed_value(const char* value, size_t start, size_t end);
+
     void fill_fix_length_string(const Slice& value, MemPool* pool, char** new_value_p,
                                 int new_value_length);
 
@@ -105,6 +118,11 @@ protected:
     TFileFormatType::type _file_format_type;
     int _value_separator_length;
     int _line_delimiter_length;
+    // 0 if the values are not enclosed
+    char _enclose;
+    // holds the enclosed values which have doubled enclose chars in them, without one of each
+    std::string _unescaped_values;
+    size_t _unescaped_values_size;
 
     // Reader
     FileReader* _cur_file_reader;
@@ -35,8 +35,6 @@
 #include "runtime/runtime_state.h"
 #include "runtime/string_value.h"
 #include "runtime/tuple_row.h"
-#include "util/priority_thread_pool.hpp"
-#include "util/priority_work_stealing_thread_pool.hpp"
 #include "util/runtime_profile.h"
 
 namespace doris {
@@ -137,6 +135,8 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
             ADD_COUNTER(_segment_profile, "RowsConditionsFiltered", TUnit::UNIT);
     _key_range_filtered_counter =
             ADD_COUNTER(_segment_profile, "RowsKeyRangeFiltered", TUnit::UNIT);
+    _runtime_conditions_filtered_counter =
+            ADD_COUNTER(_segment_profile, "RowsRuntimeConditionsFiltered", TUnit::UNIT);
 
     _io_timer = ADD_TIMER(_segment_profile, "IOTimer");
     _decompressor_timer = ADD_TIMER(_segment_profile, "DecompressorTimer");
@@ -147,6 +147,12 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
 
     _total_pages_num_counter = ADD_COUNTER(_segment_profile, "TotalPagesNum", TUnit::UNIT);
     _cached_pages_num_counter = ADD_COUNTER(_segment_profile, "CachedPagesNum", TUnit::UNIT);
+    _compressed_cached_pages_num_counter =
+            ADD_COUNTER(_segment_profile, "CompressedCachedPagesNum", TUnit::UNIT);
+    _prefetch_pages_hit_counter =
+            ADD_COUNTER(_segment_profile, "PrefetchPagesHitNum", TUnit::UNIT);
+    _prefetch_pages_miss_counter =
+            ADD_COUNTER(_segment_profile, "PrefetchPagesMissNum", TUnit::UNIT);
 
     _bitmap_index_filter_counter =
             ADD_COUNTER(_segment_profile, "RowsBitmapIndexFiltered", TUnit::UNIT);
@@ -756,6 +762,8 @@ Status OlapScanNode::start_scan_thread(RuntimeState* state) {
         _transfer_done = true;
         return Status::OK();
     }
+    _scan_share = state->exec_env()->scan_scheduler()->get_or_create_share(
+            state->query_id(), _resource_info != nullptr ? _resource_info->group : "");
 
     // ranges constructed from scan keys
     std::vector<std::unique_ptr<OlapScanRange>> cond_ranges;
@@ -1371,19 +1379,10 @@ void OlapScanNode::transfer_thread(RuntimeState* state) {
 
     ThreadPoolToken* thread_token = state->get_query_fragments_ctx()->get_token();
 
-    /*********************************
-     * The basic strategy of priority scheduling:
-     * 1. Determine the initial nice value by querying the number of split ranges
-     *    The more the number of Ranges, the more likely it is to be recognized as a large query, and the smaller the nice value
-     * 2. Adjust the nice value by querying the accumulated data volume
-     *    The more data read, the more likely it is to be regarded as a large query, and the smaller the nice value
-     * 3. Judge the priority of the query by the nice value
-     *    The larger the nice value, the more preferentially obtained query resources
-     * 4. Regularly increase the priority of the remaining tasks in the queue to avoid starvation for large queries
-     *********************************/
-    PriorityThreadPool* thread_pool = state->exec_env()->scan_thread_pool();
+    // The scanners share the threads of the ScanScheduler with the vectorized scanners,
+    // the queries which have used less cpu time run first.
+    ScanScheduler* scan_scheduler = state->exec_env()->scan_scheduler();
     _total_assign_num = 0;
-    _nice = 18 + std::max(0, 2 - (int)_olap_scanners.size() / 5);
     std::list<OlapScanner*> olap_scanners;
 
     int64_t mem_limit = _scanner_mem_tracker->limit();
@@ -1455,15 +1454,14 @@ void OlapScanNode::transfer_thread(RuntimeState* state) {
             }
         } else {
             while (iter != olap_scanners.end()) {
-                PriorityThreadPool::Task task;
-                task.work_function = std::bind(&OlapScanNode::scanner_thread, this, *iter);
-                task.priority = _nice;
-                task.queue_id = state->exec_env()->store_path_to_index((*iter)->scan_disk());
                 (*iter)->start_wait_worker_timer();
-                if (thread_pool->offer(task)) {
+                // the scanners of a disk are put on the same local queue
+                if (scan_scheduler->submit(
+                            _scan_share, std::bind(&OlapScanNode::scanner_thread, this, *iter),
+                            state->exec_env()->store_path_to_index((*iter)->scan_disk()))) {
                     olap_scanners.erase(iter++);
                 } else {
-                    LOG(FATAL) << "Failed to assign scanner task to thread pool!";
+                    LOG(FATAL) << "Failed to assign scanner task to scan scheduler!";
                 }
                 ++_total_assign_num;
             }
@@ -1474,13 +1472,6 @@ void OlapScanNode::transfer_thread(RuntimeState* state) {
             // 1 scanner idle task not empty, assign new scanner task
             std::unique_lock<std::mutex> l(_scan_batches_lock);
 
-            // scanner_row_num = 16k
-            // 16k * 10 * 12 * 8 = 15M(>2s)  --> nice=10
-            // 16k * 20 * 22 * 8 = 55M(>6s)  --> nice=0
-            while (_nice > 0 && _total_assign_num > (22 - _nice) * (20 - _nice) * 6) {
-                --_nice;
-            }
-
             // 2 wait when all scanner are running & no result in queue
             while (UNLIKELY(_running_thread == assigned_thread_num && _scan_row_batches.empty() &&
                             !_scanner_done)) {
@@ -1558,6 +1549,7 @@ void OlapScanNode::scanner_thread(OlapScanner* scanner) {
     }
 
     std::vector<ExprContext*> contexts;
+    std::vector<TCondition> runtime_conditions;
     auto& scanner_filter_apply_marks = *scanner->mutable_runtime_filter_marks();
     DCHECK(scanner_filter_apply_marks.size() == _runtime_filter_descs.size());
     for (size_t i = 0; i < scanner_filter_apply_marks.size(); i++) {
@@ -1568,8 +1560,10 @@ void OlapScanNode::scanner_thread(OlapScanner* scanner) {
             DCHECK(runtime_filter != nullptr);
             bool ready = runtime_filter->is_ready();
             if (ready) {
+                // must be called before get_prepared_context
+                runtime_filter->get_olap_conditions(*_tuple_desc, &runtime_conditions);
                 runtime_filter->get_prepared_context(&contexts, row_desc(), _expr_mem_tracker);
-                _runtime_filter_ctxs[i].apply_mark = true;
+                scanner_filter_apply_marks[i] = true;
             }
         }
     }
@@ -1582,6 +1576,11 @@ void OlapScanNode::scanner_thread(OlapScanner* scanner) {
                                      new_contexts.end());
         scanner->set_use_pushdown_conjuncts(true);
     }
+    // the filter arrived after the scan started, skip the pages not read yet which can not
+    // pass it by zone map and bloom filter index
+    if (!runtime_conditions.empty() && !eos) {
+        scanner->add_runtime_conditions(runtime_conditions);
+    }
 
     // apply to cgroup
     if (_resource_info != nullptr) {
@@ -28,6 +28,7 @@
 #include "exprs/in_predicate.h"
 #include "runtime/descriptors.h"
 #include "runtime/row_batch_interface.hpp"
+#include "runtime/scan_scheduler.h"
 #include "runtime/vectorized_row_batch.h"
 #include "util/progress_updater.h"
 #include "util/spinlock.h"
@@ -234,7 +235,8 @@ protected:
     size_t _direct_conjunct_size;
 
     int _total_assign_num;
-    int _nice;
+    // the scan time of the query, shared with the other scan nodes of the query
+    std::shared_ptr<ScanQueryShare> _scan_share;
 
     // protect _status, for many thread may change _status
     SpinLock _status_mutex;
@@ -299,6 +301,7 @@ protected:
     RuntimeProfile::Counter* _del_filtered_counter = nullptr;
     RuntimeProfile::Counter* _conditions_filtered_counter = nullptr;
     RuntimeProfile::Counter* _key_range_filtered_counter = nullptr;
+    RuntimeProfile::Counter* _runtime_conditions_filtered_counter = nullptr;
 
     RuntimeProfile::Counter* _block_seek_timer = nullptr;
     RuntimeProfile::Counter* _block_seek_counter = nullptr;
@@ -315,6 +318,13 @@ protected:
     // page read from cache
     // used by segment v2
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
+    // page decompressed from the compressed page cache
+    // used by segment v2
+    RuntimeProfile::Counter* _compressed_cached_pages_num_counter = nullptr;
+    // data page read ahead by segment prefetch or not
+    // used by segment v2
+    RuntimeProfile::Counter* _prefetch_pages_hit_counter = nullptr;
+    RuntimeProfile::Counter* _prefetch_pages_miss_counter = nullptr;
 
     // row count filtered by bitmap inverted index
     RuntimeProfile::Counter* _bitmap_index_filter_counter = nullptr;
@@ -194,7 +194,8 @@ Status OlapScanner::_init_tablet_reader_params(
     _tablet_reader_params.origin_return_columns = &_return_columns;
     _tablet_reader_params.tablet_columns_convert_to_null_set = &_tablet_columns_convert_to_null_set;
 
-    if (_aggregation || single_version) {
+    // merge-on-write tablet has no duplicated key after filtering by delete bitmap
+    if (_aggregation || single_version || _tablet->enable_unique_key_merge_on_write()) {
         _tablet_reader_params.return_columns = _return_columns;
         _tablet_reader_params.direct_mode = true;
     } else {
@@ -554,9 +555,12 @@ void OlapScanner::update_counter() {
     COUNTER_UPDATE(_parent->_bf_filtered_counter, stats.rows_bf_filtered);
     COUNTER_UPDATE(_parent->_del_filtered_counter, stats.rows_del_filtered);
     COUNTER_UPDATE(_parent->_del_filtered_counter, stats.rows_vec_del_cond_filtered);
+    COUNTER_UPDATE(_parent->_del_filtered_counter, stats.rows_del_by_bitmap);
 
     COUNTER_UPDATE(_parent->_conditions_filtered_counter, stats.rows_conditions_filtered);
     COUNTER_UPDATE(_parent->_key_range_filtered_counter, stats.rows_key_range_filtered);
+    COUNTER_UPDATE(_parent->_runtime_conditions_filtered_counter,
+                   stats.rows_runtime_conditions_filtered);
 
     COUNTER_UPDATE(_parent->_index_load_timer, stats.index_load_ns);
 
@@ -567,6 +571,10 @@ void OlapScanner::update_counter() {
 
     COUNTER_UPDATE(_parent->_total_pages_num_counter, stats.total_pages_num);
     COUNTER_UPDATE(_parent->_cached_pages_num_counter, stats.cached_pages_num);
+    COUNTER_UPDATE(_parent->_compressed_cached_pages_num_counter,
+                   stats.compressed_cached_pages_num);
+    COUNTER_UPDATE(_parent->_prefetch_pages_hit_counter, stats.prefetch_pages_hit_num);
+    COUNTER_UPDATE(_parent->_prefetch_pages_miss_counter, stats.prefetch_pages_miss_num);
 
     COUNTER_UPDATE(_parent->_bitmap_index_filter_counter, stats.rows_bitmap_index_filtered);
     COUNTER_UPDATE(_parent->_bitmap_index_filter_timer, stats.bitmap_index_filter_timer);
@@ -91,6 +91,10 @@ public:
 
     std::vector<bool>* mutable_runtime_filter_marks() { return &_runtime_filter_marks; }
 
+    void add_runtime_conditions(const std::vector<TCondition>& conditions) {
+        _tablet_reader->add_runtime_conditions(conditions);
+    }
+
     const std::vector<SlotDescriptor*>& get_query_slots() const { return _query_slots; }
 
     const std::shared_ptr<MemTracker>& mem_tracker() const { return _mem_tracker; }
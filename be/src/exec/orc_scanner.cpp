@@ -126,8 +126,6 @@ ORCScanner::ORCScanner(RuntimeState* state, RuntimeProfile* profile,
           // _splittable(params.splittable),
           _next_range(0),
           _cur_file_eof(true),
-          _total_groups(0),
-          _current_group(0),
           _rows_of_group(0),
           _current_line_of_group(0) {}
 
@@ -149,6 +147,7 @@ Status ORCScanner::open() {
         }
         _row_reader_options.include(include_cols);
     }
+    _src_slot_predicates = get_src_slot_predicates();
 
     return Status::OK();
 }
@@ -167,17 +166,14 @@ Status ORCScanner::get_next(Tuple* tuple, MemPool* tuple_pool, bool* eof, bool*
                     _cur_file_eof = false;
                 }
             }
-            if (_current_line_of_group >= _rows_of_group) { // read next stripe
-                if (_current_group >= _total_groups) {
+            if (_current_line_of_group >= _rows_of_group) { // read next batch
+                // the rows skipped by the search argument are not in the batch
+                if (!_row_reader->next(*_batch.get())) {
                     _cur_file_eof = true;
                     continue;
                 }
-                _rows_of_group = _reader->getStripe(_current_group)->getNumberOfRows();
-                _batch = _row_reader->createRowBatch(_rows_of_group);
-                _row_reader->next(*_batch.get());
-
+                _rows_of_group = _batch->numElements;
                 _current_line_of_group = 0;
-                ++_current_group;
             }
 
             const std::vector<orc::ColumnVectorBatch*>& batch_vec =
@@ -266,28 +262,7 @@ Status ORCScanner::get_next(Tuple* tuple, MemPool* tuple_pool, bool* eof, bool*
                                                   ->values[_current_line_of_group]
                                                   .toString();
                         }
-
-                        int negative = decimal_str[0] == '-' ? 1 : 0;
-                        int decimal_scale_length = decimal_str.size() - negative;
-
-                        std::string v;
-                        if (decimal_scale_length <= scale) {
-                            // decimal(5,2) : the integer of 0.01 is 1, so we should fill 0 befor integer
-                            v = std::string(negative ? "-0." : "0.");
-                            int fill_zero = scale - decimal_scale_length;
-                            while (fill_zero--) {
-                                v += "0";
-                            }
-                            if (negative) {
-                                v += decimal_str.substr(1, decimal_str.length());
-                            } else {
-                                v += decimal_str;
-                            }
-                        } else {
-                            //Orc api will fill in 0 at the end, so size must greater than scale
-                            v = decimal_str.substr(0, decimal_str.size() - scale) + "." +
-                                decimal_str.substr(decimal_str.size() - scale);
-                        }
+                        std::string v = decimal_to_string(decimal_str, scale);
 
                         str_slot->ptr = reinterpret_cast<char*>(tuple_pool->allocate(v.size()));
                         memcpy(str_slot->ptr, v.c_str(), v.size());
@@ -382,6 +357,105 @@ Status ORCScanner::get_next(Tuple* tuple, MemPool* tuple_pool, bool* eof, bool*
     }
 }
 
+std::string ORCScanner::decimal_to_string(const std::string& decimal_str, int scale) {
+    int negative = decimal_str[0] == '-' ? 1 : 0;
+    int decimal_scale_length = decimal_str.size() - negative;
+
+    std::string v;
+    if (decimal_scale_length <= scale) {
+        // decimal(5,2) : the integer of 0.01 is 1, so we should fill 0 befor integer
+        v = std::string(negative ? "-0." : "0.");
+        int fill_zero = scale - decimal_scale_length;
+        while (fill_zero--) {
+            v += "0";
+        }
+        if (negative) {
+            v += decimal_str.substr(1, decimal_str.length());
+        } else {
+            v += decimal_str;
+        }
+    } else {
+        //Orc api will fill in 0 at the end, so size must greater than scale
+        v = decimal_str.substr(0, decimal_str.size() - scale) + "." +
+            decimal_str.substr(decimal_str.size() - scale);
+    }
+    return v;
+}
+
+std::unique_ptr<orc::SearchArgument> ORCScanner::build_search_argument(
+        const orc::Type& file_type) {
+    auto builder = orc::SearchArgumentFactory::newBuilder();
+    builder->startAnd();
+    int num_leaves = 0;
+    for (const auto& pred : _src_slot_predicates) {
+        if (pred.slot_index >= _num_of_columns_from_file) {
+            continue;
+        }
+        const std::string& name = _src_slot_descs[pred.slot_index]->col_name();
+        const orc::Type* column_type = nullptr;
+        for (int i = 0; i < file_type.getSubtypeCount(); ++i) {
+            if (file_type.getFieldName(i) == name) {
+                column_type = file_type.getSubtype(i);
+                break;
+            }
+        }
+        if (column_type == nullptr) {
+            continue;
+        }
+
+        orc::PredicateDataType type;
+        switch (column_type->getKind()) {
+        case orc::BYTE:
+        case orc::SHORT:
+        case orc::INT:
+        case orc::LONG:
+            if (!pred.is_int) {
+                continue;
+            }
+            type = orc::PredicateDataType::LONG;
+            break;
+        // CHAR is padded with spaces
+        case orc::STRING:
+        case orc::VARCHAR:
+            if (pred.is_int) {
+                continue;
+            }
+            type = orc::PredicateDataType::STRING;
+            break;
+        default:
+            continue;
+        }
+        auto literal = pred.is_int ? orc::Literal(pred.int_value)
+                                   : orc::Literal(pred.string_value.data(),
+                                                  pred.string_value.size());
+        switch (pred.op) {
+        case TExprOpcode::EQ:
+            builder->equals(name, type, literal);
+            break;
+        case TExprOpcode::LT:
+            builder->lessThan(name, type, literal);
+            break;
+        case TExprOpcode::LE:
+            builder->lessThanEquals(name, type, literal);
+            break;
+        case TExprOpcode::GT:
+            builder->startNot().lessThanEquals(name, type, literal).end();
+            break;
+        case TExprOpcode::GE:
+            builder->startNot().lessThan(name, type, literal).end();
+            break;
+        default:
+            continue;
+        }
+        ++num_leaves;
+    }
+    if (num_leaves == 0) {
+        return nullptr;
+    }
+    builder->end();
+    return builder->build();
+}
+
 Status ORCScanner::open_next_reader() {
     while (true) {
         if (_next_range >= _ranges.size()) {
@@ -437,11 +511,13 @@ Status ORCScanner::open_next_reader() {
                 new ORCFileStream(file_reader.release(), range.path));
         _reader = orc::createReader(std::move(inStream), _options);
 
-        _total_groups = _reader->getNumberOfStripes();
-        _current_group = 0;
         _rows_of_group = 0;
         _current_line_of_group = 0;
+        if (!_src_slot_predicates.empty()) {
+            _row_reader_options.searchArgument(build_search_argument(_reader->getType()));
+        }
         _row_reader = _reader->createRowReader(_row_reader_options);
+        _batch = _row_reader->createRowBatch(_state->batch_size());
 
         //include_colus is in loader columns order, and batch is in the orc order
         _position_in_orc_original.clear();
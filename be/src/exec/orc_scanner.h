@@ -19,6 +19,7 @@
 #define ORC_SCANNER_H
 
 #include <orc/OrcFile.hh>
+#include <orc/sargs/SearchArgument.hh>
 
 #include "exec/base_scanner.h"
 
@@ -43,11 +44,17 @@ public:
     // Close this scanner
     void close() override;
 
-private:
+protected:
     // Read next buffer from reader
     Status open_next_reader();
 
-private:
+    // Build the search argument of the file, with which the row reader skips the stripes
+    // and the row groups by their statistics. Return nullptr if nothing can be checked.
+    std::unique_ptr<orc::SearchArgument> build_search_argument(const orc::Type& file_type);
+
+    // Text of the decimal with unscaled digits `decimal_str` and `scale`
+    static std::string decimal_to_string(const std::string& decimal_str, int scale);
+
     const std::vector<TBrokerRangeDesc>& _ranges;
     const std::vector<TNetworkAddress>& _broker_addresses;
 
@@ -66,9 +73,9 @@ private:
     std::vector<int> _position_in_orc_original;
     int _num_of_columns_from_file;
 
-    int _total_groups; // groups in a orc file
-    int _current_group;
-    int64_t _rows_of_group; // rows in a group.
+    std::vector<SrcSlotPredicate> _src_slot_predicates;
+
+    int64_t _rows_of_group; // rows in the batch.
     int64_t _current_line_of_group;
 };
 
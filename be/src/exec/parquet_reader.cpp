@@ -87,6 +87,11 @@ Status ParquetReaderWrap::init_parquet_reader(const std::vector<SlotDescriptor*>
 
         if (_current_line_of_group == 0) { // the first read
             RETURN_IF_ERROR(column_indices(tuple_slot_descs));
+            skip_filtered_groups();
+            if (_current_group >= _total_groups) {
+                return Status::EndOfFile("All row groups are filtered");
+            }
+            _rows_of_group = _file_metadata->RowGroup(_current_group)->num_rows();
             // read batch
             arrow::Status status = _reader->GetRecordBatchReader({_current_group},
                                                                  _parquet_column_ids, &_rb_batch);
@@ -186,6 +191,7 @@ Status ParquetReaderWrap::read_record_batch(const std::vector<SlotDescriptor*>&
                    << " is larger than rows group size:" << _rows_of_group
                    << ". start to read next row group";
         _current_group++;
+        skip_filtered_groups();
         if (_current_group >= _total_groups) { // read completed.
             _parquet_column_ids.clear();
             *eof = true;
@@ -219,6 +225,31 @@ Status ParquetReaderWrap::read_record_batch(const std::vector<SlotDescriptor*>&
     return Status::OK();
 }
 
+void ParquetReaderWrap::skip_filtered_groups() {
+    while (_current_group < _total_groups) {
+        auto row_group = _file_metadata->RowGroup(_current_group);
+        if (row_group->num_rows() > 0 &&
+            (_row_group_filter == nullptr || _row_group_filter(*row_group, _parquet_column_ids))) {
+            break;
+        }
+        ++_filtered_groups;
+        ++_current_group;
+    }
+}
+
+Status ParquetReaderWrap::next_batch(std::shared_ptr<arrow::RecordBatch>* batch,
+                                     const std::vector<SlotDescriptor*>& tuple_slot_descs,
+                                     bool* eof) {
+    if (_current_line_of_batch == 0) {
+        *batch = _batch;
+    } else {
+        *batch = _batch->Slice(_current_line_of_batch);
+    }
+    _current_line_of_group += (*batch)->num_rows();
+    _current_line_of_batch = _batch->num_rows();
+    return read_record_batch(tuple_slot_descs, eof);
+}
+
 Status ParquetReaderWrap::handle_timestamp(const std::shared_ptr<arrow::TimestampArray>& ts_array,
                                            uint8_t* buf, int32_t* wbytes) {
     const auto type = std::static_pointer_cast<arrow::TimestampType>(ts_array->type());
@@ -29,6 +29,7 @@
 #include <parquet/exception.h>
 #include <stdint.h>
 
+#include <functional>
 #include <map>
 #include <string>
 
@@ -69,6 +70,11 @@ private:
 // Reader of broker parquet file
 class ParquetReaderWrap {
 public:
+    // Return false if the row group can not hold any row we need, `column_ids[i]` is the
+    // index of the column read for the i-th slot in the file.
+    using RowGroupFilter = std::function<bool(const parquet::RowGroupMetaData& row_group,
+                                              const std::vector<int>& column_ids)>;
+
     ParquetReaderWrap(FileReader* file_reader, int32_t num_of_columns_from_file);
     virtual ~ParquetReaderWrap();
 
@@ -80,6 +86,18 @@ public:
     Status init_parquet_reader(const std::vector<SlotDescriptor*>& tuple_slot_descs,
                                const std::string& timezone);
 
+    // Must be called before init_parquet_reader().
+    void set_row_group_filter(RowGroupFilter filter) { _row_group_filter = std::move(filter); }
+
+    // Read all the remaining rows of the current record batch. Like read(), `eof` is set
+    // along with the last batch of the file.
+    Status next_batch(std::shared_ptr<arrow::RecordBatch>* batch,
+                      const std::vector<SlotDescriptor*>& tuple_slot_descs, bool* eof);
+
+    arrow::Type::type column_type(int i) const { return _parquet_column_type[i]; }
+    const std::string& timezone() const { return _timezone; }
+    int num_filtered_groups() const { return _filtered_groups; }
+
 private:
     void fill_slot(Tuple* tuple, SlotDescriptor* slot_desc, MemPool* mem_pool, const uint8_t* value,
                    int32_t len);
@@ -88,6 +106,8 @@ private:
     Status read_record_batch(const std::vector<SlotDescriptor*>& tuple_slot_descs, bool* eof);
     Status handle_timestamp(const std::shared_ptr<arrow::TimestampArray>& ts_array, uint8_t* buf,
                             int32_t* wbtyes);
+    // Move _current_group to the first group from it which passes the row group filter.
+    void skip_filtered_groups();
 
 private:
     const int32_t _num_of_columns_from_file;
@@ -104,6 +124,8 @@ private:
     std::vector<arrow::Type::type> _parquet_column_type;
     int _total_groups; // groups in a parquet file
     int _current_group;
+    RowGroupFilter _row_group_filter;
+    int _filtered_groups = 0;
 
     int _rows_of_group; // rows in a group.
     int _current_line_of_group;
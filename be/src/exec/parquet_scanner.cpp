@@ -54,7 +54,10 @@ ParquetScanner::~ParquetScanner() {
 }
 
 Status ParquetScanner::open() {
-    return BaseScanner::open();
+    RETURN_IF_ERROR(BaseScanner::open());
+    _filtered_row_groups_counter = ADD_COUNTER(_profile, "RowGroupsFiltered", TUnit::UNIT);
+    _src_slot_predicates = get_src_slot_predicates();
+    return Status::OK();
 }
 
 Status ParquetScanner::get_next(Tuple* tuple, MemPool* tuple_pool, bool* eof, bool* fill_tuple) {
@@ -94,6 +97,7 @@ Status ParquetScanner::get_next(Tuple* tuple, MemPool* tuple_pool, bool* eof, bo
 Status ParquetScanner::open_next_reader() {
     // open_file_reader
     if (_cur_file_reader != nullptr) {
+        COUNTER_UPDATE(_filtered_row_groups_counter, _cur_file_reader->num_filtered_groups());
         if (_stream_load_pipe != nullptr) {
             _stream_load_pipe.reset();
             _cur_file_reader = nullptr;
@@ -157,9 +161,19 @@ Status ParquetScanner::open_next_reader() {
             _cur_file_reader = new ParquetReaderWrap(file_reader.release(), _src_slot_descs.size());
         }
 
+        if (!_src_slot_predicates.empty()) {
+            _cur_file_reader->set_row_group_filter(
+                    [this](const parquet::RowGroupMetaData& row_group,
+                           const std::vector<int>& column_ids) {
+                        return filter_row_group(row_group, column_ids);
+                    });
+        }
         Status status = _cur_file_reader->init_parquet_reader(_src_slot_descs, _state->timezone());
 
         if (status.is_end_of_file()) {
+            COUNTER_UPDATE(_filtered_row_groups_counter, _cur_file_reader->num_filtered_groups());
+            delete _cur_file_reader;
+            _cur_file_reader = nullptr;
             continue;
         } else {
             if (!status.ok()) {
@@ -173,9 +187,80 @@ Status ParquetScanner::open_next_reader() {
     }
 }
 
+template <typename T>
+static bool may_match(TExprOpcode::type op, const T& min, const T& max, const T& value) {
+    switch (op) {
+    case TExprOpcode::EQ:
+        return !(value < min) && !(max < value);
+    case TExprOpcode::LT:
+        return min < value;
+    case TExprOpcode::LE:
+        return !(value < min);
+    case TExprOpcode::GT:
+        return value < max;
+    case TExprOpcode::GE:
+        return !(max < value);
+    default:
+        return true;
+    }
+}
+
+bool ParquetScanner::filter_row_group(const parquet::RowGroupMetaData& row_group,
+                                      const std::vector<int>& column_ids) {
+    for (const auto& pred : _src_slot_predicates) {
+        // only the slots read from the file have statistics
+        if (pred.slot_index >= column_ids.size()) {
+            continue;
+        }
+        auto column_chunk = row_group.ColumnChunk(column_ids[pred.slot_index]);
+        if (!column_chunk->is_stats_set()) {
+            continue;
+        }
+        auto stats = column_chunk->statistics();
+        if (stats == nullptr || !stats->HasMinMax()) {
+            continue;
+        }
+        auto converted_type = stats->descr()->converted_type();
+        bool match = true;
+        if (pred.is_int) {
+            if (converted_type != parquet::ConvertedType::NONE &&
+                converted_type != parquet::ConvertedType::INT_8 &&
+                converted_type != parquet::ConvertedType::INT_16 &&
+                converted_type != parquet::ConvertedType::INT_32 &&
+                converted_type != parquet::ConvertedType::INT_64) {
+                continue;
+            }
+            if (stats->physical_type() == parquet::Type::INT32) {
+                auto int_stats = std::static_pointer_cast<parquet::Int32Statistics>(stats);
+                match = may_match<int64_t>(pred.op, int_stats->min(), int_stats->max(),
+                                           pred.int_value);
+            } else if (stats->physical_type() == parquet::Type::INT64) {
+                auto int_stats = std::static_pointer_cast<parquet::Int64Statistics>(stats);
+                match = may_match<int64_t>(pred.op, int_stats->min(), int_stats->max(),
+                                           pred.int_value);
+            }
+        } else if (stats->physical_type() == parquet::Type::BYTE_ARRAY &&
+                   (converted_type == parquet::ConvertedType::NONE ||
+                    converted_type == parquet::ConvertedType::UTF8)) {
+            auto str_stats = std::static_pointer_cast<parquet::ByteArrayStatistics>(stats);
+            auto to_string_view = [](const parquet::ByteArray& v) {
+                return std::string_view(reinterpret_cast<const char*>(v.ptr), v.len);
+            };
+            match = may_match(pred.op, to_string_view(str_stats->min()),
+                              to_string_view(str_stats->max()),
+                              std::string_view(pred.string_value));
+        }
+        if (!match) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void ParquetScanner::close() {
     BaseScanner::close();
     if (_cur_file_reader != nullptr) {
+        COUNTER_UPDATE(_filtered_row_groups_counter, _cur_file_reader->num_filtered_groups());
         if (_stream_load_pipe != nullptr) {
             _stream_load_pipe.reset();
             _cur_file_reader = nullptr;
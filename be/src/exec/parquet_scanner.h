@@ -31,6 +31,10 @@
 #include "util/runtime_profile.h"
 #include "util/slice.h"
 
+namespace parquet {
+class RowGroupMetaData;
+} // namespace parquet
+
 namespace doris {
 
 class Tuple;
@@ -65,11 +69,15 @@ public:
     // Close this scanner
     virtual void close();
 
-private:
+protected:
     // Read next buffer from reader
     Status open_next_reader();
 
-private:
+    // Check the column statistics of the row group against _src_slot_predicates,
+    // return false if no row of the group can pass them.
+    bool filter_row_group(const parquet::RowGroupMetaData& row_group,
+                          const std::vector<int>& column_ids);
+
     //const TBrokerScanRangeParams& _params;
     const std::vector<TBrokerRangeDesc>& _ranges;
     const std::vector<TNetworkAddress>& _broker_addresses;
@@ -81,6 +89,9 @@ private:
 
     // used to hold current StreamLoadPipe
     std::shared_ptr<StreamLoadPipe> _stream_load_pipe;
+
+    std::vector<SrcSlotPredicate> _src_slot_predicates;
+    RuntimeProfile::Counter* _filtered_row_groups_counter = nullptr;
 };
 
 } // namespace doris
@@ -17,6 +17,8 @@
 
 #include "exec/plain_text_line_reader.h"
 
+#include <algorithm>
+
 #include "common/status.h"
 #include "exec/decompressor.h"
 #include "exec/file_reader.h"
@@ -35,7 +37,7 @@ namespace doris {
 PlainTextLineReader::PlainTextLineReader(RuntimeProfile* profile, FileReader* file_reader,
                                          Decompressor* decompressor, size_t length,
                                          const std::string& line_delimiter,
-                                         size_t line_delimiter_length)
+                                         size_t line_delimiter_length, char enclose)
         : _profile(profile),
           _file_reader(file_reader),
           _decompressor(decompressor),
@@ -43,6 +45,7 @@ PlainTextLineReader::PlainTextLineReader(RuntimeProfile* profile, FileReader* fi
           _total_read_bytes(0),
           _line_delimiter(line_delimiter),
           _line_delimiter_length(line_delimiter_length),
+          _enclose(enclose),
           _input_buf(new uint8_t[INPUT_CHUNK]),
           _input_buf_size(INPUT_CHUNK),
           _input_buf_pos(0),
@@ -94,6 +97,10 @@ inline bool PlainTextLineReader::update_eof() {
 uint8_t* PlainTextLineReader::update_field_pos_and_find_line_delimiter(const uint8_t* start,
                                                                        size_t len) {
     // TODO: meanwhile find and save field pos
+    if (_line_delimiter_length == 1) {
+        // memchr is vectorized by libc
+        return (uint8_t*)memchr(start, _line_delimiter[0], len);
+    }
     return (uint8_t*)memmem(start, len, _line_delimiter.c_str(), _line_delimiter_length);
 }
 
@@ -189,6 +196,9 @@ Status PlainTextLineReader::read_line(const uint8_t** ptr, size_t* size, bool* e
     }
     int found_line_delimiter = 0;
     size_t offset = 0;
+    // the enclose chars before this offset of the line have been counted
+    size_t enclose_offset = 0;
+    bool enclosed = false;
     while (!done()) {
         // find line delimiter in current decompressed data
         uint8_t* cur_ptr = _output_buf + _output_buf_pos;
@@ -320,6 +330,15 @@ Status PlainTextLineReader::read_line(const uint8_t** ptr, size_t* size, bool* e
                 }
             }
         } else {
+            if (_enclose != 0) {
+                enclosed ^= std::count(cur_ptr + enclose_offset, pos, _enclose) & 1;
+                enclose_offset = pos - cur_ptr;
+                if (enclosed) {
+                    // the delimiter is in an enclosed value, find the next one
+                    offset = enclose_offset + 1;
+                    continue;
+                }
+            }
             // we found a complete line
             // ready to return
             offset = pos - cur_ptr;
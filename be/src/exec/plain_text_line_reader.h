@@ -30,7 +30,8 @@ class PlainTextLineReader : public LineReader {
 public:
     PlainTextLineReader(RuntimeProfile* profile, FileReader* file_reader,
                         Decompressor* decompressor, size_t length,
-                        const std::string& line_delimiter, size_t line_delimiter_length);
+                        const std::string& line_delimiter, size_t line_delimiter_length,
+                        char enclose = 0);
 
     ~PlainTextLineReader() override;
 
@@ -64,6 +65,9 @@ private:
     size_t _total_read_bytes;
     std::string _line_delimiter;
     size_t _line_delimiter_length;
+    // the line delimiters between an odd and an even enclose char of a line do not end it,
+    // 0 if the values are not enclosed
+    char _enclose;
 
     // save the data read from file reader
     uint8_t* _input_buf;
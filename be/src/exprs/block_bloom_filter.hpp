@@ -80,6 +80,16 @@ public:
     // - Or'ing with kAlwaysTrueFilter is disallowed.
     Status merge(const BlockBloomFilter& other);
 
+    // Halves the directory, as long as the fraction of bits set in the halved directory
+    // does not exceed 'max_fill_ratio'. Bucket 'i + n / 2' is or'ed into bucket 'i', which
+    // keeps every inserted element, since the bucket index is the low bits of the rehash.
+    // Used to shrink a filter sized for more elements than were actually inserted.
+    void fold(double max_fill_ratio);
+
+    // Halves the directory until it takes 2^target_log_space_bytes bytes, so that it can be
+    // merged with a smaller filter. No-op if the filter is not larger than that.
+    void fold_to(int target_log_space_bytes);
+
     // Computes out[i] |= in[i] for the arrays 'in' and 'out' of length 'n' bytes where 'n'
     // is multiple of 32-bytes.
     static Status or_equal_array(size_t n, const uint8_t* __restrict__ in,
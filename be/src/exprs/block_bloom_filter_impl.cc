@@ -217,6 +217,34 @@ void BlockBloomFilter::or_equal_array_no_avx2(size_t n, const uint8_t* __restric
 #endif
 }
 
+void BlockBloomFilter::fold(double max_fill_ratio) {
+    while (_log_num_buckets > 1) {
+        const size_t half_size = directory_size() / 2;
+        const uint64_t* lower = reinterpret_cast<const uint64_t*>(_directory);
+        const uint64_t* upper = reinterpret_cast<const uint64_t*>(
+                reinterpret_cast<const uint8*>(_directory) + half_size);
+        uint64_t bits_set = 0;
+        for (size_t i = 0; i < half_size / sizeof(uint64_t); ++i) {
+            bits_set += __builtin_popcountll(lower[i] | upper[i]);
+        }
+        if (bits_set > max_fill_ratio * half_size * CHAR_BIT) {
+            break;
+        }
+        fold_to(log_space_bytes() - 1);
+    }
+}
+
+void BlockBloomFilter::fold_to(int target_log_space_bytes) {
+    const int log_num_buckets = std::max(1, target_log_space_bytes - kLogBucketByteSize);
+    while (_log_num_buckets > log_num_buckets) {
+        const size_t half_size = directory_size() / 2;
+        or_equal_array_internal(half_size, reinterpret_cast<const uint8*>(_directory) + half_size,
+                                reinterpret_cast<uint8*>(_directory));
+        --_log_num_buckets;
+        _directory_mask >>= 1;
+    }
+}
+
 Status BlockBloomFilter::merge(const BlockBloomFilter& other) {
     // AlwaysTrueFilter is a special case implemented with a nullptr.
     // Hence merge'ing with an AlwaysTrueFilter will result in a Bloom filter that also
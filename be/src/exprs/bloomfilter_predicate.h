@@ -43,8 +43,21 @@ public:
 
     static BlockBloomFilterAdaptor* create() { return new BlockBloomFilterAdaptor(); }
 
+    // The filters may have different sizes if one of them has been folded, the larger one
+    // is folded to the size of the smaller one first.
     Status merge(BlockBloomFilterAdaptor* other) {
-        return _bloom_filter->merge(*other->_bloom_filter);
+        const auto& other_filter = *other->_bloom_filter;
+        if (_bloom_filter->log_space_bytes() > other_filter.log_space_bytes()) {
+            _bloom_filter->fold_to(other_filter.log_space_bytes());
+        } else if (_bloom_filter->log_space_bytes() < other_filter.log_space_bytes()) {
+            doris::BlockBloomFilter folded;
+            RETURN_IF_ERROR(folded.init_from_directory(other_filter.log_space_bytes(),
+                                                       other_filter.directory(),
+                                                       other_filter.always_false(), 0));
+            folded.fold_to(_bloom_filter->log_space_bytes());
+            return _bloom_filter->merge(folded);
+        }
+        return _bloom_filter->merge(other_filter);
     }
 
     Status init(int len) {
@@ -61,6 +74,8 @@ public:
 
     size_t size() { return _bloom_filter->directory().size; }
 
+    void fold(double max_fill_ratio) { _bloom_filter->fold(max_fill_ratio); }
+
     template <typename T>
     bool test(T data) const {
         return _bloom_filter->find(data);
@@ -91,6 +106,9 @@ public:
 
     virtual Status get_data(char** data, int* len) = 0;
     virtual void light_copy(IBloomFilterFuncBase* other) = 0;
+
+    // shrink the filter when it holds fewer elements than it was sized for
+    virtual void fold(double max_fill_ratio) = 0;
 };
 
 template <class BloomFilterAdaptor>
@@ -128,10 +146,7 @@ public:
         if (bloomfilter_func == nullptr) {
             _bloom_filter.reset(BloomFilterAdaptor::create());
         }
-        if (_bloom_filter_alloced != other_func->_bloom_filter_alloced) {
-            LOG(WARNING) << "bloom filter size not the same";
-            return Status::InvalidArgument("bloom filter size invalid");
-        }
+        // the sizes differ if one of the filters has been folded, the adaptor takes care of it
         return _bloom_filter->merge(other_func->_bloom_filter.get());
     }
 
@@ -151,6 +166,8 @@ public:
         return Status::OK();
     }
 
+    void fold(double max_fill_ratio) override { _bloom_filter->fold(max_fill_ratio); }
+
     void light_copy(IBloomFilterFuncBase* bloomfilter_func) override {
         auto other_func = static_cast<BloomFilterFuncBase*>(bloomfilter_func);
         _tracker = nullptr; // Avoid repeated release when ~BloomFilterFuncBase
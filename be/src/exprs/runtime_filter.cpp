@@ -19,9 +19,11 @@
 
 #include <memory>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "exec/hash_join_node.h"
+#include "exec/olap_common.h"
 #include "exprs/binary_predicate.h"
 #include "exprs/bloomfilter_predicate.h"
 #include "exprs/create_predicate_function.h"
@@ -32,8 +34,10 @@
 #include "exprs/literal.h"
 #include "exprs/minmax_predicate.h"
 #include "exprs/predicate.h"
+#include "exprs/slot_ref.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "gen_cpp/types.pb.h"
+#include "runtime/large_int_value.h"
 #include "runtime/primitive_type.h"
 #include "runtime/runtime_filter_mgr.h"
 #include "runtime/runtime_state.h"
@@ -856,6 +860,58 @@ public:
         return _bloomfilter_func->get_data(data, filter_length);
     }
 
+    void fold_bloom_filter(double max_fill_ratio) {
+        if (get_real_type() == RuntimeFilterType::BLOOM_FILTER && _bloomfilter_func != nullptr) {
+            _bloomfilter_func->fold(max_fill_ratio);
+        }
+    }
+
+    // Convert the filter to the conditions used by the olap storage to prune pages.
+    // Only IN filters which are not ignored and non empty MIN/MAX filters are converted.
+    void get_olap_conditions(const std::string& column_name,
+                             std::vector<TCondition>* conditions) {
+        auto real_filter_type = get_real_type();
+        if (real_filter_type == RuntimeFilterType::IN_FILTER) {
+            if (_is_ignored_in_filter || _hybrid_set == nullptr || _hybrid_set->size() == 0) {
+                return;
+            }
+            TCondition condition;
+            condition.__set_column_name(column_name);
+            condition.__set_condition_op("*=");
+            auto it = _hybrid_set->begin();
+            while (it->has_next()) {
+                std::string value;
+                if (!to_olap_value(it->get_value(), &value)) {
+                    return;
+                }
+                condition.condition_values.push_back(std::move(value));
+                it->next();
+            }
+            conditions->push_back(std::move(condition));
+        } else if (real_filter_type == RuntimeFilterType::MINMAX_FILTER) {
+            if (_minmax_func == nullptr || _minmax_func->is_empty()) {
+                return;
+            }
+            std::string min_value;
+            std::string max_value;
+            if (!to_olap_value(_minmax_func->get_min(), &min_value) ||
+                !to_olap_value(_minmax_func->get_max(), &max_value)) {
+                return;
+            }
+            TCondition low;
+            low.__set_column_name(column_name);
+            low.__set_condition_op(">=");
+            low.condition_values.push_back(std::move(min_value));
+            conditions->push_back(std::move(low));
+
+            TCondition high;
+            high.__set_column_name(column_name);
+            high.__set_condition_op("<=");
+            high.condition_values.push_back(std::move(max_value));
+            conditions->push_back(std::move(high));
+        }
+    }
+
     Status get_minmax_filter_desc(void** min_data, void** max_data) {
         *min_data = _minmax_func->get_min();
         *max_data = _minmax_func->get_max();
@@ -900,6 +956,41 @@ public:
     }
 
 private:
+    // same format as the values of the scan conditions, see ColumnValueRange::to_olap_filter
+    bool to_olap_value(const void* value, std::string* result) const {
+        switch (_column_return_type) {
+        case TYPE_TINYINT:
+            *result = cast_to_string(*reinterpret_cast<const int8_t*>(value));
+            return true;
+        case TYPE_SMALLINT:
+            *result = cast_to_string(*reinterpret_cast<const int16_t*>(value));
+            return true;
+        case TYPE_INT:
+            *result = cast_to_string(*reinterpret_cast<const int32_t*>(value));
+            return true;
+        case TYPE_BIGINT:
+            *result = cast_to_string(*reinterpret_cast<const int64_t*>(value));
+            return true;
+        case TYPE_LARGEINT:
+            *result = LargeIntValue::to_string(*reinterpret_cast<const __int128*>(value));
+            return true;
+        case TYPE_DATE:
+        case TYPE_DATETIME:
+            *result = reinterpret_cast<const DateTimeValue*>(value)->debug_string();
+            return true;
+        case TYPE_DECIMALV2:
+            *result = reinterpret_cast<const DecimalV2Value*>(value)->to_string();
+            return true;
+        case TYPE_CHAR:
+        case TYPE_VARCHAR:
+        case TYPE_STRING:
+            *result = reinterpret_cast<const StringValue*>(value)->to_string();
+            return true;
+        default:
+            return false;
+        }
+    }
+
     ObjectPool* _pool;
     PrimitiveType _column_return_type; // column type
     RuntimeFilterType _filter_type;
@@ -943,6 +1034,8 @@ Status IRuntimeFilter::publish() {
         Status status =
                 _state->runtime_filter_mgr()->get_consume_filter(_filter_id, &consumer_filter);
         DCHECK(status.ok());
+        // no merge will follow, the filter can be shrunk to what the build side inserted
+        fold_bloom_filter();
         // push down
         std::swap(this->_wrapper, consumer_filter->_wrapper);
         consumer_filter->update_runtime_filter_type_to_profile();
@@ -992,6 +1085,29 @@ Status IRuntimeFilter::get_prepared_context(std::vector<ExprContext*>* push_expr
     return Expr::open(_push_down_ctxs, _state);
 }
 
+Status IRuntimeFilter::get_olap_conditions(const TupleDescriptor& tuple_desc,
+                                           std::vector<TCondition>* conditions) {
+    DCHECK(_is_ready);
+    DCHECK(is_consumer());
+    std::lock_guard<std::mutex> guard(_inner_mutex);
+
+    if (!_olap_conditions_built) {
+        _olap_conditions_built = true;
+        if (_is_ignored || _probe_ctx == nullptr || !_probe_ctx->root()->is_slotref()) {
+            return Status::OK();
+        }
+        SlotId slot_id = static_cast<SlotRef*>(_probe_ctx->root())->slot_id();
+        for (auto slot : tuple_desc.slots()) {
+            if (slot->id() == slot_id) {
+                _wrapper->get_olap_conditions(slot->col_name(), &_olap_conditions);
+                break;
+            }
+        }
+    }
+    conditions->insert(conditions->end(), _olap_conditions.begin(), _olap_conditions.end());
+    return Status::OK();
+}
+
 bool IRuntimeFilter::await() {
     DCHECK(is_consumer());
     SCOPED_TIMER(_await_time_cost);
@@ -1143,6 +1259,12 @@ void IRuntimeFilter::ready_for_publish() {
     _wrapper->ready_for_publish();
 }
 
+void IRuntimeFilter::fold_bloom_filter() {
+    if (config::runtime_bloom_filter_max_fill_ratio > 0) {
+        _wrapper->fold_bloom_filter(config::runtime_bloom_filter_max_fill_ratio);
+    }
+}
+
 Status IRuntimeFilter::merge_from(const RuntimePredicateWrapper* wrapper) {
     if (!_is_ignored && wrapper->is_ignored_in_filter()) {
         set_ignored();
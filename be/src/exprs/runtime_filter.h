@@ -25,6 +25,7 @@
 
 #include "exprs/expr_context.h"
 #include "gen_cpp/Exprs_types.h"
+#include "gen_cpp/PaloInternalService_types.h"
 #include "runtime/types.h"
 #include "util/runtime_profile.h"
 #include "util/uid_util.h"
@@ -45,6 +46,7 @@ class PInFilter;
 class PMinMaxFilter;
 class HashJoinNode;
 class RuntimeProfile;
+class TupleDescriptor;
 
 enum class RuntimeFilterType {
     UNKNOWN_FILTER = -1,
@@ -158,6 +160,14 @@ public:
                                 const RowDescriptor& desc,
                                 const std::shared_ptr<MemTracker>& tracker);
 
+    // Get the conditions on the olap column of the probe expr, with which the olap scan
+    // prunes the pages by zone map and bloom filter index. Only the IN and MIN/MAX filters
+    // whose probe expr is a slot of `tuple_desc` are converted. This function can be called
+    // multiple times, the conditions are built on the first call, which must happen before
+    // get_prepared_context takes over the values of the IN filter.
+    Status get_olap_conditions(const TupleDescriptor& tuple_desc,
+                               std::vector<TCondition>* conditions);
+
     bool is_broadcast_join() const { return _is_broadcast_join; }
 
     bool has_remote_target() const { return _has_remote_target; }
@@ -223,6 +233,10 @@ public:
 
     void ready_for_publish();
 
+    // Shrink a bloom filter holding fewer values than it was sized for. Merging a larger
+    // filter into a folded one folds it as well, so only call it when no more merge follows.
+    void fold_bloom_filter();
+
 protected:
     // serialize _wrapper to protobuf
     void to_protobuf(PInFilter* filter);
@@ -281,6 +295,10 @@ protected:
     // consumer_close should be called before release
     std::vector<ExprContext*> _push_down_ctxs;
 
+    // conditions pushed to the olap storage, see get_olap_conditions
+    bool _olap_conditions_built = false;
+    std::vector<TCondition> _olap_conditions;
+
     struct rpc_context;
     std::shared_ptr<rpc_context> _rpc_context;
 
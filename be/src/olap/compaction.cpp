@@ -19,8 +19,10 @@
 
 #include "gutil/strings/substitute.h"
 #include "olap/rowset/rowset_factory.h"
+#include "olap/rowset/segment_v2/segment_writer.h"
 #include "util/time.h"
 #include "util/trace.h"
+#include "vec/olap/vertical_block_reader.h"
 
 using std::vector;
 
@@ -87,14 +89,21 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     // The test results show that merger is low-memory-footprint, there is no need to tracker its mem pool
     Merger::Statistics stats;
     Status res;
-    if (config::enable_vectorized_compaction) {
+    bool vertical_merge = config::enable_vectorized_compaction && _should_vertical_merge();
+    if (vertical_merge) {
+        res = Merger::vertical_merge_rowsets(_tablet, compaction_type(), _input_rs_readers,
+                                             _output_rs_writer.get(), _get_segment_max_rows(),
+                                             &stats);
+    } else if (config::enable_vectorized_compaction) {
         res = Merger::vmerge_rowsets(_tablet, compaction_type(), _input_rs_readers,
                                      _output_rs_writer.get(), &stats);
     } else {
         res = Merger::merge_rowsets(_tablet, compaction_type(), _input_rs_readers,
                                     _output_rs_writer.get(), &stats);
     }
-    string merge_type = config::enable_vectorized_compaction ? "v" : "";
+    string merge_type = vertical_merge                          ? "vertical "
+                        : config::enable_vectorized_compaction ? "v"
+                                                               : "";
     if (!res.ok()) {
         LOG(WARNING) << "fail to do " << merge_type << compaction_name() << ". res=" << res
                      << ", tablet=" << _tablet->full_name()
@@ -121,7 +130,7 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     TRACE("check correctness finished");
 
     // 4. modify rowsets in memory
-    modify_rowsets();
+    RETURN_NOT_OK(modify_rowsets());
     TRACE("modify rowsets finished");
 
     // 5. update last success compaction time
@@ -150,6 +159,26 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     return Status::OK();
 }
 
+bool Compaction::_should_vertical_merge() const {
+    if (!config::enable_vertical_compaction ||
+        _output_rs_writer->type() != RowsetTypePB::BETA_ROWSET ||
+        _input_rowsets.size() > vectorized::RowSourcesBuffer::MAX_SOURCES) {
+        return false;
+    }
+    // it is worth only if the value columns are split to more than one group
+    std::vector<std::vector<uint32_t>> column_groups;
+    Merger::vertical_split_columns(_tablet->tablet_schema(), &column_groups);
+    return column_groups.size() > 2;
+}
+
+int64_t Compaction::_get_segment_max_rows() const {
+    if (_input_row_num <= 0) {
+        return INT32_MAX;
+    }
+    int64_t avg_row_size = std::max<int64_t>(1, _input_rowsets_size / _input_row_num);
+    return std::clamp<int64_t>(MAX_SEGMENT_SIZE / avg_row_size, 1, INT32_MAX);
+}
+
 Status Compaction::construct_output_rowset_writer() {
     RowsetWriterContext context;
     context.rowset_id = StorageEngine::instance()->next_rowset_id();
@@ -167,6 +196,7 @@ Status Compaction::construct_output_rowset_writer() {
     context.rowset_state = VISIBLE;
     context.version = _output_version;
     context.segments_overlap = NONOVERLAPPING;
+    context.enable_unique_key_merge_on_write = _tablet->enable_unique_key_merge_on_write();
     // The test results show that one rs writer is low-memory-footprint, there is no need to tracker its mem pool
     RETURN_NOT_OK(RowsetFactory::create_rowset_writer(context, &_output_rs_writer));
     return Status::OK();
@@ -181,13 +211,18 @@ Status Compaction::construct_input_rowset_readers() {
     return Status::OK();
 }
 
-void Compaction::modify_rowsets() {
+Status Compaction::modify_rowsets() {
     std::vector<RowsetSharedPtr> output_rowsets;
     output_rowsets.push_back(_output_rowset);
 
     std::lock_guard<std::shared_mutex> wrlock(_tablet->get_header_lock());
+    if (_tablet->enable_unique_key_merge_on_write()) {
+        // the loads published while compacting only marked the rows of input rowsets
+        RETURN_NOT_OK(_tablet->update_delete_bitmap_after_compaction(_output_rowset));
+    }
     _tablet->modify_rowsets(output_rowsets, _input_rowsets);
     _tablet->save_meta();
+    return Status::OK();
 }
 
 void Compaction::gc_output_rowset() {
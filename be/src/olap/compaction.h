@@ -61,7 +61,7 @@ protected:
     Status do_compaction(int64_t permits);
     Status do_compaction_impl(int64_t permits);
 
-    void modify_rowsets();
+    Status modify_rowsets();
     void gc_output_rowset();
 
     Status construct_output_rowset_writer();
@@ -78,6 +78,13 @@ private:
     // return -1 if these are not alpha rowsets.
     int64_t _get_input_num_rows_from_seg_grps();
 
+    // whether to merge the rowsets column group by column group
+    bool _should_vertical_merge() const;
+
+    // the rows of a segment of about MAX_SEGMENT_SIZE, estimated by the input rowsets since
+    // the size of a segment is unknown until all of its column groups are written
+    int64_t _get_segment_max_rows() const;
+
 protected:
     // the root tracker for this compaction
     std::shared_ptr<MemTracker> _mem_tracker;
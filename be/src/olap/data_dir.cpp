@@ -47,6 +47,9 @@
 #include "util/file_utils.h"
 #include "util/storage_backend.h"
 #include "util/storage_backend_mgr.h"
+#include "util/stopwatch.hpp"
+#include "util/threadpool.h"
+#include "util/time.h"
 
 #include "util/string_util.h"
 
@@ -60,6 +63,9 @@ DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(disks_data_used_capacity, MetricUnit::BYTES);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(disks_state, MetricUnit::BYTES);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(disks_compaction_score, MetricUnit::NOUNIT);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(disks_compaction_num, MetricUnit::NOUNIT);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(disks_load_rowset_metas_ms, MetricUnit::MILLISECONDS);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(disks_load_tablets_ms, MetricUnit::MILLISECONDS);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(disks_load_rowsets_ms, MetricUnit::MILLISECONDS);
 
 static const char* const kTestFilePath = "/.testfile";
 
@@ -88,6 +94,9 @@ DataDir::DataDir(const std::string& path, int64_t capacity_bytes,
     INT_GAUGE_METRIC_REGISTER(_data_dir_metric_entity, disks_state);
     INT_GAUGE_METRIC_REGISTER(_data_dir_metric_entity, disks_compaction_score);
     INT_GAUGE_METRIC_REGISTER(_data_dir_metric_entity, disks_compaction_num);
+    INT_GAUGE_METRIC_REGISTER(_data_dir_metric_entity, disks_load_rowset_metas_ms);
+    INT_GAUGE_METRIC_REGISTER(_data_dir_metric_entity, disks_load_tablets_ms);
+    INT_GAUGE_METRIC_REGISTER(_data_dir_metric_entity, disks_load_rowsets_ms);
 }
 
 DataDir::~DataDir() {
@@ -374,21 +383,52 @@ Status DataDir::load() {
     // necessarily check incompatible old format. when there are old metas, it may load to data missing
     _check_incompatible_old_format_tablet();
 
+    // The metas are read from the meta env sequentially, and parsed and loaded by the
+    // threads of the pool in batches. The tablets are added to the tablet manager under the
+    // lock of their own shards, so the threads rarely contend with each other.
+    std::unique_ptr<ThreadPool> load_pool;
+    RETURN_IF_ERROR(ThreadPoolBuilder("LoadTabletThreadPool")
+                            .set_min_threads(config::load_tablet_threads_per_data_dir)
+                            .set_max_threads(config::load_tablet_threads_per_data_dir)
+                            .build(&load_pool));
+    MonotonicStopWatch watch;
+    watch.start();
+
     std::vector<RowsetMetaSharedPtr> dir_rowset_metas;
+    std::mutex dir_rowset_metas_lock;
     LOG(INFO) << "begin loading rowset from meta";
-    auto load_rowset_func = [&dir_rowset_metas](TabletUid tablet_uid, RowsetId rowset_id,
-                                                const std::string& meta_str) -> bool {
-        RowsetMetaSharedPtr rowset_meta(new AlphaRowsetMeta());
-        bool parsed = rowset_meta->init(meta_str);
-        if (!parsed) {
-            LOG(WARNING) << "parse rowset meta string failed for rowset_id:" << rowset_id;
-            // return false will break meta iterator, return true to skip this error
-            return true;
+    auto parse_rowset_metas = [&dir_rowset_metas, &dir_rowset_metas_lock](
+                                      const std::vector<std::pair<RowsetId, std::string>>& batch) {
+        std::vector<RowsetMetaSharedPtr> rowset_metas;
+        for (const auto& [rowset_id, meta_str] : batch) {
+            RowsetMetaSharedPtr rowset_meta(new AlphaRowsetMeta());
+            bool parsed = rowset_meta->init(meta_str);
+            if (!parsed) {
+                LOG(WARNING) << "parse rowset meta string failed for rowset_id:" << rowset_id;
+                continue;
+            }
+            rowset_metas.push_back(std::move(rowset_meta));
         }
-        dir_rowset_metas.push_back(rowset_meta);
+        std::lock_guard<std::mutex> l(dir_rowset_metas_lock);
+        dir_rowset_metas.insert(dir_rowset_metas.end(), rowset_metas.begin(), rowset_metas.end());
+    };
+    std::vector<std::pair<RowsetId, std::string>> rowset_meta_batch;
+    auto load_rowset_func = [&](TabletUid tablet_uid, RowsetId rowset_id,
+                                const std::string& meta_str) -> bool {
+        rowset_meta_batch.emplace_back(rowset_id, meta_str);
+        if (rowset_meta_batch.size() >= LOAD_META_BATCH_SIZE) {
+            _submit_load_task(load_pool.get(), [&parse_rowset_metas,
+                                                batch = std::move(rowset_meta_batch)]() {
+                parse_rowset_metas(batch);
+            });
+            rowset_meta_batch.clear();
+        }
+        // return false will break meta iterator, return true to skip this error
         return true;
     };
     Status load_rowset_status = RowsetMetaManager::traverse_rowset_metas(_meta, load_rowset_func);
+    parse_rowset_metas(rowset_meta_batch);
+    load_pool->wait();
 
     if (!load_rowset_status) {
         LOG(WARNING) << "errors when load rowset meta from meta env, skip this data dir:"
@@ -396,46 +436,66 @@ Status DataDir::load() {
     } else {
         LOG(INFO) << "load rowset from meta finished, data dir: " << _path_desc.filepath;
     }
+    disks_load_rowset_metas_ms->set_value(watch.elapsed_time() / NANOS_PER_MILLIS);
+    watch.reset();
 
     // load tablet
     // create tablet from tablet meta and add it to tablet mgr
     LOG(INFO) << "begin loading tablet from meta";
-    std::set<int64_t> tablet_ids;
+    std::atomic<int64_t> loaded_tablet_num = 0;
     std::set<int64_t> failed_tablet_ids;
-    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids](
-                                    int64_t tablet_id, int32_t schema_hash,
-                                    const std::string& value) -> bool {
-        Status status = _tablet_manager->load_tablet_from_meta(this, tablet_id, schema_hash, value,
-                                                               false, false, false, false);
-        if (!status.ok() &&
-            status != Status::OLAPInternalError(OLAP_ERR_TABLE_ALREADY_DELETED_ERROR) &&
-            status != Status::OLAPInternalError(OLAP_ERR_ENGINE_INSERT_OLD_TABLET)) {
-            // load_tablet_from_meta() may return Status::OLAPInternalError(OLAP_ERR_TABLE_ALREADY_DELETED_ERROR)
-            // which means the tablet status is DELETED
-            // This may happen when the tablet was just deleted before the BE restarted,
-            // but it has not been cleared from rocksdb. At this time, restarting the BE
-            // will read the tablet in the DELETE state from rocksdb. These tablets have been
-            // added to the garbage collection queue and will be automatically deleted afterwards.
-            // Therefore, we believe that this situation is not a failure.
-
-            // Besides, load_tablet_from_meta() may return Status::OLAPInternalError(OLAP_ERR_ENGINE_INSERT_OLD_TABLET)
-            // when BE is restarting and the older tablet have been added to the
-            // garbage collection queue but not deleted yet.
-            // In this case, since the data_dirs are parallel loaded, a later loaded tablet
-            // may be older than previously loaded one, which should not be acknowledged as a
-            // failure.
-            LOG(WARNING) << "load tablet from header failed. status:" << status
-                         << ", tablet=" << tablet_id << "." << schema_hash;
-            failed_tablet_ids.insert(tablet_id);
-        } else {
-            tablet_ids.insert(tablet_id);
+    std::mutex failed_tablet_ids_lock;
+    auto load_tablets = [this, &loaded_tablet_num, &failed_tablet_ids, &failed_tablet_ids_lock](
+                                const std::vector<std::tuple<int64_t, int32_t, std::string>>&
+                                        batch) {
+        for (const auto& [tablet_id, schema_hash, value] : batch) {
+            Status status = _tablet_manager->load_tablet_from_meta(
+                    this, tablet_id, schema_hash, value, false, false, false, false);
+            if (!status.ok() &&
+                status != Status::OLAPInternalError(OLAP_ERR_TABLE_ALREADY_DELETED_ERROR) &&
+                status != Status::OLAPInternalError(OLAP_ERR_ENGINE_INSERT_OLD_TABLET)) {
+                // load_tablet_from_meta() may return Status::OLAPInternalError(OLAP_ERR_TABLE_ALREADY_DELETED_ERROR)
+                // which means the tablet status is DELETED
+                // This may happen when the tablet was just deleted before the BE restarted,
+                // but it has not been cleared from rocksdb. At this time, restarting the BE
+                // will read the tablet in the DELETE state from rocksdb. These tablets have been
+                // added to the garbage collection queue and will be automatically deleted afterwards.
+                // Therefore, we believe that this situation is not a failure.
+
+                // Besides, load_tablet_from_meta() may return Status::OLAPInternalError(OLAP_ERR_ENGINE_INSERT_OLD_TABLET)
+                // when BE is restarting and the older tablet have been added to the
+                // garbage collection queue but not deleted yet.
+                // In this case, since the data_dirs and the tablets of a data dir are parallel
+                // loaded, a later loaded tablet may be older than previously loaded one, which
+                // should not be acknowledged as a failure.
+                LOG(WARNING) << "load tablet from header failed. status:" << status
+                             << ", tablet=" << tablet_id << "." << schema_hash;
+                std::lock_guard<std::mutex> l(failed_tablet_ids_lock);
+                failed_tablet_ids.insert(tablet_id);
+            } else {
+                ++loaded_tablet_num;
+            }
+        }
+    };
+    std::vector<std::tuple<int64_t, int32_t, std::string>> tablet_meta_batch;
+    auto load_tablet_func = [&](int64_t tablet_id, int32_t schema_hash,
+                                const std::string& value) -> bool {
+        tablet_meta_batch.emplace_back(tablet_id, schema_hash, value);
+        if (tablet_meta_batch.size() >= LOAD_META_BATCH_SIZE) {
+            _submit_load_task(load_pool.get(),
+                              [&load_tablets, batch = std::move(tablet_meta_batch)]() {
+                                  load_tablets(batch);
+                              });
+            tablet_meta_batch.clear();
         }
         return true;
     };
     Status load_tablet_status = TabletMetaManager::traverse_headers(_meta, load_tablet_func);
+    load_tablets(tablet_meta_batch);
+    load_pool->wait();
     if (failed_tablet_ids.size() != 0) {
         LOG(WARNING) << "load tablets from header failed"
-                     << ", loaded tablet: " << tablet_ids.size()
+                     << ", loaded tablet: " << loaded_tablet_num
                      << ", error tablet: " << failed_tablet_ids.size()
                      << ", path: " << _path_desc.filepath;
         if (!config::ignore_load_tablet_failure) {
@@ -445,81 +505,61 @@ Status DataDir::load() {
     }
     if (!load_tablet_status) {
         LOG(WARNING) << "there is failure when loading tablet headers"
-                     << ", loaded tablet: " << tablet_ids.size()
+                     << ", loaded tablet: " << loaded_tablet_num
                      << ", error tablet: " << failed_tablet_ids.size()
                      << ", path: " << _path_desc.filepath;
     } else {
         LOG(INFO) << "load tablet from meta finished"
-                  << ", loaded tablet: " << tablet_ids.size()
+                  << ", loaded tablet: " << loaded_tablet_num
                   << ", error tablet: " << failed_tablet_ids.size()
                   << ", path: " << _path_desc.filepath;
     }
+    disks_load_tablets_ms->set_value(watch.elapsed_time() / NANOS_PER_MILLIS);
+    watch.reset();
 
     // traverse rowset
     // 1. add committed rowset to txn map
     // 2. add visible rowset to tablet
     // ignore any errors when load tablet or rowset, because fe will repair them after report
-    int64_t invalid_rowset_counter = 0;
-    for (auto rowset_meta : dir_rowset_metas) {
-        TabletSharedPtr tablet = _tablet_manager->get_tablet(rowset_meta->tablet_id(),
-                                                             rowset_meta->tablet_schema_hash());
-        // tablet maybe dropped, but not drop related rowset meta
-        if (tablet == nullptr) {
-            VLOG_NOTICE << "could not find tablet id: " << rowset_meta->tablet_id()
-                        << ", schema hash: " << rowset_meta->tablet_schema_hash()
-                        << ", for rowset: " << rowset_meta->rowset_id() << ", skip this rowset";
-            ++invalid_rowset_counter;
-            continue;
-        }
-        RowsetSharedPtr rowset;
-        Status create_status = RowsetFactory::create_rowset(
-                &tablet->tablet_schema(), tablet->tablet_path_desc(), rowset_meta, &rowset);
-        if (!create_status) {
-            LOG(WARNING) << "could not create rowset from rowsetmeta: "
-                         << " rowset_id: " << rowset_meta->rowset_id()
-                         << " rowset_type: " << rowset_meta->rowset_type()
-                         << " rowset_state: " << rowset_meta->rowset_state();
-            continue;
-        }
-        if (rowset_meta->rowset_state() == RowsetStatePB::COMMITTED &&
-            rowset_meta->tablet_uid() == tablet->tablet_uid()) {
-            Status commit_txn_status = _txn_manager->commit_txn(
-                    _meta, rowset_meta->partition_id(), rowset_meta->txn_id(),
-                    rowset_meta->tablet_id(), rowset_meta->tablet_schema_hash(),
-                    rowset_meta->tablet_uid(), rowset_meta->load_id(), rowset, true);
-            if (!commit_txn_status &&
-                commit_txn_status !=
-                        Status::OLAPInternalError(OLAP_ERR_PUSH_TRANSACTION_ALREADY_EXIST)) {
-                LOG(WARNING) << "failed to add committed rowset: " << rowset_meta->rowset_id()
-                             << " to tablet: " << rowset_meta->tablet_id()
-                             << " for txn: " << rowset_meta->txn_id();
-            } else {
-                LOG(INFO) << "successfully to add committed rowset: " << rowset_meta->rowset_id()
-                          << " to tablet: " << rowset_meta->tablet_id()
-                          << " schema hash: " << rowset_meta->tablet_schema_hash()
-                          << " for txn: " << rowset_meta->txn_id();
-            }
-        } else if (rowset_meta->rowset_state() == RowsetStatePB::VISIBLE &&
-                   rowset_meta->tablet_uid() == tablet->tablet_uid()) {
-            Status publish_status = tablet->add_rowset(rowset, false);
-            if (!publish_status &&
-                publish_status != Status::OLAPInternalError(OLAP_ERR_PUSH_VERSION_ALREADY_EXIST)) {
-                LOG(WARNING) << "add visible rowset to tablet failed rowset_id:"
-                             << rowset->rowset_id() << " tablet id: " << rowset_meta->tablet_id()
-                             << " txn id:" << rowset_meta->txn_id()
-                             << " start_version: " << rowset_meta->version().first
-                             << " end_version: " << rowset_meta->version().second;
+    std::atomic<int64_t> invalid_rowset_counter = 0;
+    for (size_t begin = 0; begin < dir_rowset_metas.size(); begin += LOAD_META_BATCH_SIZE) {
+        size_t end = std::min(begin + LOAD_META_BATCH_SIZE, dir_rowset_metas.size());
+        _submit_load_task(load_pool.get(), [this, &dir_rowset_metas, &invalid_rowset_counter,
+                                            begin, end]() {
+            for (size_t i = begin; i < end; ++i) {
+                if (!_load_rowset(dir_rowset_metas[i])) {
+                    ++invalid_rowset_counter;
+                }
             }
+        });
+    }
+    load_pool->wait();
+    load_pool->shutdown();
+
+    // merge the delete bitmaps of merge-on-write tablets saved by publish after the tablet
+    // meta was saved last time
+    std::vector<std::string> dropped_delete_bitmap_keys;
+    auto load_delete_bitmap_func = [this, &dropped_delete_bitmap_keys](
+                                           TTabletId tablet_id, const std::string& key,
+                                           const DeleteBitmap& delete_bitmap) -> bool {
+        TabletSharedPtr tablet = _tablet_manager->get_tablet(tablet_id);
+        if (tablet == nullptr) {
+            dropped_delete_bitmap_keys.push_back(key);
         } else {
-            LOG(WARNING) << "find invalid rowset: " << rowset_meta->rowset_id()
-                         << " with tablet id: " << rowset_meta->tablet_id()
-                         << " tablet uid: " << rowset_meta->tablet_uid()
-                         << " schema hash: " << rowset_meta->tablet_schema_hash()
-                         << " txn: " << rowset_meta->txn_id()
-                         << " current valid tablet uid: " << tablet->tablet_uid();
-            ++invalid_rowset_counter;
+            tablet->merge_saved_delete_bitmap(delete_bitmap);
         }
+        return true;
+    };
+    Status load_delete_bitmap_status =
+            TabletMetaManager::traverse_delete_bitmaps(_meta, load_delete_bitmap_func);
+    if (!load_delete_bitmap_status) {
+        LOG(WARNING) << "errors when load delete bitmaps from meta env, data dir: "
+                     << _path_desc.filepath;
     }
+    WARN_IF_ERROR(TabletMetaManager::remove_delete_bitmaps(this, dropped_delete_bitmap_keys),
+                  "failed to remove delete bitmaps of dropped tablets");
+    disks_load_rowsets_ms->set_value(watch.elapsed_time() / NANOS_PER_MILLIS);
+
     // At startup, we only count these invalid rowset, but do not actually delete it.
     // The actual delete operation is in StorageEngine::_clean_unused_rowset_metas,
     // which is cleaned up uniformly by the background cleanup thread.
@@ -530,6 +570,75 @@ Status DataDir::load() {
     return Status::OK();
 }
 
+void DataDir::_submit_load_task(ThreadPool* pool, std::function<void()> task) {
+    auto st = pool->submit_func(task);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to submit load task, run it in the current thread. " << st;
+        task();
+    }
+}
+
+bool DataDir::_load_rowset(const RowsetMetaSharedPtr& rowset_meta) {
+    TabletSharedPtr tablet = _tablet_manager->get_tablet(rowset_meta->tablet_id(),
+                                                         rowset_meta->tablet_schema_hash());
+    // tablet maybe dropped, but not drop related rowset meta
+    if (tablet == nullptr) {
+        VLOG_NOTICE << "could not find tablet id: " << rowset_meta->tablet_id()
+                    << ", schema hash: " << rowset_meta->tablet_schema_hash()
+                    << ", for rowset: " << rowset_meta->rowset_id() << ", skip this rowset";
+        return false;
+    }
+    RowsetSharedPtr rowset;
+    Status create_status = RowsetFactory::create_rowset(
+            &tablet->tablet_schema(), tablet->tablet_path_desc(), rowset_meta, &rowset);
+    if (!create_status) {
+        LOG(WARNING) << "could not create rowset from rowsetmeta: "
+                     << " rowset_id: " << rowset_meta->rowset_id()
+                     << " rowset_type: " << rowset_meta->rowset_type()
+                     << " rowset_state: " << rowset_meta->rowset_state();
+        return true;
+    }
+    if (rowset_meta->rowset_state() == RowsetStatePB::COMMITTED &&
+        rowset_meta->tablet_uid() == tablet->tablet_uid()) {
+        Status commit_txn_status = _txn_manager->commit_txn(
+                _meta, rowset_meta->partition_id(), rowset_meta->txn_id(),
+                rowset_meta->tablet_id(), rowset_meta->tablet_schema_hash(),
+                rowset_meta->tablet_uid(), rowset_meta->load_id(), rowset, true);
+        if (!commit_txn_status &&
+            commit_txn_status !=
+                    Status::OLAPInternalError(OLAP_ERR_PUSH_TRANSACTION_ALREADY_EXIST)) {
+            LOG(WARNING) << "failed to add committed rowset: " << rowset_meta->rowset_id()
+                         << " to tablet: " << rowset_meta->tablet_id()
+                         << " for txn: " << rowset_meta->txn_id();
+        } else {
+            LOG(INFO) << "successfully to add committed rowset: " << rowset_meta->rowset_id()
+                      << " to tablet: " << rowset_meta->tablet_id()
+                      << " schema hash: " << rowset_meta->tablet_schema_hash()
+                      << " for txn: " << rowset_meta->txn_id();
+        }
+    } else if (rowset_meta->rowset_state() == RowsetStatePB::VISIBLE &&
+               rowset_meta->tablet_uid() == tablet->tablet_uid()) {
+        Status publish_status = tablet->add_rowset(rowset, false);
+        if (!publish_status &&
+            publish_status != Status::OLAPInternalError(OLAP_ERR_PUSH_VERSION_ALREADY_EXIST)) {
+            LOG(WARNING) << "add visible rowset to tablet failed rowset_id:"
+                         << rowset->rowset_id() << " tablet id: " << rowset_meta->tablet_id()
+                         << " txn id:" << rowset_meta->txn_id()
+                         << " start_version: " << rowset_meta->version().first
+                         << " end_version: " << rowset_meta->version().second;
+        }
+    } else {
+        LOG(WARNING) << "find invalid rowset: " << rowset_meta->rowset_id()
+                     << " with tablet id: " << rowset_meta->tablet_id()
+                     << " tablet uid: " << rowset_meta->tablet_uid()
+                     << " schema hash: " << rowset_meta->tablet_schema_hash()
+                     << " txn: " << rowset_meta->txn_id()
+                     << " current valid tablet uid: " << tablet->tablet_uid();
+        return false;
+    }
+    return true;
+}
+
 void DataDir::add_pending_ids(const std::string& id) {
     std::lock_guard<std::shared_mutex> wr_lock(_pending_path_mutex);
     _pending_path_ids.insert(id);
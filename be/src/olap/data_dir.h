@@ -19,6 +19,7 @@
 
 #include <condition_variable>
 #include <cstdint>
+#include <functional>
 #include <mutex>
 #include <set>
 #include <shared_mutex>
@@ -30,6 +31,7 @@
 #include "gen_cpp/olap_file.pb.h"
 #include "olap/olap_common.h"
 #include "olap/rowset/rowset_id_generator.h"
+#include "olap/rowset/rowset_meta.h"
 #include "util/metrics.h"
 
 namespace doris {
@@ -37,6 +39,7 @@ namespace doris {
 class Tablet;
 class TabletManager;
 class TabletMeta;
+class ThreadPool;
 class TxnManager;
 
 // A DataDir used to manage data in same path.
@@ -159,6 +162,13 @@ private:
 
     bool _check_pending_ids(const std::string& id);
 
+    // run `task` in `pool`, or in the calling thread if the pool rejects it
+    void _submit_load_task(ThreadPool* pool, std::function<void()> task);
+
+    // add a committed rowset to the txn map or a visible rowset to its tablet,
+    // return false if the rowset is invalid
+    bool _load_rowset(const RowsetMetaSharedPtr& rowset_meta);
+
 private:
     bool _stop_bg_worker = false;
 
@@ -188,6 +198,8 @@ private:
     std::set<TabletInfo> _tablet_set;
 
     static const uint32_t MAX_SHARD_NUM = 1024;
+    // the number of metas parsed or loaded by a task when loading this data dir
+    static constexpr size_t LOAD_META_BATCH_SIZE = 256;
 
     OlapMeta* _meta = nullptr;
     RowsetIdGenerator* _id_generator = nullptr;
@@ -207,6 +219,10 @@ private:
     IntGauge* disks_state;
     IntGauge* disks_compaction_score;
     IntGauge* disks_compaction_num;
+    // the time spent in each phase of loading this data dir at startup
+    IntGauge* disks_load_rowset_metas_ms;
+    IntGauge* disks_load_tablets_ms;
+    IntGauge* disks_load_rowsets_ms;
 };
 
 } // namespace doris
@@ -133,6 +133,7 @@ Status DeltaWriter::init() {
     writer_context.load_id = _req.load_id;
     writer_context.segments_overlap = OVERLAPPING;
     writer_context.data_dir = _tablet->data_dir();
+    writer_context.enable_unique_key_merge_on_write = _tablet->enable_unique_key_merge_on_write();
     RETURN_NOT_OK(RowsetFactory::create_rowset_writer(writer_context, &_rowset_writer));
 
     _tablet_schema = &(_tablet->tablet_schema());
@@ -234,6 +235,13 @@ Status DeltaWriter::_flush_memtable_async() {
     if (++_segment_counter > config::max_segment_num_per_rowset) {
         return Status::OLAPInternalError(OLAP_ERR_TOO_MANY_SEGMENTS);
     }
+    // reserve the segments in the order of the memtables, as they may be flushed concurrently
+    if (_mem_table->rows() > 0) {
+        int32_t num_segments = 0;
+        int32_t segment_id = _rowset_writer->allocate_segment_ids(
+                _mem_table->rows(), _mem_table->memory_usage(), &num_segments);
+        _mem_table->set_segment_ids(segment_id, num_segments);
+    }
     return _flush_token->submit(_mem_table);
 }
 
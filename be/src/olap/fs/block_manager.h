@@ -161,6 +161,24 @@ public:
     // If an error was encountered, returns a non-OK status.
     virtual Status readv(uint64_t offset, const Slice* res, size_t res_cnt) const = 0;
 
+    // Reads exactly each of the "ranges" in the block, the ranges may be read concurrently.
+    // If an error was encountered, returns a non-OK status.
+    virtual Status read_batch(const ReadRange* ranges, size_t cnt) const {
+        for (size_t i = 0; i < cnt; ++i) {
+            RETURN_IF_ERROR(read(ranges[i].offset, ranges[i].data));
+        }
+        return Status::OK();
+    }
+
+    // Whether read_batch() issues the reads of all the ranges at once, rather than
+    // one read after another.
+    virtual bool is_batch_read_supported() const { return false; }
+
+    // Hint that `size` bytes at `offset` of the block hold the indexes, which are read before
+    // the data and by most reads. A block on the remote storage reads the range ahead into
+    // the local cache, and keeps it longer than the data.
+    virtual Status warm_up_index(uint64_t offset, uint64_t size) const { return Status::OK(); }
+
     // Returns the memory usage of this object including the object itself.
     // virtual size_t memory_footprint() const = 0;
 };
@@ -271,6 +271,10 @@ public:
 
     virtual Status readv(uint64_t offset, const Slice* results, size_t res_cnt) const override;
 
+    virtual Status read_batch(const ReadRange* ranges, size_t cnt) const override;
+
+    virtual bool is_batch_read_supported() const override;
+
     void handle_error(const Status& s) const;
 
 private:
@@ -362,6 +366,25 @@ Status FileReadableBlock::readv(uint64_t offset, const Slice* results, size_t re
     return Status::OK();
 }
 
+Status FileReadableBlock::read_batch(const ReadRange* ranges, size_t cnt) const {
+    DCHECK(!_closed.load());
+
+    RETURN_IF_ERROR(_file->read_batch(ranges, cnt));
+
+    if (_block_manager->_metrics) {
+        size_t bytes_read = accumulate(
+                ranges, ranges + cnt, static_cast<size_t>(0),
+                [&](size_t sum, const ReadRange& curr) { return sum + curr.data.size; });
+        _block_manager->_metrics->total_bytes_read->increment(bytes_read);
+    }
+
+    return Status::OK();
+}
+
+bool FileReadableBlock::is_batch_read_supported() const {
+    return _file->is_batch_read_supported();
+}
+
 } // namespace internal
 
 ////////////////////////////////////////////////////////////
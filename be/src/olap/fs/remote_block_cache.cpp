@@ -0,0 +1,327 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/fs/remote_block_cache.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "env/env.h"
+#include "gutil/strings/substitute.h"
+#include "util/coding.h"
+#include "util/doris_metrics.h"
+#include "util/storage_backend.h"
+#include "util/time.h"
+
+namespace doris {
+namespace fs {
+
+// A local file of the cache is
+//   CachedFile := Data, Key, KeyLength(4), BlockSize(4), Priority(4)
+// Key := RemotePath, BlockOffset(8)
+// A file is written with the suffix ".tmp" and renamed when it is complete.
+static const std::string kBlockFileSuffix = ".block";
+static const std::string kTmpFileSuffix = ".tmp";
+static constexpr size_t kTrailerSize = 12;
+
+struct RemoteBlockCache::CachedBlock {
+    RemoteBlockCache* cache;
+    std::string remote_path;
+    std::string local_path;
+    // the size of the data of the block
+    uint64_t size;
+};
+
+static std::string block_key(const std::string& remote_path, uint64_t block_offset) {
+    std::string key = remote_path;
+    put_fixed64_le(&key, block_offset);
+    return key;
+}
+
+static bool ends_with(const std::string& str, const std::string& suffix) {
+    return str.size() >= suffix.size() &&
+           str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+RemoteBlockCache* RemoteBlockCache::instance() {
+    // never destroyed, the blocks may still be read by other static objects at exit
+    static RemoteBlockCache* cache = []() -> RemoteBlockCache* {
+        if (config::remote_block_cache_path.empty()) {
+            return nullptr;
+        }
+        std::unique_ptr<RemoteBlockCache> cache(new RemoteBlockCache(
+                config::remote_block_cache_path, config::remote_block_cache_capacity,
+                config::remote_block_cache_block_size));
+        Status st = cache->open();
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to open remote block cache at "
+                         << config::remote_block_cache_path << ": " << st;
+            return nullptr;
+        }
+        return cache.release();
+    }();
+    return cache;
+}
+
+RemoteBlockCache::RemoteBlockCache(const std::string& path, size_t capacity,
+                                   uint32_t block_size)
+        : _path(path),
+          _capacity(capacity),
+          _block_size(std::max<uint32_t>(block_size, 4096)),
+          _next_file_id(GetCurrentTimeMicros()) {}
+
+RemoteBlockCache::~RemoteBlockCache() {
+    _closing = true;
+    _cache.reset();
+}
+
+Status RemoteBlockCache::open() {
+    RETURN_IF_ERROR(Env::Default()->create_dirs(_path));
+    _cache.reset(new_lru_cache("RemoteBlockCache", _capacity));
+
+    std::vector<std::string> children;
+    RETURN_IF_ERROR(Env::Default()->get_children(_path, &children));
+    // put the files to the cache from the least recently written one, close to the LRU order
+    // before the restart
+    std::vector<std::pair<uint64_t, std::string>> files;
+    for (const auto& child : children) {
+        std::string file_path = _path + "/" + child;
+        if (ends_with(child, kTmpFileSuffix)) {
+            WARN_IF_ERROR(Env::Default()->delete_file(file_path),
+                          "failed to delete incomplete file " + file_path);
+            continue;
+        }
+        if (!ends_with(child, kBlockFileSuffix)) {
+            continue;
+        }
+        uint64_t mtime = 0;
+        WARN_IF_ERROR(Env::Default()->get_file_modified_time(file_path, &mtime),
+                      "failed to get modified time of " + file_path);
+        files.emplace_back(mtime, child);
+        // never reuse the name of a file cached before
+        uint64_t file_id = strtoull(child.c_str(), nullptr, 10);
+        if (file_id >= _next_file_id) {
+            _next_file_id = file_id + 1;
+        }
+    }
+    std::sort(files.begin(), files.end());
+    for (const auto& file : files) {
+        Status st = _load_block(file.second);
+        if (!st.ok()) {
+            LOG(WARNING) << "drop bad remote block cache file " << file.second << ": " << st;
+            WARN_IF_ERROR(Env::Default()->delete_file(_path + "/" + file.second),
+                          "failed to delete " + file.second);
+        }
+    }
+    LOG(INFO) << "open remote block cache at " << _path << ", " << files.size()
+              << " blocks are loaded";
+    return Status::OK();
+}
+
+Status RemoteBlockCache::_load_block(const std::string& file_name) {
+    std::string local_path = _path + "/" + file_name;
+    std::unique_ptr<RandomAccessFile> file;
+    RETURN_IF_ERROR(Env::Default()->new_random_access_file(local_path, &file));
+    uint64_t file_size = 0;
+    RETURN_IF_ERROR(file->size(&file_size));
+    if (file_size < kTrailerSize) {
+        return Status::Corruption(strings::Substitute("file size $0 is too small", file_size));
+    }
+    uint8_t trailer[kTrailerSize];
+    Slice trailer_slice(trailer, kTrailerSize);
+    RETURN_IF_ERROR(file->read_at(file_size - kTrailerSize, &trailer_slice));
+    uint32_t key_length = decode_fixed32_le(trailer);
+    uint32_t block_size = decode_fixed32_le(trailer + 4);
+    uint32_t priority = decode_fixed32_le(trailer + 8);
+    if (block_size != _block_size) {
+        return Status::Corruption(
+                strings::Substitute("block size $0 is not $1", block_size, _block_size));
+    }
+    if (file_size < kTrailerSize + key_length) {
+        return Status::Corruption(strings::Substitute("bad key length $0", key_length));
+    }
+    std::string key;
+    key.resize(key_length);
+    Slice key_slice(key);
+    RETURN_IF_ERROR(file->read_at(file_size - kTrailerSize - key_length, &key_slice));
+
+    if (key_length < sizeof(uint64_t)) {
+        return Status::Corruption(strings::Substitute("bad key length $0", key_length));
+    }
+    auto* block = new CachedBlock {this, key.substr(0, key_length - sizeof(uint64_t)), local_path,
+                                   file_size - kTrailerSize - key_length};
+    auto* handle = _cache->insert(
+            key, block, block->size, &RemoteBlockCache::_delete_cached_block,
+            priority == static_cast<uint32_t>(CachePriority::DURABLE) ? CachePriority::DURABLE
+                                                                       : CachePriority::NORMAL);
+    _cache->release(handle);
+    return Status::OK();
+}
+
+void RemoteBlockCache::_delete_cached_block(const CacheKey& key, void* value) {
+    auto* block = static_cast<CachedBlock*>(value);
+    // the block is evicted, or is replaced by the same block downloaded concurrently
+    if (!block->cache->_closing) {
+        WARN_IF_ERROR(Env::Default()->delete_file(block->local_path),
+                      "failed to delete evicted block " + block->local_path);
+    }
+    delete block;
+}
+
+Status RemoteBlockCache::read_at(StorageBackend* storage_backend, const std::string& remote_path,
+                                 uint64_t offset, const Slice& result, bool is_index) {
+    CachePriority priority = is_index ? CachePriority::DURABLE : CachePriority::NORMAL;
+    size_t bytes_read = 0;
+    while (bytes_read < result.size) {
+        uint64_t pos = offset + bytes_read;
+        uint64_t block_offset = pos - pos % _block_size;
+        uint64_t offset_in_block = pos - block_offset;
+        size_t bytes = std::min<uint64_t>(result.size - bytes_read,
+                                          _block_size - offset_in_block);
+        RETURN_IF_ERROR(_read_block(storage_backend, remote_path, block_offset, offset_in_block,
+                                    Slice(result.data + bytes_read, bytes), priority));
+        bytes_read += bytes;
+    }
+    return Status::OK();
+}
+
+Status RemoteBlockCache::warm_up(StorageBackend* storage_backend, const std::string& remote_path,
+                                 uint64_t offset, uint64_t size) {
+    if (size == 0) {
+        return Status::OK();
+    }
+    uint64_t end = offset + size;
+    for (uint64_t block_offset = offset - offset % _block_size; block_offset < end;
+         block_offset += _block_size) {
+        RETURN_IF_ERROR(_read_block(storage_backend, remote_path, block_offset, 0, Slice(),
+                                    CachePriority::DURABLE));
+    }
+    return Status::OK();
+}
+
+void RemoteBlockCache::erase(const std::string& remote_path, bool is_dir) {
+    std::string dir_prefix = remote_path + "/";
+    int64_t num_erased = _cache->prune_if([&](const void* value) {
+        const auto* block = static_cast<const CachedBlock*>(value);
+        if (!is_dir) {
+            return block->remote_path == remote_path;
+        }
+        return block->remote_path.compare(0, dir_prefix.size(), dir_prefix) == 0;
+    });
+    VLOG_NOTICE << "erase " << num_erased << " cached blocks of " << remote_path;
+}
+
+Status RemoteBlockCache::_read_block(StorageBackend* storage_backend,
+                                     const std::string& remote_path, uint64_t block_offset,
+                                     uint64_t offset_in_block, const Slice& result,
+                                     CachePriority priority) {
+    std::string key = block_key(remote_path, block_offset);
+    auto* handle = _cache->lookup(key);
+    if (handle != nullptr) {
+        auto* block = static_cast<CachedBlock*>(_cache->value(handle));
+        Status st;
+        if (offset_in_block + result.size > block->size) {
+            st = Status::IOError(strings::Substitute(
+                    "cannot read $0 bytes at $1 of $2, the file ends at $3", result.size,
+                    block_offset + offset_in_block, remote_path, block_offset + block->size));
+        } else if (result.size > 0) {
+            std::unique_ptr<RandomAccessFile> file;
+            st = Env::Default()->new_random_access_file(block->local_path, &file);
+            if (st.ok()) {
+                st = file->read_at(offset_in_block, &result);
+            }
+            if (!st.ok()) {
+                // download the block again if the local file is broken
+                LOG(WARNING) << "failed to read cached block " << block->local_path << ": "
+                             << st;
+                _cache->release(handle);
+                _cache->erase(key);
+                handle = nullptr;
+            }
+        }
+        if (handle != nullptr) {
+            _cache->release(handle);
+            if (st.ok()) {
+                DorisMetrics::instance()->remote_block_cache_hit_bytes_total->increment(
+                        result.size);
+            }
+            return st;
+        }
+    }
+
+    std::string data;
+    RETURN_IF_ERROR(storage_backend->direct_download_range(remote_path, block_offset, _block_size,
+                                                           &data));
+    DorisMetrics::instance()->remote_block_cache_download_bytes_total->increment(data.size());
+    if (offset_in_block + result.size > data.size()) {
+        return Status::IOError(strings::Substitute(
+                "cannot read $0 bytes at $1 of $2, the file ends at $3", result.size,
+                block_offset + offset_in_block, remote_path, block_offset + data.size()));
+    }
+    if (result.size > 0) {
+        memcpy(result.data, data.data() + offset_in_block, result.size);
+    }
+    if (!data.empty()) {
+        // the data is read anyway, the next read downloads the block again if it is not cached
+        WARN_IF_ERROR(_cache_block(key, data, priority),
+                      "failed to cache block of " + remote_path);
+    }
+    return Status::OK();
+}
+
+Status RemoteBlockCache::_cache_block(const std::string& key, const std::string& data,
+                                      CachePriority priority) {
+    std::string trailer = key;
+    put_fixed32_le(&trailer, key.size());
+    put_fixed32_le(&trailer, _block_size);
+    put_fixed32_le(&trailer, static_cast<uint32_t>(priority));
+
+    std::string file_name = std::to_string(_next_file_id++);
+    std::string tmp_path = _path + "/" + file_name + kTmpFileSuffix;
+    std::string local_path = _path + "/" + file_name + kBlockFileSuffix;
+    {
+        std::unique_ptr<WritableFile> file;
+        RETURN_IF_ERROR(Env::Default()->new_writable_file(tmp_path, &file));
+        Slice slices[2] = {data, trailer};
+        Status st = file->appendv(slices, 2);
+        if (st.ok()) {
+            st = file->close();
+        }
+        if (st.ok()) {
+            st = Env::Default()->rename_file(tmp_path, local_path);
+        }
+        if (!st.ok()) {
+            WARN_IF_ERROR(Env::Default()->delete_file(tmp_path), "failed to delete " + tmp_path);
+            return st;
+        }
+    }
+
+    auto* block = new CachedBlock {this, key.substr(0, key.size() - sizeof(uint64_t)), local_path,
+                                   data.size()};
+    auto* handle = _cache->insert(key, block, block->size,
+                                  &RemoteBlockCache::_delete_cached_block, priority);
+    _cache->release(handle);
+    return Status::OK();
+}
+
+} // namespace fs
+} // namespace doris
@@ -0,0 +1,109 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "common/status.h"
+#include "gutil/macros.h"
+#include "olap/lru_cache.h"
+#include "util/slice.h"
+
+namespace doris {
+
+class StorageBackend;
+
+namespace fs {
+
+// A cache of the files on the remote storage, kept in a directory of the local disk.
+//
+// The remote files are downloaded and cached in blocks of `block_size` bytes, a block is
+// kept in a local file of its own and keyed by the remote path and the offset of the block.
+// The blocks are evicted in LRU order when the cached bytes exceed `capacity`, but the
+// blocks holding the indexes of the segments are cached with CachePriority::DURABLE and are
+// evicted only after all the blocks of data, so a scan over the cold data does not flush
+// the footers and the indexes which every query reads first.
+//
+// The local files are found again after restart, so the cache survives the restart of BE.
+class RemoteBlockCache {
+public:
+    // Return the cache of the process configured by `config::remote_block_cache_path`, or
+    // nullptr if no path is configured or the cache fails to open.
+    static RemoteBlockCache* instance();
+
+    RemoteBlockCache(const std::string& path, size_t capacity, uint32_t block_size);
+
+    // The cached files are kept for the next open.
+    ~RemoteBlockCache();
+
+    // Create the cache directory if missing, and load the blocks cached before.
+    Status open();
+
+    // Read `result.size` bytes at `offset` of the remote file `remote_path`, the blocks not
+    // cached are downloaded by `storage_backend` and cached. `is_index` tells whether the
+    // range holds the indexes of a segment.
+    Status read_at(StorageBackend* storage_backend, const std::string& remote_path,
+                   uint64_t offset, const Slice& result, bool is_index);
+
+    // Download and cache the blocks covering `size` bytes at `offset` of the remote file as
+    // the blocks of the indexes, the blocks already cached are not downloaded again.
+    Status warm_up(StorageBackend* storage_backend, const std::string& remote_path,
+                   uint64_t offset, uint64_t size);
+
+    // Drop all the cached blocks of the remote file `remote_path`, or of all the files under
+    // it if `is_dir` is true, called when the remote files are deleted. A block being read at
+    // the same time is dropped when it is evicted.
+    void erase(const std::string& remote_path, bool is_dir);
+
+    uint32_t block_size() const { return _block_size; }
+
+private:
+    struct CachedBlock;
+
+    // Read `result.size` bytes at `offset_in_block` of the block at `block_offset`, downloading
+    // the block if it is not cached. `result` may be empty to only cache the block.
+    Status _read_block(StorageBackend* storage_backend, const std::string& remote_path,
+                       uint64_t block_offset, uint64_t offset_in_block, const Slice& result,
+                       CachePriority priority);
+
+    // Write the block to a local file and put it in the cache.
+    Status _cache_block(const std::string& key, const std::string& data,
+                        CachePriority priority);
+
+    // Load a local file written by _cache_block() before.
+    Status _load_block(const std::string& file_name);
+
+    static void _delete_cached_block(const CacheKey& key, void* value);
+
+    const std::string _path;
+    const size_t _capacity;
+    const uint32_t _block_size;
+    std::unique_ptr<Cache> _cache;
+    // gives each local file an unique name
+    std::atomic<uint64_t> _next_file_id;
+    // set before destroying `_cache` to keep the local files
+    bool _closing = false;
+
+    DISALLOW_COPY_AND_ASSIGN(RemoteBlockCache);
+};
+
+} // namespace fs
+} // namespace doris
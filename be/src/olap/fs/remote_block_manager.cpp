@@ -32,6 +32,8 @@
 #include "env/env_util.h"
 #include "gutil/strings/substitute.h"
 #include "olap/fs/block_id.h"
+#include "olap/fs/remote_block_cache.h"
+#include "olap/storage_engine.h"
 #include "util/storage_backend.h"
 
 using std::shared_ptr;
@@ -173,7 +175,8 @@ Status RemoteWritableBlock::_close(SyncMode mode) {
 // RemoteReadableBlock
 ////////////////////////////////////////////////////////////
 
-// A file-backed block that has been opened for reading.
+// A remote-backed block that has been opened for reading, it reads the local file if the
+// file exists, or reads the remote file otherwise.
 //
 // There may be millions of instances of RemoteReadableBlock outstanding, so
 // great care must be taken to reduce its size. To that end, it does _not_
@@ -198,6 +201,8 @@ public:
 
     virtual Status readv(uint64_t offset, const Slice* results, size_t res_cnt) const override;
 
+    virtual Status warm_up_index(uint64_t offset, uint64_t size) const override;
+
     void handle_error(const Status& s) const;
 
 private:
@@ -222,12 +227,27 @@ private:
 
 RemoteReadableBlock::RemoteReadableBlock(
         RemoteBlockManager* block_manager, const FilePathDesc& path_desc,
-        std::shared_ptr<OpenedFileHandle<RandomAccessFile>> file_handle) {}
+        std::shared_ptr<OpenedFileHandle<RandomAccessFile>> file_handle)
+        : _block_manager(block_manager),
+          _path_desc(path_desc),
+          _file_handle(std::move(file_handle)),
+          _closed(false) {
+    if (_file_handle != nullptr) {
+        _file = _file_handle->file();
+    }
+}
 
-RemoteReadableBlock::~RemoteReadableBlock() {}
+RemoteReadableBlock::~RemoteReadableBlock() {
+    WARN_IF_ERROR(close(), strings::Substitute("Failed to close block $0", _path_desc.filepath));
+}
 
 Status RemoteReadableBlock::close() {
-    return Status::IOError("invalid function", 0, "");
+    bool expected = false;
+    if (_closed.compare_exchange_strong(expected, true)) {
+        _file_handle.reset();
+        _file = nullptr;
+    }
+    return Status::OK();
 }
 
 BlockManager* RemoteReadableBlock::block_manager() const {
@@ -244,7 +264,11 @@ const FilePathDesc& RemoteReadableBlock::path_desc() const {
 }
 
 Status RemoteReadableBlock::size(uint64_t* sz) const {
-    return Status::IOError("invalid function", 0, "");
+    DCHECK(!_closed.load());
+    if (_file != nullptr) {
+        return _file->size(sz);
+    }
+    return _block_manager->_remote_file_size(_path_desc.remote_path, sz);
 }
 
 Status RemoteReadableBlock::read(uint64_t offset, Slice result) const {
@@ -252,7 +276,24 @@ Status RemoteReadableBlock::read(uint64_t offset, Slice result) const {
 }
 
 Status RemoteReadableBlock::readv(uint64_t offset, const Slice* results, size_t res_cnt) const {
-    return Status::IOError("invalid function", 0, "");
+    DCHECK(!_closed.load());
+    if (_file != nullptr) {
+        return _file->readv_at(offset, results, res_cnt);
+    }
+    for (size_t i = 0; i < res_cnt; ++i) {
+        RETURN_IF_ERROR(_block_manager->_read_remote(_path_desc.remote_path, offset, results[i]));
+        offset += results[i].size;
+    }
+    return Status::OK();
+}
+
+Status RemoteReadableBlock::warm_up_index(uint64_t offset, uint64_t size) const {
+    DCHECK(!_closed.load());
+    if (_file != nullptr || _block_manager->_remote_block_cache == nullptr) {
+        return Status::OK();
+    }
+    return _block_manager->_remote_block_cache->warm_up(_block_manager->_storage_backend.get(),
+                                                        _path_desc.remote_path, offset, size);
 }
 
 } // namespace internal
@@ -264,7 +305,18 @@ Status RemoteReadableBlock::readv(uint64_t offset, const Slice* results, size_t
 RemoteBlockManager::RemoteBlockManager(Env* local_env,
                                        std::shared_ptr<StorageBackend> storage_backend,
                                        const BlockManagerOptions& opts)
-        : _local_env(local_env), _storage_backend(storage_backend), _opts(opts) {}
+        : _local_env(local_env),
+          _storage_backend(storage_backend),
+          _opts(opts),
+          _remote_block_cache(RemoteBlockCache::instance()) {
+#ifdef BE_TEST
+    _file_cache.reset(new FileCache<RandomAccessFile>("Readable_file_cache",
+                                                      config::file_descriptor_cache_capacity));
+#else
+    _file_cache.reset(new FileCache<RandomAccessFile>("Readable_file_cache",
+                                                      StorageEngine::instance()->file_cache()));
+#endif
+}
 
 RemoteBlockManager::~RemoteBlockManager() {}
 
@@ -311,6 +363,39 @@ Status RemoteBlockManager::open_block(const FilePathDesc& path_desc,
     return Status::OK();
 }
 
+Status RemoteBlockManager::_remote_file_size(const std::string& remote_path, uint64_t* size) {
+    {
+        std::lock_guard<std::mutex> l(_file_sizes_lock);
+        auto it = _file_sizes.find(remote_path);
+        if (it != _file_sizes.end()) {
+            *size = it->second;
+            return Status::OK();
+        }
+    }
+    RETURN_IF_ERROR(_storage_backend->file_size(remote_path, size));
+    std::lock_guard<std::mutex> l(_file_sizes_lock);
+    _file_sizes[remote_path] = *size;
+    return Status::OK();
+}
+
+Status RemoteBlockManager::_read_remote(const std::string& remote_path, uint64_t offset,
+                                        const Slice& result) {
+    if (_remote_block_cache != nullptr) {
+        return _remote_block_cache->read_at(_storage_backend.get(), remote_path, offset, result,
+                                            false);
+    }
+    std::string content;
+    RETURN_IF_ERROR(
+            _storage_backend->direct_download_range(remote_path, offset, result.size, &content));
+    if (content.size() != result.size) {
+        return Status::IOError(strings::Substitute("cannot read $0 bytes at $1 of $2, only $3",
+                                                   result.size, offset, remote_path,
+                                                   content.size()));
+    }
+    memcpy(result.data, content.data(), result.size);
+    return Status::OK();
+}
+
 Status RemoteBlockManager::delete_block(const FilePathDesc& path_desc, bool is_dir) {
     if (is_dir) {
         if (_local_env->path_exists(path_desc.filepath).ok()) {
@@ -318,6 +403,9 @@ Status RemoteBlockManager::delete_block(const FilePathDesc& path_desc, bool is_d
         }
         if (!path_desc.remote_path.empty()) {
             RETURN_IF_ERROR(_storage_backend->rmdir(path_desc.remote_path));
+            if (_remote_block_cache != nullptr) {
+                _remote_block_cache->erase(path_desc.remote_path, true);
+            }
         }
     } else {
         if (_local_env->path_exists(path_desc.filepath).ok()) {
@@ -326,6 +414,12 @@ Status RemoteBlockManager::delete_block(const FilePathDesc& path_desc, bool is_d
         if (_storage_backend->exist(path_desc.remote_path).ok()) {
             RETURN_IF_ERROR(_storage_backend->rm(path_desc.remote_path));
         }
+        // the index blocks are cached as DURABLE and would never be evicted by the data blocks
+        if (_remote_block_cache != nullptr) {
+            _remote_block_cache->erase(path_desc.remote_path, false);
+        }
+        std::lock_guard<std::mutex> l(_file_sizes_lock);
+        _file_sizes.erase(path_desc.remote_path);
     }
     return Status::OK();
 }
@@ -19,7 +19,9 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -35,7 +37,16 @@ class StorageBackend;
 
 namespace fs {
 
+class RemoteBlockCache;
+
+namespace internal {
+class RemoteReadableBlock;
+} // namespace internal
+
 // The remote-backed block manager.
+//
+// A block is read from the local file if it exists, or from the remote storage otherwise.
+// The remote reads go through RemoteBlockCache if `config::remote_block_cache_path` is set.
 class RemoteBlockManager : public BlockManager {
 public:
     // Note: all objects passed as pointers should remain alive for the lifetime
@@ -62,11 +73,25 @@ public:
                      const FilePathDesc& dest_path_desc) override;
 
 private:
+    friend class internal::RemoteReadableBlock;
+
+    // Return the size of the remote file, the sizes are kept as the remote files are never
+    // modified once uploaded.
+    Status _remote_file_size(const std::string& remote_path, uint64_t* size);
+
+    // Read `result.size` bytes at `offset` of the remote file.
+    Status _read_remote(const std::string& remote_path, uint64_t offset, const Slice& result);
+
     Env* _local_env;
     std::shared_ptr<StorageBackend> _storage_backend;
     const BlockManagerOptions _opts;
     // Underlying cache instance. Caches opened files.
     std::unique_ptr<FileCache<RandomAccessFile>> _file_cache;
+    // nullptr if the remote files are not cached
+    RemoteBlockCache* _remote_block_cache;
+
+    std::mutex _file_sizes_lock;
+    std::unordered_map<std::string, uint64_t> _file_sizes;
 };
 
 } // namespace fs
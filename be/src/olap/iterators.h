@@ -18,6 +18,9 @@
 #pragma once
 
 #include <memory>
+#include <roaring/roaring.hh>
+#include <set>
+#include <unordered_map>
 
 #include "common/status.h"
 #include "olap/olap_common.h"
@@ -71,6 +74,11 @@ public:
     // delete conditions used by column index to filter pages
     std::vector<const Conditions*> delete_conditions;
 
+    // conditions of the runtime filters which arrived after the read started, nullptr if
+    // not existed. The reader may append to it between two batches, used by column index
+    // to filter the pages not read yet
+    const std::vector<std::unique_ptr<Conditions>>* runtime_conditions = nullptr;
+
     std::shared_ptr<AndBlockColumnPredicate> delete_condition_predicates =
             std::make_shared<AndBlockColumnPredicate>();
     // reader's column predicate, nullptr if not existed
@@ -79,10 +87,19 @@ public:
     // to unify Conditions and ColumnPredicate
     std::vector<ColumnPredicate*> column_predicates;
 
+    // segment id -> rows overwritten in merge-on-write tablet, which are filtered out
+    std::unordered_map<uint32_t, std::shared_ptr<roaring::Roaring>> delete_bitmap;
+
     // REQUIRED (null is not allowed)
     OlapReaderStatistics* stats = nullptr;
     bool use_page_cache = false;
     int block_row_max = 4096;
+
+    // VARCHAR and STRING columns output as (nullable) ColumnDictionary, holding the codes of
+    // the rows and sharing the dictionary of the segment, when their pages are dictionary
+    // encoded. Only asked when the blocks of the segments are passed to the caller unmerged,
+    // and the caller must decode them before reading the next block.
+    std::set<ColumnId> dict_code_columns;
 };
 
 // Used to read data in RowBlockV2 one by one
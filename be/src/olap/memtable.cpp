@@ -17,6 +17,7 @@
 
 #include "olap/memtable.h"
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "olap/row.h"
 #include "olap/rowset/column_data_writer.h"
@@ -24,7 +25,9 @@
 #include "olap/schema.h"
 #include "runtime/tuple.h"
 #include "util/doris_metrics.h"
+#include "vec/common/arena.h"
 #include "vec/core/field.h"
+#include "vec/core/sort_block.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
 #include "vec/aggregate_functions/aggregate_function_reader.h"
 
@@ -50,9 +53,14 @@ MemTable::MemTable(int64_t tablet_id, Schema* schema, const TabletSchema* tablet
     if (support_vec) {
         _skip_list = nullptr;
         _vec_row_comparator = std::make_shared<RowInBlockComparator>(_schema);
-        // TODO: Support ZOrderComparator in the future
-        _vec_skip_list = new VecTable(_vec_row_comparator.get(), _table_mem_pool.get(),
-                                      _keys_type == KeysType::DUP_KEYS);
+        if (config::enable_vectorized_memtable_sort_merge) {
+            // rows are only appended to _input_mutable_block, see _sort_and_merge_block()
+            _vec_skip_list = nullptr;
+        } else {
+            // TODO: Support ZOrderComparator in the future
+            _vec_skip_list = new VecTable(_vec_row_comparator.get(), _table_mem_pool.get(),
+                                          _keys_type == KeysType::DUP_KEYS);
+        }
     } else {
         _vec_skip_list = nullptr;
         if (tablet_schema->sort_type() == SortType::ZORDER) {
@@ -125,6 +133,12 @@ void MemTable::insert(const vectorized::Block* block, size_t row_pos, size_t num
     _mem_usage += newsize - oldsize;
     _mem_tracker->consume(newsize - oldsize);
 
+    if (_vec_skip_list == nullptr) {
+        // sort and aggregate all rows at once in flush
+        _rows += num_rows;
+        return;
+    }
+
     for (int i = 0; i < num_rows; i++) {
         _row_in_blocks.emplace_back(new RowInBlock {cursor_in_mutableblock + i});
         _insert_one_row_from_block(_row_in_blocks.back());
@@ -263,6 +277,78 @@ vectorized::Block MemTable::_collect_vskiplist_results() {
     return _output_mutable_block.to_block();
 }
 
+vectorized::Block MemTable::_sort_and_merge_block() {
+    vectorized::Block in_block = _input_mutable_block.to_block();
+    if (in_block.rows() == 0) {
+        return _output_mutable_block.to_block();
+    }
+
+    size_t num_key_columns = _schema->num_key_columns();
+    // same order as RowInBlockComparator, which compares with nulls first
+    vectorized::SortDescription sort_desc;
+    for (size_t i = 0; i < num_key_columns; ++i) {
+        sort_desc.emplace_back(i, 1, -1);
+    }
+    bool has_sequence_col =
+            _keys_type != KeysType::DUP_KEYS && _tablet_schema->has_sequence_col();
+    if (has_sequence_col) {
+        // the row with the largest sequence value is added last in its key group,
+        // so the replace aggregation keeps it.
+        sort_desc.emplace_back(_tablet_schema->sequence_col_idx(), 1, -1);
+    }
+    // stable sort keeps the load order of the rows with equal keys, which
+    // matters for the replace aggregation.
+    vectorized::stable_sort_block(in_block, sort_desc);
+
+    if (_keys_type == KeysType::DUP_KEYS) {
+        return in_block;
+    }
+
+    // one aggregate state per value column, reset after each key group
+    vectorized::Arena agg_arena;
+    std::vector<vectorized::AggregateDataPtr> agg_places(_schema->num_columns(), nullptr);
+    std::vector<bool> has_null(_schema->num_columns(), false);
+    for (size_t cid = num_key_columns; cid < _schema->num_columns(); ++cid) {
+        auto function = _agg_functions[cid];
+        agg_places[cid] =
+                agg_arena.aligned_alloc(function->size_of_data(), function->align_of_data());
+        function->create(agg_places[cid]);
+        has_null[cid] = in_block.get_by_position(cid).column->has_null();
+    }
+
+    auto& output_columns = _output_mutable_block.mutable_columns();
+    size_t rows = in_block.rows();
+    size_t group_begin = 0;
+    for (size_t row = 1; row <= rows; ++row) {
+        if (row < rows &&
+            in_block.compare_at(row, group_begin, num_key_columns, in_block, -1) == 0) {
+            continue;
+        }
+        // rows in [group_begin, row) have the same key
+        for (size_t cid = 0; cid < num_key_columns; ++cid) {
+            output_columns[cid]->insert_from(*in_block.get_by_position(cid).column,
+                                             group_begin);
+        }
+        for (size_t cid = num_key_columns; cid < _schema->num_columns(); ++cid) {
+            auto function = _agg_functions[cid];
+            auto place = agg_places[cid];
+            auto column_ptr = in_block.get_by_position(cid).column.get();
+            function->add_batch_range(group_begin, row - 1, place,
+                                      const_cast<const vectorized::IColumn**>(&column_ptr),
+                                      &agg_arena, has_null[cid]);
+            function->insert_result_into(place, *output_columns[cid]);
+            function->destroy(place);
+            function->create(place);
+        }
+        group_begin = row;
+    }
+
+    for (size_t cid = num_key_columns; cid < _schema->num_columns(); ++cid) {
+        _agg_functions[cid]->destroy(agg_places[cid]);
+    }
+    return _output_mutable_block.to_block();
+}
+
 Status MemTable::flush() {
     VLOG_CRITICAL << "begin to flush memtable for tablet: " << _tablet_id
                   << ", memsize: " << memory_usage() << ", rows: " << _rows;
@@ -278,7 +364,8 @@ Status MemTable::flush() {
 Status MemTable::_do_flush(int64_t& duration_ns) {
     SCOPED_RAW_TIMER(&duration_ns);
     if (_skip_list) {
-        Status st = _rowset_writer->flush_single_memtable(this, &_flush_size);
+        Status st = _rowset_writer->flush_single_memtable(this, _segment_id, _num_segments,
+                                                          &_flush_size);
         if (st == Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED)) {
             // For alpha rowset, we do not implement "flush_single_memtable".
             // Flush the memtable like the old way.
@@ -294,10 +381,17 @@ Status MemTable::_do_flush(int64_t& duration_ns) {
             RETURN_NOT_OK(st);
         }
     } else {
-        vectorized::Block block = _collect_vskiplist_results();
-        RETURN_NOT_OK(_rowset_writer->add_block(&block));
-        _flush_size = block.allocated_bytes();
-        RETURN_NOT_OK(_rowset_writer->flush());
+        vectorized::Block block = _vec_skip_list != nullptr ? _collect_vskiplist_results()
+                                                            : _sort_and_merge_block();
+        Status st = _rowset_writer->flush_single_memtable(&block, _segment_id, _num_segments,
+                                                          &_flush_size);
+        if (st == Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED)) {
+            RETURN_NOT_OK(_rowset_writer->add_block(&block));
+            _flush_size = block.allocated_bytes();
+            RETURN_NOT_OK(_rowset_writer->flush());
+        } else {
+            RETURN_NOT_OK(st);
+        }
     }
     return Status::OK();
 }
@@ -60,6 +60,15 @@ public:
 
     int64_t flush_size() const { return _flush_size; }
 
+    // Number of rows inserted to this memtable
+    int64_t rows() const { return _rows; }
+
+    // The segments this memtable is flushed to, see RowsetWriter::allocate_segment_ids()
+    void set_segment_ids(int32_t segment_id, int32_t num_segments) {
+        _segment_id = segment_id;
+        _num_segments = num_segments;
+    }
+
 private:
     Status _do_flush(int64_t& duration_ns);
 
@@ -181,6 +190,8 @@ private:
 
     // the data size flushed on disk of this memtable
     int64_t _flush_size = 0;
+    int32_t _segment_id = -1;
+    int32_t _num_segments = 0;
     // Number of rows inserted to this memtable.
     // This is not the rows in this memtable, because rows may be merged
     // in unique or aggragate key model.
@@ -190,6 +201,9 @@ private:
     vectorized::MutableBlock _input_mutable_block;
     vectorized::MutableBlock _output_mutable_block;
     vectorized::Block _collect_vskiplist_results();
+    // sort the whole _input_mutable_block by key columns and aggregate the rows
+    // with equal keys, used when the skiplist is disabled.
+    vectorized::Block _sort_and_merge_block();
     bool _is_first_insertion;
 
     void _init_agg_functions(const vectorized::Block* block);
@@ -45,8 +45,9 @@ struct FlushStatistic {
 std::ostream& operator<<(std::ostream& os, const FlushStatistic& stat);
 
 // A thin wrapper of ThreadPoolToken to submit task.
-// For a tablet, there may be multiple memtables, which will be flushed to disk
-// one by one in the order of generation.
+// For a tablet, there may be multiple memtables. For beta rowset, they are flushed
+// to disk concurrently, each to the segment reserved for it in the order of generation;
+// otherwise they are flushed one by one in the order of generation.
 // If a memtable flush fails, then:
 // 1. Immediately disallow submission of any subsequent memtable
 // 2. For the memtables that have already been submitted, there is no need to flush,
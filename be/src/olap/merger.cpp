@@ -20,9 +20,11 @@
 #include <memory>
 #include <vector>
 
+#include "olap/delete_handler.h"
 #include "olap/olap_define.h"
 #include "olap/tuple_reader.h"
 #include "vec/olap/block_reader.h"
+#include "vec/olap/vertical_block_reader.h"
 #include "olap/row_cursor.h"
 #include "olap/tablet.h"
 #include "util/trace.h"
@@ -133,4 +135,125 @@ Status Merger::vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
     return Status::OK();
 }
 
+void Merger::vertical_split_columns(const TabletSchema& tablet_schema,
+                                    std::vector<std::vector<uint32_t>>* column_groups) {
+    std::vector<uint32_t> key_columns;
+    std::vector<uint32_t> value_columns;
+    for (uint32_t cid = 0; cid < tablet_schema.num_columns(); ++cid) {
+        // the sequence column decides the row kept for a key, so it is merged with the keys
+        if (tablet_schema.column(cid).is_key() ||
+            static_cast<int32_t>(cid) == tablet_schema.sequence_col_idx()) {
+            key_columns.push_back(cid);
+        } else {
+            value_columns.push_back(cid);
+        }
+    }
+    column_groups->push_back(std::move(key_columns));
+
+    size_t group_size = std::max(1, config::vertical_compaction_num_columns_per_group);
+    for (size_t i = 0; i < value_columns.size(); i += group_size) {
+        column_groups->emplace_back(
+                value_columns.begin() + i,
+                value_columns.begin() + std::min(i + group_size, value_columns.size()));
+    }
+}
+
+Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
+                                      const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+                                      RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
+                                      Statistics* stats_output) {
+    TRACE_COUNTER_SCOPE_LATENCY_US("merge_rowsets_latency_us");
+
+    const auto& schema = tablet->tablet_schema();
+    std::vector<std::vector<uint32_t>> column_groups;
+    vertical_split_columns(schema, &column_groups);
+
+    // the keys, the sequence column and the columns of the delete conditions are read by
+    // every group, so that the rows are filtered and merged the same way in each group
+    std::set<uint32_t> common_columns(column_groups[0].begin(), column_groups[0].end());
+    if (reader_type == READER_BASE_COMPACTION) {
+        DeleteHandler delete_handler;
+        {
+            std::shared_lock rdlock(tablet->get_header_lock());
+            RETURN_NOT_OK(delete_handler.init(schema, tablet->delete_predicates(),
+                                              dst_rowset_writer->version().second));
+        }
+        for (const auto& conds : delete_handler.get_delete_conditions()) {
+            for (const auto& cond_column : conds.del_cond->columns()) {
+                common_columns.insert(cond_column.first);
+            }
+        }
+    }
+
+    vectorized::RowSourcesBuffer row_sources;
+    for (size_t i = 0; i < column_groups.size(); ++i) {
+        bool is_key = i == 0;
+        // each value group reads the rowsets again from the beginning
+        std::vector<RowsetReaderSharedPtr> rs_readers;
+        if (is_key) {
+            rs_readers = src_rowset_readers;
+        } else {
+            for (const auto& src_rs_reader : src_rowset_readers) {
+                RowsetReaderSharedPtr rs_reader;
+                RETURN_NOT_OK(src_rs_reader->rowset()->create_reader(&rs_reader));
+                rs_readers.push_back(std::move(rs_reader));
+            }
+        }
+        RETURN_NOT_OK(_vertical_merge_column_group(
+                tablet, reader_type, rs_readers, dst_rowset_writer, max_rows_per_segment,
+                column_groups[i], common_columns, is_key, &row_sources,
+                is_key ? stats_output : nullptr));
+    }
+
+    RETURN_NOT_OK_LOG(
+            dst_rowset_writer->final_flush(),
+            "failed to flush rowset when merging rowsets of tablet " + tablet->full_name());
+    return Status::OK();
+}
+
+Status Merger::_vertical_merge_column_group(
+        TabletSharedPtr tablet, ReaderType reader_type,
+        const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+        RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
+        const std::vector<uint32_t>& column_group, const std::set<uint32_t>& common_columns,
+        bool is_key, vectorized::RowSourcesBuffer* row_sources, Statistics* stats_output) {
+    vectorized::VerticalBlockReader reader(row_sources);
+    TabletReader::ReaderParams reader_params;
+    reader_params.tablet = tablet;
+    reader_params.reader_type = reader_type;
+    reader_params.rs_readers = src_rowset_readers;
+    reader_params.version = dst_rowset_writer->version();
+
+    std::set<uint32_t> read_columns(common_columns);
+    read_columns.insert(column_group.begin(), column_group.end());
+    reader_params.return_columns.assign(read_columns.begin(), read_columns.end());
+    reader_params.origin_return_columns = &reader_params.return_columns;
+    RETURN_NOT_OK(reader.init(reader_params, column_group, is_key));
+
+    vectorized::Block block = tablet->tablet_schema().create_block(column_group);
+    size_t output_rows = 0;
+    bool eof = false;
+    while (!eof) {
+        RETURN_NOT_OK_LOG(
+                reader.next_block(&block, &eof),
+                "failed to read next block when merging rowsets of tablet " + tablet->full_name());
+        RETURN_NOT_OK_LOG(
+                dst_rowset_writer->add_columns(&block, column_group, is_key, max_rows_per_segment),
+                "failed to write block when merging rowsets of tablet " + tablet->full_name());
+        output_rows += block.rows();
+        block.clear_column_data();
+    }
+
+    if (stats_output != nullptr) {
+        stats_output->output_rows = output_rows;
+        stats_output->merged_rows = reader.merged_rows();
+        stats_output->filtered_rows = reader.filtered_rows();
+    }
+
+    RETURN_NOT_OK_LOG(
+            dst_rowset_writer->flush_columns(),
+            "failed to flush columns when merging rowsets of tablet " + tablet->full_name());
+    return Status::OK();
+}
+
 } // namespace doris
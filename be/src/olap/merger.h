@@ -17,12 +17,19 @@
 
 #pragma once
 
+#include <set>
+#include <vector>
+
 #include "olap/olap_define.h"
 #include "olap/rowset/rowset_writer.h"
 #include "olap/tablet.h"
 
 namespace doris {
 
+namespace vectorized {
+class RowSourcesBuffer;
+} // namespace vectorized
+
 class Merger {
 public:
     struct Statistics {
@@ -42,6 +49,29 @@ public:
     static Status vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
                                  const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
                                  RowsetWriter* dst_rowset_writer, Statistics* stats_output);
+
+    // Merge the rowsets column group by column group, the key columns are merged first and
+    // the value columns are merged in groups by replaying the order of the merged keys, so
+    // that the memory is bounded by the columns of a group rather than all the columns.
+    // The output segments have at most `max_rows_per_segment` rows.
+    static Status vertical_merge_rowsets(
+            TabletSharedPtr tablet, ReaderType reader_type,
+            const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+            RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
+            Statistics* stats_output);
+
+    // Split the columns to the key group, which has the key columns and the sequence column,
+    // and the value groups of `vertical_compaction_num_columns_per_group` columns.
+    static void vertical_split_columns(const TabletSchema& tablet_schema,
+                                       std::vector<std::vector<uint32_t>>* column_groups);
+
+private:
+    static Status _vertical_merge_column_group(
+            TabletSharedPtr tablet, ReaderType reader_type,
+            const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+            RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
+            const std::vector<uint32_t>& column_group, const std::set<uint32_t>& common_columns,
+            bool is_key, vectorized::RowSourcesBuffer* row_sources, Statistics* stats_output);
 };
 
 } // namespace doris
@@ -278,13 +278,23 @@ struct OlapReaderStatistics {
     // and it is also used to record the replaced rows in the Unique key model in the "Reader" class.
     // In segmentv2, if you want to get all filtered rows, you need the sum of "rows_del_filtered" and "rows_conditions_filtered".
     int64_t rows_del_filtered = 0;
+    // the number of rows overwritten in merge-on-write unique key tablet
+    int64_t rows_del_by_bitmap = 0;
     // the number of rows filtered by various column indexes.
     int64_t rows_conditions_filtered = 0;
+    // the number of rows not read yet filtered by the column indexes with the runtime filters
+    // which arrived after the read started
+    int64_t rows_runtime_conditions_filtered = 0;
 
     int64_t index_load_ns = 0;
 
     int64_t total_pages_num = 0;
     int64_t cached_pages_num = 0;
+    // pages not in the page cache but in the compressed page cache
+    int64_t compressed_cached_pages_num = 0;
+    // data pages that were (or were not) read ahead by the prefetch thread pool
+    int64_t prefetch_pages_hit_num = 0;
+    int64_t prefetch_pages_miss_num = 0;
 
     int64_t rows_bitmap_index_filtered = 0;
     int64_t bitmap_index_filter_timer = 0;
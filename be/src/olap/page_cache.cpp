@@ -22,15 +22,18 @@ namespace doris {
 
 StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
-void StoragePageCache::create_global_cache(size_t capacity, int32_t index_cache_percentage) {
+void StoragePageCache::create_global_cache(size_t capacity, int32_t index_cache_percentage,
+                                           size_t compressed_capacity) {
     DCHECK(_s_instance == nullptr);
-    static StoragePageCache instance(capacity, index_cache_percentage);
+    static StoragePageCache instance(capacity, index_cache_percentage, compressed_capacity);
     _s_instance = &instance;
 }
 
-StoragePageCache::StoragePageCache(size_t capacity, int32_t index_cache_percentage)
+StoragePageCache::StoragePageCache(size_t capacity, int32_t index_cache_percentage,
+                                   size_t compressed_capacity)
         : _index_cache_percentage(index_cache_percentage),
-          _mem_tracker(MemTracker::create_tracker(capacity, "StoragePageCache", nullptr,
+          _mem_tracker(MemTracker::create_tracker(capacity + compressed_capacity,
+                                                  "StoragePageCache", nullptr,
                                                   MemTrackerLevel::OVERVIEW)) {
     SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
     if (index_cache_percentage == 0) {
@@ -45,6 +48,10 @@ StoragePageCache::StoragePageCache(size_t capacity, int32_t index_cache_percenta
     } else {
         CHECK(false) << "invalid index page cache percentage";
     }
+    if (compressed_capacity > 0) {
+        _compressed_page_cache = std::unique_ptr<Cache>(
+                new_lru_cache("CompressedPageCache", compressed_capacity));
+    }
 }
 
 bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle,
@@ -72,4 +79,22 @@ void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheH
     *handle = PageCacheHandle(cache, lru_handle);
 }
 
+bool StoragePageCache::lookup_compressed(const CacheKey& key, PageCacheHandle* handle) {
+    auto lru_handle = _compressed_page_cache->lookup(key.encode());
+    if (lru_handle == nullptr) {
+        return false;
+    }
+    *handle = PageCacheHandle(_compressed_page_cache.get(), lru_handle);
+    return true;
+}
+
+void StoragePageCache::insert_compressed(const CacheKey& key, const Slice& data,
+                                         PageCacheHandle* handle) {
+    auto deleter = [](const doris::CacheKey& key, void* value) { delete[](uint8_t*) value; };
+
+    auto lru_handle = _compressed_page_cache->insert(key.encode(), data.data, data.size, deleter,
+                                                     CachePriority::NORMAL);
+    *handle = PageCacheHandle(_compressed_page_cache.get(), lru_handle);
+}
+
 } // namespace doris
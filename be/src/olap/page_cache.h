@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <gtest/gtest_prod.h>
+
 #include <memory>
 #include <string>
 #include <utility>
@@ -32,7 +34,14 @@ class PageCacheHandle;
 
 // Wrapper around Cache, and used for cache page of column data
 // in Segment.
-// TODO(zc): We should add some metric to see cache hit/miss rate.
+//
+// The decompressed pages are cached in the data page cache or the index page cache by the
+// page type. The compressed pages can also be cached in the compressed page cache, which
+// keeps the pages as they are read from the file. As a compressed page takes several times
+// less memory, the pages evicted from the decompressed caches are still found in it, and
+// a hit there saves the read of the file and pays only the decompression.
+//
+// The hit ratio of each cache is exported by the metrics of the LRU cache of its name.
 class StoragePageCache {
 public:
     // The unique key identifying entries in the page cache.
@@ -54,14 +63,17 @@ public:
         }
     };
 
-    // Create global instance of this class
-    static void create_global_cache(size_t capacity, int32_t index_cache_percentage);
+    // Create global instance of this class, the compressed page cache is not allocated if
+    // `compressed_capacity` is 0.
+    static void create_global_cache(size_t capacity, int32_t index_cache_percentage,
+                                    size_t compressed_capacity = 0);
 
     // Return global instance.
     // Client should call create_global_cache before.
     static StoragePageCache* instance() { return _s_instance; }
 
-    StoragePageCache(size_t capacity, int32_t index_cache_percentage);
+    StoragePageCache(size_t capacity, int32_t index_cache_percentage,
+                     size_t compressed_capacity = 0);
 
     // Lookup the given page in the cache.
     //
@@ -88,14 +100,28 @@ public:
         return _get_page_cache(page_type) != nullptr;
     }
 
+    // Lookup the compressed page of the given key, the page read from the file as is.
+    bool lookup_compressed(const CacheKey& key, PageCacheHandle* handle);
+
+    // Insert a compressed page with key into the compressed page cache, the page is owned
+    // by the cache from now on. Given handle will be set to valid reference.
+    void insert_compressed(const CacheKey& key, const Slice& data, PageCacheHandle* handle);
+
+    bool is_compressed_cache_available() { return _compressed_page_cache != nullptr; }
+
 private:
+    FRIEND_TEST(StoragePageCacheTest, compressed_page);
+    FRIEND_TEST(PageIOTest, compressed_page_cache);
+
     StoragePageCache();
     static StoragePageCache* _s_instance;
 
     int32_t _index_cache_percentage = 0;
     std::unique_ptr<Cache> _data_page_cache = nullptr;
     std::unique_ptr<Cache> _index_page_cache = nullptr;
+    std::unique_ptr<Cache> _compressed_page_cache = nullptr;
 
+    // the parent of the trackers of all the caches, including the compressed page cache
     std::shared_ptr<MemTracker> _mem_tracker = nullptr;
 
     Cache* _get_page_cache(segment_v2::PageTypePB page_type) {
@@ -193,6 +193,10 @@ Status TabletReader::_capture_rs_readers(const ReaderParams& read_params,
             // duplicated keys are allowed, no need to merge sort keys in rowset
             need_ordered_result = false;
         }
+        if (_tablet->enable_unique_key_merge_on_write()) {
+            // overwritten rows are filtered out by delete bitmap, no need to merge
+            need_ordered_result = false;
+        }
         if (_aggregation) {
             // compute engine will aggregate rows with the same key,
             // it's ok for rowset to return unordered result
@@ -209,6 +213,7 @@ Status TabletReader::_capture_rs_readers(const ReaderParams& read_params,
     _reader_context.load_bf_all_columns = &_load_bf_all_columns;
     _reader_context.conditions = &_conditions;
     _reader_context.all_conditions = &_all_conditions;
+    _reader_context.runtime_conditions = &_runtime_conditions;
     _reader_context.predicates = &_col_predicates;
     _reader_context.value_predicates = &_value_col_predicates;
     _reader_context.lower_bound_keys = &_keys_param.start_keys;
@@ -219,8 +224,13 @@ Status TabletReader::_capture_rs_readers(const ReaderParams& read_params,
     _reader_context.stats = &_stats;
     _reader_context.runtime_state = read_params.runtime_state;
     _reader_context.use_page_cache = read_params.use_page_cache;
+    _reader_context.dict_code_columns = &read_params.dict_code_columns;
     _reader_context.sequence_id_idx = _sequence_col_idx;
     _reader_context.batch_size = _batch_size;
+    if (_tablet->enable_unique_key_merge_on_write()) {
+        _reader_context.delete_bitmap = &_tablet->delete_bitmap();
+        _reader_context.version = read_params.version;
+    }
 
     *valid_rs_readers = *rs_readers;
 
@@ -444,9 +454,13 @@ void TabletReader::_init_conditions_param(const ReaderParams& read_params) {
     for (const auto& condition : read_params.conditions) {
         ColumnPredicate* predicate = _parse_to_predicate(condition);
         if (predicate != nullptr) {
+            // value column predicates of merge-on-write tablet can be pushed down like
+            // DUP_KEYS, because every key has only one visible row.
             if (_tablet->tablet_schema()
-                        .column(_tablet->field_index(condition.column_name))
-                        .aggregation() != FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE) {
+                                .column(_tablet->field_index(condition.column_name))
+                                .aggregation() !=
+                        FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE &&
+                !_tablet->enable_unique_key_merge_on_write()) {
                 _value_col_predicates.push_back(predicate);
             } else {
                 _col_predicates.push_back(predicate);
@@ -464,6 +478,31 @@ void TabletReader::_init_conditions_param(const ReaderParams& read_params) {
     }
 }
 
+void TabletReader::add_runtime_conditions(const std::vector<TCondition>& conditions) {
+    auto runtime_conditions = std::make_unique<Conditions>();
+    runtime_conditions->set_tablet_schema(&_tablet->tablet_schema());
+    for (const auto& condition : conditions) {
+        int32_t index = _tablet->field_index(condition.column_name);
+        if (index < 0) {
+            continue;
+        }
+        // same as _conditions, value columns can only be pruned when every key has one row
+        if (_tablet->tablet_schema().column(index).aggregation() !=
+                    FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE &&
+            !_tablet->enable_unique_key_merge_on_write()) {
+            continue;
+        }
+        Status status = runtime_conditions->append_condition(condition);
+        if (!status.ok()) {
+            LOG(WARNING) << "fail to append runtime condition on column " << condition.column_name
+                         << ", status=" << status;
+        }
+    }
+    if (!runtime_conditions->empty()) {
+        _runtime_conditions.push_back(std::move(runtime_conditions));
+    }
+}
+
 #define COMPARISON_PREDICATE_CONDITION_VALUE(NAME, PREDICATE)                                      \
     ColumnPredicate* TabletReader::_new_##NAME##_pred(                                             \
             const TabletColumn& column, int index, const std::string& cond, bool opposite) const { \
@@ -97,6 +97,8 @@ public:
         // use only in vec exec engine
         std::vector<uint32_t>* origin_return_columns = nullptr;
         std::unordered_set<uint32_t>* tablet_columns_convert_to_null_set = nullptr;
+        // string columns returned as dictionary codes, see StorageReadOptions
+        std::set<uint32_t> dict_code_columns;
 
         void check_validation() const;
 
@@ -130,12 +132,18 @@ public:
     uint64_t merged_rows() const { return _merged_rows; }
 
     uint64_t filtered_rows() const {
-        return _stats.rows_del_filtered + _stats.rows_conditions_filtered +
-               _stats.rows_vec_del_cond_filtered;
+        return _stats.rows_del_filtered + _stats.rows_del_by_bitmap +
+               _stats.rows_conditions_filtered + _stats.rows_vec_del_cond_filtered +
+               _stats.rows_runtime_conditions_filtered;
     }
 
     void set_batch_size(int batch_size) { _batch_size = batch_size; }
 
+    // Add the conditions of the runtime filters which arrived after the read started.
+    // The segments not finished yet use them to skip the pages not read yet by zone map
+    // and bloom filter index. Must not be called concurrently with reading.
+    void add_runtime_conditions(const std::vector<TCondition>& conditions);
+
     const OlapReaderStatistics& stats() const { return _stats; }
     OlapReaderStatistics* mutable_stats() { return &_stats; }
 
@@ -203,6 +211,9 @@ protected:
     // contains _conditions and condition on value columns, used for push down
     // conditions to base rowset of unique table
     Conditions _all_conditions;
+    // conditions of the runtime filters which arrived after the read started, only on the
+    // columns which can be in _conditions
+    std::vector<std::unique_ptr<Conditions>> _runtime_conditions;
     std::vector<ColumnPredicate*> _col_predicates;
     std::vector<ColumnPredicate*> _value_col_predicates;
     DeleteHandler _delete_handler;
@@ -26,6 +26,7 @@
 #include "olap/row_cursor.h"
 #include "olap/rowset/segment_v2/segment_iterator.h"
 #include "olap/schema.h"
+#include "olap/tablet_meta.h"
 
 #include "vec/core/block.h"
 
@@ -53,6 +54,7 @@ Status BetaRowsetReader::init(RowsetReaderContext* read_context) {
     StorageReadOptions read_options;
     read_options.stats = _stats;
     read_options.conditions = read_context->conditions;
+    read_options.runtime_conditions = read_context->runtime_conditions;
     if (read_context->lower_bound_keys != nullptr) {
         for (int i = 0; i < read_context->lower_bound_keys->size(); ++i) {
             read_options.key_ranges.emplace_back(&read_context->lower_bound_keys->at(i),
@@ -71,10 +73,21 @@ Status BetaRowsetReader::init(RowsetReaderContext* read_context) {
                                               read_context->predicates->begin(),
                                               read_context->predicates->end());
     }
+    if (read_context->delete_bitmap != nullptr) {
+        for (uint32_t seg_id = 0; seg_id < _rowset->num_segments(); ++seg_id) {
+            auto segment_delete_bitmap = read_context->delete_bitmap->get_agg(
+                    {_rowset->rowset_id(), seg_id, read_context->version.second});
+            if (segment_delete_bitmap != nullptr) {
+                read_options.delete_bitmap.emplace(seg_id, std::move(segment_delete_bitmap));
+            }
+        }
+    }
     // if unique table with rowset [0-x] or [0-1] [2-y] [...],
-    // value column predicates can be pushdown on rowset [0-x] or [2-y]
+    // value column predicates can be pushdown on rowset [0-x] or [2-y].
+    // for merge-on-write unique table, they can be pushdown on all rowsets.
     if (_rowset->keys_type() == UNIQUE_KEYS &&
-        (_rowset->start_version() == 0 || _rowset->start_version() == 2)) {
+        (_rowset->start_version() == 0 || _rowset->start_version() == 2 ||
+         read_context->delete_bitmap != nullptr)) {
         if (read_context->value_predicates != nullptr) {
             read_options.column_predicates.insert(read_options.column_predicates.end(),
                                                   read_context->value_predicates->begin(),
@@ -85,6 +98,9 @@ Status BetaRowsetReader::init(RowsetReaderContext* read_context) {
         }
     }
     read_options.use_page_cache = read_context->use_page_cache;
+    if (read_context->dict_code_columns != nullptr) {
+        read_options.dict_code_columns = *read_context->dict_code_columns;
+    }
 
     // load segments
     RETURN_NOT_OK(SegmentLoader::instance()->load_segments(
@@ -114,8 +130,19 @@ Status BetaRowsetReader::init(RowsetReaderContext* read_context) {
     if (config::enable_storage_vectorization && read_context->is_vec) {
         if (read_context->need_ordered_result &&
             _rowset->rowset_meta()->is_segments_overlapping()) {
-            final_iterator =
-                    vectorized::new_merge_iterator(iterators, read_context->sequence_id_idx);
+            // the blocks hold the return columns only, so the sequence column is located
+            // by its position in them rather than by its column id
+            int sequence_loc = -1;
+            if (read_context->sequence_id_idx != -1) {
+                const auto& return_columns = *read_context->return_columns;
+                for (int loc = 0; loc < return_columns.size(); ++loc) {
+                    if (return_columns[loc] == read_context->sequence_id_idx) {
+                        sequence_loc = loc;
+                        break;
+                    }
+                }
+            }
+            final_iterator = vectorized::new_merge_iterator(iterators, sequence_loc);
         } else {
             final_iterator = vectorized::new_union_iterator(iterators);
         }
@@ -17,6 +17,7 @@
 
 #include "olap/rowset/beta_rowset_writer.h"
 
+#include <algorithm>
 #include <ctime> // time
 
 #include "common/config.h"
@@ -50,6 +51,7 @@ BetaRowsetWriter::~BetaRowsetWriter() {
     // TODO(lingbin): Should wrapper exception logic, no need to know file ops directly.
     if (!_already_built) {       // abnormal exit, remove all files generated
         _segment_writer.reset(); // ensure all files are closed
+        _vertical_segment_writers.clear();
         Status st;
         if (_context.path_desc.is_remote()) {
             std::shared_ptr<StorageBackend> storage_backend =
@@ -217,16 +219,43 @@ Status BetaRowsetWriter::flush() {
     return Status::OK();
 }
 
-Status BetaRowsetWriter::flush_single_memtable(MemTable* memtable, int64_t* flush_size) {
-    int64_t current_flush_size = _total_data_size + _total_index_size;
-    // Create segment writer for each memtable, so that
-    // all memtables can be flushed in parallel.
+int32_t BetaRowsetWriter::allocate_segment_ids(int64_t num_rows, int64_t num_bytes,
+                                               int32_t* num_segments) {
+    // The rows of a memtable can only be merged, and they are encoded smaller than they are
+    // in memory, so the memtable does not fill more segments.
+    int64_t max_rows = _context.max_rows_per_segment;
+    *num_segments = std::max<int64_t>({1, (num_rows + max_rows - 1) / max_rows,
+                                       (num_bytes + MAX_SEGMENT_SIZE - 1) / MAX_SEGMENT_SIZE});
+    return _num_segment.fetch_add(*num_segments);
+}
+
+Status BetaRowsetWriter::_create_memtable_segment_writer(
+        int32_t* segment_id, int32_t* num_segments,
+        std::unique_ptr<segment_v2::SegmentWriter>* writer) {
+    if (*segment_id < 0) {
+        return _create_segment_writer(writer);
+    }
+    DCHECK_GT(*num_segments, 0);
+    --(*num_segments);
+    return _create_segment_writer((*segment_id)++, writer);
+}
+
+void BetaRowsetWriter::_release_segment_ids(int32_t segment_id, int32_t num_segments) {
+    std::lock_guard<SpinLock> l(_lock);
+    for (int32_t i = 0; i < num_segments; ++i) {
+        _released_segment_ids.push_back(segment_id + i);
+    }
+}
+
+Status BetaRowsetWriter::flush_single_memtable(MemTable* memtable, int32_t segment_id,
+                                               int32_t num_segments, int64_t* flush_size) {
+    *flush_size = 0;
     std::unique_ptr<segment_v2::SegmentWriter> writer;
 
     MemTable::Iterator it(memtable);
     for (it.seek_to_first(); it.valid(); it.next()) {
         if (PREDICT_FALSE(writer == nullptr)) {
-            RETURN_NOT_OK(_create_segment_writer(&writer));
+            RETURN_NOT_OK(_create_memtable_segment_writer(&segment_id, &num_segments, &writer));
         }
         ContiguousRow dst_row = it.get_current_row();
         auto s = writer->append_row(dst_row);
@@ -234,19 +263,157 @@ Status BetaRowsetWriter::flush_single_memtable(MemTable* memtable, int64_t* flus
             LOG(WARNING) << "failed to append row: " << s.to_string();
             return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
         }
-
-        if (PREDICT_FALSE(writer->estimate_segment_size() >= MAX_SEGMENT_SIZE ||
-                          writer->num_rows_written() >= _context.max_rows_per_segment)) {
-            RETURN_NOT_OK(_flush_segment_writer(&writer));
-        }
         ++_num_rows_written;
+        // the last segment reserved takes the rest of the rows
+        if (PREDICT_FALSE((segment_id < 0 || num_segments > 0) &&
+                          (writer->estimate_segment_size() >= MAX_SEGMENT_SIZE ||
+                           writer->num_rows_written() >= _context.max_rows_per_segment))) {
+            int64_t segment_size = 0;
+            RETURN_NOT_OK(_flush_segment_writer(&writer, &segment_size));
+            *flush_size += segment_size;
+        }
     }
 
     if (writer != nullptr) {
-        RETURN_NOT_OK(_flush_segment_writer(&writer));
+        int64_t segment_size = 0;
+        RETURN_NOT_OK(_flush_segment_writer(&writer, &segment_size));
+        *flush_size += segment_size;
+    }
+    if (segment_id >= 0 && num_segments > 0) {
+        _release_segment_ids(segment_id, num_segments);
+    }
+    return Status::OK();
+}
+
+Status BetaRowsetWriter::flush_single_memtable(const vectorized::Block* block,
+                                               int32_t segment_id, int32_t num_segments,
+                                               int64_t* flush_size) {
+    *flush_size = 0;
+    size_t block_row_num = block->rows();
+    size_t row_avg_size_in_bytes =
+            block_row_num == 0 ? 1 : std::max((size_t)1, block->bytes() / block_row_num);
+    size_t row_offset = 0;
+    while (row_offset < block_row_num) {
+        std::unique_ptr<segment_v2::SegmentWriter> writer;
+        RETURN_NOT_OK(_create_memtable_segment_writer(&segment_id, &num_segments, &writer));
+        size_t input_row_num = block_row_num - row_offset;
+        // the last segment reserved takes the rest of the rows
+        if (segment_id < 0 || num_segments > 0) {
+            auto max_row_add = std::max<int64_t>(1, writer->max_row_to_add(row_avg_size_in_bytes));
+            input_row_num = std::min(input_row_num, size_t(max_row_add));
+        }
+        auto s = writer->append_block(block, row_offset, input_row_num);
+        if (UNLIKELY(!s.ok())) {
+            LOG(WARNING) << "failed to append block: " << s.to_string();
+            return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+        }
+        row_offset += input_row_num;
+        _num_rows_written += input_row_num;
+
+        int64_t segment_size = 0;
+        RETURN_NOT_OK(_flush_segment_writer(&writer, &segment_size));
+        *flush_size += segment_size;
+    }
+    if (segment_id >= 0 && num_segments > 0) {
+        _release_segment_ids(segment_id, num_segments);
+    }
+    return Status::OK();
+}
+
+Status BetaRowsetWriter::add_columns(const vectorized::Block* block,
+                                     const std::vector<uint32_t>& col_ids, bool is_key,
+                                     uint32_t max_rows_per_segment) {
+    size_t num_rows = block->rows();
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    size_t row_offset = 0;
+    if (is_key) {
+        DCHECK(!_key_group_flushed);
+        while (row_offset < num_rows) {
+            if (_vertical_segment_writers.empty() ||
+                _vertical_segment_writers.back()->num_rows_written() >= max_rows_per_segment) {
+                if (!_vertical_segment_writers.empty()) {
+                    RETURN_NOT_OK(_flush_vertical_columns(_vertical_segment_writers.back().get()));
+                }
+                std::unique_ptr<segment_v2::SegmentWriter> writer;
+                RETURN_NOT_OK(_create_segment_writer(_num_segment++, &writer, &col_ids, true));
+                _vertical_segment_writers.push_back(std::move(writer));
+            }
+            auto& writer = _vertical_segment_writers.back();
+            size_t input_row_num =
+                    std::min(num_rows - row_offset,
+                             size_t(max_rows_per_segment - writer->num_rows_written()));
+            auto s = writer->append_block(block, row_offset, input_row_num);
+            if (UNLIKELY(!s.ok())) {
+                LOG(WARNING) << "failed to append block: " << s.to_string();
+                return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+            }
+            row_offset += input_row_num;
+        }
+        _num_rows_written += num_rows;
+        return Status::OK();
+    }
+
+    DCHECK(_key_group_flushed);
+    while (row_offset < num_rows) {
+        if (_cur_writer_idx >= _vertical_segment_writers.size()) {
+            return Status::InternalError(
+                    "the value columns have more rows than the key columns in vertical writing");
+        }
+        auto& writer = _vertical_segment_writers[_cur_writer_idx];
+        if (!_value_group_inited) {
+            auto s = writer->init(col_ids, false);
+            if (!s.ok()) {
+                LOG(WARNING) << "failed to init segment writer: " << s.to_string();
+                return Status::OLAPInternalError(OLAP_ERR_INIT_FAILED);
+            }
+            _value_group_inited = true;
+        }
+        size_t input_row_num = std::min(num_rows - row_offset,
+                                        size_t(writer->row_count() - writer->num_rows_written()));
+        auto s = writer->append_block(block, row_offset, input_row_num);
+        if (UNLIKELY(!s.ok())) {
+            LOG(WARNING) << "failed to append block: " << s.to_string();
+            return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+        }
+        row_offset += input_row_num;
+        // the group of this segment is complete, write it out to release its memory
+        if (writer->num_rows_written() == writer->row_count()) {
+            RETURN_NOT_OK(_flush_vertical_columns(writer.get()));
+            ++_cur_writer_idx;
+            _value_group_inited = false;
+        }
     }
+    return Status::OK();
+}
+
+Status BetaRowsetWriter::flush_columns() {
+    if (!_key_group_flushed) {
+        if (!_vertical_segment_writers.empty()) {
+            RETURN_NOT_OK(_flush_vertical_columns(_vertical_segment_writers.back().get()));
+        }
+        _key_group_flushed = true;
+    } else if (_cur_writer_idx != _vertical_segment_writers.size()) {
+        return Status::InternalError(
+                "the value columns have less rows than the key columns in vertical writing");
+    }
+    _cur_writer_idx = 0;
+    _value_group_inited = false;
+    return Status::OK();
+}
 
-    *flush_size = (_total_data_size + _total_index_size) - current_flush_size;
+Status BetaRowsetWriter::final_flush() {
+    for (auto& writer : _vertical_segment_writers) {
+        uint64_t segment_size;
+        auto s = writer->finalize_footer(&segment_size);
+        if (!s.ok()) {
+            LOG(WARNING) << "failed to finalize segment: " << s.to_string();
+            return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+        }
+        _total_data_size += segment_size;
+    }
+    _vertical_segment_writers.clear();
     return Status::OK();
 }
 
@@ -258,6 +425,13 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     // When building a rowset, we must ensure that the current _segment_writer has been
     // flushed, that is, the current _segment_writer is nullptr
     DCHECK(_segment_writer == nullptr) << "segment must be null when build rowset";
+    if (!_released_segment_ids.empty()) {
+        auto st = _remove_released_segment_ids();
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to remove the unused segment ids, res=" << st;
+            return nullptr;
+        }
+    }
     _rowset_meta->set_num_rows(_num_rows_written);
     _rowset_meta->set_total_disk_size(_total_data_size);
     _rowset_meta->set_data_disk_size(_total_data_size);
@@ -286,10 +460,39 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     return rowset;
 }
 
-Status BetaRowsetWriter::_create_segment_writer(
-        std::unique_ptr<segment_v2::SegmentWriter>* writer) {
+Status BetaRowsetWriter::_remove_released_segment_ids() {
+    if (_context.path_desc.is_remote()) {
+        return Status::NotSupported("can not rename the segments of a remote rowset");
+    }
+    std::sort(_released_segment_ids.begin(), _released_segment_ids.end());
+    auto released = _released_segment_ids.begin();
+    int32_t num_segments = 0;
+    for (int32_t segment_id = 0; segment_id < _num_segment; ++segment_id) {
+        if (released != _released_segment_ids.end() && *released == segment_id) {
+            ++released;
+            continue;
+        }
+        if (segment_id != num_segments) {
+            auto src_path_desc = BetaRowset::segment_file_path(_context.path_desc,
+                                                               _context.rowset_id, segment_id);
+            auto dst_path_desc = BetaRowset::segment_file_path(_context.path_desc,
+                                                               _context.rowset_id, num_segments);
+            RETURN_IF_ERROR(
+                    Env::Default()->rename_file(src_path_desc.filepath, dst_path_desc.filepath));
+        }
+        ++num_segments;
+    }
+    _num_segment = num_segments;
+    _released_segment_ids.clear();
+    return Status::OK();
+}
+
+Status BetaRowsetWriter::_create_segment_writer(int32_t segment_id,
+                                                std::unique_ptr<segment_v2::SegmentWriter>* writer,
+                                                const std::vector<uint32_t>* col_ids,
+                                                bool is_key) {
     auto path_desc =
-            BetaRowset::segment_file_path(_context.path_desc, _context.rowset_id, _num_segment++);
+            BetaRowset::segment_file_path(_context.path_desc, _context.rowset_id, segment_id);
     // TODO(lingbin): should use a more general way to get BlockManager object
     // and tablets with the same type should share one BlockManager object;
     fs::BlockManager* block_mgr = fs::fs_util::block_manager(_context.path_desc);
@@ -305,7 +508,8 @@ Status BetaRowsetWriter::_create_segment_writer(
 
     DCHECK(wblock != nullptr);
     segment_v2::SegmentWriterOptions writer_options;
-    writer->reset(new segment_v2::SegmentWriter(wblock.get(), _num_segment, _context.tablet_schema,
+    writer_options.enable_unique_key_merge_on_write = _context.enable_unique_key_merge_on_write;
+    writer->reset(new segment_v2::SegmentWriter(wblock.get(), segment_id, _context.tablet_schema,
                                                 _context.data_dir, _context.max_rows_per_segment,
                                                 writer_options));
     {
@@ -313,7 +517,8 @@ Status BetaRowsetWriter::_create_segment_writer(
         _wblocks.push_back(std::move(wblock));
     }
 
-    auto s = (*writer)->init(config::push_write_mbytes_per_sec);
+    auto s = col_ids == nullptr ? (*writer)->init(config::push_write_mbytes_per_sec)
+                                : (*writer)->init(*col_ids, is_key);
     if (!s.ok()) {
         LOG(WARNING) << "failed to init segment writer: " << s.to_string();
         writer->reset(nullptr);
@@ -322,7 +527,8 @@ Status BetaRowsetWriter::_create_segment_writer(
     return Status::OK();
 }
 
-Status BetaRowsetWriter::_flush_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer) {
+Status BetaRowsetWriter::_flush_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer,
+                                               int64_t* flush_size) {
     if ((*writer)->num_rows_written() == 0) {
         return Status::OK();
     }
@@ -335,8 +541,22 @@ Status BetaRowsetWriter::_flush_segment_writer(std::unique_ptr<segment_v2::Segme
     }
     _total_data_size += segment_size;
     _total_index_size += index_size;
+    if (flush_size != nullptr) {
+        *flush_size = segment_size + index_size;
+    }
     writer->reset();
     return Status::OK();
 }
 
+Status BetaRowsetWriter::_flush_vertical_columns(segment_v2::SegmentWriter* writer) {
+    uint64_t index_size;
+    Status s = writer->finalize_columns(&index_size);
+    if (!s.ok()) {
+        LOG(WARNING) << "failed to finalize segment columns: " << s.to_string();
+        return Status::OLAPInternalError(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+    }
+    _total_index_size += index_size;
+    return Status::OK();
+}
+
 } // namespace doris
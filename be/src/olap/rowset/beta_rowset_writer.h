@@ -55,8 +55,24 @@ public:
 
     Status flush() override;
 
-    // Return the file size flushed to disk in "flush_size"
-    Status flush_single_memtable(MemTable* memtable, int64_t* flush_size) override;
+    int32_t allocate_segment_ids(int64_t num_rows, int64_t num_bytes,
+                                 int32_t* num_segments) override;
+
+    // Each memtable is flushed to the segments of its own by independent segment writers,
+    // so that the memtables can be flushed in parallel. A segment is full at MAX_SEGMENT_SIZE
+    // or `max_rows_per_segment` rows, then the next segment reserved is written, the last one
+    // takes the rest of the rows. The ids left unused are removed by build().
+    Status flush_single_memtable(MemTable* memtable, int32_t segment_id, int32_t num_segments,
+                                 int64_t* flush_size) override;
+    Status flush_single_memtable(const vectorized::Block* block, int32_t segment_id,
+                                 int32_t num_segments, int64_t* flush_size) override;
+
+    // The segment writers of the vertical compaction are kept until all the column groups
+    // are written, each column group of a segment is finalized once all its rows are added.
+    Status add_columns(const vectorized::Block* block, const std::vector<uint32_t>& col_ids,
+                       bool is_key, uint32_t max_rows_per_segment) override;
+    Status flush_columns() override;
+    Status final_flush() override;
 
     RowsetSharedPtr build() override;
 
@@ -72,9 +88,28 @@ private:
     template <typename RowType>
     Status _add_row(const RowType& row);
 
-    Status _create_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer);
-
-    Status _flush_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer);
+    Status _create_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer) {
+        return _create_segment_writer(_num_segment++, writer);
+    }
+    // Create a writer of the columns `col_ids` if it is not null, or of all columns
+    Status _create_segment_writer(int32_t segment_id,
+                                  std::unique_ptr<segment_v2::SegmentWriter>* writer,
+                                  const std::vector<uint32_t>* col_ids = nullptr,
+                                  bool is_key = true);
+
+    Status _flush_vertical_columns(segment_v2::SegmentWriter* writer);
+
+    // Create the writer of the next segment of a memtable, see flush_single_memtable()
+    Status _create_memtable_segment_writer(int32_t* segment_id, int32_t* num_segments,
+                                           std::unique_ptr<segment_v2::SegmentWriter>* writer);
+    // Give back the ids reserved for a memtable but not written
+    void _release_segment_ids(int32_t segment_id, int32_t num_segments);
+    // Rename the segments after the ids released, so the ids of the rowset are contiguous again
+    Status _remove_released_segment_ids();
+
+    // Return the size of the segment flushed to disk in "flush_size" if it is not null
+    Status _flush_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* writer,
+                                 int64_t* flush_size = nullptr);
 
 private:
     RowsetWriterContext _context;
@@ -85,7 +120,14 @@ private:
     /// Because we want to flush memtables in parallel.
     /// In other processes, such as merger or schema change, we will use this unified writer for data writing.
     std::unique_ptr<segment_v2::SegmentWriter> _segment_writer;
-    mutable SpinLock _lock; // lock to protect _wblocks.
+    // The segment writers of the vertical compaction. A value group is written to the
+    // segment `_cur_writer_idx` until it has as many rows as the key group.
+    std::vector<std::unique_ptr<segment_v2::SegmentWriter>> _vertical_segment_writers;
+    size_t _cur_writer_idx = 0;
+    bool _key_group_flushed = false;
+    bool _value_group_inited = false;
+    mutable SpinLock _lock; // lock to protect _wblocks and _released_segment_ids.
+    std::vector<int32_t> _released_segment_ids;
     // TODO(lingbin): it is better to wrapper in a Batch?
     std::vector<std::unique_ptr<fs::WritableBlock>> _wblocks;
 
@@ -26,6 +26,7 @@ namespace doris {
 
 class RowCursor;
 class Conditions;
+class DeleteBitmap;
 class DeleteHandler;
 class TabletSchema;
 
@@ -47,6 +48,8 @@ struct RowsetReaderContext {
     const Conditions* conditions = nullptr;
     // value column predicate in UNIQUE table
     const Conditions* all_conditions = nullptr;
+    // conditions of the runtime filters which arrived after the read started
+    const std::vector<std::unique_ptr<Conditions>>* runtime_conditions = nullptr;
     // column name -> column predicate
     // adding column_name for predicate to make use of column selectivity
     const std::vector<ColumnPredicate*>* predicates = nullptr;
@@ -60,9 +63,15 @@ struct RowsetReaderContext {
     OlapReaderStatistics* stats = nullptr;
     RuntimeState* runtime_state = nullptr;
     bool use_page_cache = false;
+    // string columns returned as dictionary codes, nullptr if not existed
+    const std::set<uint32_t>* dict_code_columns = nullptr;
     int sequence_id_idx = -1;
     int batch_size = 1024;
     bool is_vec = false;
+    // delete bitmap of merge-on-write tablet, the rows marked by the loads
+    // whose version is not larger than `version.second` are filtered out
+    DeleteBitmap* delete_bitmap = nullptr;
+    Version version {-1, -1};
 };
 
 } // namespace doris
@@ -61,7 +61,40 @@ public:
     // note that `add_row` could also trigger flush when certain conditions are met
     virtual Status flush() = 0;
 
-    virtual Status flush_single_memtable(MemTable* memtable, int64_t* flush_size) {
+    // Reserve the contiguous ids of the segments a memtable of `num_rows` rows and `num_bytes`
+    // bytes in memory may be flushed to, return the first of them and the number of them in
+    // `num_segments`. The ids are reserved in the order the memtables are generated, so they
+    // keep that order however the flushes of the memtables run concurrently.
+    // Return -1 if the writer can not flush memtables concurrently.
+    virtual int32_t allocate_segment_ids(int64_t num_rows, int64_t num_bytes,
+                                         int32_t* num_segments) {
+        return -1;
+    }
+
+    // Flush a memtable to the `num_segments` segments reserved from `segment_id`, or to newly
+    // allocated ones if it is -1. Return the file size flushed to disk in "flush_size".
+    virtual Status flush_single_memtable(MemTable* memtable, int32_t segment_id,
+                                         int32_t num_segments, int64_t* flush_size) {
+        return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
+    }
+    virtual Status flush_single_memtable(const vectorized::Block* block, int32_t segment_id,
+                                         int32_t num_segments, int64_t* flush_size) {
+        return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
+    }
+
+    // Used by the vertical compaction, which writes the rows column group by column group.
+    // The key group is written first and splits the rows to segments of at most
+    // `max_rows_per_segment` rows, then each value group is written to the same segments in
+    // the same order. flush_columns() finishes a column group and final_flush() finishes
+    // the segments after all the column groups are written.
+    virtual Status add_columns(const vectorized::Block* block, const std::vector<uint32_t>& col_ids,
+                               bool is_key, uint32_t max_rows_per_segment) {
+        return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
+    }
+    virtual Status flush_columns() {
+        return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
+    }
+    virtual Status final_flush() {
         return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
     }
 
@@ -71,6 +71,8 @@ struct RowsetWriterContext {
     // ATTN: not support for RowsetConvertor.
     // (because it hard to refactor, and RowsetConvertor will be deprecated in future)
     DataDir* data_dir = nullptr;
+    // build primary key index for each segment, see `TabletMeta::enable_unique_key_merge_on_write`
+    bool enable_unique_key_merge_on_write = false;
 };
 
 } // namespace doris
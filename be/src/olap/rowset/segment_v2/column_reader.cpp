@@ -17,9 +17,14 @@
 
 #include "olap/rowset/segment_v2/column_reader.h"
 
+#include <condition_variable>
+#include <mutex>
+
+#include "common/config.h"
 #include "common/logging.h"
 #include "gutil/strings/substitute.h"                // for Substitute
 #include "olap/column_block.h"                       // for ColumnBlockView
+#include "olap/olap_common.h"
 #include "olap/rowset/segment_v2/binary_dict_page.h" // for BinaryDictPageDecoder
 #include "olap/rowset/segment_v2/bloom_filter_index_reader.h"
 #include "olap/rowset/segment_v2/encoding_info.h" // for EncodingInfo
@@ -27,9 +32,11 @@
 #include "olap/rowset/segment_v2/page_io.h"
 #include "olap/rowset/segment_v2/page_pointer.h" // for PagePointer
 #include "olap/types.h"                          // for TypeInfo
+#include "runtime/exec_env.h"
 #include "util/block_compression.h"
 #include "util/coding.h"       // for get_varint32
 #include "util/rle_encoding.h" // for RleDecoder
+#include "util/threadpool.h"
 #include "vec/core/types.h"
 #include "vec/runtime/vdatetime_value.h" //for VecDateTime
 
@@ -159,6 +166,25 @@ Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const Pag
     return PageIO::read_and_decompress_page(opts, handle, page_body, footer);
 }
 
+Status ColumnReader::read_pages(const ColumnIteratorOptions& iter_opts,
+                                const std::vector<PagePointer>& pps,
+                                std::vector<PageHandle>* handles, std::vector<Slice>* page_bodies,
+                                std::vector<PageFooterPB>* footers) {
+    iter_opts.sanity_check();
+    std::vector<PageReadOptions> opts(pps.size());
+    for (size_t i = 0; i < pps.size(); ++i) {
+        opts[i].rblock = iter_opts.rblock;
+        opts[i].page_pointer = pps[i];
+        opts[i].codec = _compress_codec;
+        opts[i].stats = iter_opts.stats;
+        opts[i].verify_checksum = _opts.verify_checksum;
+        opts[i].use_page_cache = iter_opts.use_page_cache;
+        opts[i].kept_in_memory = _opts.kept_in_memory;
+        opts[i].type = iter_opts.type;
+    }
+    return PageIO::read_and_decompress_pages(opts, handles, page_bodies, footers);
+}
+
 Status ColumnReader::get_row_ranges_by_zone_map(CondColumn* cond_column,
                                                 CondColumn* delete_condition,
                                                 RowRanges* row_ranges) {
@@ -463,9 +489,52 @@ Status ArrayFileColumnIterator::next_batch(size_t* n, ColumnBlockView* dst, bool
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// A data page read on the segment prefetch thread pool.
+struct FileColumnIterator::PrefetchedPage {
+    int32_t page_index = -1;
+    PageHandle handle;
+    Slice page_body;
+    PageFooterPB footer;
+    // OlapReaderStatistics is not thread safe, the statistics of the read are
+    // kept here and merged into the iterator's statistics by the reading thread.
+    OlapReaderStatistics stats;
+    Status status;
+
+    std::mutex lock;
+    std::condition_variable cv;
+    bool done = false;
+
+    void finish(const Status& st) {
+        std::lock_guard<std::mutex> l(lock);
+        status = st;
+        done = true;
+        cv.notify_all();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> l(lock);
+        cv.wait(l, [this] { return done; });
+    }
+
+    void merge_stats_to(OlapReaderStatistics* to) const {
+        to->io_ns += stats.io_ns;
+        to->compressed_bytes_read += stats.compressed_bytes_read;
+        to->decompress_ns += stats.decompress_ns;
+        to->uncompressed_bytes_read += stats.uncompressed_bytes_read;
+        to->total_pages_num += stats.total_pages_num;
+        to->cached_pages_num += stats.cached_pages_num;
+        to->compressed_cached_pages_num += stats.compressed_cached_pages_num;
+    }
+};
+
 FileColumnIterator::FileColumnIterator(ColumnReader* reader) : _reader(reader) {}
 
-FileColumnIterator::~FileColumnIterator() {}
+FileColumnIterator::~FileColumnIterator() {
+    // the pending reads refer to the file of this column
+    for (auto& page : _prefetched_pages) {
+        page->wait();
+    }
+}
 
 Status FileColumnIterator::seek_to_first() {
     RETURN_IF_ERROR(_reader->seek_to_first(&_page_iter));
@@ -652,8 +721,14 @@ Status FileColumnIterator::_read_data_page(const OrdinalPageIndexIterator& iter)
     PageHandle handle;
     Slice page_body;
     PageFooterPB footer;
-    _opts.type = DATA_PAGE;
-    RETURN_IF_ERROR(_reader->read_page(_opts, iter.page(), &handle, &page_body, &footer));
+    bool prefetched = false;
+    RETURN_IF_ERROR(
+            _get_prefetched_page(iter.page_index(), &handle, &page_body, &footer, &prefetched));
+    if (!prefetched) {
+        _opts.type = DATA_PAGE;
+        RETURN_IF_ERROR(_reader->read_page(_opts, iter.page(), &handle, &page_body, &footer));
+    }
+    _prefetch_pages(iter);
     // parse data page
     RETURN_IF_ERROR(ParsedPage::create(std::move(handle), page_body, footer.data_page_footer(),
                                        _reader->encoding_info(), iter.page(), iter.page_index(),
@@ -690,6 +765,145 @@ Status FileColumnIterator::_read_data_page(const OrdinalPageIndexIterator& iter)
     return Status::OK();
 }
 
+Status FileColumnIterator::_get_prefetched_page(int32_t page_index, PageHandle* handle,
+                                                Slice* page_body, PageFooterPB* footer,
+                                                bool* found) {
+    *found = false;
+    if (_prefetch_row_ranges == nullptr) {
+        return Status::OK();
+    }
+    // drop the pages skipped by seek
+    while (!_prefetched_pages.empty() && _prefetched_pages.front()->page_index < page_index) {
+        auto& page = _prefetched_pages.front();
+        page->wait();
+        page->merge_stats_to(_opts.stats);
+        _prefetched_pages.pop_front();
+    }
+    if (_prefetched_pages.empty() || _prefetched_pages.front()->page_index != page_index) {
+        _opts.stats->prefetch_pages_miss_num++;
+        return Status::OK();
+    }
+
+    auto page = std::move(_prefetched_pages.front());
+    _prefetched_pages.pop_front();
+    page->wait();
+    page->merge_stats_to(_opts.stats);
+    RETURN_IF_ERROR(page->status);
+    *handle = std::move(page->handle);
+    *page_body = page->page_body;
+    *footer = std::move(page->footer);
+    _opts.stats->prefetch_pages_hit_num++;
+    *found = true;
+    return Status::OK();
+}
+
+void FileColumnIterator::_prefetch_pages(const OrdinalPageIndexIterator& iter) {
+    int32_t prefetch_page_num = config::segment_prefetch_page_num;
+    ThreadPool* pool = ExecEnv::GetInstance()->segment_prefetch_thread_pool();
+    if (_prefetch_row_ranges == nullptr || prefetch_page_num <= 0 || pool == nullptr) {
+        return;
+    }
+
+    OrdinalPageIndexIterator next = iter;
+    if (_prefetched_pages.empty() || _prefetch_row_ranges_changed) {
+        // restart from the range containing the current page, the pages already prefetched
+        // but no longer in the ranges are dropped when the reads skip them
+        _prefetch_row_ranges_changed = false;
+        size_t lo = 0;
+        size_t hi = _prefetch_row_ranges->range_size();
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (_prefetch_row_ranges->get_range_to(mid) <= iter.first_ordinal()) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        _prefetch_range_idx = lo;
+    }
+    int32_t last_page_index = _prefetched_pages.empty() ? iter.page_index()
+                                                         : _prefetched_pages.back()->page_index;
+    while (next.valid() && next.page_index() <= last_page_index) {
+        next.next();
+    }
+
+    // if the reads of the block are issued at once, the pages are read by a single task,
+    // which is issued when half of the prefetched pages are consumed to read more at once
+    bool read_in_batch = _opts.rblock->is_batch_read_supported();
+    if (read_in_batch && _prefetched_pages.size() > static_cast<size_t>(prefetch_page_num / 2)) {
+        return;
+    }
+    std::vector<std::shared_ptr<PrefetchedPage>> batch;
+    std::vector<PagePointer> batch_page_pointers;
+    while (next.valid() && _prefetched_pages.size() < static_cast<size_t>(prefetch_page_num)) {
+        while (_prefetch_range_idx < _prefetch_row_ranges->range_size() &&
+               _prefetch_row_ranges->get_range_to(_prefetch_range_idx) <= next.first_ordinal()) {
+            _prefetch_range_idx++;
+        }
+        if (_prefetch_range_idx == _prefetch_row_ranges->range_size()) {
+            // no more rows to read
+            break;
+        }
+        if (_prefetch_row_ranges->get_range_from(_prefetch_range_idx) > next.last_ordinal()) {
+            // no row in this page will be read
+            next.next();
+            continue;
+        }
+
+        auto page = std::make_shared<PrefetchedPage>();
+        page->page_index = next.page_index();
+        if (read_in_batch) {
+            batch.push_back(page);
+            batch_page_pointers.push_back(next.page());
+            _prefetched_pages.push_back(std::move(page));
+            next.next();
+            continue;
+        }
+        ColumnIteratorOptions opts = _opts;
+        opts.stats = &page->stats;
+        opts.type = DATA_PAGE;
+        PagePointer page_pointer = next.page();
+        ColumnReader* reader = _reader;
+        Status st = pool->submit_func([page, opts, page_pointer, reader]() {
+            page->finish(reader->read_page(opts, page_pointer, &page->handle, &page->page_body,
+                                           &page->footer));
+        });
+        if (!st.ok()) {
+            // the pool is busy, the page will be read when it is needed
+            break;
+        }
+        _prefetched_pages.push_back(std::move(page));
+        next.next();
+    }
+
+    if (!batch.empty()) {
+        ColumnIteratorOptions opts = _opts;
+        opts.stats = &batch[0]->stats;
+        opts.type = DATA_PAGE;
+        ColumnReader* reader = _reader;
+        Status st = pool->submit_func([batch, batch_page_pointers, opts, reader]() {
+            std::vector<PageHandle> handles;
+            std::vector<Slice> page_bodies;
+            std::vector<PageFooterPB> footers;
+            Status st = reader->read_pages(opts, batch_page_pointers, &handles, &page_bodies,
+                                           &footers);
+            for (size_t i = 0; i < batch.size(); ++i) {
+                if (st.ok()) {
+                    batch[i]->handle = std::move(handles[i]);
+                    batch[i]->page_body = page_bodies[i];
+                    batch[i]->footer = std::move(footers[i]);
+                }
+                batch[i]->finish(st);
+            }
+        });
+        if (!st.ok()) {
+            // the pool is busy, the pages will be read when they are needed
+            _prefetched_pages.erase(_prefetched_pages.end() - batch.size(),
+                                    _prefetched_pages.end());
+        }
+    }
+}
+
 Status FileColumnIterator::get_row_ranges_by_zone_map(CondColumn* cond_column,
                                                       CondColumn* delete_condition,
                                                       RowRanges* row_ranges) {
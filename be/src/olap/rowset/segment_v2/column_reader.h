@@ -19,7 +19,8 @@
 
 #include <cstddef> // for size_t
 #include <cstdint> // for uint32_t
-#include <memory>  // for unique_ptr
+#include <deque>
+#include <memory> // for unique_ptr
 
 #include "common/logging.h"
 #include "common/status.h"                              // for Status
@@ -105,6 +106,11 @@ public:
     Status read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp,
                      PageHandle* handle, Slice* page_body, PageFooterPB* footer);
 
+    // read the pages from file by one batch read, see PageIO::read_and_decompress_pages
+    Status read_pages(const ColumnIteratorOptions& iter_opts, const std::vector<PagePointer>& pps,
+                      std::vector<PageHandle>* handles, std::vector<Slice>* page_bodies,
+                      std::vector<PageFooterPB>* footers);
+
     bool is_nullable() const { return _meta.is_nullable(); }
 
     const EncodingInfo* encoding_info() const { return _encoding_info; }
@@ -242,6 +248,11 @@ public:
         return Status::OK();
     }
 
+    // Set the rows that will be read by this iterator, so that the data pages
+    // containing them can be read ahead. Only pages overlapping these ranges are
+    // prefetched. Called again when some of the rows are filtered out while reading.
+    virtual void set_prefetch_row_ranges(std::shared_ptr<RowRanges> row_ranges) {}
+
 protected:
     ColumnIteratorOptions _opts;
 };
@@ -277,10 +288,23 @@ public:
 
     bool is_nullable() { return _reader->is_nullable(); }
 
+    void set_prefetch_row_ranges(std::shared_ptr<RowRanges> row_ranges) override {
+        _prefetch_row_ranges = std::move(row_ranges);
+        _prefetch_row_ranges_changed = true;
+    }
+
 private:
+    struct PrefetchedPage;
+
     void _seek_to_pos_in_page(ParsedPage* page, ordinal_t offset_in_page);
     Status _load_next_page(bool* eos);
     Status _read_data_page(const OrdinalPageIndexIterator& iter);
+    // issue reads for the data pages after `iter` which overlap _prefetch_row_ranges
+    void _prefetch_pages(const OrdinalPageIndexIterator& iter);
+    // take the page at `page_index` out of the prefetch queue, `*found` is false
+    // if it was not prefetched
+    Status _get_prefetched_page(int32_t page_index, PageHandle* handle, Slice* page_body,
+                                PageFooterPB* footer, bool* found);
 
 private:
     ColumnReader* _reader;
@@ -304,6 +328,15 @@ private:
     ordinal_t _current_ordinal = 0;
 
     std::unique_ptr<StringRef[]> _dict_word_info;
+
+    // rows to read, nullptr if page prefetch is disabled
+    std::shared_ptr<RowRanges> _prefetch_row_ranges;
+    // index of the first range in _prefetch_row_ranges not before the last prefetched page
+    size_t _prefetch_range_idx = 0;
+    // _prefetch_range_idx is an index of the ranges set before
+    bool _prefetch_row_ranges_changed = false;
+    // pages being read ahead, in ascending page index order
+    std::deque<std::shared_ptr<PrefetchedPage>> _prefetched_pages;
 };
 
 class EmptyFileColumnIterator final : public ColumnIterator {
@@ -114,6 +114,93 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     opts.sanity_check();
     opts.stats->total_pages_num++;
 
+    bool found = false;
+    RETURN_IF_ERROR(_lookup_page_cache(opts, handle, body, footer, &found));
+    if (found) {
+        return Status::OK();
+    }
+
+    // every page contains 4 bytes footer length and 4 bytes checksum
+    const uint32_t page_size = opts.page_pointer.size;
+    if (page_size < 8) {
+        return Status::Corruption(strings::Substitute("Bad page: too small size ($0)", page_size));
+    }
+
+    // hold compressed page at first, reset to decompressed page later
+    std::unique_ptr<char[]> page;
+    _lookup_compressed_page_cache(opts, &page, &found);
+    if (found) {
+        return _decode_page(opts, std::move(page), false, handle, body, footer);
+    }
+    page.reset(new char[page_size]);
+    Slice page_slice(page.get(), page_size);
+    {
+        SCOPED_RAW_TIMER(&opts.stats->io_ns);
+        RETURN_IF_ERROR(opts.rblock->read(opts.page_pointer.offset, page_slice));
+        opts.stats->compressed_bytes_read += page_size;
+    }
+    return _decode_page(opts, std::move(page), true, handle, body, footer);
+}
+
+Status PageIO::read_and_decompress_pages(const std::vector<PageReadOptions>& opts,
+                                         std::vector<PageHandle>* handles,
+                                         std::vector<Slice>* bodies,
+                                         std::vector<PageFooterPB>* footers) {
+    handles->resize(opts.size());
+    bodies->resize(opts.size());
+    footers->resize(opts.size());
+
+    // the index in `opts' of each page to read from the block
+    std::vector<size_t> page_indexes;
+    std::vector<std::unique_ptr<char[]>> pages;
+    std::vector<ReadRange> ranges;
+    for (size_t i = 0; i < opts.size(); ++i) {
+        opts[i].sanity_check();
+        DCHECK_EQ(opts[i].rblock, opts[0].rblock);
+        opts[i].stats->total_pages_num++;
+
+        bool found = false;
+        RETURN_IF_ERROR(_lookup_page_cache(opts[i], &(*handles)[i], &(*bodies)[i],
+                                           &(*footers)[i], &found));
+        if (found) {
+            continue;
+        }
+        const uint32_t page_size = opts[i].page_pointer.size;
+        if (page_size < 8) {
+            return Status::Corruption(
+                    strings::Substitute("Bad page: too small size ($0)", page_size));
+        }
+        std::unique_ptr<char[]> page;
+        _lookup_compressed_page_cache(opts[i], &page, &found);
+        if (found) {
+            RETURN_IF_ERROR(_decode_page(opts[i], std::move(page), false, &(*handles)[i],
+                                         &(*bodies)[i], &(*footers)[i]));
+            continue;
+        }
+        pages.emplace_back(new char[page_size]);
+        ranges.push_back({opts[i].page_pointer.offset, Slice(pages.back().get(), page_size)});
+        page_indexes.push_back(i);
+    }
+    if (ranges.empty()) {
+        return Status::OK();
+    }
+
+    {
+        SCOPED_RAW_TIMER(&opts[0].stats->io_ns);
+        RETURN_IF_ERROR(opts[0].rblock->read_batch(ranges.data(), ranges.size()));
+    }
+    for (size_t j = 0; j < page_indexes.size(); ++j) {
+        size_t i = page_indexes[j];
+        opts[i].stats->compressed_bytes_read += ranges[j].data.size;
+        RETURN_IF_ERROR(_decode_page(opts[i], std::move(pages[j]), true, &(*handles)[i],
+                                     &(*bodies)[i], &(*footers)[i]));
+    }
+    return Status::OK();
+}
+
+Status PageIO::_lookup_page_cache(const PageReadOptions& opts, PageHandle* handle, Slice* body,
+                                  PageFooterPB* footer, bool* found) {
+    *found = false;
     auto cache = StoragePageCache::instance();
     PageCacheHandle cache_handle;
     StoragePageCache::CacheKey cache_key(opts.rblock->path_desc().filepath,
@@ -131,24 +218,36 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
             return Status::Corruption("Bad page: invalid footer");
         }
         *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
-        return Status::OK();
+        *found = true;
     }
+    return Status::OK();
+}
 
-    // every page contains 4 bytes footer length and 4 bytes checksum
-    const uint32_t page_size = opts.page_pointer.size;
-    if (page_size < 8) {
-        return Status::Corruption(strings::Substitute("Bad page: too small size ($0)", page_size));
+void PageIO::_lookup_compressed_page_cache(const PageReadOptions& opts,
+                                           std::unique_ptr<char[]>* page, bool* found) {
+    *found = false;
+    auto cache = StoragePageCache::instance();
+    if (!opts.use_page_cache || !cache->is_compressed_cache_available()) {
+        return;
     }
-
-    // hold compressed page at first, reset to decompressed page later
-    std::unique_ptr<char[]> page(new char[page_size]);
-    Slice page_slice(page.get(), page_size);
-    {
-        SCOPED_RAW_TIMER(&opts.stats->io_ns);
-        RETURN_IF_ERROR(opts.rblock->read(opts.page_pointer.offset, page_slice));
-        opts.stats->compressed_bytes_read += page_size;
+    PageCacheHandle cache_handle;
+    StoragePageCache::CacheKey cache_key(opts.rblock->path_desc().filepath,
+                                         opts.page_pointer.offset);
+    if (cache->lookup_compressed(cache_key, &cache_handle)) {
+        // copy the page out of the cache, since the decoding takes the ownership of it
+        Slice cached = cache_handle.data();
+        DCHECK_EQ(cached.size, opts.page_pointer.size);
+        page->reset(new char[cached.size]);
+        memcpy(page->get(), cached.data, cached.size);
+        opts.stats->compressed_cached_pages_num++;
+        *found = true;
     }
+}
 
+Status PageIO::_decode_page(const PageReadOptions& opts, std::unique_ptr<char[]> page,
+                            bool from_block, PageHandle* handle, Slice* body,
+                            PageFooterPB* footer) {
+    Slice page_slice(page.get(), opts.page_pointer.size);
     if (opts.verify_checksum) {
         uint32_t expect = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
         uint32_t actual = crc32c::Value(page_slice.data, page_slice.size - 4);
@@ -187,6 +286,16 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         // append footer and footer size
         memcpy(decompressed_body.data + decompressed_body.size, page_slice.data + body_size,
                footer_size + 4);
+        auto cache = StoragePageCache::instance();
+        if (from_block && opts.use_page_cache && cache->is_compressed_cache_available()) {
+            // keep the compressed page in the compressed page cache, where it is found after
+            // the decompressed page is evicted from the page cache
+            PageCacheHandle cache_handle;
+            StoragePageCache::CacheKey cache_key(opts.rblock->path_desc().filepath,
+                                                 opts.page_pointer.offset);
+            cache->insert_compressed(cache_key, Slice(page.release(), opts.page_pointer.size),
+                                     &cache_handle);
+        }
         // free memory of compressed page
         page = std::move(decompressed_page);
         page_slice = Slice(page.get(), footer->uncompressed_size() + footer_size + 4);
@@ -196,8 +305,12 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     }
 
     *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
+    auto cache = StoragePageCache::instance();
     if (opts.use_page_cache && cache->is_cache_available(opts.type)) {
         // insert this page into cache and return the cache handle
+        PageCacheHandle cache_handle;
+        StoragePageCache::CacheKey cache_key(opts.rblock->path_desc().filepath,
+                                             opts.page_pointer.offset);
         cache->insert(cache_key, page_slice, &cache_handle, opts.type, opts.kept_in_memory);
         *handle = PageHandle(std::move(cache_handle));
     } else {
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "common/logging.h"
@@ -101,13 +102,39 @@ public:
         return write_page(wblock, {compressed_body.slice()}, footer, result);
     }
 
-    // Read and parse a page according to `opts'.
+    // Read and parse a page according to `opts'. The page is looked up in the page cache,
+    // then in the compressed page cache, and is read from the block only if it is in neither.
     // On success
     //     `handle' holds the memory of page data,
     //     `body' points to page body,
     //     `footer' stores the page footer.
     static Status read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle,
                                            Slice* body, PageFooterPB* footer);
+
+    // Read and parse the pages of `opts', which are all in the same block, like
+    // read_and_decompress_page(). The pages missing in the page caches are read by one
+    // ReadableBlock::read_batch(), whose IO time is counted in the stats of the first page.
+    static Status read_and_decompress_pages(const std::vector<PageReadOptions>& opts,
+                                            std::vector<PageHandle>* handles,
+                                            std::vector<Slice>* bodies,
+                                            std::vector<PageFooterPB>* footers);
+
+private:
+    // Look up the page of `opts' in the page cache, `found' is false if it is not cached.
+    static Status _lookup_page_cache(const PageReadOptions& opts, PageHandle* handle,
+                                     Slice* body, PageFooterPB* footer, bool* found);
+
+    // Look up the compressed page of `opts' in the compressed page cache, `page' is a copy
+    // of the cached page if `found' is true.
+    static void _lookup_compressed_page_cache(const PageReadOptions& opts,
+                                              std::unique_ptr<char[]>* page, bool* found);
+
+    // Verify and decompress the page read from the block, and insert it into the page cache.
+    // The compressed page is inserted into the compressed page cache if `from_block' is true,
+    // that is it is not taken from the compressed page cache.
+    static Status _decode_page(const PageReadOptions& opts, std::unique_ptr<char[]> page,
+                               bool from_block, PageHandle* handle, Slice* body,
+                               PageFooterPB* footer);
 };
 
 } // namespace segment_v2
@@ -0,0 +1,95 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/primary_key_index.h"
+
+#include "olap/column_block.h"
+#include "olap/rowset/segment_v2/encoding_info.h"
+#include "olap/types.h"
+
+namespace doris {
+namespace segment_v2 {
+
+Status PrimaryKeyIndexBuilder::init() {
+    const auto* type_info = get_scalar_type_info<OLAP_FIELD_TYPE_VARCHAR>();
+    IndexedColumnWriterOptions options;
+    options.write_ordinal_index = true;
+    options.write_value_index = true;
+    options.encoding = EncodingInfo::get_default_encoding(type_info, true);
+    options.compression = LZ4F;
+    _index_writer.reset(new IndexedColumnWriter(options, type_info, _wblock));
+    return _index_writer->init();
+}
+
+Status PrimaryKeyIndexBuilder::add_item(const Slice& key) {
+    DCHECK(_num_rows == 0 || Slice(_last_key).compare(key) < 0)
+            << "primary keys must be unique and added in ascending order";
+    RETURN_IF_ERROR(_index_writer->add(&key));
+    if (UNLIKELY(_num_rows == 0)) {
+        _min_key.assign(key.data, key.size);
+    }
+    _last_key.assign(key.data, key.size);
+    _size += key.size;
+    ++_num_rows;
+    return Status::OK();
+}
+
+Status PrimaryKeyIndexBuilder::finalize(PrimaryKeyIndexMetaPB* meta) {
+    meta->set_min_key(_min_key);
+    meta->set_max_key(_last_key);
+    return _index_writer->finish(meta->mutable_primary_key_index());
+}
+
+Status PrimaryKeyIndexReader::load(const FilePathDesc& path_desc,
+                                   const PrimaryKeyIndexMetaPB& meta) {
+    _index_reader.reset(new IndexedColumnReader(path_desc, meta.primary_key_index()));
+    RETURN_IF_ERROR(_index_reader->load(true, false));
+    _min_key = meta.min_key();
+    _max_key = meta.max_key();
+    return Status::OK();
+}
+
+Status PrimaryKeyIndexReader::lookup_row_key(IndexedColumnIterator* iter, const Slice& key,
+                                             rowid_t* row_id) const {
+    if (key.compare(min_key()) < 0 || key.compare(max_key()) > 0) {
+        return Status::NotFound("key is out of the range of this segment");
+    }
+    bool exact_match = false;
+    RETURN_IF_ERROR(iter->seek_at_or_after(&key, &exact_match));
+    if (!exact_match) {
+        return Status::NotFound("key does not exist in this segment");
+    }
+    *row_id = iter->get_current_ordinal();
+    return Status::OK();
+}
+
+Status PrimaryKeyIndexReader::read_keys(IndexedColumnIterator* iter, ordinal_t ordinal, size_t* n,
+                                        Slice* keys, MemPool* pool) const {
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    RETURN_IF_ERROR(ColumnVectorBatch::create(*n, false, _index_reader->type_info(), nullptr, &cvb));
+    ColumnBlock block(cvb.get(), pool);
+    ColumnBlockView column_block_view(&block);
+
+    RETURN_IF_ERROR(iter->seek_to_ordinal(ordinal));
+    RETURN_IF_ERROR(iter->next_batch(n, &column_block_view));
+    const auto* data = reinterpret_cast<const Slice*>(block.data());
+    std::copy(data, data + *n, keys);
+    return Status::OK();
+}
+
+} // namespace segment_v2
+} // namespace doris
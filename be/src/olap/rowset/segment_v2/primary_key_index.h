@@ -0,0 +1,108 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "common/status.h"
+#include "env/env.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "gutil/macros.h"
+#include "olap/rowset/segment_v2/common.h"
+#include "olap/rowset/segment_v2/indexed_column_reader.h"
+#include "olap/rowset/segment_v2/indexed_column_writer.h"
+#include "util/slice.h"
+
+namespace doris {
+
+class TypeInfo;
+
+namespace fs {
+class WritableBlock;
+}
+
+namespace segment_v2 {
+
+// Build the primary key index of a segment in a merge-on-write unique key table.
+// The index is an IndexedColumn of the full encoded keys of all rows, with both
+// an ordinal index and a value index, so that a key can be mapped to its row id
+// and the keys can be scanned in row id order.
+//
+// Keys must be added in ascending order and must be unique inside a segment.
+class PrimaryKeyIndexBuilder {
+public:
+    explicit PrimaryKeyIndexBuilder(fs::WritableBlock* wblock) : _wblock(wblock) {}
+
+    Status init();
+
+    Status add_item(const Slice& key);
+
+    uint32_t num_rows() const { return _num_rows; }
+
+    // approximate size of the keys added so far
+    uint64_t size() const { return _size; }
+
+    Status finalize(PrimaryKeyIndexMetaPB* meta);
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(PrimaryKeyIndexBuilder);
+
+    fs::WritableBlock* _wblock;
+    uint32_t _num_rows = 0;
+    uint64_t _size = 0;
+    std::string _min_key;
+    std::string _last_key;
+    std::unique_ptr<IndexedColumnWriter> _index_writer;
+};
+
+class PrimaryKeyIndexReader {
+public:
+    PrimaryKeyIndexReader() = default;
+
+    Status load(const FilePathDesc& path_desc, const PrimaryKeyIndexMetaPB& meta);
+
+    // The returned iterator holds an open file handle, reuse it for many lookups.
+    std::unique_ptr<IndexedColumnIterator> new_iterator() const {
+        DCHECK(_index_reader != nullptr);
+        return std::make_unique<IndexedColumnIterator>(_index_reader.get());
+    }
+
+    // Find the row `key` belongs to. Return NotFound if no row has this key.
+    Status lookup_row_key(IndexedColumnIterator* iter, const Slice& key, rowid_t* row_id) const;
+
+    // Read keys [`ordinal`, `ordinal` + *n) into `keys`, string data is allocated from `pool`.
+    // *n is set to the number of keys actually read.
+    Status read_keys(IndexedColumnIterator* iter, ordinal_t ordinal, size_t* n, Slice* keys,
+                     MemPool* pool) const;
+
+    int64_t num_rows() const { return _index_reader->num_values(); }
+
+    Slice min_key() const { return Slice(_min_key); }
+    Slice max_key() const { return Slice(_max_key); }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(PrimaryKeyIndexReader);
+
+    std::unique_ptr<IndexedColumnReader> _index_reader;
+    std::string _min_key;
+    std::string _max_key;
+};
+
+} // namespace segment_v2
+} // namespace doris
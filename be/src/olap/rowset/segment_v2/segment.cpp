@@ -25,6 +25,7 @@
 #include "olap/rowset/segment_v2/column_reader.h" // ColumnReader
 #include "olap/rowset/segment_v2/empty_segment_iterator.h"
 #include "olap/rowset/segment_v2/page_io.h"
+#include "olap/rowset/segment_v2/primary_key_index.h"
 #include "olap/rowset/segment_v2/segment_iterator.h"
 #include "olap/rowset/segment_v2/segment_writer.h" // k_segment_magic_length
 #include "olap/storage_engine.h"
@@ -112,6 +113,7 @@ Status Segment::_parse_footer() {
     }
 
     uint8_t fixed_buf[12];
+    RETURN_IF_ERROR(rblock->warm_up_index(file_size - 12, 12));
     RETURN_IF_ERROR(rblock->read(file_size - 12, Slice(fixed_buf, 12)));
 
     // validate magic number
@@ -131,6 +133,7 @@ Status Segment::_parse_footer() {
 
     std::string footer_buf;
     footer_buf.resize(footer_length);
+    RETURN_IF_ERROR(rblock->warm_up_index(file_size - 12 - footer_length, footer_length));
     RETURN_IF_ERROR(rblock->read(file_size - 12 - footer_length, footer_buf));
 
     // validate footer PB's checksum
@@ -147,6 +150,32 @@ Status Segment::_parse_footer() {
         return Status::Corruption(strings::Substitute(
                 "Bad segment file $0: failed to parse SegmentFooterPB", _path_desc.filepath));
     }
+    // the indexes will be read anyway, so the segment can still be opened if they fail
+    // to be read ahead
+    WARN_IF_ERROR(_warm_up_index(rblock.get()),
+                  "failed to warm up the indexes of " + _path_desc.filepath);
+    return Status::OK();
+}
+
+Status Segment::_warm_up_index(fs::ReadableBlock* rblock) {
+    auto warm_up = [rblock](const PagePointerPB& pp) {
+        return rblock->warm_up_index(pp.offset(), pp.size());
+    };
+    if (_footer.has_short_key_index_page()) {
+        RETURN_IF_ERROR(warm_up(_footer.short_key_index_page()));
+    }
+    for (const auto& column : _footer.columns()) {
+        for (const auto& index : column.indexes()) {
+            if (index.has_ordinal_index() &&
+                !index.ordinal_index().root_page().is_root_data_page()) {
+                RETURN_IF_ERROR(warm_up(index.ordinal_index().root_page().root_page()));
+            }
+            if (index.has_zone_map_index()) {
+                RETURN_IF_ERROR(warm_up(
+                        index.zone_map_index().page_zone_maps().ordinal_index_meta().root_page()));
+            }
+        }
+    }
     return Status::OK();
 }
 
@@ -177,6 +206,22 @@ Status Segment::_load_index() {
     });
 }
 
+Status Segment::load_primary_key_index() {
+    return _load_pk_index_once.call([this] {
+        if (!_footer.has_primary_key_index_meta()) {
+            return Status::NotSupported("segment has no primary key index");
+        }
+        _pk_index_reader.reset(new PrimaryKeyIndexReader());
+        return _pk_index_reader->load(_path_desc, _footer.primary_key_index_meta());
+    });
+}
+
+Status Segment::lookup_row_key(const Slice& key, uint32_t* row_id) {
+    RETURN_IF_ERROR(load_primary_key_index());
+    auto iter = _pk_index_reader->new_iterator();
+    return _pk_index_reader->lookup_row_key(iter.get(), key, row_id);
+}
+
 Status Segment::_create_column_readers() {
     for (uint32_t ordinal = 0; ordinal < _footer.columns().size(); ++ordinal) {
         auto& column_pb = _footer.columns(ordinal);
@@ -45,6 +45,7 @@ namespace segment_v2 {
 class BitmapIndexIterator;
 class ColumnReader;
 class ColumnIterator;
+class PrimaryKeyIndexReader;
 class Segment;
 class SegmentIterator;
 using SegmentSharedPtr = std::shared_ptr<Segment>;
@@ -99,6 +100,21 @@ public:
         return _sk_index_decoder->num_items() - 1;
     }
 
+    bool has_primary_key_index() const { return _footer.has_primary_key_index_meta(); }
+
+    // Load the primary key index of a merge-on-write segment.
+    // May be called multiple times, subsequent calls will no op.
+    Status load_primary_key_index();
+
+    const PrimaryKeyIndexReader* primary_key_index() const {
+        DCHECK(_load_pk_index_once.has_called() && _load_pk_index_once.stored_result().ok());
+        return _pk_index_reader.get();
+    }
+
+    // Find the row id of `key` through the primary key index.
+    // Return NotFound if no row in this segment has this key.
+    Status lookup_row_key(const Slice& key, uint32_t* row_id);
+
     // only used by UT
     const SegmentFooterPB& footer() const { return _footer; }
 
@@ -108,6 +124,9 @@ private:
     // open segment file and read the minimum amount of necessary information (footer)
     Status _open();
     Status _parse_footer();
+    // Hint the block to read ahead the pages of the indexes read first by the iterators,
+    // that is the short key index and the root pages of the ordinal and zone map indexes.
+    Status _warm_up_index(fs::ReadableBlock* rblock);
     Status _create_column_readers();
     // Load and decode short key index.
     // May be called multiple times, subsequent calls will no op.
@@ -140,6 +159,9 @@ private:
     PageHandle _sk_index_handle;
     // short key index decoder
     std::unique_ptr<ShortKeyIndexDecoder> _sk_index_decoder;
+    // used to guarantee that primary key index will be loaded at most once
+    DorisCallOnce<Status> _load_pk_index_once;
+    std::unique_ptr<PrimaryKeyIndexReader> _pk_index_reader;
     // segment footer need not to be read for remote storage, so _is_open is false. When remote file
     // need to be read. footer will be read and _is_open will be set to true.
     bool _is_open = false;
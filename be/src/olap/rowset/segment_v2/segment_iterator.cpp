@@ -17,10 +17,13 @@
 
 #include "olap/rowset/segment_v2/segment_iterator.h"
 
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <set>
 #include <utility>
 
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
 #include "olap/column_predicate.h"
 #include "olap/fs/fs_util.h"
@@ -35,6 +38,7 @@
 #include "util/doris_metrics.h"
 #include "util/simd/bits.h"
 #include "vec/columns/column_dictionary.h"
+#include "vec/columns/column_nullable.h"
 
 using strings::Substitute;
 
@@ -140,6 +144,12 @@ Status SegmentIterator::_init(bool is_vec) {
     fs::BlockManager* block_mgr = fs::fs_util::block_manager(_segment->_path_desc);
     RETURN_IF_ERROR(block_mgr->open_block(_segment->_path_desc, &_rblock));
     _row_bitmap.addRange(0, _segment->num_rows());
+    auto delete_bitmap_iter = _opts.delete_bitmap.find(segment_id());
+    if (delete_bitmap_iter != _opts.delete_bitmap.end()) {
+        size_t pre_size = _row_bitmap.cardinality();
+        _row_bitmap -= *delete_bitmap_iter->second;
+        _opts.stats->rows_del_by_bitmap += (pre_size - _row_bitmap.cardinality());
+    }
     RETURN_IF_ERROR(_init_return_column_iterators());
     RETURN_IF_ERROR(_init_bitmap_index_iterators());
     // z-order can not use prefix index
@@ -147,6 +157,7 @@ Status SegmentIterator::_init(bool is_vec) {
         RETURN_IF_ERROR(_get_row_ranges_by_keys());
     }
     RETURN_IF_ERROR(_get_row_ranges_by_column_conditions());
+    RETURN_IF_ERROR(_apply_runtime_conditions());
     if (is_vec) {
         _vec_init_lazy_materialization();
         _vec_init_char_column_id();
@@ -154,9 +165,27 @@ Status SegmentIterator::_init(bool is_vec) {
         _init_lazy_materialization();
     }
     _range_iter.reset(new BitmapRangeIterator(_row_bitmap));
+    if (config::segment_prefetch_page_num > 0) {
+        _init_prefetch_row_ranges();
+    }
     return Status::OK();
 }
 
+void SegmentIterator::_init_prefetch_row_ranges() {
+    auto row_ranges = std::make_shared<RowRanges>();
+    BitmapRangeIterator range_iter(_row_bitmap);
+    uint32_t range_from;
+    uint32_t range_to;
+    while (range_iter.next_range(std::numeric_limits<uint32_t>::max(), &range_from, &range_to)) {
+        row_ranges->add(RowRange(range_from, range_to));
+    }
+    for (auto cid : _schema.column_ids()) {
+        if (_column_iterators[cid] != nullptr) {
+            _column_iterators[cid]->set_prefetch_row_ranges(row_ranges);
+        }
+    }
+}
+
 Status SegmentIterator::_get_row_ranges_by_keys() {
     DorisMetrics::instance()->segment_row_total->increment(num_rows());
 
@@ -248,6 +277,48 @@ Status SegmentIterator::_get_row_ranges_by_column_conditions() {
     return Status::OK();
 }
 
+Status SegmentIterator::_apply_runtime_conditions() {
+    if (_opts.runtime_conditions == nullptr ||
+        _num_runtime_conditions == _opts.runtime_conditions->size()) {
+        return Status::OK();
+    }
+    // the rows before _cur_rowid are read already
+    RowRanges unread_row_ranges = RowRanges::create_single(_cur_rowid, num_rows());
+    RowRanges row_ranges = unread_row_ranges;
+    for (size_t i = _num_runtime_conditions; i < _opts.runtime_conditions->size(); ++i) {
+        for (auto& column_condition : (*_opts.runtime_conditions)[i]->columns()) {
+            int32_t cid = column_condition.first;
+            if (cid >= _column_iterators.size() || _column_iterators[cid] == nullptr) {
+                continue;
+            }
+            RowRanges column_bf_row_ranges = unread_row_ranges;
+            RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_bloom_filter(
+                    column_condition.second, &column_bf_row_ranges));
+            RowRanges column_row_ranges = RowRanges::create_single(num_rows());
+            RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_zone_map(
+                    column_condition.second, nullptr, &column_row_ranges));
+            RowRanges::ranges_intersection(row_ranges, column_bf_row_ranges, &row_ranges);
+            RowRanges::ranges_intersection(row_ranges, column_row_ranges, &row_ranges);
+        }
+    }
+    _num_runtime_conditions = _opts.runtime_conditions->size();
+
+    roaring::Roaring unread_rows = _row_bitmap;
+    unread_rows.removeRange(0, _cur_rowid);
+    size_t pre_size = unread_rows.cardinality();
+    _row_bitmap = unread_rows & RowRanges::ranges_to_roaring(row_ranges);
+    _opts.stats->rows_runtime_conditions_filtered += (pre_size - _row_bitmap.cardinality());
+    if (_range_iter != nullptr) {
+        // the read rows are removed from _row_bitmap, so it starts from the first row not read
+        _range_iter.reset(new BitmapRangeIterator(_row_bitmap));
+        // stop prefetching the pages of the rows filtered out
+        if (config::segment_prefetch_page_num > 0) {
+            _init_prefetch_row_ranges();
+        }
+    }
+    return Status::OK();
+}
+
 Status SegmentIterator::_get_row_ranges_from_conditions(RowRanges* condition_row_ranges) {
     std::set<int32_t> cids;
     if (_opts.conditions != nullptr) {
@@ -513,6 +584,7 @@ Status SegmentIterator::next_batch(RowBlockV2* block) {
         }
         _inited = true;
     }
+    RETURN_IF_ERROR(_apply_runtime_conditions());
 
     uint32_t nrows_read = 0;
     uint32_t nrows_read_limit = block->capacity();
@@ -610,6 +682,14 @@ Status SegmentIterator::next_batch(RowBlockV2* block) {
 // todo(wb) need a UT here
 void SegmentIterator::_vec_init_lazy_materialization() {
     _is_pred_column.resize(_schema.columns().size(), false);
+    _is_dict_code_column.resize(_schema.columns().size(), false);
+    for (auto cid : _opts.dict_code_columns) {
+        if (cid < _schema.columns().size() && _schema.column(cid) != nullptr) {
+            FieldType type = _schema.column(cid)->type();
+            _is_dict_code_column[cid] =
+                    type == OLAP_FIELD_TYPE_VARCHAR || type == OLAP_FIELD_TYPE_STRING;
+        }
+    }
 
     // including short_cir_pred_col_id_set and vec_pred_col_id_set
     std::set<ColumnId> pred_column_ids;
@@ -762,7 +842,8 @@ void SegmentIterator::_init_current_block(
         auto cid = _schema.column_id(i);
         auto column_desc = _schema.column(cid);
 
-        if (_is_pred_column[cid]) { //todo(wb) maybe we can release it after output block
+        if (_is_pred_column[cid] ||
+            _is_dict_code_column[cid]) { //todo(wb) maybe we can release it after output block
             current_columns[cid]->clear();
         } else { // non-predicate column
             current_columns[cid] = std::move(*block->get_by_position(i).column).mutate();
@@ -777,12 +858,62 @@ void SegmentIterator::_init_current_block(
     }
 }
 
-void SegmentIterator::_output_non_pred_columns(vectorized::Block* block) {
+Status SegmentIterator::_output_non_pred_columns(vectorized::Block* block) {
     SCOPED_RAW_TIMER(&_opts.stats->output_col_ns);
+    std::vector<uint16_t> all_rows;
     for (auto cid : _non_predicate_columns) {
+        if (_is_dict_code_column[cid]) {
+            // the column only holds the rows to output
+            size_t rows = _current_return_columns[cid]->size();
+            if (all_rows.size() != rows) {
+                all_rows.resize(rows);
+                std::iota(all_rows.begin(), all_rows.end(), 0);
+            }
+            RETURN_IF_ERROR(_output_dict_code_column(block, cid, all_rows.data(), rows));
+            continue;
+        }
         block->replace_by_position(_schema_block_id_map[cid],
                                    std::move(_current_return_columns[cid]));
     }
+    return Status::OK();
+}
+
+// The codes of the rows are output with the dictionary of the segment, so the strings are
+// only decoded for the rows which pass the filters of the scanner on the codes. The column
+// is decoded here if plain encoded pages were read and it holds the strings.
+Status SegmentIterator::_output_dict_code_column(vectorized::Block* block, ColumnId cid,
+                                                 const uint16_t* sel_rowid_idx,
+                                                 uint16_t select_size) {
+    int block_cid = _schema_block_id_map[cid];
+    if (block_cid >= block->columns()) {
+        return Status::OK();
+    }
+    auto* column = _current_return_columns[cid].get();
+    vectorized::ColumnNullable* nullable_column = nullptr;
+    vectorized::IColumn* nested_column = column;
+    if (column->is_nullable()) {
+        nullable_column = reinterpret_cast<vectorized::ColumnNullable*>(column);
+        nested_column = &nullable_column->get_nested_column();
+    }
+
+    if (!nested_column->is_column_dictionary()) {
+        block->replace_by_position(block_cid,
+                                   block->get_by_position(block_cid).type->create_column());
+        return block->copy_column_data_to_block(column, const_cast<uint16_t*>(sel_rowid_idx),
+                                                select_size, block_cid, _opts.block_row_max);
+    }
+
+    vectorized::MutableColumnPtr codes =
+            reinterpret_cast<vectorized::ColumnDictI32*>(nested_column)
+                    ->clone_codes_by_selector(sel_rowid_idx, select_size);
+    if (nullable_column != nullptr) {
+        auto null_map = vectorized::ColumnUInt8::create();
+        RETURN_IF_ERROR(nullable_column->get_null_map_column().filter_by_selector(
+                sel_rowid_idx, select_size, null_map.get()));
+        codes = vectorized::ColumnNullable::create(std::move(codes), std::move(null_map));
+    }
+    block->replace_by_position(block_cid, std::move(codes));
+    return Status::OK();
 }
 
 Status SegmentIterator::_read_columns_by_index(uint32_t nrows_read_limit, uint32_t& nrows_read,
@@ -922,9 +1053,20 @@ Status SegmentIterator::next_batch(vectorized::Block* block) {
                 _current_return_columns[cid] = Schema::get_predicate_column_nullable_ptr(
                         column_desc->type(), column_desc->is_nullable());
                 _current_return_columns[cid]->reserve(_opts.block_row_max);
+            } else if (_is_dict_code_column[cid]) {
+                // the dictionary encoded pages are read as codes, the plain encoded pages
+                // convert the column to a PredicateColumnType<StringValue>
+                vectorized::MutableColumnPtr codes = vectorized::ColumnDictI32::create();
+                if (_schema.column(cid)->is_nullable()) {
+                    codes = vectorized::ColumnNullable::create(std::move(codes),
+                                                               vectorized::ColumnUInt8::create());
+                }
+                _current_return_columns[cid] = std::move(codes);
+                _current_return_columns[cid]->reserve(_opts.block_row_max);
             }
         }
     }
+    RETURN_IF_ERROR(_apply_runtime_conditions());
 
     _init_current_block(block, _current_return_columns);
 
@@ -939,7 +1081,7 @@ Status SegmentIterator::next_batch(vectorized::Block* block) {
         for (int i = 0; i < _schema.num_column_ids(); i++) {
             auto cid = _schema.column_id(i);
             // todo(wb) abstract make column where
-            if (!_is_pred_column[cid]) { // non-predicate
+            if (!_is_pred_column[cid] && !_is_dict_code_column[cid]) { // non-predicate
                 block->replace_by_position(i, std::move(_current_return_columns[cid]));
             }
         }
@@ -949,7 +1091,7 @@ Status SegmentIterator::next_batch(vectorized::Block* block) {
 
     // when no predicate(include delete condition) is provided, output column directly
     if (_vec_pred_column_ids.empty() && _short_cir_pred_column_ids.empty()) {
-        _output_non_pred_columns(block);
+        RETURN_IF_ERROR(_output_non_pred_columns(block));
     } else { // need predicate evaluation
         uint16_t selected_size = nrows_read;
         uint16_t sel_rowid_idx[selected_size];
@@ -977,7 +1119,7 @@ Status SegmentIterator::next_batch(vectorized::Block* block) {
 
             // step4: output columns
             // 4.1 output non-predicate column
-            _output_non_pred_columns(block);
+            RETURN_IF_ERROR(_output_non_pred_columns(block));
 
             // 4.2 get union of short_cir_pred and vec_pred
             std::set<ColumnId> pred_column_ids;
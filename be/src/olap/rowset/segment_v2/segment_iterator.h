@@ -64,6 +64,9 @@ private:
 
     Status _init_return_column_iterators();
     Status _init_bitmap_index_iterators();
+    // pass the rows in `_row_bitmap` to column iterators for page prefetch, called again
+    // whenever `_row_bitmap` shrinks after the iterator is initialized
+    void _init_prefetch_row_ranges();
 
     // calculate row ranges that fall into requested key ranges using short key index
     Status _get_row_ranges_by_keys();
@@ -76,6 +79,8 @@ private:
     Status _get_row_ranges_by_column_conditions();
     Status _get_row_ranges_from_conditions(RowRanges* condition_row_ranges);
     Status _apply_bitmap_index();
+    // prune the rows not read yet with the new conditions in `_opts.runtime_conditions`
+    Status _apply_runtime_conditions();
 
     void _init_lazy_materialization();
     void _vec_init_lazy_materialization();
@@ -101,7 +106,9 @@ private:
                              std::vector<vectorized::MutableColumnPtr>& non_pred_vector);
     void _evaluate_vectorization_predicate(uint16_t* sel_rowid_idx, uint16_t& selected_size);
     void _evaluate_short_circuit_predicate(uint16_t* sel_rowid_idx, uint16_t* selected_size);
-    void _output_non_pred_columns(vectorized::Block* block);
+    Status _output_non_pred_columns(vectorized::Block* block);
+    Status _output_dict_code_column(vectorized::Block* block, ColumnId cid,
+                                    const uint16_t* sel_rowid_idx, uint16_t select_size);
     void _read_columns_by_rowids(std::vector<ColumnId>& read_column_ids,
                                  std::vector<rowid_t>& rowid_vector, uint16_t* sel_rowid_idx,
                                  size_t select_size, vectorized::MutableColumns* mutable_columns);
@@ -111,6 +118,11 @@ private:
                                      uint16_t* sel_rowid_idx, uint16_t select_size) {
         SCOPED_RAW_TIMER(&_opts.stats->output_col_ns);
         for (auto cid : column_ids) {
+            if (_is_dict_code_column[cid]) {
+                RETURN_IF_ERROR(
+                        _output_dict_code_column(block, cid, sel_rowid_idx, select_size));
+                continue;
+            }
             int block_cid = _schema_block_id_map[cid];
             RETURN_IF_ERROR(block->copy_column_data_to_block(_current_return_columns[cid].get(),
                                                              sel_rowid_idx, select_size, block_cid,
@@ -154,6 +166,8 @@ private:
     std::vector<ColumnId>
             _short_cir_pred_column_ids; // keep columnId of columns for short circuit predicate evaluation
     std::vector<bool> _is_pred_column; // columns hold by segmentIter
+    // columns output as dictionary codes, see StorageReadOptions::dict_code_columns
+    std::vector<bool> _is_dict_code_column;
     vectorized::MutableColumns _current_return_columns;
     std::unique_ptr<AndBlockColumnPredicate> _pre_eval_block_predicate;
     std::vector<ColumnPredicate*> _short_cir_eval_predicate;
@@ -170,6 +184,8 @@ private:
     StorageReadOptions _opts;
     // make a copy of `_opts.column_predicates` in order to make local changes
     std::vector<ColumnPredicate*> _col_predicates;
+    // the number of `_opts.runtime_conditions` applied to `_row_bitmap`
+    size_t _num_runtime_conditions = 0;
 
     // row schema of the key to seek
     // only used in `_get_row_ranges_by_keys`
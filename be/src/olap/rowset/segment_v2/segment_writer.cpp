@@ -17,6 +17,8 @@
 
 #include "olap/rowset/segment_v2/segment_writer.h"
 
+#include <numeric>
+
 #include "common/logging.h" // LOG
 #include "env/env.h"        // Env
 #include "olap/data_dir.h"
@@ -25,6 +27,7 @@
 #include "olap/row_cursor.h"                      // RowCursor
 #include "olap/rowset/segment_v2/column_writer.h" // ColumnWriter
 #include "olap/rowset/segment_v2/page_io.h"
+#include "olap/rowset/segment_v2/primary_key_index.h"
 #include "olap/schema.h"
 #include "olap/short_key_index.h"
 #include "runtime/mem_tracker.h"
@@ -56,6 +59,12 @@ SegmentWriter::SegmentWriter(fs::WritableBlock* wblock, uint32_t segment_id,
         _short_key_coders.push_back(get_key_coder(column.type()));
         _short_key_index_size.push_back(column.index_length());
     }
+    if (_opts.enable_unique_key_merge_on_write) {
+        DCHECK(_tablet_schema->keys_type() == KeysType::UNIQUE_KEYS);
+        for (size_t cid = 0; cid < _tablet_schema->num_key_columns(); ++cid) {
+            _key_coders.push_back(get_key_coder(_tablet_schema->column(cid).type()));
+        }
+    }
 }
 
 SegmentWriter::~SegmentWriter() {
@@ -78,13 +87,30 @@ void SegmentWriter::init_column_meta(ColumnMetaPB* meta, uint32_t* column_id,
 }
 
 Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))) {
-    uint32_t column_id = 0;
-    _column_writers.reserve(_tablet_schema->columns().size());
-    for (auto& column : _tablet_schema->columns()) {
-        ColumnWriterOptions opts;
-        opts.meta = _footer.add_columns();
+    std::vector<uint32_t> column_ids(_tablet_schema->num_columns());
+    std::iota(column_ids.begin(), column_ids.end(), 0);
+    return init(column_ids, true);
+}
+
+Status SegmentWriter::init(const std::vector<uint32_t>& col_ids, bool has_key) {
+    DCHECK(_column_writers.empty());
+    // the metas of all columns are added at the first init, the footer keeps the order
+    // of the schema whichever group is written first
+    if (_footer.columns_size() == 0) {
+        uint32_t column_id = 0;
+        for (auto& column : _tablet_schema->columns()) {
+            init_column_meta(_footer.add_columns(), &column_id, column);
+        }
+    }
 
-        init_column_meta(opts.meta, &column_id, column);
+    _column_ids = col_ids;
+    _has_key = has_key;
+    _num_rows_written = 0;
+    _column_writers.reserve(col_ids.size());
+    for (auto cid : col_ids) {
+        const auto& column = _tablet_schema->column(cid);
+        ColumnWriterOptions opts;
+        opts.meta = _footer.mutable_columns(cid);
 
         // now we create zone map for key columns in AGG_KEYS or all column in UNIQUE_KEYS or DUP_KEYS
         // and not support zone map for array type.
@@ -106,7 +132,13 @@ Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))
         RETURN_IF_ERROR(writer->init());
         _column_writers.push_back(std::move(writer));
     }
-    _index_builder.reset(new ShortKeyIndexBuilder(_segment_id, _opts.num_rows_per_block));
+    if (_has_key) {
+        _index_builder.reset(new ShortKeyIndexBuilder(_segment_id, _opts.num_rows_per_block));
+        if (_opts.enable_unique_key_merge_on_write) {
+            _primary_key_index_builder.reset(new PrimaryKeyIndexBuilder(_wblock));
+            RETURN_IF_ERROR(_primary_key_index_builder->init());
+        }
+    }
     return Status::OK();
 }
 
@@ -114,7 +146,23 @@ Status SegmentWriter::append_block(const vectorized::Block* block, size_t row_po
                                    size_t num_rows) {
     assert(block && num_rows > 0 && row_pos + num_rows <= block->rows() &&
            block->columns() == _column_writers.size());
-    _olap_data_convertor.set_source_content(block, row_pos, num_rows);
+    _olap_data_convertor.set_source_content_with_specified_columns(block, row_pos, num_rows,
+                                                                   _column_ids);
+
+    // the value groups of a vertical compaction only append the column data
+    if (!_has_key) {
+        for (size_t i = 0; i < _column_writers.size(); ++i) {
+            auto converted_result = _olap_data_convertor.convert_column_data(_column_ids[i]);
+            if (converted_result.first != Status::OK()) {
+                return converted_result.first;
+            }
+            _column_writers[i]->append(converted_result.second->get_nullmap(),
+                                       converted_result.second->get_data(), num_rows);
+        }
+        _num_rows_written += num_rows;
+        _olap_data_convertor.clear_source_content();
+        return Status::OK();
+    }
 
     // find all row pos for short key indexes
     std::vector<size_t> short_key_pos;
@@ -127,32 +175,48 @@ Status SegmentWriter::append_block(const vectorized::Block* block, size_t row_po
     }
 
     // convert column data from engine format to storage layer format
-    std::vector<vectorized::IOlapColumnDataAccessorSPtr> short_key_columns;
-    size_t num_key_columns = _tablet_schema->num_short_key_columns();
-    for (size_t cid = 0; cid < _column_writers.size(); ++cid) {
-        auto converted_result = _olap_data_convertor.convert_column_data(cid);
+    std::vector<vectorized::IOlapColumnDataAccessorSPtr> key_columns;
+    size_t num_short_key_columns = _tablet_schema->num_short_key_columns();
+    size_t num_key_columns = _primary_key_index_builder != nullptr
+                                     ? _tablet_schema->num_key_columns()
+                                     : num_short_key_columns;
+    for (size_t i = 0; i < _column_writers.size(); ++i) {
+        auto converted_result = _olap_data_convertor.convert_column_data(_column_ids[i]);
         if (converted_result.first != Status::OK()) {
             return converted_result.first;
         }
-        if (cid < num_key_columns) {
-            short_key_columns.push_back(converted_result.second);
+        if (_column_ids[i] < num_key_columns) {
+            key_columns.push_back(converted_result.second);
         }
-        _column_writers[cid]->append(converted_result.second->get_nullmap(),
-                                     converted_result.second->get_data(), num_rows);
+        _column_writers[i]->append(converted_result.second->get_nullmap(),
+                                   converted_result.second->get_data(), num_rows);
     }
 
     // create short key indexes
     std::vector<const void*> key_column_fields;
     for (const auto pos : short_key_pos) {
-        for (const auto& column : short_key_columns) {
-            key_column_fields.push_back(column->get_data_at(pos));
+        for (size_t cid = 0; cid < num_short_key_columns; ++cid) {
+            key_column_fields.push_back(key_columns[cid]->get_data_at(pos));
         }
         std::string encoded_key = encode_short_keys(key_column_fields);
         RETURN_IF_ERROR(_index_builder->add_item(encoded_key));
         key_column_fields.clear();
     }
 
+    // create primary key index, one entry per row
+    if (_primary_key_index_builder != nullptr) {
+        for (size_t pos = 0; pos < num_rows; ++pos) {
+            for (const auto& column : key_columns) {
+                key_column_fields.push_back(column->get_data_at(pos));
+            }
+            std::string encoded_key = _full_encode_keys(key_column_fields);
+            RETURN_IF_ERROR(_primary_key_index_builder->add_item(encoded_key));
+            key_column_fields.clear();
+        }
+    }
+
     _row_count += num_rows;
+    _num_rows_written += num_rows;
     _olap_data_convertor.clear_source_content();
     return Status::OK();
 }
@@ -189,6 +253,21 @@ std::string SegmentWriter::encode_short_keys(const std::vector<const void*> key_
     return encoded_keys;
 }
 
+std::string SegmentWriter::_full_encode_keys(const std::vector<const void*>& key_column_fields) {
+    DCHECK_EQ(key_column_fields.size(), _key_coders.size());
+    std::string encoded_keys;
+    for (size_t cid = 0; cid < _key_coders.size(); ++cid) {
+        auto field = key_column_fields[cid];
+        if (UNLIKELY(!field)) {
+            encoded_keys.push_back(KEY_NULL_FIRST_MARKER);
+            continue;
+        }
+        encoded_keys.push_back(KEY_NORMAL_MARKER);
+        _key_coders[cid]->full_encode_ascending(field, &encoded_keys);
+    }
+    return encoded_keys;
+}
+
 template <typename RowType>
 Status SegmentWriter::append_row(const RowType& row) {
     for (size_t cid = 0; cid < _column_writers.size(); ++cid) {
@@ -202,7 +281,16 @@ Status SegmentWriter::append_row(const RowType& row) {
         encode_key(&encoded_key, row, _tablet_schema->num_short_key_columns());
         RETURN_IF_ERROR(_index_builder->add_item(encoded_key));
     }
+    if (_primary_key_index_builder != nullptr) {
+        std::vector<const void*> key_column_fields;
+        for (size_t cid = 0; cid < _key_coders.size(); ++cid) {
+            auto cell = row.cell(cid);
+            key_column_fields.push_back(cell.is_null() ? nullptr : cell.cell_ptr());
+        }
+        RETURN_IF_ERROR(_primary_key_index_builder->add_item(_full_encode_keys(key_column_fields)));
+    }
     ++_row_count;
+    ++_num_rows_written;
     return Status::OK();
 }
 
@@ -219,7 +307,12 @@ uint64_t SegmentWriter::estimate_segment_size() {
     for (auto& column_writer : _column_writers) {
         size += column_writer->estimate_buffer_size();
     }
-    size += _index_builder->size();
+    if (_index_builder != nullptr) {
+        size += _index_builder->size();
+    }
+    if (_primary_key_index_builder != nullptr) {
+        size += _primary_key_index_builder->size();
+    }
 
     // update the mem_tracker of segment size
     _mem_tracker->consume(size - _mem_tracker->consumption());
@@ -227,6 +320,16 @@ uint64_t SegmentWriter::estimate_segment_size() {
 }
 
 Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size) {
+    RETURN_IF_ERROR(finalize_columns(index_size));
+    return finalize_footer(segment_file_size);
+}
+
+Status SegmentWriter::finalize_columns(uint64_t* index_size) {
+    if (_num_rows_written != _row_count) {
+        return Status::InternalError(fmt::format(
+                "{} rows are written to a column group of segment {}, but the segment has {} rows",
+                _num_rows_written, _segment_id, _row_count));
+    }
     // check disk capacity
     if (_data_dir != nullptr && _data_dir->reach_capacity_limit((int64_t)estimate_segment_size())) {
         return Status::InternalError(
@@ -241,8 +344,18 @@ Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size
     RETURN_IF_ERROR(_write_zone_map());
     RETURN_IF_ERROR(_write_bitmap_index());
     RETURN_IF_ERROR(_write_bloom_filter_index());
-    RETURN_IF_ERROR(_write_short_key_index());
+    if (_has_key) {
+        RETURN_IF_ERROR(_write_short_key_index());
+        RETURN_IF_ERROR(_write_primary_key_index());
+    }
     *index_size = _wblock->bytes_appended() - index_offset;
+    // the pages of the group are written, release the memory of the writers
+    _column_writers.clear();
+    _column_ids.clear();
+    return Status::OK();
+}
+
+Status SegmentWriter::finalize_footer(uint64_t* segment_file_size) {
     RETURN_IF_ERROR(_write_footer());
     RETURN_IF_ERROR(_wblock->finalize());
     *segment_file_size = _wblock->bytes_appended();
@@ -297,6 +410,14 @@ Status SegmentWriter::_write_short_key_index() {
     return Status::OK();
 }
 
+Status SegmentWriter::_write_primary_key_index() {
+    if (_primary_key_index_builder == nullptr) {
+        return Status::OK();
+    }
+    DCHECK_EQ(_primary_key_index_builder->num_rows(), _row_count);
+    return _primary_key_index_builder->finalize(_footer.mutable_primary_key_index_meta());
+}
+
 Status SegmentWriter::_write_footer() {
     _footer.set_num_rows(_row_count);
 
@@ -49,12 +49,15 @@ class WritableBlock;
 namespace segment_v2 {
 
 class ColumnWriter;
+class PrimaryKeyIndexBuilder;
 
 extern const char* k_segment_magic;
 extern const uint32_t k_segment_magic_length;
 
 struct SegmentWriterOptions {
     uint32_t num_rows_per_block = 1024;
+    // write a primary key index for merge-on-write unique key tables
+    bool enable_unique_key_merge_on_write = false;
 };
 
 class SegmentWriter {
@@ -66,6 +69,13 @@ public:
 
     Status init(uint32_t write_mbytes_per_sec);
 
+    // Init the writer to write the columns `col_ids` only. A segment of the vertical
+    // compaction is written column group by column group, each group is inited, appended
+    // and finalized by finalize_columns() in turn, then the footer is written by
+    // finalize_footer(). The key group, which `has_key` is true for, builds the indexes
+    // of the keys and decides the number of rows.
+    Status init(const std::vector<uint32_t>& col_ids, bool has_key);
+
     template <typename RowType>
     Status append_row(const RowType& row);
 
@@ -75,10 +85,19 @@ public:
 
     uint64_t estimate_segment_size();
 
-    uint32_t num_rows_written() { return _row_count; }
+    // the rows written to the current column group
+    uint32_t num_rows_written() { return _num_rows_written; }
+
+    // the rows of the segment, which is decided by the key group
+    uint32_t row_count() const { return _row_count; }
 
     Status finalize(uint64_t* segment_file_size, uint64_t* index_size);
 
+    // write the data and the indexes of the current column group and release its writers
+    Status finalize_columns(uint64_t* index_size);
+
+    Status finalize_footer(uint64_t* segment_file_size);
+
     static void init_column_meta(ColumnMetaPB* meta, uint32_t* column_id,
                                  const TabletColumn& column);
 
@@ -90,11 +109,14 @@ private:
     Status _write_bitmap_index();
     Status _write_bloom_filter_index();
     Status _write_short_key_index();
+    Status _write_primary_key_index();
     Status _write_footer();
     Status _write_raw_data(const std::vector<Slice>& slices);
 
     std::string encode_short_keys(const std::vector<const void*> key_column_fields,
                                   bool null_first = true);
+    // encode all key columns, the result is the key of the row in primary key index
+    std::string _full_encode_keys(const std::vector<const void*>& key_column_fields);
 
 private:
     uint32_t _segment_id;
@@ -108,13 +130,20 @@ private:
 
     SegmentFooterPB _footer;
     std::unique_ptr<ShortKeyIndexBuilder> _index_builder;
+    std::unique_ptr<PrimaryKeyIndexBuilder> _primary_key_index_builder;
+    // the writers of the columns `_column_ids`
+    std::vector<uint32_t> _column_ids;
     std::vector<std::unique_ptr<ColumnWriter>> _column_writers;
+    bool _has_key = true;
     std::shared_ptr<MemTracker> _mem_tracker;
     uint32_t _row_count = 0;
+    uint32_t _num_rows_written = 0;
 
     vectorized::OlapBlockDataConvertor _olap_data_convertor;
     std::vector<const KeyCoder*> _short_key_coders;
     std::vector<uint16_t> _short_key_index_size;
+    // coders of all key columns, only used to build primary key index
+    std::vector<const KeyCoder*> _key_coders;
     size_t _short_key_row_pos = 0;
 };
 
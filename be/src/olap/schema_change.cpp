@@ -1416,6 +1416,12 @@ Status SchemaChangeHandler::_do_process_alter_tablet_v2(const TAlterTabletReqV2&
         LOG(WARNING) << "fail to find base tablet. base_tablet=" << request.base_tablet_id;
         return Status::OLAPInternalError(OLAP_ERR_TABLE_NOT_FOUND);
     }
+    if (base_tablet->enable_unique_key_merge_on_write()) {
+        // the delete bitmap is bound to the rowset ids of the base tablet
+        LOG(WARNING) << "schema change of merge-on-write tablet is not supported. base_tablet="
+                     << request.base_tablet_id;
+        return Status::OLAPInternalError(OLAP_ERR_FUNC_NOT_IMPLEMENTED);
+    }
 
     // new tablet has to exist
     TabletSharedPtr new_tablet =
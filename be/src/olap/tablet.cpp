@@ -36,7 +36,11 @@
 #include "olap/row_cursor.h"
 #include "olap/rowset/rowset.h"
 #include "olap/rowset/rowset_factory.h"
+#include "olap/rowset/beta_rowset.h"
 #include "olap/rowset/rowset_meta_manager.h"
+#include "olap/rowset/segment_v2/primary_key_index.h"
+#include "olap/rowset/segment_v2/segment.h"
+#include "olap/segment_loader.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet_meta_manager.h"
 #include "util/path_util.h"
@@ -134,9 +138,21 @@ Status Tablet::init() {
 // should save tablet meta to remote meta store
 // if it's a primary replica
 void Tablet::save_meta() {
+    // The delete bitmaps saved by add_inc_rowset() before now have been merged into the tablet
+    // meta, and are removed once the tablet meta is saved. Those saved later are kept.
+    std::vector<std::string> delete_bitmap_keys;
+    if (enable_unique_key_merge_on_write()) {
+        WARN_IF_ERROR(TabletMetaManager::get_delete_bitmap_keys(_data_dir, tablet_id(),
+                                                                &delete_bitmap_keys),
+                      "failed to get delete bitmap keys of tablet " + full_name());
+    }
     auto res = _tablet_meta->save_meta(_data_dir);
     CHECK_EQ(res, Status::OK()) << "fail to save tablet_meta. res=" << res
                                 << ", root=" << _data_dir->path();
+    if (!delete_bitmap_keys.empty()) {
+        WARN_IF_ERROR(TabletMetaManager::remove_delete_bitmaps(_data_dir, delete_bitmap_keys),
+                      "failed to remove delete bitmaps of tablet " + full_name());
+    }
 }
 
 Status Tablet::revise_tablet_meta(const std::vector<RowsetMetaSharedPtr>& rowsets_to_clone,
@@ -310,6 +326,9 @@ void Tablet::modify_rowsets(std::vector<RowsetSharedPtr>& to_add,
         for (auto& rs : to_delete) {
             LOG(INFO) << "add unused rowset " << rs->rowset_id() << " because of same version";
             StorageEngine::instance()->add_unused_rowset(rs);
+            if (enable_unique_key_merge_on_write()) {
+                _tablet_meta->delete_bitmap().remove_rowset(rs->rowset_id());
+            }
         }
     }
 }
@@ -368,20 +387,266 @@ RowsetSharedPtr Tablet::_rowset_with_largest_size() {
 }
 
 // add inc rowset should not persist tablet meta, because it will be persisted when publish txn.
+// For a merge-on-write tablet, only the delete bitmap marked by the rowset is persisted, see
+// TabletMetaManager::save_delete_bitmap().
 Status Tablet::add_inc_rowset(const RowsetSharedPtr& rowset) {
     DCHECK(rowset != nullptr);
+    DeleteBitmap delete_bitmap;
+    std::set<RowsetId> checked_rowsets;
+    if (enable_unique_key_merge_on_write()) {
+        // look up the keys without holding the write lock, which blocks the queries
+        std::vector<RowsetSharedPtr> older_rowsets;
+        std::vector<RowsetSharedPtr> newer_rowsets;
+        {
+            std::shared_lock rdlock(_meta_lock);
+            if (_contains_rowset(rowset->rowset_id())) {
+                return Status::OK();
+            }
+            _get_rowsets_to_check_keys(rowset, checked_rowsets, &older_rowsets, &newer_rowsets);
+        }
+        RETURN_NOT_OK(_calc_delete_bitmap(rowset, older_rowsets, newer_rowsets, true,
+                                          &delete_bitmap));
+        for (auto& rs : older_rowsets) {
+            checked_rowsets.insert(rs->rowset_id());
+        }
+        for (auto& rs : newer_rowsets) {
+            checked_rowsets.insert(rs->rowset_id());
+        }
+    }
+
     std::lock_guard<std::shared_mutex> wrlock(_meta_lock);
     if (_contains_rowset(rowset->rowset_id())) {
         return Status::OK();
     }
     RETURN_NOT_OK(_contains_version(rowset->version()));
 
+    if (enable_unique_key_merge_on_write()) {
+        // the rowsets published or compacted while the keys were looked up
+        std::vector<RowsetSharedPtr> older_rowsets;
+        std::vector<RowsetSharedPtr> newer_rowsets;
+        _get_rowsets_to_check_keys(rowset, checked_rowsets, &older_rowsets, &newer_rowsets);
+        if (!older_rowsets.empty() || !newer_rowsets.empty()) {
+            RETURN_NOT_OK(_calc_delete_bitmap(rowset, older_rowsets, newer_rowsets, false,
+                                              &delete_bitmap));
+        }
+    }
+
     RETURN_NOT_OK(_tablet_meta->add_rs_meta(rowset->rowset_meta()));
     _rs_version_map[rowset->version()] = rowset;
 
     _timestamped_version_tracker.add_version(rowset->version());
 
     ++_newly_created_rowset_num;
+    if (enable_unique_key_merge_on_write()) {
+        _tablet_meta->delete_bitmap().merge(delete_bitmap);
+        // must be saved after merged into the tablet meta, see save_meta()
+        Status st = TabletMetaManager::save_delete_bitmap(_data_dir, tablet_id(),
+                                                          rowset->rowset_id(),
+                                                          rowset->end_version(), delete_bitmap);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to save delete bitmap of rowset " << rowset->rowset_id()
+                         << ", save the tablet meta instead. tablet=" << full_name()
+                         << ", res=" << st;
+            save_meta();
+        }
+    }
+    return Status::OK();
+}
+
+void Tablet::merge_saved_delete_bitmap(const DeleteBitmap& delete_bitmap) {
+    std::lock_guard<std::shared_mutex> wrlock(_meta_lock);
+    std::set<RowsetId> rowset_ids;
+    for (auto& it : _rs_version_map) {
+        rowset_ids.insert(it.second->rowset_id());
+    }
+    for (auto& it : _stale_rs_version_map) {
+        rowset_ids.insert(it.second->rowset_id());
+    }
+    _tablet_meta->delete_bitmap().merge(delete_bitmap, rowset_ids);
+}
+
+void Tablet::_get_rowsets_to_check_keys(const RowsetSharedPtr& rowset,
+                                        const std::set<RowsetId>& excluded_rowsets,
+                                        std::vector<RowsetSharedPtr>* older_rowsets,
+                                        std::vector<RowsetSharedPtr>* newer_rowsets) {
+    for (auto& [version, rs] : _rs_version_map) {
+        if (excluded_rowsets.count(rs->rowset_id()) > 0) {
+            continue;
+        }
+        if (version.second < rowset->start_version()) {
+            older_rowsets->push_back(rs);
+        } else {
+            // published before this rowset, versions are not published in order
+            newer_rowsets->push_back(rs);
+        }
+    }
+    std::sort(older_rowsets->begin(), older_rowsets->end(),
+              [](const RowsetSharedPtr& a, const RowsetSharedPtr& b) {
+                  return a->end_version() > b->end_version();
+              });
+    std::sort(newer_rowsets->begin(), newer_rowsets->end(), Rowset::comparator);
+}
+
+Status Tablet::update_delete_bitmap_after_compaction(const RowsetSharedPtr& output_rowset) {
+    DCHECK(enable_unique_key_merge_on_write());
+    std::vector<RowsetSharedPtr> newer_rowsets;
+    for (auto& [version, rs] : _rs_version_map) {
+        if (version.first > output_rowset->end_version()) {
+            newer_rowsets.push_back(rs);
+        }
+    }
+    if (newer_rowsets.empty()) {
+        return Status::OK();
+    }
+    std::sort(newer_rowsets.begin(), newer_rowsets.end(), Rowset::comparator);
+    DeleteBitmap delete_bitmap;
+    RETURN_NOT_OK(_calc_delete_bitmap(output_rowset, {}, newer_rowsets, false, &delete_bitmap));
+    _tablet_meta->delete_bitmap().merge(delete_bitmap);
+    return Status::OK();
+}
+
+namespace {
+
+// Primary key indexes of the segments in a rowset, the iterators are created on demand
+// and reused by all the lookups.
+class RowsetKeyIndex {
+public:
+    Status init(const RowsetSharedPtr& rowset) {
+        _rowset = rowset;
+        RETURN_NOT_OK(rowset->load());
+        RETURN_NOT_OK(SegmentLoader::instance()->load_segments(
+                std::static_pointer_cast<BetaRowset>(rowset), &_handle, true));
+        for (auto& segment : segments()) {
+            RETURN_NOT_OK(segment->load_primary_key_index());
+        }
+        _iters.resize(segments().size());
+        return Status::OK();
+    }
+
+    const std::vector<segment_v2::SegmentSharedPtr>& segments() {
+        return _handle.get_segments();
+    }
+
+    segment_v2::IndexedColumnIterator* iterator(uint32_t segment_id) {
+        if (_iters[segment_id] == nullptr) {
+            _iters[segment_id] = segments()[segment_id]->primary_key_index()->new_iterator();
+        }
+        return _iters[segment_id].get();
+    }
+
+    // Find `key` in segments [0, `end_segment`), from the last one to the first one,
+    // because a later segment overwrites an earlier one in the same rowset.
+    Status lookup(const Slice& key, uint32_t end_segment, uint32_t* segment_id,
+                  uint32_t* row_id) {
+        for (uint32_t i = end_segment; i > 0; --i) {
+            const auto* pk_index = segments()[i - 1]->primary_key_index();
+            auto st = pk_index->lookup_row_key(iterator(i - 1), key, row_id);
+            if (st.ok()) {
+                *segment_id = i - 1;
+                return st;
+            }
+            if (!st.is_not_found()) {
+                return st;
+            }
+        }
+        return Status::NotFound("key not found in rowset");
+    }
+
+    Status lookup(const Slice& key, uint32_t* segment_id, uint32_t* row_id) {
+        return lookup(key, segments().size(), segment_id, row_id);
+    }
+
+    const RowsetSharedPtr& rowset() const { return _rowset; }
+
+private:
+    RowsetSharedPtr _rowset;
+    SegmentCacheHandle _handle;
+    std::vector<std::unique_ptr<segment_v2::IndexedColumnIterator>> _iters;
+};
+
+} // namespace
+
+Status Tablet::_calc_delete_bitmap(const RowsetSharedPtr& rowset,
+                                   const std::vector<RowsetSharedPtr>& older_rowsets,
+                                   const std::vector<RowsetSharedPtr>& newer_rowsets,
+                                   bool check_self, DeleteBitmap* delete_bitmap) {
+    if (rowset->num_rows() == 0) {
+        return Status::OK();
+    }
+    auto init_indexes = [](const std::vector<RowsetSharedPtr>& rowsets,
+                           std::vector<std::unique_ptr<RowsetKeyIndex>>* indexes) {
+        for (auto& rs : rowsets) {
+            if (rs->num_rows() == 0) {
+                continue;
+            }
+            indexes->emplace_back(new RowsetKeyIndex());
+            RETURN_NOT_OK(indexes->back()->init(rs));
+        }
+        return Status::OK();
+    };
+    RowsetKeyIndex self;
+    std::vector<std::unique_ptr<RowsetKeyIndex>> older;
+    std::vector<std::unique_ptr<RowsetKeyIndex>> newer;
+    RETURN_NOT_OK(self.init(rowset));
+    RETURN_NOT_OK(init_indexes(older_rowsets, &older));
+    RETURN_NOT_OK(init_indexes(newer_rowsets, &newer));
+    check_self = check_self && rowset->rowset_meta()->is_segments_overlapping();
+
+    const RowsetId& rowset_id = rowset->rowset_id();
+    int64_t version = rowset->end_version();
+    constexpr size_t batch_size = 1024;
+    std::vector<Slice> keys(batch_size);
+    MemPool pool("calc_delete_bitmap");
+    for (uint32_t seg_id = 0; seg_id < self.segments().size(); ++seg_id) {
+        const auto* pk_index = self.segments()[seg_id]->primary_key_index();
+        auto key_iter = pk_index->new_iterator();
+        for (uint32_t row_id = 0; row_id < pk_index->num_rows();) {
+            size_t num_keys = batch_size;
+            RETURN_NOT_OK(pk_index->read_keys(key_iter.get(), row_id, &num_keys, keys.data(),
+                                              &pool));
+            DCHECK_GT(num_keys, 0);
+            for (size_t i = 0; i < num_keys; ++i, ++row_id) {
+                uint32_t found_seg_id = 0;
+                uint32_t found_row_id = 0;
+                // overwrite the newest row with the same key
+                bool found = false;
+                if (check_self) {
+                    auto st = self.lookup(keys[i], seg_id, &found_seg_id, &found_row_id);
+                    if (!st.ok() && !st.is_not_found()) {
+                        return st;
+                    }
+                    if (st.ok()) {
+                        delete_bitmap->add({rowset_id, found_seg_id, version}, found_row_id);
+                        found = true;
+                    }
+                }
+                for (auto it = older.begin(); !found && it != older.end(); ++it) {
+                    auto st = (*it)->lookup(keys[i], &found_seg_id, &found_row_id);
+                    if (!st.ok() && !st.is_not_found()) {
+                        return st;
+                    }
+                    if (st.ok()) {
+                        delete_bitmap->add({(*it)->rowset()->rowset_id(), found_seg_id, version},
+                                           found_row_id);
+                        found = true;
+                    }
+                }
+                // be overwritten by the oldest newer row with the same key
+                for (auto& index : newer) {
+                    auto st = index->lookup(keys[i], &found_seg_id, &found_row_id);
+                    if (!st.ok() && !st.is_not_found()) {
+                        return st;
+                    }
+                    if (st.ok()) {
+                        delete_bitmap->add({rowset_id, seg_id, index->rowset()->end_version()},
+                                           row_id);
+                        break;
+                    }
+                }
+            }
+            pool.clear();
+        }
+    }
     return Status::OK();
 }
 
@@ -512,6 +777,9 @@ void Tablet::delete_expired_stale_rowset() {
             if (it != _stale_rs_version_map.end()) {
                 // delete rowset
                 StorageEngine::instance()->add_unused_rowset(it->second);
+                if (enable_unique_key_merge_on_write()) {
+                    _tablet_meta->delete_bitmap().remove_rowset(it->second->rowset_id());
+                }
                 _stale_rs_version_map.erase(it);
                 VLOG_NOTICE << "delete stale rowset tablet=" << full_name() << " version["
                             << timestampedVersion->version().first << ","
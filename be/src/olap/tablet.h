@@ -256,6 +256,21 @@ public:
         return _tablet_meta->all_beta();
     }
 
+    bool enable_unique_key_merge_on_write() const {
+        return _tablet_meta->enable_unique_key_merge_on_write();
+    }
+
+    DeleteBitmap& delete_bitmap() { return _tablet_meta->delete_bitmap(); }
+
+    // Merge the delete bitmap saved by add_inc_rowset() before restart, the bitmaps of the
+    // rowsets no longer in the tablet are dropped.
+    void merge_saved_delete_bitmap(const DeleteBitmap& delete_bitmap);
+
+    // Mark the rows of compaction output rowset which have been overwritten by the
+    // rowsets published while compacting. Only for merge-on-write tablet.
+    // caller should hold the _meta_lock before calling this method
+    Status update_delete_bitmap_after_compaction(const RowsetSharedPtr& output_rowset);
+
 private:
     Status _init_once_action();
     void _print_missed_versions(const std::vector<Version>& missed_versions) const;
@@ -274,6 +289,26 @@ private:
     Status _capture_consistent_rowsets_unlocked(const std::vector<Version>& version_path,
                                                 std::vector<RowsetSharedPtr>* rowsets) const;
 
+    // Look up every key of `rowset` in the primary key index of other rowsets, and mark
+    // the overwritten rows in `delete_bitmap`:
+    // - a key overwrites the row with the same key in the newest rowset of `older_rowsets`,
+    //   or in an earlier segment of `rowset` if its segments are overlapping.
+    // - a key is overwritten by the row with the same key in the oldest rowset of `newer_rowsets`.
+    // `older_rowsets` must be sorted by version descending, `newer_rowsets` ascending.
+    // The segments of `rowset` are not checked against each other if `check_self` is false.
+    Status _calc_delete_bitmap(const RowsetSharedPtr& rowset,
+                               const std::vector<RowsetSharedPtr>& older_rowsets,
+                               const std::vector<RowsetSharedPtr>& newer_rowsets,
+                               bool check_self, DeleteBitmap* delete_bitmap);
+
+    // Collect the rowsets of the tablet not in `excluded_rowsets` to look up the keys of
+    // `rowset` in, sorted as required by _calc_delete_bitmap().
+    // caller should hold the _meta_lock before calling this method
+    void _get_rowsets_to_check_keys(const RowsetSharedPtr& rowset,
+                                    const std::set<RowsetId>& excluded_rowsets,
+                                    std::vector<RowsetSharedPtr>* older_rowsets,
+                                    std::vector<RowsetSharedPtr>* newer_rowsets);
+
     const uint32_t _calc_cumulative_compaction_score(
             std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy);
     const uint32_t _calc_base_compaction_score() const;
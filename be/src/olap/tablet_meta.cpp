@@ -43,7 +43,9 @@ Status TabletMeta::create(const TCreateTabletReq& request, const TabletUid& tabl
             request.tablet_schema.schema_hash, shard_id, request.tablet_schema, next_unique_id,
             col_ordinal_to_unique_id, tablet_uid,
             request.__isset.tablet_type ? request.tablet_type : TTabletType::TABLET_TYPE_DISK,
-            request.storage_medium, request.storage_param.storage_name));
+            request.storage_medium, request.storage_param.storage_name,
+            request.__isset.enable_unique_key_merge_on_write &&
+                    request.enable_unique_key_merge_on_write));
     return Status::OK();
 }
 
@@ -54,7 +56,8 @@ TabletMeta::TabletMeta(int64_t table_id, int64_t partition_id, int64_t tablet_id
                        uint32_t next_unique_id,
                        const std::unordered_map<uint32_t, uint32_t>& col_ordinal_to_unique_id,
                        TabletUid tablet_uid, TTabletType::type tabletType,
-                       TStorageMedium::type t_storage_medium, const std::string& storage_name)
+                       TStorageMedium::type t_storage_medium, const std::string& storage_name,
+                       bool enable_unique_key_merge_on_write)
         : _tablet_uid(0, 0), _schema(new TabletSchema) {
     TabletMetaPB tablet_meta_pb;
     tablet_meta_pb.set_table_id(table_id);
@@ -71,6 +74,7 @@ TabletMeta::TabletMeta(int64_t table_id, int64_t partition_id, int64_t tablet_id
                                            : TabletTypePB::TABLET_TYPE_MEMORY);
     tablet_meta_pb.set_storage_medium(fs::fs_util::get_storage_medium_pb(t_storage_medium));
     tablet_meta_pb.set_remote_storage_name(storage_name);
+    tablet_meta_pb.set_enable_unique_key_merge_on_write(enable_unique_key_merge_on_write);
     TabletSchemaPB* schema = tablet_meta_pb.mutable_schema();
     schema->set_num_short_key_columns(tablet_schema.short_key_column_count);
     schema->set_num_rows_per_row_block(config::default_num_rows_per_column_file_block);
@@ -163,7 +167,9 @@ TabletMeta::TabletMeta(const TabletMeta& b)
           _stale_rs_metas(b._stale_rs_metas),
           _del_pred_array(b._del_pred_array),
           _in_restore_mode(b._in_restore_mode),
-          _preferred_rowset_type(b._preferred_rowset_type) {}
+          _preferred_rowset_type(b._preferred_rowset_type),
+          _enable_unique_key_merge_on_write(b._enable_unique_key_merge_on_write),
+          _delete_bitmap(b._delete_bitmap) {}
 
 void TabletMeta::_init_column_from_tcolumn(uint32_t unique_id, const TColumn& tcolumn,
                                            ColumnPB* column) {
@@ -407,6 +413,10 @@ void TabletMeta::init_from_pb(const TabletMetaPB& tablet_meta_pb) {
 
     _remote_storage_name = tablet_meta_pb.remote_storage_name();
     _storage_medium = tablet_meta_pb.storage_medium();
+    _enable_unique_key_merge_on_write = tablet_meta_pb.enable_unique_key_merge_on_write();
+    if (tablet_meta_pb.has_delete_bitmap()) {
+        _delete_bitmap.init_from_pb(tablet_meta_pb.delete_bitmap());
+    }
 }
 
 void TabletMeta::to_meta_pb(TabletMetaPB* tablet_meta_pb) {
@@ -454,6 +464,10 @@ void TabletMeta::to_meta_pb(TabletMetaPB* tablet_meta_pb) {
 
     tablet_meta_pb->set_remote_storage_name(_remote_storage_name);
     tablet_meta_pb->set_storage_medium(_storage_medium);
+    tablet_meta_pb->set_enable_unique_key_merge_on_write(_enable_unique_key_merge_on_write);
+    if (_enable_unique_key_merge_on_write) {
+        _delete_bitmap.to_pb(tablet_meta_pb->mutable_delete_bitmap());
+    }
 }
 
 uint32_t TabletMeta::mem_size() const {
@@ -669,6 +683,8 @@ bool operator==(const TabletMeta& a, const TabletMeta& b) {
     if (a._preferred_rowset_type != b._preferred_rowset_type) return false;
     if (a._storage_medium != b._storage_medium) return false;
     if (a._remote_storage_name != b._remote_storage_name) return false;
+    if (a._enable_unique_key_merge_on_write != b._enable_unique_key_merge_on_write) return false;
+    if (a._delete_bitmap != b._delete_bitmap) return false;
     return true;
 }
 
@@ -676,4 +692,144 @@ bool operator!=(const TabletMeta& a, const TabletMeta& b) {
     return !(a == b);
 }
 
+bool operator==(const DeleteBitmap& a, const DeleteBitmap& b) {
+    if (&a == &b) return true;
+    // copy one of them to avoid holding both of the locks
+    DeleteBitmap copy(a);
+    std::shared_lock l(b._lock);
+    return copy._delete_bitmap == b._delete_bitmap;
+}
+
+bool operator!=(const DeleteBitmap& a, const DeleteBitmap& b) {
+    return !(a == b);
+}
+
+DeleteBitmap::DeleteBitmap(const DeleteBitmap& other) {
+    std::shared_lock l(other._lock);
+    _delete_bitmap = other._delete_bitmap;
+}
+
+DeleteBitmap& DeleteBitmap::operator=(const DeleteBitmap& other) {
+    if (this != &other) {
+        auto copy = [&other] {
+            std::shared_lock l(other._lock);
+            return other._delete_bitmap;
+        }();
+        std::lock_guard l(_lock);
+        _delete_bitmap = std::move(copy);
+    }
+    return *this;
+}
+
+void DeleteBitmap::add(const BitmapKey& bmk, uint32_t row_id) {
+    std::lock_guard l(_lock);
+    _delete_bitmap[bmk].add(row_id);
+}
+
+void DeleteBitmap::merge(const BitmapKey& bmk, const roaring::Roaring& segment_delete_bitmap) {
+    std::lock_guard l(_lock);
+    _delete_bitmap[bmk] |= segment_delete_bitmap;
+}
+
+void DeleteBitmap::merge(const DeleteBitmap& other) {
+    std::shared_lock rl(other._lock);
+    std::lock_guard wl(_lock);
+    for (const auto& [bmk, bitmap] : other._delete_bitmap) {
+        _delete_bitmap[bmk] |= bitmap;
+    }
+}
+
+void DeleteBitmap::merge(const DeleteBitmap& other, const std::set<RowsetId>& rowset_ids) {
+    std::shared_lock rl(other._lock);
+    std::lock_guard wl(_lock);
+    for (const auto& [bmk, bitmap] : other._delete_bitmap) {
+        if (rowset_ids.count(std::get<0>(bmk)) > 0) {
+            _delete_bitmap[bmk] |= bitmap;
+        }
+    }
+}
+
+bool DeleteBitmap::contains_agg(const BitmapKey& bmk, uint32_t row_id) const {
+    const auto& [rowset_id, segment_id, version] = bmk;
+    std::shared_lock l(_lock);
+    for (auto it = _delete_bitmap.lower_bound({rowset_id, segment_id, 0});
+         it != _delete_bitmap.end(); ++it) {
+        const auto& [rs_id, seg_id, ver] = it->first;
+        if (rs_id != rowset_id || seg_id != segment_id || ver > version) {
+            break;
+        }
+        if (it->second.contains(row_id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::shared_ptr<roaring::Roaring> DeleteBitmap::get_agg(const BitmapKey& bmk) const {
+    const auto& [rowset_id, segment_id, version] = bmk;
+    std::shared_ptr<roaring::Roaring> result;
+    std::shared_lock l(_lock);
+    for (auto it = _delete_bitmap.lower_bound({rowset_id, segment_id, 0});
+         it != _delete_bitmap.end(); ++it) {
+        const auto& [rs_id, seg_id, ver] = it->first;
+        if (rs_id != rowset_id || seg_id != segment_id || ver > version) {
+            break;
+        }
+        if (result == nullptr) {
+            result = std::make_shared<roaring::Roaring>(it->second);
+        } else {
+            *result |= it->second;
+        }
+    }
+    return result;
+}
+
+void DeleteBitmap::remove_rowset(const RowsetId& rowset_id) {
+    std::lock_guard l(_lock);
+    auto it = _delete_bitmap.lower_bound({rowset_id, 0, 0});
+    while (it != _delete_bitmap.end() && std::get<0>(it->first) == rowset_id) {
+        it = _delete_bitmap.erase(it);
+    }
+}
+
+uint64_t DeleteBitmap::cardinality() const {
+    uint64_t res = 0;
+    std::shared_lock l(_lock);
+    for (const auto& it : _delete_bitmap) {
+        res += it.second.cardinality();
+    }
+    return res;
+}
+
+void DeleteBitmap::to_pb(DeleteBitmapPB* delete_bitmap_pb) const {
+    delete_bitmap_pb->Clear();
+    std::shared_lock l(_lock);
+    for (const auto& [bmk, bitmap] : _delete_bitmap) {
+        const auto& [rowset_id, segment_id, version] = bmk;
+        delete_bitmap_pb->add_rowset_ids(rowset_id.to_string());
+        delete_bitmap_pb->add_segment_ids(segment_id);
+        delete_bitmap_pb->add_versions(version);
+        std::string buf;
+        buf.resize(bitmap.getSizeInBytes());
+        bitmap.write(buf.data());
+        delete_bitmap_pb->add_segment_delete_bitmaps(std::move(buf));
+    }
+}
+
+void DeleteBitmap::init_from_pb(const DeleteBitmapPB& delete_bitmap_pb) {
+    int num_bitmaps = delete_bitmap_pb.rowset_ids_size();
+    DCHECK(delete_bitmap_pb.segment_ids_size() == num_bitmaps &&
+           delete_bitmap_pb.versions_size() == num_bitmaps &&
+           delete_bitmap_pb.segment_delete_bitmaps_size() == num_bitmaps);
+    std::lock_guard l(_lock);
+    _delete_bitmap.clear();
+    for (int i = 0; i < num_bitmaps; ++i) {
+        RowsetId rowset_id;
+        rowset_id.init(delete_bitmap_pb.rowset_ids(i));
+        BitmapKey bmk {rowset_id, delete_bitmap_pb.segment_ids(i), delete_bitmap_pb.versions(i)};
+        _delete_bitmap[bmk] =
+                roaring::Roaring::read(delete_bitmap_pb.segment_delete_bitmaps(i).data());
+    }
+}
+
 } // namespace doris
@@ -17,9 +17,13 @@
 
 #pragma once
 
+#include <map>
 #include <mutex>
+#include <roaring/roaring.hh>
+#include <set>
 #include <shared_mutex>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "common/logging.h"
@@ -67,6 +71,56 @@ class DataDir;
 class TabletMeta;
 using TabletMetaSharedPtr = std::shared_ptr<TabletMeta>;
 
+// Rows overwritten in a merge-on-write unique key tablet.
+//
+// A bitmap is kept for every (rowset, segment, version), where version is the
+// version of the load that overwrote these rows. So a reader of version v only
+// filters out the rows marked by loads whose version is not larger than v.
+// This class is thread-safe.
+class DeleteBitmap {
+public:
+    using SegmentId = uint32_t;
+    using BitmapKey = std::tuple<RowsetId, SegmentId, int64_t>;
+
+    DeleteBitmap() = default;
+    DeleteBitmap(const DeleteBitmap& other);
+    DeleteBitmap& operator=(const DeleteBitmap& other);
+
+    // mark row `row_id` as deleted
+    void add(const BitmapKey& bmk, uint32_t row_id);
+
+    // union `segment_delete_bitmap` into the bitmap of `bmk`
+    void merge(const BitmapKey& bmk, const roaring::Roaring& segment_delete_bitmap);
+
+    // union all the bitmaps of `other` into this one
+    void merge(const DeleteBitmap& other);
+
+    // union the bitmaps of `other` of the rowsets in `rowset_ids` into this one
+    void merge(const DeleteBitmap& other, const std::set<RowsetId>& rowset_ids);
+
+    // Whether the row is marked by any load whose version is not larger than the version of `bmk`
+    bool contains_agg(const BitmapKey& bmk, uint32_t row_id) const;
+
+    // Union of the bitmaps of the rowset and segment in `bmk`, whose version is not
+    // larger than the version of `bmk`. Return nullptr if no row is marked.
+    std::shared_ptr<roaring::Roaring> get_agg(const BitmapKey& bmk) const;
+
+    // drop all the bitmaps of rowset `rowset_id`, called when the rowset is removed
+    void remove_rowset(const RowsetId& rowset_id);
+
+    // total number of rows marked
+    uint64_t cardinality() const;
+
+    void to_pb(DeleteBitmapPB* delete_bitmap_pb) const;
+    void init_from_pb(const DeleteBitmapPB& delete_bitmap_pb);
+
+    friend bool operator==(const DeleteBitmap& a, const DeleteBitmap& b);
+
+private:
+    mutable std::shared_mutex _lock;
+    std::map<BitmapKey, roaring::Roaring> _delete_bitmap;
+};
+
 // Class encapsulates meta of tablet.
 // The concurrency control is handled in Tablet Class, not in this class.
 class TabletMeta {
@@ -83,7 +137,8 @@ public:
                uint64_t shard_id, const TTabletSchema& tablet_schema, uint32_t next_unique_id,
                const std::unordered_map<uint32_t, uint32_t>& col_ordinal_to_unique_id,
                TabletUid tablet_uid, TTabletType::type tabletType,
-               TStorageMedium::type t_storage_medium, const std::string& remote_storage_name);
+               TStorageMedium::type t_storage_medium, const std::string& remote_storage_name,
+               bool enable_unique_key_merge_on_write = false);
     // If need add a filed in TableMeta, filed init copy in copy construct function
     TabletMeta(const TabletMeta& tablet_meta);
     TabletMeta(TabletMeta&& tablet_meta) = delete;
@@ -175,6 +230,10 @@ public:
 
     StorageMediumPB storage_medium() const { return _storage_medium; }
 
+    bool enable_unique_key_merge_on_write() const { return _enable_unique_key_merge_on_write; }
+
+    DeleteBitmap& delete_bitmap() { return _delete_bitmap; }
+
 private:
     Status _save_meta(DataDir* data_dir);
     void _init_column_from_tcolumn(uint32_t unique_id, const TColumn& tcolumn, ColumnPB* column);
@@ -211,6 +270,9 @@ private:
     std::string _remote_storage_name;
     StorageMediumPB _storage_medium;
 
+    bool _enable_unique_key_merge_on_write = false;
+    DeleteBitmap _delete_bitmap;
+
     std::shared_mutex _meta_lock;
 };
 
@@ -329,5 +391,7 @@ inline bool TabletMeta::all_beta() const {
 // Only for unit test now.
 bool operator==(const TabletMeta& a, const TabletMeta& b);
 bool operator!=(const TabletMeta& a, const TabletMeta& b);
+bool operator==(const DeleteBitmap& a, const DeleteBitmap& b);
+bool operator!=(const DeleteBitmap& a, const DeleteBitmap& b);
 
 } // namespace doris
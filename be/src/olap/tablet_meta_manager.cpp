@@ -160,4 +160,61 @@ Status TabletMetaManager::load_json_meta(DataDir* store, const std::string& meta
     return save(store, tablet_id, schema_hash, meta_binary);
 }
 
+Status TabletMetaManager::save_delete_bitmap(DataDir* store, TTabletId tablet_id,
+                                             const RowsetId& rowset_id, int64_t version,
+                                             const DeleteBitmap& delete_bitmap) {
+    std::string key = fmt::format("{}{}_{}_{}", DELETE_BITMAP_PREFIX, tablet_id,
+                                  rowset_id.to_string(), version);
+    DeleteBitmapPB delete_bitmap_pb;
+    delete_bitmap.to_pb(&delete_bitmap_pb);
+    std::string value;
+    if (!delete_bitmap_pb.SerializeToString(&value)) {
+        return Status::OLAPInternalError(OLAP_ERR_SERIALIZE_PROTOBUF_ERROR);
+    }
+    OlapMeta* meta = store->get_meta();
+    VLOG_NOTICE << "save delete bitmap, key:" << key << ", size:" << value.length();
+    return meta->put(META_COLUMN_FAMILY_INDEX, key, value);
+}
+
+Status TabletMetaManager::get_delete_bitmap_keys(DataDir* store, TTabletId tablet_id,
+                                                 std::vector<std::string>* keys) {
+    std::string prefix = fmt::format("{}{}_", DELETE_BITMAP_PREFIX, tablet_id);
+    auto collect_key_func = [keys](const std::string& key, const std::string& value) -> bool {
+        keys->push_back(key);
+        return true;
+    };
+    return store->get_meta()->iterate(META_COLUMN_FAMILY_INDEX, prefix, collect_key_func);
+}
+
+Status TabletMetaManager::remove_delete_bitmaps(DataDir* store,
+                                                const std::vector<std::string>& keys) {
+    OlapMeta* meta = store->get_meta();
+    for (const auto& key : keys) {
+        RETURN_NOT_OK(meta->remove(META_COLUMN_FAMILY_INDEX, key));
+    }
+    return Status::OK();
+}
+
+Status TabletMetaManager::traverse_delete_bitmaps(
+        OlapMeta* meta,
+        std::function<bool(TTabletId, const std::string&, const DeleteBitmap&)> const& func) {
+    auto traverse_delete_bitmap_func = [&func](const std::string& key,
+                                               const std::string& value) -> bool {
+        // key format: "delete_bitmap_" + tablet_id + "_" + rowset_id + "_" + version
+        std::vector<std::string> parts;
+        split_string<char>(key.substr(DELETE_BITMAP_PREFIX.size()), '_', &parts);
+        DeleteBitmapPB delete_bitmap_pb;
+        if (parts.size() != 3 || !delete_bitmap_pb.ParseFromString(value)) {
+            LOG(WARNING) << "invalid delete bitmap, key:" << key;
+            return true;
+        }
+        TTabletId tablet_id = std::stol(parts[0].c_str(), nullptr, 10);
+        DeleteBitmap delete_bitmap;
+        delete_bitmap.init_from_pb(delete_bitmap_pb);
+        return func(tablet_id, key, delete_bitmap);
+    };
+    return meta->iterate(META_COLUMN_FAMILY_INDEX, DELETE_BITMAP_PREFIX,
+                         traverse_delete_bitmap_func);
+}
+
 } // namespace doris
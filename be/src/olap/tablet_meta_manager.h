@@ -17,7 +17,9 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
+#include <vector>
 
 #include "olap/data_dir.h"
 #include "olap/olap_define.h"
@@ -29,6 +31,8 @@ const std::string OLD_HEADER_PREFIX = "hdr_";
 
 const std::string HEADER_PREFIX = "tabletmeta_";
 
+const std::string DELETE_BITMAP_PREFIX = "delete_bitmap_";
+
 // Helper Class for managing tablet headers of one root path.
 class TabletMetaManager {
 public:
@@ -52,6 +56,25 @@ public:
                                    const string& header_prefix = "tabletmeta_");
 
     static Status load_json_meta(DataDir* store, const std::string& meta_path);
+
+    // Save the delete bitmap marked by the rowset `rowset_id` of `version` published to a
+    // merge-on-write tablet, so that a publish does not save the whole tablet meta. The bitmaps
+    // are merged into the tablet when it is loaded, and removed after the tablet meta is saved.
+    static Status save_delete_bitmap(DataDir* store, TTabletId tablet_id,
+                                     const RowsetId& rowset_id, int64_t version,
+                                     const DeleteBitmap& delete_bitmap);
+
+    // Get the keys of the delete bitmaps of the tablet saved by save_delete_bitmap().
+    static Status get_delete_bitmap_keys(DataDir* store, TTabletId tablet_id,
+                                         std::vector<std::string>* keys);
+
+    static Status remove_delete_bitmaps(DataDir* store, const std::vector<std::string>& keys);
+
+    // Call `func` with the tablet id, the key and the delete bitmap of every delete bitmap
+    // saved by save_delete_bitmap().
+    static Status traverse_delete_bitmaps(
+            OlapMeta* meta,
+            std::function<bool(TTabletId, const std::string&, const DeleteBitmap&)> const& func);
 };
 
 } // namespace doris
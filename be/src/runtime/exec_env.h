@@ -49,8 +49,8 @@ class MemTracker;
 class StorageEngine;
 class MemTrackerTaskPool;
 class PriorityThreadPool;
-class PriorityWorkStealingThreadPool;
 class ReservationTracker;
+class ScanScheduler;
 class ResultBufferMgr;
 class ResultQueueMgr;
 class TMasterInfo;
@@ -125,10 +125,14 @@ public:
         return _task_pool_mem_tracker_registry.get();
     }
     ThreadResourceMgr* thread_mgr() { return _thread_mgr; }
-    PriorityThreadPool* scan_thread_pool() { return _scan_thread_pool; }
+    ScanScheduler* scan_scheduler() { return _scan_scheduler; }
     ThreadPool* limited_scan_thread_pool() { return _limited_scan_thread_pool.get(); }
     PriorityThreadPool* etl_thread_pool() { return _etl_thread_pool; }
     ThreadPool* send_batch_thread_pool() { return _send_batch_thread_pool.get(); }
+    ThreadPool* segment_prefetch_thread_pool() { return _segment_prefetch_thread_pool.get(); }
+    void set_segment_prefetch_thread_pool(std::unique_ptr<ThreadPool> pool) {
+        _segment_prefetch_thread_pool = std::move(pool);
+    }
     CgroupsMgr* cgroups_mgr() { return _cgroups_mgr; }
     FragmentMgr* fragment_mgr() { return _fragment_mgr; }
     ResultCache* result_cache() { return _result_cache; }
@@ -194,20 +198,21 @@ private:
     std::shared_ptr<MemTracker> _load_pool_mem_tracker = nullptr;
     std::unique_ptr<MemTrackerTaskPool> _task_pool_mem_tracker_registry;
 
-    // The following two thread pools are used in different scenarios.
-    // _scan_thread_pool is a priority thread pool.
-    // Scanner threads for common queries will use this thread pool,
-    // and the priority of each scan task is set according to the size of the query.
+    // The following two are used for scanners in different scenarios.
+    // _scan_scheduler runs the olap scanners of common queries, it shares the scanner
+    // threads among queries according to the cpu time they used.
 
     // _limited_scan_thread_pool is also the thread pool used for scanner.
     // The difference is that it is no longer a priority queue, but according to the concurrency
     // set by the user to control the number of threads that can be used by a query.
 
     // TODO(cmy): find a better way to unify these 2 pools.
-    PriorityThreadPool* _scan_thread_pool = nullptr;
+    ScanScheduler* _scan_scheduler = nullptr;
     std::unique_ptr<ThreadPool> _limited_scan_thread_pool;
 
     std::unique_ptr<ThreadPool> _send_batch_thread_pool;
+    // used to read segment pages ahead of the scanner threads
+    std::unique_ptr<ThreadPool> _segment_prefetch_thread_pool;
     PriorityThreadPool* _etl_thread_pool = nullptr;
     CgroupsMgr* _cgroups_mgr = nullptr;
     FragmentMgr* _fragment_mgr = nullptr;
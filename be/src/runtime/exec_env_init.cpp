@@ -44,6 +44,7 @@
 #include "runtime/mem_tracker_task_pool.h"
 #include "runtime/result_buffer_mgr.h"
 #include "runtime/result_queue_mgr.h"
+#include "runtime/scan_scheduler.h"
 #include "runtime/routine_load/routine_load_task_executor.h"
 #include "runtime/small_file_mgr.h"
 #include "runtime/stream_load/load_stream_mgr.h"
@@ -52,13 +53,13 @@
 #include "runtime/tmp_file_mgr.h"
 #include "util/bfd_parser.h"
 #include "util/brpc_client_cache.h"
+#include "util/cpu_info.h"
 #include "util/doris_metrics.h"
 #include "util/mem_info.h"
 #include "util/metrics.h"
 #include "util/parse_util.h"
 #include "util/pretty_printer.h"
 #include "util/priority_thread_pool.hpp"
-#include "util/priority_work_stealing_thread_pool.hpp"
 #include "vec/runtime/vdata_stream_mgr.h"
 
 namespace doris {
@@ -99,18 +100,16 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
             new ExtDataSourceServiceClientCache(config::max_client_cache_size_per_host);
     _task_pool_mem_tracker_registry.reset(new MemTrackerTaskPool());
     _thread_mgr = new ThreadResourceMgr();
-    if (config::doris_enable_scanner_thread_pool_per_disk &&
-        config::doris_scanner_thread_pool_thread_num >= store_paths.size() &&
-        store_paths.size() > 0) {
-        _scan_thread_pool = new PriorityWorkStealingThreadPool(
-                config::doris_scanner_thread_pool_thread_num, store_paths.size(),
-                config::doris_scanner_thread_pool_queue_size);
-        LOG(INFO) << "scan thread pool use PriorityWorkStealingThreadPool";
-    } else {
-        _scan_thread_pool = new PriorityThreadPool(config::doris_scanner_thread_pool_thread_num,
-                                                   config::doris_scanner_thread_pool_queue_size);
-        LOG(INFO) << "scan thread pool use PriorityThreadPool";
-    }
+
+    // The olap scanners of both engines run on the threads of the scan scheduler.
+    uint32_t scan_queue_num = config::doris_scan_scheduler_queue_num > 0
+                                      ? config::doris_scan_scheduler_queue_num
+                                      : CpuInfo::num_cores();
+    scan_queue_num = std::max(1, std::min<int>(scan_queue_num,
+                                               config::doris_scanner_thread_pool_thread_num));
+    _scan_scheduler = new ScanScheduler(config::doris_scanner_thread_pool_thread_num,
+                                        scan_queue_num,
+                                        config::doris_scanner_thread_pool_queue_size);
 
     ThreadPoolBuilder("LimitedScanThreadPool")
             .set_min_threads(1)
@@ -124,6 +123,12 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
             .set_max_queue_size(config::send_batch_thread_pool_queue_size)
             .build(&_send_batch_thread_pool);
 
+    ThreadPoolBuilder("SegmentPrefetchThreadPool")
+            .set_min_threads(1)
+            .set_max_threads(config::segment_prefetch_thread_pool_thread_num)
+            .set_max_queue_size(config::segment_prefetch_thread_pool_queue_size)
+            .build(&_segment_prefetch_thread_pool);
+
     _etl_thread_pool = new PriorityThreadPool(config::etl_thread_pool_size,
                                               config::etl_thread_pool_queue_size);
     _cgroups_mgr = new CgroupsMgr(this, config::doris_cgroups);
@@ -255,10 +260,26 @@ Status ExecEnv::_init_mem_tracker() {
         storage_cache_limit = storage_cache_limit / 2;
     }
     int32_t index_page_cache_percentage = config::index_page_cache_percentage;
-    StoragePageCache::create_global_cache(storage_cache_limit, index_page_cache_percentage);
+    int64_t compressed_cache_limit = ParseUtil::parse_mem_spec(
+            config::storage_compressed_page_cache_limit, global_memory_limit_bytes,
+            MemInfo::physical_mem(), &is_percent);
+    while (!is_percent && compressed_cache_limit > global_memory_limit_bytes / 2) {
+        // Reason same as buffer_pool_limit
+        compressed_cache_limit = compressed_cache_limit / 2;
+    }
+    compressed_cache_limit = std::max<int64_t>(compressed_cache_limit, 0);
+    if (config::disable_storage_page_cache) {
+        // the compressed pages are not cached either
+        compressed_cache_limit = 0;
+    }
+    StoragePageCache::create_global_cache(storage_cache_limit, index_page_cache_percentage,
+                                          compressed_cache_limit);
     LOG(INFO) << "Storage page cache memory limit: "
               << PrettyPrinter::print(storage_cache_limit, TUnit::BYTES)
-              << ", origin config value: " << config::storage_page_cache_limit;
+              << ", origin config value: " << config::storage_page_cache_limit
+              << ". compressed page cache memory limit: "
+              << PrettyPrinter::print(compressed_cache_limit, TUnit::BYTES)
+              << ", origin config value: " << config::storage_compressed_page_cache_limit;
 
     SegmentLoader::create_global_instance(config::segment_cache_capacity);
 
@@ -281,7 +302,7 @@ void ExecEnv::_init_buffer_pool(int64_t min_page_size, int64_t capacity,
 
 void ExecEnv::_register_metrics() {
     REGISTER_HOOK_METRIC(scanner_thread_pool_queue_size,
-                         [this]() { return _scan_thread_pool->get_queue_size(); });
+                         [this]() { return _scan_scheduler->get_queue_size(); });
 
     REGISTER_HOOK_METRIC(etl_thread_pool_queue_size,
                          [this]() { return _etl_thread_pool->get_queue_size(); });
@@ -320,7 +341,7 @@ void ExecEnv::_destroy() {
     SAFE_DELETE(_fragment_mgr);
     SAFE_DELETE(_cgroups_mgr);
     SAFE_DELETE(_etl_thread_pool);
-    SAFE_DELETE(_scan_thread_pool);
+    SAFE_DELETE(_scan_scheduler);
     SAFE_DELETE(_thread_mgr);
     SAFE_DELETE(_broker_client_cache);
     SAFE_DELETE(_extdatasource_client_cache);
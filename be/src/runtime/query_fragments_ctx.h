@@ -90,7 +90,7 @@ private:
     // This thread pool token is created from "_limited_scan_thread_pool" from exec env.
     // And will be shared by all instances of this query.
     // So that we can control the max thread that a query can be used to execute.
-    // If this token is not set, the scanner will be executed in "_scan_thread_pool" in exec env.
+    // If this token is not set, the scanner will be executed by the "_scan_scheduler" in exec env.
     std::unique_ptr<ThreadPoolToken> _thread_token;
 };
 
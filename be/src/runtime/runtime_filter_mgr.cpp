@@ -201,6 +201,11 @@ Status RuntimeFilterMergeControllerEntity::merge(const PMergeFilterRequest* requ
             return Status::InvalidArgument("unknown filter id");
         }
         cntVal = iter->second;
+        if (cntVal->published) {
+            // an ignored filter has been published ahead, the rest producers change nothing
+            cntVal->arrive_id.insert(UniqueId(request->fragment_id()).to_string());
+            return Status::OK();
+        }
         SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(cntVal->tracker);
         MergeRuntimeFilterParams params;
         params.data = data;
@@ -214,12 +219,22 @@ Status RuntimeFilterMergeControllerEntity::merge(const PMergeFilterRequest* requ
         // TODO: avoid log when we had acquired a lock
         VLOG_ROW << "merge size:" << merged_size << ":" << cntVal->producer_size;
         DCHECK_LE(merged_size, cntVal->producer_size);
-        if (merged_size < cntVal->producer_size) {
+        // Once the merged filter is ignored, e.g. the IN filter has too many values, it stays
+        // ignored whatever the rest producers send. Publish it at once so that the targets
+        // stop waiting for it and start scanning.
+        // Filters which can still prune are published after all the producers arrive, since
+        // a filter built from part of the producers would drop rows the others match.
+        if (merged_size < cntVal->producer_size && !cntVal->filter->is_ignored()) {
             return Status::OK();
         }
+        cntVal->published = true;
+        if (merged_size == cntVal->producer_size) {
+            // no more merge, the bloom filter can be shrunk to the real number of values
+            cntVal->filter->fold_bloom_filter();
+        }
     }
 
-    if (merged_size == cntVal->producer_size) {
+    {
         // prepare rpc context
         using PPublishFilterRpcContext =
                 async_rpc_context<PPublishFilterRequest, PPublishFilterResponse>;
@@ -130,6 +130,8 @@ private:
         std::vector<doris::TRuntimeFilterTargetParams> target_info;
         IRuntimeFilter* filter;
         std::unordered_set<std::string> arrive_id; // fragment_instance_id ?
+        // set when the filter is sent to the targets, maybe before all the producers arrive
+        bool published = false;
         std::shared_ptr<MemTracker> tracker;
         std::shared_ptr<ObjectPool> pool;
     };
@@ -331,6 +331,10 @@ public:
         return _query_options.return_object_data_as_binary;
     }
 
+    const std::string& fragment_transmission_compression_codec() const {
+        return _query_options.fragment_transmission_compression_codec;
+    }
+
     bool enable_exchange_node_parallel_merge() const {
         return _query_options.enable_enable_exchange_node_parallel_merge;
     }
@@ -0,0 +1,125 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/scan_scheduler.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "gutil/strings/numbers.h"
+#include "gutil/strings/split.h"
+#include "gutil/strings/strip.h"
+#include "util/stopwatch.hpp"
+
+namespace doris {
+
+static constexpr int DEFAULT_GROUP_WEIGHT = 10;
+// one level of priority per millisecond of weighted cpu time
+static constexpr int64_t NS_PER_PRIORITY = 1000 * 1000;
+// tasks more than this behind the others all get the lowest priority
+static constexpr int64_t MAX_PRIORITY_DELTA = 1 << 20;
+
+ScanScheduler::ScanScheduler(uint32_t num_threads, uint32_t num_queues, uint32_t queue_size)
+        : _num_threads(num_threads),
+          _num_queues(num_queues),
+          _pool(num_threads, num_queues, queue_size) {
+    for (auto& item : strings::Split(config::doris_scan_scheduler_group_weights, ",",
+                                     strings::SkipWhitespace())) {
+        std::vector<std::string> kv = strings::Split(item, ":");
+        int32_t weight = 0;
+        if (kv.size() == 2) {
+            StripWhiteSpace(&kv[0]);
+            StripWhiteSpace(&kv[1]);
+        }
+        if (kv.size() != 2 || !safe_strto32(kv[1], &weight) || weight <= 0) {
+            LOG(WARNING) << "invalid scan scheduler group weight: " << item;
+            continue;
+        }
+        _group_weights[kv[0]] = weight;
+    }
+    LOG(INFO) << "scan scheduler started, threads: " << num_threads << ", queues: " << num_queues;
+}
+
+ScanScheduler::~ScanScheduler() {
+    shutdown();
+}
+
+void ScanScheduler::shutdown() {
+    _pool.shutdown();
+    _pool.join();
+}
+
+int ScanScheduler::group_weight(const std::string& group) const {
+    auto it = _group_weights.find(group);
+    return it == _group_weights.end() ? DEFAULT_GROUP_WEIGHT : it->second;
+}
+
+std::shared_ptr<ScanQueryShare> ScanScheduler::get_or_create_share(const TUniqueId& query_id,
+                                                                   const std::string& group) {
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = _shares.find(query_id);
+    if (it != _shares.end()) {
+        auto share = it->second.lock();
+        if (share != nullptr) {
+            return share;
+        }
+    }
+
+    // drop the finished queries and find the smallest vruntime of the running ones
+    int64_t min_vruntime = std::numeric_limits<int64_t>::max();
+    for (auto iter = _shares.begin(); iter != _shares.end();) {
+        auto share = iter->second.lock();
+        if (share == nullptr) {
+            iter = _shares.erase(iter);
+        } else {
+            min_vruntime = std::min(min_vruntime, share->vruntime_ns());
+            ++iter;
+        }
+    }
+    if (min_vruntime != std::numeric_limits<int64_t>::max()) {
+        _base_vruntime_ns = std::max(_base_vruntime_ns.load(), min_vruntime);
+    }
+
+    auto share =
+            std::make_shared<ScanQueryShare>(query_id, group_weight(group), _base_vruntime_ns);
+    _shares[query_id] = share;
+    return share;
+}
+
+int ScanScheduler::_priority(const ScanQueryShare& share) const {
+    // the larger the priority the earlier the task runs
+    int64_t delta = (share.vruntime_ns() - _base_vruntime_ns) / NS_PER_PRIORITY;
+    return -static_cast<int>(std::clamp<int64_t>(delta, 0, MAX_PRIORITY_DELTA));
+}
+
+bool ScanScheduler::submit(const std::shared_ptr<ScanQueryShare>& share, WorkFunction func,
+                           uint32_t queue_hint) {
+    PriorityThreadPool::Task task;
+    task.priority = _priority(*share);
+    task.queue_id = queue_hint % _num_queues;
+    task.work_function = [share, func = std::move(func)]() {
+        ThreadCpuStopWatch cpu_watch;
+        cpu_watch.start();
+        func();
+        share->consume(cpu_watch.elapsed_time());
+    };
+    return _pool.offer(std::move(task));
+}
+
+} // namespace doris
@@ -0,0 +1,114 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "gen_cpp/Types_types.h"
+#include "util/hash_util.hpp"
+#include "util/priority_work_stealing_thread_pool.hpp"
+
+namespace doris {
+
+// The scan time a query has consumed in the ScanScheduler.
+// Shared by all the scan nodes of the query on this backend.
+class ScanQueryShare {
+public:
+    ScanQueryShare(const TUniqueId& query_id, int weight, int64_t vruntime_ns)
+            : _query_id(query_id), _weight(weight), _vruntime_ns(vruntime_ns) {}
+
+    const TUniqueId& query_id() const { return _query_id; }
+    int weight() const { return _weight; }
+
+    // cpu time consumed divided by the weight of the query
+    int64_t vruntime_ns() const { return _vruntime_ns.load(std::memory_order_relaxed); }
+
+    void consume(int64_t cpu_time_ns) {
+        _vruntime_ns.fetch_add(cpu_time_ns / _weight, std::memory_order_relaxed);
+    }
+
+private:
+    const TUniqueId _query_id;
+    const int _weight;
+    std::atomic<int64_t> _vruntime_ns;
+};
+
+// Scheduler of the olap scanners, of both the vectorized and the row based scan node.
+//
+// Scan tasks are put on per-core local queues of a PriorityWorkStealingThreadPool, idle
+// threads steal from the other queues. The priority of a task is decided by the cpu time
+// its query has used so far, weighted by the resource group of the query, so a query which
+// consumed less gets the next free thread, like the CFS scheduler of linux. A new query
+// starts from the smallest vruntime of the running queries, so it neither starves the
+// running ones nor waits behind them.
+//
+// The scanners give up the thread after a row, byte or time budget, see
+// VOlapScanNode::scanner_thread, which makes the shares effective.
+class ScanScheduler {
+public:
+    using WorkFunction = PriorityThreadPool::WorkFunction;
+
+    ScanScheduler(uint32_t num_threads, uint32_t num_queues, uint32_t queue_size);
+    ~ScanScheduler();
+
+    // Return the share of query `query_id`, create it if this is the first scan of the query.
+    // The share is dropped when all the scan nodes of the query release it.
+    std::shared_ptr<ScanQueryShare> get_or_create_share(const TUniqueId& query_id,
+                                                        const std::string& group);
+
+    // Put `func` on the local queue `queue_hint` % num_queues(). The cpu time `func` uses
+    // is charged to `share`. Return false if the scheduler is shut down.
+    bool submit(const std::shared_ptr<ScanQueryShare>& share, WorkFunction func,
+                uint32_t queue_hint);
+
+    // Local queue for a new scanner, round robin over the queues.
+    uint32_t next_queue_id() { return _next_queue_id.fetch_add(1, std::memory_order_relaxed); }
+
+    uint32_t num_queues() const { return _num_queues; }
+
+    uint32_t num_threads() const { return _num_threads; }
+
+    uint32_t get_queue_size() const { return _pool.get_queue_size(); }
+
+    void shutdown();
+
+    int group_weight(const std::string& group) const;
+
+private:
+    int _priority(const ScanQueryShare& share) const;
+
+    const uint32_t _num_threads;
+    const uint32_t _num_queues;
+    std::atomic<uint32_t> _next_queue_id {0};
+
+    std::unordered_map<std::string, int> _group_weights;
+
+    // Guards _shares and _base_vruntime_ns
+    mutable std::mutex _lock;
+    std::unordered_map<TUniqueId, std::weak_ptr<ScanQueryShare>> _shares;
+    // the smallest vruntime of the running queries when the last query came
+    std::atomic<int64_t> _base_vruntime_ns {0};
+
+    PriorityWorkStealingThreadPool _pool;
+};
+
+} // namespace doris
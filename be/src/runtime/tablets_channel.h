@@ -200,11 +200,14 @@ Status TabletsChannel::add_batch(const TabletWriterAddRequest& request,
         if constexpr (std::is_same_v<TabletWriterAddRequest, PTabletWriterAddBatchRequest>) {
             return RowBatch(*_row_desc, request.row_batch());
         } else {
-            return vectorized::Block(request.block());
+            return vectorized::Block();
         }
     };
 
     auto send_data = get_send_data();
+    if constexpr (!std::is_same_v<TabletWriterAddRequest, PTabletWriterAddBatchRequest>) {
+        RETURN_IF_ERROR(send_data.deserialize(request.block()));
+    }
     google::protobuf::RepeatedPtrField<PTabletError>* tablet_errors =
             response->mutable_tablet_errors();
     for (const auto& tablet_to_rowidxs_it : tablet_to_rowidxs) {
@@ -22,6 +22,7 @@
 #include <snappy/snappy-sinksource.h>
 #include <snappy/snappy.h>
 #include <zlib.h>
+#include <zstd.h>
 
 #include <limits>
 
@@ -369,6 +370,39 @@ public:
     }
 };
 
+class ZstdBlockCompression : public BlockCompressionCodec {
+public:
+    static const ZstdBlockCompression* instance() {
+        static ZstdBlockCompression s_instance;
+        return &s_instance;
+    }
+    ~ZstdBlockCompression() override {}
+
+    Status compress(const Slice& input, Slice* output) const override {
+        auto compressed_len = ZSTD_compress(output->data, output->size, input.data, input.size,
+                                            ZSTD_CLEVEL_DEFAULT);
+        if (ZSTD_isError(compressed_len)) {
+            return Status::InvalidArgument(strings::Substitute(
+                    "Fail to do ZSTD compress, error=$0", ZSTD_getErrorName(compressed_len)));
+        }
+        output->size = compressed_len;
+        return Status::OK();
+    }
+
+    Status decompress(const Slice& input, Slice* output) const override {
+        auto decompressed_len =
+                ZSTD_decompress(output->data, output->size, input.data, input.size);
+        if (ZSTD_isError(decompressed_len)) {
+            return Status::InvalidArgument(strings::Substitute(
+                    "Fail to do ZSTD decompress, error=$0", ZSTD_getErrorName(decompressed_len)));
+        }
+        output->size = decompressed_len;
+        return Status::OK();
+    }
+
+    size_t max_compressed_len(size_t len) const override { return ZSTD_compressBound(len); }
+};
+
 Status get_block_compression_codec(segment_v2::CompressionTypePB type,
                                    const BlockCompressionCodec** codec) {
     switch (type) {
@@ -387,6 +421,9 @@ Status get_block_compression_codec(segment_v2::CompressionTypePB type,
     case segment_v2::CompressionTypePB::ZLIB:
         *codec = ZlibBlockCompression::instance();
         break;
+    case segment_v2::CompressionTypePB::ZSTD:
+        *codec = ZstdBlockCompression::instance();
+        break;
     default:
         return Status::NotFound(strings::Substitute("unknown compression type($0)", type));
     }
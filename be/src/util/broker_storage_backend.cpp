@@ -100,6 +100,15 @@ Status BrokerStorageBackend::direct_download(const std::string& remote, std::str
     return Status::IOError("broker direct_download not support ");
 }
 
+Status BrokerStorageBackend::direct_download_range(const std::string& remote, uint64_t offset,
+                                                   size_t length, std::string* content) {
+    return Status::IOError("broker direct_download_range not support ");
+}
+
+Status BrokerStorageBackend::file_size(const std::string& remote, uint64_t* size) {
+    return Status::IOError("broker file_size not support ");
+}
+
 Status BrokerStorageBackend::upload(const std::string& local, const std::string& remote) {
     // read file and write to broker
     FileHandler file_handler;
@@ -170,6 +170,9 @@ DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(disk_sync_total, MetricUnit::OPERATIONS);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(blocks_open_reading, MetricUnit::BLOCKS);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(blocks_open_writing, MetricUnit::BLOCKS);
 
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(remote_block_cache_hit_bytes_total, MetricUnit::BYTES);
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(remote_block_cache_download_bytes_total, MetricUnit::BYTES);
+
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(query_cache_memory_total_byte, MetricUnit::BYTES);
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(query_cache_sql_total_count, MetricUnit::NOUNIT);
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(query_cache_partition_total_count, MetricUnit::NOUNIT);
@@ -281,6 +284,9 @@ DorisMetrics::DorisMetrics() : _metric_registry(_s_registry_name) {
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, blocks_open_reading);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, blocks_open_writing);
 
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, remote_block_cache_hit_bytes_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, remote_block_cache_download_bytes_total);
+
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, load_rows);
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, load_bytes);
 
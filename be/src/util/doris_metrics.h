@@ -171,6 +171,11 @@ public:
     IntGauge* blocks_open_reading;
     IntGauge* blocks_open_writing;
 
+    // Metrics related with the local cache of the remote storage, the hit ratio is exported
+    // by the LRU cache "RemoteBlockCache"
+    IntCounter* remote_block_cache_hit_bytes_total;
+    IntCounter* remote_block_cache_download_bytes_total;
+
     // Size of some global containers
     UIntGauge* rowset_count_generated_and_in_use;
     UIntGauge* unused_rowsets_count;
@@ -107,6 +107,50 @@ Status S3StorageBackend::direct_download(const std::string& remote, std::string*
     return Status::OK();
 }
 
+Status S3StorageBackend::direct_download_range(const std::string& remote, uint64_t offset,
+                                               size_t length, std::string* content) {
+    CHECK_S3_CLIENT(_client);
+    CHECK_S3_PATH(uri, remote);
+    if (length == 0) {
+        content->clear();
+        return Status::OK();
+    }
+    Aws::S3::Model::GetObjectRequest request;
+    request.WithBucket(uri.get_bucket()).WithKey(uri.get_key());
+    std::stringstream range;
+    range << "bytes=" << offset << "-" << offset + length - 1;
+    request.SetRange(range.str());
+    Aws::S3::Model::GetObjectOutcome response = _client->GetObject(request);
+    if (response.IsSuccess()) {
+        std::stringstream ss;
+        ss << response.GetResult().GetBody().rdbuf();
+        *content = ss.str();
+    } else if (response.GetError().GetResponseCode() ==
+               Aws::Http::HttpResponseCode::REQUESTED_RANGE_NOT_SATISFIABLE) {
+        // the range starts after the end of the file
+        content->clear();
+    } else {
+        return Status::IOError("s3 direct_download_range error: " + error_msg(response));
+    }
+    return Status::OK();
+}
+
+Status S3StorageBackend::file_size(const std::string& remote, uint64_t* size) {
+    CHECK_S3_CLIENT(_client);
+    CHECK_S3_PATH(uri, remote);
+    Aws::S3::Model::HeadObjectRequest request;
+    request.WithBucket(uri.get_bucket()).WithKey(uri.get_key());
+    Aws::S3::Model::HeadObjectOutcome response = _client->HeadObject(request);
+    if (response.IsSuccess()) {
+        *size = response.GetResult().GetContentLength();
+        return Status::OK();
+    } else if (response.GetError().GetResponseCode() == Aws::Http::HttpResponseCode::NOT_FOUND) {
+        return Status::NotFound(remote + " not exists!");
+    } else {
+        return Status::InternalError(error_msg(response));
+    }
+}
+
 Status S3StorageBackend::upload(const std::string& local, const std::string& remote) {
     CHECK_S3_CLIENT(_client);
     CHECK_S3_PATH(uri, remote);
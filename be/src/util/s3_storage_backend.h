@@ -33,6 +33,9 @@ public:
     ~S3StorageBackend();
     Status download(const std::string& remote, const std::string& local) override;
     Status direct_download(const std::string& remote, std::string* content) override;
+    Status direct_download_range(const std::string& remote, uint64_t offset, size_t length,
+                                 std::string* content) override;
+    Status file_size(const std::string& remote, uint64_t* size) override;
     Status upload(const std::string& local, const std::string& remote) override;
     Status upload_with_checksum(const std::string& local, const std::string& remote,
                                 const std::string& checksum) override;
@@ -55,5 +55,28 @@ inline uint32_t bytes32_mask_to_bits32_mask(const bool* data) {
     return bytes32_mask_to_bits32_mask(reinterpret_cast<const uint8_t*>(data));
 }
 
+/// Transform the 32 bytes equal to `c` to a 32-bit mask
+inline uint32_t bytes32_eq_to_bits32_mask(const char* data, char c) {
+#ifdef __AVX2__
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)), _mm256_set1_epi8(c))));
+#elif __SSE2__
+    auto c16 = _mm_set1_epi8(c);
+    uint32_t mask =
+            (static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), c16)))) |
+            ((static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                      _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), c16)))
+              << 16) &
+             0xffff0000);
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < 32; ++i) {
+        mask |= static_cast<uint32_t>(c == *(data + i)) << i;
+    }
+#endif
+    return mask;
+}
+
 } // namespace simd
 } // namespace doris
\ No newline at end of file
@@ -31,6 +31,11 @@ class StorageBackend {
 public:
     virtual Status download(const std::string& remote, const std::string& local) = 0;
     virtual Status direct_download(const std::string& remote, std::string* content) = 0;
+    // Download at most `length` bytes at `offset` of the remote file, `content` is shorter than
+    // `length` if the file ends before.
+    virtual Status direct_download_range(const std::string& remote, uint64_t offset,
+                                         size_t length, std::string* content) = 0;
+    virtual Status file_size(const std::string& remote, uint64_t* size) = 0;
     virtual Status upload(const std::string& local, const std::string& remote) = 0;
     virtual Status upload_with_checksum(const std::string& local, const std::string& remote,
                                         const std::string& checksum) = 0;
@@ -20,6 +20,7 @@
 #include <parallel_hashmap/phmap.h>
 
 #include <algorithm>
+#include <memory>
 
 #include "gutil/hash/string_hash.h"
 #include "olap/decimal12.h"
@@ -50,7 +51,11 @@ namespace doris::vectorized {
  * contents, convert the encoding column, and then compare the encoding directly.
  * If the read data page contains plain-encoded data pages, the dictionary
  * columns are converted into PredicateColumn for processing.
- * Currently ColumnDictionary is only used for storage layer.
+ * ColumnDictionary is mostly used in the storage layer, the codes are decoded to
+ * strings in bulk, by filter_by_selector(), before the block leaves the segment
+ * iterator. The columns asked by StorageReadOptions::dict_code_columns are output as
+ * codes instead, see clone_codes_by_selector(), and decoded by the scanner after its
+ * equality and IN filters are evaluated on the codes, see VDictCodeFilter.
  */
 template <typename T>
 class ColumnDictionary final : public COWHelper<IColumn, ColumnDictionary<T>> {
@@ -108,7 +113,7 @@ public:
     void clear() override {
         _codes.clear();
         _dict_code_converted = false;
-        _dict.clear_hash_values();
+        _dict->clear_hash_values();
     }
 
     // TODO: Make dict memory usage more precise
@@ -197,14 +202,29 @@ public:
         LOG(FATAL) << "scatter not supported in ColumnDictionary";
     }
 
+    // A column of the codes of the rows in `sel`, which shares the dictionary with this column.
+    // The strings of the dictionary point into the dictionary page of the segment, so the
+    // result must be decoded before the next batch is read from the segment.
+    MutableColumnPtr clone_codes_by_selector(const uint16_t* sel, size_t sel_size) const {
+        auto res = ColumnDictionary::create();
+        res->_dict = _dict;
+        res->_dict_inited = _dict_inited;
+        res->_dict_sorted = _dict_sorted;
+        res->_dict_code_converted = _dict_code_converted;
+        res->_codes.resize(sel_size);
+        for (size_t i = 0; i < sel_size; ++i) {
+            res->_codes[i] = _codes[sel[i]];
+        }
+        return res;
+    }
+
+    // The strings are only materialized here, for the rows that survive the predicates.
     Status filter_by_selector(const uint16_t* sel, size_t sel_size, IColumn* col_ptr) override {
         auto* res_col = reinterpret_cast<vectorized::ColumnString*>(col_ptr);
-        for (size_t i = 0; i < sel_size; i++) {
-            uint16_t n = sel[i];
-            auto& code = reinterpret_cast<T&>(_codes[n]);
-            auto value = _dict.get_value(code);
-            res_col->insert_data(value.ptr, value.len);
-        }
+        res_col->insert_many_strings(sel_size, [&](size_t i) {
+            const auto& value = _dict->get_value(_codes[sel[i]]);
+            return StringRef(value.ptr, value.len);
+        });
         return Status::OK();
     }
 
@@ -220,10 +240,10 @@ public:
                                const StringRef* dict_array, size_t data_num,
                                uint32_t dict_num) override {
         if (!is_dict_inited()) {
-            _dict.reserve(dict_num);
+            _dict->reserve(dict_num);
             for (uint32_t i = 0; i < dict_num; ++i) {
                 auto value = StringValue(dict_array[i].data, dict_array[i].size);
-                _dict.insert_value(value);
+                _dict->insert_value(value);
             }
             _dict_inited = true;
         }
@@ -236,31 +256,31 @@ public:
 
     void convert_dict_codes_if_necessary() override {
         if (!is_dict_sorted()) {
-            _dict.sort();
+            _dict->sort();
             _dict_sorted = true;
         }
 
         if (!is_dict_code_converted()) {
             for (size_t i = 0; i < size(); ++i) {
-                _codes[i] = _dict.convert_code(_codes[i]);
+                _codes[i] = _dict->convert_code(_codes[i]);
             }
             _dict_code_converted = true;
         }
     }
 
-    int32_t find_code(const StringValue& value) const { return _dict.find_code(value); }
+    int32_t find_code(const StringValue& value) const { return _dict->find_code(value); }
 
     int32_t find_code_by_bound(const StringValue& value, bool greater, bool eq) const {
-        return _dict.find_code_by_bound(value, greater, eq);
+        return _dict->find_code_by_bound(value, greater, eq);
     }
 
-    void generate_hash_values() { _dict.generate_hash_values(); }
+    void generate_hash_values() { _dict->generate_hash_values(); }
 
-    uint32_t get_hash_value(uint32_t idx) const { return _dict.get_hash_value(_codes[idx]); }
+    uint32_t get_hash_value(uint32_t idx) const { return _dict->get_hash_value(_codes[idx]); }
 
     phmap::flat_hash_set<int32_t> find_codes(
             const phmap::flat_hash_set<StringValue>& values) const {
-        return _dict.find_codes(values);
+        return _dict->find_codes(values);
     }
 
     bool is_dict_inited() const { return _dict_inited; }
@@ -274,11 +294,11 @@ public:
         res->reserve(_reserve_size);
         for (size_t i = 0; i < _codes.size(); ++i) {
             auto& code = reinterpret_cast<T&>(_codes[i]);
-            auto value = _dict.get_value(code);
+            auto value = _dict->get_value(code);
             res->insert_data(value.ptr, value.len);
         }
         clear();
-        _dict.clear();
+        _dict->clear();
         return res;
     }
 
@@ -306,6 +326,10 @@ public:
 
         inline StringValue& get_value(T code) { return _dict_data[code]; }
 
+        inline const StringValue& get_value(T code) const { return _dict_data[code]; }
+
+        size_t size() const { return _dict_data.size(); }
+
         inline void generate_hash_values() {
             if (_hash_values.size() == 0) {
                 _hash_values.resize(_dict_data.size());
@@ -396,12 +420,15 @@ public:
         HashValueContainer _hash_values;
     };
 
+    const std::shared_ptr<Dictionary>& dictionary() const { return _dict; }
+
 private:
-    size_t _reserve_size;
+    size_t _reserve_size = 0;
     bool _dict_inited = false;
     bool _dict_sorted = false;
     bool _dict_code_converted = false;
-    Dictionary _dict;
+    // shared with the columns created by clone_codes_by_selector()
+    std::shared_ptr<Dictionary> _dict = std::make_shared<Dictionary>();
     Container _codes;
 };
 
@@ -168,9 +168,31 @@ public:
 
     void insert_many_dict_data(const int32_t* data_array, size_t start_index, const StringRef* dict,
                                size_t num, uint32_t /*dict_num*/) override {
-        for (size_t end_index = start_index + num; start_index < end_index; ++start_index) {
-            int32_t codeword = data_array[start_index];
-            insert_data(dict[codeword].data, dict[codeword].size);
+        const int32_t* codes = data_array + start_index;
+        insert_many_strings(num, [&](size_t i) { return dict[codes[i]]; });
+    }
+
+    /// Append `num` strings, the i-th one is returned by `get_string(i)`.
+    /// Chars and offsets are resized only once, which is much cheaper than calling
+    /// insert_data() for every row when decoding dictionary codes to strings.
+    template <typename GetString>
+    void insert_many_strings(size_t num, GetString&& get_string) {
+        size_t old_chars_size = chars.size();
+        size_t new_chars_size = old_chars_size;
+        for (size_t i = 0; i < num; ++i) {
+            new_chars_size += get_string(i).size + 1;
+        }
+        chars.resize(new_chars_size);
+
+        size_t old_rows = offsets.size();
+        offsets.resize(old_rows + num);
+        size_t offset = old_chars_size;
+        for (size_t i = 0; i < num; ++i) {
+            StringRef value = get_string(i);
+            if (value.size) memcpy(chars.data() + offset, value.data, value.size);
+            offset += value.size;
+            chars[offset++] = 0;
+            offsets[old_rows + i] = offset;
         }
     }
 
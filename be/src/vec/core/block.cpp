@@ -34,6 +34,7 @@
 #include "runtime/tuple.h"
 #include "runtime/tuple_row.h"
 #include "udf/udf.h"
+#include "util/block_compression.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_nullable.h"
@@ -74,35 +75,6 @@ Block::Block(const std::vector<SlotDescriptor*>& slots, size_t block_size) {
     }
 }
 
-Block::Block(const PBlock& pblock) {
-    const char* buf = nullptr;
-    std::string compression_scratch;
-    if (pblock.compressed()) {
-        // Decompress
-        const char* compressed_data = pblock.column_values().c_str();
-        size_t compressed_size = pblock.column_values().size();
-        size_t uncompressed_size = 0;
-        bool success =
-                snappy::GetUncompressedLength(compressed_data, compressed_size, &uncompressed_size);
-        DCHECK(success) << "snappy::GetUncompressedLength failed";
-        compression_scratch.resize(uncompressed_size);
-        success =
-                snappy::RawUncompress(compressed_data, compressed_size, compression_scratch.data());
-        DCHECK(success) << "snappy::RawUncompress failed";
-        buf = compression_scratch.data();
-    } else {
-        buf = pblock.column_values().data();
-    }
-
-    for (const auto& pcol_meta : pblock.column_metas()) {
-        DataTypePtr type = DataTypeFactory::instance().create_data_type(pcol_meta);
-        MutableColumnPtr data_column = type->create_column();
-        buf = type->deserialize(buf, data_column.get());
-        data.emplace_back(data_column->get_ptr(), type, pcol_meta.name());
-    }
-    initialize_index_by_name();
-}
-
 void Block::initialize_index_by_name() {
     for (size_t i = 0, size = data.size(); i < size; ++i) {
         index_by_name[data[i].name] = i;
@@ -643,7 +615,8 @@ Status Block::filter_block(Block* block, int filter_column_id, int column_to_kee
 }
 
 Status Block::serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* compressed_bytes,
-                        std::string* allocated_buf) const {
+                        std::string* allocated_buf,
+                        segment_v2::CompressionTypePB compression_type) const {
     // calc uncompressed size for allocation
     size_t content_uncompressed_size = 0;
     for (const auto& c : *this) {
@@ -662,26 +635,32 @@ Status Block::serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* comp
     }
     *uncompressed_bytes = content_uncompressed_size;
 
+    *compressed_bytes = content_uncompressed_size;
+
     // compress
+    const BlockCompressionCodec* codec = nullptr;
     if (config::compress_rowbatches && content_uncompressed_size > 0) {
+        RETURN_IF_ERROR(get_block_compression_codec(compression_type, &codec));
+    }
+    // codec is nullptr for NO_COMPRESSION, and LZ4 can not compress data larger than 2G
+    if (codec != nullptr && codec->max_compressed_len(content_uncompressed_size) > 0) {
         // Try compressing the content to compression_scratch,
         // swap if compressed data is smaller
         std::string compression_scratch;
-        uint32_t max_compressed_size = snappy::MaxCompressedLength(content_uncompressed_size);
-        compression_scratch.resize(max_compressed_size);
+        compression_scratch.resize(codec->max_compressed_len(content_uncompressed_size));
 
-        size_t compressed_size = 0;
-        char* compressed_output = compression_scratch.data();
-        snappy::RawCompress(allocated_buf->data(), content_uncompressed_size, compressed_output,
-                            &compressed_size);
+        Slice compressed_slice(compression_scratch);
+        RETURN_IF_ERROR(codec->compress(Slice(allocated_buf->data(), content_uncompressed_size),
+                                        &compressed_slice));
+        size_t compressed_size = compressed_slice.size;
 
         if (LIKELY(compressed_size < content_uncompressed_size)) {
             compression_scratch.resize(compressed_size);
             allocated_buf->swap(compression_scratch);
             pblock->set_compressed(true);
+            pblock->set_compression_type(compression_type);
+            pblock->set_uncompressed_size(content_uncompressed_size);
             *compressed_bytes = compressed_size;
-        } else {
-            *compressed_bytes = content_uncompressed_size;
         }
 
         VLOG_ROW << "uncompressed size: " << content_uncompressed_size
@@ -691,6 +670,58 @@ Status Block::serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* comp
     return Status::OK();
 }
 
+Status Block::deserialize(const PBlock& pblock) {
+    const char* buf = nullptr;
+    std::string compression_scratch;
+    if (pblock.compressed() && pblock.has_uncompressed_size()) {
+        // Decompress by the codec chosen by sender
+        const BlockCompressionCodec* codec = nullptr;
+        RETURN_IF_ERROR(get_block_compression_codec(pblock.compression_type(), &codec));
+        if (codec == nullptr) {
+            return Status::InternalError(fmt::format("unsupported block compression type: {}",
+                                                     pblock.compression_type()));
+        }
+        compression_scratch.resize(pblock.uncompressed_size());
+        Slice output(compression_scratch);
+        RETURN_IF_ERROR(codec->decompress(Slice(pblock.column_values()), &output));
+        if (output.size != pblock.uncompressed_size()) {
+            return Status::InternalError(
+                    fmt::format("decompressed size {} of block is not the uncompressed size {}",
+                                output.size, pblock.uncompressed_size()));
+        }
+        buf = compression_scratch.data();
+    } else if (pblock.compressed()) {
+        // Decompress, blocks from old version are always compressed by snappy
+        const char* compressed_data = pblock.column_values().c_str();
+        size_t compressed_size = pblock.column_values().size();
+        size_t uncompressed_size = 0;
+        if (!snappy::GetUncompressedLength(compressed_data, compressed_size,
+                                           &uncompressed_size)) {
+            return Status::InternalError("snappy::GetUncompressedLength failed");
+        }
+        compression_scratch.resize(uncompressed_size);
+        if (!snappy::RawUncompress(compressed_data, compressed_size,
+                                   compression_scratch.data())) {
+            return Status::InternalError("snappy::RawUncompress failed");
+        }
+        buf = compression_scratch.data();
+    } else {
+        buf = pblock.column_values().data();
+    }
+
+    Container new_data;
+    for (const auto& pcol_meta : pblock.column_metas()) {
+        DataTypePtr type = DataTypeFactory::instance().create_data_type(pcol_meta);
+        MutableColumnPtr data_column = type->create_column();
+        buf = type->deserialize(buf, data_column.get());
+        new_data.emplace_back(data_column->get_ptr(), type, pcol_meta.name());
+    }
+    data = std::move(new_data);
+    index_by_name.clear();
+    initialize_index_by_name();
+    return Status::OK();
+}
+
 void Block::serialize(RowBatch* output_batch, const RowDescriptor& row_desc) {
     auto num_rows = rows();
     auto mem_pool = output_batch->tuple_data_pool();
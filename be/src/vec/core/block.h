@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "gen_cpp/data.pb.h"
+#include "gen_cpp/segment_v2.pb.h"
 #include "runtime/descriptors.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_nullable.h"
@@ -71,7 +72,6 @@ public:
     Block() = default;
     Block(std::initializer_list<ColumnWithTypeAndName> il);
     Block(const ColumnsWithTypeAndName& data_);
-    Block(const PBlock& pblock);
     Block(const std::vector<SlotDescriptor*>& slots, size_t block_size);
 
     /// insert the column at the specified position
@@ -250,13 +250,20 @@ public:
         }
     }
 
-    // serialize block to PBlock
+    // serialize block to PBlock, column values are compressed by `compression_type`
+    // if config::compress_rowbatches is true and it makes the data smaller.
     Status serialize(PBlock* pblock, size_t* uncompressed_bytes, size_t* compressed_bytes,
-                     std::string* allocated_buf) const;
+                     std::string* allocated_buf,
+                     segment_v2::CompressionTypePB compression_type =
+                             segment_v2::CompressionTypePB::SNAPPY) const;
 
     // serialize block to PRowbatch
     void serialize(RowBatch*, const RowDescriptor&);
 
+    // Replace the columns of this block by the columns of `pblock'. Return error if the
+    // column values of `pblock' can not be decompressed, and the block is left unchanged.
+    Status deserialize(const PBlock& pblock);
+
     std::unique_ptr<Block> create_same_struct_block(size_t size) const;
 
     /** Compares (*this) n-th row and rhs m-th row.
@@ -17,9 +17,14 @@
 
 #include "vec/exec/join/vhash_join_node.h"
 
+#include <algorithm>
+#include <numeric>
+
+#include "common/config.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/runtime_filter_mgr.h"
+#include "util/debug_util.h"
 #include "util/defer_op.h"
 #include "vec/core/materialize_block.h"
 #include "vec/exprs/vexpr.h"
@@ -81,9 +86,9 @@ struct ProcessHashTableBuild {
             }
 
             auto emplace_result =
-                    key_getter.emplace_key(hash_table_ctx.hash_table, k, _join_node->_arena);
+                    key_getter.emplace_key(hash_table_ctx.hash_table, k, *_join_node->_arena);
             if (k + 1 < _rows) {
-                key_getter.prefetch(hash_table_ctx.hash_table, k + 1, _join_node->_arena);
+                key_getter.prefetch(hash_table_ctx.hash_table, k + 1, *_join_node->_arena);
             }
 
             if (emplace_result.is_inserted()) {
@@ -94,7 +99,7 @@ struct ProcessHashTableBuild {
             } else {
                 if constexpr (!build_unique) {
                     /// The first element of the list is stored in the value of the hash table, the rest in the pool.
-                    emplace_result.get_mapped().insert({k, _offset}, _join_node->_arena);
+                    emplace_result.get_mapped().insert({k, _offset}, *_join_node->_arena);
                     if (has_runtime_filter) {
                         inserted_rows.push_back(k);
                     }
@@ -132,7 +137,13 @@ struct ProcessRuntimeFilterBuild {
                 new VRuntimeFilterSlots(_join_node->_probe_expr_ctxs, _join_node->_build_expr_ctxs,
                                         _join_node->_runtime_filter_descs);
 
-        RETURN_IF_ERROR(runtime_filter_slots->init(state, hash_table_ctx.hash_table.get_size()));
+        int64_t build_size = hash_table_ctx.hash_table.get_size();
+        for (const auto& partition : _join_node->_spill_partitions) {
+            if (partition->is_spilled()) {
+                build_size += partition->build_stream->num_rows();
+            }
+        }
+        RETURN_IF_ERROR(runtime_filter_slots->init(state, build_size));
 
         if (!runtime_filter_slots->empty() && !_join_node->_inserted_rows.empty()) {
             {
@@ -140,6 +151,11 @@ struct ProcessRuntimeFilterBuild {
                 runtime_filter_slots->insert(_join_node->_inserted_rows);
             }
         }
+        if (!runtime_filter_slots->empty() && _join_node->_is_spilled) {
+            SCOPED_TIMER(_join_node->_push_compute_timer);
+            RETURN_IF_ERROR(
+                    _join_node->_insert_spilled_rows_to_runtime_filter(runtime_filter_slots));
+        }
         {
             SCOPED_TIMER(_join_node->_push_down_timer);
             runtime_filter_slots->publish();
@@ -664,6 +680,8 @@ HashJoinNode::HashJoinNode(ObjectPool* pool, const TPlanNode& tnode, const Descr
     _runtime_filter_descs = tnode.runtime_filters;
     init_join_op();
 
+    _arena.reset(new Arena());
+
     // avoid vector expand change block address.
     // one block can store 4g data, _build_blocks can store 128*4g data.
     // if probe data bigger than 512g, runtime filter maybe will core dump when insert data.
@@ -788,6 +806,12 @@ Status HashJoinNode::prepare(RuntimeState* state) {
     _push_compute_timer = ADD_TIMER(runtime_profile(), "PushDownComputeTime");
     _build_buckets_counter = ADD_COUNTER(runtime_profile(), "BuildBuckets", TUnit::UNIT);
 
+    // Spill
+    _spill_timer = ADD_TIMER(runtime_profile(), "SpillTime");
+    _spill_bytes_counter = ADD_COUNTER(runtime_profile(), "SpillBytes", TUnit::BYTES);
+    _spill_partitions_counter = ADD_COUNTER(runtime_profile(), "SpillPartitions", TUnit::UNIT);
+    _spill_max_level_counter = ADD_COUNTER(runtime_profile(), "SpillMaxLevel", TUnit::UNIT);
+
     RETURN_IF_ERROR(
             VExpr::prepare(_build_expr_ctxs, state, child(1)->row_desc(), expr_mem_tracker()));
     RETURN_IF_ERROR(
@@ -818,6 +842,11 @@ Status HashJoinNode::close(RuntimeState* state) {
 
     if (_vother_join_conjunct_ptr) (*_vother_join_conjunct_ptr)->close(state);
 
+    // remove the spill files
+    _spill_partitions.clear();
+    _pending_spill_partitions.clear();
+    _current_spill_partition.reset();
+
     _hash_table_mem_tracker->release(_mem_used);
 
     return ExecNode::close(state);
@@ -831,25 +860,55 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     SCOPED_TIMER(_probe_timer);
 
+    if (_is_spilled) {
+        RETURN_IF_ERROR(_get_next_spilled(state, output_block, eos));
+    } else {
+        RETURN_IF_ERROR(_probe(state, output_block, eos));
+    }
+
+    if (output_block->rows() != 0) {
+        RETURN_IF_ERROR(VExprContext::filter_block(_vconjunct_ctx_ptr, output_block,
+                                                   output_block->columns()));
+    }
+    reached_limit(output_block, eos);
+
+    return Status::OK();
+}
+
+void HashJoinNode::_clear_probe_block() {
+    if (!_probe_column_disguise_null.empty()) {
+        for (int i = 0; i < _probe_column_disguise_null.size(); ++i) {
+            auto column_to_erase = _probe_column_disguise_null[i];
+            _probe_block.erase(column_to_erase - i);
+        }
+        _probe_column_disguise_null.clear();
+    }
+    release_block_memory(_probe_block);
+}
+
+Status HashJoinNode::_fetch_probe_block(RuntimeState* state) {
+    SCOPED_TIMER(_probe_next_timer);
+    if (_current_spill_partition != nullptr) {
+        return _current_spill_partition->probe_stream->get_next(&_probe_block, &_probe_eos);
+    }
+
+    do {
+        RETURN_IF_ERROR(child(0)->get_next(state, &_probe_block, &_probe_eos));
+        if (_is_spilled) {
+            RETURN_IF_ERROR(_add_spill_probe_block(_probe_block));
+        }
+    } while (_probe_block.rows() == 0 && !_probe_eos);
+    return Status::OK();
+}
+
+// Join the probe input with the build side in the hash table. 'eos' is set once all
+// probe rows are consumed and the rows only produced from the hash table are returned.
+Status HashJoinNode::_probe(RuntimeState* state, Block* output_block, bool* eos) {
     size_t probe_rows = _probe_block.rows();
     if ((probe_rows == 0 || _probe_index == probe_rows) && !_probe_eos) {
         _probe_index = 0;
-        // clear_column_data of _probe_block
-        {
-            if (!_probe_column_disguise_null.empty()) {
-                for (int i = 0; i < _probe_column_disguise_null.size(); ++i) {
-                    auto column_to_erase = _probe_column_disguise_null[i];
-                    _probe_block.erase(column_to_erase - i);
-                }
-                _probe_column_disguise_null.clear();
-            }
-            release_block_memory(_probe_block);
-        }
-
-        do {
-            SCOPED_TIMER(_probe_next_timer);
-            RETURN_IF_ERROR(child(0)->get_next(state, &_probe_block, &_probe_eos));
-        } while (_probe_block.rows() == 0 && !_probe_eos);
+        _clear_probe_block();
+        RETURN_IF_ERROR(_fetch_probe_block(state));
 
         probe_rows = _probe_block.rows();
         if (probe_rows != 0) {
@@ -951,10 +1010,6 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
         return Status::OK();
     }
 
-    RETURN_IF_ERROR(
-            VExprContext::filter_block(_vconjunct_ctx_ptr, output_block, output_block->columns()));
-    reached_limit(output_block, eos);
-
     return st;
 }
 
@@ -993,6 +1048,10 @@ Status HashJoinNode::_hash_table_build(RuntimeState* state) {
         RETURN_IF_CANCELLED(state);
 
         RETURN_IF_ERROR(child(1)->get_next(state, &block, &eos));
+        if (_is_spilled) {
+            RETURN_IF_ERROR(_add_spill_build_block(state, block));
+            continue;
+        }
         _hash_table_mem_tracker->consume(block.allocated_bytes());
         _mem_used += block.allocated_bytes();
 
@@ -1000,6 +1059,11 @@ Status HashJoinNode::_hash_table_build(RuntimeState* state) {
             mutable_block.merge(block);
         }
 
+        if (state->enable_spill() && _mem_used > config::vhash_join_spill_threshold_bytes) {
+            RETURN_IF_ERROR(_start_spill(state, mutable_block));
+            continue;
+        }
+
         // make one block for each 4 gigabytes
         constexpr static auto BUILD_BLOCK_MAX_SIZE = 4 * 1024UL * 1024UL * 1024UL;
         if (_mem_used - last_mem_used > BUILD_BLOCK_MAX_SIZE) {
@@ -1014,8 +1078,12 @@ Status HashJoinNode::_hash_table_build(RuntimeState* state) {
         }
     }
 
-    _build_blocks.emplace_back(mutable_block.to_block());
-    RETURN_IF_ERROR(_process_build_block(state, _build_blocks[index], index));
+    if (_is_spilled) {
+        RETURN_IF_ERROR(_finish_spill_build(state));
+    } else {
+        _build_blocks.emplace_back(mutable_block.to_block());
+        RETURN_IF_ERROR(_process_build_block(state, _build_blocks[index], index));
+    }
 
     return std::visit(
             [&](auto&& arg) -> Status {
@@ -1254,4 +1322,379 @@ void HashJoinNode::_hash_table_init() {
     }
 }
 
+void HashJoinNode::_reset_hash_table() {
+    _hash_table_init();
+    _arena.reset(new Arena());
+    _build_blocks.clear();
+    _inserted_rows.clear();
+    _hash_table_mem_tracker->release(_mem_used);
+    _mem_used = 0;
+}
+
+// Split 'block' into 'num' blocks, row i goes to block selector[i].
+static std::vector<Block> scatter_block(const Block& block, size_t num,
+                                        const IColumn::Selector& selector) {
+    std::vector<MutableColumns> scattered_columns(num);
+    for (size_t i = 0; i < block.columns(); ++i) {
+        auto columns = block.get_by_position(i).column->scatter(num, selector);
+        for (size_t j = 0; j < num; ++j) {
+            scattered_columns[j].emplace_back(std::move(columns[j]));
+        }
+    }
+
+    std::vector<Block> blocks;
+    blocks.reserve(num);
+    for (size_t j = 0; j < num; ++j) {
+        blocks.emplace_back(block.clone_with_columns(std::move(scattered_columns[j])));
+    }
+    return blocks;
+}
+
+Status HashJoinNode::_compute_spill_partition(Block& block, const VExprContexts& expr_ctxs,
+                                              int level, IColumn::Selector* selector) {
+    size_t rows = block.rows();
+    auto column_to_keep = block.columns();
+
+    // every level uses its own seed, so a partition is split evenly when it is repartitioned
+    std::vector<SipHash> siphashs(rows, SipHash(level));
+    for (auto ctx : expr_ctxs) {
+        int result_col_id = -1;
+        RETURN_IF_ERROR(ctx->execute(&block, &result_col_id));
+        auto column =
+                block.get_by_position(result_col_id).column->convert_to_full_column_if_const();
+
+        // the same key may be nullable on one side only, so only the nested value is hashed
+        if (auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+            const auto& nested_column = nullable->get_nested_column();
+            const auto& null_map = nullable->get_null_map_data();
+            for (size_t i = 0; i < rows; ++i) {
+                if (null_map[i]) {
+                    siphashs[i].update(static_cast<uint8_t>(0));
+                } else {
+                    nested_column.update_hash_with_value(i, siphashs[i]);
+                }
+            }
+        } else {
+            for (size_t i = 0; i < rows; ++i) {
+                column->update_hash_with_value(i, siphashs[i]);
+            }
+        }
+    }
+    Block::erase_useless_column(&block, column_to_keep);
+
+    selector->resize(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        (*selector)[i] = siphashs[i].get64() % _spill_partition_num;
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_create_spill_partitions(RuntimeState* state, int level, bool spilled,
+                                              std::vector<SpillPartitionPtr>* partitions) {
+    partitions->clear();
+    for (int i = 0; i < _spill_partition_num; ++i) {
+        auto partition = std::make_unique<SpillPartition>();
+        partition->level = level;
+        if (spilled) {
+            RETURN_IF_ERROR(VSpillStream::create(state, &partition->build_stream));
+            RETURN_IF_ERROR(VSpillStream::create(state, &partition->probe_stream));
+        } else {
+            partition->build_block =
+                    std::make_unique<MutableBlock>(child(1)->row_desc().tuple_descriptors());
+        }
+        partitions->emplace_back(std::move(partition));
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_spill_block(VSpillStream* stream, const Block& block) {
+    SCOPED_TIMER(_spill_timer);
+    auto old_bytes = stream->bytes_written();
+    RETURN_IF_ERROR(stream->add_block(block));
+    COUNTER_UPDATE(_spill_bytes_counter, stream->bytes_written() - old_bytes);
+    return Status::OK();
+}
+
+Status HashJoinNode::_start_spill(RuntimeState* state, MutableBlock& mutable_block) {
+    LOG(INFO) << "hash join node " << id() << " of fragment instance "
+              << print_id(state->fragment_instance_id()) << " starts to spill, build size "
+              << _mem_used;
+    _is_spilled = true;
+    _spill_partition_num = std::clamp(config::vhash_join_spill_partition_num, 2, 64);
+    RETURN_IF_ERROR(_create_spill_partitions(state, 0, false, &_spill_partitions));
+
+    // blocks already inserted into the hash table are partitioned like the incoming ones
+    std::vector<Block> build_blocks;
+    build_blocks.swap(_build_blocks);
+    build_blocks.emplace_back(mutable_block.to_block());
+    mutable_block.clear();
+    _reset_hash_table();
+
+    for (auto& block : build_blocks) {
+        Block::erase_useless_column(&block, _right_table_data_types.size());
+        RETURN_IF_ERROR(_add_spill_build_block(state, block));
+        block.clear();
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_add_spill_build_block(RuntimeState* state, Block& block) {
+    if (block.rows() == 0) {
+        return Status::OK();
+    }
+
+    IColumn::Selector selector;
+    RETURN_IF_ERROR(_compute_spill_partition(block, _build_expr_ctxs, 0, &selector));
+    auto blocks = scatter_block(block, _spill_partition_num, selector);
+    for (int i = 0; i < _spill_partition_num; ++i) {
+        if (blocks[i].rows() == 0) {
+            continue;
+        }
+        auto& partition = _spill_partitions[i];
+        if (partition->is_spilled()) {
+            RETURN_IF_ERROR(_spill_block(partition->build_stream.get(), blocks[i]));
+        } else {
+            int64_t old_bytes = partition->build_block->allocated_bytes();
+            partition->build_block->merge(blocks[i]);
+            int64_t delta = partition->build_block->allocated_bytes() - old_bytes;
+            _spill_buffered_bytes += delta;
+            _mem_used += delta;
+            _hash_table_mem_tracker->consume(delta);
+        }
+    }
+
+    while (_spill_buffered_bytes > config::vhash_join_spill_threshold_bytes) {
+        RETURN_IF_ERROR(_spill_largest_partition(state));
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_spill_largest_partition(RuntimeState* state) {
+    SpillPartition* victim = nullptr;
+    int64_t victim_bytes = -1;
+    for (auto& partition : _spill_partitions) {
+        if (!partition->is_spilled() && partition->build_block->allocated_bytes() > victim_bytes) {
+            victim = partition.get();
+            victim_bytes = partition->build_block->allocated_bytes();
+        }
+    }
+    if (victim == nullptr) {
+        DCHECK(false) << "buffered bytes without in-memory partition: " << _spill_buffered_bytes;
+        _spill_buffered_bytes = 0;
+        return Status::OK();
+    }
+
+    RETURN_IF_ERROR(VSpillStream::create(state, &victim->build_stream));
+    RETURN_IF_ERROR(VSpillStream::create(state, &victim->probe_stream));
+    RETURN_IF_ERROR(_spill_block(victim->build_stream.get(), victim->build_block->to_block()));
+    victim->build_block.reset();
+
+    _spill_buffered_bytes -= victim_bytes;
+    _mem_used -= victim_bytes;
+    _hash_table_mem_tracker->release(victim_bytes);
+    COUNTER_UPDATE(_spill_partitions_counter, 1);
+    return Status::OK();
+}
+
+Status HashJoinNode::_add_spill_probe_block(Block& block) {
+    if (block.rows() == 0) {
+        return Status::OK();
+    }
+
+    IColumn::Selector selector;
+    RETURN_IF_ERROR(_compute_spill_partition(block, _probe_expr_ctxs, 0, &selector));
+    // rows of in-memory partitions go to block 0, rows of spilled partition i to block i + 1
+    for (auto& partition_idx : selector) {
+        partition_idx = _spill_partitions[partition_idx]->is_spilled() ? partition_idx + 1 : 0;
+    }
+    auto blocks = scatter_block(block, _spill_partition_num + 1, selector);
+    for (int i = 0; i < _spill_partition_num; ++i) {
+        if (blocks[i + 1].rows() != 0) {
+            RETURN_IF_ERROR(
+                    _spill_block(_spill_partitions[i]->probe_stream.get(), blocks[i + 1]));
+        }
+    }
+    block.swap(blocks[0]);
+    return Status::OK();
+}
+
+Status HashJoinNode::_finish_spill_build(RuntimeState* state) {
+    uint8_t index = 0;
+    for (auto& partition : _spill_partitions) {
+        if (partition->is_spilled()) {
+            RETURN_IF_ERROR(partition->build_stream->prepare_for_read());
+        } else if (!partition->build_block->empty()) {
+            _build_blocks.emplace_back(partition->build_block->to_block());
+            partition->build_block.reset();
+            RETURN_IF_ERROR(_process_build_block(state, _build_blocks[index], index));
+            ++index;
+        }
+    }
+    _spill_buffered_bytes = 0;
+
+    if (_build_blocks.empty()) {
+        MutableBlock mutable_block(child(1)->row_desc().tuple_descriptors());
+        _build_blocks.emplace_back(mutable_block.to_block());
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_insert_spilled_rows_to_runtime_filter(
+        VRuntimeFilterSlots* runtime_filter_slots) {
+    for (auto& partition : _spill_partitions) {
+        if (!partition->is_spilled()) {
+            continue;
+        }
+
+        auto stream = partition->build_stream.get();
+        bool eos = false;
+        while (true) {
+            Block block;
+            RETURN_IF_ERROR(stream->get_next(&block, &eos));
+            if (eos) {
+                break;
+            }
+            for (auto ctx : _build_expr_ctxs) {
+                int result_col_id = -1;
+                RETURN_IF_ERROR(ctx->execute(&block, &result_col_id));
+            }
+            std::vector<int> rows(block.rows());
+            std::iota(rows.begin(), rows.end(), 0);
+            std::unordered_map<const Block*, std::vector<int>> inserted_rows;
+            inserted_rows.emplace(&block, std::move(rows));
+            runtime_filter_slots->insert(inserted_rows);
+        }
+        // rewind for joining the partition
+        RETURN_IF_ERROR(stream->prepare_for_read());
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_get_next_spilled(RuntimeState* state, Block* output_block, bool* eos) {
+    bool hash_table_eos = false;
+    RETURN_IF_ERROR(_probe(state, output_block, &hash_table_eos));
+    if (!hash_table_eos) {
+        return Status::OK();
+    }
+
+    if (_current_spill_partition == nullptr) {
+        // the in-memory partitions are done, the probe side of all spilled ones is on disk
+        for (auto& partition : _spill_partitions) {
+            if (partition->is_spilled()) {
+                RETURN_IF_ERROR(partition->probe_stream->prepare_for_read());
+                _pending_spill_partitions.emplace_back(std::move(partition));
+            }
+        }
+        _spill_partitions.clear();
+    }
+    return _prepare_next_spill_partition(state, eos);
+}
+
+bool HashJoinNode::_need_join_partition(const SpillPartition& partition) const {
+    bool build_empty = partition.build_stream->empty();
+    bool probe_empty = partition.probe_stream->empty();
+    if (build_empty && probe_empty) {
+        return false;
+    }
+    // without build rows, only probe rows without a match are returned
+    if (build_empty) {
+        return _match_all_probe || _join_op == TJoinOp::LEFT_ANTI_JOIN;
+    }
+    // without probe rows, only build rows without a match are returned
+    if (probe_empty) {
+        return _match_all_build || _join_op == TJoinOp::RIGHT_ANTI_JOIN;
+    }
+    return true;
+}
+
+Status HashJoinNode::_prepare_next_spill_partition(RuntimeState* state, bool* eos) {
+    _current_spill_partition.reset();
+    _reset_hash_table();
+    _clear_probe_block();
+    _probe_index = 0;
+    _probe_eos = false;
+
+    while (!_pending_spill_partitions.empty()) {
+        RETURN_IF_CANCELLED(state);
+        auto partition = std::move(_pending_spill_partitions.front());
+        _pending_spill_partitions.pop_front();
+        if (!_need_join_partition(*partition)) {
+            continue;
+        }
+
+        if (partition->build_stream->block_bytes() > config::vhash_join_spill_threshold_bytes &&
+            partition->level + 1 < config::vhash_join_spill_max_depth) {
+            RETURN_IF_ERROR(_repartition(state, *partition));
+            continue;
+        }
+
+        SCOPED_TIMER(_build_timer);
+        MutableBlock mutable_block(child(1)->row_desc().tuple_descriptors());
+        bool build_eos = false;
+        while (true) {
+            Block block;
+            RETURN_IF_ERROR(partition->build_stream->get_next(&block, &build_eos));
+            if (build_eos) {
+                break;
+            }
+            mutable_block.merge(block);
+        }
+        _build_blocks.emplace_back(mutable_block.to_block());
+        _mem_used += _build_blocks[0].allocated_bytes();
+        _hash_table_mem_tracker->consume(_build_blocks[0].allocated_bytes());
+        RETURN_IF_ERROR(_process_build_block(state, _build_blocks[0], 0));
+
+        _current_spill_partition = std::move(partition);
+        *eos = false;
+        return Status::OK();
+    }
+
+    *eos = true;
+    return Status::OK();
+}
+
+Status HashJoinNode::_repartition(RuntimeState* state, SpillPartition& partition) {
+    int level = partition.level + 1;
+    std::vector<SpillPartitionPtr> partitions;
+    RETURN_IF_ERROR(_create_spill_partitions(state, level, true, &partitions));
+
+    auto repartition_stream = [&](VSpillStream* stream, const VExprContexts& expr_ctxs,
+                                  bool is_build) -> Status {
+        bool eos = false;
+        while (true) {
+            Block block;
+            RETURN_IF_ERROR(stream->get_next(&block, &eos));
+            if (eos) {
+                break;
+            }
+            IColumn::Selector selector;
+            RETURN_IF_ERROR(_compute_spill_partition(block, expr_ctxs, level, &selector));
+            auto blocks = scatter_block(block, _spill_partition_num, selector);
+            for (int i = 0; i < _spill_partition_num; ++i) {
+                if (blocks[i].rows() == 0) {
+                    continue;
+                }
+                auto sub_stream = is_build ? partitions[i]->build_stream.get()
+                                           : partitions[i]->probe_stream.get();
+                RETURN_IF_ERROR(_spill_block(sub_stream, blocks[i]));
+            }
+        }
+        return Status::OK();
+    };
+    RETURN_IF_ERROR(repartition_stream(partition.build_stream.get(), _build_expr_ctxs, true));
+    RETURN_IF_ERROR(repartition_stream(partition.probe_stream.get(), _probe_expr_ctxs, false));
+
+    // join the sub partitions first, so that their parent's disk space is released early
+    for (auto it = partitions.rbegin(); it != partitions.rend(); ++it) {
+        RETURN_IF_ERROR((*it)->build_stream->prepare_for_read());
+        RETURN_IF_ERROR((*it)->probe_stream->prepare_for_read());
+        _pending_spill_partitions.emplace_front(std::move(*it));
+    }
+    COUNTER_UPDATE(_spill_partitions_counter, _spill_partition_num);
+    if (level > _spill_max_level_counter->value()) {
+        COUNTER_SET(_spill_max_level_counter, (int64_t)level);
+    }
+    return Status::OK();
+}
+
 } // namespace doris::vectorized
@@ -16,6 +16,7 @@
 // under the License.
 
 #pragma once
+#include <deque>
 #include <variant>
 
 #include "common/object_pool.h"
@@ -27,6 +28,7 @@
 #include "vec/exec/join/join_op.h"
 #include "vec/exec/join/vacquire_list.hpp"
 #include "vec/functions/function.h"
+#include "vec/runtime/vspill_stream.h"
 
 namespace doris {
 namespace vectorized {
@@ -199,11 +201,15 @@ private:
     RuntimeProfile::Counter* _search_hashtable_timer;
     RuntimeProfile::Counter* _build_side_output_timer;
     RuntimeProfile::Counter* _probe_side_output_timer;
+    RuntimeProfile::Counter* _spill_timer;
+    RuntimeProfile::Counter* _spill_bytes_counter;
+    RuntimeProfile::Counter* _spill_partitions_counter;
+    RuntimeProfile::Counter* _spill_max_level_counter;
 
     int64_t _hash_table_rows;
     int64_t _mem_used;
 
-    Arena _arena;
+    std::unique_ptr<Arena> _arena;
     HashTableVariants _hash_table_variants;
 
     std::vector<Block> _build_blocks;
@@ -238,6 +244,37 @@ private:
     std::vector<bool> _left_output_slot_flags;
     std::vector<bool> _right_output_slot_flags;
 
+    // Grace/hybrid hash join.
+    // Once the build side grows beyond config::vhash_join_spill_threshold_bytes (and the
+    // query enables spilling), build rows are hash partitioned on the join keys. Partitions
+    // stay in memory until the buffered build side overflows the threshold again, then the
+    // largest one is moved to disk. The hash table is built from the partitions left in
+    // memory, probe rows falling into a spilled partition are written to that partition's
+    // probe stream, and after the child is exhausted every spilled partition is joined on
+    // its own, repartitioning it with a new hash seed if it still does not fit.
+    struct SpillPartition {
+        int level = 0;
+        // build rows buffered in memory, null once the partition is spilled
+        std::unique_ptr<MutableBlock> build_block;
+        std::unique_ptr<VSpillStream> build_stream;
+        std::unique_ptr<VSpillStream> probe_stream;
+
+        bool is_spilled() const { return build_stream != nullptr; }
+    };
+    using SpillPartitionPtr = std::unique_ptr<SpillPartition>;
+
+    bool _is_spilled = false;
+    int _spill_partition_num = 0;
+    // top level partitions, used while building and probing the in-memory partitions
+    std::vector<SpillPartitionPtr> _spill_partitions;
+    // bytes of build rows buffered by the top level partitions
+    int64_t _spill_buffered_bytes = 0;
+    // spilled partitions not joined yet
+    std::deque<SpillPartitionPtr> _pending_spill_partitions;
+    // the spilled partition whose build side is in the hash table, null while the
+    // in-memory partitions are probed
+    SpillPartitionPtr _current_spill_partition;
+
 private:
     Status _hash_table_build(RuntimeState* state);
     Status _process_build_block(RuntimeState* state, Block& block, uint8_t offset);
@@ -250,6 +287,52 @@ private:
 
     void _hash_table_init();
 
+    // release the hash table and build blocks so a new build side can be loaded
+    void _reset_hash_table();
+
+    Status _probe(RuntimeState* state, Block* output_block, bool* eos);
+
+    void _clear_probe_block();
+
+    Status _fetch_probe_block(RuntimeState* state);
+
+    Status _get_next_spilled(RuntimeState* state, Block* output_block, bool* eos);
+
+    // switch to partitioned mode, partitioning the build rows received so far
+    Status _start_spill(RuntimeState* state, MutableBlock& mutable_block);
+
+    Status _create_spill_partitions(RuntimeState* state, int level, bool spilled,
+                                    std::vector<SpillPartitionPtr>* partitions);
+
+    // compute the partition of every row of 'block' by the hash of 'expr_ctxs'
+    Status _compute_spill_partition(Block& block, const VExprContexts& expr_ctxs, int level,
+                                    IColumn::Selector* selector);
+
+    // add a build side block to the top level partitions, spilling partitions if the
+    // buffered rows overflow the threshold
+    Status _add_spill_build_block(RuntimeState* state, Block& block);
+
+    Status _spill_largest_partition(RuntimeState* state);
+
+    Status _spill_block(VSpillStream* stream, const Block& block);
+
+    // write the rows of a probe side block that belong to a spilled partition to disk,
+    // only the rows of in-memory partitions are kept in 'block'
+    Status _add_spill_probe_block(Block& block);
+
+    Status _finish_spill_build(RuntimeState* state);
+
+    // insert the build rows of spilled partitions into the runtime filters
+    Status _insert_spilled_rows_to_runtime_filter(VRuntimeFilterSlots* runtime_filter_slots);
+
+    // load the build side of the next pending spilled partition into the hash table
+    Status _prepare_next_spill_partition(RuntimeState* state, bool* eos);
+
+    Status _repartition(RuntimeState* state, SpillPartition& partition);
+
+    // whether joining a partition with only one empty side can produce rows
+    bool _need_join_partition(const SpillPartition& partition) const;
+
     template <class HashTableContext, bool ignore_null, bool build_unique>
     friend struct ProcessHashTableBuild;
 
@@ -17,12 +17,15 @@
 
 #include "vec/exec/vaggregation_node.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "common/config.h"
 #include "exec/exec_node.h"
 #include "runtime/mem_pool.h"
 #include "runtime/row_batch.h"
 #include "util/defer_op.h"
+#include "vec/common/sip_hash.h"
 #include "vec/core/block.h"
 #include "vec/data_types/data_type_nullable.h"
 #include "vec/exprs/vexpr.h"
@@ -84,6 +87,7 @@ AggregationNode::AggregationNode(ObjectPool* pool, const TPlanNode& tnode,
           _needs_finalize(tnode.agg_node.need_finalize),
           _is_merge(false),
           _agg_data(),
+          _agg_arena_pool(std::make_unique<Arena>()),
           _build_timer(nullptr),
           _exec_timer(nullptr),
           _merge_timer(nullptr) {
@@ -210,6 +214,11 @@ Status AggregationNode::prepare(RuntimeState* state) {
     _merge_timer = ADD_TIMER(runtime_profile(), "MergeTime");
     _expr_timer = ADD_TIMER(runtime_profile(), "ExprTime");
     _get_results_timer = ADD_TIMER(runtime_profile(), "GetResultsTime");
+    _convert_to_two_level_timer = ADD_TIMER(runtime_profile(), "ConvertToTwoLevelTime");
+    _spill_timer = ADD_TIMER(runtime_profile(), "SpillTime");
+    _spill_bytes_counter = ADD_COUNTER(runtime_profile(), "SpillBytes", TUnit::BYTES);
+    _spill_partitions_counter = ADD_COUNTER(runtime_profile(), "SpillPartitions", TUnit::UNIT);
+    _spill_max_level_counter = ADD_COUNTER(runtime_profile(), "SpillMaxLevel", TUnit::UNIT);
     _data_mem_tracker =
             MemTracker::create_virtual_tracker(-1, "AggregationNode:Data", mem_tracker());
     _intermediate_tuple_desc = state->desc_tbl().get_tuple_descriptor(_intermediate_tuple_id);
@@ -326,6 +335,10 @@ Status AggregationNode::prepare(RuntimeState* state) {
         _executor.update_memusage =
                 std::bind<void>(&AggregationNode::_update_memusage_with_serialized_key, this);
         _executor.close = std::bind<void>(&AggregationNode::_close_with_serialized_key, this);
+
+        // streaming preaggregations pass rows through instead of growing the hash table
+        _can_spill = state->enable_spill() && !_is_streaming_preagg;
+        _spill_partition_num = std::clamp(config::vagg_spill_partition_num, 2, 64);
     }
 
     return Status::OK();
@@ -359,6 +372,19 @@ Status AggregationNode::open(RuntimeState* state) {
         }
         RETURN_IF_ERROR(_executor.execute(&block));
         _executor.update_memusage();
+        if (_can_spill && _hash_table_bytes() > config::vagg_spill_threshold_bytes) {
+            RETURN_IF_ERROR(_spill_hash_table(state, 0, true));
+        }
+    }
+
+    if (!_spill_partitions.empty()) {
+        // the groups of the spilled partitions left in memory are spilled too, so that every
+        // spilled partition holds all the states of its keys. The groups of the other
+        // partitions stay in the hash table and are returned first.
+        RETURN_IF_ERROR(_spill_hash_table(state, 0, false));
+        RETURN_IF_ERROR(_finish_spill());
+        _is_spilled = true;
+        _spill_partition_merged = true;
     }
 
     return Status::OK();
@@ -392,7 +418,11 @@ Status AggregationNode::get_next(RuntimeState* state, Block* block, bool* eos) {
         _make_nullable_output_key(block);
         COUNTER_SET(_rows_returned_counter, _num_rows_returned);
     } else {
-        RETURN_IF_ERROR(_executor.get_result(state, block, eos));
+        if (_is_spilled) {
+            RETURN_IF_ERROR(_get_spilled_result(state, block, eos));
+        } else {
+            RETURN_IF_ERROR(_executor.get_result(state, block, eos));
+        }
         _make_nullable_output_key(block);
         // dispose the having clause, should not be execute in prestreaming agg
         RETURN_IF_ERROR(VExprContext::filter_block(_vconjunct_ctx_ptr, block, block->columns()));
@@ -518,7 +548,8 @@ Status AggregationNode::_execute_without_key(Block* block) {
     SCOPED_TIMER(_build_timer);
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
         _aggregate_evaluators[i]->execute_single_add(
-                block, _agg_data.without_key + _offsets_of_aggregate_states[i], &_agg_arena_pool);
+                block, _agg_data.without_key + _offsets_of_aggregate_states[i],
+                _agg_arena_pool.get());
     }
     return Status::OK();
 }
@@ -541,27 +572,27 @@ Status AggregationNode::_merge_without_key(Block* block) {
 
                 _aggregate_evaluators[i]->function()->deserialize(
                         deserialize_buffer.get() + _offsets_of_aggregate_states[i], buffer_reader,
-                        &_agg_arena_pool);
+                        _agg_arena_pool.get());
 
                 _aggregate_evaluators[i]->function()->merge(
                         _agg_data.without_key + _offsets_of_aggregate_states[i],
                         deserialize_buffer.get() + _offsets_of_aggregate_states[i],
-                        &_agg_arena_pool);
+                        _agg_arena_pool.get());
 
                 _destory_agg_status(deserialize_buffer.get());
             }
         } else {
             _aggregate_evaluators[i]->execute_single_add(
                     block, _agg_data.without_key + _offsets_of_aggregate_states[i],
-                    &_agg_arena_pool);
+                    _agg_arena_pool.get());
         }
     }
     return Status::OK();
 }
 
 void AggregationNode::_update_memusage_without_key() {
-    _data_mem_tracker->consume(_agg_arena_pool.size() - _mem_usage_record.used_in_arena);
-    _mem_usage_record.used_in_arena = _agg_arena_pool.size();
+    _data_mem_tracker->consume(_agg_arena_pool->size() - _mem_usage_record.used_in_arena);
+    _mem_usage_record.used_in_arena = _agg_arena_pool->size();
 }
 
 void AggregationNode::_close_without_key() {
@@ -669,7 +700,7 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
                         if (_streaming_pre_places.size() < rows) {
                             _streaming_pre_places.reserve(rows);
                             for (size_t i = _streaming_pre_places.size(); i < rows; ++i) {
-                                _streaming_pre_places.emplace_back(_agg_arena_pool.aligned_alloc(
+                                _streaming_pre_places.emplace_back(_agg_arena_pool->aligned_alloc(
                                         _total_size_of_aggregate_states, _align_aggregate_states));
                             }
                         }
@@ -681,7 +712,7 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
                         for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
                             _aggregate_evaluators[i]->execute_batch_add(
                                     in_block, _offsets_of_aggregate_states[i],
-                                    _streaming_pre_places.data(), &_agg_arena_pool);
+                                    _streaming_pre_places.data(), _agg_arena_pool.get());
                         }
 
                         // will serialize value data to string column
@@ -737,67 +768,19 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
             _agg_data._aggregated_method_variant);
 
     if (!ret_flag) {
-        std::visit(
-                [&](auto&& agg_method) -> void {
-                    using HashMethodType = std::decay_t<decltype(agg_method)>;
-                    using AggState = typename HashMethodType::State;
-                    AggState state(key_columns, _probe_key_sz, nullptr);
-                    /// For all rows.
-                    for (size_t i = 0; i < rows; ++i) {
-                        AggregateDataPtr aggregate_data = nullptr;
-
-                        auto emplace_result =
-                                state.emplace_key(agg_method.data, i, _agg_arena_pool);
-
-                        /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
-                        if (emplace_result.is_inserted()) {
-                            /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
-                            emplace_result.set_mapped(nullptr);
-
-                            aggregate_data = _agg_arena_pool.aligned_alloc(
-                                    _total_size_of_aggregate_states, _align_aggregate_states);
-                            _create_agg_status(aggregate_data);
-
-                            emplace_result.set_mapped(aggregate_data);
-                        } else
-                            aggregate_data = emplace_result.get_mapped();
-
-                        places[i] = aggregate_data;
-                        assert(places[i] != nullptr);
-                    }
-                },
-                _agg_data._aggregated_method_variant);
+        _emplace_into_hash_table(places.data(), key_columns, rows);
 
         for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
             _aggregate_evaluators[i]->execute_batch_add(in_block, _offsets_of_aggregate_states[i],
-                                                        places.data(), &_agg_arena_pool);
+                                                        places.data(), _agg_arena_pool.get());
         }
     }
 
     return Status::OK();
 }
 
-Status AggregationNode::_execute_with_serialized_key(Block* block) {
-    SCOPED_TIMER(_build_timer);
-    DCHECK(!_probe_expr_ctxs.empty());
-
-    size_t key_size = _probe_expr_ctxs.size();
-    ColumnRawPtrs key_columns(key_size);
-    {
-        SCOPED_TIMER(_expr_timer);
-        for (size_t i = 0; i < key_size; ++i) {
-            int result_column_id = -1;
-            RETURN_IF_ERROR(_probe_expr_ctxs[i]->execute(block, &result_column_id));
-            block->get_by_position(result_column_id).column =
-                    block->get_by_position(result_column_id)
-                            .column->convert_to_full_column_if_const();
-            key_columns[i] = block->get_by_position(result_column_id).column.get();
-        }
-    }
-
-    int rows = block->rows();
-    PODArray<AggregateDataPtr> places(rows);
-
+void AggregationNode::_emplace_into_hash_table(AggregateDataPtr* places,
+                                               ColumnRawPtrs& key_columns, size_t rows) {
     std::visit(
             [&](auto&& agg_method) -> void {
                 using HashMethodType = std::decay_t<decltype(agg_method)>;
@@ -807,14 +790,14 @@ Status AggregationNode::_execute_with_serialized_key(Block* block) {
                 for (size_t i = 0; i < rows; ++i) {
                     AggregateDataPtr aggregate_data = nullptr;
 
-                    auto emplace_result = state.emplace_key(agg_method.data, i, _agg_arena_pool);
+                    auto emplace_result = state.emplace_key(agg_method.data, i, *_agg_arena_pool);
 
                     /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
                     if (emplace_result.is_inserted()) {
                         /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
                         emplace_result.set_mapped(nullptr);
 
-                        aggregate_data = _agg_arena_pool.aligned_alloc(
+                        aggregate_data = _agg_arena_pool->aligned_alloc(
                                 _total_size_of_aggregate_states, _align_aggregate_states);
                         _create_agg_status(aggregate_data);
 
@@ -828,9 +811,44 @@ Status AggregationNode::_execute_with_serialized_key(Block* block) {
             },
             _agg_data._aggregated_method_variant);
 
+    // a streaming preaggregation keeps its hash table small, so it never converts
+    if (!_is_streaming_preagg && _agg_data.is_convertible_to_two_level()) {
+        size_t num_keys = std::visit([](auto&& agg_method) { return agg_method.data.size(); },
+                                     _agg_data._aggregated_method_variant);
+        if (num_keys >= config::vagg_two_level_hash_table_threshold) {
+            SCOPED_TIMER(_convert_to_two_level_timer);
+            _agg_data.convert_to_two_level();
+            runtime_profile()->add_info_string("TwoLevelHashTable", "true");
+        }
+    }
+}
+
+Status AggregationNode::_execute_with_serialized_key(Block* block) {
+    SCOPED_TIMER(_build_timer);
+    DCHECK(!_probe_expr_ctxs.empty());
+
+    size_t key_size = _probe_expr_ctxs.size();
+    ColumnRawPtrs key_columns(key_size);
+    {
+        SCOPED_TIMER(_expr_timer);
+        for (size_t i = 0; i < key_size; ++i) {
+            int result_column_id = -1;
+            RETURN_IF_ERROR(_probe_expr_ctxs[i]->execute(block, &result_column_id));
+            block->get_by_position(result_column_id).column =
+                    block->get_by_position(result_column_id)
+                            .column->convert_to_full_column_if_const();
+            key_columns[i] = block->get_by_position(result_column_id).column.get();
+        }
+    }
+
+    int rows = block->rows();
+    PODArray<AggregateDataPtr> places(rows);
+
+    _emplace_into_hash_table(places.data(), key_columns, rows);
+
     for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
         _aggregate_evaluators[i]->execute_batch_add(block, _offsets_of_aggregate_states[i],
-                                                    places.data(), &_agg_arena_pool);
+                                                    places.data(), _agg_arena_pool.get());
     }
 
     return Status::OK();
@@ -1017,35 +1035,7 @@ Status AggregationNode::_merge_with_serialized_key(Block* block) {
     int rows = block->rows();
     PODArray<AggregateDataPtr> places(rows);
 
-    std::visit(
-            [&](auto&& agg_method) -> void {
-                using HashMethodType = std::decay_t<decltype(agg_method)>;
-                using AggState = typename HashMethodType::State;
-                AggState state(key_columns, _probe_key_sz, nullptr);
-                /// For all rows.
-                for (size_t i = 0; i < rows; ++i) {
-                    AggregateDataPtr aggregate_data = nullptr;
-
-                    auto emplace_result = state.emplace_key(agg_method.data, i, _agg_arena_pool);
-
-                    /// If a new key is inserted, initialize the states of the aggregate functions, and possibly something related to the key.
-                    if (emplace_result.is_inserted()) {
-                        /// exception-safety - if you can not allocate memory or create states, then destructors will not be called.
-                        emplace_result.set_mapped(nullptr);
-
-                        aggregate_data = _agg_arena_pool.aligned_alloc(
-                                _total_size_of_aggregate_states, _align_aggregate_states);
-                        _create_agg_status(aggregate_data);
-
-                        emplace_result.set_mapped(aggregate_data);
-                    } else
-                        aggregate_data = emplace_result.get_mapped();
-
-                    places[i] = aggregate_data;
-                    assert(places[i] != nullptr);
-                }
-            },
-            _agg_data._aggregated_method_variant);
+    _emplace_into_hash_table(places.data(), key_columns, rows);
 
     std::unique_ptr<char[]> deserialize_buffer(new char[_total_size_of_aggregate_states]);
 
@@ -1062,18 +1052,18 @@ Status AggregationNode::_merge_with_serialized_key(Block* block) {
 
                 _aggregate_evaluators[i]->function()->deserialize(
                         deserialize_buffer.get() + _offsets_of_aggregate_states[i], buffer_reader,
-                        &_agg_arena_pool);
+                        _agg_arena_pool.get());
 
                 _aggregate_evaluators[i]->function()->merge(
                         places.data()[j] + _offsets_of_aggregate_states[i],
                         deserialize_buffer.get() + _offsets_of_aggregate_states[i],
-                        &_agg_arena_pool);
+                        _agg_arena_pool.get());
 
                 _destory_agg_status(deserialize_buffer.get());
             }
         } else {
             _aggregate_evaluators[i]->execute_batch_add(block, _offsets_of_aggregate_states[i],
-                                                        places.data(), &_agg_arena_pool);
+                                                        places.data(), _agg_arena_pool.get());
         }
     }
     return Status::OK();
@@ -1083,12 +1073,12 @@ void AggregationNode::_update_memusage_with_serialized_key() {
     std::visit(
             [&](auto&& agg_method) -> void {
                 auto& data = agg_method.data;
-                _data_mem_tracker->consume(_agg_arena_pool.size() -
+                _data_mem_tracker->consume(_agg_arena_pool->size() -
                                            _mem_usage_record.used_in_arena);
                 _data_mem_tracker->consume(data.get_buffer_size_in_bytes() -
                                            _mem_usage_record.used_in_state);
                 _mem_usage_record.used_in_state = data.get_buffer_size_in_bytes();
-                _mem_usage_record.used_in_arena = _agg_arena_pool.size();
+                _mem_usage_record.used_in_arena = _agg_arena_pool->size();
             },
             _agg_data._aggregated_method_variant);
 }
@@ -1108,6 +1098,199 @@ void AggregationNode::_close_with_serialized_key() {
     release_tracker();
 }
 
+void AggregationNode::_reset_hash_table() {
+    _close_with_serialized_key();
+    _mem_usage_record = MemoryRecord();
+    _init_hash_method(_probe_expr_ctxs);
+    _agg_arena_pool = std::make_unique<Arena>();
+}
+
+Status AggregationNode::_spill_hash_table(RuntimeState* state, int level, bool spill_more) {
+    SCOPED_TIMER(_spill_timer);
+    if (_spill_partitions.empty()) {
+        for (int i = 0; i < _spill_partition_num; ++i) {
+            auto partition = std::make_unique<SpillPartition>();
+            partition->level = level;
+            _spill_partitions.emplace_back(std::move(partition));
+        }
+        _spilled_partition_num = 0;
+        if (level > _spill_max_level_counter->value()) {
+            COUNTER_SET(_spill_max_level_counter, (int64_t)level);
+        }
+    }
+    DCHECK_EQ(_spill_partitions[0]->level, level);
+    if (spill_more) {
+        // spill half of the partitions left in memory, the keys are spread evenly over the
+        // partitions, so the first ones are as good as any
+        int old_num = _spilled_partition_num;
+        _spilled_partition_num += (_spill_partition_num - _spilled_partition_num + 1) / 2;
+        for (int i = old_num; i < _spilled_partition_num; ++i) {
+            RETURN_IF_ERROR(VSpillStream::create(state, &_spill_partitions[i]->stream));
+        }
+        COUNTER_UPDATE(_spill_partitions_counter, _spilled_partition_num - old_num);
+    }
+
+    // The hash table can not erase the groups of the spilled partitions, so all groups are
+    // serialized and the ones of the partitions kept in memory are merged into a new hash
+    // table afterwards, which also compacts the arena. Their serialized states are held in
+    // memory in the meantime.
+    std::vector<Block> kept_blocks;
+    size_t key_size = _probe_expr_ctxs.size();
+    bool eos = false;
+    while (!eos) {
+        RETURN_IF_CANCELLED(state);
+        Block block;
+        RETURN_IF_ERROR(_serialize_with_serialized_key_result(state, &block, &eos));
+        size_t rows = block.rows();
+        if (rows == 0) {
+            continue;
+        }
+
+        // every level uses its own seed, so a partition is split evenly when it is spilled again
+        std::vector<SipHash> siphashs(rows, SipHash(level));
+        for (size_t i = 0; i < key_size; ++i) {
+            const auto& column = block.get_by_position(i).column;
+            for (size_t j = 0; j < rows; ++j) {
+                column->update_hash_with_value(j, siphashs[j]);
+            }
+        }
+        IColumn::Selector selector(rows);
+        for (size_t j = 0; j < rows; ++j) {
+            selector[j] = siphashs[j].get64() % _spill_partition_num;
+        }
+
+        std::vector<MutableColumns> scattered_columns(_spill_partition_num);
+        for (size_t i = 0; i < block.columns(); ++i) {
+            auto columns = block.get_by_position(i).column->scatter(_spill_partition_num, selector);
+            for (int j = 0; j < _spill_partition_num; ++j) {
+                scattered_columns[j].emplace_back(std::move(columns[j]));
+            }
+        }
+        for (int j = 0; j < _spill_partition_num; ++j) {
+            auto partition_block = block.clone_with_columns(std::move(scattered_columns[j]));
+            if (j >= _spilled_partition_num) {
+                if (partition_block.rows() != 0) {
+                    kept_blocks.emplace_back(std::move(partition_block));
+                }
+                continue;
+            }
+            auto stream = _spill_partitions[j]->stream.get();
+            int64_t old_bytes = stream->bytes_written();
+            RETURN_IF_ERROR(stream->add_block(partition_block));
+            COUNTER_UPDATE(_spill_bytes_counter, stream->bytes_written() - old_bytes);
+        }
+    }
+
+    _reset_hash_table();
+    for (auto& block : kept_blocks) {
+        RETURN_IF_ERROR(_merge_spilled_block(&block));
+        block.clear();
+    }
+    _executor.update_memusage();
+    return Status::OK();
+}
+
+Status AggregationNode::_finish_spill() {
+    // merge the sub partitions first, so that the disk space of their parent is released early
+    for (auto it = _spill_partitions.rbegin(); it != _spill_partitions.rend(); ++it) {
+        if ((*it)->stream == nullptr || (*it)->stream->empty()) {
+            continue;
+        }
+        RETURN_IF_ERROR((*it)->stream->prepare_for_read());
+        _pending_spill_partitions.emplace_front(std::move(*it));
+    }
+    _spill_partitions.clear();
+    _spilled_partition_num = 0;
+    return Status::OK();
+}
+
+Status AggregationNode::_merge_spilled_block(Block* block) {
+    SCOPED_TIMER(_merge_timer);
+
+    size_t key_size = _probe_expr_ctxs.size();
+    ColumnRawPtrs key_columns(key_size);
+    for (size_t i = 0; i < key_size; ++i) {
+        key_columns[i] = block->get_by_position(i).column.get();
+    }
+
+    int rows = block->rows();
+    PODArray<AggregateDataPtr> places(rows);
+    _emplace_into_hash_table(places.data(), key_columns, rows);
+
+    // every spilled column holds serialized states, whether the evaluator merges or not
+    std::unique_ptr<char[]> deserialize_buffer(new char[_total_size_of_aggregate_states]);
+    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+        auto evaluator = _aggregate_evaluators[i];
+        auto offset = _offsets_of_aggregate_states[i];
+        auto place = deserialize_buffer.get() + offset;
+        auto column = (const ColumnString*)block->get_by_position(i + key_size).column.get();
+
+        for (int j = 0; j < rows; ++j) {
+            VectorBufferReader buffer_reader(column->get_data_at(j));
+            evaluator->create(place);
+            evaluator->function()->deserialize(place, buffer_reader, _agg_arena_pool.get());
+            evaluator->function()->merge(places.data()[j] + offset, place, _agg_arena_pool.get());
+            evaluator->function()->destroy(place);
+        }
+    }
+    return Status::OK();
+}
+
+Status AggregationNode::_merge_spill_partition(RuntimeState* state) {
+    DCHECK(_spill_partitions.empty());
+    auto partition = std::move(_pending_spill_partitions.front());
+    _pending_spill_partitions.pop_front();
+    _reset_hash_table();
+
+    int next_level = partition->level + 1;
+    bool eos = false;
+    while (!eos) {
+        RETURN_IF_CANCELLED(state);
+        Block block;
+        {
+            SCOPED_TIMER(_spill_timer);
+            RETURN_IF_ERROR(partition->stream->get_next(&block, &eos));
+        }
+        if (block.rows() != 0) {
+            RETURN_IF_ERROR(_merge_spilled_block(&block));
+            _executor.update_memusage();
+        }
+        if (next_level < config::vagg_spill_max_depth &&
+            _hash_table_bytes() > config::vagg_spill_threshold_bytes) {
+            // the partition is still too large, split it again with the seed of the next level
+            RETURN_IF_ERROR(_spill_hash_table(state, next_level, true));
+        }
+    }
+
+    if (!_spill_partitions.empty()) {
+        RETURN_IF_ERROR(_spill_hash_table(state, next_level, false));
+        RETURN_IF_ERROR(_finish_spill());
+    }
+    // the groups kept in memory are returned before the sub partitions are merged
+    _spill_partition_merged = true;
+    return Status::OK();
+}
+
+Status AggregationNode::_get_spilled_result(RuntimeState* state, Block* block, bool* eos) {
+    while (true) {
+        if (!_spill_partition_merged) {
+            if (_pending_spill_partitions.empty()) {
+                *eos = true;
+                return Status::OK();
+            }
+            RETURN_IF_ERROR(_merge_spill_partition(state));
+            continue;
+        }
+
+        bool partition_eos = false;
+        RETURN_IF_ERROR(_executor.get_result(state, block, &partition_eos));
+        _spill_partition_merged = !partition_eos;
+        if (block->rows() != 0) {
+            return Status::OK();
+        }
+    }
+}
+
 void AggregationNode::release_tracker() {
     _data_mem_tracker->release(_mem_usage_record.used_in_state + _mem_usage_record.used_in_arena);
 }
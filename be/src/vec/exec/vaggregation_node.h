@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <deque>
 #include <functional>
 #include <variant>
 
@@ -25,7 +26,9 @@
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/common/columns_hashing.h"
 #include "vec/common/hash_table/fixed_hash_map.h"
+#include "vec/common/hash_table/two_level_hash_map.h"
 #include "vec/exprs/vectorized_agg_fn.h"
+#include "vec/runtime/vspill_stream.h"
 
 namespace doris {
 class TPlanNode;
@@ -74,6 +77,8 @@ struct AggregationMethodSerialized {
 
 using AggregatedDataWithoutKey = AggregateDataPtr;
 using AggregatedDataWithStringKey = HashMapWithSavedHash<StringRef, AggregateDataPtr>;
+using AggregatedDataWithStringKeyTwoLevel =
+        TwoLevelHashMapWithSavedHash<StringRef, AggregateDataPtr>;
 
 /// For the case where there is one numeric key.
 /// FieldType is UInt8/16/32/64 for any type with corresponding bit width.
@@ -117,6 +122,13 @@ template <typename Base>
 struct AggregationDataWithNullKey : public Base {
     using Base::Base;
 
+    /// Copy the data of another table with null key, used to convert to a two-level table.
+    template <typename Other>
+    explicit AggregationDataWithNullKey(const Other& other) : Base(other) {
+        has_null_key = other.has_null_key_data();
+        null_key_data = other.get_null_key_data();
+    }
+
     bool& has_null_key_data() { return has_null_key; }
     AggregateDataPtr& get_null_key_data() { return null_key_data; }
     bool has_null_key_data() const { return has_null_key; }
@@ -253,6 +265,15 @@ using AggregatedDataWithUInt64Key = HashMap<UInt64, AggregateDataPtr, HashCRC32<
 using AggregatedDataWithUInt128Key = HashMap<UInt128, AggregateDataPtr, HashCRC32<UInt128>>;
 using AggregatedDataWithUInt256Key = HashMap<UInt256, AggregateDataPtr, HashCRC32<UInt256>>;
 
+using AggregatedDataWithUInt32KeyTwoLevel =
+        TwoLevelHashMap<UInt32, AggregateDataPtr, HashCRC32<UInt32>>;
+using AggregatedDataWithUInt64KeyTwoLevel =
+        TwoLevelHashMap<UInt64, AggregateDataPtr, HashCRC32<UInt64>>;
+using AggregatedDataWithUInt128KeyTwoLevel =
+        TwoLevelHashMap<UInt128, AggregateDataPtr, HashCRC32<UInt128>>;
+using AggregatedDataWithUInt256KeyTwoLevel =
+        TwoLevelHashMap<UInt256, AggregateDataPtr, HashCRC32<UInt256>>;
+
 using AggregatedDataWithNullableUInt8Key = AggregationDataWithNullKey<AggregatedDataWithUInt8Key>;
 using AggregatedDataWithNullableUInt16Key = AggregationDataWithNullKey<AggregatedDataWithUInt16Key>;
 using AggregatedDataWithNullableUInt32Key = AggregationDataWithNullKey<AggregatedDataWithUInt32Key>;
@@ -260,6 +281,13 @@ using AggregatedDataWithNullableUInt64Key = AggregationDataWithNullKey<Aggregate
 using AggregatedDataWithNullableUInt128Key =
         AggregationDataWithNullKey<AggregatedDataWithUInt128Key>;
 
+using AggregatedDataWithNullableUInt32KeyTwoLevel =
+        AggregationDataWithNullKey<AggregatedDataWithUInt32KeyTwoLevel>;
+using AggregatedDataWithNullableUInt64KeyTwoLevel =
+        AggregationDataWithNullKey<AggregatedDataWithUInt64KeyTwoLevel>;
+using AggregatedDataWithNullableUInt128KeyTwoLevel =
+        AggregationDataWithNullKey<AggregatedDataWithUInt128KeyTwoLevel>;
+
 using AggregatedMethodVariants = std::variant<
         AggregationMethodSerialized<AggregatedDataWithStringKey>,
         AggregationMethodOneNumber<UInt8, AggregatedDataWithUInt8Key, false>,
@@ -282,7 +310,23 @@ using AggregatedMethodVariants = std::variant<
         AggregationMethodKeysFixed<AggregatedDataWithUInt128Key, false>,
         AggregationMethodKeysFixed<AggregatedDataWithUInt128Key, true>,
         AggregationMethodKeysFixed<AggregatedDataWithUInt256Key, false>,
-        AggregationMethodKeysFixed<AggregatedDataWithUInt256Key, true>>;
+        AggregationMethodKeysFixed<AggregatedDataWithUInt256Key, true>,
+        AggregationMethodSerialized<AggregatedDataWithStringKeyTwoLevel>,
+        AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32KeyTwoLevel>,
+        AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64KeyTwoLevel>,
+        AggregationMethodOneNumber<UInt128, AggregatedDataWithUInt128KeyTwoLevel>,
+        AggregationMethodSingleNullableColumn<
+                AggregationMethodOneNumber<UInt32, AggregatedDataWithNullableUInt32KeyTwoLevel>>,
+        AggregationMethodSingleNullableColumn<
+                AggregationMethodOneNumber<UInt64, AggregatedDataWithNullableUInt64KeyTwoLevel>>,
+        AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                UInt128, AggregatedDataWithNullableUInt128KeyTwoLevel>>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt64KeyTwoLevel, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt64KeyTwoLevel, true>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt128KeyTwoLevel, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt128KeyTwoLevel, true>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt256KeyTwoLevel, false>,
+        AggregationMethodKeysFixed<AggregatedDataWithUInt256KeyTwoLevel, true>>;
 
 struct AggregatedDataVariants {
     AggregatedDataVariants() = default;
@@ -307,9 +351,13 @@ struct AggregatedDataVariants {
     };
 
     Type _type = Type::EMPTY;
+    bool _is_nullable = false;
+    bool _is_two_level = false;
 
     void init(Type type, bool is_nullable = false) {
         _type = type;
+        _is_nullable = is_nullable;
+        _is_two_level = false;
         switch (_type) {
         case Type::without_key:
             break;
@@ -396,11 +444,106 @@ struct AggregatedDataVariants {
             DCHECK(false) << "Do not have a rigth agg data type";
         }
     }
+
+    // The hash maps of the fixed size keys (int8/int16) are small lookup tables, the others
+    // can be split into a two-level hash table once they grow large.
+    bool is_convertible_to_two_level() const {
+        if (_is_two_level) return false;
+        switch (_type) {
+        case Type::serialized:
+        case Type::int32_key:
+        case Type::int64_key:
+        case Type::int128_key:
+        case Type::int64_keys:
+        case Type::int128_keys:
+        case Type::int256_keys:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Move all the keys of the single-level hash table into a two-level one, the mapped
+    // aggregate states are kept.
+    void convert_to_two_level() {
+        DCHECK(is_convertible_to_two_level());
+        switch (_type) {
+        case Type::serialized:
+            _convert<AggregationMethodSerialized<AggregatedDataWithStringKey>,
+                     AggregationMethodSerialized<AggregatedDataWithStringKeyTwoLevel>>();
+            break;
+        case Type::int32_key:
+            if (_is_nullable) {
+                _convert<AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                 UInt32, AggregatedDataWithNullableUInt32Key>>,
+                         AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                 UInt32, AggregatedDataWithNullableUInt32KeyTwoLevel>>>();
+            } else {
+                _convert<AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32Key>,
+                         AggregationMethodOneNumber<UInt32, AggregatedDataWithUInt32KeyTwoLevel>>();
+            }
+            break;
+        case Type::int64_key:
+            if (_is_nullable) {
+                _convert<AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                 UInt64, AggregatedDataWithNullableUInt64Key>>,
+                         AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                 UInt64, AggregatedDataWithNullableUInt64KeyTwoLevel>>>();
+            } else {
+                _convert<AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64Key>,
+                         AggregationMethodOneNumber<UInt64, AggregatedDataWithUInt64KeyTwoLevel>>();
+            }
+            break;
+        case Type::int128_key:
+            if (_is_nullable) {
+                _convert<AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                 UInt128, AggregatedDataWithNullableUInt128Key>>,
+                         AggregationMethodSingleNullableColumn<AggregationMethodOneNumber<
+                                 UInt128, AggregatedDataWithNullableUInt128KeyTwoLevel>>>();
+            } else {
+                _convert<AggregationMethodOneNumber<UInt128, AggregatedDataWithUInt128Key>,
+                         AggregationMethodOneNumber<UInt128,
+                                                    AggregatedDataWithUInt128KeyTwoLevel>>();
+            }
+            break;
+        case Type::int64_keys:
+            _convert_keys_fixed<AggregatedDataWithUInt64Key, AggregatedDataWithUInt64KeyTwoLevel>();
+            break;
+        case Type::int128_keys:
+            _convert_keys_fixed<AggregatedDataWithUInt128Key,
+                                AggregatedDataWithUInt128KeyTwoLevel>();
+            break;
+        case Type::int256_keys:
+            _convert_keys_fixed<AggregatedDataWithUInt256Key,
+                                AggregatedDataWithUInt256KeyTwoLevel>();
+            break;
+        default:
+            DCHECK(false) << "Do not have a two level hash table for agg data type";
+        }
+        _is_two_level = true;
+    }
+
+private:
+    template <typename Method, typename TwoLevelMethod>
+    void _convert() {
+        Method single_level = std::move(std::get<Method>(_aggregated_method_variant));
+        _aggregated_method_variant.emplace<TwoLevelMethod>(single_level);
+    }
+
+    template <typename Data, typename TwoLevelData>
+    void _convert_keys_fixed() {
+        if (_is_nullable) {
+            _convert<AggregationMethodKeysFixed<Data, true>,
+                     AggregationMethodKeysFixed<TwoLevelData, true>>();
+        } else {
+            _convert<AggregationMethodKeysFixed<Data, false>,
+                     AggregationMethodKeysFixed<TwoLevelData, false>>();
+        }
+    }
 };
 
 using AggregatedDataVariantsPtr = std::shared_ptr<AggregatedDataVariants>;
 
-// not support spill
 class AggregationNode : public ::doris::ExecNode {
 public:
     using Sizes = std::vector<size_t>;
@@ -445,19 +588,53 @@ private:
 
     AggregatedDataVariants _agg_data;
 
-    Arena _agg_arena_pool;
+    std::unique_ptr<Arena> _agg_arena_pool;
 
     RuntimeProfile::Counter* _build_timer;
     RuntimeProfile::Counter* _exec_timer;
     RuntimeProfile::Counter* _merge_timer;
     RuntimeProfile::Counter* _expr_timer;
     RuntimeProfile::Counter* _get_results_timer;
+    RuntimeProfile::Counter* _convert_to_two_level_timer;
+    RuntimeProfile::Counter* _spill_timer;
+    RuntimeProfile::Counter* _spill_bytes_counter;
+    RuntimeProfile::Counter* _spill_partitions_counter;
+    RuntimeProfile::Counter* _spill_max_level_counter;
 
     bool _is_streaming_preagg;
     Block _preagg_block = Block();
     bool _should_expand_hash_table = true;
     std::vector<char*> _streaming_pre_places;
 
+    // Spill of a grouping aggregation.
+    // The groups are split into _spill_partition_num partitions by the hash of the group by
+    // keys. Each time the hash table grows beyond config::vagg_spill_threshold_bytes, half of
+    // the partitions still in memory are spilled: the groups of the spilled partitions are
+    // serialized (keys + serialized aggregate states, the same layout as the output of a
+    // non-finalizing aggregation) and written to their streams, the other groups stay in the
+    // hash table. After the input is consumed, the groups in memory are returned first, then
+    // the spilled partitions are merged back and returned one by one; a partition that is
+    // still too large is spilled again with a new hash seed.
+    struct SpillPartition {
+        // the number of times the groups of this partition were partitioned
+        int level = 0;
+        // null if the partition is kept in memory
+        std::unique_ptr<VSpillStream> stream;
+    };
+    using SpillPartitionPtr = std::unique_ptr<SpillPartition>;
+
+    bool _can_spill = false;
+    bool _is_spilled = false;
+    int _spill_partition_num = 0;
+    // partitions of the hash table being spilled, the first _spilled_partition_num ones are
+    // spilled
+    std::vector<SpillPartitionPtr> _spill_partitions;
+    int _spilled_partition_num = 0;
+    // spilled partitions waiting to be merged, the front one is merged first
+    std::deque<SpillPartitionPtr> _pending_spill_partitions;
+    // whether the hash table holds a merged partition whose result is not returned yet
+    bool _spill_partition_merged = false;
+
 private:
     /// Return true if we should keep expanding hash tables in the preagg. If false,
     /// the preagg should pass through any rows it can't fit in its tables.
@@ -483,6 +660,26 @@ private:
     void _update_memusage_with_serialized_key();
     void _close_with_serialized_key();
     void _init_hash_method(std::vector<VExprContext*>& probe_exprs);
+    void _emplace_into_hash_table(AggregateDataPtr* places, ColumnRawPtrs& key_columns,
+                                  size_t rows);
+    // destroy the aggregate states and start over with an empty hash table
+    void _reset_hash_table();
+    int64_t _hash_table_bytes() const {
+        return _mem_usage_record.used_in_state + _mem_usage_record.used_in_arena;
+    }
+
+    // Write the groups of the spilled partitions of 'level' to their streams and keep the
+    // others in the hash table. If 'spill_more', half of the partitions in memory are
+    // spilled first.
+    Status _spill_hash_table(RuntimeState* state, int level, bool spill_more);
+    // Finish writing the partitions of the last spill and queue them for merging.
+    Status _finish_spill();
+    // Merge the serialized states of a spilled block into the hash table.
+    Status _merge_spilled_block(Block* block);
+    // Merge the next pending partition into the hash table, or spill it again if it is too
+    // large.
+    Status _merge_spill_partition(RuntimeState* state);
+    Status _get_spilled_result(RuntimeState* state, Block* block, bool* eos);
 
     void release_tracker();
 
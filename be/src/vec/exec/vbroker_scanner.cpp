@@ -18,14 +18,74 @@
 #include "vec/exec/vbroker_scanner.h"
 
 #include <fmt/format.h>
-#include <iostream>
-#include <sstream>
 
-#include "exec/exec_node.h"
-#include "exprs/expr_context.h"
-#include "exec/plain_text_line_reader.h"
+#include <map>
+
+#include "exec/line_reader.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/common/assert_cast.h"
+#include "vec/data_types/data_type_date.h"
+#include "vec/data_types/data_type_date_time.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vslot_ref.h"
+#include "vec/functions/function_cast.h"
 
 namespace doris::vectorized {
+
+// Parse the text of a value as the cast from string to DataType does
+template <typename DataType>
+static bool parse_value(const Slice& value, IColumn* column) {
+    typename DataType::FieldType x = 0;
+    ReadBuffer buf(value.data, value.size);
+    if (!try_parse_impl<DataType>(x, buf, nullptr) || !buf.eof()) {
+        return false;
+    }
+    assert_cast<ColumnVector<typename DataType::FieldType>&>(*column).insert_value(x);
+    return true;
+}
+
+using ParseFunc = bool (*)(const Slice&, IColumn*);
+
+static ParseFunc get_parse_func(PrimitiveType type) {
+    switch (type) {
+    case TYPE_BOOLEAN:
+        return parse_value<DataTypeUInt8>;
+    case TYPE_TINYINT:
+        return parse_value<DataTypeInt8>;
+    case TYPE_SMALLINT:
+        return parse_value<DataTypeInt16>;
+    case TYPE_INT:
+        return parse_value<DataTypeInt32>;
+    case TYPE_BIGINT:
+        return parse_value<DataTypeInt64>;
+    case TYPE_LARGEINT:
+        return parse_value<DataTypeInt128>;
+    case TYPE_FLOAT:
+        return parse_value<DataTypeFloat32>;
+    case TYPE_DOUBLE:
+        return parse_value<DataTypeFloat64>;
+    case TYPE_DATE:
+        return parse_value<DataTypeDate>;
+    case TYPE_DATETIME:
+        return parse_value<DataTypeDateTime>;
+    default:
+        return nullptr;
+    }
+}
+
+static void count_slot_refs(VExpr* expr, std::map<SlotId, int>* slot_ref_counts) {
+    if (expr->is_slot_ref()) {
+        ++(*slot_ref_counts)[static_cast<VSlotRef*>(expr)->slot_id()];
+    }
+    for (auto child : expr->children()) {
+        count_slot_refs(child, slot_ref_counts);
+    }
+}
+
 VBrokerScanner::VBrokerScanner(RuntimeState* state, RuntimeProfile* profile,
                                const TBrokerScanRangeParams& params,
                                const std::vector<TBrokerRangeDesc>& ranges,
@@ -34,18 +94,82 @@ VBrokerScanner::VBrokerScanner(RuntimeState* state, RuntimeProfile* profile,
         : BrokerScanner(state, profile, params, ranges, broker_addresses, pre_filter_texprs,
                         counter) {}
 
+Status VBrokerScanner::open() {
+    RETURN_IF_ERROR(BrokerScanner::open());
+    RETURN_IF_ERROR(init_vexpr_ctxes());
+    _init_parsed_slots();
+    return Status::OK();
+}
+
+void VBrokerScanner::_init_parsed_slots() {
+    // the preceding filter is evaluated on the strings of the source slots
+    if (!_vpre_filter_ctxs.empty()) {
+        return;
+    }
+    std::map<SlotId, int> slot_ref_counts;
+    for (auto ctx : _dest_vexpr_ctxs) {
+        count_slot_refs(ctx->root(), &slot_ref_counts);
+    }
+
+    int dest_index = -1;
+    for (auto slot_desc : _dest_tuple_desc->slots()) {
+        if (!slot_desc->is_materialized()) {
+            continue;
+        }
+        ++dest_index;
+        auto parse = get_parse_func(slot_desc->type().type);
+        VExpr* expr = _dest_vexpr_ctxs[dest_index]->root();
+        if (parse == nullptr || expr->node_type() != TExprNodeType::CAST_EXPR ||
+            expr->result_type() != slot_desc->type().type || expr->children().size() != 1 ||
+            !expr->children()[0]->is_slot_ref()) {
+            continue;
+        }
+        // the source slot must not be read by another expr
+        SlotId slot_id = static_cast<VSlotRef*>(expr->children()[0])->slot_id();
+        if (slot_ref_counts[slot_id] != 1) {
+            continue;
+        }
+        const auto& src_slots = _src_tuple_desc->slots();
+        for (int i = 0; i < src_slots.size(); ++i) {
+            int src_index = _src_slot_index[i];
+            if (src_slots[i]->id() == slot_id && src_index >= 0 &&
+                src_slots[i]->type().is_string_type()) {
+                bool is_strict = _strict_mode && _src_column_of_dest[dest_index] >= 0;
+                _parsed_slots.push_back({dest_index, src_index, slot_desc, is_strict, parse});
+                break;
+            }
+        }
+    }
+}
+
 Status VBrokerScanner::get_next(std::vector<MutableColumnPtr>& columns, bool* eof) {
     SCOPED_TIMER(_read_timer);
 
-    const int batch_size = _state->batch_size();
+    // the lines are written to the columns of the source slots directly
+    const auto& src_slots = _src_tuple_desc->slots();
+    std::vector<MutableColumnPtr> src_columns;
+    std::vector<IColumn*> file_columns(_src_slot_descs.size());
+    for (int i = 0; i < src_slots.size(); ++i) {
+        src_columns.push_back(src_slots[i]->get_empty_mutable_column());
+        if (_src_slot_index[i] >= 0) {
+            file_columns[_src_slot_index[i]] = src_columns.back().get();
+        }
+    }
+    // the values of the parsed slots are written to columns of the dest slots instead
+    std::vector<MutableColumnPtr> parsed_columns;
+    for (const auto& parsed_slot : _parsed_slots) {
+        parsed_columns.push_back(parsed_slot.dest_slot_desc->get_empty_mutable_column());
+        file_columns[parsed_slot.src_index] = nullptr;
+    }
 
-    // Get one line
-    while (columns[0]->size() < batch_size && !_scanner_eof) {
+    const int batch_size = _state->batch_size();
+    size_t num_rows = 0;
+    while (num_rows < batch_size && !_scanner_eof) {
         if (_cur_line_reader == nullptr || _cur_line_reader_eof) {
             RETURN_IF_ERROR(open_next_reader());
             // If there isn't any more reader, break this
             if (_scanner_eof) {
-                continue;
+                break;
             }
         }
         const uint8_t* ptr = nullptr;
@@ -59,231 +183,123 @@ Status VBrokerScanner::get_next(std::vector<MutableColumnPtr>& columns, bool* eo
             // Read empty row, just continue
             continue;
         }
-        {
-            COUNTER_UPDATE(_rows_read_counter, 1);
-            SCOPED_TIMER(_materialize_timer);
-            RETURN_IF_ERROR(_convert_one_row(Slice(ptr, size), columns));
-            if (_success) {
-                free_expr_local_allocations();
-            }
+        COUNTER_UPDATE(_rows_read_counter, 1);
+        RETURN_IF_ERROR(_line_split_to_values(Slice(ptr, size)));
+        if (!_success) {
+            continue;
+        }
+        bool valid = true;
+        if (!_parsed_slots.empty()) {
+            RETURN_IF_ERROR(_append_parsed_values(Slice(ptr, size), parsed_columns, &valid));
+        }
+        if (valid) {
+            _append_split_values(file_columns);
+            ++num_rows;
         }
     }
-    if (_scanner_eof) {
-        *eof = true;
-    } else {
-        *eof = false;
-    }
-    return Status::OK();
-}
 
-Status VBrokerScanner::_convert_one_row(const Slice& line, std::vector<MutableColumnPtr>& columns) {
-    RETURN_IF_ERROR(_line_to_src_tuple(line));
-    if (!_success) {
-        // If not success, which means we met an invalid row, return.
-        return Status::OK();
+    if (num_rows > 0) {
+        SCOPED_TIMER(_materialize_timer);
+        Block src_block;
+        for (int i = 0; i < src_slots.size(); ++i) {
+            if (_src_slot_index[i] < 0 || file_columns[_src_slot_index[i]] == nullptr) {
+                // not used by any expr, or only by a parsed slot
+                src_columns[i]->insert_many_defaults(num_rows);
+            }
+            src_block.insert(ColumnWithTypeAndName(std::move(src_columns[i]),
+                                                   src_slots[i]->get_data_type_ptr(),
+                                                   src_slots[i]->col_name()));
+        }
+        std::vector<ColumnPtr> parsed_dest_columns(_dest_vexpr_ctxs.size());
+        for (int i = 0; i < _parsed_slots.size(); ++i) {
+            parsed_dest_columns[_parsed_slots[i].dest_index] = std::move(parsed_columns[i]);
+        }
+        RETURN_IF_ERROR(fill_dest_columns(&src_block, columns, parsed_dest_columns));
     }
-
-    return _fill_dest_columns(columns);
+    *eof = _scanner_eof;
+    return Status::OK();
 }
 
-Status VBrokerScanner::_fill_dest_columns(std::vector<MutableColumnPtr>& columns) {
-    // filter src tuple by preceding filter first
-    if (!ExecNode::eval_conjuncts(&_pre_filter_ctxs[0], _pre_filter_ctxs.size(), _src_tuple_row)) {
-        _counter->num_rows_unselected++;
-        _success = false;
-        return Status::OK();
-    }
-    // convert and fill dest tuple
-    int ctx_idx = 0;
-    for (auto slot_desc : _dest_tuple_desc->slots()) {
-        if (!slot_desc->is_materialized()) {
-            continue;
+Status VBrokerScanner::_append_parsed_values(const Slice& line,
+                                             std::vector<MutableColumnPtr>& parsed_columns,
+                                             bool* valid) {
+    const TBrokerRangeDesc& range = _ranges.at(_next_range - 1);
+    for (int i = 0; i < _parsed_slots.size(); ++i) {
+        const ParsedSlot& parsed_slot = _parsed_slots[i];
+        IColumn* column = parsed_columns[i].get();
+        bool is_null = false;
+        Slice value;
+        if (parsed_slot.src_index < _split_values.size()) {
+            value = _split_values[parsed_slot.src_index];
+            is_null = _src_slot_descs[parsed_slot.src_index]->is_nullable() &&
+                      is_null_value(value);
+        } else {
+            // values of columns from path can not be null
+            value = Slice(range.columns_from_path[parsed_slot.src_index - _split_values.size()]);
         }
-
-        int dest_index = ctx_idx++;
-        auto* column_ptr = columns[dest_index].get();
-
-        ExprContext* ctx = _dest_expr_ctx[dest_index];
-        void* value = ctx->get_value(_src_tuple_row);
-        if (value == nullptr) {
-            // Only when the expr return value is null, we will check the error message.
-            std::string expr_error = ctx->get_error_msg();
-            if (!expr_error.empty()) {
-                RETURN_IF_ERROR(_state->append_error_msg_to_file(
-                        [&]() -> std::string {
-                            return _src_tuple_row->to_string(*(_row_desc.get()));
-                        },
-                        [&]() -> std::string { return expr_error; }, &_scanner_eof));
-                _counter->num_rows_filtered++;
-                // The ctx is reused, so must clear the error state and message.
-                ctx->clear_error_msg();
-                _success = false;
-                return Status::OK();
-            }
-            // If _strict_mode is false, _src_slot_descs_order_by_dest size could be zero
-            if (_strict_mode && (_src_slot_descs_order_by_dest[dest_index] != nullptr) &&
-                !_src_tuple->is_null(
-                        _src_slot_descs_order_by_dest[dest_index]->null_indicator_offset())) {
-                RETURN_IF_ERROR(_state->append_error_msg_to_file(
-                        [&]() -> std::string {
-                            return _src_tuple_row->to_string(*(_row_desc.get()));
-                        },
-                        [&]() -> std::string {
-                            // Type of the slot is must be Varchar in _src_tuple.
-                            StringValue* raw_value = _src_tuple->get_string_slot(
-                                    _src_slot_descs_order_by_dest[dest_index]->tuple_offset());
-                            std::string raw_string;
-                            if (raw_value != nullptr) { //is not null then get raw value
-                                raw_string = raw_value->to_string();
-                            }
-                            fmt::memory_buffer error_msg;
-                            fmt::format_to(error_msg,
-                                           "column({}) value is incorrect while strict mode is {}, "
-                                           "src value is {}",
-                                           slot_desc->col_name(), _strict_mode, raw_string);
-                            return error_msg.data();
-                        },
-                        &_scanner_eof));
-                _counter->num_rows_filtered++;
-                _success = false;
-                return Status::OK();
+        if (!is_null) {
+            if (auto* nullable_column = check_and_get_column<ColumnNullable>(*column)) {
+                if (parsed_slot.parse(value, &nullable_column->get_nested_column())) {
+                    nullable_column->get_null_map_data().push_back(0);
+                    continue;
+                }
+            } else if (parsed_slot.parse(value, column)) {
+                continue;
             }
-            if (!slot_desc->is_nullable()) {
-                RETURN_IF_ERROR(_state->append_error_msg_to_file(
-                        [&]() -> std::string {
-                            return _src_tuple_row->to_string(*(_row_desc.get()));
-                        },
-                        [&]() -> std::string {
-                            fmt::memory_buffer error_msg;
-                            fmt::format_to(
-                                    error_msg,
-                                    "column({}) values is null while columns is not nullable",
+        }
+
+        // the same checks as the result of the cast in fill_dest_columns
+        const SlotDescriptor* slot_desc = parsed_slot.dest_slot_desc;
+        std::string error_msg;
+        if (!is_null && parsed_slot.is_strict) {
+            error_msg = fmt::format(
+                    "column({}) value is incorrect while strict mode is {}, src value is {}",
+                    slot_desc->col_name(), _strict_mode, value.to_string());
+        } else if (!slot_desc->is_nullable()) {
+            error_msg = fmt::format("column({}) values is null while columns is not nullable",
                                     slot_desc->col_name());
-                            return error_msg.data();
-                        },
-                        &_scanner_eof));
-                _counter->num_rows_filtered++;
-                _success = false;
-                return Status::OK();
-            }
-            auto* nullable_column = reinterpret_cast<vectorized::ColumnNullable*>(column_ptr);
-            nullable_column->insert_data(nullptr, 0);
+        } else {
+            column->insert_default();
             continue;
         }
-        if (slot_desc->is_nullable()) {
-            auto* nullable_column = reinterpret_cast<vectorized::ColumnNullable*>(column_ptr);
-            nullable_column->get_null_map_data().push_back(0);
-            column_ptr = &nullable_column->get_nested_column();
-        }
-        char* value_ptr = (char*)value;
-        switch (slot_desc->type().type) {
-        case TYPE_BOOLEAN: {
-            assert_cast<ColumnVector<UInt8>*>(column_ptr)->insert_data(value_ptr, 0);
-            break;
-        }
-        case TYPE_TINYINT: {
-            assert_cast<ColumnVector<Int8>*>(column_ptr)->insert_data(value_ptr, 0);
-            break;
-        }
-        case TYPE_SMALLINT: {
-            assert_cast<ColumnVector<Int16>*>(column_ptr)->insert_data(value_ptr, 0);
-            break;
-        }
-        case TYPE_INT: {
-            assert_cast<ColumnVector<Int32>*>(column_ptr)->insert_data(value_ptr, 0);
-            break;
-        }
-        case TYPE_BIGINT: {
-            assert_cast<ColumnVector<Int64>*>(column_ptr)->insert_data(value_ptr, 0);
-            break;
+        // the row is filtered, remove the values of it parsed before
+        for (int j = 0; j < i; ++j) {
+            parsed_columns[j]->pop_back(1);
         }
-        case TYPE_LARGEINT: {
-            assert_cast<ColumnVector<Int128>*>(column_ptr)->insert_data(value_ptr, 0);
-            break;
-        }
-        case TYPE_FLOAT: {
-            assert_cast<ColumnVector<Float32>*>(column_ptr)->insert_data(value_ptr, 0);
-            break;
-        }
-        case TYPE_DOUBLE: {
-            assert_cast<ColumnVector<Float64>*>(column_ptr)->insert_data(value_ptr, 0);
-            break;
-        }
-        case TYPE_CHAR: {
-            Slice* slice = reinterpret_cast<Slice*>(value_ptr);
-            assert_cast<ColumnString*>(column_ptr)
-                    ->insert_data(slice->data, strnlen(slice->data, slice->size));
-            break;
-        }
-        case TYPE_VARCHAR:
-        case TYPE_STRING: {
-            Slice* slice = reinterpret_cast<Slice*>(value_ptr);
-            assert_cast<ColumnString*>(column_ptr)->insert_data(slice->data, slice->size);
-            break;
-        }
-        case TYPE_OBJECT: {
-            Slice* slice = reinterpret_cast<Slice*>(value_ptr);
-            // insert_default()
-            auto* target_column = assert_cast<ColumnBitmap*>(column_ptr);
-
-            target_column->insert_default();
-            BitmapValue* pvalue = nullptr;
-            int pos = target_column->size() - 1;
-            pvalue = &target_column->get_element(pos);
-
-            if (slice->size != 0) {
-                BitmapValue value;
-                value.deserialize(slice->data);
-                *pvalue = std::move(value);
-            } else {
-                *pvalue = std::move(*reinterpret_cast<BitmapValue*>(slice->data));
-            }
-            break;
-        }
-        case TYPE_HLL: {
-            Slice* slice = reinterpret_cast<Slice*>(value_ptr);
-            auto* target_column = assert_cast<ColumnHLL*>(column_ptr);
+        RETURN_IF_ERROR(_state->append_error_msg_to_file(
+                [&]() -> std::string { return std::string(line.data, line.size); },
+                [&]() -> std::string { return error_msg; }, &_scanner_eof));
+        _counter->num_rows_filtered++;
+        *valid = false;
+        return Status::OK();
+    }
+    *valid = true;
+    return Status::OK();
+}
 
-            target_column->insert_default();
-            HyperLogLog* pvalue = nullptr;
-            int pos = target_column->size() - 1;
-            pvalue = &target_column->get_element(pos);
-            if (slice->size != 0) {
-                HyperLogLog value;
-                value.deserialize(*slice);
-                *pvalue = std::move(value);
-            } else {
-                *pvalue = std::move(*reinterpret_cast<HyperLogLog*>(slice->data));
-            }
-            break;
-        }
-        case TYPE_DECIMALV2: {
-            assert_cast<ColumnDecimal<Decimal128>*>(column_ptr)
-                    ->insert_data(reinterpret_cast<char*>(value_ptr), 0);
-            break;
-        }
-        case TYPE_DATETIME: {
-            DateTimeValue value = *reinterpret_cast<DateTimeValue*>(value_ptr);
-            VecDateTimeValue date;
-            date.convert_dt_to_vec_dt(&value);
-            assert_cast<ColumnVector<Int64>*>(column_ptr)
-                    ->insert_data(reinterpret_cast<char*>(&date), 0);
-            break;
-        }
-        case TYPE_DATE: {
-            DateTimeValue value = *reinterpret_cast<DateTimeValue*>(value_ptr);
-            VecDateTimeValue date;
-            date.convert_dt_to_vec_dt(&value);
-            assert_cast<ColumnVector<Int64>*>(column_ptr)
-                    ->insert_data(reinterpret_cast<char*>(&date), 0);
-            break;
+void VBrokerScanner::_append_split_values(std::vector<IColumn*>& file_columns) {
+    for (int i = 0; i < _split_values.size(); ++i) {
+        IColumn* column = file_columns[i];
+        if (column == nullptr) {
+            continue;
         }
-        default: {
-            break;
+        const Slice& value = _split_values[i];
+        if (_src_slot_descs[i]->is_nullable() && is_null_value(value)) {
+            column->insert_data(nullptr, 0);
+        } else {
+            column->insert_data(value.data, value.size);
         }
+    }
+
+    // values of columns from path can not be null, they follow the columns from file
+    const TBrokerRangeDesc& range = _ranges.at(_next_range - 1);
+    for (int i = 0; i < range.columns_from_path.size(); ++i) {
+        IColumn* column = file_columns[_split_values.size() + i];
+        if (column != nullptr) {
+            const std::string& value = range.columns_from_path[i];
+            column->insert_data(value.data(), value.size());
         }
     }
-    _success = true;
-    return Status::OK();
 }
+
 } // namespace doris::vectorized
@@ -17,9 +17,18 @@
 
 #pragma once
 
-#include <exec/broker_scanner.h>
+#include "exec/broker_scanner.h"
+#include "vec/core/block.h"
 
 namespace doris::vectorized {
+
+// CSV scanner of the vectorized engine.
+//
+// The lines are split and appended to a block of the source slots, then the preceding
+// filter and the exprs of the dest slots are evaluated on the whole block.
+// When there is no preceding filter, a dest slot of a number or date type whose expr only
+// casts a source slot is parsed from the split values into a column of its own type, as
+// the cast would, so the string column of the source slot is not built for it.
 class VBrokerScanner final : public BrokerScanner {
 public:
     VBrokerScanner(RuntimeState* state, RuntimeProfile* profile,
@@ -29,10 +38,35 @@ public:
                    const std::vector<TExpr>& pre_filter_texprs, ScannerCounter* counter);
     ~VBrokerScanner() override = default;
 
+    Status open() override;
+
     Status get_next(std::vector<MutableColumnPtr>& columns, bool* eof) override;
 
 private:
-    Status _convert_one_row(const Slice& line, std::vector<MutableColumnPtr>& columns);
-    Status _fill_dest_columns(std::vector<MutableColumnPtr>& columns);
+    // A dest slot which is parsed from the split values
+    struct ParsedSlot {
+        // position in the materialized dest slots
+        int dest_index;
+        // position of the source slot in _src_slot_descs
+        int src_index;
+        const SlotDescriptor* dest_slot_desc;
+        // a value which can not be parsed filters the row, instead of being NULL
+        bool is_strict;
+        // append the value parsed to `column`, false if it can not be parsed
+        bool (*parse)(const Slice& value, IColumn* column);
+    };
+
+    // Find the dest slots which can be parsed from the split values
+    void _init_parsed_slots();
+
+    // Append the values of the parsed slots of the current line to `parsed_columns`, `valid` is
+    // false if one of them is invalid for its dest slot, then the row is filtered.
+    Status _append_parsed_values(const Slice& line, std::vector<MutableColumnPtr>& parsed_columns,
+                                 bool* valid);
+
+    // Append the values of _split_values and the columns from path as one row
+    void _append_split_values(std::vector<IColumn*>& file_columns);
+
+    std::vector<ParsedSlot> _parsed_slots;
 };
-} // namespace doris::vectorized
\ No newline at end of file
+} // namespace doris::vectorized
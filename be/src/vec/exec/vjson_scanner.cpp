@@ -0,0 +1,711 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vjson_scanner.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+
+#include "exec/line_reader.h"
+#include "exprs/json_functions.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+
+namespace doris::vectorized {
+
+VJsonScanner::VJsonScanner(RuntimeState* state, RuntimeProfile* profile,
+                           const TBrokerScanRangeParams& params,
+                           const std::vector<TBrokerRangeDesc>& ranges,
+                           const std::vector<TNetworkAddress>& broker_addresses,
+                           const std::vector<TExpr>& pre_filter_texprs, ScannerCounter* counter)
+        : JsonScanner(state, profile, params, ranges, broker_addresses, pre_filter_texprs,
+                      counter) {}
+
+VJsonScanner::~VJsonScanner() {
+    close();
+}
+
+Status VJsonScanner::open() {
+    RETURN_IF_ERROR(JsonScanner::open());
+    return init_vexpr_ctxes();
+}
+
+Status VJsonScanner::get_next(std::vector<MutableColumnPtr>& columns, bool* eof) {
+    SCOPED_TIMER(_read_timer);
+
+    // the rows are written to the columns of the source slots directly
+    const auto& src_slots = _src_tuple_desc->slots();
+    std::vector<MutableColumnPtr> src_columns;
+    std::vector<IColumn*> file_columns(_src_slot_descs.size());
+    for (int i = 0; i < src_slots.size(); ++i) {
+        src_columns.push_back(src_slots[i]->get_empty_mutable_column());
+        if (_src_slot_index[i] >= 0) {
+            file_columns[_src_slot_index[i]] = src_columns.back().get();
+        }
+    }
+
+    const int batch_size = _state->batch_size();
+    size_t num_rows = 0;
+    while (num_rows < batch_size && !_scanner_eof) {
+        if (_cur_file_reader == nullptr || _cur_reader_eof) {
+            RETURN_IF_ERROR(open_next_reader());
+            // If there isn't any more reader, break this
+            if (_scanner_eof) {
+                break;
+            }
+        }
+
+        if (_read_json_by_line && _skip_next_line) {
+            size_t size = 0;
+            const uint8_t* line_ptr = nullptr;
+            RETURN_IF_ERROR(_cur_line_reader->read_line(&line_ptr, &size, &_cur_reader_eof));
+            _skip_next_line = false;
+            continue;
+        }
+
+        bool is_empty_row = false;
+        RETURN_IF_ERROR(
+                _cur_vjson_reader->read_json_row(file_columns, &is_empty_row, &_cur_reader_eof));
+        if (!is_empty_row) {
+            ++num_rows;
+        }
+    }
+
+    if (num_rows > 0) {
+        COUNTER_UPDATE(_rows_read_counter, num_rows);
+        SCOPED_TIMER(_materialize_timer);
+        Block src_block;
+        for (int i = 0; i < src_slots.size(); ++i) {
+            if (_src_slot_index[i] < 0) {
+                // not used by any expr
+                src_columns[i]->insert_many_defaults(num_rows);
+            }
+            src_block.insert(ColumnWithTypeAndName(std::move(src_columns[i]),
+                                                   src_slots[i]->get_data_type_ptr(),
+                                                   src_slots[i]->col_name()));
+        }
+        RETURN_IF_ERROR(fill_dest_columns(&src_block, columns));
+    }
+    *eof = _scanner_eof;
+    return Status::OK();
+}
+
+Status VJsonScanner::open_json_reader() {
+    std::string json_root = "";
+    std::string jsonpath = "";
+    bool strip_outer_array = false;
+    bool num_as_string = false;
+
+    const TBrokerRangeDesc& range = _ranges[_next_range];
+    if (range.__isset.jsonpaths) {
+        jsonpath = range.jsonpaths;
+    }
+    if (range.__isset.json_root) {
+        json_root = range.json_root;
+    }
+    if (range.__isset.strip_outer_array) {
+        strip_outer_array = range.strip_outer_array;
+    }
+    if (range.__isset.num_as_string) {
+        num_as_string = range.num_as_string;
+    }
+    // fuzzy_parse is not needed, the fields are matched in one pass anyway
+    if (_read_json_by_line) {
+        _cur_vjson_reader.reset(new VJsonReader(_state, _counter, _profile, strip_outer_array,
+                                                num_as_string, &_scanner_eof, nullptr,
+                                                _cur_line_reader));
+    } else {
+        _cur_vjson_reader.reset(new VJsonReader(_state, _counter, _profile, strip_outer_array,
+                                                num_as_string, &_scanner_eof, _cur_file_reader));
+    }
+    return _cur_vjson_reader->init(jsonpath, json_root, _src_slot_descs);
+}
+
+void VJsonScanner::close() {
+    _cur_vjson_reader.reset();
+    JsonScanner::close();
+}
+
+////// class VJsonReader
+VJsonReader::PathNode* VJsonReader::PathNode::add_key(const std::string& key) {
+    for (int i = 0; i < keys.size(); ++i) {
+        if (keys[i] == key) {
+            return key_children[i].get();
+        }
+    }
+    keys.push_back(key);
+    key_children.emplace_back(new PathNode());
+    return key_children.back().get();
+}
+
+VJsonReader::PathNode* VJsonReader::PathNode::add_element(int idx) {
+    for (auto& [i, child] : element_children) {
+        if (i == idx) {
+            return child.get();
+        }
+    }
+    element_children.emplace_back(idx, new PathNode());
+    return element_children.back().second.get();
+}
+
+// key_index refers to the strings in keys, so it is built after all the paths are added
+void VJsonReader::PathNode::build_index() {
+    for (int i = 0; i < keys.size(); ++i) {
+        key_index.emplace(keys[i], key_children[i].get());
+        key_children[i]->build_index();
+    }
+    for (auto& [i, child] : element_children) {
+        child->build_index();
+    }
+}
+
+VJsonReader::VJsonReader(RuntimeState* state, ScannerCounter* counter, RuntimeProfile* profile,
+                         bool strip_outer_array, bool num_as_string, bool* scanner_eof,
+                         FileReader* file_reader, LineReader* line_reader)
+        : _state(state),
+          _counter(counter),
+          _profile(profile),
+          _file_reader(file_reader),
+          _line_reader(line_reader),
+          _strip_outer_array(strip_outer_array),
+          _num_as_string(num_as_string),
+          _scanner_eof(scanner_eof) {
+    _bytes_read_counter = ADD_COUNTER(_profile, "BytesRead", TUnit::BYTES);
+    _read_timer = ADD_TIMER(_profile, "ReadTime");
+    _file_read_timer = ADD_TIMER(_profile, "FileReadTime");
+}
+
+VJsonReader::~VJsonReader() = default;
+
+static Status simdjson_error(simdjson::error_code error) {
+    return Status::DataQualityError(
+            fmt::format("Parse json data for JsonDoc failed. code: {}, error info: {}",
+                        static_cast<int>(error), simdjson::error_message(error)));
+}
+
+#define RETURN_IF_SIMDJSON_ERROR(stmt)        \
+    do {                                      \
+        simdjson::error_code _error = (stmt); \
+        if (UNLIKELY(_error)) {               \
+            return simdjson_error(_error);    \
+        }                                     \
+    } while (false)
+
+Status VJsonReader::init(const std::string& jsonpath, const std::string& json_root,
+                         const std::vector<SlotDescriptor*>& slot_descs) {
+    _slot_descs = slot_descs;
+    _written.resize(slot_descs.size());
+    if (!jsonpath.empty()) {
+        rapidjson::Document jsonpaths_doc;
+        if (jsonpaths_doc.Parse(jsonpath.c_str(), jsonpath.length()).HasParseError() ||
+            !jsonpaths_doc.IsArray()) {
+            return Status::InvalidArgument("Invalid json path: " + jsonpath);
+        }
+        for (int i = 0; i < jsonpaths_doc.Size(); i++) {
+            const rapidjson::Value& path = jsonpaths_doc[i];
+            if (!path.IsString()) {
+                return Status::InvalidArgument("Invalid json path: " + jsonpath);
+            }
+            std::vector<JsonPath> parsed_path;
+            JsonFunctions::parse_json_paths(path.GetString(), &parsed_path);
+            // the columns without a path are never matched
+            if (i < slot_descs.size()) {
+                RETURN_IF_ERROR(_add_path(parsed_path, i));
+            }
+        }
+        _has_jsonpaths = true;
+    } else {
+        for (int i = 0; i < slot_descs.size(); ++i) {
+            _root_node.add_key(slot_descs[i]->col_name())->columns.push_back(i);
+        }
+    }
+    _root_node.build_index();
+
+    if (!json_root.empty()) {
+        std::vector<JsonPath> parsed_root;
+        JsonFunctions::parse_json_paths(json_root, &parsed_root);
+        for (int i = 0; i < parsed_root.size(); ++i) {
+            if (!parsed_root[i].is_valid || parsed_root[i].idx == -2) {
+                return Status::InvalidArgument("Invalid json root: " + json_root);
+            }
+            if (i == 0) {
+                continue;
+            }
+            // see RFC 6901 for the escaping
+            if (!parsed_root[i].key.empty()) {
+                _json_root_pointer.push_back('/');
+                for (char c : parsed_root[i].key) {
+                    if (c == '~') {
+                        _json_root_pointer.append("~0");
+                    } else if (c == '/') {
+                        _json_root_pointer.append("~1");
+                    } else {
+                        _json_root_pointer.push_back(c);
+                    }
+                }
+            }
+            if (parsed_root[i].idx >= 0) {
+                _json_root_pointer.append(fmt::format("/{}", parsed_root[i].idx));
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status VJsonReader::_add_path(const std::vector<JsonPath>& path, int column) {
+    if (path.empty() || !path[0].is_valid) {
+        return Status::OK();
+    }
+    PathNode* node = &_root_node;
+    for (int i = 1; i < path.size(); ++i) {
+        if (!path[i].is_valid) {
+            return Status::OK();
+        }
+        if (!path[i].key.empty()) {
+            node = node->add_key(path[i].key);
+        }
+        if (path[i].idx >= 0) {
+            node = node->add_element(path[i].idx);
+        } else if (path[i].idx == -2 && i != path.size() - 1) {
+            // `[*]` at the end selects the whole array
+            return Status::InvalidArgument(
+                    fmt::format("Unsupported json path: {}, `[*]` must be at the end",
+                                path[i].to_string()));
+        }
+    }
+    node->columns.push_back(column);
+    return Status::OK();
+}
+
+Status VJsonReader::_append_error(const std::string& error_msg) {
+    RETURN_IF_ERROR(_state->append_error_msg_to_file(
+            [&]() -> std::string { return _doc_text(); },
+            [&]() -> std::string { return error_msg; }, _scanner_eof));
+    _counter->num_rows_filtered++;
+    return Status::OK();
+}
+
+Status VJsonReader::_doc_error(const std::string& error_msg, bool* eof) {
+    RETURN_IF_ERROR(_append_error(error_msg));
+    if (*_scanner_eof) {
+        // we meet enough invalid rows and the scanner should be stopped, see
+        // JsonReader::_parse_json_doc()
+        *eof = true;
+        return Status::OK();
+    }
+    return Status::DataQualityError(error_msg);
+}
+
+// read one json string from line reader or file reader and start iterating it.
+// return Status::DataQualityError() if data has quality error.
+// return other error if encounter other problemes.
+// return Status::OK() if parse succeed or reach EOF.
+Status VJsonReader::_parse_json_doc(size_t* size, bool* eof) {
+    // read a whole message
+    SCOPED_TIMER(_file_read_timer);
+    _has_rows = false;
+    const uint8_t* json_str = nullptr;
+    std::unique_ptr<uint8_t[]> json_str_ptr;
+    if (_line_reader != nullptr) {
+        RETURN_IF_ERROR(_line_reader->read_line(&json_str, size, eof));
+    } else {
+        int64_t length = 0;
+        RETURN_IF_ERROR(_file_reader->read_one_message(&json_str_ptr, &length));
+        json_str = json_str_ptr.get();
+        *size = length;
+        if (length == 0) {
+            *eof = true;
+        }
+    }
+
+    COUNTER_UPDATE(_bytes_read_counter, *size);
+    if (*eof) {
+        return Status::OK();
+    }
+
+    // simdjson reads up to SIMDJSON_PADDING bytes past the end of the message
+    if (_buffer_capacity < *size + simdjson::SIMDJSON_PADDING) {
+        _buffer_capacity = std::max(*size + simdjson::SIMDJSON_PADDING, _buffer_capacity * 2);
+        _buffer.reset(new char[_buffer_capacity]);
+    }
+    memcpy(_buffer.get(), json_str, *size);
+    _buffer_size = *size;
+
+    simdjson::ondemand::value root;
+    auto error = _parser.iterate(_buffer.get(), _buffer_size, _buffer_capacity).get(_doc);
+    if (!error) {
+        if (_json_root_pointer.empty()) {
+            error = _doc.get_value().get(root);
+        } else {
+            error = _doc.at_pointer(_json_root_pointer).get(root);
+            if (error == simdjson::NO_SUCH_FIELD || error == simdjson::INDEX_OUT_OF_BOUNDS) {
+                return _doc_error("JSON Root not found.", eof);
+            }
+        }
+    }
+    simdjson::ondemand::json_type type;
+    if (!error) {
+        error = root.type().get(type);
+    }
+    if (error) {
+        return _doc_error(simdjson_error(error).get_error_msg(), eof);
+    }
+
+    if (type == simdjson::ondemand::json_type::array && !_strip_outer_array) {
+        return _doc_error("JSON data is array-object, `strip_outer_array` must be TRUE.", eof);
+    }
+    if (type != simdjson::ondemand::json_type::array && _strip_outer_array) {
+        return _doc_error("JSON data is not an array-object, `strip_outer_array` must be FALSE.",
+                          eof);
+    }
+
+    if (type == simdjson::ondemand::json_type::array) {
+        simdjson::ondemand::array array;
+        error = root.get_array().get(array);
+        if (!error) {
+            error = array.begin().get(_array_iter);
+        }
+        if (!error) {
+            error = array.end().get(_array_end);
+        }
+        if (error) {
+            return _doc_error(simdjson_error(error).get_error_msg(), eof);
+        }
+        _in_array = true;
+    } else {
+        _row = root;
+        _in_array = false;
+    }
+    _has_rows = true;
+    return Status::OK();
+}
+
+Status VJsonReader::read_json_row(std::vector<IColumn*>& columns, bool* is_empty_row,
+                                  bool* eof) {
+    SCOPED_TIMER(_read_timer);
+    while (true) {
+        if (!_has_rows) {
+            size_t size = 0;
+            Status st = _parse_json_doc(&size, eof);
+            if (st.is_data_quality_error()) {
+                continue; // continue to read next
+            }
+            RETURN_IF_ERROR(st);     // terminate if encounter other errors
+            if (size == 0 || *eof) { // read all data, then return
+                *is_empty_row = true;
+                return Status::OK();
+            }
+            if (_in_array && _array_iter == _array_end) {
+                _has_rows = false;
+                if (!_has_jsonpaths) {
+                    // may be passing an empty json, such as "[]"
+                    RETURN_IF_ERROR(_append_error("Empty json line"));
+                    if (*_scanner_eof) {
+                        *is_empty_row = true;
+                        return Status::OK();
+                    }
+                }
+                continue;
+            }
+        }
+
+        bool valid = true;
+        if (_in_array) {
+            if (_array_iter == _array_end) {
+                _has_rows = false;
+                continue;
+            }
+            auto error = (*_array_iter).get(_row);
+            if (error) {
+                // the rest of the document can not be read
+                _has_rows = false;
+                RETURN_IF_ERROR(_append_error(simdjson_error(error).get_error_msg()));
+                valid = false;
+            }
+        }
+        if (valid) {
+            RETURN_IF_ERROR(_set_column_values(_row, columns, &valid));
+            if (_in_array && _has_rows) {
+                ++_array_iter;
+            } else {
+                _has_rows = false;
+            }
+        }
+        if (!valid) {
+            if (*_scanner_eof) {
+                // When _scanner_eof is true and valid is false, it means that we have encountered
+                // unqualified data and decided to stop the scan.
+                *is_empty_row = true;
+                return Status::OK();
+            }
+            continue;
+        }
+        *is_empty_row = false;
+        return Status::OK();
+    }
+}
+
+// set valid to true and return OK if succeed.
+// set valid to false and return OK if we met an invalid row.
+// return other status if encounter other problmes.
+Status VJsonReader::_set_column_values(simdjson::ondemand::value& row,
+                                       std::vector<IColumn*>& columns, bool* valid) {
+    std::fill(_written.begin(), _written.end(), 0);
+    auto rollback = [&]() {
+        for (int i = 0; i < columns.size(); ++i) {
+            if (_written[i]) {
+                columns[i]->pop_back(1);
+            }
+        }
+    };
+
+    Status st = Status::OK();
+    simdjson::ondemand::json_type type;
+    auto error = row.type().get(type);
+    if (error) {
+        st = simdjson_error(error);
+    } else if (!_has_jsonpaths && type != simdjson::ondemand::json_type::object) {
+        // Here we expect the incoming row to be a Json Object, such as {"key" : "value"},
+        // not other type of Json format.
+        RETURN_IF_ERROR(_append_error("Expect json object value"));
+        *valid = false;
+        return Status::OK();
+    } else {
+        st = _match_paths(row, _root_node, 0, columns, valid);
+    }
+    if (!st.ok() || !*valid) {
+        rollback();
+        if (st.is_data_quality_error()) {
+            // the json is broken, the rest of the document can not be read
+            _has_rows = false;
+            RETURN_IF_ERROR(_append_error(st.get_error_msg()));
+            *valid = false;
+            return Status::OK();
+        }
+        return st;
+    }
+
+    int nullcount = 0;
+    for (int i = 0; i < columns.size(); ++i) {
+        if (_written[i]) {
+            continue;
+        }
+        if (!_slot_descs[i]->is_nullable()) {
+            rollback();
+            RETURN_IF_ERROR(_append_error(fmt::format(
+                    "The column `{}` is not nullable, but it's not found in jsondata.",
+                    _slot_descs[i]->col_name())));
+            *valid = false;
+            return Status::OK();
+        }
+        columns[i]->insert_default();
+        _written[i] = 1;
+        nullcount++;
+    }
+    if (nullcount == columns.size()) {
+        rollback();
+        RETURN_IF_ERROR(_append_error(
+                _has_jsonpaths ? "All fields is null or not matched, this is a invalid row."
+                               : "All fields is null, this is a invalid row."));
+        *valid = false;
+        return Status::OK();
+    }
+    *valid = true;
+    return Status::OK();
+}
+
+Status VJsonReader::_match_paths(simdjson::ondemand::value& value, const PathNode& node,
+                                 int depth, std::vector<IColumn*>& columns, bool* valid) {
+    simdjson::ondemand::json_type type;
+    RETURN_IF_SIMDJSON_ERROR(value.type().get(type));
+    bool is_container = type == simdjson::ondemand::json_type::object ||
+                        type == simdjson::ondemand::json_type::array;
+    if (!node.columns.empty()) {
+        if (!node.has_children() || !is_container) {
+            return _write_value(value, node.columns, columns, valid);
+        }
+        // Some paths end at the value and some go into it, while the value can only be
+        // iterated once. So the text of it is written, then parsed again for the others.
+        std::string_view text;
+        RETURN_IF_SIMDJSON_ERROR(simdjson::to_json_string(value).get(text));
+        _write_json_text(text, node.columns, columns);
+        if (_sub_parsers.size() <= depth) {
+            _sub_parsers.resize(depth + 1);
+            _sub_texts.resize(depth + 1);
+        }
+        if (_sub_parsers[depth] == nullptr) {
+            _sub_parsers[depth].reset(new simdjson::ondemand::parser());
+        }
+        _sub_texts[depth] = simdjson::padded_string(text);
+        simdjson::ondemand::document doc;
+        simdjson::ondemand::value sub_value;
+        RETURN_IF_SIMDJSON_ERROR(_sub_parsers[depth]->iterate(_sub_texts[depth]).get(doc));
+        RETURN_IF_SIMDJSON_ERROR(doc.get_value().get(sub_value));
+        return _match_children(sub_value, type, node, depth + 1, columns, valid);
+    }
+    return _match_children(value, type, node, depth, columns, valid);
+}
+
+Status VJsonReader::_match_children(simdjson::ondemand::value& value,
+                                    simdjson::ondemand::json_type type, const PathNode& node,
+                                    int depth, std::vector<IColumn*>& columns, bool* valid) {
+    if (type == simdjson::ondemand::json_type::object && !node.keys.empty()) {
+        simdjson::ondemand::object object;
+        RETURN_IF_SIMDJSON_ERROR(value.get_object().get(object));
+        for (auto field_result : object) {
+            simdjson::ondemand::field field;
+            std::string_view key;
+            RETURN_IF_SIMDJSON_ERROR(field_result.get(field));
+            RETURN_IF_SIMDJSON_ERROR(field.unescaped_key().get(key));
+            auto it = node.key_index.find(key);
+            if (it == node.key_index.end()) {
+                // skipped without being parsed
+                continue;
+            }
+            RETURN_IF_ERROR(_match_paths(field.value(), *it->second, depth, columns, valid));
+            if (!*valid) {
+                return Status::OK();
+            }
+        }
+    } else if (type == simdjson::ondemand::json_type::array && !node.element_children.empty()) {
+        simdjson::ondemand::array array;
+        RETURN_IF_SIMDJSON_ERROR(value.get_array().get(array));
+        int idx = 0;
+        for (auto element_result : array) {
+            for (auto& [i, child] : node.element_children) {
+                if (i != idx) {
+                    continue;
+                }
+                simdjson::ondemand::value element;
+                RETURN_IF_SIMDJSON_ERROR(element_result.get(element));
+                RETURN_IF_ERROR(_match_paths(element, *child, depth, columns, valid));
+                if (!*valid) {
+                    return Status::OK();
+                }
+                break;
+            }
+            ++idx;
+        }
+    }
+    // the other values can not match the paths
+    return Status::OK();
+}
+
+// The values are converted to the same text as JsonReader::_write_data_to_tuple() does.
+Status VJsonReader::_write_value(simdjson::ondemand::value& value,
+                                 const std::vector<int>& node_columns,
+                                 std::vector<IColumn*>& columns, bool* valid) {
+    simdjson::ondemand::json_type type;
+    RETURN_IF_SIMDJSON_ERROR(value.type().get(type));
+    switch (type) {
+    case simdjson::ondemand::json_type::string: {
+        std::string_view str;
+        RETURN_IF_SIMDJSON_ERROR(value.get_string().get(str));
+        _write_data(node_columns, columns, str.data(), str.size());
+        break;
+    }
+    case simdjson::ondemand::json_type::number: {
+        std::string_view token = value.raw_json_token();
+        while (!token.empty() && isspace(token.back())) {
+            token.remove_suffix(1);
+        }
+        if (_num_as_string) {
+            _write_data(node_columns, columns, token.data(), token.size());
+            break;
+        }
+        if (token.find_first_of(".eE") == std::string_view::npos) {
+            int64_t int_value = 0;
+            auto res = std::from_chars(token.data(), token.data() + token.size(), int_value);
+            if (res.ec == std::errc() && res.ptr == token.data() + token.size()) {
+                fmt::format_int text(int_value);
+                _write_data(node_columns, columns, text.data(), text.size());
+                break;
+            }
+            uint64_t uint_value = 0;
+            res = std::from_chars(token.data(), token.data() + token.size(), uint_value);
+            if (res.ec == std::errc() && res.ptr == token.data() + token.size()) {
+                fmt::format_int text(uint_value);
+                _write_data(node_columns, columns, text.data(), text.size());
+                break;
+            }
+        }
+        // out of the range of integers, the same as rapidjson
+        double double_value = 0;
+        RETURN_IF_SIMDJSON_ERROR(value.get_double().get(double_value));
+        std::string text = fmt::format("{:f}", double_value);
+        _write_data(node_columns, columns, text.data(), text.size());
+        break;
+    }
+    case simdjson::ondemand::json_type::boolean: {
+        bool bool_value = false;
+        RETURN_IF_SIMDJSON_ERROR(value.get_bool().get(bool_value));
+        _write_data(node_columns, columns, bool_value ? "1" : "0", 1);
+        break;
+    }
+    case simdjson::ondemand::json_type::null:
+        for (int column : node_columns) {
+            if (_written[column]) {
+                continue;
+            }
+            if (!_slot_descs[column]->is_nullable()) {
+                RETURN_IF_ERROR(_append_error(
+                        fmt::format("Json value is null, but the column `{}` is not nullable.",
+                                    _slot_descs[column]->col_name())));
+                *valid = false;
+                return Status::OK();
+            }
+            columns[column]->insert_default();
+            _written[column] = 1;
+        }
+        break;
+    default: {
+        // for other type like array or object. we convert it to string to save
+        std::string_view text;
+        RETURN_IF_SIMDJSON_ERROR(simdjson::to_json_string(value).get(text));
+        _write_json_text(text, node_columns, columns);
+        break;
+    }
+    }
+    return Status::OK();
+}
+
+void VJsonReader::_write_json_text(std::string_view text, const std::vector<int>& node_columns,
+                                   std::vector<IColumn*>& columns) {
+    // the same compact text as rapidjson::Writer
+    _minified.resize(text.size());
+    size_t length = 0;
+    if (simdjson::minify(text.data(), text.size(), _minified.data(), length)) {
+        _write_data(node_columns, columns, text.data(), text.size());
+    } else {
+        _write_data(node_columns, columns, _minified.data(), length);
+    }
+}
+
+void VJsonReader::_write_data(const std::vector<int>& node_columns,
+                              std::vector<IColumn*>& columns, const char* data, size_t size) {
+    for (int column : node_columns) {
+        if (!_written[column]) {
+            columns[column]->insert_data(data, size);
+            _written[column] = 1;
+        }
+    }
+}
+
+} // namespace doris::vectorized
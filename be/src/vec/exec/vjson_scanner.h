@@ -0,0 +1,163 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <simdjson.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "exec/json_scanner.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+struct JsonPath;
+
+namespace vectorized {
+
+class VJsonReader;
+
+// JSON scanner of the vectorized engine, used by the broker load, the stream load and
+// the routine load.
+//
+// The rows are parsed by VJsonReader and written to a block of the source slots, then the
+// preceding filter and the exprs of the dest slots are evaluated on the whole block.
+class VJsonScanner final : public JsonScanner {
+public:
+    VJsonScanner(RuntimeState* state, RuntimeProfile* profile,
+                 const TBrokerScanRangeParams& params, const std::vector<TBrokerRangeDesc>& ranges,
+                 const std::vector<TNetworkAddress>& broker_addresses,
+                 const std::vector<TExpr>& pre_filter_texprs, ScannerCounter* counter);
+    ~VJsonScanner() override;
+
+    Status open() override;
+
+    Status get_next(std::vector<MutableColumnPtr>& columns, bool* eof) override;
+
+    void close() override;
+
+private:
+    Status open_json_reader() override;
+
+    std::unique_ptr<VJsonReader> _cur_vjson_reader;
+};
+
+// Reader to parse the json with the on demand API of simdjson.
+//
+// The fields selected by the jsonpaths, or named by the slots if there is no jsonpaths,
+// are matched in a single pass over each row and written to the columns directly, the
+// other fields are skipped without being parsed.
+// Like JsonReader, the methods return Status::OK() if succeed or encounter data quality
+// error, and return other error Status if encounter other errors.
+class VJsonReader {
+public:
+    VJsonReader(RuntimeState* state, ScannerCounter* counter, RuntimeProfile* profile,
+                bool strip_outer_array, bool num_as_string, bool* scanner_eof,
+                FileReader* file_reader = nullptr, LineReader* line_reader = nullptr);
+
+    ~VJsonReader();
+
+    // must call before use
+    Status init(const std::string& jsonpath, const std::string& json_root,
+                const std::vector<SlotDescriptor*>& slot_descs);
+
+    // Append one row to `columns`, which are the columns of `slot_descs` passed to init().
+    Status read_json_row(std::vector<IColumn*>& columns, bool* is_empty_row, bool* eof);
+
+private:
+    // The paths to match, a field or an element of the value maps to a child node, and
+    // the columns of the paths ending at the value are listed in `columns`.
+    struct PathNode {
+        std::vector<int> columns;
+        std::vector<std::string> keys;
+        std::vector<std::unique_ptr<PathNode>> key_children;
+        std::unordered_map<std::string_view, PathNode*> key_index;
+        std::vector<std::pair<int, std::unique_ptr<PathNode>>> element_children;
+
+        bool has_children() const { return !keys.empty() || !element_children.empty(); }
+        PathNode* add_key(const std::string& key);
+        PathNode* add_element(int idx);
+        void build_index();
+    };
+
+    Status _add_path(const std::vector<JsonPath>& path, int column);
+    Status _parse_json_doc(size_t* size, bool* eof);
+    Status _set_column_values(simdjson::ondemand::value& row, std::vector<IColumn*>& columns,
+                              bool* valid);
+    Status _match_paths(simdjson::ondemand::value& value, const PathNode& node, int depth,
+                        std::vector<IColumn*>& columns, bool* valid);
+    Status _match_children(simdjson::ondemand::value& value, simdjson::ondemand::json_type type,
+                           const PathNode& node, int depth, std::vector<IColumn*>& columns,
+                           bool* valid);
+    Status _write_value(simdjson::ondemand::value& value, const std::vector<int>& node_columns,
+                        std::vector<IColumn*>& columns, bool* valid);
+    void _write_json_text(std::string_view text, const std::vector<int>& node_columns,
+                          std::vector<IColumn*>& columns);
+    void _write_data(const std::vector<int>& node_columns, std::vector<IColumn*>& columns,
+                     const char* data, size_t size);
+    Status _append_error(const std::string& error_msg);
+    Status _doc_error(const std::string& error_msg, bool* eof);
+    std::string _doc_text() const { return std::string(_buffer.get(), _buffer_size); }
+
+    RuntimeState* _state;
+    ScannerCounter* _counter;
+    RuntimeProfile* _profile;
+    FileReader* _file_reader;
+    LineReader* _line_reader;
+    bool _strip_outer_array;
+    bool _num_as_string;
+    RuntimeProfile::Counter* _bytes_read_counter;
+    RuntimeProfile::Counter* _read_timer;
+    RuntimeProfile::Counter* _file_read_timer;
+
+    std::vector<SlotDescriptor*> _slot_descs;
+    bool _has_jsonpaths = false;
+    PathNode _root_node;
+    std::string _json_root_pointer;
+    // a column is written at most once per row
+    std::vector<uint8_t> _written;
+
+    // the message read with SIMDJSON_PADDING bytes reserved
+    std::unique_ptr<char[]> _buffer;
+    size_t _buffer_size = 0;
+    size_t _buffer_capacity = 0;
+
+    simdjson::ondemand::parser _parser;
+    simdjson::ondemand::document _doc;
+    // the rows of the current document not read yet
+    bool _has_rows = false;
+    bool _in_array = false;
+    simdjson::ondemand::value _row;
+    simdjson::ondemand::array_iterator _array_iter;
+    simdjson::ondemand::array_iterator _array_end;
+
+    // parsers of the values that some paths end at and some go into, by depth
+    std::vector<std::unique_ptr<simdjson::ondemand::parser>> _sub_parsers;
+    std::vector<simdjson::padded_string> _sub_texts;
+    std::string _minified;
+
+    // point to the _scanner_eof of VJsonScanner
+    bool* _scanner_eof;
+};
+
+} // namespace vectorized
+} // namespace doris
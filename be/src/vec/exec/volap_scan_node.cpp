@@ -21,8 +21,9 @@
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_filter_mgr.h"
-#include "util/priority_thread_pool.hpp"
+#include "util/time.h"
 #include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
 #include "vec/exec/volap_scanner.h"
 #include "vec/exprs/vexpr.h"
 
@@ -50,19 +51,8 @@ void VOlapScanNode::transfer_thread(RuntimeState* state) {
         }
     }
 
-    /*********************************
-     * 优先级调度基本策略:
-     * 1. 通过查询拆分的Range个数来确定初始nice值
-     *    Range个数越多，越倾向于认定为大查询，nice值越小
-     * 2. 通过查询累计读取的数据量来调整nice值
-     *    读取的数据越多，越倾向于认定为大查询，nice值越小
-     * 3. 通过nice值来判断查询的优先级
-     *    nice值越大的，越优先获得的查询资源
-     * 4. 定期提高队列内残留任务的优先级，避免大查询完全饿死
-     *********************************/
-    _total_assign_num = 0;
-    _nice = 18 + std::max(0, 2 - (int)_volap_scanners.size() / 5);
-
+    // The priority of the scanners is decided by the ScanScheduler, according to
+    // the cpu time the query has used.
     auto doris_scanner_row_num =
             _limit == -1 ? config::doris_scanner_row_num
                          : std::min(static_cast<int64_t>(config::doris_scanner_row_num), _limit);
@@ -71,7 +61,7 @@ void VOlapScanNode::transfer_thread(RuntimeState* state) {
     auto block_per_scanner = (doris_scanner_row_num + (_block_size - 1)) / _block_size;
     auto pre_block_count =
             std::min(_volap_scanners.size(),
-                     static_cast<size_t>(config::doris_scanner_thread_pool_thread_num)) *
+                     static_cast<size_t>(state->exec_env()->scan_scheduler()->num_threads())) *
             block_per_scanner;
 
     for (int i = 0; i < pre_block_count; ++i) {
@@ -91,13 +81,6 @@ void VOlapScanNode::transfer_thread(RuntimeState* state) {
             // 1 scanner idle task not empty, assign new scanner task
             std::unique_lock<std::mutex> l(_scan_blocks_lock);
 
-            // scanner_row_num = 16k
-            // 16k * 10 * 12 * 8 = 15M(>2s)  --> nice=10
-            // 16k * 20 * 22 * 8 = 55M(>6s)  --> nice=0
-            while (_nice > 0 && _total_assign_num > (22 - _nice) * (20 - _nice) * 6) {
-                --_nice;
-            }
-
             // 2 wait when all scanner are running & no result in queue
             while (UNLIKELY(_running_thread == assigned_thread_num && _scan_blocks.empty() &&
                             !_scanner_done)) {
@@ -147,6 +130,8 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
     // (_scan_cpu_timer, the class member) is not destroyed after `_running_thread==0`.
     ThreadCpuStopWatch cpu_watch;
     cpu_watch.start();
+    MonotonicStopWatch run_watch;
+    run_watch.start();
     Status status = Status::OK();
     bool eos = false;
     RuntimeState* state = scanner->runtime_state();
@@ -162,6 +147,7 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
     }
 
     std::vector<ExprContext*> contexts;
+    std::vector<TCondition> runtime_conditions;
     auto& scanner_filter_apply_marks = *scanner->mutable_runtime_filter_marks();
     DCHECK(scanner_filter_apply_marks.size() == _runtime_filter_descs.size());
     for (size_t i = 0; i < scanner_filter_apply_marks.size(); i++) {
@@ -172,8 +158,10 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
             DCHECK(runtime_filter != nullptr);
             bool ready = runtime_filter->is_ready();
             if (ready) {
+                // must be called before get_prepared_context
+                runtime_filter->get_olap_conditions(*_tuple_desc, &runtime_conditions);
                 runtime_filter->get_prepared_context(&contexts, row_desc(), _expr_mem_tracker);
-                _runtime_filter_ctxs[i].apply_mark = true;
+                scanner_filter_apply_marks[i] = true;
             }
         }
     }
@@ -186,6 +174,19 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
                                      new_contexts.end());
         scanner->set_use_pushdown_conjuncts(true);
     }
+    // the filter arrived after the scan started, skip the pages not read yet which can not
+    // pass it by zone map and bloom filter index
+    if (!runtime_conditions.empty() && !eos) {
+        scanner->add_runtime_conditions(runtime_conditions);
+    }
+    if (_topn_filter != nullptr && !eos &&
+        _topn_filter->version() > scanner->topn_filter_version()) {
+        std::vector<TCondition> topn_conditions;
+        scanner->set_topn_filter_version(_topn_filter->get_olap_conditions(&topn_conditions));
+        if (!topn_conditions.empty()) {
+            scanner->add_runtime_conditions(topn_conditions);
+        }
+    }
 
     std::vector<Block*> blocks;
 
@@ -195,14 +196,17 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
     // data in pre-aggregate mode, then we can't use storage returned data to
     // judge if we need to yield. So we record all raw data read in this round
     // scan, if this exceed row number or bytes threshold, we yield this thread.
+    // A scanner reading few rows for a long time, e.g. with a selective filter,
+    // also yields when it has run longer than the time slice.
     int64_t raw_rows_read = scanner->raw_rows_read();
     int64_t raw_rows_threshold = raw_rows_read + config::doris_scanner_row_num;
     int64_t raw_bytes_read = 0;
     int64_t raw_bytes_threshold = config::doris_scanner_row_bytes;
+    int64_t max_run_time_ns = config::doris_scanner_max_run_time_ms * NANOS_PER_MILLIS;
     bool get_free_block = true;
 
     while (!eos && raw_rows_read < raw_rows_threshold && raw_bytes_read < raw_bytes_threshold &&
-           get_free_block) {
+           get_free_block && run_watch.elapsed_time() < max_run_time_ns) {
         if (UNLIKELY(_transfer_done)) {
             eos = true;
             status = Status::Cancelled("Cancelled");
@@ -283,6 +287,8 @@ void VOlapScanNode::scanner_thread(VOlapScanner* scanner) {
     }
     _scan_cpu_timer->update(cpu_watch.elapsed_time());
     _scanner_wait_worker_timer->update(wait_time);
+    _scanner_run_timer->update(run_watch.elapsed_time());
+    _scanner_sched_counter->update(1);
 
     std::unique_lock<std::mutex> l(_scan_blocks_lock);
     _running_thread--;
@@ -322,6 +328,23 @@ Status VOlapScanNode::start_scan_thread(RuntimeState* state) {
     }
     _block_mem_tracker = MemTracker::create_virtual_tracker(-1, "VOlapScanNode:Block");
 
+    ScanScheduler* scan_scheduler = state->exec_env()->scan_scheduler();
+    _scan_share = scan_scheduler->get_or_create_share(
+            state->query_id(), _resource_info != nullptr ? _resource_info->group : "");
+    _scanner_run_timer = ADD_TIMER(_runtime_profile, "ScannerRunTime");
+    _scanner_sched_counter = ADD_COUNTER(_runtime_profile, "ScannerSchedCount", TUnit::UNIT);
+    if (_topn_filter != nullptr) {
+        _topn_filtered_counter = ADD_COUNTER(_runtime_profile, "RowsTopNFiltered", TUnit::UNIT);
+    }
+    if (config::enable_dict_code_filter && _vconjunct_ctx_ptr) {
+        VDictCodeFilter::create_filters(*_vconjunct_ctx_ptr, _tuple_desc->slots(),
+                                        &_dict_code_filters);
+    }
+    if (!_dict_code_filters.empty()) {
+        _dict_code_filtered_counter =
+                ADD_COUNTER(_runtime_profile, "RowsDictCodeFiltered", TUnit::UNIT);
+    }
+
     // ranges constructed from scan keys
     std::vector<std::unique_ptr<OlapScanRange>> cond_ranges;
     RETURN_IF_ERROR(_scan_keys.get_key_range(&cond_ranges));
@@ -372,6 +395,14 @@ Status VOlapScanNode::start_scan_thread(RuntimeState* state) {
             _scanner_pool.add(scanner);
             RETURN_IF_ERROR(scanner->prepare(*scan_range, scanner_ranges, _olap_filter,
                                              _bloom_filters_push_down));
+            scanner->set_scan_queue_id(scan_scheduler->next_queue_id());
+            if (_topn_filter != nullptr) {
+                scanner->set_topn_filter(_topn_filter, _topn_filter_column_id,
+                                         _topn_filtered_counter);
+            }
+            if (!_dict_code_filters.empty()) {
+                scanner->set_dict_code_filters(_dict_code_filters, _dict_code_filtered_counter);
+            }
 
             _volap_scanners.push_back(scanner);
             disk_set.insert(scanner->scan_disk());
@@ -390,6 +421,48 @@ Status VOlapScanNode::start_scan_thread(RuntimeState* state) {
     return Status::OK();
 }
 
+std::shared_ptr<VTopNFilter> VOlapScanNode::register_topn_filter(SlotId slot_id, bool is_asc,
+                                                                 bool nulls_first) {
+    if (!config::enable_topn_runtime_filter) {
+        return nullptr;
+    }
+    const auto& slots = _tuple_desc->slots();
+    for (int i = 0; i < slots.size(); ++i) {
+        const SlotDescriptor* slot = slots[i];
+        if (slot->id() != slot_id) {
+            continue;
+        }
+        bool push_to_storage = false;
+        switch (slot->type().type) {
+        case TYPE_TINYINT:
+        case TYPE_SMALLINT:
+        case TYPE_INT:
+        case TYPE_BIGINT:
+        case TYPE_LARGEINT:
+        case TYPE_DATE:
+        case TYPE_DATETIME:
+        case TYPE_DECIMALV2:
+        case TYPE_VARCHAR:
+        case TYPE_STRING:
+            push_to_storage = true;
+            break;
+        default:
+            break;
+        }
+        // the conditions of the storage remove the rows with NULL, which are kept when they
+        // are sorted first
+        if (slot->is_nullable() && nulls_first) {
+            push_to_storage = false;
+        }
+        _topn_filter = std::make_shared<VTopNFilter>(
+                slot->col_name(), remove_nullable(slot->get_data_type_ptr()), is_asc,
+                nulls_first, push_to_storage);
+        _topn_filter_column_id = i;
+        return _topn_filter;
+    }
+    return nullptr;
+}
+
 Status VOlapScanNode::close(RuntimeState* state) {
     if (is_closed()) {
         return Status::OK();
@@ -554,8 +627,9 @@ Block* VOlapScanNode::_alloc_block(bool& get_free_block) {
 int VOlapScanNode::_start_scanner_thread_task(RuntimeState* state, int block_per_scanner) {
     std::list<VOlapScanner*> olap_scanners;
     int assigned_thread_num = _running_thread;
-    size_t max_thread = std::min(_volap_scanners.size(),
-                                 static_cast<size_t>(config::doris_scanner_thread_pool_thread_num));
+    size_t max_thread =
+            std::min(_volap_scanners.size(),
+                     static_cast<size_t>(state->exec_env()->scan_scheduler()->num_threads()));
     // copy to local
     {
         // How many thread can apply to this query
@@ -600,21 +674,18 @@ int VOlapScanNode::_start_scanner_thread_task(RuntimeState* state, int block_per
         }
     }
 
-    // post volap scanners to thread-pool
-    PriorityThreadPool* thread_pool = state->exec_env()->scan_thread_pool();
+    // post volap scanners to the scan scheduler
+    ScanScheduler* scan_scheduler = state->exec_env()->scan_scheduler();
     auto iter = olap_scanners.begin();
     while (iter != olap_scanners.end()) {
-        PriorityThreadPool::Task task;
-        task.work_function = std::bind(&VOlapScanNode::scanner_thread, this, *iter);
-        task.priority = _nice;
-        task.queue_id = state->exec_env()->store_path_to_index((*iter)->scan_disk());
         (*iter)->start_wait_worker_timer();
-        if (thread_pool->offer(task)) {
+        if (scan_scheduler->submit(_scan_share,
+                                   std::bind(&VOlapScanNode::scanner_thread, this, *iter),
+                                   (*iter)->scan_queue_id())) {
             olap_scanners.erase(iter++);
         } else {
-            LOG(FATAL) << "Failed to assign scanner task to thread pool!";
+            LOG(FATAL) << "Failed to assign scanner task to scan scheduler!";
         }
-        ++_total_assign_num;
     }
 
     return assigned_thread_num;
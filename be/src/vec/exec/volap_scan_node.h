@@ -19,6 +19,9 @@
 
 #include "exec/olap_scan_node.h"
 #include "exprs/runtime_filter.h"
+#include "runtime/scan_scheduler.h"
+#include "vec/runtime/vdict_code_filter.h"
+#include "vec/runtime/vtopn_filter.h"
 
 namespace doris {
 class ObjectPool;
@@ -40,6 +43,12 @@ public:
     Status get_next(RuntimeState* state, Block* block, bool* eos) override;
     Status close(RuntimeState* state) override;
 
+    // Called by the top-n VSortNode above in prepare(), the scan skips the rows whose slot
+    // `slot_id` is worse than the bound of the filter. Return nullptr if the scan can not be
+    // filtered by the slot.
+    std::shared_ptr<VTopNFilter> register_topn_filter(SlotId slot_id, bool is_asc,
+                                                      bool nulls_first);
+
 private:
     void transfer_thread(RuntimeState* state);
     void scanner_thread(VOlapScanner* scanner);
@@ -69,6 +78,19 @@ private:
     int _max_materialized_blocks;
 
     size_t _block_size = 0;
+
+    RuntimeProfile::Counter* _scanner_run_timer = nullptr;
+    RuntimeProfile::Counter* _scanner_sched_counter = nullptr;
+
+    // the bound of the top-n sort node above, nullptr if not existed
+    std::shared_ptr<VTopNFilter> _topn_filter;
+    // position of the filtered slot in the blocks of the scanners
+    int _topn_filter_column_id = -1;
+    RuntimeProfile::Counter* _topn_filtered_counter = nullptr;
+
+    // the conjuncts evaluated on the dictionary codes by the scanners
+    std::vector<VDictCodeFilter> _dict_code_filters;
+    RuntimeProfile::Counter* _dict_code_filtered_counter = nullptr;
 };
 } // namespace vectorized
 } // namespace doris
@@ -67,8 +67,21 @@ Status VOlapScanner::get_block(RuntimeState* state, vectorized::Block* block, bo
             _num_rows_read += block->rows();
             _update_realtime_counter();
 
+            if (!_dict_code_filters.empty()) {
+                size_t filtered_rows = 0;
+                RETURN_IF_ERROR(
+                        VDictCodeFilter::filter_block(&_dict_code_filters, block, &filtered_rows));
+                COUNTER_UPDATE(_dict_code_filtered_counter, filtered_rows);
+            }
+
             RETURN_IF_ERROR(
                     VExprContext::filter_block(_vconjunct_ctx, block, _tuple_desc->slots().size()));
+            if (_topn_filter != nullptr) {
+                size_t filtered_rows = 0;
+                RETURN_IF_ERROR(_topn_filter->filter_block(block, _topn_filter_column_id,
+                                                           &filtered_rows));
+                COUNTER_UPDATE(_topn_filtered_counter, filtered_rows);
+            }
         } while (block->rows() == 0 && !(*eof) && raw_rows_read() < raw_rows_threshold &&
                  block->allocated_bytes() < raw_bytes_threshold);
     }
@@ -80,6 +93,30 @@ Status VOlapScanner::get_block(RuntimeState* state, vectorized::Block* block, bo
     return Status::OK();
 }
 
+void VOlapScanner::set_dict_code_filters(std::vector<VDictCodeFilter> filters,
+                                         RuntimeProfile::Counter* filtered_counter) {
+    // the codes are only valid until the next block is read from the segment, they can not
+    // be merged with the rows of the other rowsets
+    if (_tablet->keys_type() != DUP_KEYS && !_aggregation &&
+        !_tablet->enable_unique_key_merge_on_write()) {
+        return;
+    }
+    const auto& slots = _tuple_desc->slots();
+    for (auto& filter : filters) {
+        int32_t index = _tablet->field_index(slots[filter.column_id()]->col_name());
+        if (index < 0) {
+            continue;
+        }
+        FieldType type = _tablet->tablet_schema().column(index).type();
+        if (type != OLAP_FIELD_TYPE_VARCHAR && type != OLAP_FIELD_TYPE_STRING) {
+            continue;
+        }
+        _tablet_reader_params.dict_code_columns.insert(index);
+        _dict_code_filters.push_back(std::move(filter));
+    }
+    _dict_code_filtered_counter = filtered_counter;
+}
+
 void VOlapScanner::set_tablet_reader() {
     _tablet_reader = std::make_unique<BlockReader>();
 }
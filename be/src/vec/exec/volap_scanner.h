@@ -20,6 +20,8 @@
 #include "exec/olap_scanner.h"
 
 #include "vec/olap/block_reader.h"
+#include "vec/runtime/vdict_code_filter.h"
+#include "vec/runtime/vtopn_filter.h"
 
 namespace doris {
 class OlapScanNode;
@@ -48,12 +50,40 @@ public:
 
     bool need_to_close() { return _need_to_close; }
 
+    // the local queue of the ScanScheduler this scanner is put on
+    uint32_t scan_queue_id() const { return _scan_queue_id; }
+    void set_scan_queue_id(uint32_t scan_queue_id) { _scan_queue_id = scan_queue_id; }
+
+    void set_topn_filter(std::shared_ptr<VTopNFilter> topn_filter, int column_id,
+                         RuntimeProfile::Counter* filtered_counter) {
+        _topn_filter = std::move(topn_filter);
+        _topn_filter_column_id = column_id;
+        _topn_filtered_counter = filtered_counter;
+    }
+    // Called before open(), the columns of the filters are read as dictionary codes if the
+    // blocks of the segments reach the scanner unmerged.
+    void set_dict_code_filters(std::vector<VDictCodeFilter> filters,
+                               RuntimeProfile::Counter* filtered_counter);
+
+    // version of the top-n filter bound pushed to the storage
+    int64_t topn_filter_version() const { return _topn_filter_version; }
+    void set_topn_filter_version(int64_t version) { _topn_filter_version = version; }
+
 protected:
     virtual void set_tablet_reader() override;
 
 private:
     VExprContext* _vconjunct_ctx = nullptr;
     bool _need_to_close = false;
+    uint32_t _scan_queue_id = 0;
+
+    std::shared_ptr<VTopNFilter> _topn_filter;
+    int _topn_filter_column_id = -1;
+    int64_t _topn_filter_version = 0;
+    RuntimeProfile::Counter* _topn_filtered_counter = nullptr;
+
+    std::vector<VDictCodeFilter> _dict_code_filters;
+    RuntimeProfile::Counter* _dict_code_filtered_counter = nullptr;
 };
 
 } // namespace vectorized
@@ -0,0 +1,288 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vorc_scanner.h"
+
+#include <fmt/format.h>
+
+#include "runtime/datetime_value.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+
+namespace doris::vectorized {
+
+VOrcScanner::VOrcScanner(RuntimeState* state, RuntimeProfile* profile,
+                         const TBrokerScanRangeParams& params,
+                         const std::vector<TBrokerRangeDesc>& ranges,
+                         const std::vector<TNetworkAddress>& broker_addresses,
+                         const std::vector<TExpr>& pre_filter_texprs, ScannerCounter* counter)
+        : ORCScanner(state, profile, params, ranges, broker_addresses, pre_filter_texprs,
+                     counter) {}
+
+Status VOrcScanner::open() {
+    RETURN_IF_ERROR(ORCScanner::open());
+    return init_vexpr_ctxes();
+}
+
+Status VOrcScanner::get_next(std::vector<MutableColumnPtr>& columns, bool* eof) {
+    try {
+        RETURN_IF_ERROR(_next_block(columns));
+    } catch (orc::ParseError& e) {
+        std::string str_error = fmt::format("ParseError : {}", e.what());
+        LOG(WARNING) << str_error;
+        return Status::InternalError(str_error);
+    } catch (orc::InvalidArgument& e) {
+        std::string str_error = fmt::format("ParseError : {}", e.what());
+        LOG(WARNING) << str_error;
+        return Status::InternalError(str_error);
+    } catch (std::runtime_error& e) {
+        // orc::TimezoneError is not exposed by the orc headers
+        std::string str_error = fmt::format("ParseError : {}", e.what());
+        LOG(WARNING) << str_error;
+        return Status::InternalError(str_error);
+    }
+    *eof = _scanner_eof;
+    return Status::OK();
+}
+
+Status VOrcScanner::_next_block(std::vector<MutableColumnPtr>& columns) {
+    SCOPED_TIMER(_read_timer);
+
+    const int batch_size = _state->batch_size();
+    while (columns[0]->size() < batch_size && !_scanner_eof) {
+        if (_cur_file_eof) {
+            RETURN_IF_ERROR(open_next_reader());
+            _cur_file_eof = false;
+            continue;
+        }
+        if (_current_line_of_group >= _rows_of_group) {
+            // the rows skipped by the search argument are not in the batch
+            if (!_row_reader->next(*_batch)) {
+                _cur_file_eof = true;
+                continue;
+            }
+            _rows_of_group = _batch->numElements;
+            _current_line_of_group = 0;
+        }
+
+        size_t num_rows = std::min<int64_t>(batch_size - columns[0]->size(),
+                                            _rows_of_group - _current_line_of_group);
+        const auto& fields = static_cast<orc::StructVectorBatch*>(_batch.get())->fields;
+        const orc::Type& selected_type = _row_reader->getSelectedType();
+        Block src_block;
+        RETURN_IF_ERROR(fill_src_block(
+                _ranges.at(_next_range - 1), num_rows,
+                [&](int index, const SlotDescriptor* slot_desc, IColumn* column) {
+                    int position = _position_in_orc_original[index];
+                    return _append_column(fields[position], *selected_type.getSubtype(position),
+                                          _current_line_of_group, num_rows, slot_desc, column);
+                },
+                &src_block));
+        _current_line_of_group += num_rows;
+
+        COUNTER_UPDATE(_rows_read_counter, num_rows);
+        SCOPED_TIMER(_materialize_timer);
+        RETURN_IF_ERROR(fill_dest_columns(&src_block, columns));
+    }
+    return Status::OK();
+}
+
+template <typename Func>
+static Status append_values(const orc::ColumnVectorBatch* cvb, size_t start, size_t num_rows,
+                            const SlotDescriptor* slot_desc, NullMap* null_map,
+                            ColumnString* column, Func&& append_value) {
+    for (size_t i = start; i < start + num_rows; ++i) {
+        if (cvb->hasNulls && !cvb->notNull[i]) {
+            if (null_map == nullptr) {
+                return Status::InternalError(fmt::format("The field name({}) is not nullable ",
+                                                         slot_desc->col_name()));
+            }
+            null_map->push_back(1);
+            column->insert_default();
+        } else {
+            if (null_map != nullptr) {
+                null_map->push_back(0);
+            }
+            RETURN_IF_ERROR(append_value(i));
+        }
+    }
+    return Status::OK();
+}
+
+// The strings are copied into the chars of the column at once, with the
+// terminating zero of every value that ColumnString keeps.
+static Status append_strings(const orc::StringVectorBatch* cvb, size_t start, size_t num_rows,
+                             const SlotDescriptor* slot_desc, NullMap* null_map,
+                             ColumnString* column) {
+    if (cvb->hasNulls && null_map == nullptr) {
+        for (size_t i = start; i < start + num_rows; ++i) {
+            if (!cvb->notNull[i]) {
+                return Status::InternalError(fmt::format("The field name({}) is not nullable ",
+                                                         slot_desc->col_name()));
+            }
+        }
+    }
+
+    size_t total_length = 0;
+    for (size_t i = start; i < start + num_rows; ++i) {
+        if (!cvb->hasNulls || cvb->notNull[i]) {
+            total_length += cvb->length[i];
+        }
+    }
+    auto& chars = column->get_chars();
+    auto& offsets = column->get_offsets();
+    size_t offset = chars.size();
+    chars.resize(offset + total_length + num_rows);
+    offsets.reserve(offsets.size() + num_rows);
+    for (size_t i = start; i < start + num_rows; ++i) {
+        bool is_null = cvb->hasNulls && !cvb->notNull[i];
+        if (null_map != nullptr) {
+            null_map->push_back(is_null);
+        }
+        if (!is_null) {
+            memcpy(&chars[offset], cvb->data[i], cvb->length[i]);
+            offset += cvb->length[i];
+        }
+        chars[offset++] = 0;
+        offsets.push_back(offset);
+    }
+    return Status::OK();
+}
+
+// The source slots are strings, the values are converted to the same text as
+// ORCScanner::get_next() does.
+Status VOrcScanner::_append_column(const orc::ColumnVectorBatch* cvb, const orc::Type& orc_type,
+                                   size_t start, size_t num_rows, const SlotDescriptor* slot_desc,
+                                   IColumn* column) {
+    NullMap* null_map = nullptr;
+    if (column->is_nullable()) {
+        auto* nullable_column = reinterpret_cast<ColumnNullable*>(column);
+        null_map = &nullable_column->get_null_map_data();
+        column = &nullable_column->get_nested_column();
+    }
+    auto* str_column = typeid_cast<ColumnString*>(column);
+    if (str_column == nullptr) {
+        return Status::InternalError(fmt::format("The source slot of field name({}) is not string",
+                                                 slot_desc->col_name()));
+    }
+
+    auto append_datetime = [str_column](int64_t timestamp, bool is_date) {
+        DateTimeValue dtv;
+        if (!dtv.from_unixtime(timestamp, "UTC")) {
+            std::string str_error = fmt::format("Parse timestamp ({}) error", timestamp);
+            LOG(WARNING) << str_error;
+            return Status::InternalError(str_error);
+        }
+        if (is_date) {
+            dtv.cast_to_date();
+        }
+        char buf[64];
+        char* end = dtv.to_string(buf);
+        str_column->insert_data(buf, end - buf - 1);
+        return Status::OK();
+    };
+
+    switch (orc_type.getKind()) {
+    case orc::BOOLEAN: {
+        const auto* data = static_cast<const orc::LongVectorBatch*>(cvb)->data.data();
+        return append_values(cvb, start, num_rows, slot_desc, null_map, str_column,
+                             [str_column, data](size_t i) {
+                                 if (data[i] == 0) {
+                                     str_column->insert_data("false", 5);
+                                 } else {
+                                     str_column->insert_data("true", 4);
+                                 }
+                                 return Status::OK();
+                             });
+    }
+    case orc::BYTE:
+    case orc::INT:
+    case orc::SHORT:
+    case orc::LONG: {
+        const auto* data = static_cast<const orc::LongVectorBatch*>(cvb)->data.data();
+        return append_values(cvb, start, num_rows, slot_desc, null_map, str_column,
+                             [str_column, data](size_t i) {
+                                 fmt::format_int value(data[i]);
+                                 str_column->insert_data(value.data(), value.size());
+                                 return Status::OK();
+                             });
+    }
+    case orc::FLOAT:
+    case orc::DOUBLE: {
+        const auto* data = static_cast<const orc::DoubleVectorBatch*>(cvb)->data.data();
+        return append_values(cvb, start, num_rows, slot_desc, null_map, str_column,
+                             [str_column, data](size_t i) {
+                                 std::string value = fmt::format("{:.9f}", data[i]);
+                                 str_column->insert_data(value.data(), value.size());
+                                 return Status::OK();
+                             });
+    }
+    case orc::BINARY:
+    case orc::CHAR:
+    case orc::VARCHAR:
+    case orc::STRING:
+        return append_strings(static_cast<const orc::StringVectorBatch*>(cvb), start, num_rows,
+                              slot_desc, null_map, str_column);
+    case orc::DECIMAL: {
+        //Decimal64VectorBatch handles decimal columns with precision no greater than 18.
+        //Decimal128VectorBatch handles the others.
+        if (const auto* batch = dynamic_cast<const orc::Decimal64VectorBatch*>(cvb)) {
+            return append_values(cvb, start, num_rows, slot_desc, null_map, str_column,
+                                 [str_column, batch](size_t i) {
+                                     std::string value = decimal_to_string(
+                                             std::to_string(batch->values[i]), batch->scale);
+                                     str_column->insert_data(value.data(), value.size());
+                                     return Status::OK();
+                                 });
+        }
+        const auto* batch = dynamic_cast<const orc::Decimal128VectorBatch*>(cvb);
+        return append_values(cvb, start, num_rows, slot_desc, null_map, str_column,
+                             [str_column, batch](size_t i) {
+                                 std::string value = decimal_to_string(
+                                         batch->values[i].toString(), batch->scale);
+                                 str_column->insert_data(value.data(), value.size());
+                                 return Status::OK();
+                             });
+    }
+    case orc::DATE: {
+        //Date columns record the number of days since the UNIX epoch (1/1/1970 in UTC).
+        const auto* data = static_cast<const orc::LongVectorBatch*>(cvb)->data.data();
+        return append_values(cvb, start, num_rows, slot_desc, null_map, str_column,
+                             [&append_datetime, data](size_t i) {
+                                 return append_datetime(data[i] * 24 * 60 * 60, true);
+                             });
+    }
+    case orc::TIMESTAMP: {
+        // see ORCScanner::get_next() for the time zone
+        const auto* data = static_cast<const orc::TimestampVectorBatch*>(cvb)->data.data();
+        return append_values(cvb, start, num_rows, slot_desc, null_map, str_column,
+                             [&append_datetime, data](size_t i) {
+                                 return append_datetime(data[i], false);
+                             });
+    }
+    default: {
+        std::string str_error =
+                fmt::format("The field name({}) type not support. ", slot_desc->col_name());
+        LOG(WARNING) << str_error;
+        return Status::InternalError(str_error);
+    }
+    }
+}
+
+} // namespace doris::vectorized
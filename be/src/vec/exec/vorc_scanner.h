@@ -0,0 +1,50 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "exec/orc_scanner.h"
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+// ORC scanner of the vectorized engine.
+//
+// The column vector batches are converted column by column into a block of the source
+// slots, then the preceding filter and the exprs of the dest slots are evaluated on the
+// whole block. The stripes and the row groups are pruned by the search argument built in
+// ORCScanner.
+class VOrcScanner final : public ORCScanner {
+public:
+    VOrcScanner(RuntimeState* state, RuntimeProfile* profile,
+                const TBrokerScanRangeParams& params, const std::vector<TBrokerRangeDesc>& ranges,
+                const std::vector<TNetworkAddress>& broker_addresses,
+                const std::vector<TExpr>& pre_filter_texprs, ScannerCounter* counter);
+
+    Status open() override;
+
+    Status get_next(std::vector<MutableColumnPtr>& columns, bool* eof) override;
+
+private:
+    Status _next_block(std::vector<MutableColumnPtr>& columns);
+
+    Status _append_column(const orc::ColumnVectorBatch* cvb, const orc::Type& orc_type,
+                          size_t start, size_t num_rows, const SlotDescriptor* slot_desc,
+                          IColumn* column);
+};
+
+} // namespace doris::vectorized
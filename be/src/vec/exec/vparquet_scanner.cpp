@@ -0,0 +1,279 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vparquet_scanner.h"
+
+#include <fmt/format.h>
+#include <time.h>
+
+#include "exec/parquet_reader.h"
+#include "runtime/datetime_value.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+
+namespace doris::vectorized {
+
+VParquetScanner::VParquetScanner(RuntimeState* state, RuntimeProfile* profile,
+                                 const TBrokerScanRangeParams& params,
+                                 const std::vector<TBrokerRangeDesc>& ranges,
+                                 const std::vector<TNetworkAddress>& broker_addresses,
+                                 const std::vector<TExpr>& pre_filter_texprs,
+                                 ScannerCounter* counter)
+        : ParquetScanner(state, profile, params, ranges, broker_addresses, pre_filter_texprs,
+                         counter) {}
+
+VParquetScanner::~VParquetScanner() {
+    close();
+}
+
+Status VParquetScanner::open() {
+    RETURN_IF_ERROR(ParquetScanner::open());
+    return init_vexpr_ctxes();
+}
+
+Status VParquetScanner::get_next(std::vector<MutableColumnPtr>& columns, bool* eof) {
+    SCOPED_TIMER(_read_timer);
+
+    const int batch_size = _state->batch_size();
+    while (columns[0]->size() < batch_size && !_scanner_eof) {
+        if (_batch == nullptr || _batch_start >= _batch->num_rows()) {
+            if (_cur_file_reader == nullptr || _cur_file_eof) {
+                RETURN_IF_ERROR(open_next_reader());
+                // If there isn't any more reader, break this
+                if (_scanner_eof) {
+                    continue;
+                }
+                _cur_file_eof = false;
+            }
+            RETURN_IF_ERROR(
+                    _cur_file_reader->next_batch(&_batch, _src_slot_descs, &_cur_file_eof));
+            _batch_start = 0;
+        }
+
+        size_t num_rows = std::min<int64_t>(batch_size - columns[0]->size(),
+                                            _batch->num_rows() - _batch_start);
+        Block src_block;
+        RETURN_IF_ERROR(fill_src_block(
+                _ranges.at(_next_range - 1), num_rows,
+                [this, num_rows](int index, const SlotDescriptor* slot_desc, IColumn* column) {
+                    return _append_column(*_batch->column(index), _batch_start, num_rows,
+                                          slot_desc, column);
+                },
+                &src_block));
+        _batch_start += num_rows;
+
+        COUNTER_UPDATE(_rows_read_counter, num_rows);
+        SCOPED_TIMER(_materialize_timer);
+        RETURN_IF_ERROR(fill_dest_columns(&src_block, columns));
+    }
+    *eof = _scanner_eof;
+    return Status::OK();
+}
+
+template <typename ArrayType, typename Func>
+static Status append_values(const arrow::Array& array, size_t start, size_t num_rows,
+                            const SlotDescriptor* slot_desc, NullMap* null_map,
+                            ColumnString* column, Func&& append_value) {
+    const auto& typed_array = static_cast<const ArrayType&>(array);
+    for (size_t i = start; i < start + num_rows; ++i) {
+        if (typed_array.IsNull(i)) {
+            if (null_map == nullptr) {
+                return Status::RuntimeError(fmt::format(
+                        "The field name({}) is not allowed null, but Parquet field is null.",
+                        slot_desc->col_name()));
+            }
+            null_map->push_back(1);
+            column->insert_default();
+        } else {
+            if (null_map != nullptr) {
+                null_map->push_back(0);
+            }
+            RETURN_IF_ERROR(append_value(typed_array, i));
+        }
+    }
+    return Status::OK();
+}
+
+// The source slots are strings, the values are converted to the same text as
+// ParquetReaderWrap::read() does.
+Status VParquetScanner::_append_column(const arrow::Array& array, size_t start, size_t num_rows,
+                                       const SlotDescriptor* slot_desc, IColumn* column) {
+    NullMap* null_map = nullptr;
+    if (column->is_nullable()) {
+        auto* nullable_column = reinterpret_cast<ColumnNullable*>(column);
+        null_map = &nullable_column->get_null_map_data();
+        column = &nullable_column->get_nested_column();
+    }
+    auto* str_column = typeid_cast<ColumnString*>(column);
+    if (str_column == nullptr) {
+        return Status::InternalError(fmt::format("The source slot of field name({}) is not string",
+                                                 slot_desc->col_name()));
+    }
+
+    auto append_int = [str_column](const auto& typed_array, size_t i) {
+        fmt::format_int value(typed_array.Value(i));
+        str_column->insert_data(value.data(), value.size());
+        return Status::OK();
+    };
+    auto append_double = [str_column](const auto& typed_array, size_t i) {
+        // see ParquetReaderWrap::read() for the precision
+        std::string value = fmt::format("{:.9f}", static_cast<double>(typed_array.Value(i)));
+        str_column->insert_data(value.data(), value.size());
+        return Status::OK();
+    };
+    auto append_binary = [str_column](const arrow::BinaryArray& typed_array, size_t i) {
+        int32_t length = 0;
+        const uint8_t* value = typed_array.GetValue(i, &length);
+        str_column->insert_data(reinterpret_cast<const char*>(value), length);
+        return Status::OK();
+    };
+    auto append_local_time = [str_column](time_t timestamp, const char* format) {
+        char buf[64];
+        struct tm local;
+        localtime_r(&timestamp, &local);
+        size_t length = strftime(buf, sizeof(buf), format, &local);
+        str_column->insert_data(buf, length);
+        return Status::OK();
+    };
+
+    switch (array.type_id()) {
+    case arrow::Type::type::STRING:
+    case arrow::Type::type::BINARY:
+        return append_values<arrow::BinaryArray>(array, start, num_rows, slot_desc, null_map,
+                                                 str_column, append_binary);
+    case arrow::Type::type::FIXED_SIZE_BINARY:
+        return append_values<arrow::FixedSizeBinaryArray>(
+                array, start, num_rows, slot_desc, null_map, str_column,
+                [str_column](const arrow::FixedSizeBinaryArray& typed_array, size_t i) {
+                    str_column->insert_data(
+                            reinterpret_cast<const char*>(typed_array.GetValue(i)),
+                            typed_array.byte_width());
+                    return Status::OK();
+                });
+    case arrow::Type::type::BOOL:
+        return append_values<arrow::BooleanArray>(
+                array, start, num_rows, slot_desc, null_map, str_column,
+                [str_column](const arrow::BooleanArray& typed_array, size_t i) {
+                    if (typed_array.Value(i)) {
+                        str_column->insert_data("true", 4);
+                    } else {
+                        str_column->insert_data("false", 5);
+                    }
+                    return Status::OK();
+                });
+    case arrow::Type::type::INT8:
+        return append_values<arrow::Int8Array>(array, start, num_rows, slot_desc, null_map,
+                                               str_column, append_int);
+    case arrow::Type::type::UINT8:
+        return append_values<arrow::UInt8Array>(array, start, num_rows, slot_desc, null_map,
+                                                str_column, append_int);
+    case arrow::Type::type::INT16:
+        return append_values<arrow::Int16Array>(array, start, num_rows, slot_desc, null_map,
+                                                str_column, append_int);
+    case arrow::Type::type::UINT16:
+        return append_values<arrow::UInt16Array>(array, start, num_rows, slot_desc, null_map,
+                                                 str_column, append_int);
+    case arrow::Type::type::INT32:
+        return append_values<arrow::Int32Array>(array, start, num_rows, slot_desc, null_map,
+                                                str_column, append_int);
+    case arrow::Type::type::UINT32:
+        return append_values<arrow::UInt32Array>(array, start, num_rows, slot_desc, null_map,
+                                                 str_column, append_int);
+    case arrow::Type::type::INT64:
+        return append_values<arrow::Int64Array>(array, start, num_rows, slot_desc, null_map,
+                                                str_column, append_int);
+    case arrow::Type::type::UINT64:
+        return append_values<arrow::UInt64Array>(array, start, num_rows, slot_desc, null_map,
+                                                 str_column, append_int);
+    case arrow::Type::type::FLOAT:
+        return append_values<arrow::FloatArray>(array, start, num_rows, slot_desc, null_map,
+                                                str_column, append_double);
+    case arrow::Type::type::DOUBLE:
+        return append_values<arrow::DoubleArray>(array, start, num_rows, slot_desc, null_map,
+                                                 str_column, append_double);
+    case arrow::Type::type::DECIMAL:
+        return append_values<arrow::DecimalArray>(
+                array, start, num_rows, slot_desc, null_map, str_column,
+                [str_column](const arrow::DecimalArray& typed_array, size_t i) {
+                    std::string value = typed_array.FormatValue(i);
+                    str_column->insert_data(value.data(), value.size());
+                    return Status::OK();
+                });
+    case arrow::Type::type::TIMESTAMP: {
+        const auto type = std::static_pointer_cast<arrow::TimestampType>(array.type());
+        // Doris only supports seconds
+        int64_t divisor = 1;
+        switch (type->unit()) {
+        case arrow::TimeUnit::type::NANO: // INT96
+            divisor = 1000000000L;
+            break;
+        case arrow::TimeUnit::type::MICRO:
+            divisor = 1000000L;
+            break;
+        case arrow::TimeUnit::type::MILLI:
+            divisor = 1000L;
+            break;
+        default:
+            break;
+        }
+        const std::string& timezone = _cur_file_reader->timezone();
+        return append_values<arrow::TimestampArray>(
+                array, start, num_rows, slot_desc, null_map, str_column,
+                [str_column, divisor, &timezone](const arrow::TimestampArray& typed_array,
+                                                 size_t i) {
+                    int64_t timestamp = typed_array.Value(i) / divisor;
+                    DateTimeValue dtv;
+                    if (!dtv.from_unixtime(timestamp, timezone)) {
+                        return Status::InternalError(
+                                fmt::format("Parse timestamp ({}) error", timestamp));
+                    }
+                    char buf[64];
+                    char* end = dtv.to_string(buf);
+                    str_column->insert_data(buf, end - buf - 1);
+                    return Status::OK();
+                });
+    }
+    case arrow::Type::type::DATE32:
+        return append_values<arrow::Date32Array>(
+                array, start, num_rows, slot_desc, null_map, str_column,
+                [&append_local_time](const arrow::Date32Array& typed_array, size_t i) {
+                    time_t timestamp = (time_t)((int64_t)typed_array.Value(i) * 24 * 60 * 60);
+                    return append_local_time(timestamp, "%Y-%m-%d");
+                });
+    case arrow::Type::type::DATE64:
+        return append_values<arrow::Date64Array>(
+                array, start, num_rows, slot_desc, null_map, str_column,
+                [&append_local_time](const arrow::Date64Array& typed_array, size_t i) {
+                    // convert milliseconds to seconds
+                    return append_local_time((time_t)(typed_array.Value(i) / 1000),
+                                             "%Y-%m-%d %H:%M:%S");
+                });
+    default:
+        return Status::InternalError(fmt::format("The field name({}), type({}) not support.",
+                                                 slot_desc->col_name(),
+                                                 array.type()->ToString()));
+    }
+}
+
+void VParquetScanner::close() {
+    _batch.reset();
+    ParquetScanner::close();
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,57 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <arrow/array.h>
+#include <arrow/record_batch.h>
+
+#include "exec/parquet_scanner.h"
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+// Parquet scanner of the vectorized engine.
+//
+// The record batches of the projected columns are converted column by column into a block
+// of the source slots, then the preceding filter and the exprs of the dest slots are
+// evaluated on the whole block. The row groups are pruned by ParquetScanner.
+class VParquetScanner final : public ParquetScanner {
+public:
+    VParquetScanner(RuntimeState* state, RuntimeProfile* profile,
+                    const TBrokerScanRangeParams& params,
+                    const std::vector<TBrokerRangeDesc>& ranges,
+                    const std::vector<TNetworkAddress>& broker_addresses,
+                    const std::vector<TExpr>& pre_filter_texprs, ScannerCounter* counter);
+    ~VParquetScanner() override;
+
+    Status open() override;
+
+    Status get_next(std::vector<MutableColumnPtr>& columns, bool* eof) override;
+
+    void close() override;
+
+private:
+    Status _append_column(const arrow::Array& array, size_t start, size_t num_rows,
+                          const SlotDescriptor* slot_desc, IColumn* column);
+
+    // the rows of _batch from _batch_start are not consumed yet
+    std::shared_ptr<arrow::RecordBatch> _batch;
+    int64_t _batch_start = 0;
+};
+
+} // namespace doris::vectorized
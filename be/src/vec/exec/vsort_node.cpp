@@ -17,12 +17,17 @@
 
 #include "vec/exec/vsort_node.h"
 
+#include <limits>
+
+#include "common/config.h"
 #include "exec/sort_exec_exprs.h"
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "util/debug_util.h"
 
 #include "vec/core/sort_block.h"
+#include "vec/exec/volap_scan_node.h"
+#include "vec/exprs/vslot_ref.h"
 
 namespace doris::vectorized {
 
@@ -45,11 +50,46 @@ Status VSortNode::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::prepare(state));
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
     _block_mem_tracker = MemTracker::create_virtual_tracker(-1, "VSortNode:Block", mem_tracker());
+    _can_spill = state->enable_spill();
+    _spill_timer = ADD_TIMER(runtime_profile(), "SpillTime");
+    _spill_bytes_counter = ADD_COUNTER(runtime_profile(), "SpillBytes", TUnit::BYTES);
+    _spill_runs_counter = ADD_COUNTER(runtime_profile(), "SpillRuns", TUnit::UNIT);
     RETURN_IF_ERROR(_vsort_exec_exprs.prepare(state, child(0)->row_desc(), _row_descriptor,
                                               expr_mem_tracker()));
+    init_topn_filter();
     return Status::OK();
 }
 
+void VSortNode::init_topn_filter() {
+    auto scan_node = dynamic_cast<VOlapScanNode*>(child(0));
+    if (_limit == -1 || scan_node == nullptr) {
+        return;
+    }
+    VExpr* ordering_expr = _vsort_exec_exprs.lhs_ordering_expr_ctxs()[0]->root();
+    if (!ordering_expr->is_slot_ref()) {
+        return;
+    }
+    int slot_id = static_cast<VSlotRef*>(ordering_expr)->slot_id();
+    if (_vsort_exec_exprs.need_materialize_tuple()) {
+        // the ordering exprs are on the sort tuple, find the slot of the child it comes from
+        const auto& sort_slots = _row_descriptor.tuple_descriptors()[0]->slots();
+        const auto& slot_expr_ctxs = _vsort_exec_exprs.sort_tuple_slot_expr_ctxs();
+        ordering_expr = nullptr;
+        for (int i = 0; i < sort_slots.size() && i < slot_expr_ctxs.size(); ++i) {
+            if (sort_slots[i]->id() == slot_id) {
+                ordering_expr = slot_expr_ctxs[i]->root();
+                break;
+            }
+        }
+        if (ordering_expr == nullptr || !ordering_expr->is_slot_ref()) {
+            return;
+        }
+        slot_id = static_cast<VSlotRef*>(ordering_expr)->slot_id();
+    }
+    _topn_filter = scan_node->register_topn_filter(slot_id, _is_asc_order[0], _nulls_first[0]);
+    _runtime_profile->add_info_string("TopNFilter", _topn_filter != nullptr ? "true" : "false");
+}
+
 Status VSortNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     SCOPED_SWITCH_TASK_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
@@ -81,7 +121,10 @@ Status VSortNode::get_next(RuntimeState* state, Block* block, bool* eos) {
     SCOPED_SWITCH_TASK_THREAD_LOCAL_EXISTED_MEM_TRACKER(_mem_tracker);
 
     auto status = Status::OK();
-    if (_sorted_blocks.empty()) {
+    if (_run_merger != nullptr) {
+        RETURN_IF_ERROR(_run_merger->get_next(block, eos));
+        RETURN_IF_ERROR(_spilled_run_status);
+    } else if (_sorted_blocks.empty()) {
         *eos = true;
     } else if (_sorted_blocks.size() == 1) {
         if (_offset != 0) {
@@ -107,6 +150,9 @@ Status VSortNode::close(RuntimeState* state) {
         return Status::OK();
     }
     _block_mem_tracker->release(_total_mem_usage);
+    _run_merger.reset();
+    _spilled_run_blocks.clear();
+    _spilled_runs.clear();
     _vsort_exec_exprs.close(state);
     ExecNode::close(state);
     return Status::OK();
@@ -140,7 +186,7 @@ Status VSortNode::sort_input(RuntimeState* state) {
                 // to order the block in _block_priority_queue.
                 // if one block totally greater the heap top of _block_priority_queue
                 // we can throw the block data directly.
-                if (_num_rows_in_block < _limit) {
+                if (_num_rows_in_block < _offset + _limit) {
                     _total_mem_usage += mem_usage;
                     _sorted_blocks.emplace_back(std::move(block));
                     _num_rows_in_block += rows;
@@ -157,6 +203,9 @@ Status VSortNode::sort_input(RuntimeState* state) {
                         continue;
                     }
                 }
+                if (_topn_filter != nullptr) {
+                    update_topn_filter();
+                }
             } else {
                 // dispose normal sort logic
                 _total_mem_usage += mem_usage;
@@ -164,11 +213,21 @@ Status VSortNode::sort_input(RuntimeState* state) {
             }
 
             _block_mem_tracker->consume(mem_usage);
+            if (_can_spill && _total_mem_usage > config::vsort_spill_threshold_bytes) {
+                RETURN_IF_ERROR(spill_sorted_blocks(state));
+            }
             RETURN_IF_CANCELLED(state);
             RETURN_IF_ERROR(state->check_query_state("vsort, while sorting input."));
         }
     } while (!eos);
 
+    if (!_spilled_runs.empty()) {
+        if (!_sorted_blocks.empty()) {
+            RETURN_IF_ERROR(spill_sorted_blocks(state));
+        }
+        return prepare_run_merger(state);
+    }
+
     build_merge_tree();
     return Status::OK();
 }
@@ -203,6 +262,47 @@ Status VSortNode::pretreat_block(doris::vectorized::Block& block) {
     return Status::OK();
 }
 
+void VSortNode::update_topn_filter() {
+    size_t num_rows = _offset + _limit;
+    const auto& desc = _sort_description[0];
+    std::vector<ColumnPtr> columns;
+    size_t total_rows = 0;
+    for (const auto& block : _sorted_blocks) {
+        columns.emplace_back(block.get_by_position(desc.column_number)
+                                     .column->convert_to_full_column_if_const());
+        total_rows += block.rows();
+    }
+    if (num_rows == 0 || total_rows < num_rows) {
+        return;
+    }
+
+    // merge the first ordering column of the sorted blocks up to the n-th row, the heap top
+    // is the (block, row) with the best value
+    using RowRef = std::pair<size_t, size_t>;
+    auto worse = [&](const RowRef& lhs, const RowRef& rhs) {
+        return desc.direction * columns[lhs.first]->compare_at(lhs.second, rhs.second,
+                                                               *columns[rhs.first],
+                                                               desc.nulls_direction) >
+               0;
+    };
+    std::priority_queue<RowRef, std::vector<RowRef>, decltype(worse)> heap(worse);
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (columns[i]->size() > 0) {
+            heap.emplace(i, 0);
+        }
+    }
+    for (size_t i = 1; i < num_rows; ++i) {
+        RowRef top = heap.top();
+        heap.pop();
+        if (top.second + 1 < columns[top.first]->size()) {
+            heap.emplace(top.first, top.second + 1);
+        }
+    }
+    // a NULL n-th row publishes nothing, the bound is never NULL
+    const RowRef& nth = heap.top();
+    _topn_filter->update(*columns[nth.first], nth.second);
+}
+
 void VSortNode::build_merge_tree() {
     for (const auto& block : _sorted_blocks) {
         _cursors.emplace_back(block, _sort_description);
@@ -256,4 +356,84 @@ Status VSortNode::merge_sort_read(doris::RuntimeState* state, doris::vectorized:
     return Status::OK();
 }
 
+Status VSortNode::spill_sorted_blocks(RuntimeState* state) {
+    SCOPED_TIMER(_spill_timer);
+    std::unique_ptr<VSpillStream> stream;
+    RETURN_IF_ERROR(VSpillStream::create(state, &stream));
+
+    if (_sorted_blocks.size() == 1) {
+        RETURN_IF_ERROR(stream->add_block(_sorted_blocks[0]));
+    } else {
+        std::vector<SortCursorImpl> cursors;
+        cursors.reserve(_sorted_blocks.size());
+        std::priority_queue<SortCursor> priority_queue;
+        for (const auto& block : _sorted_blocks) {
+            cursors.emplace_back(block, _sort_description);
+            priority_queue.push(SortCursor(&cursors.back()));
+        }
+
+        // of a TOP-N node only the first _offset + _limit rows of the run can be returned
+        size_t max_rows = _limit == -1 ? std::numeric_limits<size_t>::max() : _offset + _limit;
+        size_t num_rows = 0;
+        size_t num_columns = _sorted_blocks[0].columns();
+        MutableColumns merged_columns = _sorted_blocks[0].clone_empty_columns();
+        while (!priority_queue.empty() && num_rows < max_rows) {
+            auto current = priority_queue.top();
+            priority_queue.pop();
+
+            for (size_t i = 0; i < num_columns; ++i) {
+                merged_columns[i]->insert_from(*current->all_columns[i], current->pos);
+            }
+            ++num_rows;
+            if (!current->isLast()) {
+                current->next();
+                priority_queue.push(current);
+            }
+
+            if (merged_columns[0]->size() == state->batch_size() || priority_queue.empty() ||
+                num_rows == max_rows) {
+                RETURN_IF_ERROR(stream->add_block(
+                        _sorted_blocks[0].clone_with_columns(std::move(merged_columns))));
+                merged_columns = _sorted_blocks[0].clone_empty_columns();
+            }
+        }
+    }
+    COUNTER_UPDATE(_spill_bytes_counter, stream->bytes_written());
+    COUNTER_UPDATE(_spill_runs_counter, 1);
+    _spilled_runs.emplace_back(std::move(stream));
+
+    // the cursors of a TOP-N node point to the released blocks
+    _block_priority_queue = {};
+    _num_rows_in_block = 0;
+    _sorted_blocks.clear();
+    _block_mem_tracker->release(_total_mem_usage);
+    _total_mem_usage = 0;
+    return Status::OK();
+}
+
+Status VSortNode::prepare_run_merger(RuntimeState* state) {
+    std::vector<BlockSupplier> run_suppliers;
+    _spilled_run_blocks.resize(_spilled_runs.size());
+    for (size_t i = 0; i < _spilled_runs.size(); ++i) {
+        RETURN_IF_ERROR(_spilled_runs[i]->prepare_for_read());
+        run_suppliers.emplace_back([this, i](Block** block) {
+            bool eos = false;
+            auto status = _spilled_runs[i]->get_next(&_spilled_run_blocks[i], &eos);
+            if (!status.ok()) {
+                _spilled_run_status = status;
+                eos = true;
+            }
+            *block = eos ? nullptr : &_spilled_run_blocks[i];
+            return status;
+        });
+    }
+
+    // the spilled runs keep every row, so _offset is applied by the merger
+    _run_merger.reset(new VSortedRunMerger(_vsort_exec_exprs.lhs_ordering_expr_ctxs(),
+                                           _is_asc_order, _nulls_first, state->batch_size(),
+                                           _limit, _offset, runtime_profile()));
+    RETURN_IF_ERROR(_run_merger->prepare(run_suppliers));
+    return _spilled_run_status;
+}
+
 } // namespace doris::vectorized
@@ -23,13 +23,16 @@
 #include "vec/core/block.h"
 #include "vec/core/sort_cursor.h"
 #include "vec/exec/vsort_exec_exprs.h"
+#include "vec/runtime/vsorted_run_merger.h"
+#include "vec/runtime/vspill_stream.h"
+#include "vec/runtime/vtopn_filter.h"
 
 namespace doris::vectorized {
 // Node that implements a full sort of its input with a fixed memory budget
 // In open() the input Block to VSortNode will sort firstly, using the expressions specified in _sort_exec_exprs.
 // In get_next(), VSortNode do the merge sort to gather data to a new block
-
-// support spill to disk in the future
+// When spilling is enabled, a sort whose input does not fit in memory writes sorted
+// runs to disk and merges them in get_next() (external merge sort)
 class VSortNode : public doris::ExecNode {
 public:
     VSortNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
@@ -63,6 +66,20 @@ private:
 
     Status merge_sort_read(RuntimeState* state, Block* block, bool* eos);
 
+    // Merge the buffered blocks into one sorted run on disk and release them.
+    Status spill_sorted_blocks(RuntimeState* state);
+
+    // Set up _run_merger to merge the spilled runs.
+    Status prepare_run_merger(RuntimeState* state);
+
+    // Register a top-n filter on the olap scan node child if the first ordering expr is one
+    // of its slots.
+    void init_topn_filter();
+
+    // Publish the first ordering column of the n-th row of the sorted blocks held to
+    // _topn_filter, n is _offset + _limit, once the blocks hold at least n rows.
+    void update_topn_filter();
+
     // Number of rows to skip.
     int64_t _offset;
 
@@ -86,6 +103,24 @@ private:
     std::priority_queue<SortBlockCursor> _block_priority_queue;
 
     std::shared_ptr<MemTracker> _block_mem_tracker;
+
+    // only valid for a query with spilling enabled: once the buffered blocks exceed
+    // config::vsort_spill_threshold_bytes they are written as a sorted run, a run of a TOP-N
+    // node keeps its first _offset + _limit rows
+    bool _can_spill = false;
+    std::vector<std::unique_ptr<VSpillStream>> _spilled_runs;
+    // the current block of every spilled run, read by _run_merger
+    std::vector<Block> _spilled_run_blocks;
+    // _run_merger takes a failed read as the end of a run, so the error is kept here
+    Status _spilled_run_status;
+    std::unique_ptr<VSortedRunMerger> _run_merger;
+
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spill_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _spill_runs_counter = nullptr;
+
+    // only valid in TOP-N node whose child is an olap scan node
+    std::shared_ptr<VTopNFilter> _topn_filter;
 };
 
 } // namespace doris::vectorized
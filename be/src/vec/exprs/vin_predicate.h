@@ -39,6 +39,8 @@ public:
     }
     virtual const std::string& expr_name() const override;
 
+    bool is_not_in() const { return _is_not_in; }
+
 private:
     FunctionBasePtr _function;
     std::string _expr_name;
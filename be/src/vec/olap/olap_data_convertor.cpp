@@ -119,6 +119,17 @@ void OlapBlockDataConvertor::set_source_content(const vectorized::Block* block,
     }
 }
 
+void OlapBlockDataConvertor::set_source_content_with_specified_columns(
+        const vectorized::Block* block, size_t row_pos, size_t num_rows,
+        const std::vector<uint32_t>& cids) {
+    assert(block && num_rows > 0 && row_pos + num_rows <= block->rows() &&
+           block->columns() == cids.size());
+    for (size_t i = 0; i < cids.size(); ++i) {
+        assert(cids[i] < _convertors.size());
+        _convertors[cids[i]]->set_source_column(block->get_by_position(i), row_pos, num_rows);
+    }
+}
+
 void OlapBlockDataConvertor::clear_source_content() {
     for (auto& convertor : _convertors) {
         convertor->clear_source_column();
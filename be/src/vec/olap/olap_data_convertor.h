@@ -34,6 +34,10 @@ class OlapBlockDataConvertor {
 public:
     OlapBlockDataConvertor(const TabletSchema* tablet_schema);
     void set_source_content(const vectorized::Block* block, size_t row_pos, size_t num_rows);
+    // the columns of `block` are the columns `cids` of the tablet schema in order
+    void set_source_content_with_specified_columns(const vectorized::Block* block, size_t row_pos,
+                                                   size_t num_rows,
+                                                   const std::vector<uint32_t>& cids);
     void clear_source_content();
     std::pair<Status, IOlapColumnDataAccessorSPtr> convert_column_data(size_t cid);
 
@@ -0,0 +1,316 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/vertical_block_reader.h"
+
+#include <algorithm>
+
+#include "olap/tablet.h"
+#include "vec/aggregate_functions/aggregate_function_reader.h"
+#include "vec/aggregate_functions/aggregate_function_simple_factory.h"
+#include "vec/olap/block_reader.h"
+
+namespace doris::vectorized {
+
+VerticalBlockReader::~VerticalBlockReader() {
+    for (int i = 0; i < _agg_functions.size(); ++i) {
+        _agg_functions[i]->destroy(_agg_places[i]);
+        delete[] _agg_places[i];
+    }
+}
+
+bool VerticalBlockReader::RowsetSourceComparator::operator()(const RowsetSource* lhs,
+                                                             const RowsetSource* rhs) const {
+    // the smaller key is output first
+    int cmp_res = lhs->block.compare_at(lhs->row_pos, rhs->row_pos, num_key_columns, rhs->block,
+                                        -1);
+    if (cmp_res != 0) {
+        return cmp_res > 0;
+    }
+    // then the greater sequence
+    if (sequence_loc != -1) {
+        cmp_res = lhs->block.get_by_position(sequence_loc)
+                          .column->compare_at(lhs->row_pos, rhs->row_pos,
+                                              *rhs->block.get_by_position(sequence_loc).column,
+                                              -1);
+        if (cmp_res != 0) {
+            return cmp_res < 0;
+        }
+    }
+    // then the higher version
+    return lhs->version < rhs->version;
+}
+
+Status VerticalBlockReader::init(const TabletReader::ReaderParams& read_params,
+                                 const std::vector<uint32_t>& output_columns, bool is_key) {
+    const auto& tablet = read_params.tablet;
+    const auto& tablet_schema = tablet->tablet_schema();
+    _is_key = is_key;
+    _keys_type = tablet->keys_type();
+    _num_key_columns = tablet->num_key_columns();
+    _read_columns = read_params.return_columns;
+    DCHECK(std::is_sorted(_read_columns.begin(), _read_columns.end()));
+
+    int sequence_loc = -1;
+    for (auto cid : output_columns) {
+        auto it = std::find(_read_columns.begin(), _read_columns.end(), cid);
+        DCHECK(it != _read_columns.end());
+        _output_positions.push_back(it - _read_columns.begin());
+    }
+    // BlockReader takes the last origin return column as the sequence column appended by a
+    // query and does not output it, so append it again to have all read columns output
+    _origin_return_columns = _read_columns;
+    if (tablet_schema.has_sequence_col()) {
+        auto it = std::find(_read_columns.begin(), _read_columns.end(),
+                            tablet_schema.sequence_col_idx());
+        if (it != _read_columns.end()) {
+            sequence_loc = it - _read_columns.begin();
+            _origin_return_columns.push_back(tablet_schema.sequence_col_idx());
+        }
+    }
+
+    for (const auto& rs_reader : read_params.rs_readers) {
+        // the empty rowsets are skipped by every group alike
+        if (rs_reader->rowset()->num_rows() == 0) {
+            continue;
+        }
+        auto source = std::make_unique<RowsetSource>();
+        source->index = _sources.size();
+        source->version = rs_reader->version().second;
+        source->block = tablet_schema.create_block(_read_columns);
+
+        TabletReader::ReaderParams params = read_params;
+        params.rs_readers = {rs_reader};
+        params.origin_return_columns = &_origin_return_columns;
+        source->reader = std::make_unique<BlockReader>();
+        source->reader->set_batch_size(_batch_size);
+        RETURN_IF_ERROR(source->reader->init(params));
+        _sources.push_back(std::move(source));
+    }
+    if (_sources.size() > RowSourcesBuffer::MAX_SOURCES) {
+        return Status::InternalError(fmt::format(
+                "too many rowsets to merge vertically: {}, the limit is {}", _sources.size(),
+                RowSourcesBuffer::MAX_SOURCES));
+    }
+
+    if (_is_key) {
+        _merge_heap.reset(new std::priority_queue<RowsetSource*, std::vector<RowsetSource*>,
+                                                  RowsetSourceComparator>(
+                RowsetSourceComparator {_num_key_columns, sequence_loc}));
+        for (auto& source : _sources) {
+            RETURN_IF_ERROR(_fetch(source.get()));
+            if (!source->eof) {
+                _merge_heap->push(source.get());
+            }
+        }
+    } else {
+        _row_sources->seek_to_begin();
+        if (_keys_type == AGG_KEYS) {
+            _init_agg_state(tablet_schema);
+        }
+    }
+    return Status::OK();
+}
+
+void VerticalBlockReader::_init_agg_state(const TabletSchema& tablet_schema) {
+    auto block = tablet_schema.create_block(_read_columns);
+    for (auto pos : _output_positions) {
+        const auto& column = tablet_schema.column(_read_columns[pos]);
+        DCHECK(!column.is_key());
+        std::string agg_name =
+                TabletColumn::get_string_by_aggregation_type(column.aggregation()) +
+                AGG_READER_SUFFIX;
+        std::transform(agg_name.begin(), agg_name.end(), agg_name.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+
+        // create aggregate function
+        DataTypes argument_types;
+        argument_types.push_back(block.get_data_type(pos));
+        Array params;
+        AggregateFunctionPtr function = AggregateFunctionSimpleFactory::instance().get(
+                agg_name, argument_types, params, block.get_data_type(pos)->is_nullable());
+        DCHECK(function != nullptr);
+        _agg_functions.push_back(function);
+        // create aggregate data
+        AggregateDataPtr place = new char[function->size_of_data()];
+        function->create(place);
+        _agg_places.push_back(place);
+    }
+}
+
+Status VerticalBlockReader::_fetch(RowsetSource* source) {
+    while (source->row_pos >= source->block.rows()) {
+        if (source->reader_eof) {
+            source->eof = true;
+            return Status::OK();
+        }
+        source->block.clear_column_data();
+        source->row_pos = 0;
+        RETURN_IF_ERROR(source->reader->next_block_with_aggregation(&source->block, nullptr,
+                                                                    nullptr, &source->reader_eof));
+    }
+    return Status::OK();
+}
+
+Status VerticalBlockReader::next_block(Block* block, bool* eof) {
+    auto columns = block->mutate_columns();
+    DCHECK_EQ(columns.size(), _output_positions.size());
+    auto res = _is_key ? _key_next_block(columns, eof) : _value_next_block(columns, eof);
+    block->set_columns(std::move(columns));
+    return res;
+}
+
+bool VerticalBlockReader::_is_same_key(const RowsetSource& source,
+                                       const MutableColumns& columns) const {
+    // the key columns lead the output columns of the key group
+    const MutableColumns* last_key = &columns;
+    size_t last_row = columns[0]->size();
+    if (last_row == 0) {
+        if (_last_key.empty()) {
+            return false;
+        }
+        last_key = &_last_key;
+        last_row = 1;
+    }
+    for (size_t i = 0; i < _num_key_columns; ++i) {
+        if (source.block.get_by_position(i).column->compare_at(source.row_pos, last_row - 1,
+                                                               *(*last_key)[i], -1) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status VerticalBlockReader::_key_next_block(MutableColumns& columns, bool* eof) {
+    size_t rows = 0;
+    while (!_merge_heap->empty()) {
+        auto* source = _merge_heap->top();
+        bool is_same = _keys_type != DUP_KEYS && _is_same_key(*source, columns);
+        if (!is_same && rows == _batch_size) {
+            break;
+        }
+        _merge_heap->pop();
+        _row_sources->append(source->index, is_same);
+        if (is_same) {
+            ++_merged_rows;
+        } else {
+            for (size_t i = 0; i < _output_positions.size(); ++i) {
+                columns[i]->insert_from(*source->block.get_by_position(_output_positions[i]).column,
+                                        source->row_pos);
+            }
+            ++rows;
+        }
+        ++source->row_pos;
+        RETURN_IF_ERROR(_fetch(source));
+        if (!source->eof) {
+            _merge_heap->push(source);
+        }
+    }
+
+    // keep the keys of the last row to compare with the rows of the next block
+    if (rows > 0 && _keys_type != DUP_KEYS) {
+        _last_key.clear();
+        for (size_t i = 0; i < _num_key_columns; ++i) {
+            _last_key.push_back(columns[i]->clone_empty());
+            _last_key[i]->insert_from(*columns[i], rows - 1);
+        }
+    }
+    *eof = _merge_heap->empty();
+    return Status::OK();
+}
+
+Status VerticalBlockReader::_value_next_block(MutableColumns& columns, bool* eof) {
+    size_t rows = 0;
+    while (_row_sources->has_remaining()) {
+        auto entry = _row_sources->peek();
+        bool agg_flag = RowSourcesBuffer::agg_flag(entry);
+        if (!agg_flag) {
+            // the next row starts a new output row, so the aggregated row is complete
+            if (_agg_opened) {
+                _insert_agg_result(columns);
+            }
+            if (rows == _batch_size) {
+                break;
+            }
+        }
+        _row_sources->advance();
+
+        auto* source = _sources[RowSourcesBuffer::source(entry)].get();
+        RETURN_IF_ERROR(_fetch(source));
+        if (UNLIKELY(source->eof)) {
+            return Status::InternalError(
+                    "the rowset has less rows than the row sources in vertical merging");
+        }
+        if (_keys_type == AGG_KEYS) {
+            if (!agg_flag) {
+                _agg_opened = true;
+                ++rows;
+            }
+            _add_agg_row(*source);
+        } else if (!agg_flag) {
+            for (size_t i = 0; i < _output_positions.size(); ++i) {
+                columns[i]->insert_from(*source->block.get_by_position(_output_positions[i]).column,
+                                        source->row_pos);
+            }
+            ++rows;
+        }
+        ++source->row_pos;
+    }
+
+    if (!_row_sources->has_remaining()) {
+        if (_agg_opened) {
+            _insert_agg_result(columns);
+        }
+        *eof = true;
+    }
+    return Status::OK();
+}
+
+void VerticalBlockReader::_add_agg_row(const RowsetSource& source) {
+    for (size_t i = 0; i < _agg_functions.size(); ++i) {
+        const IColumn* column = source.block.get_by_position(_output_positions[i]).column.get();
+        _agg_functions[i]->add(_agg_places[i], &column, source.row_pos, nullptr);
+    }
+}
+
+void VerticalBlockReader::_insert_agg_result(MutableColumns& columns) {
+    for (size_t i = 0; i < _agg_functions.size(); ++i) {
+        _agg_functions[i]->insert_result_into(_agg_places[i], *columns[i]);
+        // reset aggregate data
+        _agg_functions[i]->destroy(_agg_places[i]);
+        _agg_functions[i]->create(_agg_places[i]);
+    }
+    _agg_opened = false;
+}
+
+uint64_t VerticalBlockReader::merged_rows() const {
+    uint64_t merged_rows = _merged_rows;
+    for (const auto& source : _sources) {
+        merged_rows += source->reader->merged_rows();
+    }
+    return merged_rows;
+}
+
+uint64_t VerticalBlockReader::filtered_rows() const {
+    uint64_t filtered_rows = 0;
+    for (const auto& source : _sources) {
+        filtered_rows += source->reader->filtered_rows();
+    }
+    return filtered_rows;
+}
+
+} // namespace doris::vectorized
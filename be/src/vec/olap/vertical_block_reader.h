@@ -0,0 +1,163 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include "olap/reader.h"
+#include "olap/rowset/rowset_reader.h"
+#include "vec/aggregate_functions/aggregate_function.h"
+#include "vec/core/block.h"
+
+namespace doris {
+namespace vectorized {
+
+class BlockReader;
+
+// The sources of the rows merged by the key group of a vertical compaction, one entry per
+// row read from the input rowsets, in the order the rows are merged.
+//
+// An entry records the index of the rowset the row is read from, and whether the row has
+// the same key as the previous one, that is the row is dropped for a UNIQUE KEY table and
+// aggregated into the previous row for an AGGREGATE KEY table.
+class RowSourcesBuffer {
+public:
+    static constexpr uint16_t SOURCE_MASK = 0x7FFF;
+    static constexpr uint16_t AGG_FLAG = 0x8000;
+    // the max number of rowsets the row sources can tell apart
+    static constexpr size_t MAX_SOURCES = SOURCE_MASK + 1;
+
+    void append(uint16_t source, bool agg_flag) {
+        _entries.push_back(agg_flag ? (source | AGG_FLAG) : source);
+    }
+
+    size_t size() const { return _entries.size(); }
+
+    // replay the entries from the first one
+    void seek_to_begin() { _pos = 0; }
+
+    bool has_remaining() const { return _pos < _entries.size(); }
+
+    uint16_t peek() const { return _entries[_pos]; }
+
+    void advance() { ++_pos; }
+
+    static uint16_t source(uint16_t entry) { return entry & SOURCE_MASK; }
+
+    static bool agg_flag(uint16_t entry) { return entry & AGG_FLAG; }
+
+private:
+    // 2 bytes per input row, kept in memory until all the column groups are merged
+    std::vector<uint16_t> _entries;
+    size_t _pos = 0;
+};
+
+// Reader of a column group of the vertical compaction.
+//
+// Each input rowset is read by a BlockReader of its own, which filters the deleted rows and
+// merges the overlapping segments of the rowset. The key group merges the rowsets by keys
+// as VCollectIterator does, and records the row sources. A value group replays the row
+// sources to take the rows of the rowsets in the same order without any comparison.
+// The key columns, the sequence column and the columns of the delete conditions are read
+// by every group, so that the rows of each rowset are filtered and merged the same way.
+class VerticalBlockReader {
+public:
+    explicit VerticalBlockReader(RowSourcesBuffer* row_sources) : _row_sources(row_sources) {}
+
+    ~VerticalBlockReader();
+
+    // `read_params.return_columns` are the columns read from the rowsets in the order of
+    // column id, the blocks returned hold the columns `output_columns` of them. The row
+    // sources are recorded if `is_key` is true, or replayed otherwise.
+    Status init(const TabletReader::ReaderParams& read_params,
+                const std::vector<uint32_t>& output_columns, bool is_key);
+
+    Status next_block(Block* block, bool* eof);
+
+    // must be called before init(), so that the rowsets are read in blocks of the same size
+    void set_batch_size(int batch_size) { _batch_size = batch_size; }
+
+    uint64_t merged_rows() const;
+
+    uint64_t filtered_rows() const;
+
+private:
+    struct RowsetSource {
+        std::unique_ptr<BlockReader> reader;
+        Block block;
+        size_t row_pos = 0;
+        int64_t version = -1;
+        uint16_t index = 0;
+        bool reader_eof = false;
+        // all the rows of the rowset are consumed
+        bool eof = false;
+    };
+
+    // ordered as the merge heap of VCollectIterator, the top is the row output next
+    struct RowsetSourceComparator {
+        size_t num_key_columns;
+        int sequence_loc;
+        bool operator()(const RowsetSource* lhs, const RowsetSource* rhs) const;
+    };
+
+    // make sure the source has a row to read unless it is eof
+    Status _fetch(RowsetSource* source);
+
+    Status _key_next_block(MutableColumns& columns, bool* eof);
+
+    Status _value_next_block(MutableColumns& columns, bool* eof);
+
+    // whether the current row of `source` has the same key as the last row output
+    bool _is_same_key(const RowsetSource& source, const MutableColumns& columns) const;
+
+    void _init_agg_state(const TabletSchema& tablet_schema);
+
+    void _add_agg_row(const RowsetSource& source);
+
+    void _insert_agg_result(MutableColumns& columns);
+
+    RowSourcesBuffer* _row_sources;
+    bool _is_key = false;
+    KeysType _keys_type = DUP_KEYS;
+    size_t _num_key_columns = 0;
+    size_t _batch_size = 1024;
+
+    // the columns read from the rowsets, and the positions of the output columns in them
+    std::vector<uint32_t> _read_columns;
+    std::vector<uint32_t> _origin_return_columns;
+    std::vector<size_t> _output_positions;
+
+    std::vector<std::unique_ptr<RowsetSource>> _sources;
+    std::unique_ptr<std::priority_queue<RowsetSource*, std::vector<RowsetSource*>,
+                                        RowsetSourceComparator>>
+            _merge_heap;
+    // the keys of the last row of the previous block
+    MutableColumns _last_key;
+    uint64_t _merged_rows = 0;
+
+    // the aggregate functions of the output columns, only for the value groups of
+    // AGGREGATE KEY tables
+    std::vector<AggregateFunctionPtr> _agg_functions;
+    std::vector<AggregateDataPtr> _agg_places;
+    bool _agg_opened = false;
+};
+
+} // namespace vectorized
+} // namespace doris
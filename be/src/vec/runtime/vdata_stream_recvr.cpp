@@ -42,7 +42,8 @@ VDataStreamRecvr::SenderQueue::~SenderQueue() = default;
 Status VDataStreamRecvr::SenderQueue::get_batch(Block** next_block) {
     std::unique_lock<std::mutex> l(_lock);
     // wait until something shows up or we know we're done
-    while (!_is_cancelled && _block_queue.empty() && _num_remaining_senders > 0) {
+    while (!_is_cancelled && _status.ok() && _block_queue.empty() &&
+           _num_remaining_senders > 0) {
         VLOG_ROW << "wait arrival fragment_instance_id=" << _recvr->fragment_instance_id()
                  << " node=" << _recvr->dest_node_id();
         // Don't count time spent waiting on the sender as active time.
@@ -59,6 +60,8 @@ Status VDataStreamRecvr::SenderQueue::get_batch(Block** next_block) {
     if (_is_cancelled) {
         return Status::Cancelled("Cancelled");
     }
+    // a block failed to be deserialized
+    RETURN_IF_ERROR(_status);
 
     if (_block_queue.empty()) {
         DCHECK_EQ(_num_remaining_senders, 0);
@@ -88,12 +91,12 @@ Status VDataStreamRecvr::SenderQueue::get_batch(Block** next_block) {
     return Status::OK();
 }
 
-void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_number,
-                                              int64_t packet_seq,
-                                              ::google::protobuf::Closure** done) {
+Status VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_number,
+                                                int64_t packet_seq,
+                                                ::google::protobuf::Closure** done) {
     std::lock_guard<std::mutex> l(_lock);
     if (_is_cancelled) {
-        return;
+        return Status::OK();
     }
     auto iter = _packet_seq_map.find(be_number);
     if (iter != _packet_seq_map.end()) {
@@ -101,7 +104,7 @@ void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_numbe
             LOG(WARNING) << fmt::format(
                     "packet already exist [cur_packet_id= {} receive_packet_id={}]", iter->second,
                     packet_seq);
-            return;
+            return Status::OK();
         }
         iter->second = packet_seq;
     } else {
@@ -112,17 +115,26 @@ void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_numbe
 
     if (_num_remaining_senders <= 0) {
         DCHECK(_sender_eos_set.end() != _sender_eos_set.find(be_number));
-        return;
+        return Status::OK();
     }
 
     if (_is_cancelled) {
-        return;
+        return Status::OK();
     }
 
-    Block* block = nullptr;
+    Block* block = new Block();
     {
         SCOPED_TIMER(_recvr->_deserialize_row_batch_timer);
-        block = new Block(pblock);
+        Status st = block->deserialize(pblock);
+        if (!st.ok()) {
+            delete block;
+            LOG(WARNING) << "failed to deserialize block from backend " << be_number << ": "
+                         << st.get_error_msg();
+            // fail the receiver, and the sender by the returned status
+            _status = st;
+            _data_arrival_cv.notify_one();
+            return st;
+        }
     }
     _recvr->_block_mem_tracker->consume(block->bytes());
 
@@ -138,19 +150,23 @@ void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_numbe
     }
     _recvr->_num_buffered_bytes += block_byte_size;
     _data_arrival_cv.notify_one();
+    return Status::OK();
 }
 
 void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
-    std::unique_lock<std::mutex> l(_lock);
-    if (_is_cancelled) {
-        return;
-    }
-    Block* nblock = new Block(block->get_columns_with_type_and_name());
+    // Build the queued block before taking the lock, so that copying does not
+    // block the other senders and the receiver.
+    std::unique_ptr<Block> nblock(new Block(block->get_columns_with_type_and_name()));
     nblock->info = block->info;
 
     // local exchange should copy the block contented if use move == false
     if (use_move) {
-        block->clear();
+        // The column data is handed over to the receiver without copy, the sender
+        // keeps the schema with empty columns so that the block can be filled again.
+        for (int i = 0; i < block->columns(); ++i) {
+            auto& column = block->get_by_position(i).column;
+            column = column->clone_empty();
+        }
     } else {
         auto rows = block->rows();
         for (int i = 0; i < nblock->columns(); ++i) {
@@ -159,13 +175,19 @@ void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
         }
     }
     materialize_block_inplace(*nblock);
-
     size_t block_size = nblock->bytes();
-    _block_queue.emplace_back(block_size, nblock);
-    _recvr->_block_mem_tracker->consume(nblock->bytes());
+
+    std::unique_lock<std::mutex> l(_lock);
+    if (_is_cancelled) {
+        return;
+    }
+    _block_queue.emplace_back(block_size, nblock.release());
+    _recvr->_block_mem_tracker->consume(block_size);
+    // count the block before waiting, get_batch() subtracts it once it is fetched
+    _recvr->_num_buffered_bytes += block_size;
     _data_arrival_cv.notify_one();
 
-    if (_recvr->exceeds_limit(block_size)) {
+    if (_recvr->exceeds_limit(0)) {
         std::thread::id tid = std::this_thread::get_id();
         MonotonicStopWatch monotonicStopWatch;
         monotonicStopWatch.start();
@@ -177,8 +199,6 @@ void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
         _pending_closures.emplace_back(iter->second.get(), monotonicStopWatch);
         iter->second->wait(l);
     }
-
-    _recvr->_num_buffered_bytes += block_size;
 }
 
 void VDataStreamRecvr::SenderQueue::decrement_senders(int be_number) {
@@ -309,11 +329,11 @@ Status VDataStreamRecvr::create_merger(const std::vector<VExprContext*>& orderin
     return Status::OK();
 }
 
-void VDataStreamRecvr::add_block(const PBlock& pblock, int sender_id, int be_number,
-                                 int64_t packet_seq, ::google::protobuf::Closure** done) {
+Status VDataStreamRecvr::add_block(const PBlock& pblock, int sender_id, int be_number,
+                                   int64_t packet_seq, ::google::protobuf::Closure** done) {
     SCOPED_SWITCH_THREAD_LOCAL_MEM_TRACKER(_mem_tracker);
     int use_sender_id = _is_merging ? sender_id : 0;
-    _sender_queues[use_sender_id]->add_block(pblock, be_number, packet_seq, done);
+    return _sender_queues[use_sender_id]->add_block(pblock, be_number, packet_seq, done);
 }
 
 void VDataStreamRecvr::add_block(Block* block, int sender_id, bool use_move) {
@@ -0,0 +1,199 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vdict_code_filter.h"
+
+#include <algorithm>
+
+#include "runtime/descriptors.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_common.h"
+#include "vec/common/assert_cast.h"
+#include "vec/exprs/vexpr.h"
+#include "vec/exprs/vexpr_context.h"
+#include "vec/exprs/vin_predicate.h"
+#include "vec/exprs/vslot_ref.h"
+
+namespace doris::vectorized {
+
+static bool is_dict_code_column(const IColumn& column) {
+    if (auto* nullable_column = check_and_get_column<ColumnNullable>(column)) {
+        return nullable_column->get_nested_column().is_column_dictionary();
+    }
+    return column.is_column_dictionary();
+}
+
+VDictCodeFilter::VDictCodeFilter(int column_id, std::unordered_set<std::string> values)
+        : _column_id(column_id),
+          _values(std::make_shared<const std::unordered_set<std::string>>(std::move(values))) {}
+
+void VDictCodeFilter::create_filters(VExprContext* vconjunct_ctx,
+                                     const std::vector<SlotDescriptor*>& slots,
+                                     std::vector<VDictCodeFilter>* filters) {
+    if (vconjunct_ctx == nullptr || vconjunct_ctx->root() == nullptr) {
+        return;
+    }
+
+    std::vector<VExpr*> exprs = {vconjunct_ctx->root()};
+    while (!exprs.empty()) {
+        VExpr* expr = exprs.back();
+        exprs.pop_back();
+        if (expr->is_and_expr()) {
+            exprs.insert(exprs.end(), expr->children().begin(), expr->children().end());
+            continue;
+        }
+
+        VExpr* slot_expr = nullptr;
+        std::vector<VExpr*> literal_exprs;
+        if (expr->node_type() == TExprNodeType::IN_PRED) {
+            auto* in_predicate = dynamic_cast<VInPredicate*>(expr);
+            if (in_predicate == nullptr || in_predicate->is_not_in()) {
+                continue;
+            }
+            slot_expr = expr->children()[0];
+            literal_exprs.assign(expr->children().begin() + 1, expr->children().end());
+        } else if (expr->fn().name.function_name == "eq" && expr->children().size() == 2) {
+            slot_expr = expr->children()[0];
+            literal_exprs.push_back(expr->children()[1]);
+            if (!slot_expr->is_slot_ref()) {
+                std::swap(slot_expr, literal_exprs[0]);
+            }
+        } else {
+            continue;
+        }
+        if (!slot_expr->is_slot_ref()) {
+            continue;
+        }
+
+        int slot_id = static_cast<VSlotRef*>(slot_expr)->slot_id();
+        int column_id = -1;
+        for (int i = 0; i < slots.size(); ++i) {
+            if (slots[i]->id() == slot_id) {
+                PrimitiveType type = slots[i]->type().type;
+                if (type == TYPE_VARCHAR || type == TYPE_STRING) {
+                    column_id = i;
+                }
+                break;
+            }
+        }
+        if (column_id == -1) {
+            continue;
+        }
+
+        std::unordered_set<std::string> values;
+        bool is_valid = true;
+        for (auto* literal_expr : literal_exprs) {
+            // a NULL in the list never makes the conjunct true
+            if (literal_expr->node_type() == TExprNodeType::NULL_LITERAL) {
+                continue;
+            }
+            if (literal_expr->node_type() != TExprNodeType::STRING_LITERAL) {
+                is_valid = false;
+                break;
+            }
+            ColumnPtrWrapper* value = literal_expr->get_const_col(vconjunct_ctx);
+            values.insert(value->column_ptr->get_data_at(0).to_string());
+        }
+        if (is_valid) {
+            filters->emplace_back(column_id, std::move(values));
+        }
+    }
+}
+
+void VDictCodeFilter::_evaluate(const IColumn& column, IColumn::Filter* filter) {
+    const IColumn* codes_column = &column;
+    const NullMap* null_map = nullptr;
+    if (auto* nullable_column = check_and_get_column<ColumnNullable>(column)) {
+        codes_column = &nullable_column->get_nested_column();
+        null_map = &nullable_column->get_null_map_data();
+    }
+    const auto& dict_column = assert_cast<const ColumnDictI32&>(*codes_column);
+
+    // a dictionary is only sorted in place once, by a range predicate of the storage
+    if (dict_column.dictionary() != _dict || dict_column.is_dict_sorted() != _dict_sorted) {
+        _dict = dict_column.dictionary();
+        _dict_sorted = dict_column.is_dict_sorted();
+        // the NULL rows may hold the default code 0 of an empty dictionary
+        _matched.assign(std::max<size_t>(_dict->size(), 1), 0);
+        for (size_t code = 0; code < _dict->size(); ++code) {
+            _matched[code] = _values->count(_dict->get_value(code).to_string());
+        }
+    }
+
+    const auto& codes = dict_column.get_data();
+    auto* res = filter->data();
+    for (size_t i = 0; i < codes.size(); ++i) {
+        res[i] &= _matched[codes[i]];
+    }
+    if (null_map != nullptr) {
+        for (size_t i = 0; i < codes.size(); ++i) {
+            res[i] &= !(*null_map)[i];
+        }
+    }
+}
+
+Status VDictCodeFilter::filter_block(std::vector<VDictCodeFilter>* filters, Block* block,
+                                     size_t* filtered_rows) {
+    *filtered_rows = 0;
+    std::vector<int> dict_column_ids;
+    for (int i = 0; i < block->columns(); ++i) {
+        if (is_dict_code_column(*block->get_by_position(i).column)) {
+            dict_column_ids.push_back(i);
+        }
+    }
+    if (dict_column_ids.empty()) {
+        return Status::OK();
+    }
+
+    size_t rows = block->rows();
+    IColumn::Filter filter(rows, 1);
+    for (auto& dict_code_filter : *filters) {
+        int column_id = dict_code_filter._column_id;
+        if (column_id < block->columns() &&
+            is_dict_code_column(*block->get_by_position(column_id).column)) {
+            dict_code_filter._evaluate(*block->get_by_position(column_id).column, &filter);
+        }
+    }
+
+    std::vector<uint16_t> sel_rowid_idx;
+    sel_rowid_idx.reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        if (filter[i]) {
+            sel_rowid_idx.push_back(i);
+        }
+    }
+    uint16_t selected_size = sel_rowid_idx.size();
+    *filtered_rows = rows - selected_size;
+
+    for (int i = 0; i < block->columns(); ++i) {
+        auto& column_with_type = block->get_by_position(i);
+        if (std::find(dict_column_ids.begin(), dict_column_ids.end(), i) !=
+            dict_column_ids.end()) {
+            // only the rows left are decoded
+            ColumnPtr codes = std::move(column_with_type.column);
+            block->replace_by_position(i, column_with_type.type->create_column());
+            RETURN_IF_ERROR(block->copy_column_data_to_block(codes->assume_mutable().get(),
+                                                             sel_rowid_idx.data(), selected_size,
+                                                             i, selected_size));
+        } else if (*filtered_rows > 0) {
+            column_with_type.column = column_with_type.column->filter(filter, selected_size);
+        }
+    }
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
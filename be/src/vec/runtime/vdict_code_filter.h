@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "common/status.h"
+#include "vec/columns/column_dictionary.h"
+#include "vec/core/block.h"
+
+namespace doris {
+class SlotDescriptor;
+
+namespace vectorized {
+
+class VExprContext;
+
+// A `slot = 'a'` or `slot IN ('a', 'b', ...)` conjunct of a VARCHAR or STRING slot, which the
+// VOlapScanner evaluates on the dictionary codes of the blocks it reads, see
+// StorageReadOptions::dict_code_columns. The values are compared with each entry of a
+// dictionary once, then the rows are filtered by their codes, and only the rows left are
+// decoded to strings.
+//
+// The conjunct stays in the conjuncts of the scanner, so the rows read from the plain
+// encoded pages, which are not codes, are still filtered by it.
+class VDictCodeFilter {
+public:
+    // `column_id` is the position of the slot in the blocks of the scanners
+    VDictCodeFilter(int column_id, std::unordered_set<std::string> values);
+
+    // Append the filters of the top level conjuncts of `vconjunct_ctx` which can be evaluated
+    // on the codes, `slots` are the slots of the blocks of the scanners.
+    static void create_filters(VExprContext* vconjunct_ctx,
+                               const std::vector<SlotDescriptor*>& slots,
+                               std::vector<VDictCodeFilter>* filters);
+
+    int column_id() const { return _column_id; }
+
+    // Remove the rows of `block` which do not pass `filters` on the dictionary code columns,
+    // then decode all the dictionary code columns to strings, the number of the removed rows
+    // is put in `filtered_rows`. Must be called before the next block is read from the storage.
+    static Status filter_block(std::vector<VDictCodeFilter>* filters, Block* block,
+                               size_t* filtered_rows);
+
+private:
+    using Dictionary = ColumnDictI32::Dictionary;
+
+    // Clear the entries of `filter` whose rows are NULL or not one of the values.
+    void _evaluate(const IColumn& column, IColumn::Filter* filter);
+
+    int _column_id;
+    // shared by the copies of the filter in the scanners
+    std::shared_ptr<const std::unordered_set<std::string>> _values;
+
+    // whether each code of `_dict` is one of the values, the dictionary is held so its
+    // address is not reused by the dictionary of another segment
+    std::shared_ptr<Dictionary> _dict;
+    bool _dict_sorted = false;
+    std::vector<uint8_t> _matched;
+};
+
+} // namespace vectorized
+} // namespace doris
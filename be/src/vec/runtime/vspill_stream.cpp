@@ -0,0 +1,144 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vspill_stream.h"
+
+#include <atomic>
+
+#include "gen_cpp/data.pb.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "runtime/tmp_file_mgr.h"
+#include "util/coding.h"
+
+namespace doris::vectorized {
+
+VSpillStream::VSpillStream(std::string path) : _path(std::move(path)) {}
+
+VSpillStream::~VSpillStream() {
+    if (_writer != nullptr) {
+        _writer->close();
+    }
+    _reader.reset();
+    if (_num_blocks > 0) {
+        Status st = Env::Default()->delete_file(_path);
+        if (!st.ok()) {
+            LOG(WARNING) << "fail to remove spill file " << _path << ": " << st.get_error_msg();
+        }
+    }
+}
+
+Status VSpillStream::create(RuntimeState* state, std::unique_ptr<VSpillStream>* stream) {
+    static std::atomic<uint32_t> s_next_device {0};
+
+    TmpFileMgr* tmp_file_mgr = state->exec_env()->tmp_file_mgr();
+    auto devices = tmp_file_mgr->active_tmp_devices();
+    if (devices.empty()) {
+        return Status::InternalError("no available tmp dir to spill");
+    }
+    auto device_id = devices[s_next_device.fetch_add(1) % devices.size()];
+
+    TmpFileMgr::File* tmp_file = nullptr;
+    RETURN_IF_ERROR(tmp_file_mgr->get_file(device_id, state->query_id(), &tmp_file));
+    // only the generated path is used, the file is written through Env
+    std::unique_ptr<TmpFileMgr::File> file_holder(tmp_file);
+    stream->reset(new VSpillStream(tmp_file->path()));
+    return Status::OK();
+}
+
+Status VSpillStream::_open_writer() {
+    DCHECK(_reader == nullptr) << "can not add block after prepare_for_read";
+    return Env::Default()->new_writable_file(_path, &_writer);
+}
+
+Status VSpillStream::add_block(const Block& block) {
+    if (block.rows() == 0) {
+        return Status::OK();
+    }
+    if (_writer == nullptr) {
+        RETURN_IF_ERROR(_open_writer());
+    }
+
+    PBlock pblock;
+    size_t uncompressed_bytes = 0, compressed_bytes = 0;
+    RETURN_IF_ERROR(block.serialize(&pblock, &uncompressed_bytes, &compressed_bytes,
+                                    &_column_values_buffer));
+    pblock.mutable_column_values()->swap(_column_values_buffer);
+
+    std::string buf;
+    if (!pblock.SerializeToString(&buf)) {
+        return Status::InternalError("fail to serialize spilled block");
+    }
+    pblock.mutable_column_values()->swap(_column_values_buffer);
+
+    uint8_t len_buf[sizeof(uint64_t)];
+    encode_fixed64_le(len_buf, buf.size());
+    Slice slices[2] = {Slice(len_buf, sizeof(len_buf)), Slice(buf)};
+    RETURN_IF_ERROR(_writer->appendv(slices, 2));
+
+    _bytes_written += sizeof(len_buf) + buf.size();
+    _block_bytes += block.bytes();
+    _num_rows += block.rows();
+    _num_blocks++;
+    return Status::OK();
+}
+
+Status VSpillStream::prepare_for_read() {
+    if (_writer != nullptr) {
+        RETURN_IF_ERROR(_writer->close());
+        _writer.reset();
+    }
+    _read_offset = 0;
+    _num_blocks_read = 0;
+    if (_num_blocks > 0 && _reader == nullptr) {
+        RETURN_IF_ERROR(Env::Default()->new_random_access_file(_path, &_reader));
+    }
+    return Status::OK();
+}
+
+Status VSpillStream::get_next(Block* block, bool* eos) {
+    DCHECK(_writer == nullptr) << "prepare_for_read should be called before get_next";
+    if (_num_blocks_read == _num_blocks) {
+        *eos = true;
+        return Status::OK();
+    }
+    DCHECK(_reader != nullptr);
+
+    uint8_t len_buf[sizeof(uint64_t)];
+    Slice len_slice(len_buf, sizeof(len_buf));
+    RETURN_IF_ERROR(_reader->read_at(_read_offset, &len_slice));
+    uint64_t len = decode_fixed64_le(len_buf);
+
+    _read_buffer.resize(len);
+    Slice data_slice(_read_buffer.data(), len);
+    RETURN_IF_ERROR(_reader->read_at(_read_offset + sizeof(len_buf), &data_slice));
+    _read_offset += sizeof(len_buf) + len;
+
+    PBlock pblock;
+    if (!pblock.ParseFromArray(_read_buffer.data(), len)) {
+        return Status::Corruption("fail to parse spilled block from " + _path);
+    }
+    Block spilled;
+    RETURN_IF_ERROR(spilled.deserialize(pblock));
+    block->swap(spilled);
+
+    _num_blocks_read++;
+    *eos = false;
+    return Status::OK();
+}
+
+} // namespace doris::vectorized
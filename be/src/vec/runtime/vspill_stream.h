@@ -0,0 +1,96 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "common/status.h"
+#include "env/env.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+class RuntimeState;
+
+namespace vectorized {
+
+// VSpillStream is an append-only sequence of blocks written to a temporary file, used by
+// the vectorized operators (hash join, aggregation, sort) to move data out of memory when
+// the in-memory state grows beyond its budget.
+//
+// The stream has two phases: blocks are appended with add_block() until prepare_for_read()
+// is called, after which they are returned in the same order by get_next(). Each block is
+// stored as a length-prefixed serialized PBlock, so the columns are compressed with the
+// same codec as blocks exchanged between fragments.
+//
+// The backing file is removed when the stream is destroyed.
+class VSpillStream {
+public:
+    // Create a stream backed by the given file path.
+    explicit VSpillStream(std::string path);
+
+    ~VSpillStream();
+
+    // Create a stream on one of the active tmp dirs of 'state''s TmpFileMgr. Dirs are
+    // picked round robin so that concurrent spills are spread over all scratch disks.
+    static Status create(RuntimeState* state, std::unique_ptr<VSpillStream>* stream);
+
+    // Append 'block' to the stream. Empty blocks are skipped.
+    Status add_block(const Block& block);
+
+    // Finish writing and rewind the stream to its first block.
+    Status prepare_for_read();
+
+    // Return the next spilled block into 'block'. 'eos' is set when all blocks are read.
+    Status get_next(Block* block, bool* eos);
+
+    const std::string& path() const { return _path; }
+
+    // Bytes written to disk, including the length prefix of each block.
+    int64_t bytes_written() const { return _bytes_written; }
+    // Sum of the in-memory size of the spilled blocks.
+    int64_t block_bytes() const { return _block_bytes; }
+    int64_t num_rows() const { return _num_rows; }
+    int64_t num_blocks() const { return _num_blocks; }
+    bool empty() const { return _num_rows == 0; }
+
+private:
+    Status _open_writer();
+
+    const std::string _path;
+
+    std::unique_ptr<WritableFile> _writer;
+    std::unique_ptr<RandomAccessFile> _reader;
+    uint64_t _read_offset = 0;
+    int64_t _num_blocks_read = 0;
+
+    int64_t _bytes_written = 0;
+    int64_t _block_bytes = 0;
+    int64_t _num_rows = 0;
+    int64_t _num_blocks = 0;
+
+    // reused between blocks to avoid reallocating the serialize buffer
+    std::string _column_values_buffer;
+    std::string _read_buffer;
+};
+
+using VSpillStreamSPtr = std::shared_ptr<VSpillStream>;
+
+} // namespace vectorized
+} // namespace doris
@@ -0,0 +1,107 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vtopn_filter.h"
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_common.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+VTopNFilter::VTopNFilter(std::string column_name, DataTypePtr data_type, bool is_asc,
+                         bool nulls_first, bool push_to_storage)
+        : _column_name(std::move(column_name)),
+          _data_type(std::move(data_type)),
+          _direction(is_asc ? 1 : -1),
+          _nulls_first(nulls_first),
+          _push_to_storage(push_to_storage) {}
+
+void VTopNFilter::update(const IColumn& column, size_t row) {
+    const IColumn* data_column = &column;
+    if (auto* nullable_column = check_and_get_column<ColumnNullable>(column)) {
+        if (nullable_column->is_null_at(row)) {
+            return;
+        }
+        data_column = &nullable_column->get_nested_column();
+    }
+
+    std::lock_guard<std::mutex> l(_lock);
+    if (_bound != nullptr && _direction * data_column->compare_at(row, 0, *_bound, 1) >= 0) {
+        return;
+    }
+    _bound = data_column->cut(row, 1);
+    _version.fetch_add(1, std::memory_order_release);
+}
+
+ColumnPtr VTopNFilter::_get_bound(int64_t* version) const {
+    std::lock_guard<std::mutex> l(_lock);
+    *version = _version.load(std::memory_order_relaxed);
+    return _bound;
+}
+
+int64_t VTopNFilter::get_olap_conditions(std::vector<TCondition>* conditions) const {
+    int64_t version = 0;
+    ColumnPtr bound = _get_bound(&version);
+    if (bound != nullptr && _push_to_storage) {
+        TCondition condition;
+        condition.__set_column_name(_column_name);
+        condition.__set_condition_op(_direction == 1 ? "<=" : ">=");
+        condition.condition_values.push_back(_data_type->to_string(*bound, 0));
+        conditions->push_back(std::move(condition));
+    }
+    return version;
+}
+
+Status VTopNFilter::filter_block(Block* block, int column_id, size_t* filtered_rows) const {
+    *filtered_rows = 0;
+    int64_t version = 0;
+    ColumnPtr bound = _get_bound(&version);
+    size_t rows = block->rows();
+    if (bound == nullptr || rows == 0) {
+        return Status::OK();
+    }
+
+    ColumnPtr column = block->get_by_position(column_id).column->convert_to_full_column_if_const();
+    const IColumn* data_column = column.get();
+    const NullMap* null_map = nullptr;
+    if (auto* nullable_column = check_and_get_column<ColumnNullable>(*column)) {
+        data_column = &nullable_column->get_nested_column();
+        null_map = &nullable_column->get_null_map_data();
+    }
+
+    auto filter_column = ColumnUInt8::create(rows);
+    auto& filter = filter_column->get_data();
+    for (size_t i = 0; i < rows; ++i) {
+        if (null_map != nullptr && (*null_map)[i]) {
+            filter[i] = _nulls_first;
+        } else {
+            filter[i] = _direction * data_column->compare_at(i, 0, *bound, 1) <= 0;
+        }
+    }
+    *filtered_rows = rows - count_bytes_in_filter(filter);
+    if (*filtered_rows == 0) {
+        return Status::OK();
+    }
+
+    int column_to_keep = block->columns();
+    block->insert({std::move(filter_column), std::make_shared<DataTypeUInt8>(), "topn_filter"});
+    return Block::filter_block(block, column_to_keep, column_to_keep);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,79 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/PaloInternalService_types.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type.h"
+
+namespace doris::vectorized {
+
+// The bound of the rows a top-n VSortNode can still output, published to the VOlapScanNode
+// below it, so the scan skips the pages and rows which can not reach the top n.
+//
+// The bound is the first ordering column of the n-th row of the sorted blocks the sort node
+// holds, so at least n rows are not worse than it, and a row whose first ordering column is
+// worse than the bound can not be in the result whatever its other ordering columns are.
+// The bound is never NULL. When the NULLs are sorted first they are better than the bound
+// and always kept, otherwise they are worse and always removed.
+class VTopNFilter {
+public:
+    // `data_type` is the not nullable type of the column, `push_to_storage` is false if the
+    // bound can not be compared with the zone maps of the column, or the rows with NULL,
+    // which the conditions of the storage remove, have to be kept.
+    VTopNFilter(std::string column_name, DataTypePtr data_type, bool is_asc, bool nulls_first,
+                bool push_to_storage);
+
+    // Called by the sort node with the n-th row of its sorted blocks, tighten the bound if
+    // the row is not NULL and better than it.
+    void update(const IColumn& column, size_t row);
+
+    // Increased every time the bound is tightened, 0 means there is no bound yet.
+    int64_t version() const { return _version.load(std::memory_order_acquire); }
+
+    // Append the condition of the current bound on the olap column, used to prune the pages
+    // by zone map. Return the version of the bound.
+    int64_t get_olap_conditions(std::vector<TCondition>* conditions) const;
+
+    // Remove the rows of `block` whose column `column_id` is worse than the bound, and the
+    // rows with NULL unless the NULLs are sorted first, the number of the removed rows is put
+    // in `filtered_rows`.
+    Status filter_block(Block* block, int column_id, size_t* filtered_rows) const;
+
+private:
+    ColumnPtr _get_bound(int64_t* version) const;
+
+    const std::string _column_name;
+    const DataTypePtr _data_type;
+    const int _direction;
+    const bool _nulls_first;
+    const bool _push_to_storage;
+
+    mutable std::mutex _lock;
+    // one not nullable row, nullptr if there is no bound yet
+    ColumnPtr _bound;
+    std::atomic<int64_t> _version {0};
+};
+
+} // namespace doris::vectorized
@@ -20,6 +20,7 @@
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 
+#include <boost/algorithm/string.hpp>
 #include <random>
 
 #include "runtime/client_cache.h"
@@ -29,6 +30,7 @@
 #include "runtime/runtime_state.h"
 #include "runtime/thread_context.h"
 #include "util/proto_util.h"
+#include "util/time.h"
 #include "vec/common/sip_hash.h"
 #include "vec/runtime/vdata_stream_mgr.h"
 #include "vec/runtime/vdata_stream_recvr.h"
@@ -72,13 +74,12 @@ Status VDataStreamSender::Channel::init(RuntimeState* state) {
 }
 
 Status VDataStreamSender::Channel::send_current_block(bool eos) {
-    // TODO: Now, local exchange will cause the performance problem is in a multi-threaded scenario
-    //  so this feature is turned off here. We need to re-examine this logic
-    //    if (is_local()) {
-    //        return send_local_block(eos);
-    //    }
+    // see enable_local_exchange_for_partitioned_sink for why this is not always done
+    if (is_local() && config::enable_local_exchange_for_partitioned_sink) {
+        return send_local_block(eos);
+    }
     auto block = _mutable_block->to_block();
-    RETURN_IF_ERROR(_parent->serialize_block(&block, _ch_cur_pb_block));
+    RETURN_IF_ERROR(_parent->serialize_block(&block, _ch_cur_pb_block, 1, &_compression_policy));
     block.clear_column_data();
     _mutable_block->set_muatable_columns(block.mutate_columns());
     RETURN_IF_ERROR(send_block(_ch_cur_pb_block, eos));
@@ -90,25 +91,27 @@ Status VDataStreamSender::Channel::send_local_block(bool eos) {
     std::shared_ptr<VDataStreamRecvr> recvr =
             _parent->state()->exec_env()->vstream_mgr()->find_recvr(_fragment_instance_id,
                                                                     _dest_node_id);
+    Block block = _mutable_block->to_block();
     if (recvr != nullptr) {
-        Block block = _mutable_block->to_block();
         COUNTER_UPDATE(_parent->_local_bytes_send_counter, block.bytes());
         recvr->add_block(&block, _parent->_sender_id, true);
         if (eos) {
             recvr->remove_sender(_parent->_sender_id, _be_number);
         }
     }
-    _mutable_block->clear();
+    // the receiver owns the rows now, keep filling the empty columns left in block
+    block.clear_column_data();
+    _mutable_block->set_muatable_columns(block.mutate_columns());
     return Status::OK();
 }
 
-Status VDataStreamSender::Channel::send_local_block(Block* block) {
+Status VDataStreamSender::Channel::send_local_block(Block* block, bool use_move) {
     std::shared_ptr<VDataStreamRecvr> recvr =
             _parent->state()->exec_env()->vstream_mgr()->find_recvr(_fragment_instance_id,
                                                                     _dest_node_id);
     if (recvr != nullptr) {
         COUNTER_UPDATE(_parent->_local_bytes_send_counter, block->bytes());
-        recvr->add_block(block, _parent->_sender_id, false);
+        recvr->add_block(block, _parent->_sender_id, use_move);
     }
     return Status::OK();
 }
@@ -118,9 +121,16 @@ Status VDataStreamSender::Channel::send_block(PBlock* block, bool eos) {
         _closure = new RefCountClosure<PTransmitDataResult>();
         _closure->ref();
     } else {
+        int64_t wait_start_ns = MonotonicNanos();
         RETURN_IF_ERROR(_wait_last_brpc());
+        int64_t now_ns = MonotonicNanos();
+        // the blocks broadcast to all the channels are compressed by the policy of the sender
+        _compression_policy.update_network_wait(now_ns - wait_start_ns, now_ns - _last_send_ns);
+        _parent->_compression_policy.update_network_wait(now_ns - wait_start_ns,
+                                                         now_ns - _last_send_ns);
         _closure->cntl.Reset();
     }
+    _last_send_ns = MonotonicNanos();
     VLOG_ROW << "Channel::send_batch() instance_id=" << _fragment_instance_id
              << " dest_node=" << _dest_node_id << " to_host=" << _brpc_dest_addr.hostname
              << " _packet_seq=" << _packet_seq << " row_desc=" << _row_desc.debug_string();
@@ -369,7 +379,15 @@ Status VDataStreamSender::prepare(RuntimeState* state) {
                                profile()->total_time_counter()),
             "");
     _local_bytes_send_counter = ADD_COUNTER(profile(), "LocalBytesSent", TUnit::BYTES);
+
+    segment_v2::CompressionTypePB compression_type;
+    bool adaptive;
+    RETURN_IF_ERROR(_parse_compression_codec(state->fragment_transmission_compression_codec(),
+                                             &compression_type, &adaptive));
+    _compression_policy.init(compression_type, adaptive);
     for (int i = 0; i < _channels.size(); ++i) {
+        _channels[i]->compression_policy()->init(compression_type, adaptive,
+                                                 _channels[i]->is_same_host());
         RETURN_IF_ERROR(_channels[i]->init(state));
     }
     return Status::OK();
@@ -400,15 +418,17 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block) {
         for (auto channel : _channels) {
             if (channel->is_local()) local_size++;
         }
+        // block is not used after being sent, so the last local channel takes over
+        // its data and only the others need a copy
         if (local_size == _channels.size()) {
             for (auto channel : _channels) {
-                RETURN_IF_ERROR(channel->send_local_block(block));
+                RETURN_IF_ERROR(channel->send_local_block(block, --local_size == 0));
             }
         } else {
             RETURN_IF_ERROR(serialize_block(block, _cur_pb_block, _channels.size()));
             for (auto channel : _channels) {
                 if (channel->is_local()) {
-                    RETURN_IF_ERROR(channel->send_local_block(block));
+                    RETURN_IF_ERROR(channel->send_local_block(block, --local_size == 0));
                 } else {
                     RETURN_IF_ERROR(channel->send_block(_cur_pb_block));
                 }
@@ -421,9 +441,10 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block) {
         Channel* current_channel = _channels[_current_channel_idx];
         // 2. serialize, send and rollover block
         if (current_channel->is_local()) {
-            RETURN_IF_ERROR(current_channel->send_local_block(block));
+            RETURN_IF_ERROR(current_channel->send_local_block(block, true));
         } else {
-            RETURN_IF_ERROR(serialize_block(block, current_channel->ch_cur_pb_block()));
+            RETURN_IF_ERROR(serialize_block(block, current_channel->ch_cur_pb_block(), 1,
+                                            current_channel->compression_policy()));
             RETURN_IF_ERROR(current_channel->send_block(current_channel->ch_cur_pb_block()));
             current_channel->ch_roll_pb_block();
         }
@@ -526,13 +547,19 @@ Status VDataStreamSender::close(RuntimeState* state, Status exec_status) {
     return final_st;
 }
 
-Status VDataStreamSender::serialize_block(Block* src, PBlock* dest, int num_receivers) {
+Status VDataStreamSender::serialize_block(Block* src, PBlock* dest, int num_receivers,
+                                          BlockCompressionPolicy* policy) {
+    if (policy == nullptr) {
+        policy = &_compression_policy;
+    }
     {
         SCOPED_TIMER(_serialize_batch_timer);
         dest->Clear();
         size_t uncompressed_bytes = 0, compressed_bytes = 0;
+        auto compression_type = policy->next_codec();
         RETURN_IF_ERROR(src->serialize(dest, &uncompressed_bytes, &compressed_bytes,
-                                       &_column_values_buffer));
+                                       &_column_values_buffer, compression_type));
+        policy->update(compression_type, uncompressed_bytes, compressed_bytes);
         COUNTER_UPDATE(_bytes_sent_counter, compressed_bytes * num_receivers);
         COUNTER_UPDATE(_uncompressed_bytes_counter, uncompressed_bytes * num_receivers);
     }
@@ -540,6 +567,31 @@ Status VDataStreamSender::serialize_block(Block* src, PBlock* dest, int num_rece
     return Status::OK();
 }
 
+Status VDataStreamSender::_parse_compression_codec(const std::string& codec,
+                                                   segment_v2::CompressionTypePB* compression_type,
+                                                   bool* adaptive) {
+    *adaptive = false;
+    std::string lower_codec = boost::algorithm::to_lower_copy(codec);
+    if (lower_codec.empty() || lower_codec == "snappy") {
+        *compression_type = segment_v2::CompressionTypePB::SNAPPY;
+    } else if (lower_codec == "lz4") {
+        *compression_type = segment_v2::CompressionTypePB::LZ4;
+    } else if (lower_codec == "zstd") {
+        *compression_type = segment_v2::CompressionTypePB::ZSTD;
+    } else if (lower_codec == "none") {
+        *compression_type = segment_v2::CompressionTypePB::NO_COMPRESSION;
+    } else if (lower_codec == "auto") {
+        // LZ4 is cheap enough for most networks, ZSTD is used for the destinations the
+        // network cannot keep up with, see BlockCompressionPolicy
+        *compression_type = segment_v2::CompressionTypePB::LZ4;
+        *adaptive = true;
+    } else {
+        return Status::InvalidArgument(
+                fmt::format("unknown fragment transmission compression codec: {}", codec));
+    }
+    return Status::OK();
+}
+
 void VDataStreamSender::_roll_pb_block() {
     _cur_pb_block = (_cur_pb_block == &_pb_block1 ? &_pb_block2 : &_pb_block1);
 }
@@ -17,11 +17,14 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "common/global_types.h"
 #include "exec/data_sink.h"
 #include "gen_cpp/PaloInternalService_types.h"
 #include "gen_cpp/data.pb.h"
 #include "gen_cpp/internal_service.pb.h"
+#include "gen_cpp/segment_v2.pb.h"
 #include "runtime/descriptors.h"
 #include "service/backend_options.h"
 #include "service/brpc.h"
@@ -45,6 +48,81 @@ namespace vectorized {
 class VExprContext;
 class VPartitionInfo;
 
+// Decides which codec compresses the next block sent to a destination.
+// In adaptive mode:
+// - blocks to another BE on the same host are not compressed.
+// - blocks are compressed by LZ4, or by ZSTD while the sender mostly waits for the
+//   previous rpc of the destination, i.e. the network is slower than the sender, as on
+//   cross-rack links. ZSTD costs more CPU but sends fewer bytes then.
+// - compression is skipped for a while once it turns out that the blocks hardly shrink,
+//   so that CPU is not wasted on incompressible data.
+class BlockCompressionPolicy {
+public:
+    void init(segment_v2::CompressionTypePB compression_type, bool adaptive,
+              bool same_host = false) {
+        _compression_type = compression_type;
+        _adaptive = adaptive;
+        if (_adaptive && same_host) {
+            _compression_type = segment_v2::CompressionTypePB::NO_COMPRESSION;
+        }
+    }
+
+    segment_v2::CompressionTypePB next_codec() const {
+        if (_skip_blocks > 0) {
+            return segment_v2::CompressionTypePB::NO_COMPRESSION;
+        }
+        return _network_bound ? segment_v2::CompressionTypePB::ZSTD : _compression_type;
+    }
+
+    // `wait_ns` is how long the sender waited for the previous rpc before sending a block,
+    // `interval_ns` the time since the previous block was sent.
+    void update_network_wait(int64_t wait_ns, int64_t interval_ns) {
+        if (!_adaptive || interval_ns <= 0 ||
+            _compression_type == segment_v2::CompressionTypePB::NO_COMPRESSION) {
+            return;
+        }
+        double wait_ratio = std::min(1.0, static_cast<double>(wait_ns) / interval_ns);
+        _wait_ratio = _wait_ratio * (1 - WAIT_RATIO_DECAY) + wait_ratio * WAIT_RATIO_DECAY;
+        // two thresholds, so the codec does not flip on every block
+        if (_wait_ratio > NETWORK_BOUND_WAIT_RATIO) {
+            _network_bound = true;
+        } else if (_wait_ratio < CPU_BOUND_WAIT_RATIO) {
+            _network_bound = false;
+        }
+    }
+
+    void update(segment_v2::CompressionTypePB used, size_t uncompressed_bytes,
+                size_t compressed_bytes) {
+        if (!_adaptive) {
+            return;
+        }
+        if (used == segment_v2::CompressionTypePB::NO_COMPRESSION) {
+            if (_skip_blocks > 0) {
+                --_skip_blocks;
+            }
+        } else if (compressed_bytes > uncompressed_bytes * MIN_COMPRESSION_RATIO) {
+            _skip_blocks = SKIP_BLOCKS_ON_BAD_RATIO;
+        }
+    }
+
+private:
+    // compressed size / uncompressed size above which compression is not worth it
+    static constexpr double MIN_COMPRESSION_RATIO = 0.8;
+    static constexpr int SKIP_BLOCKS_ON_BAD_RATIO = 16;
+    // share of the time the sender waits for the network above which ZSTD is used,
+    // and below which it goes back to the configured codec
+    static constexpr double NETWORK_BOUND_WAIT_RATIO = 0.5;
+    static constexpr double CPU_BOUND_WAIT_RATIO = 0.2;
+    // weight of the latest block in the moving average of the wait ratio
+    static constexpr double WAIT_RATIO_DECAY = 0.25;
+
+    segment_v2::CompressionTypePB _compression_type = segment_v2::CompressionTypePB::SNAPPY;
+    bool _adaptive = false;
+    int _skip_blocks = 0;
+    double _wait_ratio = 0;
+    bool _network_bound = false;
+};
+
 class VDataStreamSender final : public DataSink {
 public:
     VDataStreamSender(ObjectPool* pool, int sender_id, const RowDescriptor& row_desc,
@@ -67,11 +145,18 @@ public:
 
     RuntimeState* state() { return _state; }
 
-    Status serialize_block(Block* src, PBlock* dest, int num_receivers = 1);
+    // compress the block by the codec `policy` decides, the sender's own policy is used
+    // if it is nullptr
+    Status serialize_block(Block* src, PBlock* dest, int num_receivers = 1,
+                           BlockCompressionPolicy* policy = nullptr);
 
 private:
     void _roll_pb_block();
 
+    static Status _parse_compression_codec(const std::string& codec,
+                                           segment_v2::CompressionTypePB* compression_type,
+                                           bool* adaptive);
+
 private:
     class Channel;
 
@@ -114,6 +199,9 @@ private:
     PBlock _pb_block2;
     PBlock* _cur_pb_block = nullptr;
 
+    // codec of the blocks sent to all channels at once, channels have their own one
+    BlockCompressionPolicy _compression_policy;
+
     // compute per-row partition values
     std::vector<VExprContext*> _partition_expr_ctxs;
 
@@ -207,7 +295,9 @@ public:
 
     Status send_local_block(bool eos = false);
 
-    Status send_local_block(Block* block);
+    // the receiver takes over the column data of block without copy if use_move is true,
+    // and block is left with empty columns of the same schema
+    Status send_local_block(Block* block, bool use_move = false);
     // Flush buffered rows and close channel. This function don't wait the response
     // of close operation, client should call close_wait() to finish channel's close.
     // We split one close operation into two phases in order to make multiple channels
@@ -221,6 +311,13 @@ public:
 
     PBlock* ch_cur_pb_block() { return _ch_cur_pb_block; }
 
+    BlockCompressionPolicy* compression_policy() { return &_compression_policy; }
+
+    // another BE on the same host, blocks to it are sent by rpc but not over the network
+    bool is_same_host() const {
+        return _brpc_dest_addr.hostname == BackendOptions::get_localhost();
+    }
+
     std::string get_fragment_instance_id_str() {
         UniqueId uid(_fragment_instance_id);
         return uid.to_string();
@@ -293,6 +390,10 @@ private:
     PBlock* _ch_cur_pb_block = nullptr;
     PBlock _ch_pb_block1;
     PBlock _ch_pb_block2;
+
+    BlockCompressionPolicy _compression_policy;
+    // when the last block was sent by rpc
+    int64_t _last_send_ns = 0;
 };
 
 template <typename Channels, typename HashVals>
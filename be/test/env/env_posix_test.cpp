@@ -21,6 +21,8 @@
 
 #include "common/logging.h"
 #include "env/env.h"
+#include "env/env_posix.h"
+#include "env/io_uring.h"
 #include "util/file_utils.h"
 
 namespace doris {
@@ -216,4 +218,66 @@ TEST_F(EnvPosixTest, iterate_dir) {
     FileUtils::remove_all(dir_path);
 }
 
+TEST_F(EnvPosixTest, io_uring) {
+    std::unique_ptr<IOUring> io_uring;
+    auto st = IOUring::create(16, &io_uring);
+    if (!st.ok()) {
+        LOG(INFO) << "skip the test as io_uring is not available, st=" << st;
+        return;
+    }
+    IOUringEnv env(io_uring.get());
+    std::string fname = "./ut_dir/env_posix/io_uring";
+    std::unique_ptr<WritableFile> wfile;
+    st = env.new_writable_file(fname, &wfile);
+    EXPECT_TRUE(st.ok());
+
+    // more slices than IOV_MAX and the queue depth
+    std::vector<std::string> values;
+    for (int i = 0; i < 3000; ++i) {
+        values.push_back(std::to_string(i * 7));
+    }
+    std::vector<Slice> slices(values.begin(), values.end());
+    st = wfile->appendv(slices.data(), slices.size());
+    EXPECT_TRUE(st.ok());
+    st = wfile->close();
+    EXPECT_TRUE(st.ok());
+    std::string expected;
+    for (auto& value : values) {
+        expected.append(value);
+    }
+    EXPECT_EQ(expected.size(), wfile->size());
+
+    std::unique_ptr<RandomAccessFile> rfile;
+    st = env.new_random_access_file(fname, &rfile);
+    EXPECT_TRUE(st.ok());
+    EXPECT_TRUE(rfile->is_batch_read_supported());
+    {
+        std::string buf(expected.size(), '\0');
+        Slice read_slices[2] {Slice(buf.data(), 100), Slice(buf.data() + 100, buf.size() - 100)};
+        st = rfile->readv_at(0, read_slices, 2);
+        EXPECT_TRUE(st.ok());
+        EXPECT_EQ(expected, buf);
+    }
+    {
+        // read the ranges backward
+        std::string buf(expected.size(), '\0');
+        std::vector<ReadRange> ranges;
+        for (size_t offset = 0; offset < buf.size(); offset += 10) {
+            size_t size = std::min<size_t>(10, buf.size() - offset);
+            ranges.push_back({offset, Slice(buf.data() + offset, size)});
+        }
+        std::reverse(ranges.begin(), ranges.end());
+        st = rfile->read_batch(ranges.data(), ranges.size());
+        EXPECT_TRUE(st.ok());
+        EXPECT_EQ(expected, buf);
+    }
+    {
+        // end of file
+        char buf[10];
+        ReadRange range {expected.size() - 5, Slice(buf, 10)};
+        st = rfile->read_batch(&range, 1);
+        EXPECT_EQ(TStatusCode::END_OF_FILE, st.code());
+    }
+}
+
 } // namespace doris
@@ -290,4 +290,42 @@ TEST_F(PlainTextLineReaderUncompressedTest, uncompressed_test_empty) {
     EXPECT_TRUE(eof);
 }
 
+TEST_F(PlainTextLineReaderUncompressedTest, uncompressed_test_enclose) {
+    LocalFileReader file_reader("./be/test/exec/test_data/plain_text_line_reader/enclosed.csv",
+                                0);
+    auto st = file_reader.open();
+    EXPECT_TRUE(st.ok());
+
+    Decompressor* decompressor;
+    st = Decompressor::create_decompressor(CompressType::UNCOMPRESSED, &decompressor);
+    EXPECT_TRUE(st.ok());
+    EXPECT_TRUE(decompressor == nullptr);
+
+    PlainTextLineReader line_reader(&_profile, &file_reader, decompressor, -1, "\n", 1, '"');
+    const uint8_t* ptr;
+    size_t size;
+    bool eof;
+
+    // the line delimiter is in an enclosed value
+    st = line_reader.read_line(&ptr, &size, &eof);
+    EXPECT_TRUE(st.ok());
+    EXPECT_EQ("\"a\nb\",1", std::string((char*)ptr, size));
+    EXPECT_FALSE(eof);
+
+    // a doubled enclose char does not end the enclosed value
+    st = line_reader.read_line(&ptr, &size, &eof);
+    EXPECT_TRUE(st.ok());
+    EXPECT_EQ("\"c\"\"\",2", std::string((char*)ptr, size));
+    EXPECT_FALSE(eof);
+
+    st = line_reader.read_line(&ptr, &size, &eof);
+    EXPECT_TRUE(st.ok());
+    EXPECT_EQ("3", std::string((char*)ptr, size));
+    EXPECT_FALSE(eof);
+
+    st = line_reader.read_line(&ptr, &size, &eof);
+    EXPECT_TRUE(st.ok());
+    EXPECT_TRUE(eof);
+}
+
 } // end namespace doris
@@ -109,4 +109,45 @@ TEST_F(BloomFilterPredicateTest, bloom_filter_size_test) {
     EXPECT_EQ(length, len);
 }
 
+TEST_F(BloomFilterPredicateTest, bloom_filter_fold_test) {
+    // sized for far more values than inserted
+    std::unique_ptr<IBloomFilterFuncBase> func(create_bloom_filter(PrimitiveType::TYPE_INT));
+    func->init_with_fixed_length(1 << 20);
+    const int data_size = 1024;
+    int data[data_size];
+    for (int i = 0; i < data_size; i++) {
+        data[i] = i * 7;
+        func->insert((const void*)&data[i]);
+    }
+
+    func->fold(0.5);
+    char* bytes = nullptr;
+    int len = 0;
+    func->get_data(&bytes, &len);
+    EXPECT_LT(len, 1 << 20);
+    EXPECT_GE(len, data_size);
+    for (int i = 0; i < data_size; i++) {
+        EXPECT_TRUE(func->find((const void*)&data[i]));
+    }
+
+    // a filter of the original size can still be merged into the folded one
+    std::unique_ptr<IBloomFilterFuncBase> other(create_bloom_filter(PrimitiveType::TYPE_INT));
+    other->init_with_fixed_length(1 << 20);
+    int other_val = -1;
+    other->insert((const void*)&other_val);
+    EXPECT_TRUE(func->merge(other.get()).ok());
+    EXPECT_TRUE(func->find((const void*)&other_val));
+
+    // and the folded one into a filter of the original size
+    std::unique_ptr<IBloomFilterFuncBase> large(create_bloom_filter(PrimitiveType::TYPE_INT));
+    large->init_with_fixed_length(1 << 20);
+    EXPECT_TRUE(large->merge(func.get()).ok());
+    large->get_data(&bytes, &len);
+    EXPECT_LT(len, 1 << 20);
+    for (int i = 0; i < data_size; i++) {
+        EXPECT_TRUE(large->find((const void*)&data[i]));
+    }
+    EXPECT_TRUE(large->find((const void*)&other_val));
+}
+
 } // namespace doris
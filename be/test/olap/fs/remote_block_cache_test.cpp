@@ -0,0 +1,238 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/fs/remote_block_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+
+#include "util/file_utils.h"
+#include "util/storage_backend.h"
+
+namespace doris {
+
+// An object storage keeping the objects in memory, which counts the bytes downloaded.
+class MockStorageBackend : public StorageBackend {
+public:
+    Status download(const std::string& remote, const std::string& local) override {
+        return Status::NotSupported("mock");
+    }
+    Status direct_download(const std::string& remote, std::string* content) override {
+        return direct_download_range(remote, 0, SIZE_MAX, content);
+    }
+    Status direct_download_range(const std::string& remote, uint64_t offset, size_t length,
+                                 std::string* content) override {
+        auto it = objects.find(remote);
+        if (it == objects.end()) {
+            return Status::NotFound(remote + " not exists!");
+        }
+        *content = offset < it->second.size() ? it->second.substr(offset, length) : "";
+        downloaded_bytes += content->size();
+        return Status::OK();
+    }
+    Status file_size(const std::string& remote, uint64_t* size) override {
+        auto it = objects.find(remote);
+        if (it == objects.end()) {
+            return Status::NotFound(remote + " not exists!");
+        }
+        *size = it->second.size();
+        return Status::OK();
+    }
+    Status upload(const std::string& local, const std::string& remote) override {
+        return Status::NotSupported("mock");
+    }
+    Status upload_with_checksum(const std::string& local, const std::string& remote,
+                                const std::string& checksum) override {
+        return Status::NotSupported("mock");
+    }
+    Status list(const std::string& remote_path, bool contain_md5, bool recursion,
+                std::map<std::string, FileStat>* files) override {
+        return Status::NotSupported("mock");
+    }
+    Status rename(const std::string& orig_name, const std::string& new_name) override {
+        return Status::NotSupported("mock");
+    }
+    Status rename_dir(const std::string& orig_name, const std::string& new_name) override {
+        return Status::NotSupported("mock");
+    }
+    Status direct_upload(const std::string& remote, const std::string& content) override {
+        objects[remote] = content;
+        return Status::OK();
+    }
+    Status copy(const std::string& src, const std::string& dst) override {
+        return Status::NotSupported("mock");
+    }
+    Status copy_dir(const std::string& src, const std::string& dst) override {
+        return Status::NotSupported("mock");
+    }
+    Status rm(const std::string& remote) override {
+        objects.erase(remote);
+        return Status::OK();
+    }
+    Status rmdir(const std::string& remote) override { return Status::NotSupported("mock"); }
+    Status mkdir(const std::string& path) override { return Status::NotSupported("mock"); }
+    Status mkdirs(const std::string& path) override { return Status::NotSupported("mock"); }
+    Status exist(const std::string& path) override {
+        return objects.count(path) > 0 ? Status::OK() : Status::NotFound(path + " not exists!");
+    }
+    Status exist_dir(const std::string& path) override { return Status::NotSupported("mock"); }
+
+    std::map<std::string, std::string> objects;
+    size_t downloaded_bytes = 0;
+};
+
+class RemoteBlockCacheTest : public testing::Test {
+protected:
+    const std::string kCacheDir = "./ut_dir/remote_block_cache";
+    const std::string kRemotePath = "s3://bucket/data/0_0.dat";
+    static constexpr uint32_t kBlockSize = 4096;
+
+    void SetUp() override {
+        if (FileUtils::check_exist(kCacheDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kCacheDir).ok());
+        }
+        _content.resize(kBlockSize * 10 + 100);
+        for (size_t i = 0; i < _content.size(); ++i) {
+            _content[i] = 'a' + i % 26;
+        }
+        EXPECT_TRUE(_backend.direct_upload(kRemotePath, _content).ok());
+    }
+
+    void TearDown() override {
+        if (FileUtils::check_exist(kCacheDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kCacheDir).ok());
+        }
+    }
+
+    void check_read(fs::RemoteBlockCache* cache, uint64_t offset, size_t size) {
+        std::string buf(size, '\0');
+        ASSERT_TRUE(cache->read_at(&_backend, kRemotePath, offset, Slice(buf), false).ok());
+        ASSERT_EQ(_content.substr(offset, size), buf);
+    }
+
+    MockStorageBackend _backend;
+    std::string _content;
+};
+
+TEST_F(RemoteBlockCacheTest, read) {
+    fs::RemoteBlockCache cache(kCacheDir, 1024 * 1024, kBlockSize);
+    ASSERT_TRUE(cache.open().ok());
+
+    // across 3 blocks
+    check_read(&cache, kBlockSize - 10, kBlockSize + 20);
+    ASSERT_EQ(kBlockSize * 3, _backend.downloaded_bytes);
+    // cached
+    check_read(&cache, kBlockSize + 10, 100);
+    check_read(&cache, 0, kBlockSize * 3);
+    ASSERT_EQ(kBlockSize * 3, _backend.downloaded_bytes);
+
+    // the last block is short
+    check_read(&cache, _content.size() - 200, 200);
+    ASSERT_EQ(kBlockSize * 4 + 100, _backend.downloaded_bytes);
+
+    // beyond the end of the file
+    std::string buf(200, '\0');
+    ASSERT_FALSE(cache.read_at(&_backend, kRemotePath, _content.size() - 100, Slice(buf), false)
+                         .ok());
+    ASSERT_FALSE(cache.read_at(&_backend, "s3://bucket/not_exist", 0, Slice(buf), false).ok());
+}
+
+TEST_F(RemoteBlockCacheTest, reopen) {
+    {
+        fs::RemoteBlockCache cache(kCacheDir, 1024 * 1024, kBlockSize);
+        ASSERT_TRUE(cache.open().ok());
+        check_read(&cache, 0, _content.size());
+    }
+    size_t downloaded_bytes = _backend.downloaded_bytes;
+    ASSERT_EQ(_content.size(), downloaded_bytes);
+
+    // the blocks cached before are loaded
+    {
+        fs::RemoteBlockCache cache(kCacheDir, 1024 * 1024, kBlockSize);
+        ASSERT_TRUE(cache.open().ok());
+        check_read(&cache, 100, _content.size() - 100);
+        ASSERT_EQ(downloaded_bytes, _backend.downloaded_bytes);
+    }
+
+    // the blocks of another block size are dropped
+    {
+        fs::RemoteBlockCache cache(kCacheDir, 1024 * 1024, kBlockSize * 2);
+        ASSERT_TRUE(cache.open().ok());
+        check_read(&cache, 0, 100);
+        ASSERT_EQ(downloaded_bytes + kBlockSize * 2, _backend.downloaded_bytes);
+    }
+}
+
+TEST_F(RemoteBlockCacheTest, index_evicted_last) {
+    // each shard of the cache holds 2 blocks
+    fs::RemoteBlockCache cache(kCacheDir, 16 * (kBlockSize * 2 + 1024), kBlockSize);
+    ASSERT_TRUE(cache.open().ok());
+
+    // the footer and indexes in the last blocks
+    uint64_t index_offset = kBlockSize * 9;
+    ASSERT_TRUE(cache.warm_up(&_backend, kRemotePath, index_offset, _content.size() - index_offset)
+                        .ok());
+    size_t downloaded_bytes = _backend.downloaded_bytes;
+    ASSERT_EQ(_content.size() - index_offset, downloaded_bytes);
+
+    // scan the data many times
+    const std::string other_path = "s3://bucket/data/1_0.dat";
+    ASSERT_TRUE(_backend.direct_upload(other_path, std::string(kBlockSize * 64, 'x')).ok());
+    for (int i = 0; i < 3; ++i) {
+        std::string buf(kBlockSize * 64, '\0');
+        ASSERT_TRUE(cache.read_at(&_backend, other_path, 0, Slice(buf), false).ok());
+    }
+    ASSERT_GT(_backend.downloaded_bytes, downloaded_bytes + kBlockSize * 64);
+
+    // the indexes are still cached
+    downloaded_bytes = _backend.downloaded_bytes;
+    check_read(&cache, index_offset, _content.size() - index_offset);
+    ASSERT_EQ(downloaded_bytes, _backend.downloaded_bytes);
+}
+
+TEST_F(RemoteBlockCacheTest, erase) {
+    fs::RemoteBlockCache cache(kCacheDir, 1024 * 1024, kBlockSize);
+    ASSERT_TRUE(cache.open().ok());
+
+    const std::string other_path = "s3://bucket/data/0_01.dat";
+    ASSERT_TRUE(_backend.direct_upload(other_path, _content).ok());
+    std::string buf(kBlockSize, '\0');
+    ASSERT_TRUE(cache.read_at(&_backend, other_path, 0, Slice(buf), false).ok());
+    check_read(&cache, 0, kBlockSize);
+    // the index blocks are erased as well
+    ASSERT_TRUE(cache.warm_up(&_backend, kRemotePath, kBlockSize * 9, kBlockSize).ok());
+    size_t downloaded_bytes = _backend.downloaded_bytes;
+
+    // the blocks of the other file are kept
+    cache.erase(kRemotePath, false);
+    ASSERT_TRUE(cache.read_at(&_backend, other_path, 0, Slice(buf), false).ok());
+    ASSERT_EQ(downloaded_bytes, _backend.downloaded_bytes);
+    check_read(&cache, 0, kBlockSize);
+    check_read(&cache, kBlockSize * 9, kBlockSize);
+    ASSERT_EQ(downloaded_bytes + kBlockSize * 2, _backend.downloaded_bytes);
+
+    // all the files in the directory
+    downloaded_bytes = _backend.downloaded_bytes;
+    cache.erase("s3://bucket/data", true);
+    check_read(&cache, 0, kBlockSize);
+    ASSERT_TRUE(cache.read_at(&_backend, other_path, 0, Slice(buf), false).ok());
+    ASSERT_EQ(downloaded_bytes + kBlockSize * 2, _backend.downloaded_bytes);
+}
+
+} // namespace doris
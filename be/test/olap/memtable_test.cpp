@@ -0,0 +1,223 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/memtable.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "olap/rowset/rowset_writer.h"
+#include "olap/schema.h"
+#include "olap/tablet_schema.h"
+#include "runtime/mem_tracker.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_factory.hpp"
+
+namespace doris {
+
+// Keeps the blocks flushed by the memtable.
+class MockRowsetWriter : public RowsetWriter {
+public:
+    Status init(const RowsetWriterContext& rowset_writer_context) override { return Status::OK(); }
+    Status add_row(const RowCursor& row) override { return Status::NotSupported("add_row"); }
+    Status add_row(const ContiguousRow& row) override { return Status::NotSupported("add_row"); }
+
+    Status add_block(const vectorized::Block* block) override {
+        if (_block.columns() == 0) {
+            auto empty_block = block->clone_empty();
+            _block = vectorized::MutableBlock::build_mutable_block(&empty_block);
+        }
+        _block.add_rows(block, 0, block->rows());
+        return Status::OK();
+    }
+
+    Status add_rowset(RowsetSharedPtr rowset) override {
+        return Status::NotSupported("add_rowset");
+    }
+    Status add_rowset_for_linked_schema_change(RowsetSharedPtr rowset,
+                                               const SchemaMapping& schema_mapping) override {
+        return Status::NotSupported("add_rowset_for_linked_schema_change");
+    }
+    Status add_rowset_for_migration(RowsetSharedPtr rowset) override {
+        return Status::NotSupported("add_rowset_for_migration");
+    }
+    Status flush() override { return Status::OK(); }
+    RowsetSharedPtr build() override { return nullptr; }
+    Version version() override { return Version(); }
+    int64_t num_rows() override { return _block.rows(); }
+    RowsetId rowset_id() override { return RowsetId(); }
+    RowsetTypePB type() const override { return BETA_ROWSET; }
+
+    vectorized::Block block() { return _block.to_block(); }
+
+private:
+    vectorized::MutableBlock _block;
+};
+
+// The table (k1 int, k2 int null, v1 bigint, v2 int[, seq int]), the aggregation of the value
+// columns is given by the keys type.
+class MemTableTest : public testing::Test {
+public:
+    void SetUp() override { _sort_merge = config::enable_vectorized_memtable_sort_merge; }
+
+    void TearDown() override { config::enable_vectorized_memtable_sort_merge = _sort_merge; }
+
+    void init_tablet_schema(KeysType keys_type, bool has_sequence_col) {
+        std::string value_agg = keys_type == DUP_KEYS ? "NONE" : "REPLACE";
+        TabletSchemaPB schema_pb;
+        schema_pb.set_keys_type(keys_type);
+        schema_pb.set_num_short_key_columns(2);
+        auto add_column = [&](const std::string& name, const std::string& type, bool is_key,
+                              bool is_nullable, const std::string& aggregation) {
+            ColumnPB* column = schema_pb.add_column();
+            column->set_unique_id(schema_pb.column_size());
+            column->set_name(name);
+            column->set_type(type);
+            column->set_is_key(is_key);
+            column->set_is_nullable(is_nullable);
+            column->set_length(type == "BIGINT" ? 8 : 4);
+            column->set_index_length(type == "BIGINT" ? 8 : 4);
+            if (!is_key) {
+                column->set_aggregation(aggregation);
+            }
+        };
+        add_column("k1", "INT", true, false, "");
+        add_column("k2", "INT", true, true, "");
+        add_column("v1", "BIGINT", false, true, keys_type == AGG_KEYS ? "SUM" : value_agg);
+        add_column("v2", "INT", false, true, value_agg);
+        if (has_sequence_col) {
+            add_column("__DORIS_SEQUENCE_COL__", "INT", false, true, value_agg);
+            schema_pb.set_sequence_col_idx(4);
+        }
+        _tablet_schema.init_from_pb(schema_pb);
+        _keys_type = keys_type;
+    }
+
+    // Rows with repeated keys in no order, k2 and the values are null at times.
+    vectorized::Block create_block(int begin, int end) {
+        vectorized::Block block;
+        for (size_t cid = 0; cid < _tablet_schema.num_columns(); ++cid) {
+            const auto& column = _tablet_schema.column(cid);
+            auto data_type = vectorized::DataTypeFactory::instance().create_data_type(
+                    column, column.is_nullable());
+            block.insert({data_type->create_column(), data_type, column.name()});
+        }
+        auto columns = block.mutate_columns();
+        for (int i = begin; i < end; ++i) {
+            int32_t k1 = i * 7 % 37;
+            int32_t k2 = i * 13 % 11;
+            int64_t v1 = i;
+            int32_t v2 = i % 101;
+            int32_t seq = i * 31 % 17;
+            columns[0]->insert_data((const char*)&k1, sizeof(k1));
+            columns[1]->insert_data(i % 7 == 0 ? nullptr : (const char*)&k2, sizeof(k2));
+            columns[2]->insert_data(i % 5 == 0 ? nullptr : (const char*)&v1, sizeof(v1));
+            columns[3]->insert_data((const char*)&v2, sizeof(v2));
+            if (columns.size() > 4) {
+                columns[4]->insert_data((const char*)&seq, sizeof(seq));
+            }
+        }
+        block.set_columns(std::move(columns));
+        return block;
+    }
+
+    // Load the rows into a memtable, flush it and return the flushed rows.
+    std::vector<std::string> load(bool sort_merge) {
+        config::enable_vectorized_memtable_sort_merge = sort_merge;
+        Schema schema(_tablet_schema);
+        MockRowsetWriter writer;
+        auto memtable = std::make_unique<MemTable>(0, &schema, &_tablet_schema, nullptr, nullptr,
+                                                   _keys_type, &writer, nullptr, true);
+        for (int begin = 0; begin < 5000; begin += 1000) {
+            auto block = create_block(begin, begin + 1000);
+            // a block is inserted in parts, as the delta writer does for the tablets
+            memtable->insert(&block, 0, 400);
+            memtable->insert(&block, 400, 600);
+        }
+        EXPECT_EQ(5000, memtable->rows());
+        EXPECT_TRUE(memtable->flush().ok());
+
+        auto block = writer.block();
+        std::vector<std::string> rows;
+        for (size_t i = 0; i < block.rows(); ++i) {
+            std::string row;
+            for (size_t cid = 0; cid < block.columns(); ++cid) {
+                const auto& column = block.get_by_position(cid);
+                row += (cid == 0 ? "" : "|") + column.type->to_string(*column.column, i);
+            }
+            rows.push_back(row);
+            // sorted by the keys, with nulls first
+            if (i > 0) {
+                EXPECT_LE(block.compare_at(i - 1, i, _tablet_schema.num_key_columns(), block, -1),
+                          _keys_type == DUP_KEYS ? 0 : -1);
+            }
+        }
+        return rows;
+    }
+
+    // The sort-merge memtable flushes the same rows as the skiplist one.
+    void check_same_as_skiplist() {
+        auto rows = load(true);
+        auto expected = load(false);
+        if (_keys_type == DUP_KEYS) {
+            // the order of the rows with equal keys is not defined by the skiplist
+            EXPECT_EQ(5000, rows.size());
+            std::sort(rows.begin(), rows.end());
+            std::sort(expected.begin(), expected.end());
+        } else {
+            // 37 * 12 keys, k2 is null or one of 11 values
+            EXPECT_EQ(37 * 12, rows.size());
+        }
+        EXPECT_EQ(expected.size(), rows.size());
+        EXPECT_TRUE(expected == rows);
+    }
+
+protected:
+    TabletSchema _tablet_schema;
+    KeysType _keys_type = DUP_KEYS;
+
+private:
+    bool _sort_merge;
+};
+
+TEST_F(MemTableTest, sort_merge_dup_keys) {
+    init_tablet_schema(DUP_KEYS, false);
+    check_same_as_skiplist();
+}
+
+// v1 is summed, v2 is replaced by the last loaded row
+TEST_F(MemTableTest, sort_merge_agg_keys) {
+    init_tablet_schema(AGG_KEYS, false);
+    check_same_as_skiplist();
+}
+
+TEST_F(MemTableTest, sort_merge_unique_keys) {
+    init_tablet_schema(UNIQUE_KEYS, false);
+    check_same_as_skiplist();
+}
+
+// the row with the largest sequence value is kept, the last loaded one of them if it repeats
+TEST_F(MemTableTest, sort_merge_unique_keys_with_sequence_col) {
+    init_tablet_schema(UNIQUE_KEYS, true);
+    check_same_as_skiplist();
+}
+
+} // namespace doris
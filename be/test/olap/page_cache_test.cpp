@@ -243,4 +243,59 @@ TEST(StoragePageCacheTest, mixed_pages) {
     }
 }
 
+// The compressed pages are cached apart from the decompressed pages
+TEST(StoragePageCacheTest, compressed_page) {
+    StoragePageCache no_compressed_cache(kNumShards * 2048, 10);
+    EXPECT_FALSE(no_compressed_cache.is_compressed_cache_available());
+
+    StoragePageCache cache(kNumShards * 2048, 0, kNumShards * 2048);
+    EXPECT_TRUE(cache.is_compressed_cache_available());
+    // the compressed pages are tracked as the memory of the page cache
+    EXPECT_EQ(kNumShards * 2048 * 2, cache._mem_tracker->limit());
+
+    StoragePageCache::CacheKey key("abc", 0);
+    segment_v2::PageTypePB page_type = segment_v2::DATA_PAGE;
+
+    {
+        char* buf = new char[512];
+        PageCacheHandle handle;
+        cache.insert_compressed(key, Slice(buf, 512), &handle);
+        EXPECT_EQ(buf, handle.data().data);
+
+        auto found = cache.lookup_compressed(key, &handle);
+        EXPECT_TRUE(found);
+        EXPECT_EQ(buf, handle.data().data);
+        // not in the decompressed page cache
+        found = cache.lookup(key, &handle, page_type);
+        EXPECT_FALSE(found);
+    }
+
+    // the decompressed pages evicted are still found compressed
+    {
+        PageCacheHandle handle;
+        cache.insert(key, Slice(new char[1024], 1024), &handle, page_type, false);
+    }
+    for (int i = 1; i < 10 * kNumShards; ++i) {
+        StoragePageCache::CacheKey key("abc", i);
+        PageCacheHandle handle;
+        cache.insert(key, Slice(new char[1024], 1024), &handle, page_type, false);
+    }
+    {
+        PageCacheHandle handle;
+        EXPECT_FALSE(cache.lookup(key, &handle, page_type));
+        EXPECT_TRUE(cache.lookup_compressed(key, &handle));
+    }
+
+    // put too many compressed pages to eliminate the first one
+    for (int i = 1; i < 10 * kNumShards; ++i) {
+        StoragePageCache::CacheKey key("abc", i);
+        PageCacheHandle handle;
+        cache.insert_compressed(key, Slice(new char[512], 512), &handle);
+    }
+    {
+        PageCacheHandle handle;
+        EXPECT_FALSE(cache.lookup_compressed(key, &handle));
+    }
+}
+
 } // namespace doris
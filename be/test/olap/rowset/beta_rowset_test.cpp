@@ -15,6 +15,7 @@
 // specific language governing permissions and limitations
 // under the License.
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "gen_cpp/olap_file.pb.h"
@@ -359,4 +360,279 @@ TEST_F(BetaRowsetTest, BasicFunctionTest) {
     }
 }
 
+TEST_F(BetaRowsetTest, ConcurrentFlushTest) {
+    Status s;
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+
+    RowsetSharedPtr rowset;
+    const int num_segments = 3;
+    const uint32_t rows_per_segment = 4096;
+    { // flush the segments concurrently in the reverse order of their ids
+        RowsetWriterContext writer_context;
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        s = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+        EXPECT_EQ(Status::OK(), s);
+
+        std::vector<int32_t> segment_ids;
+        for (int i = 0; i < num_segments; ++i) {
+            int32_t num_reserved = 0;
+            segment_ids.push_back(
+                    rowset_writer->allocate_segment_ids(rows_per_segment, 0, &num_reserved));
+            EXPECT_EQ(i, segment_ids.back());
+            EXPECT_EQ(1, num_reserved);
+        }
+
+        // for segment "i", row "rid"
+        // k1 := rid*10 + i
+        // k2 := k1 * 10
+        // k3 := 4096 * i + rid
+        std::vector<Status> statuses(num_segments);
+        std::vector<std::thread> threads;
+        for (int i = num_segments - 1; i >= 0; --i) {
+            threads.emplace_back([&, i]() {
+                vectorized::Block block = tablet_schema.create_block({0, 1, 2});
+                auto columns = block.mutate_columns();
+                for (int rid = 0; rid < rows_per_segment; ++rid) {
+                    int32_t k1 = rid * 10 + i;
+                    int32_t k2 = k1 * 10;
+                    int32_t k3 = rows_per_segment * i + rid;
+                    columns[0]->insert_data(reinterpret_cast<const char*>(&k1), sizeof(k1));
+                    columns[1]->insert_data(reinterpret_cast<const char*>(&k2), sizeof(k2));
+                    columns[2]->insert_data(reinterpret_cast<const char*>(&k3), sizeof(k3));
+                }
+                block.set_columns(std::move(columns));
+                int64_t flush_size = 0;
+                statuses[i] = rowset_writer->flush_single_memtable(&block, segment_ids[i], 1,
+                                                                   &flush_size);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (auto& status : statuses) {
+            EXPECT_EQ(Status::OK(), status);
+        }
+
+        rowset = rowset_writer->build();
+        EXPECT_TRUE(rowset != nullptr);
+        EXPECT_EQ(num_segments, rowset->rowset_meta()->num_segments());
+        EXPECT_EQ(num_segments * rows_per_segment, rowset->rowset_meta()->num_rows());
+    }
+
+    { // the unordered result follows the order of the segment ids
+        RowsetReaderContext reader_context;
+        reader_context.tablet_schema = &tablet_schema;
+        reader_context.need_ordered_result = false;
+        std::vector<uint32_t> return_columns = {2};
+        reader_context.return_columns = &return_columns;
+        reader_context.seek_columns = &return_columns;
+        reader_context.stats = &_stats;
+
+        RowsetReaderSharedPtr rowset_reader;
+        create_and_init_rowset_reader(rowset.get(), reader_context, &rowset_reader);
+
+        RowBlock* output_block;
+        uint32_t num_rows_read = 0;
+        while ((s = rowset_reader->next_block(&output_block)) == Status::OK()) {
+            EXPECT_TRUE(output_block != nullptr);
+            for (int i = 0; i < output_block->row_num(); ++i) {
+                char* field3 = output_block->field_ptr(i, 2);
+                EXPECT_FALSE(*reinterpret_cast<bool*>(field3));
+                uint32_t k3 = *reinterpret_cast<uint32_t*>(field3 + 1);
+                EXPECT_EQ(num_rows_read, k3);
+                num_rows_read++;
+            }
+        }
+        EXPECT_EQ(Status::OLAPInternalError(OLAP_ERR_DATA_EOF), s);
+        EXPECT_EQ(rowset->rowset_meta()->num_rows(), num_rows_read);
+    }
+}
+
+TEST_F(BetaRowsetTest, ConcurrentFlushSplitTest) {
+    Status s;
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+
+    RowsetSharedPtr rowset;
+    const uint32_t max_rows_per_segment = 1000;
+    // the rows of the memtables after merging, and the rows inserted to them
+    const std::vector<uint32_t> memtable_rows = {2500, 1500};
+    const std::vector<uint32_t> inserted_rows = {4000, 1500};
+    { // flush the memtables concurrently in the reverse order, each to several segments
+        RowsetWriterContext writer_context;
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+        writer_context.max_rows_per_segment = max_rows_per_segment;
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        s = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+        EXPECT_EQ(Status::OK(), s);
+
+        std::vector<int32_t> segment_ids;
+        std::vector<int32_t> num_segments;
+        uint32_t first_row = 0;
+        std::vector<uint32_t> first_rows;
+        for (int i = 0; i < memtable_rows.size(); ++i) {
+            int32_t num_reserved = 0;
+            segment_ids.push_back(
+                    rowset_writer->allocate_segment_ids(inserted_rows[i], 0, &num_reserved));
+            num_segments.push_back(num_reserved);
+            first_rows.push_back(first_row);
+            first_row += memtable_rows[i];
+        }
+        // 4 ids for the first memtable, whose last one is not used, and 2 for the second
+        EXPECT_EQ(0, segment_ids[0]);
+        EXPECT_EQ(4, num_segments[0]);
+        EXPECT_EQ(4, segment_ids[1]);
+        EXPECT_EQ(2, num_segments[1]);
+
+        // k1 := k3 * 10, k2 := k1 * 10, and k3 increases over all the memtables
+        std::vector<Status> statuses(memtable_rows.size());
+        std::vector<std::thread> threads;
+        for (int i = memtable_rows.size() - 1; i >= 0; --i) {
+            threads.emplace_back([&, i]() {
+                vectorized::Block block = tablet_schema.create_block({0, 1, 2});
+                auto columns = block.mutate_columns();
+                for (uint32_t rid = 0; rid < memtable_rows[i]; ++rid) {
+                    int32_t k3 = first_rows[i] + rid;
+                    int32_t k1 = k3 * 10;
+                    int32_t k2 = k1 * 10;
+                    columns[0]->insert_data(reinterpret_cast<const char*>(&k1), sizeof(k1));
+                    columns[1]->insert_data(reinterpret_cast<const char*>(&k2), sizeof(k2));
+                    columns[2]->insert_data(reinterpret_cast<const char*>(&k3), sizeof(k3));
+                }
+                block.set_columns(std::move(columns));
+                int64_t flush_size = 0;
+                statuses[i] = rowset_writer->flush_single_memtable(&block, segment_ids[i],
+                                                                   num_segments[i], &flush_size);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (auto& status : statuses) {
+            EXPECT_EQ(Status::OK(), status);
+        }
+
+        rowset = rowset_writer->build();
+        EXPECT_TRUE(rowset != nullptr);
+        // 1000, 1000, 500 and 1000, 500 rows
+        EXPECT_EQ(5, rowset->rowset_meta()->num_segments());
+        EXPECT_EQ(first_row, rowset->rowset_meta()->num_rows());
+    }
+
+    { // the segments are contiguous, and the unordered result follows the order of the memtables
+        RowsetReaderContext reader_context;
+        reader_context.tablet_schema = &tablet_schema;
+        reader_context.need_ordered_result = false;
+        std::vector<uint32_t> return_columns = {2};
+        reader_context.return_columns = &return_columns;
+        reader_context.seek_columns = &return_columns;
+        reader_context.stats = &_stats;
+
+        RowsetReaderSharedPtr rowset_reader;
+        create_and_init_rowset_reader(rowset.get(), reader_context, &rowset_reader);
+
+        RowBlock* output_block;
+        uint32_t num_rows_read = 0;
+        while ((s = rowset_reader->next_block(&output_block)) == Status::OK()) {
+            EXPECT_TRUE(output_block != nullptr);
+            for (int i = 0; i < output_block->row_num(); ++i) {
+                char* field3 = output_block->field_ptr(i, 2);
+                EXPECT_FALSE(*reinterpret_cast<bool*>(field3));
+                uint32_t k3 = *reinterpret_cast<uint32_t*>(field3 + 1);
+                EXPECT_EQ(num_rows_read, k3);
+                num_rows_read++;
+            }
+        }
+        EXPECT_EQ(Status::OLAPInternalError(OLAP_ERR_DATA_EOF), s);
+        EXPECT_EQ(rowset->rowset_meta()->num_rows(), num_rows_read);
+    }
+}
+
+TEST_F(BetaRowsetTest, VerticalWriteTest) {
+    Status s;
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+
+    RowsetSharedPtr rowset;
+    const uint32_t num_rows = 10000;
+    const uint32_t max_rows_per_segment = 4096;
+    { // write the key group and the value group in blocks of different sizes
+        RowsetWriterContext writer_context;
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        s = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+        EXPECT_EQ(Status::OK(), s);
+
+        // for row "rid"
+        // k1 := rid
+        // k2 := k1 * 10
+        // v1 := k1 * 100
+        auto add_columns = [&](const std::vector<uint32_t>& col_ids, bool is_key,
+                               uint32_t begin, uint32_t end) {
+            vectorized::Block block = tablet_schema.create_block(col_ids);
+            auto columns = block.mutate_columns();
+            for (int32_t rid = begin; rid < end; ++rid) {
+                for (size_t i = 0; i < col_ids.size(); ++i) {
+                    int32_t value = rid;
+                    for (uint32_t cid = 0; cid < col_ids[i]; ++cid) {
+                        value *= 10;
+                    }
+                    columns[i]->insert_data(reinterpret_cast<const char*>(&value), sizeof(value));
+                }
+            }
+            block.set_columns(std::move(columns));
+            return rowset_writer->add_columns(&block, col_ids, is_key, max_rows_per_segment);
+        };
+
+        EXPECT_EQ(Status::OK(), add_columns({0, 1}, true, 0, 5000));
+        EXPECT_EQ(Status::OK(), add_columns({0, 1}, true, 5000, num_rows));
+        EXPECT_EQ(Status::OK(), rowset_writer->flush_columns());
+        EXPECT_EQ(Status::OK(), add_columns({2}, false, 0, 3000));
+        EXPECT_EQ(Status::OK(), add_columns({2}, false, 3000, num_rows));
+        EXPECT_EQ(Status::OK(), rowset_writer->flush_columns());
+        EXPECT_EQ(Status::OK(), rowset_writer->final_flush());
+
+        rowset = rowset_writer->build();
+        EXPECT_TRUE(rowset != nullptr);
+        EXPECT_EQ(3, rowset->rowset_meta()->num_segments());
+        EXPECT_EQ(num_rows, rowset->rowset_meta()->num_rows());
+    }
+
+    { // read all the columns back
+        RowsetReaderContext reader_context;
+        reader_context.tablet_schema = &tablet_schema;
+        reader_context.need_ordered_result = false;
+        std::vector<uint32_t> return_columns = {0, 1, 2};
+        reader_context.return_columns = &return_columns;
+        reader_context.seek_columns = &return_columns;
+        reader_context.stats = &_stats;
+
+        RowsetReaderSharedPtr rowset_reader;
+        create_and_init_rowset_reader(rowset.get(), reader_context, &rowset_reader);
+
+        RowBlock* output_block;
+        uint32_t num_rows_read = 0;
+        while ((s = rowset_reader->next_block(&output_block)) == Status::OK()) {
+            EXPECT_TRUE(output_block != nullptr);
+            for (int i = 0; i < output_block->row_num(); ++i) {
+                int32_t expected = num_rows_read;
+                for (uint32_t cid = 0; cid < 3; ++cid) {
+                    char* field = output_block->field_ptr(i, cid);
+                    EXPECT_FALSE(*reinterpret_cast<bool*>(field));
+                    EXPECT_EQ(expected, *reinterpret_cast<int32_t*>(field + 1));
+                    expected *= 10;
+                }
+                num_rows_read++;
+            }
+        }
+        EXPECT_EQ(Status::OLAPInternalError(OLAP_ERR_DATA_EOF), s);
+        EXPECT_EQ(num_rows, num_rows_read);
+    }
+}
+
 } // namespace doris
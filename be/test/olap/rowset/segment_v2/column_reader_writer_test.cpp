@@ -29,10 +29,12 @@
 #include "olap/rowset/segment_v2/column_writer.h"
 #include "olap/tablet_schema_helper.h"
 #include "olap/types.h"
+#include "runtime/exec_env.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
 #include "testutil/test_util.h"
 #include "util/file_utils.h"
+#include "util/threadpool.h"
 #include "vec/core/types.h"
 #include "vec/data_types/data_type_nothing.h"
 #include "vec/data_types/data_type_number.h"
@@ -845,5 +847,102 @@ TEST_F(ColumnReaderWriterTest, test_mixed_empty_arrays) {
             collection_values.get(), array_is_null.get(), num_array, "test_mixed_empty_arrays");
 }
 
+// the pages are still read ahead after the rows to read are reduced while reading
+TEST_F(ColumnReaderWriterTest, test_prefetch_row_ranges_changed) {
+    const int num_rows = 300000;
+    std::string fname = TEST_DIR + "/test_prefetch_row_ranges_changed";
+    ColumnMetaPB meta;
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions opts(fname);
+        std::string storage_name;
+        ASSERT_TRUE(fs::fs_util::block_manager(storage_name)->create_block(opts, &wblock).ok());
+        ColumnWriterOptions writer_opts;
+        writer_opts.meta = &meta;
+        writer_opts.meta->set_column_id(0);
+        writer_opts.meta->set_unique_id(0);
+        writer_opts.meta->set_type(OLAP_FIELD_TYPE_INT);
+        writer_opts.meta->set_length(0);
+        writer_opts.meta->set_encoding(BIT_SHUFFLE);
+        writer_opts.meta->set_compression(segment_v2::CompressionTypePB::LZ4F);
+        writer_opts.meta->set_is_nullable(false);
+        TabletColumn column(OLAP_FIELD_AGGREGATION_NONE, OLAP_FIELD_TYPE_INT);
+        std::unique_ptr<ColumnWriter> writer;
+        ColumnWriter::create(writer_opts, &column, wblock.get(), &writer);
+        ASSERT_TRUE(writer->init().ok());
+        for (int32_t i = 0; i < num_rows; ++i) {
+            ASSERT_TRUE(writer->append(false, &i).ok());
+        }
+        ASSERT_TRUE(writer->finish().ok());
+        ASSERT_TRUE(writer->write_data().ok());
+        ASSERT_TRUE(writer->write_ordinal_index().ok());
+        ASSERT_TRUE(wblock->close().ok());
+    }
+
+    int32_t prefetch_page_num = config::segment_prefetch_page_num;
+    config::segment_prefetch_page_num = 4;
+    std::unique_ptr<ThreadPool> prefetch_pool;
+    ASSERT_TRUE(ThreadPoolBuilder("SegmentPrefetchThreadPool")
+                        .set_min_threads(1)
+                        .set_max_threads(4)
+                        .build(&prefetch_pool)
+                        .ok());
+    ExecEnv::GetInstance()->set_segment_prefetch_thread_pool(std::move(prefetch_pool));
+
+    FilePathDesc path_desc;
+    path_desc.filepath = fname;
+    std::unique_ptr<ColumnReader> reader;
+    ASSERT_TRUE(ColumnReader::create(ColumnReaderOptions(), meta, num_rows, path_desc, &reader)
+                        .ok());
+    std::unique_ptr<fs::ReadableBlock> rblock;
+    ASSERT_TRUE(fs::fs_util::block_manager(path_desc)->open_block(path_desc, &rblock).ok());
+    ColumnIterator* iter_ptr = nullptr;
+    ASSERT_TRUE(reader->new_iterator(&iter_ptr).ok());
+    std::unique_ptr<ColumnIterator> iter(iter_ptr);
+    ColumnIteratorOptions iter_opts;
+    OlapReaderStatistics stats;
+    iter_opts.stats = &stats;
+    iter_opts.rblock = rblock.get();
+    ASSERT_TRUE(iter->init(iter_opts).ok());
+
+    // many small ranges in every page
+    auto row_ranges = std::make_shared<RowRanges>();
+    for (int32_t i = 0; i < num_rows; i += 1000) {
+        row_ranges->add(RowRange(i, i + 10));
+    }
+    iter->set_prefetch_row_ranges(row_ranges);
+    ASSERT_TRUE(iter->seek_to_first().ok());
+
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    ColumnVectorBatch::create(0, false, get_scalar_type_info(OLAP_FIELD_TYPE_INT), nullptr, &cvb);
+    cvb->resize(1024);
+    ColumnBlock col(cvb.get(), &_pool);
+    auto read_and_check = [&](int32_t from) {
+        int32_t expected = from;
+        while (expected < num_rows) {
+            size_t rows_read = 1024;
+            ColumnBlockView dst(&col);
+            ASSERT_TRUE(iter->next_batch(&rows_read, &dst).ok());
+            ASSERT_GT(rows_read, 0);
+            for (size_t j = 0; j < rows_read; ++j) {
+                ASSERT_EQ(expected++, *reinterpret_cast<const int32_t*>(col.cell_ptr(j)));
+            }
+        }
+    };
+    // only the first page is not prefetched
+    ASSERT_EQ(1, stats.prefetch_pages_miss_num);
+
+    // the rows before 5000 are filtered out, the rest are read
+    iter->set_prefetch_row_ranges(
+            std::make_shared<RowRanges>(RowRanges::create_single(5000, num_rows)));
+    ASSERT_TRUE(iter->seek_to_ordinal(5000).ok());
+    read_and_check(5000);
+    EXPECT_EQ(1, stats.prefetch_pages_miss_num);
+    EXPECT_GT(stats.prefetch_pages_hit_num, 10);
+
+    ExecEnv::GetInstance()->set_segment_prefetch_thread_pool(nullptr);
+    config::segment_prefetch_page_num = prefetch_page_num;
+}
+
 } // namespace segment_v2
 } // namespace doris
@@ -0,0 +1,154 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/page_io.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "olap/fs/block_manager.h"
+#include "olap/fs/fs_util.h"
+#include "olap/olap_common.h"
+#include "olap/page_cache.h"
+#include "util/block_compression.h"
+#include "util/file_utils.h"
+
+namespace doris {
+
+using namespace segment_v2;
+
+// A block counting the reads of the block it wraps.
+class CountingReadableBlock : public fs::ReadableBlock {
+public:
+    explicit CountingReadableBlock(std::unique_ptr<fs::ReadableBlock> block)
+            : _block(std::move(block)) {}
+
+    const BlockId& id() const override { return _block->id(); }
+    const FilePathDesc& path_desc() const override { return _block->path_desc(); }
+    Status close() override { return _block->close(); }
+    fs::BlockManager* block_manager() const override { return _block->block_manager(); }
+    Status size(uint64_t* sz) const override { return _block->size(sz); }
+    Status read(uint64_t offset, Slice result) const override {
+        ++num_reads;
+        return _block->read(offset, result);
+    }
+    Status readv(uint64_t offset, const Slice* res, size_t res_cnt) const override {
+        ++num_reads;
+        return _block->readv(offset, res, res_cnt);
+    }
+
+    mutable int num_reads = 0;
+
+private:
+    std::unique_ptr<fs::ReadableBlock> _block;
+};
+
+class PageIOTest : public testing::Test {
+public:
+    const std::string kTestDir = "./ut_dir/page_io_test";
+
+    void SetUp() override {
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+        EXPECT_TRUE(FileUtils::create_dir(kTestDir).ok());
+    }
+    void TearDown() override {
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+    }
+};
+
+// A page found in the compressed page cache is decompressed without reading the block
+TEST_F(PageIOTest, compressed_page_cache) {
+    std::string filename = kTestDir + "/compressed_page_cache.dat";
+    const BlockCompressionCodec* codec = nullptr;
+    ASSERT_TRUE(get_block_compression_codec(LZ4F, &codec).ok());
+
+    std::string body;
+    for (int i = 0; i < 4096; ++i) {
+        body.append(std::to_string(i % 16));
+    }
+    PagePointer page_pointer;
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions opts(filename);
+        std::string storage_name;
+        ASSERT_TRUE(fs::fs_util::block_manager(storage_name)->create_block(opts, &wblock).ok());
+        PageFooterPB footer;
+        footer.set_type(DATA_PAGE);
+        footer.set_uncompressed_size(body.size());
+        ASSERT_TRUE(PageIO::compress_and_write_page(codec, 0.1, wblock.get(), {Slice(body)},
+                                                    footer, &page_pointer)
+                            .ok());
+        ASSERT_TRUE(wblock->close().ok());
+    }
+    // the page is compressed
+    ASSERT_LT(page_pointer.size, body.size());
+
+    std::unique_ptr<fs::ReadableBlock> block;
+    std::string storage_name;
+    ASSERT_TRUE(fs::fs_util::block_manager(storage_name)
+                        ->open_block(FilePathDesc(filename), &block)
+                        .ok());
+    CountingReadableBlock rblock(std::move(block));
+
+    // only the index pages are cached decompressed, the data pages are cached compressed
+    StoragePageCache cache(1024 * 1024, 100, 1024 * 1024);
+    StoragePageCache* global_cache = StoragePageCache::_s_instance;
+    StoragePageCache::_s_instance = &cache;
+
+    OlapReaderStatistics stats;
+    PageReadOptions opts;
+    opts.rblock = &rblock;
+    opts.page_pointer = page_pointer;
+    opts.codec = codec;
+    opts.stats = &stats;
+    opts.type = DATA_PAGE;
+
+    for (int i = 0; i < 3; ++i) {
+        PageHandle handle;
+        Slice page_body;
+        PageFooterPB footer;
+        ASSERT_TRUE(PageIO::read_and_decompress_page(opts, &handle, &page_body, &footer).ok());
+        ASSERT_EQ(body, page_body.to_string());
+        ASSERT_EQ(body.size(), footer.uncompressed_size());
+    }
+    // read from the block only once
+    EXPECT_EQ(1, rblock.num_reads);
+    EXPECT_EQ(0, stats.cached_pages_num);
+    EXPECT_EQ(2, stats.compressed_cached_pages_num);
+
+    // not cached at all without the page cache
+    opts.use_page_cache = false;
+    {
+        PageHandle handle;
+        Slice page_body;
+        PageFooterPB footer;
+        ASSERT_TRUE(PageIO::read_and_decompress_page(opts, &handle, &page_body, &footer).ok());
+        ASSERT_EQ(body, page_body.to_string());
+    }
+    EXPECT_EQ(2, rblock.num_reads);
+    EXPECT_EQ(2, stats.compressed_cached_pages_num);
+
+    StoragePageCache::_s_instance = global_cache;
+}
+
+} // namespace doris
@@ -0,0 +1,113 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/primary_key_index.h"
+
+#include <gtest/gtest.h>
+
+#include "env/env.h"
+#include "olap/fs/block_manager.h"
+#include "olap/fs/fs_util.h"
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+#include "util/file_utils.h"
+
+namespace doris {
+namespace segment_v2 {
+
+const std::string kTestDir = "./ut_dir/primary_key_index_test";
+
+class PrimaryKeyIndexTest : public testing::Test {
+public:
+    void SetUp() override {
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+        EXPECT_TRUE(FileUtils::create_dir(kTestDir).ok());
+    }
+    void TearDown() override {
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+    }
+};
+
+TEST_F(PrimaryKeyIndexTest, builder_and_reader) {
+    std::string filename = kTestDir + "/builder_and_reader";
+    const int num_keys = 10000;
+    std::vector<std::string> keys;
+    // keys with even suffix only, so that odd ones can be used as missing keys
+    for (int i = 0; i < num_keys; ++i) {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "key%08d", i * 2);
+        keys.emplace_back(buf);
+    }
+
+    PrimaryKeyIndexMetaPB index_meta;
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions opts(filename);
+        std::string storage_name;
+        Status st = fs::fs_util::block_manager(storage_name)->create_block(opts, &wblock);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+
+        PrimaryKeyIndexBuilder builder(wblock.get());
+        ASSERT_TRUE(builder.init().ok());
+        for (const auto& key : keys) {
+            ASSERT_TRUE(builder.add_item(key).ok());
+        }
+        EXPECT_EQ(num_keys, builder.num_rows());
+        ASSERT_TRUE(builder.finalize(&index_meta).ok());
+        ASSERT_TRUE(wblock->close().ok());
+        EXPECT_EQ(keys.front(), index_meta.min_key());
+        EXPECT_EQ(keys.back(), index_meta.max_key());
+    }
+
+    PrimaryKeyIndexReader reader;
+    ASSERT_TRUE(reader.load(FilePathDesc(filename), index_meta).ok());
+    EXPECT_EQ(num_keys, reader.num_rows());
+    auto iter = reader.new_iterator();
+
+    // every key maps to its own row
+    for (int i = 0; i < num_keys; i += 7) {
+        rowid_t row_id = 0;
+        Status st = reader.lookup_row_key(iter.get(), keys[i], &row_id);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        EXPECT_EQ(i, row_id);
+    }
+
+    // keys between, before and after the existing ones are not found
+    rowid_t row_id = 0;
+    EXPECT_TRUE(reader.lookup_row_key(iter.get(), "key00000001", &row_id).is_not_found());
+    EXPECT_TRUE(reader.lookup_row_key(iter.get(), "aaa", &row_id).is_not_found());
+    EXPECT_TRUE(reader.lookup_row_key(iter.get(), "key99999999", &row_id).is_not_found());
+
+    // keys can be read back in row id order
+    auto tracker = std::make_shared<MemTracker>();
+    MemPool pool(tracker.get());
+    std::vector<Slice> slices(1024);
+    ordinal_t ordinal = num_keys - 100;
+    size_t n = slices.size();
+    ASSERT_TRUE(reader.read_keys(iter.get(), ordinal, &n, slices.data(), &pool).ok());
+    EXPECT_EQ(100, n);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(keys[ordinal + i], slices[i].to_string());
+    }
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -595,6 +595,65 @@ TEST_F(SegmentReaderWriterTest, TestIndex) {
     }
 }
 
+TEST_F(SegmentReaderWriterTest, TestRuntimeConditions) {
+    TabletSchema tablet_schema = create_schema(
+            {create_int_key(1), create_int_key(2), create_int_key(3), create_int_value(4)});
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+
+    std::shared_ptr<Segment> segment;
+    // 64k int will generate 4 pages
+    build_segment(
+            opts, tablet_schema, tablet_schema, 64 * 1024,
+            [](size_t rid, int cid, int block_id, RowCursorCell& cell) {
+                cell.set_not_null();
+                *(int*)cell.mutable_cell_ptr() = rid * 10 + cid;
+            },
+            &segment);
+
+    Schema schema(tablet_schema);
+    OlapReaderStatistics stats;
+    std::vector<std::unique_ptr<Conditions>> runtime_conditions;
+    StorageReadOptions read_opts;
+    read_opts.stats = &stats;
+    read_opts.runtime_conditions = &runtime_conditions;
+
+    std::unique_ptr<RowwiseIterator> iter;
+    segment->new_iterator(schema, read_opts, &iter);
+
+    RowBlockV2 block(schema, 1024);
+    EXPECT_TRUE(iter->next_batch(&block).ok());
+    EXPECT_EQ(1024, block.num_rows());
+
+    // the filter arrives after the first block, only the last page can pass it
+    TCondition condition;
+    condition.__set_column_name("1");
+    condition.__set_condition_op(">=");
+    std::vector<std::string> vals = {std::to_string(48 * 1024 * 10)};
+    condition.__set_condition_values(vals);
+    runtime_conditions.emplace_back(new Conditions());
+    runtime_conditions.back()->set_tablet_schema(&tablet_schema);
+    EXPECT_EQ(Status::OK(), runtime_conditions.back()->append_condition(condition));
+
+    int rowid = 48 * 1024;
+    while (true) {
+        block.clear();
+        auto st = iter->next_batch(&block);
+        if (st.is_end_of_file()) {
+            break;
+        }
+        EXPECT_TRUE(st.ok());
+        auto column_block = block.column_block(0);
+        for (int i = 0; i < block.num_rows(); ++i) {
+            EXPECT_EQ((rowid + i) * 10, *(int*)column_block.cell_ptr(i)) << "i:" << i;
+        }
+        rowid += block.num_rows();
+    }
+    EXPECT_EQ(64 * 1024, rowid);
+    EXPECT_EQ(48 * 1024 - 1024, stats.rows_runtime_conditions_filtered);
+}
+
 TEST_F(SegmentReaderWriterTest, estimate_segment_size) {
     size_t num_rows_per_block = 10;
 
@@ -0,0 +1,297 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "olap/data_dir.h"
+#include "olap/row_block.h"
+#include "olap/row_cursor.h"
+#include "olap/rowset/rowset_factory.h"
+#include "olap/rowset/rowset_reader_context.h"
+#include "olap/rowset/rowset_writer.h"
+#include "olap/rowset/rowset_writer_context.h"
+#include "olap/tablet.h"
+#include "olap/tablet_meta.h"
+#include "olap/tablet_meta_manager.h"
+#include "runtime/mem_pool.h"
+#include "util/file_utils.h"
+
+namespace doris {
+
+// key and value of a row
+using Row = std::pair<int32_t, int32_t>;
+
+// Merge-on-write unique key tablet (k1 int, v1 int replace), the rows overwritten by a later
+// load are marked in the delete bitmap when the load is published.
+class TabletDeleteBitmapTest : public testing::Test {
+protected:
+    const std::string kTestDir = "./ut_dir/tablet_delete_bitmap_test";
+    const int64_t kTabletId = 10001;
+    const int32_t kSchemaHash = 270068375;
+
+    void SetUp() override {
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+        EXPECT_TRUE(FileUtils::create_dir(kTestDir).ok());
+        _data_dir.reset(new DataDir(kTestDir));
+        ASSERT_TRUE(_data_dir->init().ok());
+
+        TTabletSchema tablet_schema;
+        tablet_schema.schema_hash = kSchemaHash;
+        tablet_schema.short_key_column_count = 1;
+        tablet_schema.keys_type = TKeysType::UNIQUE_KEYS;
+        tablet_schema.storage_type = TStorageType::COLUMN;
+        TColumn k1;
+        k1.column_name = "k1";
+        k1.__set_is_key(true);
+        k1.__set_is_allow_null(false);
+        k1.column_type.type = TPrimitiveType::INT;
+        tablet_schema.columns.push_back(k1);
+        TColumn v1;
+        v1.column_name = "v1";
+        v1.__set_is_key(false);
+        v1.__set_is_allow_null(false);
+        v1.column_type.type = TPrimitiveType::INT;
+        v1.__set_aggregation_type(TAggregationType::REPLACE);
+        tablet_schema.columns.push_back(v1);
+
+        TabletMetaSharedPtr tablet_meta(new TabletMeta(
+                1, 2, kTabletId, kSchemaHash, 0, tablet_schema, 2, {{0, 0}, {1, 1}},
+                UniqueId(3, 4), TTabletType::TABLET_TYPE_DISK, TStorageMedium::HDD, "", true));
+        _tablet = Tablet::create_tablet_from_meta(tablet_meta, StorageParamPB(), _data_dir.get());
+        ASSERT_TRUE(_tablet->init().ok());
+        ASSERT_TRUE(FileUtils::create_dir(_tablet->tablet_path_desc().filepath).ok());
+    }
+
+    void TearDown() override {
+        _tablet.reset();
+        _data_dir.reset();
+        if (FileUtils::check_exist(kTestDir)) {
+            EXPECT_TRUE(FileUtils::remove_all(kTestDir).ok());
+        }
+    }
+
+    // Write a rowset of `version`, each of `segments` is written as a segment.
+    RowsetSharedPtr write_rowset(const Version& version,
+                                 const std::vector<std::vector<Row>>& segments) {
+        RowsetWriterContext context;
+        context.rowset_id.init(++_next_rowset_id);
+        context.tablet_id = kTabletId;
+        context.partition_id = 2;
+        context.tablet_schema_hash = kSchemaHash;
+        context.rowset_type = BETA_ROWSET;
+        context.path_desc = _tablet->tablet_path_desc();
+        context.rowset_state = VISIBLE;
+        context.tablet_schema = &_tablet->tablet_schema();
+        context.version = version;
+        context.segments_overlap = segments.size() > 1 ? OVERLAPPING : NONOVERLAPPING;
+        context.data_dir = _data_dir.get();
+        context.enable_unique_key_merge_on_write = true;
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        EXPECT_TRUE(RowsetFactory::create_rowset_writer(context, &rowset_writer).ok());
+        RowCursor row;
+        row.init(_tablet->tablet_schema());
+        MemPool pool("TabletDeleteBitmapTest");
+        for (auto& segment : segments) {
+            for (auto [key, value] : segment) {
+                row.set_not_null(0);
+                row.set_field_content(0, reinterpret_cast<char*>(&key), &pool);
+                row.set_not_null(1);
+                row.set_field_content(1, reinterpret_cast<char*>(&value), &pool);
+                EXPECT_TRUE(rowset_writer->add_row(row).ok());
+            }
+            EXPECT_TRUE(rowset_writer->flush().ok());
+        }
+        RowsetSharedPtr rowset = rowset_writer->build();
+        EXPECT_NE(nullptr, rowset);
+        return rowset;
+    }
+
+    // Read the rows of `rowsets` visible at `version` without merging them by key.
+    std::map<int32_t, int32_t> read(const std::vector<RowsetSharedPtr>& rowsets, int64_t version,
+                                    OlapReaderStatistics* stats) {
+        std::map<int32_t, int32_t> rows;
+        std::vector<uint32_t> return_columns = {0, 1};
+        for (auto& rowset : rowsets) {
+            if (rowset->end_version() > version) {
+                continue;
+            }
+            RowsetReaderContext context;
+            context.reader_type = READER_QUERY;
+            context.tablet_schema = &_tablet->tablet_schema();
+            context.return_columns = &return_columns;
+            context.seek_columns = &return_columns;
+            context.stats = stats;
+            context.delete_bitmap = &_tablet->delete_bitmap();
+            context.version = {0, version};
+
+            RowsetReaderSharedPtr reader;
+            EXPECT_TRUE(rowset->create_reader(&reader).ok());
+            EXPECT_TRUE(reader->init(&context).ok());
+            RowBlock* block = nullptr;
+            Status st;
+            while ((st = reader->next_block(&block)).ok()) {
+                for (size_t i = 0; i < block->row_num(); ++i) {
+                    int32_t key = *reinterpret_cast<int32_t*>(block->field_ptr(i, 0) + 1);
+                    int32_t value = *reinterpret_cast<int32_t*>(block->field_ptr(i, 1) + 1);
+                    // every key is visible only once
+                    EXPECT_TRUE(rows.emplace(key, value).second) << "duplicate key " << key;
+                }
+            }
+            EXPECT_EQ(Status::OLAPInternalError(OLAP_ERR_DATA_EOF), st);
+        }
+        return rows;
+    }
+
+    std::unique_ptr<DataDir> _data_dir;
+    TabletSharedPtr _tablet;
+    int64_t _next_rowset_id = 10000;
+};
+
+// keys overwritten by the older rowsets and by the earlier segments in the same rowset
+TEST_F(TabletDeleteBitmapTest, overlapping_keys) {
+    auto rs2 = write_rowset({2, 2}, {{{1, 10}, {2, 20}, {3, 30}}});
+    auto rs3 = write_rowset({3, 3}, {{{2, 21}, {4, 41}}, {{2, 22}, {3, 32}}});
+    ASSERT_TRUE(_tablet->add_inc_rowset(rs2).ok());
+    ASSERT_TRUE(_tablet->add_inc_rowset(rs3).ok());
+
+    auto& delete_bitmap = _tablet->delete_bitmap();
+    EXPECT_EQ(3, delete_bitmap.cardinality());
+    // key 2 and 3 of rs2 are overwritten by rs3
+    EXPECT_FALSE(delete_bitmap.contains_agg({rs2->rowset_id(), 0, 2}, 1));
+    EXPECT_TRUE(delete_bitmap.contains_agg({rs2->rowset_id(), 0, 3}, 1));
+    EXPECT_TRUE(delete_bitmap.contains_agg({rs2->rowset_id(), 0, 3}, 2));
+    EXPECT_FALSE(delete_bitmap.contains_agg({rs2->rowset_id(), 0, 3}, 0));
+    // key 2 of the first segment is overwritten by the second segment
+    EXPECT_TRUE(delete_bitmap.contains_agg({rs3->rowset_id(), 0, 3}, 0));
+    EXPECT_FALSE(delete_bitmap.contains_agg({rs3->rowset_id(), 0, 3}, 1));
+    EXPECT_FALSE(delete_bitmap.contains_agg({rs3->rowset_id(), 1, 3}, 0));
+
+    // the reader filters out the overwritten rows visible at its version
+    OlapReaderStatistics stats;
+    EXPECT_EQ((std::map<int32_t, int32_t> {{1, 10}, {2, 20}, {3, 30}}),
+              read({rs2, rs3}, 2, &stats));
+    EXPECT_EQ(0, stats.rows_del_by_bitmap);
+    EXPECT_EQ((std::map<int32_t, int32_t> {{1, 10}, {2, 22}, {3, 32}, {4, 41}}),
+              read({rs2, rs3}, 3, &stats));
+    EXPECT_EQ(3, stats.rows_del_by_bitmap);
+}
+
+// a load published before an older one overwrites the rows of the older one
+TEST_F(TabletDeleteBitmapTest, out_of_order_publish) {
+    auto rs2 = write_rowset({2, 2}, {{{1, 21}, {3, 23}}});
+    auto rs3 = write_rowset({3, 3}, {{{1, 31}, {2, 32}}});
+    ASSERT_TRUE(_tablet->add_inc_rowset(rs3).ok());
+    ASSERT_TRUE(_tablet->add_inc_rowset(rs2).ok());
+
+    auto& delete_bitmap = _tablet->delete_bitmap();
+    EXPECT_EQ(1, delete_bitmap.cardinality());
+    EXPECT_FALSE(delete_bitmap.contains_agg({rs2->rowset_id(), 0, 2}, 0));
+    EXPECT_TRUE(delete_bitmap.contains_agg({rs2->rowset_id(), 0, 3}, 0));
+
+    OlapReaderStatistics stats;
+    EXPECT_EQ((std::map<int32_t, int32_t> {{1, 21}, {3, 23}}), read({rs2, rs3}, 2, &stats));
+    EXPECT_EQ((std::map<int32_t, int32_t> {{1, 31}, {2, 32}, {3, 23}}),
+              read({rs2, rs3}, 3, &stats));
+}
+
+// the rows of the compaction output overwritten by the loads not compacted
+TEST_F(TabletDeleteBitmapTest, update_after_compaction) {
+    auto rs2 = write_rowset({2, 2}, {{{1, 10}, {2, 20}}});
+    auto rs3 = write_rowset({3, 3}, {{{2, 30}, {3, 30}}});
+    auto rs4 = write_rowset({4, 4}, {{{3, 40}}});
+    ASSERT_TRUE(_tablet->add_inc_rowset(rs2).ok());
+    ASSERT_TRUE(_tablet->add_inc_rowset(rs3).ok());
+    ASSERT_TRUE(_tablet->add_inc_rowset(rs4).ok());
+
+    // compact [2-3], the rows of rs3 are not merged with rs4
+    auto output = write_rowset({2, 3}, {{{1, 10}, {2, 30}, {3, 30}}});
+    {
+        std::lock_guard<std::shared_mutex> wrlock(_tablet->get_header_lock());
+        ASSERT_TRUE(_tablet->update_delete_bitmap_after_compaction(output).ok());
+        std::vector<RowsetSharedPtr> to_add = {output};
+        std::vector<RowsetSharedPtr> to_delete = {rs2, rs3};
+        _tablet->modify_rowsets(to_add, to_delete);
+    }
+
+    auto& delete_bitmap = _tablet->delete_bitmap();
+    EXPECT_FALSE(delete_bitmap.contains_agg({output->rowset_id(), 0, 3}, 2));
+    EXPECT_TRUE(delete_bitmap.contains_agg({output->rowset_id(), 0, 4}, 2));
+    EXPECT_FALSE(delete_bitmap.contains_agg({output->rowset_id(), 0, 4}, 1));
+
+    OlapReaderStatistics stats;
+    EXPECT_EQ((std::map<int32_t, int32_t> {{1, 10}, {2, 30}, {3, 30}}),
+              read({output, rs4}, 3, &stats));
+    EXPECT_EQ((std::map<int32_t, int32_t> {{1, 10}, {2, 30}, {3, 40}}),
+              read({output, rs4}, 4, &stats));
+}
+
+// the delete bitmap of a publish is saved alone, until the tablet meta is saved
+TEST_F(TabletDeleteBitmapTest, save_delete_bitmap) {
+    auto rs2 = write_rowset({2, 2}, {{{1, 10}, {2, 20}}});
+    auto rs3 = write_rowset({3, 3}, {{{2, 30}, {3, 30}}});
+    auto rs4 = write_rowset({4, 4}, {{{1, 40}, {3, 40}}});
+    ASSERT_TRUE(_tablet->add_inc_rowset(rs2).ok());
+    ASSERT_TRUE(_tablet->add_inc_rowset(rs3).ok());
+    ASSERT_TRUE(_tablet->add_inc_rowset(rs4).ok());
+
+    std::vector<std::string> keys;
+    ASSERT_TRUE(TabletMetaManager::get_delete_bitmap_keys(_data_dir.get(), kTabletId, &keys).ok());
+    EXPECT_EQ(3, keys.size());
+
+    // all the rows marked are saved
+    DeleteBitmap saved;
+    ASSERT_TRUE(TabletMetaManager::traverse_delete_bitmaps(
+                        _data_dir->get_meta(),
+                        [&](TTabletId tablet_id, const std::string& key,
+                            const DeleteBitmap& delete_bitmap) {
+                            EXPECT_EQ(kTabletId, tablet_id);
+                            saved.merge(delete_bitmap);
+                            return true;
+                        })
+                        .ok());
+    EXPECT_EQ(3, saved.cardinality());
+    EXPECT_TRUE(saved == _tablet->delete_bitmap());
+
+    // merged into a tablet loaded from the tablet meta saved before
+    TabletMetaSharedPtr tablet_meta(new TabletMeta(*_tablet->tablet_meta()));
+    tablet_meta->delete_bitmap() = DeleteBitmap();
+    TabletSharedPtr tablet =
+            Tablet::create_tablet_from_meta(tablet_meta, StorageParamPB(), _data_dir.get());
+    ASSERT_TRUE(tablet->init().ok());
+    tablet->merge_saved_delete_bitmap(saved);
+    EXPECT_TRUE(tablet->delete_bitmap() == _tablet->delete_bitmap());
+
+    // removed once the tablet meta with the delete bitmap is saved
+    _tablet->save_meta();
+    keys.clear();
+    ASSERT_TRUE(TabletMetaManager::get_delete_bitmap_keys(_data_dir.get(), kTabletId, &keys).ok());
+    EXPECT_TRUE(keys.empty());
+    TabletMetaSharedPtr loaded(new TabletMeta());
+    ASSERT_TRUE(
+            TabletMetaManager::get_meta(_data_dir.get(), kTabletId, kSchemaHash, loaded).ok());
+    EXPECT_TRUE(loaded->delete_bitmap() == _tablet->delete_bitmap());
+}
+
+} // namespace doris
@@ -41,4 +41,37 @@ TEST(TabletMetaTest, SaveAndParse) {
     EXPECT_EQ(old_tablet_meta, new_tablet_meta);
 }
 
+TEST(TabletMetaTest, DeleteBitmap) {
+    RowsetId rowset_id;
+    rowset_id.init(1);
+    DeleteBitmap delete_bitmap;
+    // rows marked by the load of version 3 and version 5
+    delete_bitmap.add({rowset_id, 0, 3}, 1);
+    delete_bitmap.add({rowset_id, 0, 3}, 2);
+    delete_bitmap.add({rowset_id, 0, 5}, 10);
+    delete_bitmap.add({rowset_id, 1, 5}, 7);
+    EXPECT_EQ(4, delete_bitmap.cardinality());
+
+    // a reader only sees the marks not newer than its version
+    EXPECT_EQ(nullptr, delete_bitmap.get_agg({rowset_id, 0, 2}));
+    auto bitmap = delete_bitmap.get_agg({rowset_id, 0, 4});
+    ASSERT_NE(nullptr, bitmap);
+    EXPECT_EQ(2, bitmap->cardinality());
+    EXPECT_FALSE(bitmap->contains(10));
+    bitmap = delete_bitmap.get_agg({rowset_id, 0, 5});
+    EXPECT_EQ(3, bitmap->cardinality());
+    EXPECT_TRUE(delete_bitmap.contains_agg({rowset_id, 1, 6}, 7));
+    EXPECT_FALSE(delete_bitmap.contains_agg({rowset_id, 1, 4}, 7));
+
+    DeleteBitmapPB delete_bitmap_pb;
+    delete_bitmap.to_pb(&delete_bitmap_pb);
+    DeleteBitmap new_delete_bitmap;
+    new_delete_bitmap.init_from_pb(delete_bitmap_pb);
+    EXPECT_EQ(4, new_delete_bitmap.cardinality());
+    EXPECT_TRUE(new_delete_bitmap.contains_agg({rowset_id, 0, 5}, 10));
+
+    new_delete_bitmap.remove_rowset(rowset_id);
+    EXPECT_EQ(0, new_delete_bitmap.cardinality());
+}
+
 } // namespace doris
@@ -0,0 +1,104 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/scan_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "common/config.h"
+
+namespace doris {
+
+static TUniqueId make_query_id(int64_t lo) {
+    TUniqueId query_id;
+    query_id.hi = 100;
+    query_id.lo = lo;
+    return query_id;
+}
+
+TEST(ScanSchedulerTest, share_of_query) {
+    ScanScheduler scheduler(2, 2, 16);
+    auto share = scheduler.get_or_create_share(make_query_id(1), "");
+    EXPECT_EQ(share.get(), scheduler.get_or_create_share(make_query_id(1), "").get());
+    EXPECT_NE(share.get(), scheduler.get_or_create_share(make_query_id(2), "").get());
+
+    // a new query starts from the vruntime of the running queries
+    share->consume(1000L * 1000 * 1000);
+    auto other_share = scheduler.get_or_create_share(make_query_id(3), "");
+    EXPECT_EQ(share->vruntime_ns(), other_share->vruntime_ns());
+
+    // the share is dropped once released by all the scan nodes
+    int64_t vruntime = share->vruntime_ns();
+    share.reset();
+    other_share.reset();
+    share = scheduler.get_or_create_share(make_query_id(1), "");
+    EXPECT_EQ(vruntime, share->vruntime_ns());
+}
+
+TEST(ScanSchedulerTest, group_weight) {
+    std::string old_weights = config::doris_scan_scheduler_group_weights;
+    config::doris_scan_scheduler_group_weights = "normal:10, high : 40,bad,zero:0";
+    ScanScheduler scheduler(1, 1, 16);
+    config::doris_scan_scheduler_group_weights = old_weights;
+
+    EXPECT_EQ(10, scheduler.group_weight("normal"));
+    EXPECT_EQ(40, scheduler.group_weight("high"));
+    EXPECT_EQ(10, scheduler.group_weight("zero"));
+    EXPECT_EQ(10, scheduler.group_weight(""));
+
+    auto normal = scheduler.get_or_create_share(make_query_id(1), "normal");
+    auto high = scheduler.get_or_create_share(make_query_id(2), "high");
+    normal->consume(4000);
+    high->consume(4000);
+    EXPECT_EQ(400, normal->vruntime_ns());
+    EXPECT_EQ(100, high->vruntime_ns());
+}
+
+TEST(ScanSchedulerTest, submit) {
+    ScanScheduler scheduler(4, 2, 16);
+    auto share = scheduler.get_or_create_share(make_query_id(1), "");
+    std::atomic<int> finished {0};
+    const int num_tasks = 10;
+    for (int i = 0; i < num_tasks; ++i) {
+        EXPECT_TRUE(scheduler.submit(
+                share,
+                [&finished]() {
+                    // burn some cpu so that the share is charged
+                    volatile int64_t sum = 0;
+                    for (int j = 0; j < 1000000; ++j) {
+                        sum += j;
+                    }
+                    ++finished;
+                },
+                scheduler.next_queue_id()));
+    }
+    for (int i = 0; i < 1000 && finished < num_tasks; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(num_tasks, finished);
+
+    // wait the threads to finish charging the share
+    scheduler.shutdown();
+    EXPECT_GT(share->vruntime_ns(), 0);
+    EXPECT_FALSE(scheduler.submit(share, []() {}, 0));
+}
+
+} // namespace doris
@@ -25,8 +25,8 @@
 #include "runtime/fragment_mgr.h"
 #include "runtime/initial_reservations.h"
 #include "runtime/result_queue_mgr.h"
+#include "runtime/scan_scheduler.h"
 #include "util/disk_info.h"
-#include "util/priority_thread_pool.hpp"
 
 namespace doris {
 
@@ -39,7 +39,7 @@ TestEnv::TestEnv()
     _exec_env->_task_pool_mem_tracker_registry.reset(new MemTrackerTaskPool());
     _exec_env->_disk_io_mgr = new DiskIoMgr(1, 1, 1, 10);
     _exec_env->disk_io_mgr()->init(-1);
-    _exec_env->_scan_thread_pool = new PriorityThreadPool(1, 16);
+    _exec_env->_scan_scheduler = new ScanScheduler(1, 1, 16);
     _exec_env->_result_queue_mgr = new ResultQueueMgr();
     // TODO may need rpc support, etc.
 }
@@ -61,7 +61,7 @@ void TestEnv::init_buffer_pool(int64_t min_page_len, int64_t capacity, int64_t c
 TestEnv::~TestEnv() {
     SAFE_DELETE(_exec_env->_result_queue_mgr);
     SAFE_DELETE(_exec_env->_buffer_pool);
-    SAFE_DELETE(_exec_env->_scan_thread_pool);
+    SAFE_DELETE(_exec_env->_scan_scheduler);
     SAFE_DELETE(_exec_env->_disk_io_mgr);
     SAFE_DELETE(_exec_env->_buffer_reservation);
     SAFE_DELETE(_exec_env->_thread_mgr);
@@ -0,0 +1,115 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/hash_table/two_level_hash_map.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "vec/common/hash_table/hash.h"
+#include "vec/core/types.h"
+
+namespace doris::vectorized {
+
+using SingleLevelMap = HashMap<UInt64, UInt64, HashCRC32<UInt64>>;
+using TwoLevelMap = TwoLevelHashMap<UInt64, UInt64, HashCRC32<UInt64>>;
+
+TEST(TwoLevelHashTableTest, emplace_and_find) {
+    TwoLevelMap map;
+    const UInt64 num_keys = 100000;
+    for (UInt64 i = 0; i < num_keys; ++i) {
+        TwoLevelMap::LookupResult it;
+        bool inserted;
+        map.emplace(i, it, inserted);
+        EXPECT_TRUE(inserted);
+        *lookup_result_get_mapped(it) = i * 2;
+    }
+    // emplace an existing key
+    TwoLevelMap::LookupResult it;
+    bool inserted;
+    map.emplace(num_keys / 2, it, inserted);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(num_keys, *lookup_result_get_mapped(it));
+
+    EXPECT_EQ(num_keys, map.size());
+    EXPECT_FALSE(map.empty());
+    for (UInt64 i = 0; i < num_keys; ++i) {
+        auto found = map.find(i);
+        ASSERT_NE(nullptr, found);
+        EXPECT_EQ(i * 2, found->get_second());
+    }
+    EXPECT_EQ(nullptr, map.find(num_keys));
+    EXPECT_FALSE(map.has(num_keys + 1));
+
+    // the keys are spread over the buckets
+    size_t non_empty_buckets = 0;
+    for (size_t i = 0; i < TwoLevelMap::NUM_BUCKETS; ++i) {
+        non_empty_buckets += !map.impls[i].empty();
+    }
+    EXPECT_EQ(TwoLevelMap::NUM_BUCKETS, non_empty_buckets);
+
+    // every key is visited once
+    std::set<UInt64> keys;
+    for (auto iter = map.begin(); iter != map.end(); ++iter) {
+        EXPECT_EQ(iter->get_first() * 2, iter->get_second());
+        keys.insert(iter->get_first());
+    }
+    EXPECT_EQ(num_keys, keys.size());
+
+    UInt64 sum = 0;
+    map.for_each_mapped([&](UInt64& mapped) { sum += mapped; });
+    EXPECT_EQ(num_keys * (num_keys - 1), sum);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.begin() == map.end());
+}
+
+TEST(TwoLevelHashTableTest, convert_from_single_level) {
+    SingleLevelMap single_level;
+    const UInt64 num_keys = 5000;
+    // key 0 is kept in the zero value storage of the single level table
+    for (UInt64 i = 0; i < num_keys; ++i) {
+        single_level[i] = i + 1;
+    }
+
+    TwoLevelMap two_level(single_level);
+    EXPECT_EQ(single_level.size(), two_level.size());
+    for (UInt64 i = 0; i < num_keys; ++i) {
+        auto found = two_level.find(i);
+        ASSERT_NE(nullptr, found);
+        EXPECT_EQ(i + 1, found->get_second());
+    }
+
+    size_t visited = 0;
+    for (auto iter = two_level.begin(); iter != two_level.end(); ++iter) {
+        ++visited;
+    }
+    EXPECT_EQ(num_keys, visited);
+}
+
+TEST(TwoLevelHashTableTest, empty_table) {
+    TwoLevelMap map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(0, map.size());
+    EXPECT_TRUE(map.begin() == map.end());
+    EXPECT_FALSE(map.add_elem_size_overflow(1));
+    EXPECT_TRUE(map.add_elem_size_overflow(TwoLevelMap::NUM_BUCKETS * 1024));
+}
+
+} // namespace doris::vectorized
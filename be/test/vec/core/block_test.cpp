@@ -185,7 +185,8 @@ TEST(BlockTest, SerializeAndDeserializeBlock) {
         block_to_pb(block, &pblock);
         std::string s1 = pblock.DebugString();
 
-        vectorized::Block block2(pblock);
+        vectorized::Block block2;
+        EXPECT_TRUE(block2.deserialize(pblock).ok());
         PBlock pblock2;
         block_to_pb(block2, &pblock2);
         std::string s2 = pblock2.DebugString();
@@ -206,7 +207,8 @@ TEST(BlockTest, SerializeAndDeserializeBlock) {
         block_to_pb(block, &pblock);
         std::string s1 = pblock.DebugString();
 
-        vectorized::Block block2(pblock);
+        vectorized::Block block2;
+        EXPECT_TRUE(block2.deserialize(pblock).ok());
         PBlock pblock2;
         block_to_pb(block2, &pblock2);
         std::string s2 = pblock2.DebugString();
@@ -230,7 +232,8 @@ TEST(BlockTest, SerializeAndDeserializeBlock) {
         block_to_pb(block, &pblock);
         std::string s1 = pblock.DebugString();
 
-        vectorized::Block block2(pblock);
+        vectorized::Block block2;
+        EXPECT_TRUE(block2.deserialize(pblock).ok());
         PBlock pblock2;
         block_to_pb(block2, &pblock2);
         std::string s2 = pblock2.DebugString();
@@ -256,7 +259,8 @@ TEST(BlockTest, SerializeAndDeserializeBlock) {
         block_to_pb(block, &pblock);
         std::string s1 = pblock.DebugString();
 
-        vectorized::Block block2(pblock);
+        vectorized::Block block2;
+        EXPECT_TRUE(block2.deserialize(pblock).ok());
         PBlock pblock2;
         block_to_pb(block2, &pblock2);
         std::string s2 = pblock2.DebugString();
@@ -276,7 +280,8 @@ TEST(BlockTest, SerializeAndDeserializeBlock) {
         block_to_pb(block, &pblock);
         std::string s1 = pblock.DebugString();
 
-        vectorized::Block block2(pblock);
+        vectorized::Block block2;
+        EXPECT_TRUE(block2.deserialize(pblock).ok());
         PBlock pblock2;
         block_to_pb(block2, &pblock2);
         std::string s2 = pblock2.DebugString();
@@ -298,7 +303,8 @@ TEST(BlockTest, SerializeAndDeserializeBlock) {
         EXPECT_TRUE(pblock.column_metas()[0].has_decimal_param());
         std::string s1 = pblock.DebugString();
 
-        vectorized::Block block2(pblock);
+        vectorized::Block block2;
+        EXPECT_TRUE(block2.deserialize(pblock).ok());
         PBlock pblock2;
         block_to_pb(block2, &pblock2);
         std::string s2 = pblock2.DebugString();
@@ -320,7 +326,8 @@ TEST(BlockTest, SerializeAndDeserializeBlock) {
         block_to_pb(block, &pblock);
         std::string s1 = pblock.DebugString();
 
-        vectorized::Block block2(pblock);
+        vectorized::Block block2;
+        EXPECT_TRUE(block2.deserialize(pblock).ok());
         PBlock pblock2;
         block_to_pb(block2, &pblock2);
         std::string s2 = pblock2.DebugString();
@@ -328,6 +335,74 @@ TEST(BlockTest, SerializeAndDeserializeBlock) {
     }
 }
 
+TEST(BlockTest, SerializeWithCompressionType) {
+    config::compress_rowbatches = true;
+    auto vec = vectorized::ColumnVector<Int32>::create();
+    auto& data = vec->get_data();
+    for (int i = 0; i < 4096; ++i) {
+        data.push_back(i % 16);
+    }
+    vectorized::DataTypePtr data_type(std::make_shared<vectorized::DataTypeInt32>());
+    vectorized::ColumnWithTypeAndName type_and_name(vec->get_ptr(), data_type, "test_int");
+    vectorized::Block block({type_and_name});
+
+    for (auto type : {segment_v2::CompressionTypePB::SNAPPY, segment_v2::CompressionTypePB::LZ4,
+                      segment_v2::CompressionTypePB::ZSTD,
+                      segment_v2::CompressionTypePB::NO_COMPRESSION}) {
+        PBlock pblock;
+        size_t uncompressed_bytes = 0;
+        size_t compressed_bytes = 0;
+        std::string column_values_buffer;
+        Status st = block.serialize(&pblock, &uncompressed_bytes, &compressed_bytes,
+                                    &column_values_buffer, type);
+        EXPECT_TRUE(st.ok());
+        EXPECT_EQ(compressed_bytes, column_values_buffer.size());
+        pblock.set_column_values(column_values_buffer);
+        if (type == segment_v2::CompressionTypePB::NO_COMPRESSION) {
+            EXPECT_FALSE(pblock.compressed());
+            EXPECT_EQ(uncompressed_bytes, compressed_bytes);
+        } else {
+            EXPECT_TRUE(pblock.compressed());
+            EXPECT_EQ(type, pblock.compression_type());
+            EXPECT_EQ(uncompressed_bytes, pblock.uncompressed_size());
+            EXPECT_LT(compressed_bytes, uncompressed_bytes);
+        }
+
+        vectorized::Block block2;
+        EXPECT_TRUE(block2.deserialize(pblock).ok());
+        EXPECT_EQ(block.dump_data(), block2.dump_data());
+    }
+
+    // blocks from old version carry no uncompressed size and are always compressed by snappy
+    PBlock pblock;
+    block_to_pb(block, &pblock);
+    EXPECT_TRUE(pblock.compressed());
+    pblock.clear_compression_type();
+    pblock.clear_uncompressed_size();
+    vectorized::Block block2;
+    EXPECT_TRUE(block2.deserialize(pblock).ok());
+    EXPECT_EQ(block.dump_data(), block2.dump_data());
+
+    // a block which can not be decompressed is an error
+    {
+        PBlock bad_pblock;
+        size_t uncompressed_bytes = 0;
+        size_t compressed_bytes = 0;
+        std::string column_values_buffer;
+        EXPECT_TRUE(block.serialize(&bad_pblock, &uncompressed_bytes, &compressed_bytes,
+                                    &column_values_buffer, segment_v2::CompressionTypePB::LZ4)
+                            .ok());
+        bad_pblock.set_column_values(column_values_buffer.substr(0, compressed_bytes / 2));
+        vectorized::Block block3;
+        EXPECT_FALSE(block3.deserialize(bad_pblock).ok());
+
+        bad_pblock.set_column_values(column_values_buffer);
+        bad_pblock.set_compression_type(segment_v2::CompressionTypePB::NO_COMPRESSION);
+        EXPECT_FALSE(block3.deserialize(bad_pblock).ok());
+        EXPECT_EQ(0, block3.columns());
+    }
+}
+
 TEST(BlockTest, dump_data) {
     auto vec = vectorized::ColumnVector<Int32>::create();
     auto& int32_data = vec->get_data();
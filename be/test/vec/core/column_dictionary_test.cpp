@@ -0,0 +1,73 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/columns/column_dictionary.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "vec/columns/column_string.h"
+
+namespace doris::vectorized {
+
+static std::vector<StringRef> make_dict(const std::vector<std::string>& words) {
+    std::vector<StringRef> dict;
+    for (const auto& word : words) {
+        dict.emplace_back(word.data(), word.size());
+    }
+    return dict;
+}
+
+TEST(ColumnDictionaryTest, StringInsertManyDictData) {
+    std::vector<std::string> words = {"", "beijing", "shanghai"};
+    auto dict = make_dict(words);
+    int32_t codes[] = {2, 0, 1, 1, 2};
+
+    auto column = ColumnString::create();
+    column->insert_data("first", 5);
+    column->insert_many_dict_data(codes, 1, dict.data(), 4, dict.size());
+
+    ASSERT_EQ(5, column->size());
+    EXPECT_EQ("first", column->get_data_at(0).to_string());
+    EXPECT_EQ("", column->get_data_at(1).to_string());
+    EXPECT_EQ("beijing", column->get_data_at(2).to_string());
+    EXPECT_EQ("beijing", column->get_data_at(3).to_string());
+    EXPECT_EQ("shanghai", column->get_data_at(4).to_string());
+}
+
+TEST(ColumnDictionaryTest, FilterBySelector) {
+    std::vector<std::string> words = {"a", "bb", "ccc"};
+    auto dict = make_dict(words);
+    int32_t codes[] = {0, 1, 2, 1, 0, 2};
+
+    auto dict_column = ColumnDictI32::create();
+    dict_column->reserve(6);
+    dict_column->insert_many_dict_data(codes, 0, dict.data(), 6, dict.size());
+    ASSERT_EQ(6, dict_column->size());
+
+    uint16_t sel[] = {1, 2, 5};
+    auto res = ColumnString::create();
+    EXPECT_TRUE(dict_column->filter_by_selector(sel, 3, res.get()).ok());
+    ASSERT_EQ(3, res->size());
+    EXPECT_EQ("bb", res->get_data_at(0).to_string());
+    EXPECT_EQ("ccc", res->get_data_at(1).to_string());
+    EXPECT_EQ("ccc", res->get_data_at(2).to_string());
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,268 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vaggregation_node.h"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "runtime/descriptors.h"
+#include "testutil/desc_tbl_builder.h"
+#include "vec/data_types/data_type_factory.hpp"
+#include "vec/exec/vexec_node_test_util.h"
+
+namespace doris::vectorized {
+
+// select k, sum(v) from t group by k
+class VAggregationNodeTest : public testing::Test {
+public:
+    VAggregationNodeTest() : _env("./ut_dir/vaggregation_node_test") {}
+
+    void SetUp() override {
+        _spill_threshold_bytes = config::vagg_spill_threshold_bytes;
+        _spill_partition_num = config::vagg_spill_partition_num;
+        _two_level_threshold = config::vagg_two_level_hash_table_threshold;
+        config::vagg_spill_partition_num = 16;
+    }
+
+    void TearDown() override {
+        config::vagg_spill_threshold_bytes = _spill_threshold_bytes;
+        config::vagg_spill_partition_num = _spill_partition_num;
+        config::vagg_two_level_hash_table_threshold = _two_level_threshold;
+    }
+
+    // the tuples of the input (0), the intermediate (1) and the output (2), all (k, v)
+    void init_desc_tbl(const TypeDescriptor& key_type) {
+        _key_type = key_type;
+        DescriptorTblBuilder builder(&_pool);
+        for (int i = 0; i < 3; ++i) {
+            builder.declare_tuple() << key_type << TYPE_BIGINT;
+        }
+        _desc_tbl = builder.build();
+    }
+
+    std::string key_of(int i) const {
+        return _key_type.is_string_type() ? "key_" + std::to_string(i) : std::to_string(i);
+    }
+
+    // The rows (i % num_keys, i) of i in [0, num_rows), every 11th key is null. The expected
+    // sums are added to _expected.
+    std::vector<Block> create_blocks(int num_rows, int num_keys, int block_rows = 1024) {
+        auto key_data_type = DataTypeFactory::instance().create_data_type(_key_type, true);
+        auto value_data_type =
+                DataTypeFactory::instance().create_data_type(TypeDescriptor(TYPE_BIGINT), true);
+        std::vector<Block> blocks;
+        for (int start = 0; start < num_rows; start += block_rows) {
+            auto key_column = key_data_type->create_column();
+            auto value_column = value_data_type->create_column();
+            for (int i = start; i < std::min(num_rows, start + block_rows); ++i) {
+                int64_t value = i;
+                value_column->insert_data((const char*)&value, sizeof(value));
+                if (i % 11 == 0) {
+                    key_column->insert_data(nullptr, 0);
+                    _expected["\\N"] += value;
+                    continue;
+                }
+                int32_t key = i % num_keys;
+                std::string key_str = key_of(key);
+                if (_key_type.is_string_type()) {
+                    key_column->insert_data(key_str.data(), key_str.size());
+                } else {
+                    key_column->insert_data((const char*)&key, sizeof(key));
+                }
+                _expected[key_str] += value;
+            }
+            blocks.emplace_back(Block({{std::move(key_column), key_data_type, "k"},
+                                       {std::move(value_column), value_data_type, "v"}}));
+        }
+        return blocks;
+    }
+
+    TExpr create_sum_expr(const SlotDescriptor* slot) {
+        TFunctionName fn_name;
+        fn_name.__set_function_name("sum");
+        TAggregateFunction aggregate_fn;
+        aggregate_fn.__set_intermediate_type(TypeDescriptor(TYPE_BIGINT).to_thrift());
+        TFunction fn;
+        fn.__set_name(fn_name);
+        fn.__set_binary_type(TFunctionBinaryType::BUILTIN);
+        fn.__set_arg_types({slot->type().to_thrift()});
+        fn.__set_ret_type(TypeDescriptor(TYPE_BIGINT).to_thrift());
+        fn.__set_has_var_args(false);
+        fn.__set_aggregate_fn(aggregate_fn);
+
+        TAggregateExpr agg_expr;
+        agg_expr.__set_is_merge_agg(false);
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::AGG_EXPR);
+        node.__set_type(TypeDescriptor(TYPE_BIGINT).to_thrift());
+        node.__set_num_children(1);
+        node.__set_output_scale(-1);
+        node.__set_is_nullable(true);
+        node.__set_agg_expr(agg_expr);
+        node.__set_fn(fn);
+
+        TExpr expr = create_slot_ref(slot);
+        expr.nodes.insert(expr.nodes.begin(), node);
+        return expr;
+    }
+
+    // Aggregate the blocks and return the sum of every key. 'after_open' is called once the
+    // input is consumed.
+    std::map<std::string, int64_t> run(
+            std::vector<Block> blocks, bool enable_spill,
+            const std::function<void(AggregationNode*, RuntimeState*)>& after_open = nullptr) {
+        ObjectPool pool;
+        auto state = _env.create_runtime_state(_desc_tbl, enable_spill);
+        const auto& input_slots = _desc_tbl->get_tuple_descriptor(0)->slots();
+        auto child =
+                create_source_node(&pool, state.get(), *_desc_tbl, 1, 0, std::move(blocks));
+
+        TAggregationNode agg_node;
+        agg_node.__set_grouping_exprs({create_slot_ref(input_slots[0])});
+        agg_node.__set_aggregate_functions({create_sum_expr(input_slots[1])});
+        agg_node.__set_intermediate_tuple_id(1);
+        agg_node.__set_output_tuple_id(2);
+        agg_node.__set_need_finalize(true);
+        TPlanNode tnode = create_plan_node(TPlanNodeType::AGGREGATION_NODE, 0, {2});
+        tnode.__set_num_children(1);
+        tnode.__set_agg_node(agg_node);
+
+        std::map<std::string, int64_t> result;
+        auto node = pool.add(new AggregationNode(&pool, tnode, *_desc_tbl));
+        node->_children.push_back(child);
+        EXPECT_TRUE(node->init(tnode, state.get()).ok());
+        EXPECT_TRUE(node->prepare(state.get()).ok());
+        EXPECT_TRUE(node->open(state.get()).ok());
+        if (after_open) {
+            after_open(node, state.get());
+        }
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            auto st = node->get_next(state.get(), &block, &eos);
+            EXPECT_TRUE(st.ok()) << st.to_string();
+            if (!st.ok()) {
+                break;
+            }
+            for (size_t i = 0; i < block.rows(); ++i) {
+                const auto& key = block.get_by_position(0);
+                const auto& value = block.get_by_position(1);
+                auto key_str = key.type->to_string(*key.column, i);
+                // every key is returned once
+                EXPECT_EQ(0, result.count(key_str)) << key_str;
+                result[key_str] = std::stoll(value.type->to_string(*value.column, i));
+            }
+        }
+        // the spilled partitions are removed once they are merged
+        EXPECT_EQ(0, _env.num_spill_files());
+        _spill_partitions = node->_spill_partitions_counter->value();
+        _spill_max_level = node->_spill_max_level_counter->value();
+        EXPECT_TRUE(node->close(state.get()).ok());
+        return result;
+    }
+
+protected:
+    VExecNodeTestEnv _env;
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    TypeDescriptor _key_type;
+    std::map<std::string, int64_t> _expected;
+    int64_t _spill_partitions = 0;
+    int64_t _spill_max_level = 0;
+
+private:
+    int64_t _spill_threshold_bytes;
+    int32_t _spill_partition_num;
+    int64_t _two_level_threshold;
+};
+
+TEST_F(VAggregationNodeTest, spill_int_key) {
+    init_desc_tbl(TypeDescriptor(TYPE_INT));
+    config::vagg_spill_threshold_bytes = 64 * 1024;
+    auto result = run(create_blocks(200000, 50000), true);
+    EXPECT_EQ(_expected.size(), result.size());
+    EXPECT_EQ(_expected, result);
+    EXPECT_GT(_spill_partitions, 0);
+    // the partitions which are still too large are spilled again
+    EXPECT_GT(_spill_max_level, 0);
+
+    // the same as without spilling
+    _expected.clear();
+    EXPECT_EQ(result, run(create_blocks(200000, 50000), false));
+}
+
+TEST_F(VAggregationNodeTest, spill_string_key) {
+    init_desc_tbl(TypeDescriptor::create_string_type());
+    config::vagg_spill_threshold_bytes = 256 * 1024;
+    auto result = run(create_blocks(100000, 30000), true);
+    EXPECT_EQ(_expected, result);
+    EXPECT_GT(_spill_partitions, 0);
+}
+
+TEST_F(VAggregationNodeTest, spill_two_level_hash_table) {
+    init_desc_tbl(TypeDescriptor(TYPE_INT));
+    config::vagg_spill_threshold_bytes = 256 * 1024;
+    config::vagg_two_level_hash_table_threshold = 1000;
+    auto result = run(create_blocks(200000, 50000), true);
+    EXPECT_EQ(_expected, result);
+    EXPECT_GT(_spill_partitions, 0);
+}
+
+TEST_F(VAggregationNodeTest, spill_part_of_partitions) {
+    init_desc_tbl(TypeDescriptor(TYPE_INT));
+    auto num_groups = [](AggregationNode* node) {
+        return std::visit([](auto&& agg_method) { return agg_method.data.size(); },
+                          node->_agg_data._aggregated_method_variant);
+    };
+    auto result = run(create_blocks(100000, 20000), true, [&](AggregationNode* node,
+                                                              RuntimeState* state) {
+        ASSERT_FALSE(node->_is_spilled);
+        size_t total_groups = num_groups(node);
+
+        // half of the partitions are spilled, the groups of the others stay in memory
+        ASSERT_TRUE(node->_spill_hash_table(state, 0, true).ok());
+        EXPECT_EQ(8, node->_spilled_partition_num);
+        EXPECT_EQ(8, _env.num_spill_files());
+        size_t kept_groups = num_groups(node);
+        EXPECT_GT(kept_groups, total_groups / 4);
+        EXPECT_LT(kept_groups, total_groups * 3 / 4);
+
+        // then half of the rest
+        ASSERT_TRUE(node->_spill_hash_table(state, 0, true).ok());
+        EXPECT_EQ(12, node->_spilled_partition_num);
+        EXPECT_EQ(12, _env.num_spill_files());
+        EXPECT_LT(num_groups(node), kept_groups);
+
+        // the same as the end of open()
+        ASSERT_TRUE(node->_spill_hash_table(state, 0, false).ok());
+        ASSERT_TRUE(node->_finish_spill().ok());
+        EXPECT_EQ(12, node->_pending_spill_partitions.size());
+        node->_is_spilled = true;
+        node->_spill_partition_merged = true;
+    });
+    EXPECT_EQ(_expected, result);
+    EXPECT_EQ(12, _spill_partitions);
+}
+
+} // namespace doris::vectorized
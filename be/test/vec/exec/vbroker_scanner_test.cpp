@@ -430,6 +430,131 @@ TEST_F(VBrokerScannerTest, normal2) {
     ASSERT_EQ(columns[2]->get_int(1), 5);
 }
 
+TEST_F(VBrokerScannerTest, long_line) {
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.path = "./be/test/exec/test_data/broker_scanner/long_line.csv";
+    range.start_offset = 0;
+    range.size = -1;
+    range.splittable = true;
+    range.file_type = TFileType::FILE_LOCAL;
+    range.format_type = TFileFormatType::FORMAT_CSV_PLAIN;
+    ranges.push_back(range);
+
+    VBrokerScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, _pre_filter,
+                           &_counter);
+    auto st = scanner.open();
+    ASSERT_TRUE(st.ok());
+
+    int slot_count = 3;
+    auto tuple_desc = _desc_tbl->get_tuple_descriptor(_dst_tuple_id);
+    std::vector<vectorized::MutableColumnPtr> columns(slot_count);
+    for (int i = 0; i < slot_count; i++) {
+        columns[i] = tuple_desc->slots()[i]->get_empty_mutable_column();
+    }
+    bool eof = false;
+    st = scanner.get_next(columns, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_TRUE(eof);
+
+    // the last line has more columns than the schema
+    ASSERT_EQ(columns[0]->size(), 2);
+    ASSERT_EQ(_counter.num_rows_filtered, 1);
+
+    ASSERT_EQ(columns[0]->get_int(0), 1);
+    ASSERT_EQ(columns[0]->get_int(1), 4);
+
+    ASSERT_EQ(columns[1]->get_int(0), 2);
+    ASSERT_EQ(columns[1]->get_int(1), 5);
+
+    ASSERT_EQ(columns[2]->get_int(0), 3);
+    ASSERT_EQ(columns[2]->get_int(1), 6);
+}
+
+// Without an enclose char, a quoted separator splits the value and the quotes are kept, so
+// the quoted values fail the int casts.
+TEST_F(VBrokerScannerTest, quoted_field) {
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.path = "./be/test/exec/test_data/broker_scanner/quoted.csv";
+    range.start_offset = 0;
+    range.size = -1;
+    range.splittable = true;
+    range.file_type = TFileType::FILE_LOCAL;
+    range.format_type = TFileFormatType::FORMAT_CSV_PLAIN;
+    ranges.push_back(range);
+
+    VBrokerScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, _pre_filter,
+                           &_counter);
+    auto st = scanner.open();
+    ASSERT_TRUE(st.ok());
+
+    int slot_count = 3;
+    auto tuple_desc = _desc_tbl->get_tuple_descriptor(_dst_tuple_id);
+    std::vector<vectorized::MutableColumnPtr> columns(slot_count);
+    for (int i = 0; i < slot_count; i++) {
+        columns[i] = tuple_desc->slots()[i]->get_empty_mutable_column();
+    }
+    bool eof = false;
+    st = scanner.get_next(columns, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_TRUE(eof);
+
+    // "4,5",6 and "7",8,9 are filtered by the casts, "10,11",12,13 has 4 columns
+    ASSERT_EQ(columns[0]->size(), 1);
+    ASSERT_EQ(_counter.num_rows_filtered, 3);
+
+    ASSERT_EQ(columns[0]->get_int(0), 1);
+    ASSERT_EQ(columns[1]->get_int(0), 2);
+    ASSERT_EQ(columns[2]->get_int(0), 3);
+}
+
+TEST_F(VBrokerScannerTest, enclosed_field) {
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.path = "./be/test/exec/test_data/broker_scanner/enclosed.csv";
+    range.start_offset = 0;
+    range.size = -1;
+    range.splittable = true;
+    range.file_type = TFileType::FILE_LOCAL;
+    range.format_type = TFileFormatType::FORMAT_CSV_PLAIN;
+    ranges.push_back(range);
+
+    _params.__set_enclose('"');
+    VBrokerScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, _pre_filter,
+                           &_counter);
+    auto st = scanner.open();
+    ASSERT_TRUE(st.ok());
+
+    int slot_count = 3;
+    auto tuple_desc = _desc_tbl->get_tuple_descriptor(_dst_tuple_id);
+    std::vector<vectorized::MutableColumnPtr> columns(slot_count);
+    for (int i = 0; i < slot_count; i++) {
+        columns[i] = tuple_desc->slots()[i]->get_empty_mutable_column();
+    }
+    bool eof = false;
+    st = scanner.get_next(columns, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_TRUE(eof);
+
+    // "4,5",6 has 2 columns, "10,11" is not an int, and the line delimiter in "2\n0" does
+    // not end the line, so the value is not an int either
+    ASSERT_EQ(columns[0]->size(), 3);
+    ASSERT_EQ(_counter.num_rows_filtered, 3);
+
+    ASSERT_EQ(columns[0]->get_int(0), 1);
+    ASSERT_EQ(columns[0]->get_int(1), 7);
+    ASSERT_EQ(columns[0]->get_int(2), 26);
+
+    ASSERT_EQ(columns[1]->get_int(0), 2);
+    ASSERT_EQ(columns[1]->get_int(1), 8);
+    ASSERT_EQ(columns[1]->get_int(2), 27);
+
+    ASSERT_EQ(columns[2]->get_int(0), 3);
+    ASSERT_EQ(columns[2]->get_int(1), 9);
+    ASSERT_EQ(columns[2]->get_int(2), 28);
+}
+
 TEST_F(VBrokerScannerTest, normal5) {
     std::vector<TBrokerRangeDesc> ranges;
     TBrokerRangeDesc range;
@@ -0,0 +1,115 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vexec_node_test_util.h"
+
+#include <gtest/gtest.h>
+
+#include "common/object_pool.h"
+#include "env/env.h"
+#include "runtime/descriptors.h"
+#include "util/disk_info.h"
+#include "util/file_utils.h"
+
+namespace doris::vectorized {
+
+Status MockSourceNode::get_next(RuntimeState* state, Block* block, bool* eos) {
+    if (_next_block < _blocks.size()) {
+        block->swap(_blocks[_next_block++]);
+    }
+    *eos = _next_block == _blocks.size();
+    return Status::OK();
+}
+
+VExecNodeTestEnv::VExecNodeTestEnv(const std::string& spill_dir) : _spill_dir(spill_dir) {
+    if (FileUtils::check_exist(_spill_dir)) {
+        EXPECT_TRUE(FileUtils::remove_all(_spill_dir).ok());
+    }
+    EXPECT_TRUE(FileUtils::create_dir(_spill_dir).ok());
+    // will use DiskInfo::num_disks(), DiskInfo should be initialized before
+    DiskInfo::init();
+    EXPECT_TRUE(_tmp_file_mgr.init_custom({_spill_dir}, false).ok());
+    _exec_env._tmp_file_mgr = &_tmp_file_mgr;
+}
+
+VExecNodeTestEnv::~VExecNodeTestEnv() {
+    if (FileUtils::check_exist(_spill_dir)) {
+        EXPECT_TRUE(FileUtils::remove_all(_spill_dir).ok());
+    }
+}
+
+std::unique_ptr<RuntimeState> VExecNodeTestEnv::create_runtime_state(DescriptorTbl* desc_tbl,
+                                                                     bool enable_spill,
+                                                                     int batch_size) {
+    TQueryOptions query_options;
+    query_options.__set_batch_size(batch_size);
+    query_options.__set_enable_spilling(enable_spill);
+    query_options.__set_enable_vectorized_engine(true);
+    auto state = std::make_unique<RuntimeState>(TUniqueId(), query_options, TQueryGlobals(),
+                                                &_exec_env);
+    EXPECT_TRUE(state->init_instance_mem_tracker().ok());
+    state->set_desc_tbl(desc_tbl);
+    return state;
+}
+
+int VExecNodeTestEnv::num_spill_files() const {
+    std::vector<std::string> files;
+    EXPECT_TRUE(
+            FileUtils::list_files(Env::Default(), _tmp_file_mgr.get_tmp_dir_path(0), &files).ok());
+    return files.size();
+}
+
+TPlanNode create_plan_node(TPlanNodeType::type node_type, int node_id,
+                           const std::vector<TTupleId>& tuple_ids) {
+    TPlanNode tnode;
+    tnode.__set_node_id(node_id);
+    tnode.__set_node_type(node_type);
+    tnode.__set_num_children(0);
+    tnode.__set_limit(-1);
+    tnode.__set_row_tuples(tuple_ids);
+    tnode.__set_nullable_tuples(std::vector<bool>(tuple_ids.size(), false));
+    tnode.__set_compact_data(false);
+    return tnode;
+}
+
+MockSourceNode* create_source_node(ObjectPool* pool, RuntimeState* state,
+                                   const DescriptorTbl& descs, int node_id, TTupleId tuple_id,
+                                   std::vector<Block> blocks) {
+    auto tnode = create_plan_node(TPlanNodeType::EXCHANGE_NODE, node_id, {tuple_id});
+    auto node = pool->add(new MockSourceNode(pool, tnode, descs, std::move(blocks)));
+    EXPECT_TRUE(node->init(tnode, state).ok());
+    return node;
+}
+
+TExpr create_slot_ref(const SlotDescriptor* slot) {
+    TExprNode node;
+    node.__set_node_type(TExprNodeType::SLOT_REF);
+    node.__set_type(slot->type().to_thrift());
+    node.__set_num_children(0);
+    node.__set_output_scale(-1);
+    node.__set_is_nullable(slot->is_nullable());
+    TSlotRef slot_ref;
+    slot_ref.__set_slot_id(slot->id());
+    slot_ref.__set_tuple_id(slot->parent());
+    node.__set_slot_ref(slot_ref);
+
+    TExpr expr;
+    expr.nodes.push_back(node);
+    return expr;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "exec/exec_node.h"
+#include "gen_cpp/Exprs_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "runtime/tmp_file_mgr.h"
+#include "vec/core/block.h"
+
+namespace doris::vectorized {
+
+// A node returning the given blocks, used as the child of the node under test.
+class MockSourceNode : public ExecNode {
+public:
+    MockSourceNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs,
+                   std::vector<Block> blocks)
+            : ExecNode(pool, tnode, descs), _blocks(std::move(blocks)) {}
+
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("Not Implemented MockSourceNode::get_next scalar");
+    }
+
+    Status get_next(RuntimeState* state, Block* block, bool* eos) override;
+
+private:
+    std::vector<Block> _blocks;
+    size_t _next_block = 0;
+};
+
+// The runtime of a vectorized exec node test, with the tmp dir the node spills to.
+class VExecNodeTestEnv {
+public:
+    explicit VExecNodeTestEnv(const std::string& spill_dir);
+    ~VExecNodeTestEnv();
+
+    // A query with spilling enabled or not, using the descriptors of 'desc_tbl'.
+    std::unique_ptr<RuntimeState> create_runtime_state(DescriptorTbl* desc_tbl, bool enable_spill,
+                                                       int batch_size = 1024);
+
+    // The number of spill files left in the spill dir.
+    int num_spill_files() const;
+
+private:
+    std::string _spill_dir;
+    ExecEnv _exec_env;
+    TmpFileMgr _tmp_file_mgr;
+};
+
+TPlanNode create_plan_node(TPlanNodeType::type node_type, int node_id,
+                           const std::vector<TTupleId>& tuple_ids);
+
+// Create a source node returning 'blocks', whose rows are the tuple 'tuple_id'.
+MockSourceNode* create_source_node(ObjectPool* pool, RuntimeState* state,
+                                   const DescriptorTbl& descs, int node_id, TTupleId tuple_id,
+                                   std::vector<Block> blocks);
+
+TExpr create_slot_ref(const SlotDescriptor* slot);
+
+} // namespace doris::vectorized
@@ -0,0 +1,260 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/join/vhash_join_node.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "runtime/descriptors.h"
+#include "testutil/desc_tbl_builder.h"
+#include "vec/data_types/data_type_factory.hpp"
+#include "vec/exec/vexec_node_test_util.h"
+
+namespace doris::vectorized {
+
+// select * from probe join build on probe.k = build.k, the rows of both sides are (k, v)
+class VHashJoinNodeTest : public testing::Test {
+public:
+    VHashJoinNodeTest() : _env("./ut_dir/vhash_join_node_test") {}
+
+    struct Row {
+        std::optional<int32_t> key;
+        int64_t value;
+    };
+
+    void SetUp() override {
+        _spill_threshold_bytes = config::vhash_join_spill_threshold_bytes;
+        _spill_partition_num = config::vhash_join_spill_partition_num;
+        _spill_max_depth = config::vhash_join_spill_max_depth;
+        config::vhash_join_spill_partition_num = 16;
+        config::vhash_join_spill_max_depth = 3;
+
+        // the probe (0) and the build (1) tuples
+        DescriptorTblBuilder builder(&_pool);
+        builder.declare_tuple() << TYPE_INT << TYPE_BIGINT;
+        builder.declare_tuple() << TYPE_INT << TYPE_BIGINT;
+        _desc_tbl = builder.build();
+
+        // keys [0, 10000) on the build side, [0, 15000) on the probe side, a few of both are
+        // null
+        for (int i = 0; i < 30000; ++i) {
+            _build_rows.push_back({i % 1000 == 0 ? std::nullopt : std::optional(i % 10000), i});
+        }
+        for (int i = 0; i < 20000; ++i) {
+            _probe_rows.push_back(
+                    {i % 1000 == 1 ? std::nullopt : std::optional(i * 7 % 15000), i});
+        }
+    }
+
+    void TearDown() override {
+        config::vhash_join_spill_threshold_bytes = _spill_threshold_bytes;
+        config::vhash_join_spill_partition_num = _spill_partition_num;
+        config::vhash_join_spill_max_depth = _spill_max_depth;
+    }
+
+    static std::vector<Block> create_blocks(const std::vector<Row>& rows) {
+        auto key_type = DataTypeFactory::instance().create_data_type(TypeDescriptor(TYPE_INT));
+        auto value_type =
+                DataTypeFactory::instance().create_data_type(TypeDescriptor(TYPE_BIGINT));
+        std::vector<Block> blocks;
+        for (size_t start = 0; start < rows.size(); start += 1024) {
+            auto key_column = key_type->create_column();
+            auto value_column = value_type->create_column();
+            for (size_t i = start; i < std::min(rows.size(), start + 1024); ++i) {
+                if (rows[i].key.has_value()) {
+                    key_column->insert_data((const char*)&*rows[i].key, sizeof(int32_t));
+                } else {
+                    key_column->insert_data(nullptr, 0);
+                }
+                value_column->insert_data((const char*)&rows[i].value, sizeof(int64_t));
+            }
+            blocks.emplace_back(Block({{std::move(key_column), key_type, "k"},
+                                       {std::move(value_column), value_type, "v"}}));
+        }
+        return blocks;
+    }
+
+    static std::string to_string(const std::optional<Row>& row) {
+        if (!row.has_value()) {
+            return "\\N|\\N";
+        }
+        return (row->key.has_value() ? std::to_string(*row->key) : "\\N") + "|" +
+               std::to_string(row->value);
+    }
+
+    // The joined rows, computed without the node.
+    std::vector<std::string> expected_rows(TJoinOp::type join_op, bool null_safe) const {
+        auto key_of = [](const Row& row) {
+            return row.key.has_value() ? std::to_string(*row.key) : "null";
+        };
+        std::unordered_map<std::string, std::vector<size_t>> build_index;
+        for (size_t i = 0; i < _build_rows.size(); ++i) {
+            if (_build_rows[i].key.has_value() || null_safe) {
+                build_index[key_of(_build_rows[i])].push_back(i);
+            }
+        }
+
+        std::vector<std::string> rows;
+        std::vector<bool> build_matched(_build_rows.size(), false);
+        for (const auto& probe_row : _probe_rows) {
+            auto it = build_index.end();
+            if (probe_row.key.has_value() || null_safe) {
+                it = build_index.find(key_of(probe_row));
+            }
+            if (it != build_index.end()) {
+                for (auto i : it->second) {
+                    rows.push_back(to_string(probe_row) + "|" + to_string(_build_rows[i]));
+                    build_matched[i] = true;
+                }
+            } else if (join_op == TJoinOp::LEFT_OUTER_JOIN ||
+                       join_op == TJoinOp::FULL_OUTER_JOIN) {
+                rows.push_back(to_string(probe_row) + "|" + to_string(std::nullopt));
+            }
+        }
+        if (join_op == TJoinOp::FULL_OUTER_JOIN) {
+            for (size_t i = 0; i < _build_rows.size(); ++i) {
+                if (!build_matched[i]) {
+                    rows.push_back(to_string(std::nullopt) + "|" + to_string(_build_rows[i]));
+                }
+            }
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    std::vector<std::string> run(TJoinOp::type join_op, bool null_safe, bool enable_spill) {
+        ObjectPool pool;
+        auto state = _env.create_runtime_state(_desc_tbl, enable_spill);
+        auto probe_child = create_source_node(&pool, state.get(), *_desc_tbl, 1, 0,
+                                              create_blocks(_probe_rows));
+        auto build_child = create_source_node(&pool, state.get(), *_desc_tbl, 2, 1,
+                                              create_blocks(_build_rows));
+
+        TEqJoinCondition eq_condition;
+        eq_condition.__set_left(
+                create_slot_ref(_desc_tbl->get_tuple_descriptor(0)->slots()[0]));
+        eq_condition.__set_right(
+                create_slot_ref(_desc_tbl->get_tuple_descriptor(1)->slots()[0]));
+        if (null_safe) {
+            eq_condition.__set_opcode(TExprOpcode::EQ_FOR_NULL);
+        }
+        THashJoinNode join_node;
+        join_node.__set_join_op(join_op);
+        join_node.__set_eq_join_conjuncts({eq_condition});
+        TPlanNode tnode = create_plan_node(TPlanNodeType::HASH_JOIN_NODE, 0, {0, 1});
+        tnode.__set_num_children(2);
+        tnode.__set_nullable_tuples({join_op == TJoinOp::FULL_OUTER_JOIN,
+                                     join_op == TJoinOp::LEFT_OUTER_JOIN ||
+                                             join_op == TJoinOp::FULL_OUTER_JOIN});
+        tnode.__set_hash_join_node(join_node);
+
+        std::vector<std::string> rows;
+        auto node = pool.add(new HashJoinNode(&pool, tnode, *_desc_tbl));
+        node->_children.push_back(probe_child);
+        node->_children.push_back(build_child);
+        EXPECT_TRUE(node->init(tnode, state.get()).ok());
+        EXPECT_TRUE(node->prepare(state.get()).ok());
+        EXPECT_TRUE(node->open(state.get()).ok());
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            auto st = node->get_next(state.get(), &block, &eos);
+            EXPECT_TRUE(st.ok()) << st.to_string();
+            if (!st.ok()) {
+                break;
+            }
+            EXPECT_EQ(4, block.columns());
+            for (size_t i = 0; i < block.rows(); ++i) {
+                std::string row;
+                for (size_t j = 0; j < block.columns(); ++j) {
+                    const auto& column = block.get_by_position(j);
+                    row += (j == 0 ? "" : "|") + column.type->to_string(*column.column, i);
+                }
+                rows.push_back(row);
+            }
+        }
+        _spill_partitions = node->_spill_partitions_counter->value();
+        _spill_max_level = node->_spill_max_level_counter->value();
+        EXPECT_TRUE(node->close(state.get()).ok());
+        // the spilled partitions are removed
+        EXPECT_EQ(0, _env.num_spill_files());
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    void check_spill(TJoinOp::type join_op, bool null_safe) {
+        config::vhash_join_spill_threshold_bytes = 16 * 1024;
+        auto rows = run(join_op, null_safe, true);
+        EXPECT_GT(_spill_partitions, 0);
+        // the partitions which are still too large are partitioned again
+        EXPECT_GT(_spill_max_level, 0);
+        auto expected = expected_rows(join_op, null_safe);
+        EXPECT_EQ(expected.size(), rows.size());
+        EXPECT_TRUE(expected == rows);
+
+        // the same as without spilling
+        config::vhash_join_spill_threshold_bytes = _spill_threshold_bytes;
+        EXPECT_TRUE(rows == run(join_op, null_safe, false));
+        EXPECT_EQ(0, _spill_partitions);
+    }
+
+protected:
+    VExecNodeTestEnv _env;
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::vector<Row> _build_rows;
+    std::vector<Row> _probe_rows;
+    int64_t _spill_partitions = 0;
+    int64_t _spill_max_level = 0;
+
+private:
+    int64_t _spill_threshold_bytes;
+    int32_t _spill_partition_num;
+    int32_t _spill_max_depth;
+};
+
+TEST_F(VHashJoinNodeTest, spill_inner_join) {
+    check_spill(TJoinOp::INNER_JOIN, false);
+}
+
+// the null keys match each other
+TEST_F(VHashJoinNodeTest, spill_null_safe_inner_join) {
+    check_spill(TJoinOp::INNER_JOIN, true);
+}
+
+// the probe rows with a null key are returned without a match
+TEST_F(VHashJoinNodeTest, spill_left_outer_join) {
+    check_spill(TJoinOp::LEFT_OUTER_JOIN, false);
+}
+
+TEST_F(VHashJoinNodeTest, spill_full_outer_join) {
+    check_spill(TJoinOp::FULL_OUTER_JOIN, false);
+}
+
+TEST_F(VHashJoinNodeTest, spill_null_safe_full_outer_join) {
+    check_spill(TJoinOp::FULL_OUTER_JOIN, true);
+}
+
+} // namespace doris::vectorized
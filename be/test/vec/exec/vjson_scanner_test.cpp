@@ -0,0 +1,250 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vjson_scanner.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "exprs/cast_functions.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "runtime/user_function_cache.h"
+
+namespace doris {
+
+namespace vectorized {
+
+#define TUPLE_ID_DST 0
+#define TUPLE_ID_SRC 1
+#define COLUMN_NUMBERS 6
+#define DST_TUPLE_SLOT_ID_START 1
+#define SRC_TUPLE_SLOT_ID_START 7
+
+static const char* column_names[] = {"category", "author",   "title",
+                                     "price",    "largeint", "decimal"};
+
+class VJsonScannerTest : public testing::Test {
+public:
+    VJsonScannerTest() : _runtime_state(TQueryGlobals()) {
+        init_desc_table();
+        init_params();
+        _profile = _runtime_state.runtime_profile();
+        _runtime_state._instance_mem_tracker.reset(new MemTracker());
+        _runtime_state._exec_env = ExecEnv::GetInstance();
+    }
+
+    static void SetUpTestCase() {
+        UserFunctionCache::instance()->init(
+                "./be/test/runtime/test_data/user_function_cache/normal");
+        CastFunctions::init();
+    }
+
+protected:
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+
+    void create_tuple(TDescriptorTable& t_desc_table, TupleId tuple_id, int first_slot_id);
+    void init_desc_table();
+    void init_params();
+    // scan the ranges and return the values of the dest slots by rows
+    std::vector<std::vector<std::string>> scan(const std::vector<TBrokerRangeDesc>& ranges);
+
+    RuntimeState _runtime_state;
+    RuntimeProfile* _profile;
+    ObjectPool _obj_pool;
+    TBrokerScanRangeParams _params;
+    DescriptorTbl* _desc_tbl;
+    std::vector<TNetworkAddress> _addresses;
+    ScannerCounter _counter;
+    std::vector<TExpr> _pre_filter;
+};
+
+static TTypeDesc create_varchar_type() {
+    TTypeDesc type_desc;
+    TTypeNode node;
+    node.__set_type(TTypeNodeType::SCALAR);
+    TScalarType scalar_type;
+    scalar_type.__set_type(TPrimitiveType::VARCHAR);
+    scalar_type.__set_len(65535);
+    node.__set_scalar_type(scalar_type);
+    type_desc.types.push_back(node);
+    return type_desc;
+}
+
+void VJsonScannerTest::create_tuple(TDescriptorTable& t_desc_table, TupleId tuple_id,
+                                    int first_slot_id) {
+    int byte_offset = 8;
+    for (int i = 0; i < COLUMN_NUMBERS; i++) {
+        TSlotDescriptor slot_desc;
+        slot_desc.id = first_slot_id + i;
+        slot_desc.parent = tuple_id;
+        slot_desc.slotType = create_varchar_type();
+        slot_desc.columnPos = i;
+        slot_desc.byteOffset = byte_offset;
+        slot_desc.nullIndicatorByte = i / 8;
+        slot_desc.nullIndicatorBit = i % 8;
+        slot_desc.colName = column_names[i];
+        slot_desc.slotIdx = i + 1;
+        slot_desc.isMaterialized = true;
+        t_desc_table.slotDescriptors.push_back(slot_desc);
+        byte_offset += 16;
+    }
+
+    TTupleDescriptor t_tuple_desc;
+    t_tuple_desc.id = tuple_id;
+    t_tuple_desc.byteSize = byte_offset;
+    t_tuple_desc.numNullBytes = 1;
+    t_tuple_desc.tableId = 0;
+    t_tuple_desc.__isset.tableId = true;
+    t_desc_table.tupleDescriptors.push_back(t_tuple_desc);
+}
+
+void VJsonScannerTest::init_desc_table() {
+    TDescriptorTable t_desc_table;
+
+    TTableDescriptor t_table_desc;
+    t_table_desc.id = 0;
+    t_table_desc.tableType = TTableType::BROKER_TABLE;
+    t_table_desc.numCols = 0;
+    t_table_desc.numClusteringCols = 0;
+    t_desc_table.tableDescriptors.push_back(t_table_desc);
+    t_desc_table.__isset.tableDescriptors = true;
+
+    create_tuple(t_desc_table, TUPLE_ID_DST, DST_TUPLE_SLOT_ID_START);
+    create_tuple(t_desc_table, TUPLE_ID_SRC, SRC_TUPLE_SLOT_ID_START);
+    t_desc_table.__isset.slotDescriptors = true;
+
+    DescriptorTbl::create(&_obj_pool, t_desc_table, &_desc_tbl);
+    _runtime_state.set_desc_tbl(_desc_tbl);
+}
+
+void VJsonScannerTest::init_params() {
+    for (int i = 0; i < COLUMN_NUMBERS; i++) {
+        TExprNode slot_ref;
+        slot_ref.node_type = TExprNodeType::SLOT_REF;
+        slot_ref.type = create_varchar_type();
+        slot_ref.num_children = 0;
+        slot_ref.__isset.slot_ref = true;
+        slot_ref.slot_ref.slot_id = SRC_TUPLE_SLOT_ID_START + i;
+        slot_ref.slot_ref.tuple_id = TUPLE_ID_SRC;
+
+        TExpr expr;
+        expr.nodes.push_back(slot_ref);
+        _params.expr_of_dest_slot.emplace(DST_TUPLE_SLOT_ID_START + i, expr);
+        _params.src_slot_ids.push_back(SRC_TUPLE_SLOT_ID_START + i);
+    }
+    _params.__set_dest_tuple_id(TUPLE_ID_DST);
+    _params.__set_src_tuple_id(TUPLE_ID_SRC);
+}
+
+std::vector<std::vector<std::string>> VJsonScannerTest::scan(
+        const std::vector<TBrokerRangeDesc>& ranges) {
+    VJsonScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, _pre_filter,
+                         &_counter);
+    EXPECT_TRUE(scanner.open().ok());
+
+    auto tuple_desc = _desc_tbl->get_tuple_descriptor(TUPLE_ID_DST);
+    std::vector<std::vector<std::string>> rows;
+    bool eof = false;
+    while (!eof) {
+        std::vector<MutableColumnPtr> columns(COLUMN_NUMBERS);
+        for (int i = 0; i < COLUMN_NUMBERS; i++) {
+            columns[i] = tuple_desc->slots()[i]->get_empty_mutable_column();
+        }
+        EXPECT_TRUE(scanner.get_next(columns, &eof).ok());
+        for (size_t row = 0; row < columns[0]->size(); ++row) {
+            std::vector<std::string> values;
+            for (int i = 0; i < COLUMN_NUMBERS; i++) {
+                values.push_back(columns[i]->is_null_at(row)
+                                         ? "NULL"
+                                         : columns[i]->get_data_at(row).to_string());
+            }
+            rows.push_back(std::move(values));
+        }
+    }
+    scanner.close();
+    return rows;
+}
+
+TEST_F(VJsonScannerTest, simple_array) {
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.start_offset = 0;
+    range.size = -1;
+    range.format_type = TFileFormatType::FORMAT_JSON;
+    range.__set_strip_outer_array(true);
+    range.splittable = true;
+    range.path = "./be/test/exec/test_data/json_scanner/test_simple2.json";
+    range.file_type = TFileType::FILE_LOCAL;
+    ranges.push_back(range);
+
+    auto rows = scan(ranges);
+    ASSERT_EQ(2, rows.size());
+    ASSERT_EQ("reference", rows[0][0]);
+    ASSERT_EQ("NigelRees", rows[0][1]);
+    ASSERT_EQ("8.950000", rows[0][3]);
+    ASSERT_EQ("1234", rows[0][4]);
+    ASSERT_EQ("fiction", rows[1][0]);
+    // Do not use num_as_string, so largeint and decimal value loss precision
+    ASSERT_NE("1180591620717411303424", rows[1][4]);
+    ASSERT_NE("9999999999999.999999", rows[1][5]);
+    ASSERT_EQ(0, _counter.num_rows_filtered);
+
+    // Use num_as_string, load largeint, decimal successfully
+    ranges[0].__set_num_as_string(true);
+    rows = scan(ranges);
+    ASSERT_EQ(2, rows.size());
+    ASSERT_EQ("1180591620717411303424", rows[1][4]);
+    ASSERT_EQ("9999999999999.999999", rows[1][5]);
+}
+
+TEST_F(VJsonScannerTest, jsonpaths) {
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.start_offset = 0;
+    range.size = -1;
+    range.format_type = TFileFormatType::FORMAT_JSON;
+    range.__set_strip_outer_array(true);
+    range.__set_jsonpaths("[\"$.author\", \"$.category\", \"$.missing.key\", \"$\"]");
+    range.splittable = true;
+    range.path = "./be/test/exec/test_data/json_scanner/test_simple2.json";
+    range.file_type = TFileType::FILE_LOCAL;
+    ranges.push_back(range);
+
+    auto rows = scan(ranges);
+    ASSERT_EQ(2, rows.size());
+    ASSERT_EQ("NigelRees", rows[0][0]);
+    ASSERT_EQ("reference", rows[0][1]);
+    ASSERT_EQ("NULL", rows[0][2]);
+    // the whole row of "$"
+    ASSERT_EQ(0, rows[0][3].find("{\"category\":\"reference\""));
+    // the columns without a path
+    ASSERT_EQ("NULL", rows[0][4]);
+    ASSERT_EQ("EvelynWaugh", rows[1][0]);
+    ASSERT_EQ(0, _counter.num_rows_filtered);
+}
+
+} // namespace vectorized
+} // namespace doris
@@ -0,0 +1,244 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vparquet_scanner.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "exprs/cast_functions.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "runtime/user_function_cache.h"
+
+namespace doris {
+
+namespace vectorized {
+
+#define TUPLE_ID_DST 0
+#define TUPLE_ID_SRC 1
+#define COLUMN_NUMBERS 20
+#define DST_TUPLE_SLOT_ID_START 1
+#define SRC_TUPLE_SLOT_ID_START 21
+
+static const char* column_names[] = {
+        "log_version",       "log_time", "log_time_stamp", "js_version",
+        "vst_cookie",        "vst_ip",   "vst_user_id",    "vst_user_agent",
+        "device_resolution", "page_url", "page_refer_url", "page_yyid",
+        "page_type",         "pos_type", "content_id",     "media_id",
+        "spm_cnt",           "spm_pre",  "scm_cnt",        "partition_column"};
+
+static TTypeDesc create_type_desc(TPrimitiveType::type type) {
+    TTypeDesc type_desc;
+    TTypeNode node;
+    node.__set_type(TTypeNodeType::SCALAR);
+    TScalarType scalar_type;
+    scalar_type.__set_type(type);
+    if (type == TPrimitiveType::VARCHAR) {
+        scalar_type.__set_len(65535);
+    }
+    node.__set_scalar_type(scalar_type);
+    type_desc.types.push_back(node);
+    return type_desc;
+}
+
+class VParquetScannerTest : public testing::Test {
+public:
+    VParquetScannerTest() : _runtime_state(TQueryGlobals()) {
+        init();
+        _profile = _runtime_state.runtime_profile();
+        _runtime_state._instance_mem_tracker.reset(new MemTracker());
+    }
+    void init();
+
+    static void SetUpTestCase() {
+        UserFunctionCache::instance()->init(
+                "./be/test/runtime/test_data/user_function_cache/normal");
+        CastFunctions::init();
+    }
+
+protected:
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+
+private:
+    void create_tuple(TDescriptorTable& t_desc_table, TupleId tuple_id, int first_slot_id);
+    void init_desc_table();
+    void init_params();
+
+    RuntimeState _runtime_state;
+    RuntimeProfile* _profile;
+    ObjectPool _obj_pool;
+    TBrokerScanRangeParams _params;
+    DescriptorTbl* _desc_tbl;
+    std::vector<TNetworkAddress> _addresses;
+    ScannerCounter _counter;
+    std::vector<TExpr> _pre_filter;
+};
+
+// log_time of the dest tuple is BIGINT, the other slots are VARCHAR
+void VParquetScannerTest::create_tuple(TDescriptorTable& t_desc_table, TupleId tuple_id,
+                                       int first_slot_id) {
+    // Skip the first 8 bytes These 8 bytes are used to indicate whether the field is a null value
+    int byte_offset = 8;
+    for (int i = 0; i < COLUMN_NUMBERS; i++) {
+        TSlotDescriptor slot_desc;
+        slot_desc.id = first_slot_id + i;
+        slot_desc.parent = tuple_id;
+        if (tuple_id == TUPLE_ID_DST && i == 1) {
+            slot_desc.slotType = create_type_desc(TPrimitiveType::BIGINT);
+        } else {
+            slot_desc.slotType = create_type_desc(TPrimitiveType::VARCHAR);
+        }
+        slot_desc.columnPos = i;
+        slot_desc.byteOffset = byte_offset;
+        slot_desc.nullIndicatorByte = i / 8;
+        slot_desc.nullIndicatorBit = i % 8;
+        slot_desc.colName = column_names[i];
+        slot_desc.slotIdx = i + 1;
+        slot_desc.isMaterialized = true;
+        t_desc_table.slotDescriptors.push_back(slot_desc);
+        byte_offset += 16;
+    }
+
+    TTupleDescriptor t_tuple_desc;
+    t_tuple_desc.id = tuple_id;
+    t_tuple_desc.byteSize = byte_offset;
+    t_tuple_desc.numNullBytes = 0;
+    t_tuple_desc.tableId = 0;
+    t_tuple_desc.__isset.tableId = true;
+    t_desc_table.tupleDescriptors.push_back(t_tuple_desc);
+}
+
+void VParquetScannerTest::init_desc_table() {
+    TDescriptorTable t_desc_table;
+
+    // table descriptors
+    TTableDescriptor t_table_desc;
+    t_table_desc.id = 0;
+    t_table_desc.tableType = TTableType::BROKER_TABLE;
+    t_table_desc.numCols = 0;
+    t_table_desc.numClusteringCols = 0;
+    t_desc_table.tableDescriptors.push_back(t_table_desc);
+    t_desc_table.__isset.tableDescriptors = true;
+
+    create_tuple(t_desc_table, TUPLE_ID_DST, DST_TUPLE_SLOT_ID_START);
+    create_tuple(t_desc_table, TUPLE_ID_SRC, SRC_TUPLE_SLOT_ID_START);
+    t_desc_table.__isset.slotDescriptors = true;
+
+    DescriptorTbl::create(&_obj_pool, t_desc_table, &_desc_tbl);
+
+    _runtime_state.set_desc_tbl(_desc_tbl);
+}
+
+void VParquetScannerTest::init_params() {
+    TTypeDesc varchar_type = create_type_desc(TPrimitiveType::VARCHAR);
+    TTypeDesc bigint_type = create_type_desc(TPrimitiveType::BIGINT);
+    for (int i = 0; i < COLUMN_NUMBERS; i++) {
+        TExprNode slot_ref;
+        slot_ref.node_type = TExprNodeType::SLOT_REF;
+        slot_ref.type = varchar_type;
+        slot_ref.num_children = 0;
+        slot_ref.__isset.slot_ref = true;
+        slot_ref.slot_ref.slot_id = SRC_TUPLE_SLOT_ID_START + i;
+        slot_ref.slot_ref.tuple_id = TUPLE_ID_SRC;
+
+        TExpr expr;
+        if (i == 1) {
+            // log_time VARCHAR --> BIGINT
+            TExprNode cast_expr;
+            cast_expr.node_type = TExprNodeType::CAST_EXPR;
+            cast_expr.type = bigint_type;
+            cast_expr.__set_opcode(TExprOpcode::CAST);
+            cast_expr.__set_num_children(1);
+            cast_expr.__set_output_scale(-1);
+            cast_expr.__isset.fn = true;
+            cast_expr.fn.name.function_name = "casttobigint";
+            cast_expr.fn.binary_type = TFunctionBinaryType::BUILTIN;
+            cast_expr.fn.arg_types.push_back(varchar_type);
+            cast_expr.fn.ret_type = bigint_type;
+            cast_expr.fn.has_var_args = false;
+            cast_expr.fn.__set_signature("casttobigint(VARCHAR(*))");
+            cast_expr.fn.__isset.scalar_fn = true;
+            cast_expr.fn.scalar_fn.symbol = "doris::CastFunctions::cast_to_big_int_val";
+            expr.nodes.push_back(cast_expr);
+        }
+        expr.nodes.push_back(slot_ref);
+
+        _params.expr_of_dest_slot.emplace(DST_TUPLE_SLOT_ID_START + i, expr);
+        _params.src_slot_ids.push_back(SRC_TUPLE_SLOT_ID_START + i);
+    }
+    _params.__set_dest_tuple_id(TUPLE_ID_DST);
+    _params.__set_src_tuple_id(TUPLE_ID_SRC);
+}
+
+void VParquetScannerTest::init() {
+    init_desc_table();
+    init_params();
+}
+
+TEST_F(VParquetScannerTest, normal) {
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.path = "./be/test/exec/test_data/parquet_scanner/localfile.parquet";
+    range.start_offset = 0;
+    range.size = -1;
+    range.splittable = true;
+    range.file_type = TFileType::FILE_LOCAL;
+    range.format_type = TFileFormatType::FORMAT_PARQUET;
+    std::vector<std::string> columns_from_path {"value"};
+    range.__set_columns_from_path(columns_from_path);
+    range.__set_num_of_columns_from_file(COLUMN_NUMBERS - 1);
+    ranges.push_back(range);
+
+    VParquetScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, _pre_filter,
+                            &_counter);
+    auto st = scanner.open();
+    ASSERT_TRUE(st.ok());
+
+    auto tuple_desc = _desc_tbl->get_tuple_descriptor(TUPLE_ID_DST);
+    size_t num_rows = 0;
+    bool eof = false;
+    while (!eof) {
+        std::vector<MutableColumnPtr> columns(COLUMN_NUMBERS);
+        for (int i = 0; i < COLUMN_NUMBERS; i++) {
+            columns[i] = tuple_desc->slots()[i]->get_empty_mutable_column();
+        }
+        st = scanner.get_next(columns, &eof);
+        ASSERT_TRUE(st.ok());
+        for (int i = 1; i < COLUMN_NUMBERS; i++) {
+            ASSERT_EQ(columns[0]->size(), columns[i]->size());
+        }
+        for (size_t row = 0; row < columns[0]->size(); ++row) {
+            ASSERT_EQ("value", columns[COLUMN_NUMBERS - 1]->get_data_at(row).to_string());
+        }
+        num_rows += columns[0]->size();
+    }
+    ASSERT_EQ(30000, num_rows);
+    ASSERT_EQ(0, _counter.num_rows_filtered);
+    scanner.close();
+}
+
+} // namespace vectorized
+} // namespace doris
@@ -0,0 +1,198 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vsort_node.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "runtime/descriptors.h"
+#include "testutil/desc_tbl_builder.h"
+#include "vec/data_types/data_type_factory.hpp"
+#include "vec/exec/vexec_node_test_util.h"
+
+namespace doris::vectorized {
+
+// select k, v from t order by k, v limit ... offset ...
+class VSortNodeTest : public testing::Test {
+public:
+    VSortNodeTest() : _env("./ut_dir/vsort_node_test") {}
+
+    struct Row {
+        std::optional<int32_t> key;
+        int64_t value;
+    };
+
+    void SetUp() override {
+        _spill_threshold_bytes = config::vsort_spill_threshold_bytes;
+
+        DescriptorTblBuilder builder(&_pool);
+        builder.declare_tuple() << TYPE_INT << TYPE_BIGINT;
+        _desc_tbl = builder.build();
+
+        // the keys are out of order, repeated and every 13th of them is null
+        for (int i = 0; i < 100000; ++i) {
+            _rows.push_back({i % 13 == 0 ? std::nullopt : std::optional(i * 7919 % 30011), i});
+        }
+    }
+
+    void TearDown() override { config::vsort_spill_threshold_bytes = _spill_threshold_bytes; }
+
+    std::vector<Block> create_blocks() const {
+        auto key_type = DataTypeFactory::instance().create_data_type(TypeDescriptor(TYPE_INT));
+        auto value_type =
+                DataTypeFactory::instance().create_data_type(TypeDescriptor(TYPE_BIGINT));
+        std::vector<Block> blocks;
+        for (size_t start = 0; start < _rows.size(); start += 1024) {
+            auto key_column = key_type->create_column();
+            auto value_column = value_type->create_column();
+            for (size_t i = start; i < std::min(_rows.size(), start + 1024); ++i) {
+                if (_rows[i].key.has_value()) {
+                    key_column->insert_data((const char*)&*_rows[i].key, sizeof(int32_t));
+                } else {
+                    key_column->insert_data(nullptr, 0);
+                }
+                value_column->insert_data((const char*)&_rows[i].value, sizeof(int64_t));
+            }
+            blocks.emplace_back(Block({{std::move(key_column), key_type, "k"},
+                                       {std::move(value_column), value_type, "v"}}));
+        }
+        return blocks;
+    }
+
+    // The sorted rows, computed without the node.
+    std::vector<std::string> expected_rows(bool asc, bool nulls_first, int64_t limit,
+                                           int64_t offset) const {
+        auto rows = _rows;
+        std::sort(rows.begin(), rows.end(), [&](const Row& lhs, const Row& rhs) {
+            if (lhs.key.has_value() != rhs.key.has_value()) {
+                return lhs.key.has_value() != nulls_first;
+            }
+            if (lhs.key != rhs.key) {
+                return asc ? *lhs.key < *rhs.key : *lhs.key > *rhs.key;
+            }
+            return asc ? lhs.value < rhs.value : lhs.value > rhs.value;
+        });
+        std::vector<std::string> result;
+        for (size_t i = offset; i < rows.size(); ++i) {
+            if (limit != -1 && (int64_t)result.size() == limit) {
+                break;
+            }
+            result.push_back((rows[i].key.has_value() ? std::to_string(*rows[i].key) : "\\N") +
+                             "|" + std::to_string(rows[i].value));
+        }
+        return result;
+    }
+
+    std::vector<std::string> run(bool asc, bool nulls_first, int64_t limit, int64_t offset,
+                                 bool enable_spill) {
+        ObjectPool pool;
+        auto state = _env.create_runtime_state(_desc_tbl, enable_spill);
+        const auto& slots = _desc_tbl->get_tuple_descriptor(0)->slots();
+        auto child = create_source_node(&pool, state.get(), *_desc_tbl, 1, 0, create_blocks());
+
+        TSortInfo sort_info;
+        sort_info.__set_ordering_exprs({create_slot_ref(slots[0]), create_slot_ref(slots[1])});
+        sort_info.__set_is_asc_order({asc, asc});
+        sort_info.__set_nulls_first({nulls_first, nulls_first});
+        TSortNode sort_node;
+        sort_node.__set_sort_info(sort_info);
+        sort_node.__set_use_top_n(limit != -1);
+        sort_node.__set_offset(offset);
+        TPlanNode tnode = create_plan_node(TPlanNodeType::SORT_NODE, 0, {0});
+        tnode.__set_num_children(1);
+        tnode.__set_limit(limit);
+        tnode.__set_sort_node(sort_node);
+
+        std::vector<std::string> rows;
+        auto node = pool.add(new VSortNode(&pool, tnode, *_desc_tbl));
+        node->_children.push_back(child);
+        EXPECT_TRUE(node->init(tnode, state.get()).ok());
+        EXPECT_TRUE(node->prepare(state.get()).ok());
+        EXPECT_TRUE(node->open(state.get()).ok());
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            auto st = node->get_next(state.get(), &block, &eos);
+            EXPECT_TRUE(st.ok()) << st.to_string();
+            if (!st.ok()) {
+                break;
+            }
+            for (size_t i = 0; i < block.rows(); ++i) {
+                const auto& key = block.get_by_position(0);
+                const auto& value = block.get_by_position(1);
+                rows.push_back(key.type->to_string(*key.column, i) + "|" +
+                               value.type->to_string(*value.column, i));
+            }
+        }
+        _spill_runs = node->_spill_runs_counter->value();
+        EXPECT_TRUE(node->close(state.get()).ok());
+        // the spilled runs are removed
+        EXPECT_EQ(0, _env.num_spill_files());
+        return rows;
+    }
+
+    void check_spill(bool asc, bool nulls_first, int64_t limit, int64_t offset) {
+        config::vsort_spill_threshold_bytes = 64 * 1024;
+        auto rows = run(asc, nulls_first, limit, offset, true);
+        EXPECT_GT(_spill_runs, 1);
+        auto expected = expected_rows(asc, nulls_first, limit, offset);
+        EXPECT_EQ(expected.size(), rows.size());
+        EXPECT_TRUE(expected == rows);
+
+        // the same as without spilling
+        config::vsort_spill_threshold_bytes = _spill_threshold_bytes;
+        EXPECT_TRUE(rows == run(asc, nulls_first, limit, offset, false));
+        EXPECT_EQ(0, _spill_runs);
+    }
+
+protected:
+    VExecNodeTestEnv _env;
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::vector<Row> _rows;
+    int64_t _spill_runs = 0;
+
+private:
+    int64_t _spill_threshold_bytes;
+};
+
+TEST_F(VSortNodeTest, spill_full_sort) {
+    check_spill(true, true, -1, 0);
+}
+
+TEST_F(VSortNodeTest, spill_full_sort_desc_nulls_last) {
+    check_spill(false, false, -1, 0);
+}
+
+// the limit is applied to the merged runs
+TEST_F(VSortNodeTest, spill_top_n) {
+    check_spill(true, false, 3000, 0);
+}
+
+// every run keeps offset + limit rows, the offset is skipped once they are merged
+TEST_F(VSortNodeTest, spill_top_n_with_offset) {
+    check_spill(false, true, 2000, 1500);
+}
+
+} // namespace doris::vectorized
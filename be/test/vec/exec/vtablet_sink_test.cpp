@@ -128,7 +128,8 @@ public:
             if (request->has_block() && _row_desc != nullptr) {
                 brpc::Controller* cntl = static_cast<brpc::Controller*>(controller);
                 attachment_transfer_request_block<PTabletWriterAddBlockRequest>(request, cntl);
-                vectorized::Block block(request->block());
+                vectorized::Block block;
+                EXPECT_TRUE(block.deserialize(request->block()).ok());
 
                 for (size_t row_num = 0; row_num < block.rows(); ++row_num) {
                     std::stringstream out;
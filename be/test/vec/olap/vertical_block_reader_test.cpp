@@ -0,0 +1,487 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/olap/vertical_block_reader.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "gen_cpp/olap_file.pb.h"
+#include "olap/merger.h"
+#include "olap/rowset/rowset_factory.h"
+#include "olap/rowset/rowset_reader_context.h"
+#include "olap/rowset/rowset_writer.h"
+#include "olap/rowset/rowset_writer_context.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet.h"
+#include "olap/tablet_meta.h"
+#include "runtime/exec_env.h"
+#include "util/file_utils.h"
+
+namespace doris::vectorized {
+
+static StorageEngine* s_engine = nullptr;
+static std::string s_test_dir;
+
+// The table (k1 int, k2 int null, v1 bigint null, v2 int null, v3 int[, seq int]).
+class VerticalBlockReaderTest : public testing::Test {
+public:
+    struct Row {
+        int32_t k1;
+        std::optional<int32_t> k2;
+        std::optional<int64_t> v1;
+        std::optional<int32_t> v2;
+        int32_t v3;
+        int32_t seq = 0;
+    };
+
+    static void SetUpTestSuite() {
+        config::tablet_map_shard_size = 1;
+        config::txn_map_shard_size = 1;
+        config::txn_shard_size = 1;
+        char buffer[1024];
+        EXPECT_NE(getcwd(buffer, sizeof(buffer)), nullptr);
+        s_test_dir = std::string(buffer) + "/vertical_block_reader_test";
+        config::storage_root_path = s_test_dir;
+        EXPECT_TRUE(FileUtils::remove_all(s_test_dir).ok());
+        EXPECT_TRUE(FileUtils::create_dir(s_test_dir).ok());
+
+        EngineOptions options;
+        options.store_paths = {StorePath(s_test_dir, -1)};
+        Status st = StorageEngine::open(options, &s_engine);
+        EXPECT_TRUE(st.ok()) << st.to_string();
+        ExecEnv::GetInstance()->set_storage_engine(s_engine);
+        EXPECT_TRUE(FileUtils::create_dir(s_test_dir + "/rowsets").ok());
+    }
+
+    static void TearDownTestSuite() {
+        if (s_engine != nullptr) {
+            s_engine->stop();
+            delete s_engine;
+            s_engine = nullptr;
+        }
+        EXPECT_TRUE(FileUtils::remove_all(s_test_dir).ok());
+    }
+
+    void SetUp() override {
+        _num_columns_per_group = config::vertical_compaction_num_columns_per_group;
+        // every value column is a group of its own
+        config::vertical_compaction_num_columns_per_group = 1;
+    }
+
+    void TearDown() override {
+        config::vertical_compaction_num_columns_per_group = _num_columns_per_group;
+    }
+
+    void create_tablet(KeysType keys_type, bool has_sequence_col) {
+        std::string value_agg = keys_type == DUP_KEYS ? "NONE" : "REPLACE";
+        TabletSchemaPB schema_pb;
+        schema_pb.set_keys_type(keys_type);
+        schema_pb.set_num_short_key_columns(2);
+        schema_pb.set_num_rows_per_row_block(1024);
+        schema_pb.set_compress_kind(COMPRESS_NONE);
+        auto add_column = [&](const std::string& name, const std::string& type, bool is_key,
+                              bool is_nullable, const std::string& aggregation) {
+            ColumnPB* column = schema_pb.add_column();
+            column->set_unique_id(schema_pb.column_size());
+            column->set_name(name);
+            column->set_type(type);
+            column->set_is_key(is_key);
+            column->set_is_nullable(is_nullable);
+            column->set_length(type == "BIGINT" ? 8 : 4);
+            column->set_index_length(type == "BIGINT" ? 8 : 4);
+            if (!is_key) {
+                column->set_aggregation(aggregation);
+            }
+        };
+        add_column("k1", "INT", true, false, "");
+        add_column("k2", "INT", true, true, "");
+        add_column("v1", "BIGINT", false, true, keys_type == AGG_KEYS ? "SUM" : value_agg);
+        add_column("v2", "INT", false, true, value_agg);
+        add_column("v3", "INT", false, false, keys_type == AGG_KEYS ? "MAX" : value_agg);
+        if (has_sequence_col) {
+            add_column("__DORIS_SEQUENCE_COL__", "INT", false, false, value_agg);
+            schema_pb.set_sequence_col_idx(5);
+        }
+        schema_pb.set_next_column_unique_id(schema_pb.column_size() + 1);
+
+        TabletMetaSharedPtr tablet_meta(new TabletMeta());
+        tablet_meta->mutable_tablet_schema()->init_from_pb(schema_pb);
+        _tablet.reset(new Tablet(tablet_meta, StorageParamPB(), nullptr));
+    }
+
+    RowsetSharedPtr create_rowset(const std::vector<Row>& rows, int64_t version) {
+        const auto& schema = _tablet->tablet_schema();
+        std::vector<uint32_t> columns(schema.num_columns());
+        std::iota(columns.begin(), columns.end(), 0);
+        Block block = schema.create_block(columns);
+        auto mutable_columns = block.mutate_columns();
+        for (const auto& row : rows) {
+            mutable_columns[0]->insert_data((const char*)&row.k1, sizeof(row.k1));
+            mutable_columns[1]->insert_data(row.k2.has_value() ? (const char*)&*row.k2 : nullptr,
+                                            sizeof(int32_t));
+            mutable_columns[2]->insert_data(row.v1.has_value() ? (const char*)&*row.v1 : nullptr,
+                                            sizeof(int64_t));
+            mutable_columns[3]->insert_data(row.v2.has_value() ? (const char*)&*row.v2 : nullptr,
+                                            sizeof(int32_t));
+            mutable_columns[4]->insert_data((const char*)&row.v3, sizeof(row.v3));
+            if (schema.has_sequence_col()) {
+                mutable_columns[5]->insert_data((const char*)&row.seq, sizeof(row.seq));
+            }
+        }
+        block.set_columns(std::move(mutable_columns));
+
+        auto rowset_writer = create_rowset_writer({version, version});
+        EXPECT_TRUE(rowset_writer->add_block(&block).ok());
+        EXPECT_TRUE(rowset_writer->flush().ok());
+        auto rowset = rowset_writer->build();
+        EXPECT_TRUE(rowset != nullptr);
+        return rowset;
+    }
+
+    std::unique_ptr<RowsetWriter> create_rowset_writer(const Version& version) {
+        RowsetWriterContext context;
+        context.rowset_id = s_engine->next_rowset_id();
+        context.tablet_id = _tablet->tablet_id();
+        context.tablet_schema_hash = _tablet->schema_hash();
+        context.rowset_type = BETA_ROWSET;
+        context.path_desc.filepath = s_test_dir + "/rowsets";
+        context.rowset_state = VISIBLE;
+        context.tablet_schema = &_tablet->tablet_schema();
+        context.version = version;
+        context.segments_overlap = NONOVERLAPPING;
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        EXPECT_TRUE(RowsetFactory::create_rowset_writer(context, &rowset_writer).ok());
+        return rowset_writer;
+    }
+
+    static std::vector<std::string> to_strings(const Block& block) {
+        std::vector<std::string> rows;
+        for (size_t i = 0; i < block.rows(); ++i) {
+            std::string row;
+            for (size_t cid = 0; cid < block.columns(); ++cid) {
+                const auto& column = block.get_by_position(cid);
+                row += (cid == 0 ? "" : "|") + column.type->to_string(*column.column, i);
+            }
+            rows.push_back(row);
+        }
+        return rows;
+    }
+
+    std::vector<RowsetReaderSharedPtr> create_readers(const std::vector<RowsetSharedPtr>& rowsets) {
+        std::vector<RowsetReaderSharedPtr> rs_readers;
+        for (const auto& rowset : rowsets) {
+            RowsetReaderSharedPtr rs_reader;
+            EXPECT_TRUE(rowset->create_reader(&rs_reader).ok());
+            rs_readers.push_back(std::move(rs_reader));
+        }
+        return rs_readers;
+    }
+
+    // Read a column group of the rowsets with a VerticalBlockReader, return the rows of
+    // every block.
+    std::vector<std::vector<std::string>> read_column_group(
+            const std::vector<RowsetSharedPtr>& rowsets, const std::vector<uint32_t>& group,
+            bool is_key, RowSourcesBuffer* row_sources, int batch_size,
+            uint64_t* merged_rows = nullptr) {
+        const auto& schema = _tablet->tablet_schema();
+        std::set<uint32_t> read_columns(group.begin(), group.end());
+        for (uint32_t cid = 0; cid < schema.num_key_columns(); ++cid) {
+            read_columns.insert(cid);
+        }
+        if (schema.has_sequence_col()) {
+            read_columns.insert(schema.sequence_col_idx());
+        }
+        TabletReader::ReaderParams reader_params;
+        reader_params.tablet = _tablet;
+        reader_params.reader_type = READER_CUMULATIVE_COMPACTION;
+        reader_params.rs_readers = create_readers(rowsets);
+        reader_params.version = {rowsets.front()->start_version(), rowsets.back()->end_version()};
+        reader_params.return_columns.assign(read_columns.begin(), read_columns.end());
+        reader_params.origin_return_columns = &reader_params.return_columns;
+
+        VerticalBlockReader reader(row_sources);
+        reader.set_batch_size(batch_size);
+        EXPECT_TRUE(reader.init(reader_params, group, is_key).ok());
+        std::vector<std::vector<std::string>> blocks;
+        Block block = schema.create_block(group);
+        bool eof = false;
+        while (!eof) {
+            auto st = reader.next_block(&block, &eof);
+            EXPECT_TRUE(st.ok()) << st.to_string();
+            if (!st.ok()) {
+                break;
+            }
+            blocks.push_back(to_strings(block));
+            block.clear_column_data();
+        }
+        if (merged_rows != nullptr) {
+            *merged_rows = reader.merged_rows();
+        }
+        return blocks;
+    }
+
+    // Compact the rowsets vertically or not, and return the rows of the output rowset.
+    std::vector<std::string> compact(const std::vector<RowsetSharedPtr>& rowsets, bool vertical,
+                                     Merger::Statistics* stats) {
+        Version version = {rowsets.front()->start_version(), rowsets.back()->end_version()};
+        auto rowset_writer = create_rowset_writer(version);
+        auto rs_readers = create_readers(rowsets);
+        Status st = vertical ? Merger::vertical_merge_rowsets(_tablet, READER_CUMULATIVE_COMPACTION,
+                                                              rs_readers, rowset_writer.get(),
+                                                              1000, stats)
+                             : Merger::vmerge_rowsets(_tablet, READER_CUMULATIVE_COMPACTION,
+                                                      rs_readers, rowset_writer.get(), stats);
+        EXPECT_TRUE(st.ok()) << st.to_string();
+        auto output_rowset = rowset_writer->build();
+        EXPECT_TRUE(output_rowset != nullptr);
+        EXPECT_EQ(stats->output_rows, (int64_t)output_rowset->num_rows());
+
+        const auto& schema = _tablet->tablet_schema();
+        std::vector<uint32_t> columns(schema.num_columns());
+        std::iota(columns.begin(), columns.end(), 0);
+        OlapReaderStatistics reader_stats;
+        RowsetReaderContext context;
+        context.tablet_schema = &schema;
+        context.need_ordered_result = false;
+        context.return_columns = &columns;
+        context.seek_columns = &columns;
+        context.stats = &reader_stats;
+        context.is_vec = true;
+        RowsetReaderSharedPtr rs_reader;
+        EXPECT_TRUE(output_rowset->create_reader(&rs_reader).ok());
+        EXPECT_TRUE(rs_reader->init(&context).ok());
+
+        std::vector<std::string> rows;
+        while (true) {
+            Block block = schema.create_block(columns);
+            st = rs_reader->next_block(&block);
+            if (!st.ok()) {
+                EXPECT_EQ(Status::OLAPInternalError(OLAP_ERR_DATA_EOF), st);
+                break;
+            }
+            auto block_rows = to_strings(block);
+            rows.insert(rows.end(), block_rows.begin(), block_rows.end());
+        }
+        return rows;
+    }
+
+    // The rowsets of versions [2, 7) share most of their keys, every rowset is sorted and
+    // has a key at most once.
+    std::vector<RowsetSharedPtr> create_overlapping_rowsets() {
+        std::vector<RowsetSharedPtr> rowsets;
+        for (int r = 0; r < 5; ++r) {
+            std::vector<Row> rows;
+            for (int32_t k1 = 0; k1 < 2000; ++k1) {
+                if ((k1 + r) % 4 == 0) {
+                    continue;
+                }
+                Row row;
+                row.k1 = k1;
+                row.k2 = k1 % 7 == 0 ? std::nullopt : std::optional(k1 % 13);
+                row.v1 = (k1 + r) % 9 == 0 ? std::nullopt : std::optional(r * 10000 + k1);
+                row.v2 = k1 * r % 100;
+                row.v3 = (k1 + r) % 17;
+                // the sequence values repeat across the versions
+                row.seq = (k1 * 7 + r * 3) % 5;
+                rows.push_back(row);
+            }
+            rowsets.push_back(create_rowset(rows, r + 2));
+        }
+        return rowsets;
+    }
+
+    // The vertical compaction outputs the same rows as the horizontal one.
+    void check_same_as_horizontal() {
+        auto rowsets = create_overlapping_rowsets();
+        Merger::Statistics vertical_stats;
+        auto rows = compact(rowsets, true, &vertical_stats);
+        Merger::Statistics stats;
+        auto expected = compact(rowsets, false, &stats);
+        EXPECT_EQ(expected.size(), rows.size());
+        EXPECT_TRUE(expected == rows);
+        EXPECT_EQ(stats.output_rows, vertical_stats.output_rows);
+        EXPECT_EQ(stats.merged_rows, vertical_stats.merged_rows);
+        if (_tablet->keys_type() == DUP_KEYS) {
+            EXPECT_EQ(0, vertical_stats.merged_rows);
+        } else {
+            // 2000 keys, each of them is missed by one or two rowsets only
+            EXPECT_EQ(2000, vertical_stats.output_rows);
+            EXPECT_GT(vertical_stats.merged_rows, 0);
+        }
+    }
+
+    // Three small rowsets, the key 3 is in all of them and the key 5 in two of them.
+    std::vector<RowsetSharedPtr> create_small_rowsets() {
+        std::vector<std::vector<int32_t>> keys = {{1, 3, 5}, {2, 3, 6}, {3, 4, 5}};
+        std::vector<RowsetSharedPtr> rowsets;
+        for (int r = 0; r < (int)keys.size(); ++r) {
+            int64_t version = r + 2;
+            std::vector<Row> rows;
+            for (auto k1 : keys[r]) {
+                Row row;
+                row.k1 = k1;
+                row.k2 = k1 == 3 ? std::nullopt : std::optional(k1 * 10);
+                row.v1 = version * 100 + k1;
+                row.v2 = version;
+                row.v3 = k1;
+                rows.push_back(row);
+            }
+            rowsets.push_back(create_rowset(rows, version));
+        }
+        return rowsets;
+    }
+
+protected:
+    TabletSharedPtr _tablet;
+
+private:
+    int32_t _num_columns_per_group;
+};
+
+TEST_F(VerticalBlockReaderTest, row_sources_buffer) {
+    RowSourcesBuffer row_sources;
+    row_sources.append(0, false);
+    row_sources.append(2, true);
+    row_sources.append(RowSourcesBuffer::MAX_SOURCES - 1, false);
+    EXPECT_EQ(3, row_sources.size());
+
+    // replayed from the beginning as many times as there are value groups
+    for (int i = 0; i < 2; ++i) {
+        row_sources.seek_to_begin();
+        ASSERT_TRUE(row_sources.has_remaining());
+        EXPECT_EQ(0, RowSourcesBuffer::source(row_sources.peek()));
+        EXPECT_FALSE(RowSourcesBuffer::agg_flag(row_sources.peek()));
+        row_sources.advance();
+        EXPECT_EQ(2, RowSourcesBuffer::source(row_sources.peek()));
+        EXPECT_TRUE(RowSourcesBuffer::agg_flag(row_sources.peek()));
+        row_sources.advance();
+        EXPECT_EQ(RowSourcesBuffer::MAX_SOURCES - 1,
+                  RowSourcesBuffer::source(row_sources.peek()));
+        EXPECT_FALSE(RowSourcesBuffer::agg_flag(row_sources.peek()));
+        row_sources.advance();
+        EXPECT_FALSE(row_sources.has_remaining());
+    }
+}
+
+// The key group merges the rowsets in a heap and records the row sources, the value groups
+// replay them. The batch of 3 rows is full at the key 3, whose other rows still go to the
+// same batch.
+TEST_F(VerticalBlockReaderTest, unique_keys_merge_and_replay) {
+    create_tablet(UNIQUE_KEYS, false);
+    auto rowsets = create_small_rowsets();
+
+    RowSourcesBuffer row_sources;
+    uint64_t merged_rows = 0;
+    auto key_blocks = read_column_group(rowsets, {0, 1}, true, &row_sources, 3, &merged_rows);
+    std::vector<std::vector<std::string>> expected_keys = {{"1|10", "2|20", "3|\\N"},
+                                                           {"4|40", "5|50", "6|60"}};
+    EXPECT_EQ(expected_keys, key_blocks);
+    EXPECT_EQ(3, merged_rows);
+
+    // the key 3 is taken from the highest version 4, then dropped from the versions 3 and 2
+    std::vector<std::pair<uint16_t, bool>> expected_sources = {
+            {0, false}, {1, false}, {2, false}, {1, true}, {0, true},
+            {2, false}, {2, false}, {0, true},  {1, false}};
+    std::vector<std::pair<uint16_t, bool>> sources;
+    for (row_sources.seek_to_begin(); row_sources.has_remaining(); row_sources.advance()) {
+        sources.emplace_back(RowSourcesBuffer::source(row_sources.peek()),
+                             RowSourcesBuffer::agg_flag(row_sources.peek()));
+    }
+    EXPECT_EQ(expected_sources, sources);
+
+    // each value group takes the rows of the highest versions in the order of the keys
+    std::vector<std::vector<std::string>> expected_v1 = {{"201", "302", "403"},
+                                                         {"404", "405", "306"}};
+    EXPECT_EQ(expected_v1, read_column_group(rowsets, {2}, false, &row_sources, 3));
+    std::vector<std::vector<std::string>> expected_v2 = {{"2", "3", "4"}, {"4", "4", "3"}};
+    EXPECT_EQ(expected_v2, read_column_group(rowsets, {3}, false, &row_sources, 3));
+}
+
+// The value groups aggregate the rows of a key, also when the batch is full at the key.
+TEST_F(VerticalBlockReaderTest, agg_keys_across_column_groups) {
+    create_tablet(AGG_KEYS, false);
+    auto rowsets = create_small_rowsets();
+
+    RowSourcesBuffer row_sources;
+    auto key_blocks = read_column_group(rowsets, {0, 1}, true, &row_sources, 3);
+    EXPECT_EQ(2, key_blocks.size());
+    EXPECT_EQ(9, row_sources.size());
+
+    // SUM
+    std::vector<std::vector<std::string>> expected_v1 = {{"201", "302", "909"},
+                                                         {"404", "610", "306"}};
+    EXPECT_EQ(expected_v1, read_column_group(rowsets, {2}, false, &row_sources, 3));
+    // REPLACE keeps the value of the highest version
+    std::vector<std::vector<std::string>> expected_v2 = {{"2", "3", "4"}, {"4", "4", "3"}};
+    EXPECT_EQ(expected_v2, read_column_group(rowsets, {3}, false, &row_sources, 3));
+    // a group of more than one column
+    std::vector<std::vector<std::string>> expected_v2_v3 = {{"2|1", "3|2", "4|3"},
+                                                            {"4|4", "4|5", "3|6"}};
+    EXPECT_EQ(expected_v2_v3, read_column_group(rowsets, {3, 4}, false, &row_sources, 3));
+}
+
+// The row of the greatest sequence value is kept, then the one of the highest version.
+TEST_F(VerticalBlockReaderTest, unique_keys_with_sequence_col) {
+    create_tablet(UNIQUE_KEYS, true);
+    std::vector<RowsetSharedPtr> rowsets;
+    // (k1, seq) of every version
+    std::vector<std::vector<std::pair<int32_t, int32_t>>> keys = {
+            {{1, 5}, {2, 1}, {3, 2}}, {{1, 3}, {2, 4}, {3, 2}}, {{1, 4}, {2, 4}}};
+    for (int r = 0; r < (int)keys.size(); ++r) {
+        std::vector<Row> rows;
+        for (auto [k1, seq] : keys[r]) {
+            rows.push_back({k1, k1, r + 2, r + 2, k1, seq});
+        }
+        rowsets.push_back(create_rowset(rows, r + 2));
+    }
+
+    RowSourcesBuffer row_sources;
+    // the sequence column is merged with the keys
+    std::vector<std::vector<std::string>> expected_keys = {{"1|1|5", "2|2|4", "3|3|2"}};
+    EXPECT_EQ(expected_keys, read_column_group(rowsets, {0, 1, 5}, true, &row_sources, 1024));
+    std::vector<std::vector<std::string>> expected_v1 = {{"2", "4", "3"}};
+    EXPECT_EQ(expected_v1, read_column_group(rowsets, {2}, false, &row_sources, 1024));
+}
+
+TEST_F(VerticalBlockReaderTest, compaction_dup_keys) {
+    create_tablet(DUP_KEYS, false);
+    check_same_as_horizontal();
+}
+
+TEST_F(VerticalBlockReaderTest, compaction_agg_keys) {
+    create_tablet(AGG_KEYS, false);
+    check_same_as_horizontal();
+}
+
+TEST_F(VerticalBlockReaderTest, compaction_unique_keys) {
+    create_tablet(UNIQUE_KEYS, false);
+    check_same_as_horizontal();
+}
+
+TEST_F(VerticalBlockReaderTest, compaction_unique_keys_with_sequence_col) {
+    create_tablet(UNIQUE_KEYS, true);
+    check_same_as_horizontal();
+}
+
+} // namespace doris::vectorized
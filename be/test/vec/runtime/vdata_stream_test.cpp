@@ -183,4 +183,94 @@ TEST_F(VDataStreamTest, BasicTest) {
     sender.close(&runtime_stat, exec_status);
     recv->close();
 }
+
+TEST_F(VDataStreamTest, LocalExchangeTest) {
+    doris::DescriptorTblBuilder builder(&_object_pool);
+    builder.declare_tuple() << doris::TYPE_INT;
+    doris::DescriptorTbl* desc_tbl = builder.build();
+    auto tuple_desc = const_cast<doris::TupleDescriptor*>(desc_tbl->get_tuple_descriptor(0));
+    doris::RowDescriptor row_desc(tuple_desc, false);
+
+    doris::RuntimeState runtime_stat(doris::TUniqueId(), doris::TQueryOptions(),
+                                     doris::TQueryGlobals(), nullptr);
+    runtime_stat.init_instance_mem_tracker();
+    runtime_stat.set_desc_tbl(desc_tbl);
+
+    TUniqueId uid;
+    RuntimeProfile profile("profile");
+    std::shared_ptr<QueryStatisticsRecvr> statistics = std::make_shared<QueryStatisticsRecvr>();
+    auto recv = _instance.create_recvr(&runtime_stat, row_desc, uid, 1, 1, 1024 * 1024, &profile,
+                                       false, statistics);
+
+    auto make_block = []() {
+        auto vec = vectorized::ColumnVector<Int32>::create();
+        for (int i = 0; i < 1024; ++i) {
+            vec->get_data().push_back(i);
+        }
+        vectorized::DataTypePtr data_type(std::make_shared<vectorized::DataTypeInt32>());
+        return vectorized::Block({{vec->get_ptr(), data_type, "test_int"}});
+    };
+
+    // copied block is left untouched
+    auto block = make_block();
+    recv->add_block(&block, 0, false);
+    EXPECT_EQ(1024, block.rows());
+
+    // moved block keeps its schema with empty columns
+    auto moved_block = make_block();
+    const IColumn* moved_column = moved_block.get_by_position(0).column.get();
+    recv->add_block(&moved_block, 0, true);
+    EXPECT_EQ(1, moved_block.columns());
+    EXPECT_EQ(0, moved_block.rows());
+    EXPECT_NE(moved_column, moved_block.get_by_position(0).column.get());
+
+    bool eos = false;
+    Block block_1;
+    recv->get_next(&block_1, &eos);
+    EXPECT_EQ(1024, block_1.rows());
+    Block block_2;
+    recv->get_next(&block_2, &eos);
+    EXPECT_EQ(1024, block_2.rows());
+    EXPECT_EQ(block.dump_data(), block_2.dump_data());
+
+    recv->close();
+}
+
+TEST(BlockCompressionPolicyTest, AdaptiveCodec) {
+    BlockCompressionPolicy policy;
+    policy.init(segment_v2::CompressionTypePB::LZ4, true);
+    EXPECT_EQ(segment_v2::CompressionTypePB::LZ4, policy.next_codec());
+
+    // the sender mostly waits for the network
+    for (int i = 0; i < 10; ++i) {
+        policy.update_network_wait(900, 1000);
+    }
+    EXPECT_EQ(segment_v2::CompressionTypePB::ZSTD, policy.next_codec());
+    // a block which hardly shrinks turns compression off for a while
+    policy.update(segment_v2::CompressionTypePB::ZSTD, 1000, 950);
+    EXPECT_EQ(segment_v2::CompressionTypePB::NO_COMPRESSION, policy.next_codec());
+    for (int i = 0; i < 16; ++i) {
+        policy.update(segment_v2::CompressionTypePB::NO_COMPRESSION, 1000, 1000);
+    }
+    EXPECT_EQ(segment_v2::CompressionTypePB::ZSTD, policy.next_codec());
+
+    // the network keeps up again
+    for (int i = 0; i < 10; ++i) {
+        policy.update_network_wait(0, 1000);
+    }
+    EXPECT_EQ(segment_v2::CompressionTypePB::LZ4, policy.next_codec());
+
+    // nothing changes without the adaptive mode
+    BlockCompressionPolicy fixed_policy;
+    fixed_policy.init(segment_v2::CompressionTypePB::LZ4, false);
+    fixed_policy.update_network_wait(1000, 1000);
+    fixed_policy.update(segment_v2::CompressionTypePB::LZ4, 1000, 1000);
+    EXPECT_EQ(segment_v2::CompressionTypePB::LZ4, fixed_policy.next_codec());
+
+    // blocks to the same host are not compressed
+    BlockCompressionPolicy same_host_policy;
+    same_host_policy.init(segment_v2::CompressionTypePB::LZ4, true, true);
+    same_host_policy.update_network_wait(1000, 1000);
+    EXPECT_EQ(segment_v2::CompressionTypePB::NO_COMPRESSION, same_host_policy.next_codec());
+}
 } // namespace doris::vectorized
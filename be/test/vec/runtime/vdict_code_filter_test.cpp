@@ -0,0 +1,135 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vdict_code_filter.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+class VDictCodeFilterTest : public testing::Test {
+public:
+    void SetUp() override {
+        _words = {"a", "bb", "ccc"};
+        for (const auto& word : _words) {
+            _dict.emplace_back(word.data(), word.size());
+        }
+    }
+
+protected:
+    // the codes of the rows as output by the segment iterator
+    MutableColumnPtr create_codes(const std::vector<int32_t>& codes) {
+        auto column = ColumnDictI32::create();
+        column->reserve(codes.size());
+        column->insert_many_dict_data(codes.data(), 0, _dict.data(), codes.size(), _dict.size());
+        std::vector<uint16_t> sel(codes.size());
+        std::iota(sel.begin(), sel.end(), 0);
+        return column->clone_codes_by_selector(sel.data(), sel.size());
+    }
+
+    static MutableColumnPtr create_ints(const std::vector<int32_t>& values) {
+        auto column = ColumnInt32::create();
+        for (auto value : values) {
+            column->insert_value(value);
+        }
+        return column;
+    }
+
+    std::vector<std::string> _words;
+    std::vector<StringRef> _dict;
+};
+
+TEST_F(VDictCodeFilterTest, filter_block) {
+    Block block;
+    block.insert({create_codes({0, 1, 2, 1, 0, 2}), std::make_shared<DataTypeString>(), "s"});
+    block.insert({create_ints({0, 1, 2, 3, 4, 5}), std::make_shared<DataTypeInt32>(), "i"});
+
+    std::vector<VDictCodeFilter> filters;
+    filters.emplace_back(0, std::unordered_set<std::string> {"bb", "ccc", "dddd"});
+    size_t filtered_rows = 0;
+    ASSERT_TRUE(VDictCodeFilter::filter_block(&filters, &block, &filtered_rows).ok());
+    EXPECT_EQ(2, filtered_rows);
+
+    ASSERT_EQ(4, block.rows());
+    const auto& strings = *block.get_by_position(0).column;
+    EXPECT_TRUE(strings.is_column_string());
+    const auto& ints = *block.get_by_position(1).column;
+    std::vector<std::string> expected_strings = {"bb", "ccc", "bb", "ccc"};
+    std::vector<int32_t> expected_ints = {1, 2, 3, 5};
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(expected_strings[i], strings.get_data_at(i).to_string());
+        EXPECT_EQ(expected_ints[i], ints.get_int(i));
+    }
+}
+
+TEST_F(VDictCodeFilterTest, filter_nullable_block) {
+    auto null_map = ColumnUInt8::create();
+    for (uint8_t is_null : {0, 1, 0, 0}) {
+        null_map->insert_value(is_null);
+    }
+    Block block;
+    block.insert({ColumnNullable::create(create_codes({1, 0, 0, 2}), std::move(null_map)),
+                  make_nullable(std::make_shared<DataTypeString>()), "s"});
+    // a not nullable column of the storage read into a nullable slot
+    block.insert({create_codes({2, 2, 1, 0}), make_nullable(std::make_shared<DataTypeString>()),
+                  "t"});
+
+    std::vector<VDictCodeFilter> filters;
+    filters.emplace_back(0, std::unordered_set<std::string> {"a", "bb"});
+    size_t filtered_rows = 0;
+    ASSERT_TRUE(VDictCodeFilter::filter_block(&filters, &block, &filtered_rows).ok());
+    // the NULL row is filtered too
+    EXPECT_EQ(2, filtered_rows);
+
+    ASSERT_EQ(2, block.rows());
+    const auto& s = assert_cast<const ColumnNullable&>(*block.get_by_position(0).column);
+    EXPECT_EQ("bb", s.get_nested_column().get_data_at(0).to_string());
+    EXPECT_EQ("a", s.get_nested_column().get_data_at(1).to_string());
+    EXPECT_FALSE(s.is_null_at(0));
+    EXPECT_FALSE(s.is_null_at(1));
+    // the columns without a filter are only decoded
+    const auto& t = assert_cast<const ColumnNullable&>(*block.get_by_position(1).column);
+    EXPECT_EQ("ccc", t.get_nested_column().get_data_at(0).to_string());
+    EXPECT_EQ("bb", t.get_nested_column().get_data_at(1).to_string());
+    EXPECT_FALSE(t.is_null_at(0));
+}
+
+TEST_F(VDictCodeFilterTest, without_codes) {
+    // the rows read from the plain encoded pages are left to the conjuncts
+    Block block;
+    auto strings = ColumnString::create();
+    strings->insert_data("a", 1);
+    strings->insert_data("ccc", 3);
+    block.insert({std::move(strings), std::make_shared<DataTypeString>(), "s"});
+
+    std::vector<VDictCodeFilter> filters;
+    filters.emplace_back(0, std::unordered_set<std::string> {"a"});
+    size_t filtered_rows = 0;
+    ASSERT_TRUE(VDictCodeFilter::filter_block(&filters, &block, &filtered_rows).ok());
+    EXPECT_EQ(0, filtered_rows);
+    EXPECT_EQ(2, block.rows());
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,111 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vspill_stream.h"
+
+#include <gtest/gtest.h>
+
+#include "util/file_utils.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+class VSpillStreamTest : public testing::Test {
+public:
+    void SetUp() override {
+        auto st = FileUtils::create_dir("./ut_dir/vspill_stream");
+        EXPECT_TRUE(st.ok());
+    }
+
+    static Block create_block(int start, int rows) {
+        auto int_column = ColumnInt32::create();
+        auto string_column = ColumnString::create();
+        auto null_map = ColumnUInt8::create();
+        for (int i = start; i < start + rows; ++i) {
+            int_column->insert_value(i);
+            std::string str = std::to_string(i);
+            string_column->insert_data(str.data(), str.size());
+            null_map->insert_value(i % 3 == 0);
+        }
+        auto nullable_column = ColumnNullable::create(std::move(string_column), std::move(null_map));
+
+        DataTypePtr int_type = std::make_shared<DataTypeInt32>();
+        DataTypePtr string_type = make_nullable(std::make_shared<DataTypeString>());
+        return Block({{std::move(int_column), int_type, "k1"},
+                      {std::move(nullable_column), string_type, "k2"}});
+    }
+};
+
+TEST_F(VSpillStreamTest, write_and_read) {
+    std::string path = "./ut_dir/vspill_stream/write_and_read";
+    {
+        VSpillStream stream(path);
+        EXPECT_TRUE(stream.add_block(create_block(0, 100)).ok());
+        // empty blocks are skipped
+        EXPECT_TRUE(stream.add_block(create_block(100, 0)).ok());
+        EXPECT_TRUE(stream.add_block(create_block(100, 4096)).ok());
+        EXPECT_EQ(2, stream.num_blocks());
+        EXPECT_EQ(4196, stream.num_rows());
+        EXPECT_GT(stream.bytes_written(), 0);
+
+        // the stream can be read more than once
+        for (int round = 0; round < 2; ++round) {
+            EXPECT_TRUE(stream.prepare_for_read().ok());
+            int next_value = 0;
+            bool eos = false;
+            while (true) {
+                Block block;
+                EXPECT_TRUE(stream.get_next(&block, &eos).ok());
+                if (eos) {
+                    break;
+                }
+                EXPECT_EQ(2, block.columns());
+                EXPECT_EQ("k2", block.get_by_position(1).name);
+                EXPECT_TRUE(block.get_by_position(1).type->is_nullable());
+                for (int i = 0; i < block.rows(); ++i, ++next_value) {
+                    EXPECT_EQ(next_value, block.get_by_position(0).column->get_int(i));
+                    auto& column = block.get_by_position(1).column;
+                    EXPECT_EQ(next_value % 3 == 0, column->is_null_at(i));
+                    if (!column->is_null_at(i)) {
+                        EXPECT_EQ(std::to_string(next_value), column->get_data_at(i).to_string());
+                    }
+                }
+            }
+            EXPECT_EQ(4196, next_value);
+        }
+        EXPECT_TRUE(FileUtils::check_exist(path));
+    }
+    // the file is removed with the stream
+    EXPECT_FALSE(FileUtils::check_exist(path));
+}
+
+TEST_F(VSpillStreamTest, empty_stream) {
+    VSpillStream stream("./ut_dir/vspill_stream/empty_stream");
+    EXPECT_TRUE(stream.empty());
+    EXPECT_TRUE(stream.prepare_for_read().ok());
+    Block block;
+    bool eos = false;
+    EXPECT_TRUE(stream.get_next(&block, &eos).ok());
+    EXPECT_TRUE(eos);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,128 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/vtopn_filter.h"
+
+#include <gtest/gtest.h>
+
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+static MutableColumnPtr create_column(const std::vector<int32_t>& values) {
+    auto column = ColumnInt32::create();
+    for (auto value : values) {
+        column->insert_value(value);
+    }
+    return column;
+}
+
+TEST(VTopNFilterTest, update) {
+    VTopNFilter filter("k1", std::make_shared<DataTypeInt32>(), true, false, true);
+    std::vector<TCondition> conditions;
+    EXPECT_EQ(0, filter.version());
+    EXPECT_EQ(0, filter.get_olap_conditions(&conditions));
+    EXPECT_TRUE(conditions.empty());
+
+    auto column = create_column({10, 20, 30});
+    filter.update(*column, 2);
+    EXPECT_EQ(1, filter.version());
+    // a looser bound is ignored
+    filter.update(*create_column({40}), 0);
+    EXPECT_EQ(1, filter.version());
+    filter.update(*column, 1);
+    EXPECT_EQ(2, filter.version());
+
+    EXPECT_EQ(2, filter.get_olap_conditions(&conditions));
+    ASSERT_EQ(1, conditions.size());
+    EXPECT_EQ("k1", conditions[0].column_name);
+    EXPECT_EQ("<=", conditions[0].condition_op);
+    EXPECT_EQ(std::vector<std::string>({"20"}), conditions[0].condition_values);
+
+    // NULL never tightens the bound
+    auto null_map = ColumnUInt8::create();
+    null_map->insert_value(1);
+    auto nullable_column = ColumnNullable::create(create_column({0}), std::move(null_map));
+    filter.update(*nullable_column, 0);
+    EXPECT_EQ(2, filter.version());
+}
+
+TEST(VTopNFilterTest, filter_block) {
+    VTopNFilter filter("k1", std::make_shared<DataTypeInt32>(), false, false, false);
+    filter.update(*create_column({30, 20, 10}), 1);
+
+    auto null_map = ColumnUInt8::create();
+    for (int i = 0; i < 5; ++i) {
+        null_map->insert_value(i == 4);
+    }
+    auto nullable_column =
+            ColumnNullable::create(create_column({5, 20, 25, 15, 40}), std::move(null_map));
+    Block block({{std::move(nullable_column), make_nullable(std::make_shared<DataTypeInt32>()),
+                  "k1"},
+                 {create_column({0, 1, 2, 3, 4}), std::make_shared<DataTypeInt32>(), "k2"}});
+
+    size_t filtered_rows = 0;
+    EXPECT_TRUE(filter.filter_block(&block, 0, &filtered_rows).ok());
+    // desc order, the rows smaller than 20 and NULL are filtered out
+    EXPECT_EQ(3, filtered_rows);
+    EXPECT_EQ(2, block.columns());
+    ASSERT_EQ(2, block.rows());
+    EXPECT_EQ(1, block.get_by_position(1).column->get_int(0));
+    EXPECT_EQ(2, block.get_by_position(1).column->get_int(1));
+
+    // not pushed to the storage
+    std::vector<TCondition> conditions;
+    EXPECT_EQ(1, filter.get_olap_conditions(&conditions));
+    EXPECT_TRUE(conditions.empty());
+}
+
+TEST(VTopNFilterTest, filter_block_nulls_first) {
+    VTopNFilter filter("k1", std::make_shared<DataTypeInt32>(), true, true, false);
+    // all of the first n rows are NULL, there is no bound yet
+    auto null_map = ColumnUInt8::create();
+    for (int i = 0; i < 3; ++i) {
+        null_map->insert_value(i < 2);
+    }
+    filter.update(*ColumnNullable::create(create_column({0, 0, 10}), std::move(null_map)), 1);
+    EXPECT_EQ(0, filter.version());
+    filter.update(*create_column({10, 20, 30}), 1);
+    EXPECT_EQ(1, filter.version());
+
+    null_map = ColumnUInt8::create();
+    for (int i = 0; i < 4; ++i) {
+        null_map->insert_value(i == 3);
+    }
+    auto nullable_column =
+            ColumnNullable::create(create_column({5, 20, 25, 0}), std::move(null_map));
+    Block block({{std::move(nullable_column), make_nullable(std::make_shared<DataTypeInt32>()),
+                  "k1"},
+                 {create_column({0, 1, 2, 3}), std::make_shared<DataTypeInt32>(), "k2"}});
+
+    size_t filtered_rows = 0;
+    EXPECT_TRUE(filter.filter_block(&block, 0, &filtered_rows).ok());
+    // asc order, the rows greater than 20 are filtered out and NULL is kept
+    EXPECT_EQ(1, filtered_rows);
+    ASSERT_EQ(3, block.rows());
+    EXPECT_EQ(0, block.get_by_position(1).column->get_int(0));
+    EXPECT_EQ(1, block.get_by_position(1).column->get_int(1));
+    EXPECT_EQ(3, block.get_by_position(1).column->get_int(2));
+}
+
+} // namespace doris::vectorized
@@ -58,6 +58,7 @@ Usage: $0 <options>
     $0                                      build all
     $0 --be                                 build Backend
     $0 --meta-tool                          build Backend meta tool
+    $0 --be --benchmark                     build Backend and the benchmark of vectorized kernels
     $0 --fe --clean                         clean and build Frontend and Spark Dpp application
     $0 --fe --be --clean                    clean and build Frontend, Spark Dpp application and Backend
     $0 --spark-dpp                          build Spark DPP application alone
@@ -104,6 +105,7 @@ OPTS=$(getopt \
   -l 'be' \
   -l 'broker' \
   -l 'meta-tool' \
+  -l 'benchmark' \
   -l 'spark-dpp' \
   -l 'java-udf' \
   -l 'hive-udf' \
@@ -123,6 +125,7 @@ BUILD_FE=0
 BUILD_BE=0
 BUILD_BROKER=0
 BUILD_META_TOOL=OFF
+BUILD_BENCHMARK=OFF
 BUILD_SPARK_DPP=0
 BUILD_JAVA_UDF=0
 BUILD_HIVE_UDF=0
@@ -147,6 +150,7 @@ else
             --be) BUILD_BE=1 ; shift ;;
             --broker) BUILD_BROKER=1 ; shift ;;
             --meta-tool) BUILD_META_TOOL=ON ; shift ;;
+            --benchmark) BUILD_BENCHMARK=ON ; shift ;;
             --spark-dpp) BUILD_SPARK_DPP=1 ; shift ;;
             --java-udf) BUILD_JAVA_UDF=1 BUILD_FE=1 BUILD_SPARK_DPP=1 ; shift ;;
             --hive-udf) BUILD_HIVE_UDF=1 ; shift ;;
@@ -218,6 +222,7 @@ echo "Get params:
     BUILD_BE            -- $BUILD_BE
     BUILD_BROKER        -- $BUILD_BROKER
     BUILD_META_TOOL     -- $BUILD_META_TOOL
+    BUILD_BENCHMARK     -- $BUILD_BENCHMARK
     BUILD_SPARK_DPP     -- $BUILD_SPARK_DPP
     BUILD_JAVA_UDF      -- $BUILD_JAVA_UDF
     BUILD_HIVE_UDF      -- $BUILD_HIVE_UDF
@@ -286,6 +291,7 @@ if [ ${BUILD_BE} -eq 1 ] ; then
             -DWITH_LZO=${WITH_LZO} \
             -DUSE_LIBCPP=${USE_LIBCPP} \
             -DBUILD_META_TOOL=${BUILD_META_TOOL} \
+            -DBUILD_BENCHMARK=${BUILD_BENCHMARK} \
             -DUSE_LLD=${USE_LLD} \
             -DBUILD_JAVA_UDF=${BUILD_JAVA_UDF} \
             -DSTRIP_DEBUG_INFO=${STRIP_DEBUG_INFO} \
@@ -391,6 +397,10 @@ if [ ${BUILD_BE} -eq 1 ]; then
         cp -r -p ${DORIS_HOME}/be/output/lib/meta_tool ${DORIS_OUTPUT}/be/lib/
     fi
 
+    if [ "${BUILD_BENCHMARK}" = "ON" ]; then
+        cp -r -p ${DORIS_HOME}/be/output/lib/doris_be_benchmark ${DORIS_OUTPUT}/be/lib/
+    fi
+
     cp -r -p ${DORIS_HOME}/be/output/udf/*.a ${DORIS_OUTPUT}/udf/lib/
     cp -r -p ${DORIS_HOME}/be/output/udf/include/* ${DORIS_OUTPUT}/udf/include/
     cp -r -p ${DORIS_HOME}/webroot/be/* ${DORIS_OUTPUT}/be/www/
@@ -117,6 +117,10 @@ public class Alter {
         db.checkQuota();
 
         OlapTable olapTable = db.getTableOrMetaException(tableName, TableType.OLAP);
+        if (olapTable.getEnableUniqueKeyMergeOnWrite()) {
+            throw new DdlException(PropertyAnalyzer.ENABLE_UNIQUE_KEY_MERGE_ON_WRITE
+                    + " table does not support materialized view");
+        }
         ((MaterializedViewHandler) materializedViewHandler).processCreateMaterializedView(stmt, db, olapTable);
     }
 
@@ -82,6 +82,11 @@ public class AlterTableStmt extends DdlStmt {
     public void rewriteAlterClause(OlapTable table) throws UserException {
         List<AlterClause> clauses = new ArrayList<>();
         for (AlterClause alterClause : ops) {
+            // the tablets of a merge-on-write table can not be converted by schema change on BE yet
+            if (table.getEnableUniqueKeyMergeOnWrite() && isSchemaChangeOrRollup(alterClause)) {
+                throw new AnalysisException(PropertyAnalyzer.ENABLE_UNIQUE_KEY_MERGE_ON_WRITE
+                        + " table does not support schema change or rollup");
+            }
             if (alterClause instanceof EnableFeatureClause) {
                 EnableFeatureClause.Features alterFeature  = ((EnableFeatureClause) alterClause).getFeature();
                 if (alterFeature == null || alterFeature == EnableFeatureClause.Features.UNKNOWN) {
@@ -149,6 +154,23 @@ public class AlterTableStmt extends DdlStmt {
         ops = clauses;
     }
 
+    private boolean isSchemaChangeOrRollup(AlterClause alterClause) {
+        if (alterClause instanceof ModifyTablePropertiesClause) {
+            Map<String, String> properties = alterClause.getProperties();
+            return properties.containsKey(PropertyAnalyzer.PROPERTIES_BF_COLUMNS)
+                    || properties.containsKey(PropertyAnalyzer.PROPERTIES_BF_FPP);
+        }
+        return alterClause instanceof EnableFeatureClause
+                || alterClause instanceof AddColumnClause
+                || alterClause instanceof AddColumnsClause
+                || alterClause instanceof DropColumnClause
+                || alterClause instanceof ModifyColumnClause
+                || alterClause instanceof ReorderColumnsClause
+                || alterClause instanceof CreateIndexClause
+                || alterClause instanceof DropIndexClause
+                || alterClause instanceof AddRollupClause;
+    }
+
     public void checkExternalTableOperationAllow(Table table) throws UserException {
         List<AlterClause> clauses = new ArrayList<>();
         for (AlterClause alterClause : ops) {
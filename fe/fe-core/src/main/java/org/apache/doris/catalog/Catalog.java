@@ -3275,7 +3275,8 @@ public class Catalog {
                     singlePartitionDesc.isInMemory(),
                     olapTable.getStorageFormat(),
                     singlePartitionDesc.getTabletType(),
-                    olapTable.getDataSortInfo()
+                    olapTable.getDataSortInfo(),
+                    olapTable.getEnableUniqueKeyMergeOnWrite()
             );
 
             // check again
@@ -3506,7 +3507,8 @@ public class Catalog {
                                                  boolean isInMemory,
                                                  TStorageFormat storageFormat,
                                                  TTabletType tabletType,
-                                                 DataSortInfo dataSortInfo) throws DdlException {
+                                                 DataSortInfo dataSortInfo,
+                                                 boolean enableUniqueKeyMergeOnWrite) throws DdlException {
         // create base index first.
         Preconditions.checkArgument(baseIndexId != -1);
         MaterializedIndex baseIndex = new MaterializedIndex(baseIndexId, IndexState.NORMAL);
@@ -3575,6 +3577,7 @@ public class Catalog {
                             tabletType,
                             dataSortInfo);
                     task.setStorageFormat(storageFormat);
+                    task.setEnableUniqueKeyMergeOnWrite(enableUniqueKeyMergeOnWrite);
                     batchTask.addTask(task);
                     // add to AgentTaskQueue for handling finish report.
                     // not for resending task
@@ -3728,6 +3731,17 @@ public class Catalog {
         boolean isInMemory = PropertyAnalyzer.analyzeBooleanProp(properties, PropertyAnalyzer.PROPERTIES_INMEMORY, false);
         olapTable.setIsInMemory(isInMemory);
 
+        // set merge-on-write
+        boolean enableUniqueKeyMergeOnWrite = PropertyAnalyzer.analyzeBooleanProp(properties,
+                PropertyAnalyzer.ENABLE_UNIQUE_KEY_MERGE_ON_WRITE, false);
+        if (enableUniqueKeyMergeOnWrite) {
+            if (keysType != KeysType.UNIQUE_KEYS) {
+                throw new DdlException(PropertyAnalyzer.ENABLE_UNIQUE_KEY_MERGE_ON_WRITE
+                        + " property only supports unique key table");
+            }
+        }
+        olapTable.setEnableUniqueKeyMergeOnWrite(enableUniqueKeyMergeOnWrite);
+
         // set remote storage
         String resourceName = PropertyAnalyzer.analyzeRemoteStorageResource(properties);
         olapTable.setRemoteStorageResource(resourceName);
@@ -3833,6 +3847,10 @@ public class Catalog {
         } catch (Exception e) {
             throw new DdlException(e.getMessage());
         }
+        if (sequenceColType != null && enableUniqueKeyMergeOnWrite) {
+            throw new DdlException(PropertyAnalyzer.ENABLE_UNIQUE_KEY_MERGE_ON_WRITE
+                    + " property does not support sequence column");
+        }
 
         // analyze version info
         Long versionInfo = null;
@@ -3875,7 +3893,8 @@ public class Catalog {
                         partitionInfo.getReplicaAllocation(partitionId),
                         versionInfo, bfColumns, bfFpp,
                         tabletIdSet, olapTable.getCopiedIndexes(),
-                        isInMemory, storageFormat, tabletType, olapTable.getDataSortInfo());
+                        isInMemory, storageFormat, tabletType, olapTable.getDataSortInfo(),
+                        olapTable.getEnableUniqueKeyMergeOnWrite());
                 olapTable.addPartition(partition);
             } else if (partitionInfo.getType() == PartitionType.RANGE || partitionInfo.getType() == PartitionType.LIST) {
                 try {
@@ -3926,7 +3945,8 @@ public class Catalog {
                             versionInfo, bfColumns, bfFpp,
                             tabletIdSet, olapTable.getCopiedIndexes(),
                             isInMemory, storageFormat,
-                            partitionInfo.getTabletType(entry.getValue()), olapTable.getDataSortInfo());
+                            partitionInfo.getTabletType(entry.getValue()), olapTable.getDataSortInfo(),
+                            olapTable.getEnableUniqueKeyMergeOnWrite());
                     olapTable.addPartition(partition);
                 }
             } else {
@@ -4256,6 +4276,12 @@ public class Catalog {
             sb.append(",\n\"").append(PropertyAnalyzer.PROPERTIES_STORAGE_FORMAT).append("\" = \"");
             sb.append(olapTable.getStorageFormat()).append("\"");
 
+            // merge-on-write
+            if (olapTable.getEnableUniqueKeyMergeOnWrite()) {
+                sb.append(",\n\"").append(PropertyAnalyzer.ENABLE_UNIQUE_KEY_MERGE_ON_WRITE).append("\" = \"");
+                sb.append(olapTable.getEnableUniqueKeyMergeOnWrite()).append("\"");
+            }
+
             // remote storage resource
             String remoteStorageResource = olapTable.getRemoteStorageResource();
             if (!Strings.isNullOrEmpty(remoteStorageResource)) {
@@ -6789,7 +6815,8 @@ public class Catalog {
                         copiedTbl.isInMemory(),
                         copiedTbl.getStorageFormat(),
                         copiedTbl.getPartitionInfo().getTabletType(oldPartitionId),
-                        copiedTbl.getDataSortInfo());
+                        copiedTbl.getDataSortInfo(),
+                        copiedTbl.getEnableUniqueKeyMergeOnWrite());
                 newPartitions.add(newPartition);
             }
         } catch (DdlException e) {
@@ -1532,6 +1532,22 @@ public class OlapTable extends Table {
         tableProperty.buildInMemory();
     }
 
+    public void setEnableUniqueKeyMergeOnWrite(boolean enableUniqueKeyMergeOnWrite) {
+        if (tableProperty == null) {
+            tableProperty = new TableProperty(new HashMap<>());
+        }
+        tableProperty.modifyTableProperties(PropertyAnalyzer.ENABLE_UNIQUE_KEY_MERGE_ON_WRITE,
+                Boolean.valueOf(enableUniqueKeyMergeOnWrite).toString());
+        tableProperty.buildEnableUniqueKeyMergeOnWrite();
+    }
+
+    public boolean getEnableUniqueKeyMergeOnWrite() {
+        if (tableProperty == null) {
+            return false;
+        }
+        return tableProperty.getEnableUniqueKeyMergeOnWrite();
+    }
+
     public void setDataSortInfo(DataSortInfo dataSortInfo) {
         if (tableProperty == null) {
             tableProperty = new TableProperty(new HashMap<>());
@@ -60,6 +60,8 @@ public class TableProperty implements Writable {
     private ReplicaAllocation replicaAlloc = ReplicaAllocation.DEFAULT_ALLOCATION;
     private boolean isInMemory = false;
 
+    private boolean enableUniqueKeyMergeOnWrite = false;
+
     /*
      * the default storage format of this table.
      * DEFAULT: depends on BE's config 'default_rowset_type'
@@ -145,6 +147,12 @@ public class TableProperty implements Writable {
         return this;
     }
 
+    public TableProperty buildEnableUniqueKeyMergeOnWrite() {
+        enableUniqueKeyMergeOnWrite = Boolean.parseBoolean(
+                properties.getOrDefault(PropertyAnalyzer.ENABLE_UNIQUE_KEY_MERGE_ON_WRITE, "false"));
+        return this;
+    }
+
     public TableProperty buildDataSortInfo() {
         HashMap<String, String> dataSortInfoProperties = new HashMap<>();
         for (Map.Entry<String, String> entry : properties.entrySet()) {
@@ -224,6 +232,10 @@ public class TableProperty implements Writable {
         return storageFormat;
     }
 
+    public boolean getEnableUniqueKeyMergeOnWrite() {
+        return enableUniqueKeyMergeOnWrite;
+    }
+
     public DataSortInfo getDataSortInfo() {
         return dataSortInfo;
     }
@@ -256,7 +268,8 @@ public class TableProperty implements Writable {
                 .buildInMemory()
                 .buildStorageFormat()
                 .buildDataSortInfo()
-                .buildRemoteStorageResource();
+                .buildRemoteStorageResource()
+                .buildEnableUniqueKeyMergeOnWrite();
         if (Catalog.getCurrentCatalogJournalVersion() < FeMetaVersion.VERSION_105) {
             // get replica num from property map and create replica allocation
             String repNum = tableProperty.properties.remove(PropertyAnalyzer.PROPERTIES_REPLICATION_NUM);
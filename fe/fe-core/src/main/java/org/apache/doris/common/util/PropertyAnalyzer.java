@@ -88,6 +88,9 @@ public class PropertyAnalyzer {
 
     public static final String PROPERTIES_INMEMORY = "in_memory";
 
+    // unique key table only, mark overwritten rows in delete bitmap at load time instead of merging at read time
+    public static final String ENABLE_UNIQUE_KEY_MERGE_ON_WRITE = "enable_unique_key_merge_on_write";
+
     public static final String PROPERTIES_REMOTE_STORAGE_RESOURCE = "remote_storage_resource";
 
     public static final String PROPERTIES_TABLET_TYPE = "tablet_type";
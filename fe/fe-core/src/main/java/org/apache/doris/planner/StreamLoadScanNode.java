@@ -165,6 +165,9 @@ public class StreamLoadScanNode extends LoadScanNode {
             params.setLineDelimiter((byte) '\n');
             params.setLineDelimiterLength(1);
         }
+        if (taskInfo.getEnclose() != 0) {
+            params.setEnclose(taskInfo.getEnclose());
+        }
         params.setDestTupleId(desc.getId().asInt());
         brokerScanRange.setParams(params);
 
@@ -174,6 +174,8 @@ public class SessionVariable implements Serializable, Writable {
 
     public static final String RETURN_OBJECT_DATA_AS_BINARY = "return_object_data_as_binary";
 
+    public static final String FRAGMENT_TRANSMISSION_COMPRESSION_CODEC = "fragment_transmission_compression_codec";
+
     public static final String BLOCK_ENCRYPTION_MODE = "block_encryption_mode";
 
     public static final String AUTO_BROADCAST_JOIN_THRESHOLD = "auto_broadcast_join_threshold";
@@ -430,6 +432,10 @@ public class SessionVariable implements Serializable, Writable {
     @VariableMgr.VarAttr(name = RETURN_OBJECT_DATA_AS_BINARY)
     private boolean returnObjectDataAsBinary = false;
 
+    // snappy, lz4, zstd, none or auto, 'auto' chooses none, lz4 or zstd for each destination
+    @VariableMgr.VarAttr(name = FRAGMENT_TRANSMISSION_COMPRESSION_CODEC)
+    private String fragmentTransmissionCompressionCodec = "snappy";
+
     @VariableMgr.VarAttr(name = BLOCK_ENCRYPTION_MODE)
     private String blockEncryptionMode = "";
 
@@ -896,6 +902,14 @@ public class SessionVariable implements Serializable, Writable {
         this.returnObjectDataAsBinary = returnObjectDataAsBinary;
     }
 
+    public String getFragmentTransmissionCompressionCodec() {
+        return fragmentTransmissionCompressionCodec;
+    }
+
+    public void setFragmentTransmissionCompressionCodec(String fragmentTransmissionCompressionCodec) {
+        this.fragmentTransmissionCompressionCodec = fragmentTransmissionCompressionCodec;
+    }
+
     public boolean isEnableInferPredicate() {
         return enableInferPredicate;
     }
@@ -923,6 +937,7 @@ public class SessionVariable implements Serializable, Writable {
         tResult.setCodegenLevel(codegenLevel);
         tResult.setEnableVectorizedEngine(enableVectorizedEngine);
         tResult.setReturnObjectDataAsBinary(returnObjectDataAsBinary);
+        tResult.setFragmentTransmissionCompressionCodec(fragmentTransmissionCompressionCodec);
 
         tResult.setBatchSize(batchSize);
         tResult.setDisableStreamPreaggregations(disableStreamPreaggregations);
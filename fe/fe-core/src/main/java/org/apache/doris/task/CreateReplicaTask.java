@@ -84,6 +84,8 @@ public class CreateReplicaTask extends AgentTask {
 
     private DataSortInfo dataSortInfo;
 
+    private boolean enableUniqueKeyMergeOnWrite = false;
+
     public CreateReplicaTask(long backendId, long dbId, long tableId, long partitionId, long indexId, long tabletId,
                              short shortKeyColumnCount, int schemaHash, long version,
                              KeysType keysType, TStorageType storageType,
@@ -190,6 +192,10 @@ public class CreateReplicaTask extends AgentTask {
         this.storageFormat = storageFormat;
     }
 
+    public void setEnableUniqueKeyMergeOnWrite(boolean enableUniqueKeyMergeOnWrite) {
+        this.enableUniqueKeyMergeOnWrite = enableUniqueKeyMergeOnWrite;
+    }
+
     public TCreateTabletReq toThrift() {
         TCreateTabletReq createTabletReq = new TCreateTabletReq();
         createTabletReq.setTabletId(tabletId);
@@ -265,6 +271,7 @@ public class CreateReplicaTask extends AgentTask {
         }
 
         createTabletReq.setTabletType(tabletType);
+        createTabletReq.setEnableUniqueKeyMergeOnWrite(enableUniqueKeyMergeOnWrite);
         return createTabletReq;
     }
 }
@@ -59,6 +59,7 @@ public interface LoadTaskInfo {
     public Expr getWhereExpr();
     public Separator getColumnSeparator();
     public Separator getLineDelimiter();
+    public byte getEnclose();
     public int getSendBatchParallelism();
     public boolean isLoadToSingleTablet();
     public String getHeaderType();
@@ -63,6 +63,7 @@ public class StreamLoadTask implements LoadTaskInfo {
     private Expr whereExpr;
     private Separator columnSeparator;
     private Separator lineDelimiter;
+    private byte enclose = 0;
     private PartitionNames partitions;
     private String path;
     private boolean negative;
@@ -131,6 +132,11 @@ public class StreamLoadTask implements LoadTaskInfo {
         return lineDelimiter;
     }
 
+    @Override
+    public byte getEnclose() {
+        return enclose;
+    }
+
     @Override
     public int getSendBatchParallelism() {
         return sendBatchParallelism;
@@ -248,6 +254,9 @@ public class StreamLoadTask implements LoadTaskInfo {
         if (request.isSetLineDelimiter()) {
             setLineDelimiter(request.getLineDelimiter());
         }
+        if (request.isSetEnclose()) {
+            setEnclose(request.getEnclose());
+        }
         if (request.isSetHeaderType()) {
             headerType = request.getHeaderType();
         }
@@ -384,6 +393,13 @@ public class StreamLoadTask implements LoadTaskInfo {
         lineDelimiter.analyze();
     }
 
+    private void setEnclose(String oriEnclose) throws AnalysisException {
+        if (oriEnclose.length() != 1 || oriEnclose.charAt(0) > 127) {
+            throw new AnalysisException("enclose must be a single ASCII character: " + oriEnclose);
+        }
+        enclose = (byte) oriEnclose.charAt(0);
+    }
+
     @Override
     public long getMemLimit() {
         return execMemLimit;
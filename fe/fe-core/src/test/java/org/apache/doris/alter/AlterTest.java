@@ -19,6 +19,7 @@ package org.apache.doris.alter;
 
 import org.apache.doris.analysis.AlterTableStmt;
 import org.apache.doris.analysis.CreateDbStmt;
+import org.apache.doris.analysis.CreateMaterializedViewStmt;
 import org.apache.doris.analysis.CreateResourceStmt;
 import org.apache.doris.analysis.CreateTableStmt;
 import org.apache.doris.analysis.DateLiteral;
@@ -39,6 +40,7 @@ import org.apache.doris.catalog.TabletInvertedIndex;
 import org.apache.doris.catalog.Type;
 import org.apache.doris.common.Config;
 import org.apache.doris.common.DdlException;
+import org.apache.doris.common.ExceptionChecker;
 import org.apache.doris.common.FeConstants;
 import org.apache.doris.common.util.TimeUtils;
 import org.apache.doris.qe.ConnectContext;
@@ -896,6 +898,40 @@ public class AlterTest {
         alterTable(changeOrderStmt, true);
     }
 
+    @Test
+    public void testAlterMergeOnWriteTable() throws Exception {
+        createTable("CREATE TABLE test.merge_on_write\n" +
+                "(\n" +
+                "    k1 int,\n" +
+                "    k2 int,\n" +
+                "    v1 int\n" +
+                ")\n" +
+                "UNIQUE KEY(k1, k2)\n" +
+                "DISTRIBUTED BY HASH(k1) BUCKETS 3\n" +
+                "PROPERTIES('replication_num' = '1', 'enable_unique_key_merge_on_write' = 'true');");
+
+        // the tablets of merge-on-write table can not be converted by schema change
+        alterTable("ALTER TABLE test.merge_on_write add column v2 int", true);
+        alterTable("ALTER TABLE test.merge_on_write drop column v1", true);
+        alterTable("ALTER TABLE test.merge_on_write modify column v1 bigint", true);
+        alterTable("ALTER TABLE test.merge_on_write order by (k1, k2, v1)", true);
+        alterTable("ALTER TABLE test.merge_on_write add rollup r1(k1, v1)", true);
+        alterTable("ALTER TABLE test.merge_on_write set ('bloom_filter_columns' = 'k2')", true);
+        alterTable("ALTER TABLE test.merge_on_write enable feature \"SEQUENCE_LOAD\" with properties "
+                + "(\"function_column.sequence_type\" = \"int\")", true);
+        alterTable("ALTER TABLE test.merge_on_write enable feature \"BATCH_DELETE\"", true);
+
+        String mvStmt = "create materialized view mv1 as select k1, sum(v1) from test.merge_on_write group by k1";
+        CreateMaterializedViewStmt createMaterializedViewStmt =
+                (CreateMaterializedViewStmt) UtFrameUtils.parseAndAnalyzeStmt(mvStmt, connectContext);
+        ExceptionChecker.expectThrowsWithMsg(DdlException.class,
+                "enable_unique_key_merge_on_write table does not support materialized view",
+                () -> Catalog.getCurrentCatalog().createMaterializedView(createMaterializedViewStmt));
+
+        // the properties not changing the tablets can be still modified
+        alterTable("ALTER TABLE test.merge_on_write set ('in_memory' = 'true')", false);
+    }
+
     private boolean checkAllTabletsExists(List<Long> tabletIds) {
         TabletInvertedIndex invertedIndex = Catalog.getCurrentCatalog().getTabletInvertedIndex();
         for (long tabletId : tabletIds) {
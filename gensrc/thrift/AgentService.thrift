@@ -105,6 +105,7 @@ struct TCreateTabletReq {
     13: optional TStorageFormat storage_format
     14: optional TTabletType tablet_type
     15: optional TStorageParam storage_param
+    16: optional bool enable_unique_key_merge_on_write = false
 }
 
 struct TDropTabletReq {
@@ -160,6 +160,10 @@ struct TQueryOptions {
   // show bitmap data in result, if use this in mysql cli may make the terminal
   // output corrupted character
   43: optional bool return_object_data_as_binary = false
+
+  // codec to compress the blocks sent between fragments:
+  // "snappy", "lz4", "zstd", "none", or "auto" to choose per destination at runtime
+  44: optional string fragment_transmission_compression_codec = "snappy"
 }
     
 
@@ -193,6 +193,9 @@ struct TBrokerScanRangeParams {
     12: optional i32 line_delimiter_length = 1;
     13: optional string column_separator_str;
     14: optional string line_delimiter_str;
+    // a csv value which starts and ends with this char is enclosed, the separators and
+    // line delimiters in it do not split, and a doubled enclose char in it is one char
+    15: optional i8 enclose
 
 }
 